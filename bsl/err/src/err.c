@@ -53,17 +53,36 @@ typedef struct {
     uint32_t line[SAL_MAX_ERROR_STACK];
 } ErrorCodeStack;
 
+/* The error stack is kept in thread local storage when the compiler supports it, so that pushing, clearing and
+   peeking errors never take a lock. Define HITLS_ERR_THREAD_LOCK to keep the stacks of all threads in an avl tree
+   guarded by g_errLock instead, e.g. on platforms without thread local storage. */
+#ifndef HITLS_ERR_THREAD_LOCK
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+#define ERR_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__) || defined(__clang__)
+#define ERR_THREAD_LOCAL __thread
+#endif
+#endif
+
+#ifdef ERR_THREAD_LOCAL
+/* Error stack of the current thread, which is only accessed by the thread itself. */
+static ERR_THREAD_LOCAL ErrorCodeStack g_errStack;
+
+/* Whether the current thread owns an error stack, that is, it has pushed an error since the stack was removed. */
+static ERR_THREAD_LOCAL bool g_hasErrStack = false;
+#else
 /* Avl tree root node of the error stack. */
 static BSL_AvlTree *g_avlRoot = NULL;
 
-/* Error description root node */
-static BSL_AvlTree *g_descRoot = NULL;
-
 /* Current number of AVL nodes */
 static uint32_t g_avlNodeCount = 0;
 
 /* Maximum number of nodes allowed by the AVL tree */
 static uint32_t g_maxAvlNodes = 0x0000FFFF;
+#endif
+
+/* Error description root node */
+static BSL_AvlTree *g_descRoot = NULL;
 
 /* Check the initialization status. 0 means false, if the value is not 0, it means true. Run once. */
 static uint32_t g_isErrInit = 0;
@@ -115,6 +134,28 @@ static void StackResetIndex(ErrorCodeStack *stack, uint32_t i)
     }
 }
 
+#ifdef ERR_THREAD_LOCAL
+/* Obtain the error stack of the current thread. If create is false and the thread has no error stack, NULL is
+   returned. ErrStackRelease must be called after a stack is returned. */
+static int32_t ErrStackAcquire(bool create, bool write, ErrorCodeStack **stack)
+{
+    (void)write;
+    if (!g_hasErrStack) {
+        if (!create) {
+            *stack = NULL;
+            return BSL_SUCCESS;
+        }
+        g_hasErrStack = true;
+    }
+    *stack = &g_errStack;
+    return BSL_SUCCESS;
+}
+
+static void ErrStackRelease(void)
+{
+    return;
+}
+#else
 static void StackDataFree(BSL_ElementData data)
 {
     BSL_SAL_FREE(data);
@@ -153,6 +194,32 @@ static ErrorCodeStack *GetStack(void)
     return stack;
 }
 
+/* Obtain the error stack of the current thread with g_errLock held. If create is false and the thread has no error
+   stack, NULL is returned. ErrStackRelease must be called after a stack is returned. */
+static int32_t ErrStackAcquire(bool create, bool write, ErrorCodeStack **stack)
+{
+    int32_t ret = write ? BSL_SAL_ThreadWriteLock(g_errLock) : BSL_SAL_ThreadReadLock(g_errLock);
+    if (ret != BSL_SUCCESS) {
+        return ret;
+    }
+    if (create) {
+        *stack = GetStack();
+    } else {
+        BSL_AvlTree *curNode = BSL_AVL_SearchNode(g_avlRoot, BSL_SAL_ThreadGetId());
+        *stack = (curNode == NULL) ? NULL : curNode->data;
+    }
+    if (*stack == NULL) {
+        BSL_SAL_ThreadUnlock(g_errLock);
+    }
+    return BSL_SUCCESS;
+}
+
+static void ErrStackRelease(void)
+{
+    BSL_SAL_ThreadUnlock(g_errLock);
+}
+#endif
+
 void BSL_ERR_PushError(int32_t err, const char *file, uint32_t lineNo)
 {
     if (err == BSL_SUCCESS) {
@@ -160,54 +227,59 @@ void BSL_ERR_PushError(int32_t err, const char *file, uint32_t lineNo)
         return;
     }
 
-    int32_t ret = BSL_SAL_ThreadWriteLock(g_errLock);
+    ErrorCodeStack *stack = NULL;
+    int32_t ret = ErrStackAcquire(true, true, &stack);
     if (ret != BSL_SUCCESS) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID05007, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN,
             "acquire lock failed when pushing error, threadId %llu, error code %d", BSL_SAL_ThreadGetId(), ret, 0, 0);
         return;
     }
+    if (stack == NULL) {
+        return;
+    }
 
-    ErrorCodeStack *stack = GetStack();
-    if (stack != NULL) {
-        if (stack->top == stack->bottom && stack->errorStack[stack->top] != 0) {
-            stack->bottom = (stack->bottom + 1) % SAL_MAX_ERROR_STACK;
-        }
-        stack->errorFlags[stack->top] = 0;
-        stack->errorStack[stack->top] = err;
-        stack->filename[stack->top] = file;
-        stack->line[stack->top] = lineNo;
-        stack->top = (stack->top + 1) % SAL_MAX_ERROR_STACK;
+    if (stack->top == stack->bottom && stack->errorStack[stack->top] != 0) {
+        stack->bottom = (stack->bottom + 1) % SAL_MAX_ERROR_STACK;
     }
+    stack->errorFlags[stack->top] = 0;
+    stack->errorStack[stack->top] = err;
+    stack->filename[stack->top] = file;
+    stack->line[stack->top] = lineNo;
+    stack->top = (stack->top + 1) % SAL_MAX_ERROR_STACK;
 
-    BSL_SAL_ThreadUnlock(g_errLock);
+    ErrStackRelease();
 }
 
 void BSL_ERR_ClearError(void)
 {
     (void)BSL_SAL_ThreadRunOnce(&g_isErrInit, ErrAutoInit);
 
-    uint64_t threadId = BSL_SAL_ThreadGetId();
-    int32_t ret = BSL_SAL_ThreadWriteLock(g_errLock);
+    ErrorCodeStack *errStack = NULL;
+    int32_t ret = ErrStackAcquire(false, true, &errStack);
     if (ret != BSL_SUCCESS) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID05008, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN,
-            "acquire lock failed when clearing error, threadId %llu", threadId, 0, 0, 0);
+            "acquire lock failed when clearing error, threadId %llu", BSL_SAL_ThreadGetId(), 0, 0, 0);
+        return;
+    }
+    if (errStack == NULL) {
         return;
     }
 
-    BSL_AvlTree *curNode = BSL_AVL_SearchNode(g_avlRoot, threadId);
-    if (curNode != NULL) {
-        /* Will not be NULL. */
-        ErrorCodeStack *errStack = curNode->data;
-        if (errStack->flag == 0) {
-            StackReset(errStack);
-        }
+    if (errStack->flag == 0) {
+        StackReset(errStack);
     }
 
-    BSL_SAL_ThreadUnlock(g_errLock);
+    ErrStackRelease();
 }
 
 void BSL_ERR_RemoveErrorStack(bool isRemoveAll)
 {
+#ifdef ERR_THREAD_LOCAL
+    /* The thread local stacks of other threads are released when the threads exit. */
+    (void)isRemoveAll;
+    StackReset(&g_errStack);
+    g_hasErrStack = false;
+#else
     (void)BSL_SAL_ThreadRunOnce(&g_isErrInit, ErrAutoInit);
 
     int32_t ret = BSL_SAL_ThreadWriteLock(g_errLock);
@@ -233,6 +305,7 @@ void BSL_ERR_RemoveErrorStack(bool isRemoveAll)
     }
 
     BSL_SAL_ThreadUnlock(g_errLock);
+#endif
 }
 
 /* Obtain the index. 'last' indicates that the last or first error code is obtained. */
@@ -259,31 +332,20 @@ static uint16_t GetIndex(ErrorCodeStack *errStack, bool last)
 static int32_t GetErrorInfo(const char **file, uint32_t *lineNo, bool clr, bool last)
 {
     uint16_t idx;
+    ErrorCodeStack *errStack = NULL;
 
-    int32_t ret = BSL_SAL_ThreadReadLock(g_errLock);
+    int32_t ret = ErrStackAcquire(false, false, &errStack);
     if (ret != BSL_SUCCESS) {
         return BSL_ERR_ERR_ACQUIRE_READ_LOCK_FAIL;
     }
-
-    if (g_avlRoot == NULL) {
-        /* If avlRoot is empty, no thread push error. Therefore, error should be success. */
-        BSL_SAL_ThreadUnlock(g_errLock);
-        return BSL_SUCCESS;
-    }
-
-    const uint64_t threadId = BSL_SAL_ThreadGetId();
-    BSL_AvlTree *curNode = BSL_AVL_SearchNode(g_avlRoot, threadId);
-    if (curNode == NULL) {
-        /* If curNode is empty, the current thread does not have push error. Therefore, error should be success. */
-        BSL_SAL_ThreadUnlock(g_errLock);
+    if (errStack == NULL) {
+        /* The current thread does not have push error. Therefore, error should be success. */
         return BSL_SUCCESS;
     }
 
-    ErrorCodeStack *errStack = curNode->data; /* will not be null */
-
     idx = GetIndex(errStack, last);
     if (errStack->errorStack[idx] == 0) { /* error stack is empty */
-        BSL_SAL_ThreadUnlock(g_errLock);
+        ErrStackRelease();
         return BSL_SUCCESS;
     }
 
@@ -299,7 +361,7 @@ static int32_t GetErrorInfo(const char **file, uint32_t *lineNo, bool clr, bool
         }
     }
 
-    BSL_SAL_ThreadUnlock(g_errLock);
+    ErrStackRelease();
 
     if (file != NULL && lineNo != NULL) { /* both together, there's no point in getting only one of them. */
         if (f == NULL) {
@@ -431,24 +493,14 @@ const char *BSL_ERR_GetString(int32_t error)
 
 static int32_t BSL_LIST_WriteLockCreate(ErrorCodeStack **errStack, uint32_t *top)
 {
-    int32_t ret = BSL_SAL_ThreadWriteLock(g_errLock);
+    int32_t ret = ErrStackAcquire(false, true, errStack);
     if (ret != BSL_SUCCESS) {
         return BSL_ERR_ERR_ACQUIRE_WRITE_LOCK_FAIL;
     }
-
-    if (g_avlRoot == NULL) {
-        BSL_SAL_ThreadUnlock(g_errLock);
-        return BSL_ERR_ERR_NO_STACK;
-    }
-
-    const uint64_t threadId = BSL_SAL_ThreadGetId();
-    BSL_AvlTree *curNode = BSL_AVL_SearchNode(g_avlRoot, threadId);
-    if (curNode == NULL) {
-        BSL_SAL_ThreadUnlock(g_errLock);
+    if (*errStack == NULL) {
         return BSL_ERR_ERR_NO_STACK;
     }
 
-    *errStack = curNode->data; /* will not be null */
     if (top == NULL) {
         return ret;
     }
@@ -469,13 +521,13 @@ int32_t BSL_ERR_SetMark(void)
     }
 
     if (errStack->errorStack[top] == 0) { /* error stack is empty */
-        BSL_SAL_ThreadUnlock(g_errLock);
+        ErrStackRelease();
         return BSL_ERR_ERR_NO_ERROR;
     }
 
     errStack->errorFlags[top] |= ERR_FLAG_POP_MARK;
 
-    BSL_SAL_ThreadUnlock(g_errLock);
+    ErrStackRelease();
     return BSL_SUCCESS;
 }
 
@@ -498,13 +550,13 @@ int32_t BSL_ERR_PopToMark(void)
     errStack->top = (top + 1) % SAL_MAX_ERROR_STACK;
 
     if (errStack->errorStack[top] == 0) {
-        BSL_SAL_ThreadUnlock(g_errLock);
+        ErrStackRelease();
         return BSL_ERR_ERR_NO_MARK;
     }
 
     errStack->errorFlags[top] &= ~ERR_FLAG_POP_MARK;
 
-    BSL_SAL_ThreadUnlock(g_errLock);
+    ErrStackRelease();
     return BSL_SUCCESS;
 }
 
@@ -525,7 +577,7 @@ int32_t BSL_ERR_ClearLastMark(void)
     }
     errStack->errorFlags[top] &= ~ERR_FLAG_POP_MARK;
 
-    BSL_SAL_ThreadUnlock(g_errLock);
+    ErrStackRelease();
     return BSL_SUCCESS;
 }
 
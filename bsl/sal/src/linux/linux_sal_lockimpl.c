@@ -134,6 +134,51 @@ void BSL_SAL_ThreadClose(BSL_SAL_ThreadId thread)
     (void)pthread_join((pthread_t)(uintptr_t)thread, NULL);
 }
 
+int32_t BSL_SAL_ThreadKeyNew(BSL_SAL_ThreadKey *key, void (*destructor)(void *))
+{
+    if (key == NULL) {
+        return BSL_SAL_ERR_BAD_PARAM;
+    }
+    pthread_key_t *threadKey = (pthread_key_t *)BSL_SAL_Malloc(sizeof(pthread_key_t));
+    if (threadKey == NULL) {
+        return BSL_MALLOC_FAIL;
+    }
+    if (pthread_key_create(threadKey, destructor) != 0) {
+        BSL_SAL_FREE(threadKey);
+        return BSL_SAL_ERR_UNKNOWN;
+    }
+    *key = threadKey;
+    return BSL_SUCCESS;
+}
+
+void BSL_SAL_ThreadKeyFree(BSL_SAL_ThreadKey key)
+{
+    if (key == NULL) {
+        return;
+    }
+    (void)pthread_key_delete(*(pthread_key_t *)key);
+    BSL_SAL_FREE(key);
+}
+
+int32_t BSL_SAL_ThreadSetSpecific(BSL_SAL_ThreadKey key, void *value)
+{
+    if (key == NULL) {
+        return BSL_SAL_ERR_BAD_PARAM;
+    }
+    if (pthread_setspecific(*(pthread_key_t *)key, value) != 0) {
+        return BSL_SAL_ERR_UNKNOWN;
+    }
+    return BSL_SUCCESS;
+}
+
+void *BSL_SAL_ThreadGetSpecific(BSL_SAL_ThreadKey key)
+{
+    if (key == NULL) {
+        return NULL;
+    }
+    return pthread_getspecific(*(pthread_key_t *)key);
+}
+
 int32_t BSL_SAL_CreateCondVar(BSL_SAL_CondVar *condVar)
 {
     if (condVar == NULL) {
@@ -718,6 +718,10 @@ chacha20poly1305, chacha20, rsa"
     #error "[HiTLS] ealinit must be enabled for sha1_armv8 or sha256_armv8 or sha224_armv8 or sm4_x8664."
 #endif
 
+#if (defined(HITLS_CRYPTO_MLKEM_X8664) || defined(HITLS_CRYPTO_MLDSA_X8664)) && !defined(HITLS_CRYPTO_EALINIT)
+    #error "[HiTLS] ealinit must be enabled for mlkem_x8664 or mldsa_x8664."
+#endif
+
 #if defined(HITLS_CRYPTO_HYBRIDKEM)
     #if !defined(HITLS_CRYPTO_X25519) && !defined(HITLS_CRYPTO_ECDH)
         #error "[HiTLS] The hybrid must work with x25519 or ecdh."
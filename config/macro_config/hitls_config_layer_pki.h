@@ -77,6 +77,9 @@
     #ifndef HITLS_PKI_X509_CRL_PARSE
         #define HITLS_PKI_X509_CRL_PARSE
     #endif
+    #ifndef HITLS_BSL_HASH
+        #define HITLS_BSL_HASH
+    #endif
 #endif
 
 #ifdef HITLS_PKI_X509_CRT
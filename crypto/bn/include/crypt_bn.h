@@ -456,6 +456,28 @@ int32_t BN_Gcd(BN_BigNum *r, const BN_BigNum *a, const BN_BigNum *b, BN_Optimize
  * @retval CRYPT_BN_ERR_NO_INVERSE      Cannot calculate the module inverse.
  */
 int32_t BN_ModInv(BN_BigNum *r, const BN_BigNum *x, const BN_BigNum *m, BN_Optimizer *opt);
+
+/**
+ * @ingroup bn
+ * @brief Modulo inverse of a batch of BigNums with one inversion (Montgomery's trick),
+ *        r[i] = 1 / a[i] mod m, which costs 3 * (num - 1) modular multiplications more.
+ *
+ * @attention r and a cannot share BigNums, and all a[i] must be invertible, otherwise no result is valid.
+ *
+ * @param r   [OUT] Results, num BigNums
+ * @param a   [IN] BigNums to be inverted, num BigNums
+ * @param num [IN] Number of the BigNums
+ * @param m   [IN] mod
+ * @param opt [IN] Optimizer
+ *
+ * @retval CRYPT_SUCCESS
+ * @retval CRYPT_NULL_INPUT             Invalid null pointer or num is 0
+ * @retval CRYPT_BN_ERR_DIVISOR_ZERO    a[i] or m is 0
+ * @retval CRYPT_MEM_ALLOC_FAIL         Memory allocation failure
+ * @retval CRYPT_BN_OPTIMIZER_GET_FAIL  Failed to apply for space from the optimizer.
+ * @retval CRYPT_BN_ERR_NO_INVERSE      Cannot calculate the module inverse.
+ */
+int32_t BN_ModInvBatch(BN_BigNum *r[], BN_BigNum *const a[], uint32_t num, const BN_BigNum *m, BN_Optimizer *opt);
 /**
  * @ingroup bn
  * @brief BigNum comparison
@@ -256,4 +256,76 @@ ERR:
     OptimizerEnd(opt); // Release occupation from the optimizer.
     return ret;
 }
+
+static int32_t InverseBatchInputCheck(BN_BigNum *r[], BN_BigNum *const a[], uint32_t num, const BN_BigNum *m,
+    const BN_Optimizer *opt)
+{
+    if (r == NULL || a == NULL || num == 0 || m == NULL || opt == NULL) {
+        BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
+        return CRYPT_NULL_INPUT;
+    }
+    for (uint32_t i = 0; i < num; i++) {
+        if (r[i] == NULL || a[i] == NULL) {
+            BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
+            return CRYPT_NULL_INPUT;
+        }
+        /* cannot be 0, the product would not be invertible */
+        if (BN_IsZero(a[i])) {
+            BSL_ERR_PUSH_ERROR(CRYPT_BN_ERR_DIVISOR_ZERO);
+            return CRYPT_BN_ERR_DIVISOR_ZERO;
+        }
+    }
+    return CRYPT_SUCCESS;
+}
+
+int32_t BN_ModInvBatch(BN_BigNum *r[], BN_BigNum *const a[], uint32_t num, const BN_BigNum *m, BN_Optimizer *opt)
+{
+    int32_t ret = InverseBatchInputCheck(r, a, num, m, opt);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    ret = OptimizerStart(opt); // use the optimizer
+    if (ret != CRYPT_SUCCESS) {
+        BSL_ERR_PUSH_ERROR(ret);
+        return ret;
+    }
+    BN_BigNum *inv = OptimizerGetBn(opt, m->size);
+    if (inv == NULL) {
+        BSL_ERR_PUSH_ERROR(CRYPT_BN_OPTIMIZER_GET_FAIL);
+        ret = CRYPT_BN_OPTIMIZER_GET_FAIL;
+        goto ERR;
+    }
+    /* r[i] = a[0] * a[1] * ... * a[i] */
+    ret = BN_Mod(r[0], a[0], m, opt);
+    for (uint32_t i = 1; i < num && ret == CRYPT_SUCCESS; i++) {
+        ret = BN_ModMul(r[i], r[i - 1], a[i], m, opt);
+    }
+    if (ret != CRYPT_SUCCESS) {
+        BSL_ERR_PUSH_ERROR(ret);
+        goto ERR;
+    }
+    /* inv = 1 / (a[0] * a[1] * ... * a[num - 1]), the only inversion */
+    ret = BN_ModInv(inv, r[num - 1], m, opt);
+    if (ret != CRYPT_SUCCESS) {
+        BSL_ERR_PUSH_ERROR(ret);
+        goto ERR;
+    }
+    for (uint32_t i = num - 1; i > 0 && ret == CRYPT_SUCCESS; i--) {
+        /* r[i] = (a[0] * ... * a[i - 1]) / (a[0] * ... * a[i]) = 1 / a[i] */
+        ret = BN_ModMul(r[i], r[i - 1], inv, m, opt);
+        if (ret == CRYPT_SUCCESS) {
+            /* inv = 1 / (a[0] * ... * a[i - 1]) */
+            ret = BN_ModMul(inv, inv, a[i], m, opt);
+        }
+    }
+    if (ret == CRYPT_SUCCESS) {
+        ret = BN_Copy(r[0], inv);
+    }
+    if (ret != CRYPT_SUCCESS) {
+        BSL_ERR_PUSH_ERROR(ret);
+    }
+ERR:
+    OptimizerEnd(opt); // Release occupation from the optimizer.
+    return ret;
+}
 #endif /* HITLS_CRYPTO_BN */
@@ -65,6 +65,7 @@ static void EalPkeyCopyMethod(const EAL_PkeyMethod *method, EAL_PkeyUnitaryMetho
     dest->decaps = method->decaps;
     dest->blind = method->blind;
     dest->unBlind = method->unBlind;
+    dest->verifyBatch = method->verifyBatch;
 }
 
 CRYPT_EAL_PkeyCtx *PkeyNewDefaultCtx(CRYPT_PKEY_AlgId id)
@@ -1452,6 +1453,9 @@ static int32_t CRYPT_EAL_SetSignMethod(const CRYPT_EAL_Func *funcSign, EAL_PkeyU
                 case CRYPT_EAL_IMPLPKEYSIGN_RECOVER:
                     method->recover = funcSign[index].func;
                     break;
+                case CRYPT_EAL_IMPLPKEYSIGN_VERIFYBATCH:
+                    method->verifyBatch = funcSign[index].func;
+                    break;
                 default:
                     BSL_ERR_PUSH_ERROR(CRYPT_PROVIDER_ERR_UNEXPECTED_IMPL);
                     return CRYPT_PROVIDER_ERR_UNEXPECTED_IMPL;
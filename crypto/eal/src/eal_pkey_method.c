@@ -67,14 +67,16 @@
 
 #define EAL_PKEY_METHOD_DEFINE(id, \
     newCtx, dupCtx, freeCtx, setPara, getPara, gen, ctrl, setPub, setPrv, getPub, getPrv, sign, signData, verify, \
-    verifyData, recover, computeShareKey, encrypt, decrypt, check, cmp, copyParam, encaps, decaps, blind, unBlind) { \
+    verifyData, recover, computeShareKey, encrypt, decrypt, check, cmp, copyParam, encaps, decaps, blind, unBlind, \
+    verifyBatch) { \
     id, (PkeyNew)(newCtx), (PkeyDup)(dupCtx), (PkeyFree)(freeCtx), \
     (PkeySetPara)(setPara), (PkeyGetPara)(getPara), (PkeyGen)(gen), (PkeyCtrl)(ctrl), \
     (PkeySetPub)(setPub), (PkeySetPrv)(setPrv), (PkeyGetPub)(getPub), (PkeyGetPrv)(getPrv), \
     (PkeySign)(sign), (PkeySignData)(signData), (PkeyVerify)(verify), (PkeyVerifyData)(verifyData), \
     (PkeyRecover)(recover), (PkeyComputeShareKey)(computeShareKey), \
     (PkeyCrypt)(encrypt), (PkeyCrypt)(decrypt), (PkeyCheck)(check), (PkeyCmp)(cmp), (PkeyCopyParam)(copyParam), \
-    (PkeyEncapsulate)(encaps), (PkeyDecapsulate)(decaps), (PkeyBlind)(blind), (PkeyUnBlind)(unBlind)}
+    (PkeyEncapsulate)(encaps), (PkeyDecapsulate)(decaps), (PkeyBlind)(blind), (PkeyUnBlind)(unBlind), \
+    (PkeyVerifyBatch)(verifyBatch)}
 
 static const EAL_PkeyMethod METHODS[] = {
 #ifdef HITLS_CRYPTO_DSA
@@ -105,7 +107,8 @@ static const EAL_PkeyMethod METHODS[] = {
         NULL, // pkeyEncaps
         NULL, // pkeyDecaps
         NULL, // blind
-        NULL  // unBlind
+        NULL, // unBlind
+        NULL  // verifyBatch
     ), // CRYPT_PKEY_DSA
 #endif
 #ifdef HITLS_CRYPTO_ED25519
@@ -136,7 +139,8 @@ static const EAL_PkeyMethod METHODS[] = {
         NULL, // pkeyEncaps
         NULL, // pkeyDecaps
         NULL, // blind
-        NULL  // unBlind
+        NULL, // unBlind
+        NULL  // verifyBatch
     ), // CRYPT_PKEY_ED25519
 #endif
 #ifdef HITLS_CRYPTO_X25519
@@ -167,7 +171,8 @@ static const EAL_PkeyMethod METHODS[] = {
         NULL, // pkeyEncaps
         NULL, // pkeyDecaps
         NULL, // blind
-        NULL  // unBlind
+        NULL, // unBlind
+        NULL  // verifyBatch
     ), // CRYPT_PKEY_X25519
 #endif
 #ifdef HITLS_CRYPTO_RSA
@@ -227,14 +232,15 @@ static const EAL_PkeyMethod METHODS[] = {
         NULL, // blind
 #endif
 #ifdef HITLS_CRYPTO_RSA_VERIFY
-        CRYPT_RSA_UnBlind  // unBlind
+        CRYPT_RSA_UnBlind, // unBlind
 #else
-        NULL  // unBlind
+        NULL, // unBlind
 #endif
 #else
         NULL, // blind
-        NULL  // unBlind
+        NULL, // unBlind
 #endif
+        NULL  // verifyBatch
     ),
 #endif
 #ifdef HITLS_CRYPTO_DH
@@ -265,7 +271,8 @@ static const EAL_PkeyMethod METHODS[] = {
         NULL, // pkeyEncaps
         NULL, // pkeyDecaps
         NULL, // blind
-        NULL  // unBlind
+        NULL, // unBlind
+        NULL  // verifyBatch
     ),
 #endif
 #ifdef HITLS_CRYPTO_ECDSA
@@ -296,7 +303,8 @@ static const EAL_PkeyMethod METHODS[] = {
         NULL, // pkeyEncaps
         NULL, // pkeyDecaps
         NULL, // blind
-        NULL  // unBlind
+        NULL, // unBlind
+        CRYPT_ECDSA_VerifyBatch
     ),
 #endif
 #ifdef HITLS_CRYPTO_ECDH
@@ -327,7 +335,8 @@ static const EAL_PkeyMethod METHODS[] = {
         NULL, // pkeyEncaps
         NULL, // pkeyDecaps
         NULL, // blind
-        NULL  // unBlind
+        NULL, // unBlind
+        NULL  // verifyBatch
     ),
 #endif
 #ifdef HITLS_CRYPTO_SM2
@@ -374,7 +383,12 @@ static const EAL_PkeyMethod METHODS[] = {
         NULL, // pkeyEncaps
         NULL, // pkeyDecaps
         NULL, // blind
-        NULL  // unBlind
+        NULL, // unBlind
+#ifdef HITLS_CRYPTO_SM2_SIGN
+        CRYPT_SM2_VerifyBatch
+#else
+        NULL  // verifyBatch
+#endif
     ), // CRYPT_PKEY_SM2
 #endif
 #ifdef HITLS_CRYPTO_PAILLIER
@@ -405,7 +419,8 @@ static const EAL_PkeyMethod METHODS[] = {
         NULL, // pkeyEncaps
         NULL, // pkeyDecaps
         NULL, // blind
-        NULL  // unBlind
+        NULL, // unBlind
+        NULL  // verifyBatch
     ), // CRYPT_PKEY_PAILLIER
 #endif
 #ifdef HITLS_CRYPTO_ELGAMAL
@@ -436,7 +451,8 @@ static const EAL_PkeyMethod METHODS[] = {
         NULL, // pkeyEncaps
         NULL, // pkeyDecaps
         NULL, // blind
-        NULL  // unBlind
+        NULL, // unBlind
+        NULL  // verifyBatch
     ), // CRYPT_PKEY_ELGAMAL
 #endif
 #ifdef HITLS_CRYPTO_MLKEM
@@ -467,7 +483,8 @@ static const EAL_PkeyMethod METHODS[] = {
         CRYPT_ML_KEM_Encaps,
         CRYPT_ML_KEM_Decaps,
         NULL, // blind
-        NULL  // unBlind
+        NULL, // unBlind
+        NULL  // verifyBatch
     ),
 #endif
 #ifdef HITLS_CRYPTO_MLDSA
@@ -498,7 +515,8 @@ static const EAL_PkeyMethod METHODS[] = {
         NULL, // pkeyEncaps
         NULL, // pkeyDecaps
         NULL, // blind
-        NULL  // unBlind
+        NULL, // unBlind
+        NULL  // verifyBatch
     ),
 #endif
 #ifdef HITLS_CRYPTO_SLH_DSA
@@ -529,7 +547,8 @@ static const EAL_PkeyMethod METHODS[] = {
         NULL,
         NULL,
         NULL,
-        NULL
+        NULL,
+        NULL  // verifyBatch
     ),
 #endif
 #ifdef HITLS_CRYPTO_HYBRIDKEM
@@ -560,7 +579,8 @@ static const EAL_PkeyMethod METHODS[] = {
         CRYPT_HYBRID_KEM_Encaps,
         CRYPT_HYBRID_KEM_Decaps,
         NULL, // blind
-        NULL  // unBlind
+        NULL, // unBlind
+        NULL  // verifyBatch
     ),
 #endif
 };
@@ -115,6 +115,122 @@ int32_t CRYPT_EAL_PkeyVerifyData(const CRYPT_EAL_PkeyCtx *pkey, const uint8_t *h
     return ret;
 }
 
+#define EAL_VERIFY_BATCH_MAX_THREAD 64
+
+typedef struct {
+    const CRYPT_EAL_PkeyCtx *const *pkeys;
+    const CRYPT_VerifyItem *items;
+    const void **keys; // The algorithm contexts of pkeys
+    int32_t *results;
+    uint32_t num;
+    CRYPT_MD_AlgId id;
+} EalVerifyBatchJob;
+
+static bool EalPkeyCanVerifyBatch(const CRYPT_EAL_PkeyCtx *pkey)
+{
+    return (pkey != NULL) && (pkey->method != NULL) && (pkey->method->verifyBatch != NULL);
+}
+
+// Consecutive items whose keys have the same batch method are verified by one call.
+static void EalVerifyBatchJobRun(const EalVerifyBatchJob *job)
+{
+    uint32_t i = 0;
+    while (i < job->num) {
+        const CRYPT_EAL_PkeyCtx *pkey = job->pkeys[i];
+        if (!EalPkeyCanVerifyBatch(pkey)) {
+            job->results[i] = CRYPT_EAL_PkeyVerify(pkey, job->id, job->items[i].data, job->items[i].dataLen,
+                job->items[i].sign, job->items[i].signLen);
+            i++;
+            continue;
+        }
+        uint32_t end = i;
+        while ((end < job->num) && EalPkeyCanVerifyBatch(job->pkeys[end]) &&
+            (job->pkeys[end]->method->verifyBatch == pkey->method->verifyBatch)) {
+            job->keys[end] = job->pkeys[end]->key;
+            end++;
+        }
+        (void)pkey->method->verifyBatch(job->keys + i, job->id, job->items + i, end - i, job->results + i);
+        for (; i < end; i++) {
+            EAL_EventReport((job->results[i] == CRYPT_SUCCESS) ? CRYPT_EVENT_VERIFY : CRYPT_EVENT_ERR,
+                CRYPT_ALGO_PKEY, job->pkeys[i]->id, job->results[i]);
+        }
+    }
+}
+
+#if defined(HITLS_BSL_SAL_THREAD) && defined(HITLS_BSL_SAL_LINUX)
+static void *EalVerifyBatchWorker(void *arg)
+{
+    EalVerifyBatchJob *job = (EalVerifyBatchJob *)arg;
+    EalVerifyBatchJobRun(job);
+    // The error stack of a worker is not seen by the caller, the caller pushes the first failed result instead.
+    BSL_ERR_RemoveErrorStack(false);
+    return NULL;
+}
+
+// The items are dealt to threadNum jobs of contiguous items, the calling thread runs the first job.
+static void EalVerifyBatchParallel(const EalVerifyBatchJob *all, uint32_t threadNum)
+{
+    EalVerifyBatchJob jobs[EAL_VERIFY_BATCH_MAX_THREAD];
+    BSL_SAL_ThreadId thread[EAL_VERIFY_BATCH_MAX_THREAD] = {0};
+    uint32_t start = 0;
+    for (uint32_t t = 0; t < threadNum; t++) {
+        uint32_t num = all->num / threadNum + ((t < all->num % threadNum) ? 1 : 0);
+        jobs[t] = *all;
+        jobs[t].pkeys += start;
+        jobs[t].items += start;
+        jobs[t].keys += start;
+        jobs[t].results += start;
+        jobs[t].num = num;
+        start += num;
+        if (t != 0 && BSL_SAL_ThreadCreate(&thread[t], EalVerifyBatchWorker, &jobs[t]) != BSL_SUCCESS) {
+            thread[t] = NULL; // run by the calling thread below
+        }
+    }
+    EalVerifyBatchJobRun(&jobs[0]);
+    for (uint32_t t = 1; t < threadNum; t++) {
+        if (thread[t] != NULL) {
+            BSL_SAL_ThreadClose(thread[t]);
+        } else {
+            EalVerifyBatchJobRun(&jobs[t]);
+        }
+    }
+}
+#endif
+
+int32_t CRYPT_EAL_PkeyVerifyBatch(const CRYPT_EAL_PkeyCtx *const *pkeys, CRYPT_MD_AlgId id,
+    const CRYPT_VerifyItem *items, uint32_t num, uint32_t threadNum, int32_t *results)
+{
+    if (pkeys == NULL || items == NULL || results == NULL || num == 0) {
+        EAL_ERR_REPORT(CRYPT_EVENT_ERR, CRYPT_ALGO_PKEY, CRYPT_PKEY_MAX, CRYPT_NULL_INPUT);
+        return CRYPT_NULL_INPUT;
+    }
+    const void **keys = BSL_SAL_Calloc(num, sizeof(void *));
+    if (keys == NULL) {
+        EAL_ERR_REPORT(CRYPT_EVENT_ERR, CRYPT_ALGO_PKEY, CRYPT_PKEY_MAX, CRYPT_MEM_ALLOC_FAIL);
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    EalVerifyBatchJob job = {pkeys, items, keys, results, num, id};
+#if defined(HITLS_BSL_SAL_THREAD) && defined(HITLS_BSL_SAL_LINUX)
+    uint32_t maxThread = (num < EAL_VERIFY_BATCH_MAX_THREAD) ? num : EAL_VERIFY_BATCH_MAX_THREAD;
+    if (threadNum > 1) {
+        EalVerifyBatchParallel(&job, (threadNum < maxThread) ? threadNum : maxThread);
+    } else {
+        EalVerifyBatchJobRun(&job);
+    }
+#else
+    (void)threadNum;
+    EalVerifyBatchJobRun(&job);
+#endif
+    BSL_SAL_Free(keys);
+    for (uint32_t i = 0; i < num; i++) {
+        if (results[i] != CRYPT_SUCCESS) {
+            BSL_ERR_PUSH_ERROR(results[i]);
+            return results[i];
+        }
+    }
+    return CRYPT_SUCCESS;
+}
+
 int32_t CRYPT_EAL_PkeyBlind(CRYPT_EAL_PkeyCtx *pkey, CRYPT_MD_AlgId id, const uint8_t *input, uint32_t inputLen,
     uint8_t *out, uint32_t *outLen)
 {
@@ -66,6 +66,12 @@ static CRYPT_EAL_RndCtx *EAL_RandNewDrbg(CRYPT_RAND_AlgId id, CRYPT_RandSeedMeth
 
 #define RAND_UNLOCK(ctx) (void)BSL_SAL_ThreadUnlock(((ctx)->lock))
 
+/* In the per-thread mode every thread keeps its DRBG with a thread-specific data key, which frees the DRBG when the
+   thread exits. */
+#if defined(HITLS_BSL_SAL_THREAD) && defined(HITLS_BSL_SAL_LINUX)
+#define RAND_PER_THREAD
+#endif
+
 #if defined(HITLS_CRYPTO_RAND_CB)
 static CRYPT_EAL_RandFunc g_rndFunc = NULL;
 static CRYPT_EAL_RandFuncEx g_rndFuncEx = NULL;
@@ -209,6 +215,23 @@ void EAL_SeedDrbgDeinit(bool isDefaultSeed)
 }
 #endif
 
+/* The thread DRBGs of the live threads are released with the shared one, no thread may generate with it any more.
+   The key is freed first, so that a thread exiting afterwards does not free its DRBG again. */
+static void FreeThreadDrbgs(CRYPT_EAL_RndCtx *ctx)
+{
+#ifdef RAND_PER_THREAD
+    BSL_SAL_ThreadKeyFree(ctx->threadKey);
+    ctx->threadKey = NULL;
+#endif
+    CRYPT_EAL_RndCtx *drbg = ctx->threadDrbgs;
+    while (drbg != NULL) {
+        CRYPT_EAL_RndCtx *next = drbg->next;
+        EAL_RandDeinit(drbg);
+        drbg = next;
+    }
+    ctx->threadDrbgs = NULL;
+}
+
 void EAL_RandDeinit(CRYPT_EAL_RndCtx *ctx)
 {
     if (ctx == NULL) {
@@ -219,6 +242,7 @@ void EAL_RandDeinit(CRYPT_EAL_RndCtx *ctx)
     ctx->lock = NULL;
 
     if (BSL_SAL_ThreadWriteLock(lock) != BSL_SUCCESS) { // write lock
+        FreeThreadDrbgs(ctx);
         MethFreeCtx(ctx);
         BSL_SAL_ThreadLockFree(lock);
 #ifdef HITLS_CRYPTO_ENTROPY
@@ -230,6 +254,7 @@ void EAL_RandDeinit(CRYPT_EAL_RndCtx *ctx)
 
     ctx->working = false;
     EAL_EventReport(CRYPT_EVENT_ZERO, CRYPT_ALGO_RAND, ctx->id, CRYPT_SUCCESS);
+    FreeThreadDrbgs(ctx);
     MethFreeCtx(ctx);
     (void)BSL_SAL_ThreadUnlock(lock);
     BSL_SAL_ThreadLockFree(lock); // free the lock resource
@@ -267,14 +292,8 @@ void CRYPT_EAL_SetRandCallBackEx(CRYPT_EAL_RandFuncEx func)
 }
 #endif
 
-int32_t EAL_DrbgbytesWithAdin(CRYPT_EAL_RndCtx *ctx, uint8_t *byte, uint32_t len, uint8_t *addin,
-    uint32_t addinLen)
+static int32_t DrbgGenerate(CRYPT_EAL_RndCtx *ctx, uint8_t *byte, uint32_t len, uint8_t *addin, uint32_t addinLen)
 {
-    if (ctx == NULL || ctx->meth == NULL || ctx->meth->gen == NULL || byte == NULL || len == 0) {
-        EAL_ERR_REPORT(CRYPT_EVENT_ERR, CRYPT_ALGO_RAND, CRYPT_RAND_ALGID_MAX, CRYPT_NULL_INPUT);
-        return CRYPT_NULL_INPUT;
-    }
-
     int32_t ret;
     RETURN_RAND_LOCK(ctx, ret); // write lock
     ret = CheckRndCtxState(ctx);
@@ -290,42 +309,6 @@ int32_t EAL_DrbgbytesWithAdin(CRYPT_EAL_RndCtx *ctx, uint8_t *byte, uint32_t len
     return ret;
 }
 
-int32_t EAL_DrbgSeedWithAdin(CRYPT_EAL_RndCtx *ctx, uint8_t *addin, uint32_t addinLen)
-{
-    if (ctx == NULL || ctx->meth == NULL || ctx->meth->reSeed == NULL) {
-        EAL_ERR_REPORT(CRYPT_EVENT_ERR, CRYPT_ALGO_RAND, CRYPT_RAND_ALGID_MAX, CRYPT_NULL_INPUT);
-        return CRYPT_NULL_INPUT;
-    }
-
-    int32_t ret;
-    RETURN_RAND_LOCK(ctx, ret); // write lock
-    ret = CheckRndCtxState(ctx);
-    if (ret != CRYPT_SUCCESS) {
-        RAND_UNLOCK(ctx);
-        return ret;
-    }
-
-    ret = ctx->meth->reSeed(ctx->ctx, addin, addinLen, NULL);
-    if (ret != CRYPT_SUCCESS) {
-        EAL_ERR_REPORT(CRYPT_EVENT_ERR, CRYPT_ALGO_RAND, ctx->id, ret);
-    }
-    RAND_UNLOCK(ctx);
-
-    return ret;
-}
-
-void EAL_RandDrbgFree(void *ctx)
-{
-    if (ctx == NULL) {
-        return;
-    }
-    DRBG_Ctx *drbg = (DRBG_Ctx *)ctx;
-
-    DRBG_Free(drbg);
-    return;
-}
-
-#ifdef HITLS_CRYPTO_ENTROPY
 static int32_t GetSeedDrbgEntropy(void *ctx, CRYPT_Data *entropy, uint32_t strength, CRYPT_Range *lenRange)
 {
     int32_t ret;
@@ -342,7 +325,7 @@ static int32_t GetSeedDrbgEntropy(void *ctx, CRYPT_Data *entropy, uint32_t stren
         return CRYPT_MEM_ALLOC_FAIL;
     }
 
-    ret = EAL_DrbgbytesWithAdin(seed, entropy->data, entropy->len, NULL, 0);
+    ret = DrbgGenerate(seed, entropy->data, entropy->len, NULL, 0);
     if (ret != CRYPT_SUCCESS) {
         BSL_SAL_FREE(entropy->data);
     }
@@ -364,6 +347,247 @@ void EAL_SeedDrbgEntropyMeth(CRYPT_RandSeedMethod *meth)
     meth->getNonce = GetSeedDrbgEntropy;
 }
 
+#ifdef RAND_PER_THREAD
+// Take a thread DRBG out of the list of its shared DRBG, after which the thread DRBG belongs to the caller.
+static int32_t RandUnlistThreadDrbg(CRYPT_EAL_RndCtx *drbg)
+{
+    CRYPT_EAL_RndCtx *shared = drbg->shared;
+    int32_t ret;
+    RETURN_RAND_LOCK(shared, ret);
+    if (drbg->prev != NULL) {
+        drbg->prev->next = drbg->next;
+    } else {
+        shared->threadDrbgs = drbg->next;
+    }
+    if (drbg->next != NULL) {
+        drbg->next->prev = drbg->prev;
+    }
+    drbg->prev = NULL;
+    drbg->next = NULL;
+    RAND_UNLOCK(shared);
+    return CRYPT_SUCCESS;
+}
+
+// The destructor of the thread-specific data key, a thread DRBG is freed when its thread exits.
+static void RandThreadDrbgExit(void *arg)
+{
+    CRYPT_EAL_RndCtx *drbg = (CRYPT_EAL_RndCtx *)arg;
+    if (RandUnlistThreadDrbg(drbg) == CRYPT_SUCCESS) {
+        EAL_RandDeinit(drbg);
+    }
+}
+
+#ifdef HITLS_CRYPTO_PROVIDER
+/* A thread DRBG of a provider DRBG is created by the same provider, with the provider context of the shared DRBG, so
+   that generating never leaves the provider. */
+static CRYPT_EAL_RndCtx *RandProvNewThreadDrbg(CRYPT_EAL_RndCtx *shared, CRYPT_RandSeedMethod *seedMeth)
+{
+    BSL_Param seedParam[6] = {BSL_PARAM_END};
+    int32_t ret = GetSeedParam(seedParam, seedMeth, shared);
+    if (ret != CRYPT_SUCCESS) {
+        BSL_ERR_PUSH_ERROR(ret);
+        return NULL;
+    }
+    CRYPT_EAL_RndCtx *drbg = BSL_SAL_Calloc(1, sizeof(CRYPT_EAL_RndCtx));
+    if (drbg == NULL) {
+        BSL_ERR_PUSH_ERROR(CRYPT_MEM_ALLOC_FAIL);
+        return NULL;
+    }
+    ret = BSL_SAL_ThreadLockNew(&(drbg->lock));
+    if (ret != CRYPT_SUCCESS) {
+        BSL_ERR_PUSH_ERROR(ret);
+        BSL_SAL_FREE(drbg);
+        return NULL;
+    }
+    drbg->isProvider = true;
+    drbg->id = shared->id;
+    drbg->provCtx = shared->provCtx;
+    if (EAL_RandSetMeth(shared->meth, drbg) != CRYPT_SUCCESS) {
+        goto ERR;
+    }
+    drbg->ctx = drbg->meth->provNewCtx(drbg->provCtx, drbg->id, seedParam);
+    if (drbg->ctx == NULL) {
+        BSL_ERR_PUSH_ERROR(CRYPT_EAL_ERR_DRBG_INIT_FAIL);
+        goto ERR;
+    }
+    return drbg;
+ERR:
+    BSL_SAL_ThreadLockFree(drbg->lock); // free the lock resource
+    BSL_SAL_FREE(drbg->meth);
+    BSL_SAL_FREE(drbg);
+    return NULL;
+}
+#endif
+
+/* Instantiate the DRBG of the calling thread, seeded from the shared DRBG with the same implementation. The seeding
+   takes the lock of the shared DRBG, so it is done before the DRBG is listed in it. */
+static CRYPT_EAL_RndCtx *RandNewThreadDrbg(CRYPT_EAL_RndCtx *shared, BSL_SAL_ThreadKey key, uint32_t reseedCnt)
+{
+    CRYPT_RandSeedMethod seedMeth = {0};
+    EAL_SeedDrbgEntropyMeth(&seedMeth);
+#ifdef HITLS_CRYPTO_PROVIDER
+    CRYPT_EAL_RndCtx *drbg = shared->isProvider ? RandProvNewThreadDrbg(shared, &seedMeth) :
+        EAL_RandNewDrbg(shared->id, &seedMeth, shared);
+#else
+    CRYPT_EAL_RndCtx *drbg = EAL_RandNewDrbg(shared->id, &seedMeth, shared);
+#endif
+    if (drbg == NULL) {
+        return NULL;
+    }
+    drbg->reseedCnt = reseedCnt; // Taken before seeding, so that a reseed request is never missed.
+    int32_t ret = drbg->meth->inst(drbg->ctx, NULL, 0, NULL);
+    if (ret != CRYPT_SUCCESS) {
+        BSL_ERR_PUSH_ERROR(ret);
+        EAL_RandDeinit(drbg);
+        return NULL;
+    }
+    drbg->working = true;
+    drbg->shared = shared;
+    if (BSL_SAL_ThreadWriteLock(shared->lock) != BSL_SUCCESS) {
+        EAL_RandDeinit(drbg);
+        return NULL;
+    }
+    drbg->next = shared->threadDrbgs;
+    if (drbg->next != NULL) {
+        drbg->next->prev = drbg;
+    }
+    shared->threadDrbgs = drbg;
+    RAND_UNLOCK(shared);
+    if (BSL_SAL_ThreadSetSpecific(key, drbg) != BSL_SUCCESS) {
+        if (RandUnlistThreadDrbg(drbg) == CRYPT_SUCCESS) {
+            EAL_RandDeinit(drbg);
+        }
+        return NULL;
+    }
+    return drbg;
+}
+
+/* Generate with the DRBG of the calling thread. No other thread uses it, so it generates without a lock.
+   The shared DRBG is only read locked to check it, and write locked to seed a new thread DRBG. A thread DRBG keeps its
+   own reseed interval and health tests. */
+static int32_t RandThreadDrbgbytes(CRYPT_EAL_RndCtx *shared, uint8_t *byte, uint32_t len, uint8_t *addin,
+    uint32_t addinLen)
+{
+    int32_t ret = BSL_SAL_ThreadReadLock(shared->lock);
+    if (ret != BSL_SUCCESS) {
+        BSL_ERR_PUSH_ERROR(ret);
+        return ret;
+    }
+    ret = CheckRndCtxState(shared);
+    BSL_SAL_ThreadKey key = shared->threadKey;
+    uint32_t reseedCnt = shared->reseedCnt;
+    RAND_UNLOCK(shared);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    CRYPT_EAL_RndCtx *drbg = BSL_SAL_ThreadGetSpecific(key);
+    if (drbg == NULL) {
+        drbg = RandNewThreadDrbg(shared, key, reseedCnt);
+        if (drbg == NULL) {
+            EAL_ERR_REPORT(CRYPT_EVENT_ERR, CRYPT_ALGO_RAND, shared->id, CRYPT_EAL_ERR_DRBG_INIT_FAIL);
+            return CRYPT_EAL_ERR_DRBG_INIT_FAIL;
+        }
+    }
+
+    // A reseed of the shared DRBG is requested, the thread DRBG follows it before the next output.
+    if (drbg->reseedCnt != reseedCnt) {
+        ret = drbg->meth->reSeed(drbg->ctx, NULL, 0, NULL);
+        if (ret != CRYPT_SUCCESS) {
+            EAL_ERR_REPORT(CRYPT_EVENT_ERR, CRYPT_ALGO_RAND, shared->id, ret);
+            return ret;
+        }
+        drbg->reseedCnt = reseedCnt;
+    }
+    ret = drbg->meth->gen(drbg->ctx, byte, len, addin, addinLen, NULL);
+    EAL_EventReport((ret == CRYPT_SUCCESS) ? CRYPT_EVENT_RANDGEN : CRYPT_EVENT_ERR, CRYPT_ALGO_RAND, shared->id, ret);
+    return ret;
+}
+
+// Every thread gets its own DRBG through the key, which is created once the mode is switched on. Called with the lock.
+static int32_t RandEnablePerThread(CRYPT_EAL_RndCtx *ctx)
+{
+    if (ctx->threadKey == NULL) {
+        int32_t ret = BSL_SAL_ThreadKeyNew(&ctx->threadKey, RandThreadDrbgExit);
+        if (ret != BSL_SUCCESS) {
+            BSL_ERR_PUSH_ERROR(ret);
+            return ret;
+        }
+    }
+    ctx->perThread = true;
+    return CRYPT_SUCCESS;
+}
+#else
+static int32_t RandThreadDrbgbytes(CRYPT_EAL_RndCtx *shared, uint8_t *byte, uint32_t len, uint8_t *addin,
+    uint32_t addinLen)
+{
+    (void)byte;
+    (void)len;
+    (void)addin;
+    (void)addinLen;
+    EAL_ERR_REPORT(CRYPT_EVENT_ERR, CRYPT_ALGO_RAND, shared->id, CRYPT_NOT_SUPPORT);
+    return CRYPT_NOT_SUPPORT;
+}
+
+// Without the thread-specific data of the SAL there is no per-thread mode.
+static int32_t RandEnablePerThread(CRYPT_EAL_RndCtx *ctx)
+{
+    (void)ctx;
+    BSL_ERR_PUSH_ERROR(CRYPT_NOT_SUPPORT);
+    return CRYPT_NOT_SUPPORT;
+}
+#endif
+
+int32_t EAL_DrbgbytesWithAdin(CRYPT_EAL_RndCtx *ctx, uint8_t *byte, uint32_t len, uint8_t *addin,
+    uint32_t addinLen)
+{
+    if (ctx == NULL || ctx->meth == NULL || ctx->meth->gen == NULL || byte == NULL || len == 0) {
+        EAL_ERR_REPORT(CRYPT_EVENT_ERR, CRYPT_ALGO_RAND, CRYPT_RAND_ALGID_MAX, CRYPT_NULL_INPUT);
+        return CRYPT_NULL_INPUT;
+    }
+    if (ctx->perThread) {
+        return RandThreadDrbgbytes(ctx, byte, len, addin, addinLen);
+    }
+    return DrbgGenerate(ctx, byte, len, addin, addinLen);
+}
+
+int32_t EAL_DrbgSeedWithAdin(CRYPT_EAL_RndCtx *ctx, uint8_t *addin, uint32_t addinLen)
+{
+    if (ctx == NULL || ctx->meth == NULL || ctx->meth->reSeed == NULL) {
+        EAL_ERR_REPORT(CRYPT_EVENT_ERR, CRYPT_ALGO_RAND, CRYPT_RAND_ALGID_MAX, CRYPT_NULL_INPUT);
+        return CRYPT_NULL_INPUT;
+    }
+
+    int32_t ret;
+    RETURN_RAND_LOCK(ctx, ret); // write lock
+    ret = CheckRndCtxState(ctx);
+    if (ret != CRYPT_SUCCESS) {
+        RAND_UNLOCK(ctx);
+        return ret;
+    }
+
+    ret = ctx->meth->reSeed(ctx->ctx, addin, addinLen, NULL);
+    if (ret != CRYPT_SUCCESS) {
+        EAL_ERR_REPORT(CRYPT_EVENT_ERR, CRYPT_ALGO_RAND, ctx->id, ret);
+    } else if (ctx->perThread) {
+        ctx->reseedCnt++;
+    }
+    RAND_UNLOCK(ctx);
+
+    return ret;
+}
+
+void EAL_RandDrbgFree(void *ctx)
+{
+    if (ctx == NULL) {
+        return;
+    }
+    DRBG_Ctx *drbg = (DRBG_Ctx *)ctx;
+
+    DRBG_Free(drbg);
+    return;
+}
+
+#ifdef HITLS_CRYPTO_ENTROPY
 static int32_t SetSeedDrbgReseedInfo(CRYPT_EAL_RndCtx *rndCtx)
 {
     int32_t ret;
@@ -667,6 +891,23 @@ void CRYPT_EAL_DrbgDeinit(CRYPT_EAL_RndCtx *ctx)
     return;
 }
 
+static int32_t RandSetPerThread(CRYPT_EAL_RndCtx *rndCtx, const void *val, uint32_t len)
+{
+    if (val == NULL) {
+        BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
+        return CRYPT_NULL_INPUT;
+    }
+    if (len != sizeof(int32_t)) {
+        BSL_ERR_PUSH_ERROR(CRYPT_INVALID_ARG);
+        return CRYPT_INVALID_ARG;
+    }
+    if (*(const int32_t *)val == 0) {
+        rndCtx->perThread = false;
+        return CRYPT_SUCCESS;
+    }
+    return RandEnablePerThread(rndCtx);
+}
+
 int32_t CRYPT_EAL_DrbgCtrl(CRYPT_EAL_RndCtx *rndCtx, int32_t opt, void *val, uint32_t len)
 {
     if (rndCtx == NULL || rndCtx->meth == NULL || rndCtx->meth->ctrl == NULL) {
@@ -680,11 +921,39 @@ int32_t CRYPT_EAL_DrbgCtrl(CRYPT_EAL_RndCtx *rndCtx, int32_t opt, void *val, uin
         BSL_ERR_PUSH_ERROR(CRYPT_EAL_ERR_RAND_WORKING);
         return CRYPT_EAL_ERR_RAND_WORKING;
     }
-    ret = rndCtx->meth->ctrl(rndCtx->ctx, opt, val, len);
+    if (opt == CRYPT_CTRL_SET_RAND_PER_THREAD) {
+        ret = RandSetPerThread(rndCtx, val, len);
+    } else {
+        ret = rndCtx->meth->ctrl(rndCtx->ctx, opt, val, len);
+    }
     RAND_UNLOCK(rndCtx);
     return ret;
 }
 
+// Switch an instantiated global DRBG to the per-thread mode when CRYPT_PARAM_RAND_PER_THREAD is true.
+static int32_t RandSetPerThreadByParam(CRYPT_EAL_RndCtx *ctx, const BSL_Param *param)
+{
+    const BSL_Param *temp = BSL_PARAM_FindConstParam(param, CRYPT_PARAM_RAND_PER_THREAD);
+    if (temp == NULL) {
+        return CRYPT_SUCCESS;
+    }
+    bool perThread = false;
+    uint32_t boolSize = sizeof(bool);
+    int32_t ret = BSL_PARAM_GetValue(temp, CRYPT_PARAM_RAND_PER_THREAD, BSL_PARAM_TYPE_BOOL, (void *)&perThread,
+        &boolSize);
+    if (ret != CRYPT_SUCCESS) {
+        BSL_ERR_PUSH_ERROR(ret);
+        return ret;
+    }
+    if (!perThread) {
+        return CRYPT_SUCCESS;
+    }
+    RETURN_RAND_LOCK(ctx, ret);
+    ret = RandEnablePerThread(ctx);
+    RAND_UNLOCK(ctx);
+    return ret;
+}
+
 #ifdef HITLS_CRYPTO_PROVIDER
 int32_t CRYPT_EAL_SetRandMethod(CRYPT_EAL_RndCtx *ctx, const CRYPT_EAL_Func *funcs)
 {
@@ -757,6 +1026,7 @@ static CRYPT_EAL_RndCtx *EAL_ProvRandInitDrbg(CRYPT_EAL_LibCtx *libCtx, CRYPT_RA
     randCtx->isProvider = true;
     randCtx->working = false;
     randCtx->id = id;
+    randCtx->provCtx = provCtx;
 
     ret = CRYPT_EAL_SetRandMethod(randCtx, funcs);
     if (ret != CRYPT_SUCCESS) {
@@ -818,6 +1088,11 @@ int32_t CRYPT_EAL_ProviderRandInitCtxInner(CRYPT_EAL_LibCtx *libCtx, int32_t alg
         EAL_RandDeinit(ctx);
         return ret;
     }
+    ret = RandSetPerThreadByParam(ctx, param);
+    if (ret != CRYPT_SUCCESS) {
+        EAL_RandDeinit(ctx);
+        return ret;
+    }
     ctx->working = true;
     CRYPT_RandRegistEx((CRYPT_EAL_RandFuncEx)CRYPT_EAL_RandbytesEx); // provide a random number generation function for BigNum.
     localLibCtx->drbg = ctx;
@@ -863,6 +1138,11 @@ int32_t CRYPT_EAL_NoProviderRandInitCtxInner(int32_t algId,
     }
     if (ret != CRYPT_SUCCESS) {
         BSL_ERR_PUSH_ERROR(ret);
+        return ret;
+    }
+    ret = RandSetPerThreadByParam(g_globalRndCtx, param);
+    if (ret != CRYPT_SUCCESS) {
+        CRYPT_EAL_RandDeinit();
     }
 ERR:
     return ret;
@@ -116,6 +116,21 @@ bool IsSupportAVX512BW(void)
     return g_cpuState.code7Out[EBX_OUT_IDX] & bit_AVX512BW;
 }
 
+bool IsSupportGFNI(void)
+{
+    return g_cpuState.code7Out[ECX_OUT_IDX] & bit_GFNI;
+}
+
+bool IsSupportVAES(void)
+{
+    return g_cpuState.code7Out[ECX_OUT_IDX] & bit_VAES;
+}
+
+bool IsSupportVPCLMULQDQ(void)
+{
+    return g_cpuState.code7Out[ECX_OUT_IDX] & bit_VPCLMULQDQ;
+}
+
 bool IsSupportXSAVE(void)
 {
     return g_cpuState.code1Out[ECX_OUT_IDX] & bit_XSAVE;
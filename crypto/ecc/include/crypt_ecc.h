@@ -189,6 +189,20 @@ int32_t ECC_GetPoint2Bn(const ECC_Para *para, ECC_Point *pt, BN_BigNum *x, BN_Bi
  */
 int32_t ECC_GetPointDataX(const ECC_Para *para, ECC_Point *pt, BN_BigNum *x);
 
+/**
+ * @ingroup ecc
+ * @brief Convert the Jacobian coordinate points (x, y, z) to affine coordinate (x/z^2, y/z^3, 1)
+ *        with one modular inversion for all of them, the points at infinity are kept.
+ *
+ * @param para [IN] Curve parameter information
+ * @param pt [IN/OUT] Points (x, y, z) -> (x/z^2, y/z^3, 1)
+ * @param ptNums [IN] Number of the points
+ *
+ * @retval CRYPT_SUCCESS succeeded.
+ * @retval For details about other errors, see crypt_errno.h.
+ */
+int32_t ECC_Points2Affine(const ECC_Para *para, ECC_Point *pt[], uint32_t ptNums);
+
 /**
  * @ingroup ecc
  * @brief Calculate r = k * pt. When pt is NULL, calculate r = k * G, where G is the generator
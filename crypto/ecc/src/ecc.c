@@ -167,6 +167,15 @@ int32_t ECC_Point2Affine(const ECC_Para *para, ECC_Point *r, const ECC_Point *a)
     return ret;
 }
 
+int32_t ECC_Points2Affine(const ECC_Para *para, ECC_Point *pt[], uint32_t ptNums)
+{
+    int32_t ret = ECP_Points2Affine(para, pt, ptNums);
+    if (ret != CRYPT_SUCCESS) {
+        BSL_ERR_PUSH_ERROR(ret);
+    }
+    return ret;
+}
+
 int32_t ECC_GetPoint2Bn(const ECC_Para *para, ECC_Point *pt, BN_BigNum *x, BN_BigNum *y)
 {
     int32_t ret;
@@ -190,7 +199,9 @@ int32_t ECC_GetPointDataX(const ECC_Para *para, ECC_Point *pt, BN_BigNum *x)
         BSL_ERR_PUSH_ERROR(CRYPT_ECC_NOT_SUPPORT);
         return CRYPT_ECC_NOT_SUPPORT;
     }
-    GOTO_ERR_IF(para->method->point2Affine(para, pt, pt), ret);
+    if (!BN_IsOne(pt->z)) {
+        GOTO_ERR_IF(para->method->point2Affine(para, pt, pt), ret);
+    }
     GOTO_ERR_IF(BN_Copy(x, pt->x), ret);
 ERR:
     return ret;
@@ -150,10 +150,8 @@ int32_t ECP_Point2Affine(const ECC_Para *para, ECC_Point *r, const ECC_Point *pt
 
 /**
  * @ingroup ecc
- * @brief   Converts all point information on pt to affine coordinate system,
- *          which is used for the coordinate system conversion of the pre-computation table.
- *
- * @attention pt[0] cannot be an infinite point.
+ * @brief   Converts all point information on pt to affine coordinate system with one modular inversion
+ *          (Montgomery's trick), the points at infinity are kept.
  *
  * @param   para [IN] Curve parameters
  * @param   pt [IN/OUT] Point information
@@ -20,6 +20,7 @@
 #include "bsl_err_internal.h"
 #include "ecp_nistp224.h"
 #include "ecp_nistp256.h"
+#include "ecp_nistp384.h"
 #include "ecp_nistp521.h"
 #include "ecp_sm2.h"
 
@@ -30,9 +31,8 @@ typedef struct {
 } ECC_MethodMap;
 
 #if defined(HITLS_SIXTY_FOUR_BITS)
-#if (((defined(HITLS_CRYPTO_CURVE_NISTP224) || defined(HITLS_CRYPTO_CURVE_NISTP521)) && \
-        !defined(HITLS_CRYPTO_NIST_USE_ACCEL)) || \
-    defined(HITLS_CRYPTO_CURVE_NISTP384) || \
+#if (((defined(HITLS_CRYPTO_CURVE_NISTP224) || defined(HITLS_CRYPTO_CURVE_NISTP384) || \
+        defined(HITLS_CRYPTO_CURVE_NISTP521)) && !defined(HITLS_CRYPTO_NIST_USE_ACCEL)) || \
     (defined(HITLS_CRYPTO_CURVE_NISTP256) && (!defined(HITLS_CRYPTO_CURVE_NISTP256_ASM) || \
         (!defined(HITLS_CRYPTO_NIST_ECC_ACCELERATE))) && (!defined(HITLS_CRYPTO_NIST_USE_ACCEL))))
 static const ECC_Method EC_METHOD_NIST = {
@@ -148,6 +148,23 @@ static const ECC_Method EC_METHOD_NIST_P224 = {
 };
 #endif
 
+#ifdef HITLS_CRYPTO_CURVE_NISTP384
+static const ECC_Method EC_METHOD_NIST_P384 = {
+    .pointMulAdd = ECP384_PointMulAdd,
+    .pointMul = ECP384_PointMul,
+    .pointMulFast = ECP384_PointMul,
+    .pointAddAffine = ECP_NistPointAddAffine,
+    .pointDouble = ECP_NistPointDouble,
+    .pointMultDouble = ECP_NistPointMultDouble,
+    .modInv = BN_ModInv,
+    .point2AffineWithInv = ECP_Point2AffineWithInv,
+    .point2Affine = ECP384_Point2Affine,
+    .bnModNistEccMul = BN_ModNistEccMul,
+    .bnModNistEccSqr = BN_ModNistEccSqr,
+    .modOrdInv = ECP_ModOrderInv,
+};
+#endif
+
 #ifdef HITLS_CRYPTO_CURVE_NISTP521
 static const ECC_Method EC_METHOD_NIST_P521 = {
     .pointMulAdd = ECP521_PointMulAdd,
@@ -213,7 +230,9 @@ static const ECC_MethodMap EC_METHODS[] = {
 
 // p384
 #ifdef HITLS_CRYPTO_CURVE_NISTP384
-    #if defined(HITLS_SIXTY_FOUR_BITS)
+    #ifdef HITLS_CRYPTO_NIST_USE_ACCEL
+        { CRYPT_ECC_NISTP384, &EC_METHOD_NIST_P384 }, // Non-assembly optimization, depending on uint128
+    #elif defined(HITLS_SIXTY_FOUR_BITS)
         { CRYPT_ECC_NISTP384, &EC_METHOD_NIST }, // Common nist calculation + fast modulus reduction of Bn
     #else
         { CRYPT_ECC_NISTP384, &EC_METHOD_NIST_MONT },
@@ -0,0 +1,2007 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include "hitls_build.h"
+#if defined(HITLS_CRYPTO_CURVE_NISTP384) && defined(HITLS_CRYPTO_NIST_USE_ACCEL)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "bsl_err_internal.h"
+#include "crypt_bn.h"
+#include "crypt_errno.h"
+#include "crypt_utils.h"
+#include "crypt_ecc.h"
+#include "ecc_local.h"
+#include "ecc_utils.h"
+#include "bsl_util_internal.h"
+
+#ifndef __SIZEOF_INT128__
+#error "This nistp384 implementation require the compiler support 128-bits integer."
+#endif
+
+#define FELEM_BITS          384
+/* The field element is 6 full 64-bit limbs in the Montgomery domain, R = 2^384. */
+#define NUM_LIMBS           6
+/* The scalar has one more limb, the signed window and the wNAF may carry into bit 384. */
+#define SCALAR_LIMBS        7
+/* The comb of G has 4 tables, each table has 5 teeth that are 20 bits apart, 4 * 5 * 20 = 400 > 384 */
+#define COMB_TABLES         4
+#define COMB_TEETH          5
+#define COMB_SPACING        20
+/* Each table of the comb has 2^5 = 32 points. */
+#define TABLE_G_SIZE        32
+/* The pre-calculation table of the P point has 17 points. */
+#define TABLE_P_SIZE        17
+/* The wNAF window of G and of P during the verification */
+#define WNAF_G_WINDOW       6
+#define WNAF_P_WINDOW       5
+/* The odd multiples 1, 3, ... 2^(w-1) - 1 of G and of P */
+#define TABLE_ODD_G_SIZE    16
+#define TABLE_ODD_P_SIZE    8
+/* The wNAF of a 384-bit scalar has 385 digits at most. */
+#define WNAF_MAX_LEN        (FELEM_BITS + 1)
+/* Forcibly convert to uint128_t */
+#define U128(x)  ((uint128_t)(x))
+
+/* Obtain the nth bit of a BigNum. The BigNum is stored in the uint64_t array in little-endian order. */
+#define GET_ARRAY64_BIT(k, n) ((((k)->data)[(n) / 64] >> ((n) & 63)) & 1)
+
+typedef struct {
+    uint64_t data[SCALAR_LIMBS];
+} Array64;
+
+/* Always fully reduced, that is less than P. */
+typedef struct {
+    uint64_t data[NUM_LIMBS];
+} Felem;
+
+typedef struct {
+    Felem x, y, z; /* Each point contains three coordinates x, y, and z. */
+} Point;
+
+/* The points of the precomputation tables of G, (0, 0) is the point at infinity. */
+typedef struct {
+    Felem x, y;
+} AffinePoint;
+
+/* P = 2^384 - 2^128 - 2^96 + 2^32 - 1 */
+static const Felem FELEM_P = {{
+    0x00000000ffffffff, 0xffffffff00000000, 0xfffffffffffffffe,
+    0xffffffffffffffff, 0xffffffffffffffff, 0xffffffffffffffff
+}};
+
+/* R mod P, the value 1 in the Montgomery domain */
+static const Felem FELEM_ONE = {{
+    0xffffffff00000001, 0x00000000ffffffff, 0x0000000000000001, 0, 0, 0
+}};
+
+/* R^2 mod P, used to convert a value to the Montgomery domain */
+static const Felem FELEM_RR = {{
+    0xfffffffe00000001, 0x0000000200000000, 0xfffffffe00000000,
+    0x0000000200000000, 0x0000000000000001, 0
+}};
+
+/* -P^(-1) mod 2^64 */
+#define P384_N0 ((uint64_t)0x100000001)
+
+static inline void FelemAssign(Felem *r, const Felem *a)
+{
+    for (uint32_t i = 0; i < NUM_LIMBS; i++) {
+        r->data[i] = a->data[i];
+    }
+}
+
+static inline void FelemPointAssign(Point *ptR, const Point *ptIn)
+{
+    FelemAssign(&ptR->x, &ptIn->x);
+    FelemAssign(&ptR->y, &ptIn->y);
+    FelemAssign(&ptR->z, &ptIn->z);
+}
+
+static inline void FelemAssignWithMask(Felem *r, const Felem *a, uint64_t mask)
+{
+    uint64_t rmask = ~mask;
+    for (uint32_t i = 0; i < NUM_LIMBS; i++) {
+        r->data[i] = (a->data[i] & mask) | (r->data[i] & rmask); // Obtain a new value or remain unchanged.
+    }
+}
+
+static inline void FelemPointAssignWithMask(Point *ptR, const Point *ptIn, uint64_t mask)
+{
+    FelemAssignWithMask(&ptR->x, &ptIn->x, mask);
+    FelemAssignWithMask(&ptR->y, &ptIn->y, mask);
+    FelemAssignWithMask(&ptR->z, &ptIn->z, mask);
+}
+
+/* If a is 0, the mask is all 1s. Otherwise, the mask is 0. */
+static inline uint64_t FelemIsZero(const Felem *a)
+{
+    uint64_t bits = a->data[0] | a->data[1] | a->data[2] | a->data[3] | a->data[4] | a->data[5];
+    /* Shift rightwards by 63 bits and get the most significant bit, which is 1 only when bits != 0. */
+    return ((bits | (0 - bits)) >> 63) - 1;
+}
+
+/* Return the low 64 bits of a + b + carry, the carry out is written back. */
+static inline uint64_t AddCarry(uint64_t a, uint64_t b, uint64_t *carry)
+{
+    uint128_t t = U128(a) + b + *carry;
+    *carry = (uint64_t)(t >> 64);
+    return (uint64_t)t;
+}
+
+/* Return the low 64 bits of a - b - borrow, the borrow out is written back. */
+static inline uint64_t SubBorrow(uint64_t a, uint64_t b, uint64_t *borrow)
+{
+    uint128_t t = U128(a) - b - *borrow;
+    *borrow = (uint64_t)(t >> 64) & 1;
+    return (uint64_t)t;
+}
+
+/* Return the low 64 bits of a * b + c + carry, which is less than 2^128, the high 64 bits are written to carry. */
+static inline uint64_t MulAdd(uint64_t a, uint64_t b, uint64_t c, uint64_t *carry)
+{
+    uint128_t t = U128(a) * b + c + *carry;
+    *carry = (uint64_t)(t >> 64);
+    return (uint64_t)t;
+}
+
+/*
+ * r = (carry * 2^384 + a) mod P
+ * input:
+ *   carry * 2^384 + a < 2P
+ */
+static inline void FelemReduceOnce(Felem *r, const uint64_t a[NUM_LIMBS], uint64_t carry)
+{
+    uint64_t diff[NUM_LIMBS];
+    uint64_t borrow = 0;
+    diff[0] = SubBorrow(a[0], FELEM_P.data[0], &borrow);
+    diff[1] = SubBorrow(a[1], FELEM_P.data[1], &borrow);
+    diff[2] = SubBorrow(a[2], FELEM_P.data[2], &borrow);
+    diff[3] = SubBorrow(a[3], FELEM_P.data[3], &borrow);
+    diff[4] = SubBorrow(a[4], FELEM_P.data[4], &borrow);
+    diff[5] = SubBorrow(a[5], FELEM_P.data[5], &borrow);
+    /* a - P is kept when there is a carry or no borrow. */
+    uint64_t mask = 0 - ((carry | (borrow ^ 1)) & 1);
+    r->data[0] = (diff[0] & mask) | (a[0] & ~mask);
+    r->data[1] = (diff[1] & mask) | (a[1] & ~mask);
+    r->data[2] = (diff[2] & mask) | (a[2] & ~mask);
+    r->data[3] = (diff[3] & mask) | (a[3] & ~mask);
+    r->data[4] = (diff[4] & mask) | (a[4] & ~mask);
+    r->data[5] = (diff[5] & mask) | (a[5] & ~mask);
+}
+
+/* r = a + b (mod P) */
+static inline void FelemAdd(Felem *r, const Felem *a, const Felem *b)
+{
+    uint64_t sum[NUM_LIMBS];
+    uint64_t carry = 0;
+    sum[0] = AddCarry(a->data[0], b->data[0], &carry);
+    sum[1] = AddCarry(a->data[1], b->data[1], &carry);
+    sum[2] = AddCarry(a->data[2], b->data[2], &carry);
+    sum[3] = AddCarry(a->data[3], b->data[3], &carry);
+    sum[4] = AddCarry(a->data[4], b->data[4], &carry);
+    sum[5] = AddCarry(a->data[5], b->data[5], &carry);
+    FelemReduceOnce(r, sum, carry);
+}
+
+/* r = a - b (mod P) */
+static inline void FelemSub(Felem *r, const Felem *a, const Felem *b)
+{
+    uint64_t diff[NUM_LIMBS];
+    uint64_t borrow = 0;
+    diff[0] = SubBorrow(a->data[0], b->data[0], &borrow);
+    diff[1] = SubBorrow(a->data[1], b->data[1], &borrow);
+    diff[2] = SubBorrow(a->data[2], b->data[2], &borrow);
+    diff[3] = SubBorrow(a->data[3], b->data[3], &borrow);
+    diff[4] = SubBorrow(a->data[4], b->data[4], &borrow);
+    diff[5] = SubBorrow(a->data[5], b->data[5], &borrow);
+    /* Add P back if a < b. */
+    uint64_t mask = 0 - borrow;
+    uint64_t carry = 0;
+    r->data[0] = AddCarry(diff[0], FELEM_P.data[0] & mask, &carry);
+    r->data[1] = AddCarry(diff[1], FELEM_P.data[1] & mask, &carry);
+    r->data[2] = AddCarry(diff[2], FELEM_P.data[2] & mask, &carry);
+    r->data[3] = AddCarry(diff[3], FELEM_P.data[3] & mask, &carry);
+    r->data[4] = AddCarry(diff[4], FELEM_P.data[4] & mask, &carry);
+    r->data[5] = AddCarry(diff[5], FELEM_P.data[5] & mask, &carry);
+}
+
+/* r = -a (mod P) */
+static inline void FelemNeg(Felem *r, const Felem *a)
+{
+    const Felem zero = {{0}};
+    FelemSub(r, &zero, a);
+}
+
+/* t[0 ... 6] = t[0 ... 5] + a * b, t[6] is overwritten by the carry. */
+static inline void FelemMulAddRow(uint64_t t[NUM_LIMBS + 1], uint64_t a, const Felem *b)
+{
+    uint64_t carry = 0;
+    t[0] = MulAdd(a, b->data[0], t[0], &carry);
+    t[1] = MulAdd(a, b->data[1], t[1], &carry);
+    t[2] = MulAdd(a, b->data[2], t[2], &carry);
+    t[3] = MulAdd(a, b->data[3], t[3], &carry);
+    t[4] = MulAdd(a, b->data[4], t[4], &carry);
+    t[5] = MulAdd(a, b->data[5], t[5], &carry);
+    t[6] = carry;
+}
+
+/* t = a * b, schoolbook multiplication of 6 limbs. */
+static inline void FelemMulWide(uint64_t t[NUM_LIMBS * 2], const Felem *a, const Felem *b)
+{
+    uint64_t carry = 0;
+    t[0] = MulAdd(a->data[0], b->data[0], 0, &carry);
+    t[1] = MulAdd(a->data[0], b->data[1], 0, &carry);
+    t[2] = MulAdd(a->data[0], b->data[2], 0, &carry);
+    t[3] = MulAdd(a->data[0], b->data[3], 0, &carry);
+    t[4] = MulAdd(a->data[0], b->data[4], 0, &carry);
+    t[5] = MulAdd(a->data[0], b->data[5], 0, &carry);
+    t[6] = carry;
+    FelemMulAddRow(t + 1, a->data[1], b);
+    FelemMulAddRow(t + 2, a->data[2], b);
+    FelemMulAddRow(t + 3, a->data[3], b);
+    FelemMulAddRow(t + 4, a->data[4], b);
+    FelemMulAddRow(t + 5, a->data[5], b);
+}
+
+/* t = a^2, the cross products are calculated once and doubled. */
+static inline void FelemSqrWide(uint64_t t[NUM_LIMBS * 2], const Felem *a)
+{
+    const uint64_t *x = a->data;
+    uint64_t carry = 0;
+    /* The cross products x[i] * x[j], i < j */
+    t[1] = MulAdd(x[0], x[1], 0, &carry);
+    t[2] = MulAdd(x[0], x[2], 0, &carry);
+    t[3] = MulAdd(x[0], x[3], 0, &carry);
+    t[4] = MulAdd(x[0], x[4], 0, &carry);
+    t[5] = MulAdd(x[0], x[5], 0, &carry);
+    t[6] = carry;
+    carry = 0;
+    t[3] = MulAdd(x[1], x[2], t[3], &carry);
+    t[4] = MulAdd(x[1], x[3], t[4], &carry);
+    t[5] = MulAdd(x[1], x[4], t[5], &carry);
+    t[6] = MulAdd(x[1], x[5], t[6], &carry);
+    t[7] = carry;
+    carry = 0;
+    t[5] = MulAdd(x[2], x[3], t[5], &carry);
+    t[6] = MulAdd(x[2], x[4], t[6], &carry);
+    t[7] = MulAdd(x[2], x[5], t[7], &carry);
+    t[8] = carry;
+    carry = 0;
+    t[7] = MulAdd(x[3], x[4], t[7], &carry);
+    t[8] = MulAdd(x[3], x[5], t[8], &carry);
+    t[9] = carry;
+    carry = 0;
+    t[9] = MulAdd(x[4], x[5], t[9], &carry);
+    t[10] = carry;
+    /* Double the cross products. */
+    t[11] = t[10] >> 63;
+    t[10] = (t[10] << 1) | (t[9] >> 63);
+    t[9] = (t[9] << 1) | (t[8] >> 63);
+    t[8] = (t[8] << 1) | (t[7] >> 63);
+    t[7] = (t[7] << 1) | (t[6] >> 63);
+    t[6] = (t[6] << 1) | (t[5] >> 63);
+    t[5] = (t[5] << 1) | (t[4] >> 63);
+    t[4] = (t[4] << 1) | (t[3] >> 63);
+    t[3] = (t[3] << 1) | (t[2] >> 63);
+    t[2] = (t[2] << 1) | (t[1] >> 63);
+    t[1] <<= 1;
+    /* Add the squares. */
+    uint64_t hi = 0;
+    t[0] = MulAdd(x[0], x[0], 0, &hi);
+    carry = 0;
+    t[1] = AddCarry(t[1], hi, &carry);
+    hi = carry;
+    carry = 0;
+    t[2] = MulAdd(x[1], x[1], t[2], &hi);
+    t[3] = AddCarry(t[3], hi, &carry);
+    hi = carry;
+    carry = 0;
+    t[4] = MulAdd(x[2], x[2], t[4], &hi);
+    t[5] = AddCarry(t[5], hi, &carry);
+    hi = carry;
+    carry = 0;
+    t[6] = MulAdd(x[3], x[3], t[6], &hi);
+    t[7] = AddCarry(t[7], hi, &carry);
+    hi = carry;
+    carry = 0;
+    t[8] = MulAdd(x[4], x[4], t[8], &hi);
+    t[9] = AddCarry(t[9], hi, &carry);
+    hi = carry;
+    carry = 0;
+    t[10] = MulAdd(x[5], x[5], t[10], &hi);
+    t[11] = AddCarry(t[11], hi, &carry);
+}
+
+/*
+ * One round of the Montgomery reduction, t[0 ... 6] = (t[0 ... 6] + m * P) / 2^64 with m = -t[0] / P (mod 2^64).
+ * The limbs of P are 2^32 - 1, 2^64 - 2^32, 2^64 - 2, 2^64 - 1, 2^64 - 1, 2^64 - 1,
+ * so m * P[j] is obtained by shifts and subtractions instead of multiplications.
+ * The carry of the round is accumulated in top.
+ */
+static inline void FelemMontReduceRow(uint64_t t[NUM_LIMBS + 1], uint64_t *top)
+{
+    uint64_t m = t[0] * P384_N0;
+    uint128_t mm = U128(m) << 64; // m * 2^64
+    uint128_t acc;
+    acc = (U128(m) << 32) - m + t[0];                               // The low 64 bits are 0.
+    acc = mm - (U128(m) << 32) + t[1] + (uint64_t)(acc >> 64);
+    t[1] = (uint64_t)acc;
+    acc = mm - m - m + t[2] + (uint64_t)(acc >> 64);
+    t[2] = (uint64_t)acc;
+    acc = mm - m + t[3] + (uint64_t)(acc >> 64);
+    t[3] = (uint64_t)acc;
+    acc = mm - m + t[4] + (uint64_t)(acc >> 64);
+    t[4] = (uint64_t)acc;
+    acc = mm - m + t[5] + (uint64_t)(acc >> 64);
+    t[5] = (uint64_t)acc;
+    acc = U128(t[6]) + (uint64_t)(acc >> 64) + *top;
+    t[6] = (uint64_t)acc;
+    *top = (uint64_t)(acc >> 64);
+}
+
+/*
+ * Montgomery reduction r = t / R (mod P)
+ * input:
+ *   t < P * R
+ */
+static inline void FelemMontReduce(Felem *r, uint64_t t[NUM_LIMBS * 2])
+{
+    uint64_t top = 0; // The carry out of the upper half
+    FelemMontReduceRow(t, &top);
+    FelemMontReduceRow(t + 1, &top);
+    FelemMontReduceRow(t + 2, &top);
+    FelemMontReduceRow(t + 3, &top);
+    FelemMontReduceRow(t + 4, &top);
+    FelemMontReduceRow(t + 5, &top);
+    /* The result is less than 2P. */
+    FelemReduceOnce(r, t + NUM_LIMBS, top);
+}
+
+// Multiply and reduce, r = a * b / R (mod P)
+static inline void FelemMulReduce(Felem *r, const Felem *a, const Felem *b)
+{
+    uint64_t t[NUM_LIMBS * 2];
+    FelemMulWide(t, a, b);
+    FelemMontReduce(r, t);
+}
+
+// Square and reduce, r = a^2 / R (mod P)
+static inline void FelemSqrReduce(Felem *r, const Felem *a)
+{
+    uint64_t t[NUM_LIMBS * 2];
+    FelemSqrWide(t, a);
+    FelemMontReduce(r, t);
+}
+
+/* r = a^(2^n) */
+static void FelemSqrReduceTimes(Felem *r, const Felem *a, uint32_t n)
+{
+    FelemSqrReduce(r, a);
+    for (uint32_t i = 1; i < n; i++) {
+        FelemSqrReduce(r, r);
+    }
+}
+
+/* Convert a BigNum to the Felem in the Montgomery domain. Note that the value cannot be greater than P. */
+static int32_t BN2Felem(Felem *r, const BN_BigNum *a)
+{
+    Felem tmp = {0};
+    uint32_t len = NUM_LIMBS;
+    int32_t ret = BN_Bn2U64Array(a, tmp.data, &len);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    FelemMulReduce(r, &tmp, &FELEM_RR);
+    return CRYPT_SUCCESS;
+}
+
+/* Felem * Convert to BigNum */
+static int32_t Felem2BN(BN_BigNum *r, const Felem *a)
+{
+    Felem one = {{1, 0, 0, 0, 0, 0}};
+    Felem tmp;
+    FelemMulReduce(&tmp, a, &one);
+    return BN_U64Array2Bn(r, tmp.data, NUM_LIMBS);
+}
+
+/*
+ * Calculate r = 1/a (mod P)
+ *  Fermat's Little Theorem:
+ *  a^(p-2) = a^(-1) mod p
+ *  p - 2 = 2^384 - 2^128 - 2^96 + 2^32 - 3, from the most significant bit:
+ *  255 bits of 1, 1 bit of 0, 32 bits of 1, 64 bits of 0, 30 bits of 1, 1 bit of 0, 1 bit of 1
+ *  x_n below denotes a^(2^n - 1).
+*/
+static void FelemInv(Felem *r, const Felem *a)
+{
+    Felem x2, x3, x15, x30, tmp1, tmp2;
+
+    FelemSqrReduce(&tmp1, a);
+    FelemMulReduce(&x2, &tmp1, a);                // x2
+    FelemSqrReduce(&tmp1, &x2);
+    FelemMulReduce(&x3, &tmp1, a);                // x3
+    FelemSqrReduceTimes(&tmp1, &x3, 3);
+    FelemMulReduce(&tmp2, &tmp1, &x3);            // x6
+    FelemSqrReduceTimes(&tmp1, &tmp2, 6);
+    FelemMulReduce(&tmp2, &tmp1, &tmp2);          // x12
+    FelemSqrReduceTimes(&tmp1, &tmp2, 3);
+    FelemMulReduce(&x15, &tmp1, &x3);             // x15
+    FelemSqrReduceTimes(&tmp1, &x15, 15);
+    FelemMulReduce(&x30, &tmp1, &x15);            // x30
+    FelemSqrReduceTimes(&tmp1, &x30, 30);
+    FelemMulReduce(&tmp2, &tmp1, &x30);           // x60
+    FelemSqrReduceTimes(&tmp1, &tmp2, 60);
+    FelemMulReduce(&tmp2, &tmp1, &tmp2);          // x120
+    FelemSqrReduceTimes(&tmp1, &tmp2, 120);
+    FelemMulReduce(&tmp2, &tmp1, &tmp2);          // x240
+    FelemSqrReduceTimes(&tmp1, &tmp2, 15);
+    FelemMulReduce(&tmp2, &tmp1, &x15);           // x255
+
+    FelemSqrReduceTimes(&tmp1, &x30, 2);
+    FelemMulReduce(&x2, &tmp1, &x2);              // x32, x2 is no longer needed.
+
+    FelemSqrReduceTimes(&tmp1, &tmp2, 1 + 32);    // 1 bit of 0 and 32 bits of 1
+    FelemMulReduce(&tmp2, &tmp1, &x2);
+    FelemSqrReduceTimes(&tmp1, &tmp2, 64 + 30);   // 64 bits of 0 and 30 bits of 1
+    FelemMulReduce(&tmp2, &tmp1, &x30);
+    FelemSqrReduceTimes(&tmp1, &tmp2, 2);         // 0b01
+    FelemMulReduce(r, &tmp1, a);
+}
+
+/*
+ *  "dbl-2001-b"
+ *    delta = Z1^2
+ *    gamma = Y1^2
+ *    beta = X1*gamma
+ *    alpha = 3*(X1-delta)*(X1+delta)
+ *    X3 = alpha^2-8*beta
+ *    Z3 = (Y1+Z1)^2-gamma-delta
+ *    Y3 = alpha*(4*beta-X3)-8*gamma^2
+*/
+/* Calculate the double point coordinates. */
+static void FelemPointDouble(Point *pointOut, const Point *pointIn)
+{
+    Felem delta, gamma, beta, alpha;
+    Felem tmp1, tmp2;
+    Point res;
+
+    /* delta = Z1^2 */
+    FelemSqrReduce(&delta, &pointIn->z);
+    /* gamma = Y1^2 */
+    FelemSqrReduce(&gamma, &pointIn->y);
+    /* beta = X1*gamma */
+    FelemMulReduce(&beta, &pointIn->x, &gamma);
+
+    /* X1 - delta */
+    FelemSub(&tmp1, &pointIn->x, &delta);
+    /* 3*(X1 + delta) */
+    FelemAdd(&tmp2, &pointIn->x, &delta);
+    FelemAdd(&alpha, &tmp2, &tmp2);
+    FelemAdd(&tmp2, &alpha, &tmp2);
+    /* alpha = 3*(X1-delta)*(X1+delta) */
+    FelemMulReduce(&alpha, &tmp1, &tmp2);
+
+    /* Z3 = (Y1+Z1)^2-gamma-delta */
+    FelemAdd(&tmp1, &pointIn->y, &pointIn->z);
+    FelemSqrReduce(&tmp1, &tmp1);
+    FelemSub(&tmp1, &tmp1, &gamma);
+    FelemSub(&res.z, &tmp1, &delta);
+
+    /* 4*beta */
+    FelemAdd(&beta, &beta, &beta);
+    FelemAdd(&beta, &beta, &beta);
+    /* X3 = alpha^2-8*beta */
+    FelemAdd(&tmp2, &beta, &beta);
+    FelemSqrReduce(&tmp1, &alpha);
+    FelemSub(&res.x, &tmp1, &tmp2);
+
+    /* alpha*(4*beta-X3) */
+    FelemSub(&tmp1, &beta, &res.x);
+    FelemMulReduce(&tmp1, &alpha, &tmp1);
+    /* 8*gamma^2 */
+    FelemSqrReduce(&tmp2, &gamma);
+    FelemAdd(&tmp2, &tmp2, &tmp2);
+    FelemAdd(&tmp2, &tmp2, &tmp2);
+    FelemAdd(&tmp2, &tmp2, &tmp2);
+    /* Y3 = alpha*(4*beta-X3)-8*gamma^2 */
+    FelemSub(&res.y, &tmp1, &tmp2);
+
+    FelemPointAssign(pointOut, &res);
+}
+
+/*
+ *  "add-2007-bl"
+ *    Z1Z1 = Z1^2
+ *    Z2Z2 = Z2^2
+ *    U1 = X1*Z2Z2
+ *    S1 = Y1*Z2*Z2Z2
+ *    U2 = X2*Z1Z1
+ *    S2 = Y2*Z1*Z1Z1
+ *    H = U2-U1
+ *    r = 2*(S2-S1)
+ *    I = (2*H)^2
+ *    J = H*I
+ *    V = U1*I
+ *    X3 = r^2-J-2*V
+ *    Y3 = r*(V-X3)-2*S1*J
+ *    Z3 = ((Z1+Z2)^2-Z1Z1-Z2Z2)*H
+*/
+/* Calculate the point addition coordinates, pt3 = pt1 + pt2 */
+static void FelemPointAdd(Point *pt3, const Point *pt1, const Point *pt2)
+{
+    uint64_t pointEqual, xEqual, yEqual, z1Zero, z2Zero;
+    Felem z1z1, z2z2, u1, u2, s1, s2, h, r, i, j, v, tmp1;
+    Point res;
+
+    z1Zero = FelemIsZero(&pt1->z);
+    z2Zero = FelemIsZero(&pt2->z);
+    /* Z1Z1 = Z1^2 */
+    FelemSqrReduce(&z1z1, &pt1->z);
+    /* Z2Z2 = Z2^2 */
+    FelemSqrReduce(&z2z2, &pt2->z);
+
+    /* U1 = X1*Z2Z2 */
+    FelemMulReduce(&u1, &pt1->x, &z2z2);
+    /* S1 = Y1*Z2*Z2Z2 */
+    FelemMulReduce(&tmp1, &pt1->y, &pt2->z);
+    FelemMulReduce(&s1, &tmp1, &z2z2);
+    /* U2 = X2*Z1Z1 */
+    FelemMulReduce(&u2, &pt2->x, &z1z1);
+    /* S2 = Y2*Z1*Z1Z1 */
+    FelemMulReduce(&tmp1, &pt2->y, &pt1->z);
+    FelemMulReduce(&s2, &tmp1, &z1z1);
+
+    /* H = U2-U1 */
+    FelemSub(&h, &u2, &u1);
+    xEqual = FelemIsZero(&h);
+    /* r = 2*(S2-S1) */
+    FelemSub(&tmp1, &s2, &s1);
+    yEqual = FelemIsZero(&tmp1);
+    /* If the coordinates are equal, use the double point formula. */
+    pointEqual = (xEqual & yEqual & (~z1Zero) & (~z2Zero));
+    if (pointEqual != 0) {
+        FelemPointDouble(pt3, pt1);
+        return;
+    }
+    FelemAdd(&r, &tmp1, &tmp1);
+
+    /* I = (2*h)^2 */
+    FelemAdd(&tmp1, &h, &h);
+    FelemSqrReduce(&i, &tmp1);
+    /* J = H*I */
+    FelemMulReduce(&j, &h, &i);
+    /* v = U1*I */
+    FelemMulReduce(&v, &u1, &i);
+
+    /* X3 = r^2-j-2*v */
+    FelemSqrReduce(&tmp1, &r);
+    FelemSub(&tmp1, &tmp1, &j);
+    FelemSub(&tmp1, &tmp1, &v);
+    FelemSub(&res.x, &tmp1, &v);
+
+    /* Y3 = r*(v-X3)-2*S1*j */
+    FelemSub(&tmp1, &v, &res.x);
+    FelemMulReduce(&tmp1, &r, &tmp1);
+    FelemMulReduce(&s1, &s1, &j);
+    FelemAdd(&s1, &s1, &s1);
+    FelemSub(&res.y, &tmp1, &s1);
+
+    /* Z3 = ((Z1+Z2)^2-Z1Z1-Z2Z2)*H */
+    FelemAdd(&tmp1, &pt1->z, &pt2->z);
+    FelemSqrReduce(&tmp1, &tmp1);
+    FelemSub(&tmp1, &tmp1, &z1z1);
+    FelemSub(&tmp1, &tmp1, &z2z2);
+    FelemMulReduce(&res.z, &tmp1, &h);
+
+    FelemPointAssignWithMask(&res, pt2, z1Zero);
+    FelemPointAssignWithMask(&res, pt1, z2Zero);
+    FelemPointAssign(pt3, &res);
+}
+
+/*
+ * "madd-2007-bl"
+ *    Z1Z1 = Z1^2
+ *    U2 = X2*Z1Z1
+ *    S2 = Y2*Z1*Z1Z1
+ *    H = U2-X1
+ *    r = 2*(S2-Y1)
+ *    HH = H^2
+ *    I = 4*HH
+ *    J = H*I
+ *    V = X1*I
+ *    X3 = r^2-J-2*V
+ *    Y3 = r*(V-X3)-2*Y1*J
+ *    Z3 = (Z1+H)^2-Z1Z1-HH
+*/
+/* Calculate the points coordinates addition in the mixed coordinate system, pt3 = pt1 + pt2, z2 == 1 */
+static void FelemPointMixAdd(Point *pt3, const Point *pt1, const AffinePoint *pt2)
+{
+    uint64_t pointEqual, xEqual, yEqual, z1Zero, z2Zero;
+    Felem z1z1, h, hh, r, i, j, v, tmp1, tmp2;
+    Point res;
+    Point jacobian2;
+
+    z1Zero = FelemIsZero(&pt1->z);
+    /* The point at infinity of the tables is (0, 0). */
+    z2Zero = FelemIsZero(&pt2->x) & FelemIsZero(&pt2->y);
+    /* Z1Z1 = Z1^2 */
+    FelemSqrReduce(&z1z1, &pt1->z);
+
+    /* U2 = X2*Z1Z1 */
+    FelemMulReduce(&tmp2, &pt2->x, &z1z1);
+    /* S2 = Y2*Z1*Z1Z1 */
+    FelemMulReduce(&tmp1, &pt2->y, &pt1->z);
+    FelemMulReduce(&tmp1, &tmp1, &z1z1);
+
+    /* H = U2-X1 */
+    FelemSub(&h, &tmp2, &pt1->x);
+    xEqual = FelemIsZero(&h);
+    /* r = 2*(S2-Y1) */
+    FelemSub(&tmp1, &tmp1, &pt1->y);
+    yEqual = FelemIsZero(&tmp1);
+    /* If the coordinates are equal, use the double point formula. */
+    pointEqual = (xEqual & yEqual & (~z1Zero) & (~z2Zero));
+    if (pointEqual != 0) {
+        FelemPointDouble(pt3, pt1);
+        return;
+    }
+    FelemAdd(&r, &tmp1, &tmp1);
+
+    /* HH = H^2 */
+    FelemSqrReduce(&hh, &h);
+    /* I = 4*HH */
+    FelemAdd(&i, &hh, &hh);
+    FelemAdd(&i, &i, &i);
+    /* J = H*I */
+    FelemMulReduce(&j, &h, &i);
+    /* V = X1*I */
+    FelemMulReduce(&v, &pt1->x, &i);
+
+    /* X3 = r^2-J-2*V */
+    FelemSqrReduce(&tmp1, &r);
+    FelemSub(&tmp1, &tmp1, &j);
+    FelemSub(&tmp1, &tmp1, &v);
+    FelemSub(&res.x, &tmp1, &v);
+
+    /* Y3 = r*(V-X3)-2*Y1*J */
+    FelemSub(&tmp1, &v, &res.x);
+    FelemMulReduce(&tmp1, &r, &tmp1);
+    FelemMulReduce(&tmp2, &pt1->y, &j);
+    FelemAdd(&tmp2, &tmp2, &tmp2);
+    FelemSub(&res.y, &tmp1, &tmp2);
+
+    /* Z3 = (Z1+H)^2-Z1Z1-HH */
+    FelemAdd(&tmp1, &pt1->z, &h);
+    FelemSqrReduce(&tmp1, &tmp1);
+    FelemSub(&tmp1, &tmp1, &z1z1);
+    FelemSub(&res.z, &tmp1, &hh);
+
+    FelemAssign(&jacobian2.x, &pt2->x);
+    FelemAssign(&jacobian2.y, &pt2->y);
+    FelemAssign(&jacobian2.z, &FELEM_ONE);
+    FelemPointAssignWithMask(&res, &jacobian2, z1Zero);
+    FelemPointAssignWithMask(&res, pt1, z2Zero);
+    FelemPointAssign(pt3, &res);
+}
+
+static void FelemPointMultDouble(Point *pointOut, const Point *pointIn, int32_t m)
+{
+    FelemPointDouble(pointOut, pointIn);
+    for (int32_t i = 1; i < m; i++) {
+        FelemPointDouble(pointOut, pointOut);
+    }
+}
+
+/*
+ * Comb tables of base point G in the Montgomery domain, PRE_COMPUTE_G[j][index] = n*G, bit m of the index
+ * corresponds to 2^(100*j + 20*m) in n:
+ *
+ * index      corresponding bit                          Value of n
+ *   0           0 0 0 0 0                                    0
+ *   1           0 0 0 0 1                                    2^(100*j)
+ *   2           0 0 0 1 0                         2^(100*j + 20)
+ *   3           0 0 0 1 1                         2^(100*j + 20) + 2^(100*j)
+ *  ...
+ *  31           1 1 1 1 1    2^(100*j + 80) + ... + 2^(100*j + 20) + 2^(100*j)
+ */
+static const AffinePoint PRE_COMPUTE_G[COMB_TABLES][TABLE_G_SIZE] = {
+    {
+        {
+            {{0, 0, 0, 0, 0, 0}},
+            {{0, 0, 0, 0, 0, 0}}
+        },
+        {
+            {{0x3dd0756649c0b528, 0x20e378e2a0d6ce38, 0x879c3afc541b4d6e,
+              0x6454868459a30eff, 0x812ff723614ede2b, 0x4d3aadc2299e1513}},
+            {{0x23043dad4b03a4fe, 0xa1bfa8bf7bb4a9ac, 0x8bade7562e83b050,
+              0xc6c3521968f4ffd9, 0xdd8002263969a840, 0x2b78abc25a15c5e9}}
+        },
+        {
+            {{0x31bdb48372876ae8, 0xe3325d98961ed1bf, 0x18c042469b6fc64d,
+              0x0dcc15fa15786b8c, 0x81acdb068e63da4a, 0xd3a4b643dada70fb}},
+            {{0x46361afedea424eb, 0xdc2d2cae89b92970, 0xf389b61b615694e6,
+              0x7036def1872951d2, 0x40fd3bdad93badc7, 0x45ab6321380a68d3}}
+        },
+        {
+            {{0x47d23302d99917ac, 0xefce627c33f7a04b, 0xb96cc6d8b8ef9f36,
+              0x8571890525c35409, 0x4a5f4f0fee91edb9, 0xae758e2a60172b89}},
+            {{0x7efb78630b7e96ae, 0xfda98be3c0225b0e, 0x6f327742e17bbcf7,
+              0xa4941bd6f2b9284e, 0x85b9c8ee55729e13, 0xee1709b95ffa8268}}
+        },
+        {
+            {{0xb083ba6aec074aea, 0x46fac5ef7f0b505b, 0x95367a21fc82dc03,
+              0x227be26a9d3679d8, 0xc70f6d6c7e9724c0, 0xcd68c757f9ebec0f}},
+            {{0x29dde03e8ff321b2, 0xf84ad7bb031939dc, 0xdaf590c90f602f4b,
+              0x17c5288849722bc4, 0xa8df99f0089b22b6, 0xc21bc5d4e59b9b90}}
+        },
+        {
+            {{0x72ce5d93912e4266, 0xb9e2fe47eb938baa, 0x43f949bd2b49a1c4,
+              0xb9046d1c0d1675a0, 0xe44cd59eb94f4d5b, 0x0e5a52c4ba5e8bad}},
+            {{0x548319de845268be, 0x4bafa151bd9f3484, 0x3aa97c67834641b9,
+              0xbc655a8d5409580a, 0x8671939d862bf901, 0x7db1d5c598381c63}}
+        },
+        {
+            {{0xa8e4214550bd7aea, 0x397e9e4b455fd5cb, 0x13bbd702385e79eb,
+              0xbe1d94b95fd29a02, 0x3ec587d9454dd50a, 0xeee28749074daebb}},
+            {{0x8a01efcf6963fa4c, 0x675f207d5164fe01, 0x48867863c747996a,
+              0xd432f46552bacad3, 0x89a35209de03accf, 0x29cc150e54b11e28}}
+        },
+        {
+            {{0xaab9862e034b6df1, 0x38ca48efa15d3816, 0xea98fa5bb583a6d0,
+              0x6ff1f22cbb1c3a75, 0x9f33b4e776745dda, 0x2bd68678a105b1d6}},
+            {{0xc5ce108ac429046c, 0x80ebcc56bb5731ee, 0xf2b6118609d2e1dc,
+              0x088b89d269815cca, 0x796faa99e3e24848, 0x934f8ec3f9249d3f}}
+        },
+        {
+            {{0xac6dbdf6edc9ce62, 0xa58f5b440f9c006e, 0x16694de3dc28e1b0,
+              0x2d039cf2a6647711, 0xa13bbe6fc5b08b4b, 0xe44da93010ebd8ce}},
+            {{0xcd47208719649a16, 0xe18f4e44683e5df1, 0xb3f66303929bfa28,
+              0x7c378e43818249bf, 0x76068c80847f7cd9, 0xee3db6d1987eba16}}
+        },
+        {
+            {{0x0be691dde461dc73, 0x9f50d64b1ce3b6e5, 0x99b6c99cd5b6e7b1,
+              0x2376eaff787f667e, 0x64e9af31bc5962c4, 0x7d79d59e6461b828}},
+            {{0x7ceb47a61ab7dcda, 0x600d8fd347a8b18a, 0x2f2d9fb2ef8ff564,
+              0xe127d3b143ed7068, 0x593e374b491cacbe, 0x082c2c5267448046}}
+        },
+        {
+            {{0xce25c98cc15c00d9, 0x573d7653447fee04, 0xb2eb085aa7f8d6a2,
+              0xc097fe12fc3f4b25, 0x7917512b1944c21e, 0x30defd62c5389707}},
+            {{0x5b813a0224525598, 0xb96e53b375e791e6, 0x01b81ffe1666da3a,
+              0xe15440e4fbfcaebf, 0x1a6ce71344876b1b, 0xd6721192aa8fcf5c}}
+        },
+        {
+            {{0x8efeef952e056d86, 0x4ba875ccc70a4323, 0x188be243261afabc,
+              0xd0712f75d9ae2284, 0x5dd21e2e34acee30, 0x8b83143fcdb4a0c8}},
+            {{0x2f0e9f58ad368b68, 0x9818c33fb9eaa564, 0x66aeff041710e6fd,
+              0x8dc4cfa7a24bdec2, 0x7a6423edbc985a59, 0xac014698542d84fb}}
+        },
+        {
+            {{0x2a286fcd1ffddc7e, 0x29bd5d17a971cd4b, 0x439a00e960d6a286,
+              0x1b54096cd4173003, 0x5fe645647cdd7f85, 0x846f3f696b1e9e42}},
+            {{0xeac30b0aef6730bc, 0x91e6b5885bc2b61f, 0xc65ebd039a598dc6,
+              0x947bd14981dda656, 0x662d617e52c65a92, 0x1a1c7cf012782b49}}
+        },
+        {
+            {{0xb6c226a704ab18b9, 0xe58f78ef9481d38d, 0x504bf4707651c54a,
+              0xaa34238f6f77091b, 0x79a12a660bf1baba, 0xe417df1baf47bd43}},
+            {{0xdee4a65490a9474f, 0x7fb1545b9b8d4118, 0x7814ea736b21498d,
+              0xa17419a8b2958ec0, 0x07f367bde885d60b, 0xfaf51c7e2a23fd2a}}
+        },
+        {
+            {{0x7ae81e38dc741a6f, 0x9ef5fd5c8c46236b, 0x02414c595383f4a9,
+              0xf44e3134630586a5, 0x4ee9d4fc09d3bea9, 0x90e205280cfd83b0}},
+            {{0x51daf54e2b32ce27, 0x892eda1c8370873b, 0x0bb94c34a007c33a,
+              0x8f8f2e4bf44f6d0c, 0x0e87f98f5faa77c3, 0xe8d6159cde6ac012}}
+        },
+        {
+            {{0x6ae8fa9b72c8ab70, 0x8abd4ed95209081a, 0xe84f2ff26c9782d3,
+              0x8d4a88351bc49ce2, 0x5bba72a1445cc0e7, 0xb154176064bcdbf2}},
+            {{0x787743ecccfb83cc, 0x0c3c6db7a3902252, 0x8d4ee7cd9633af1e,
+              0x785bae77f89cc1e1, 0xc541d9e485013d97, 0x504c61d30d4d8ece}}
+        },
+        {
+            {{0x22313dee5852b59b, 0x6f56c8e8b6a0b37f, 0x43d6eeaea76ec380,
+              0xa16551360275ad36, 0xe5c1b65adf095bda, 0xbd1ffa8d367c44b0}},
+            {{0xe2b419c26b48af2b, 0x57bbbd973da194c8, 0xb5fbe51fa2baff05,
+              0xa0594d706269b5d0, 0x0b07b70523e8d667, 0xae1976b563e016e7}}
+        },
+        {
+            {{0x0df82167f07a572d, 0x31400e2273cf044b, 0x3e68fd798ef91221,
+              0x4ffdd567b478f59e, 0xd4ed15613e5c59dd, 0x2159c3252996763e}},
+            {{0x69897b7da5a8bc97, 0x16714401c17ed62b, 0xea9c9813d721c585,
+              0x851248892d0cfa62, 0x4e502b8dedf90752, 0x9068431c2ed8d972}}
+        },
+        {
+            {{0xc9b38cc62532ed9d, 0xb081394db731fcdf, 0x195992359d9b632f,
+              0x650b89b1540b773f, 0x856e4867a301913f, 0xb98fd5ced035a90b}},
+            {{0xb8c51981136720d7, 0xa5b9fc69f23a4f89, 0x2e99fae39e0f408a,
+              0x8fdefcc890db359d, 0x53818d26ca8bac6b, 0x135b60cf8942e00b}}
+        },
+        {
+            {{0xe5d4d199d070bfa7, 0x45e916d2c543ffa0, 0x653cafdee9d27c5b,
+              0xf59062e97d4d885d, 0xb6f7eb8bebf4085c, 0x08fe3e6af8acf249}},
+            {{0x1754385bf3432eab, 0x1f16f13b456bd5c1, 0xdd0fa0c0df39b48b,
+              0xa57617a74d22b64f, 0x29a333eb25e57ff8, 0x5a54b8c5c2e19266}}
+        },
+        {
+            {{0xb0e1937416abe21e, 0x56a84b0ddbb7fee0, 0x23523186e01ab268,
+              0x967688ca4fd68a47, 0xbe94edbd7f557d85, 0x5fc8832054f177e9}},
+            {{0xbb0b1297124ad063, 0x5747fab9016d2a29, 0xb39240aa0c73a71c,
+              0x131e72b764953444, 0xfad520cc2469c5de, 0x8cb2e7588406ab64}}
+        },
+        {
+            {{0x5c5c6b8c13a8d7c0, 0xf8ed7185a38b06e9, 0xa3ef36fdca1b5047,
+              0xbb41ff89678bbec0, 0x44ea1a077758ef81, 0x6111ffdad0d1e433}},
+            {{0xbe14fe3078b06958, 0x034bd8c224e99b2a, 0x1bb698fc25e3999f,
+              0xc90c7d80ea745c8f, 0x1d44da582e75bc78, 0xe0c043f4678de8af}}
+        },
+        {
+            {{0x4acc2a05fa56a797, 0x9ee22386bc8d16b8, 0x082644273459afe1,
+              0xee137bdc490ef1b4, 0xa533d1cda49df96c, 0x858b860017f084bf}},
+            {{0x19d94a5cb8ce06d4, 0x34d9746f02027fc3, 0xbc897f727f61681e,
+              0xa364783f59956590, 0x4fe977b800a805a7, 0x797fe922ad1ecfe4}}
+        },
+        {
+            {{0xa3df33164768f3c5, 0x0c46ee911d48ebca, 0x6a3d5ec3c2f03567,
+              0x2d777d1147578e63, 0x80cea6f086af15c9, 0xa8f034e84e6a3140}},
+            {{0x56ca6070755600c5, 0xf5a68a815a30ace9, 0x65151adf96011bcb,
+              0x671b8f63f70a4f74, 0x9e183a42e43bf55f, 0x7f884c05d2f64481}}
+        },
+        {
+            {{0xe80ed8b5a33323a9, 0xa2da833d2168af00, 0x0726bf4d076320f9,
+              0x6a217d288fad15b1, 0x518e88a2dfbbfab8, 0xe3c068fd7fc4c941}},
+            {{0x4ae243836f411680, 0x966295a9fc192bac, 0x08ad3cf54944202e,
+              0x7af28af4005bd62f, 0xade4962f6c12c0a5, 0x48f147d183201a85}}
+        },
+        {
+            {{0x8a942ba9ceff4cb1, 0x28cfa87c9c779a4e, 0xc65a8784519d0824,
+              0xd1c679f7d828332b, 0xabc271edffaf2a55, 0x9d6683a82a065804}},
+            {{0xe5d6ff4388f657e3, 0x0fefeb8ef3503f68, 0x814092a85040964f,
+              0x66e94ba71ab075e1, 0xd1be12303b24df41, 0x790bed4207f14bcf}}
+        },
+        {
+            {{0xe415e811a9a8a217, 0x64ad6a831a60c599, 0x65db85cdcbb73972,
+              0x0cf822b412d69cca, 0xeec7bd2f3eaea364, 0x629cf6a0e6cf960f}},
+            {{0x56412dcb16b9ce73, 0x483fb917738207bc, 0x8cbb4cf59be659a8,
+              0x5013c8354280afd5, 0xa41636a1cc194353, 0x1d81ee74dc2905ee}}
+        },
+        {
+            {{0xe2c295fca0e9db0e, 0x4c70ee796bcbc838, 0x21c778bbde0aaf19,
+              0x8f1b88ae0df81248, 0x75b3bd3872e0b22b, 0x3739c270032741dc}},
+            {{0x600f87089010a6dc, 0xb0cad3adfe03c066, 0x661b7a2e91ce2762,
+              0xdd3fddd658f796c6, 0x9f5e9a0f0c26535f, 0xf37d5bf5100942b6}}
+        },
+        {
+            {{0xf0d8f6a613609027, 0xc2db0c03704544fb, 0x701dcf5b72439c6c,
+              0x3c3ce00e99a189c3, 0x5c42ac87d32164f4, 0x1bd18cf22b31aa07}},
+            {{0x3c94619c8cd609e5, 0xb2e4d537a759b3af, 0x254e134733398885,
+              0xb0ef13cb0bcdf619, 0x7561c518cd768726, 0x1c7c4331ab8ec7e2}}
+        },
+        {
+            {{0xd530ac7eb89b40af, 0xe1bc821402b64fea, 0x98287562aedf18c0,
+              0xb2d43762c55e5e27, 0x4e00af905c366b0a, 0xb93c6541fb359f38}},
+            {{0x07f1ab163149989f, 0x41b72cbde601b67a, 0xd5ea555870496cd7,
+              0xf9f2a6554e335acf, 0x5a47d3de2e545b53, 0xe9b31cef95357e7e}}
+        },
+        {
+            {{0x18e90783156a0db3, 0x8933255c2988c6dd, 0xfde822fb653ae2bb,
+              0xab6d0d9a27b95a89, 0xf8b2c8239022d191, 0x10c11f64c571fc1a}},
+            {{0xf92ad20e81b4ec46, 0x2614be8a5f512ea1, 0xf0d97f4c93398404,
+              0x4a06721f75cc0f63, 0xc3757b728e0acae9, 0x1f908d2a56854667}}
+        },
+        {
+            {{0xe68331d212eefecf, 0x8f71c232584ca5e3, 0x9c06f2c3ddd94131,
+              0x2dd6b16b2370b1be, 0xde37ccb1c7464c80, 0x81bcb89c87fae154}},
+            {{0x645cf447362c4575, 0x8826e5d43ff83dd3, 0x07108d28533dc63e,
+              0x5f115d6d6af58e2a, 0x6c4ba09f1d739106, 0xe50309f54f24025a}}
+        }
+    },
+    {
+        {
+            {{0, 0, 0, 0, 0, 0}},
+            {{0, 0, 0, 0, 0, 0}}
+        },
+        {
+            {{0xa05c751cd1d1b007, 0x016c213b0213e478, 0x9c56e26cf4c98fee,
+              0x6084f8b9e7b3a7c7, 0xa0b042f6decc1646, 0x4a6f3c1afbf3a0bc}},
+            {{0x94524c2c51c9f909, 0xf3b3ad403a6d3748, 0x18792d6e7ce1f9f5,
+              0x8ebc2fd7fc0c34fa, 0x032a9f41780a1693, 0x34f9801e56a60019}}
+        },
+        {
+            {{0x2af8ed8170d4d7bc, 0xabc3e15fb632435c, 0x4c0e726f78219356,
+              0x8c1962a1b87254c4, 0x30796a71c9e7691a, 0xd453ef19a75a12ee}},
+            {{0x535f42c213ae4964, 0x86831c3c0da9586a, 0xb7f1ef35e39a7a58,
+              0xa2789ae2d459b91a, 0xeadbca7f02fd429d, 0x94f215d465290f57}}
+        },
+        {
+            {{0xdb3df8c712fd0302, 0x19c06d7b99eb32d0, 0x4a30f40d5a5b819a,
+              0x27e4a448fd17a6b9, 0x3a77dd8696c42f90, 0x7067884650878b00}},
+            {{0xca6341bfc6fddf2d, 0xbcff3232ba160573, 0x4e77bba57768120e,
+              0x6de2620c445f693b, 0x7cc2b13469c56b1a, 0xefe3770d2784ff2d}}
+        },
+        {
+            {{0xbbccce39a368eff6, 0xd8caabdf8ceb5c43, 0x9eae35a5d2252fda,
+              0xa8f4f20954e7dd49, 0xa56d72a6295100fd, 0x20fc1fe856767727}},
+            {{0xbf60b2480bbaa5ab, 0xa4f3ce5a313911f2, 0xc2a67ad4b93dab9c,
+              0x18cd0ed022d71f39, 0x04380c425f304db2, 0x26420cbb6729c821}}
+        },
+        {
+            {{0x18de20cf6c8aeacb, 0x987eb7fa68f84a36, 0xde05448a2014cd86,
+              0x9bd2c01cfaae90de, 0x1aeb6ba409b2a4fa, 0x631bfc1ab539ee83}},
+            {{0x5af9931f361dbead, 0xeb60bf8a6d6b1ae8, 0x5ee9763e6d201b78,
+              0x8d1728d48070f7f3, 0x8200417a997326a6, 0xad1d72a6078db810}}
+        },
+        {
+            {{0xa8c79e36d97e39ea, 0x43af43577aeabc7e, 0x5961699968f0218c,
+              0x477fe2ac33f1dbf9, 0xd840cf71ab4c57ba, 0x0560af5323c6c85c}},
+            {{0x1946fa55941e5c90, 0xa4b337fee541a8b9, 0xd9dcd6aca870e6c1,
+              0xbda7334d868a8ed9, 0xee79c18b8f773835, 0xcbb928c245435544}}
+        },
+        {
+            {{0x6c6806ffcea1445f, 0xcdeea7bceb7209aa, 0x60943b3ebf0f0a6e,
+              0x7a371a098ebbc250, 0x7f4f757db8657ff7, 0x6cab095399cce744}},
+            {{0xc053b24d3da44592, 0xd64775bd257d227e, 0x0e98f477027aba90,
+              0xe9ee28b05ad12950, 0x024cf499e09b2a63, 0xb4d2adc898a7296c}}
+        },
+        {
+            {{0x11a8fde5f0ce2df4, 0xbc70ca3efa8d26df, 0x6818c275c74dfe82,
+              0x2b0294ac38373a50, 0x584c4061e8e5f88f, 0x1c05c1ca7342383a}},
+            {{0x263895b3911430ec, 0xef9b0032a5171453, 0x144359da84da7f0c,
+              0x76e3095a924a09f2, 0x612986e3d69ad835, 0x70e03ada392122af}}
+        },
+        {
+            {{0xeb599eb19e2b2fd9, 0x58bffc1f308ab459, 0x5e95d8f3a9775713,
+              0x5cc182f89ef3f87f, 0x468014c677673987, 0x6a13dc23813f04e4}},
+            {{0xc847c4e2fc21f2b2, 0x954ab705d1504b3b, 0xa8b327304daf1e4d,
+              0x78ac4b0bd526dff1, 0xed23f1b7c49a1257, 0xba4d67622430b687}}
+        },
+        {
+            {{0xc51acfcc2d104237, 0xe11b2fc5e696d88f, 0x4b6694c46a11c88f,
+              0xbbd76cafc92cd8c3, 0xc2975447334c7bf2, 0xb84587f2f7d1862b}},
+            {{0xe41844b6aa32c54e, 0x89c50d4c67c33955, 0x5a5f04b77099e6b8,
+              0x770733bd2f4a1a90, 0xbdac09a97977b91d, 0x46ecb3a7fa0509ef}}
+        },
+        {
+            {{0x8eec80925af7fba5, 0x52df76e5dc2d0bf7, 0x429db33eeefe88c4,
+              0x295dc1e7a89dc198, 0x605dab87541b35b2, 0x25d9ea876e3fce50}},
+            {{0x29141e5516ab030a, 0x6b02115054640b9a, 0xfb102e4e597b7389,
+              0x4f4bd9f30240cf03, 0xf1bc7a141c42535d, 0x53148b857e52f380}}
+        },
+        {
+            {{0x777229255a46a228, 0x7777e10914c5adab, 0x49839f999db43057,
+              0xffd5166dbe719cfa, 0x76d94ce8d919958a, 0x672cd2473d628b0c}},
+            {{0x1512f6c263ff2e7b, 0x2e425d49268979fb, 0x07385c5ecbc24e20,
+              0xa648dda041fa106f, 0xc1025e8f7c661baa, 0xd8f9b3e5d6fe4512}}
+        },
+        {
+            {{0x62b8340b7ed47406, 0x1376b10ae65388fb, 0x1e492f07a40237b6,
+              0xf7d12ccc9a157b60, 0x2b9d8cbc8e279c2e, 0x8a34421ba7e67993}},
+            {{0x72d1318b41c374a9, 0xe87f6875db45ed7b, 0x7e3fb46a52017c62,
+              0x0e005d9c7f92d569, 0x61ea79187dae3328, 0xa2ae27213a8f032e}}
+        },
+        {
+            {{0xfa8e10d7001a1ea9, 0xdcd068b870956f9a, 0x387489c23ce3d083,
+              0x55fc7dbaa6e00226, 0xcc3fef950979b80c, 0x847830083fd4f8d9}},
+            {{0xaa4241963457f509, 0x26a76bc2f104e4b5, 0xfee81ed49d651f44,
+              0xa4ed72c7f9a9bf5e, 0x432cf554e2e0dd18, 0x63e5314aaa8ec6ff}}
+        },
+        {
+            {{0x80c1f675253575ba, 0x228049809e61e640, 0xcf20d103f82febb4,
+              0xf149ade3a588e75a, 0x84aac62d6cb08ae4, 0x40393bc088fbc116}},
+            {{0xd40d9a2d81a0f4c6, 0xf5d380a923f4c0a7, 0x84758fb0efb7212c,
+              0x793e46ecfdec1f38, 0xb7734c12d3206851, 0x01f66e336e0ede1f}}
+        },
+        {
+            {{0xfa2db51a8d688e31, 0x225b696ca09c88d4, 0x9f88af1d6059171f,
+              0x1c5fea5e782a0993, 0xe0fb15884ec710d3, 0xfaf372e5d32ce365}},
+            {{0xd9f896ab26506f45, 0x8d3503388373c724, 0x1b76992dca6e7342,
+              0x76338fca6fd0c08b, 0xc3ea4c65a00f5c23, 0xdfab29b3b316b35b}}
+        },
+        {
+            {{0x8c7abbf97bfe8f0c, 0x8137c78bf01290f5, 0x07efa408bd4235eb,
+              0x6cdbca8546fac1cf, 0xce82bb668124f31c, 0x0e6c12e6cdc55820}},
+            {{0xf383030d1e13497d, 0xe0f16db36a2cdd04, 0x9df51171836adec3,
+              0x6c693b725d5d5c44, 0xcaffefc3220fd191, 0xaf5af6ace5f10a10}}
+        },
+        {
+            {{0x60d9b43b95ed27c1, 0xb9949b04ca3db08a, 0xad7d69f7ab68d887,
+              0x43bb7b8cffbb8292, 0xbf2d3d789e14b03e, 0x3b1b1d6b95c210cc}},
+            {{0xef595846dd6e907e, 0xb2c4a6a8da46625e, 0xb66787ef93217c6f,
+              0xc489fcd21c9b34ab, 0x5f5df93a68937945, 0xdcb05d7d1ee8b08a}}
+        },
+        {
+            {{0xe23bdb26804708b8, 0x00803ae39c43ec8c, 0xc5e7fdd7fa9a5044,
+              0x351a328b8188822d, 0x9bdf53b63bc96a96, 0x87f75b8dc238f9a1}},
+            {{0xb04b942090f8fa2e, 0xdef76e7100a681e3, 0xf13fffff0ac44df1,
+              0x5f3aab59f0fa3242, 0x937e86027243a691, 0x324ab4be0c3b5096}}
+        },
+        {
+            {{0x0795ba8e287af8c5, 0x3ed176d96e29071c, 0xa66745754032d5ff,
+              0x05df4fb07b7d0b61, 0x832f7ad0a84abfa7, 0x6340e5b4590c3cc4}},
+            {{0xff60a5bc12f3d25f, 0xa62d53dd3c499d93, 0x9cc1e923a81aa8a0,
+              0xb0b233c65b077c27, 0x4e29f6bda3d81fbe, 0x61dc1c795116ad41}}
+        },
+        {
+            {{0x10e02b8be8a70bbb, 0x631ec2cf154232bc, 0xe90363bec4dad21d,
+              0x2bb4d94a424574a5, 0xbf5e3bcf143e2c2e, 0x96484d42fa067cf0}},
+            {{0x344852d1cf58f88e, 0x89c5c60bdae86b47, 0x6da022c56b5a156f,
+              0xca28247e7e39abaa, 0xb7bbfd705451526d, 0x631e08a94361121e}}
+        },
+        {
+            {{0xe573696938196860, 0xd08502897ae55fb5, 0x50f6f8b1778bce66,
+              0x50514470f482aad5, 0x204865e4a54f327a, 0xf0d3fbfa37b2dd9b}},
+            {{0x62cc750786a86540, 0x48574fe90685ac9f, 0xc4932e696ed306f1,
+              0x118bcb3e77a3d1a4, 0xa660de99e72c528d, 0xe529723c4f598fcb}}
+        },
+        {
+            {{0xea66ab7503ce2e29, 0x2e2e811952bc0048, 0x88570a3c57224f9c,
+              0xd3df2adfea42ce66, 0x9c308807fc217733, 0x26e81c520b51f094}},
+            {{0x516ceb709d2563f6, 0x1c83bc7475814acc, 0xb7ec99dc881a26b4,
+              0xbd0931e1f734ad46, 0x3c18b1503d9b9a4c, 0xec8df34b900bf9c2}}
+        },
+        {
+            {{0x51ee4630641810ca, 0x6ce3cbfe1e8ef7a7, 0xba24ebb320723c50,
+              0x072f23908709c239, 0x6f06d2d6a544d1dd, 0xfd8dbc75b2d30780}},
+            {{0xe21b5a864f7a63d8, 0x03ede1e8e627db9c, 0xa66bb3e2ebc83733,
+              0x3280634a9c0cadbf, 0x4398666a3aae9d35, 0xa70513216bc47576}}
+        },
+        {
+            {{0x8131bdc67f146b44, 0xa2063d3be9664bd7, 0x9e11212c07d03017,
+              0x8bee58f75ead4b7e, 0x6c029fc899457ce6, 0xa0311b1da5787d62}},
+            {{0x9eb2d7e323d8bc10, 0x9b64e9117c8054b6, 0x4e4a8d866cfd9cef,
+              0x3945c8bddc30f069, 0xf811c71d33f9b5e7, 0xcb12dd9b1ef8deda}}
+        },
+        {
+            {{0x8b85bdefc0388589, 0x30be3cf375baeea9, 0x600758afbf51df24,
+              0xc72824d0b4219591, 0xa2f0a161763f1e7d, 0xc361928816fcdc3d}},
+            {{0xedf39f8e54d5a1ef, 0x49b8e46e0d5e28e2, 0x11d06bc9996bbaff,
+              0xc7153b1f5829da61, 0xd3af46862c425ea7, 0x2d5627fef0522508}}
+        },
+        {
+            {{0x874d1df2fca16178, 0x5d765fc9c9f03261, 0x860af3b2a6136729,
+              0x84b705496e9e2ff5, 0x27f2d326331e0723, 0x51d49b17542b61d0}},
+            {{0xb5f462552c62a422, 0xbd28625ec0ff0a4d, 0xa8a75e62df5eb2c6,
+              0x0a46fa30b6fe0bf8, 0xf1e5f7ba2edda4fb, 0x017b5a91e4f34742}}
+        },
+        {
+            {{0xe0b811264307ea90, 0xcac8af40d2c2b042, 0x8ed2756329b52b86,
+              0xedd02114c89326d1, 0x91e3d48be8c6e85a, 0xec23c011989aa892}},
+            {{0x8fd3b7249a2a7883, 0xffee367ca0cc8768, 0x5ab31435266935dd,
+              0x3666952d8d6a3dbb, 0x7f55fd4a595d7b47, 0x1ca8e8c484418b96}}
+        },
+        {
+            {{0x4833e9d8057d31d2, 0xad89b4e1c69ff827, 0xdf14c3253ba66224,
+              0x1305f6b6e5fe09e4, 0x0191f33a73706fb7, 0x3f605fb1477ed56f}},
+            {{0x34ea13c704e13a76, 0x2e9c361d87f4e8c0, 0x8e1d0ee28e2a9973,
+              0x87ed436cfc87c506, 0x2c0e7585d6f9bc4c, 0x32fa114fdc43f879}}
+        },
+        {
+            {{0x6799cce8f3bde97f, 0x14a918ee393e4c26, 0x85fc5c5f641c384b,
+              0x1151a039df78465e, 0xe0b27397e843bf2e, 0x72ca732e1518f660}},
+            {{0x3279a5ea9db840cd, 0x0aabbb7cc1b2e101, 0x211740ed063cd745,
+              0x18d5a37f64aa1aa5, 0x026383d79251c734, 0xc7b6d723652c067f}}
+        },
+        {
+            {{0xb7f6033d9ede2d4c, 0x989bcebb685387fa, 0x2963d1e292f66749,
+              0x161d09b3a86472ec, 0xf954163a2031b9bd, 0x3b117e9e6dd2277c}},
+            {{0x13662c45cd1836ad, 0xa9c09d2ba607ac2d, 0x29e6092b73800805,
+              0xb2577fcefec93ca9, 0xdefc4fe9228b48d3, 0x5d7a722d53588a92}}
+        }
+    },
+    {
+        {
+            {{0, 0, 0, 0, 0, 0}},
+            {{0, 0, 0, 0, 0, 0}}
+        },
+        {
+            {{0x5b0b5d692a7aeced, 0x4c03450c01dc545f, 0x72ad0a4a404a3458,
+              0x1de8e2559f467b60, 0xa4b3570590634809, 0x76f30205706f0178}},
+            {{0x588d21ab4454f0e5, 0xd22df54964134928, 0xf4e7e73d241bcd90,
+              0xb8d8a1d22facc7cc, 0x483c35a71d25d2a0, 0x7f8d25451ef9f608}}
+        },
+        {
+            {{0x3f2eff53de1e4e55, 0x6b749943e4d3ecc4, 0xaf10b18a0dde190d,
+              0xf491b98da26b0409, 0x66080782a2b1d944, 0x59277dc697e8c541}},
+            {{0xfdbfc5f6006f18aa, 0x435d165bfadd8be1, 0x8e5d263857645ef4,
+              0x31bcfda6a0258363, 0xf5330ab8d35d2503, 0xb71369f0c7cab285}}
+        },
+        {
+            {{0xb469ebf279e62713, 0x029fc34c3e683c3a, 0x1697f668521373c4,
+              0x411a75fa9c9cd7ac, 0xaa555e41a03b3662, 0xd3ea580f82bbe1ce}},
+            {{0x6251dbda8ef86eff, 0xe0945ecb7f53f62c, 0xc4e26c95f96d2e24,
+              0x69ac60ad4fcb9d04, 0x14d4db436e8b5833, 0x9cbe6be6ffdb93f9}}
+        },
+        {
+            {{0xc0426b775e3c647b, 0xbfcbd9398cf05348, 0x31d312e3172c0d3d,
+              0x5f49fde6ee754737, 0x895530f06da7ee61, 0xcf281b0ae8b3a5fb}},
+            {{0xfd14973541b8a543, 0x41a625a73080dd30, 0xe2baae07653908cf,
+              0xc3d01436ba02a278, 0xa0d0222e7b21b8f8, 0xfdc270e9d7ec1297}}
+        },
+        {
+            {{0xc676ee54a0065409, 0x4b2e1eeb55886617, 0x94b4864044d50f22,
+              0xa4368435018ae966, 0x9e940fb30aa6370d, 0x9abfedf58b296430}},
+            {{0x4edaa387e660e8ac, 0x81f9a60e3b6fd2c4, 0x3efa5dc5494f04f8,
+              0xb5cdf81c26586ce7, 0xc9fcd9fe46f2a6e2, 0x5bdb68577172c1b8}}
+        },
+        {
+            {{0x7cd656b796d4707c, 0xf6dd0ec20b77cb3e, 0xe8659698e27226d7,
+              0x0ae0501ab1a49363, 0xf319b391ad08cde5, 0xfcf11bacae446fa4}},
+            {{0x98efc78cae874fb2, 0xf12b9796d34261bc, 0x40edb88893d91e26,
+              0x9c0138aedd92fbe1, 0x347ad756774b012c, 0x0582057d5502443a}}
+        },
+        {
+            {{0x069def57b7c7624b, 0x2b7a6976038aec83, 0x430128f21ccd827f,
+              0x2c73a3e233736fc0, 0xb9d16646181bb63c, 0x9df3af92636341ca}},
+            {{0xf57eb78e40196135, 0x8815008d2e0924fd, 0xe116a4edc524f5c0,
+              0xc8cea68848b84b41, 0x26f802298e7169f7, 0x45e1a7c1771cfd00}}
+        },
+        {
+            {{0x140a0f9fdd93d50a, 0x4799ffde83b7abac, 0x78ff7c2304a1f742,
+              0xc0568f51195ba34e, 0xe97183603b7f78b4, 0x9cfd1ff1f9efaa53}},
+            {{0xe924d2c5bb06022e, 0x9987fa86faa2af6d, 0x4b12e73f6ee37e0f,
+              0x1836fdfa5e5a1dde, 0x7f1b92259dcd6416, 0xcb2c1b4d677544d8}}
+        },
+        {
+            {{0x1362399c8302884c, 0xbf325bb427823662, 0x7dd1f60a2d06face,
+              0x2061f66336266cbb, 0x7f0d1c43bbc089ae, 0x6554004c91ad2d7f}},
+            {{0xb73aa18823717cdf, 0x0cd82f2725273012, 0x3c8a49c9db57c3b8,
+              0xa08b6e2884c1efc1, 0x66232dae5980d43e, 0xf14045c897e2a9be}}
+        },
+        {
+            {{0x1bc74216221baa34, 0xb6fd0dc0626b407d, 0x622713cf5c69d587,
+              0x9ec77f295e015255, 0x844c4aeb3dd2c825, 0xf2a3dbd436684de2}},
+            {{0x93eefabd5ed0218e, 0xec9377f6232d825d, 0xf26c06893447f88d,
+              0x9f7bd25867b18d37, 0x00b83e5c34214173, 0x553c53300ac4ec94}}
+        },
+        {
+            {{0xff362726c81a07bd, 0x802cf089cdbcd692, 0x123d7f4f2c2bdaf5,
+              0xa752a8b3a108d00f, 0x64f86914e63e98ae, 0xb2300de95963ebb7}},
+            {{0x014e6ec87ea27a2d, 0xc94f1d5af1fba183, 0x4fe5fd5495ef5824,
+              0x901dee0cb1cee1f9, 0x2ee5e93b0a1e5913, 0x079559f22fbefc09}}
+        },
+        {
+            {{0x10a68a960b272184, 0x7b2efaa7d6d611ea, 0x08f05473f2e7c70d,
+              0x75ec37d73e507f73, 0xc6a1ba436c7963cf, 0x14c43616353c300a}},
+            {{0x7050bb96724ca9cf, 0x107a76c035499033, 0xbf70d3dcba6a5aa5,
+              0xf2430018d1fb8aa3, 0x52976b04e1bc0d09, 0xdf312e1c1f549f57}}
+        },
+        {
+            {{0x067af333b2148194, 0x51d6aac9492138aa, 0x4b3729c1be70bf60,
+              0xae4e902dc5ddc4cd, 0xab68696558e56c90, 0xfaf70ddc0f49342a}},
+            {{0xd5b6febf9605b0de, 0xcd6e8e8cb9b19fe9, 0xcb4c6636aff5bf32,
+              0x5df15bff875b9b70, 0x4ca73ef4b82a0afc, 0x9611e193584dc3c8}}
+        },
+        {
+            {{0x16061819ba48f3b9, 0xf3b96f151a881492, 0x31e16ee792338eea,
+              0xb69e2a178767ae96, 0x00abc8ba94c3b6a2, 0xe7371a05dcda48f9}},
+            {{0x027ee4a409aa7b33, 0xc126e1d1bfc3ea66, 0x681cfa0655b3b2d2,
+              0xa2c3b62c3eb5bbae, 0x0f6d2928fd396912, 0x050e3988b9230398}}
+        },
+        {
+            {{0x4cbaf3ceb4943d11, 0x1c557cc004a0ea7f, 0xbe29584f77f4ef73,
+              0xac4553e9687e55b6, 0x31144cbd768938af, 0x8c2035ba5e7a1064}},
+            {{0x6ae0cd76257006ab, 0x7a750b6269d58855, 0xd7a3664f11bf4285,
+              0x9cad6f10dc0ae7c0, 0x4ac1181b93f35d07, 0xb19e4e080691216f}}
+        },
+        {
+            {{0x9e9af3151c4c9d90, 0x8665c5a9d12e0a89, 0x204abd9258286493,
+              0x79959889b2e09205, 0x0c727a3dfe56b101, 0xf366244c8b657f26}},
+            {{0xde35d954cca65be2, 0x52ee1230b0fd41ce, 0xfa03261f36019fee,
+              0xafda42d966511d8f, 0xf63211dd821148b9, 0x7b56af7e6f13a3e1}}
+        },
+        {
+            {{0xfdd2596fb878cfb7, 0x3a28765b73dc9b36, 0x5ce85b639e3a3d11,
+              0xb2c149bde9e2ab27, 0x6056ca61ea337e49, 0xbc1d46f11e614c12}},
+            {{0xdc1ebfb6ed96d94b, 0x4fa5fcbe506077e5, 0x414ceaf88cf4e5ec,
+              0x1644f605ffe85d7d, 0xa17a2fd9a4c61a6a, 0x2d70e3f535cbb62a}}
+        },
+        {
+            {{0x19970ef7f56790aa, 0xc41c6def41afdfed, 0xd532763febd44b12,
+              0x86cd36c50997a2e5, 0xd0af7c8fd969d040, 0xa53360856f7fcced}},
+            {{0x980f3313d650fc68, 0xda0e402fa09fcd9f, 0xb1ed3a684be9e45a,
+              0x9e9d3adbf4f75491, 0x87d5ff1bb55f0282, 0xcdcb5a87fec3f119}}
+        },
+        {
+            {{0x2f1b74498cd21ade, 0xd099389d47576b34, 0x13a611d4d9b69f40,
+              0x5825209e852a38a9, 0x02aa0b2ab62c3b24, 0xda2d6579b31ffdb5}},
+            {{0x3e3cfe0b265cb1a2, 0xf495f01dff271f1a, 0xc58d7fcf32966fb9,
+              0xe8ea7786e5261eb5, 0x505fb045a8e76529, 0x9114d13f4786e79d}}
+        },
+        {
+            {{0xf97b33cf9ae826b9, 0xd038319ff654654d, 0x68e45698bbc5ba16,
+              0x4a45877aa36c24aa, 0x47043295b594ec74, 0xaba938d449b17378}},
+            {{0x4f38319410728596, 0x7f1a842e9f0f6fe2, 0x222d097614821ec1,
+              0x45b23936451c46dc, 0xf4d275d4eaa8097e, 0xbbebea25f9a95f08}}
+        },
+        {
+            {{0xf2fa9baf84ed6a93, 0x9a11f1895f7f1f04, 0x2c27f0a03de9c340,
+              0xd87b328e11e9149e, 0x13b95737b2fd9084, 0xa0f38b8ded9ae321}},
+            {{0xbf7144363a1ca77d, 0x7e51266a50947a13, 0xeb6556c2a6c2e996,
+              0xe0c2fe9046c1212b, 0x8a85e7a4bc47abfb, 0x2c5ac75c71494265}}
+        },
+        {
+            {{0xb4652d0ce7a42325, 0x28a89fd6e7d50027, 0x4eb25e5ce0e5e18c,
+              0x98d6f8ee77805a94, 0x98e7b9b8732168a7, 0x258251ecc4a6d952}},
+            {{0xff3a30fc8e23bc40, 0xdeda1641af1aaa95, 0x6f669f789e358186,
+              0x5377d234f35860b8, 0xe43ac0f4a5b3e7cb, 0x1e1f58550367838f}}
+        },
+        {
+            {{0x8f1d014ff6144ec8, 0x7a805e759720da45, 0xf6914251e9847ebb,
+              0x3134b3b3ac68ef52, 0xe96706e87d29cc5d, 0xb205e772eb61e63c}},
+            {{0xdf6336fba7ab066c, 0xc191db981c060992, 0x572f4a5d6f07d364,
+              0xa41773c795164632, 0xa9a5bc4f1b556761, 0xcde308ed821bfca0}}
+        },
+        {
+            {{0xb537eec27a9d9d42, 0xf067cf2c432d6c88, 0x6c917151066c9342,
+              0x7fbb15e491cd7f69, 0xe73790224580336a, 0xbe8b7265eb146f5c}},
+            {{0x2429b93fc9da2bce, 0x0d78112cf526af07, 0xb2c392bc7ddf811c,
+              0x3039757a899a345d, 0x700775477ec2253d, 0x80faa8b5058b6a1b}}
+        },
+        {
+            {{0x26974b69c9036fa2, 0xe124a25d0f4195d3, 0x3e7cd1842999d794,
+              0xad49a6c3298d22fb, 0x6723413d48c1ef56, 0xcba820ee3709382e}},
+            {{0x0f9dc81c12b713b3, 0x97555aa8569d9b6b, 0x12ee39e5a03e0707,
+              0xf1f46f04ebc3bad7, 0x47de29a8a0e5f222, 0x3fd84947ae8d9532}}
+        },
+        {
+            {{0x2a07e1e54bc0669f, 0xa127466c77ae8870, 0xfdc8da584ea24d40,
+              0x539b6d534efc156f, 0x8787afb118ad936c, 0xa5a26a5f71af160f}},
+            {{0x5db4817f64a909a3, 0xaa3e6e129e170283, 0x19b03c28e41befe3,
+              0x208ce0851da67c64, 0x117a71ec3bd2f5d7, 0x7b6026814cc4e0bf}}
+        },
+        {
+            {{0x50463c1f1a5d7d20, 0xabe9b89f292540ab, 0x6d21ae2bfcce6ffd,
+              0xee272931bdd12d86, 0x795fce2f08a7dfe6, 0xa6b587bd935c5a6b}},
+            {{0xfed759e1fb7dc627, 0x2b6619d323cd6cae, 0x0eab53bf480d20c0,
+              0x6c353958980a06d0, 0xfcaa1e8f9784592c, 0xcba7f42d824c9622}}
+        },
+        {
+            {{0xb787610f2a15a2a8, 0xc83865730cb9c1ec, 0xd70354447324a14d,
+              0xc2c8ed6698c3d357, 0x4a442750b50bdb41, 0xaa4d48fff674ff42}},
+            {{0x5897e20e44191dd0, 0xa5bea70f33bc788d, 0xbe09f253c4c88e7a,
+              0x35a03644b46cd66d, 0x174bafc0a30803eb, 0x0b7929bb5823db12}}
+        },
+        {
+            {{0x02470e91529927b4, 0x7be30bece1df46b3, 0x4ce647ed5d5ccb4f,
+              0xfb9dc94634b778b7, 0x76eac995a518ee75, 0x42350a84c0c0cd7e}},
+            {{0x370a1ad5db339072, 0xe491e1077bc77864, 0xa83b6fd2219b892b,
+              0x3cde4bac234c6df2, 0x86c32a2b8fc13971, 0x738dd5d7aa21685b}}
+        },
+        {
+            {{0x9ac677cc32fd0734, 0x2a80a867b8706df5, 0xb6115df9dbcbf780,
+              0xf021e3fe1fdf0fad, 0xa03f758cd814d25c, 0x1be4a4be76862ec5}},
+            {{0x1b2cf54336117569, 0xe09ee3c00268b07a, 0x818422c3302a3f11,
+              0x24cf45ba2d332e74, 0x3d0a2443276e58c6, 0x7a2d1a1364015d6c}}
+        },
+        {
+            {{0xc2a095b9ecaa7059, 0xba1d6bb648f8d6d6, 0x90d8fc61579f6ce8,
+              0xa620880ab13539a4, 0xd1b9f70c7ad58fc5, 0x27aab7592b3b9923}},
+            {{0x45af661a3a2ebe58, 0xfa2db6d039e4c632, 0x5948ab5315994ff9,
+              0xd25789a1f2585ef6, 0x9e1f3db7753121a5, 0x8018581df1b60330}}
+        }
+    },
+    {
+        {
+            {{0, 0, 0, 0, 0, 0}},
+            {{0, 0, 0, 0, 0, 0}}
+        },
+        {
+            {{0xbcc88422c2ec3731, 0x78a3e4d410dc4ec2, 0x745da1ef2571d6b1,
+              0xf01c2921739a956e, 0xeffd8065e4bffc16, 0x6efe62a1f36fe72c}},
+            {{0xf49e90d20f4629a4, 0xadd1dcc78ce646f4, 0xcb78b583b7240d91,
+              0x2e1a7c3c03f8387f, 0x16566c223200f2d9, 0x2361b14baaf80a84}}
+        },
+        {
+            {{0xc20fb9111a42e5e7, 0x075a678b81d12863, 0x12bcbc6a5cc0aa89,
+              0x5279c6ab4fb9f01e, 0xbc8e178911ae1b89, 0xae74a706c290003c}},
+            {{0x9949d6ec79df3f45, 0xba18e26296c8d37f, 0x68de6ee2dd2275bf,
+              0xa9e4fff8c419f1d5, 0xbc759ca4a52b5a40, 0xff18cbd863b0996d}}
+        },
+        {
+            {{0x512d2bd0b3bdc52a, 0x6ca47ee9b4b31323, 0x2cbf9130c2807d57,
+              0xf77a6c5377b05579, 0x060d1686cd827a01, 0xb2bfdcc94d060eee}},
+            {{0x2167ef3f4aa9a23d, 0x5d83db331557a750, 0xc88ef8acb42e51e1,
+              0x79473900afa1ae46, 0xe511c625e1b4a918, 0xf0be6e201573cf7a}}
+        },
+        {
+            {{0xd23658c8d2e15a8c, 0x23f93df716ba28ca, 0x6dab10ec082210f1,
+              0xfb1add91bfc36490, 0xeda8b02f9a4f2d14, 0x9060318c56560443}},
+            {{0x6c01479e64711ab2, 0x41446fc7e337eb85, 0x4dcf3c1d71888397,
+              0x87a9c04e13c34fd2, 0xfe0e08ec510c15ac, 0xfc0d0413c0f495d2}}
+        },
+        {
+            {{0x82559d91ff88320c, 0x321dec9e965ac653, 0x2210c11308a16dd8,
+              0xd8ac4738d6a8e525, 0xd0be9868747c8bfe, 0x30c8b8baf1e2f485}},
+            {{0x32f2ecf320eb7f95, 0x2d4702e0e8639e44, 0xfa36aca81e375480,
+              0x1188e69fd1ec324d, 0x10502f98597dc127, 0x471113597e9850dc}}
+        },
+        {
+            {{0x20448376648d0e7d, 0x34e4b9c2a4482079, 0xace6f1d6f650b621,
+              0x6a556ccac9420a45, 0x9a6f10983a372144, 0x663e85ca559c0308}},
+            {{0x32be5aaea531a8bc, 0x6292fc31665d8377, 0x30f1ec29b1072b86,
+              0x1edd8ccc3842c06b, 0x888639acd3f3184a, 0x7ed3365dc61b45f9}}
+        },
+        {
+            {{0x39c7719ac0859b33, 0x0fe34e457e32321c, 0xa0ff9509c499dee0,
+              0x806fd921ac479e7f, 0xf19f626540221682, 0xf4ec128b148e3665}},
+            {{0xbca87a205b3529d9, 0xad783587394bfab6, 0x9e79a83893d15e9c,
+              0x9a52b8aa8220c8e6, 0x765b8a67acf7b50e, 0xe57eb4e3346dfa21}}
+        },
+        {
+            {{0xc32730e8dd14d47e, 0xcdc1fd42c0f01e0f, 0x2bacfdbf3f5cd846,
+              0x45f364167272d4dd, 0xdd813a795eb75776, 0xb57885e450997be2}},
+            {{0xda054e2bdb8c9829, 0x4161d820aab5a594, 0x4c428f31026116a3,
+              0x372af9a0dcd85e91, 0xfda6e903673adc2d, 0x4526b8aca8db59e6}}
+        },
+        {
+            {{0x9902de8a11070360, 0xfd8a700c96b9c077, 0xf5acaa823a6d4579,
+              0x085506b74ec411fa, 0xdfdce4f15dc55b2f, 0x18ac97a0fef30171}},
+            {{0x8dd67ef35fa55e14, 0xba5b5ed397aceccf, 0x5d72c6bab42803a0,
+              0xd8b2cf556ae7d432, 0x5d16408b732c2157, 0x7bbd9254658acdda}}
+        },
+        {
+            {{0xb49b90faf649514d, 0x6066ae3150e9f31d, 0x5a6d557b8626d7fe,
+              0xe9fdbd8134a9dd5c, 0x7be787c7894ba2d8, 0x46c3f6687c5c2425}},
+            {{0x588676c3ffdc387d, 0xcbb51731ab6f890a, 0x47f35e486a6f245d,
+              0x4f7cfe15183b01e7, 0x155162a5faa8deb6, 0xc99ca77a53707e55}}
+        },
+        {
+            {{0x2365db7248f1fe0f, 0xc3810704bed034c9, 0x31784eccec8ee689,
+              0x0afef342eb61595a, 0xaa6a7ccf802a6e7b, 0x1a3af9219cce4b91}},
+            {{0x64e5adc646a30e92, 0x6bb156948f6f63c6, 0xd94f43513e567a0a,
+              0x4996e9440c4b6b57, 0xa960836f48768226, 0x15a2388b6e9f104e}}
+        },
+        {
+            {{0x1ea2d99be2045650, 0xb385a3da2f68bf37, 0x65e0fb84338020af,
+              0x95bbb4eaad04a2ae, 0x62f963dae7402f0f, 0xddaa5a0962a6bca9}},
+            {{0x63c55129223f7430, 0x61a137e4cc22e1bf, 0x44f6aa8f0d52a241,
+              0x21ae5ead4c074811, 0x14ed17cf8bcebafc, 0xd1f7d334e1427ae7}}
+        },
+        {
+            {{0x5a196e84a65562d8, 0xcbf02607613f593f, 0x36d25167de217dd2,
+              0x0077eb2225db897e, 0xa01c9b9de7d81483, 0x5c3d37f1e2f1264b}},
+            {{0x50dedc6a8852504e, 0x6ec1f2257bd6e0f1, 0xf55d547da6a2780b,
+              0x1fa361bc3c9590a1, 0x406afa0d68afcecc, 0xb3acf835e4201aa9}}
+        },
+        {
+            {{0x91ad008f41de2b11, 0xaa838273077e17e9, 0x62a71340d558fa78,
+              0x6a377ab7c232da52, 0xd816ba7403ea5534, 0x7d0b7cbf2d8c5c3f}},
+            {{0xf973c6bbb7022ee5, 0x0af72ccf0eb7c914, 0x49a4219bb94ceba7,
+              0x9098969832e07aec, 0x725f579588be123d, 0xebe5a5bb0f10d0eb}}
+        },
+        {
+            {{0xbec4ce0f180eddc9, 0x91fb6447d91268b5, 0x25e3e5a6cc590234,
+              0x91fca3300c155e2a, 0x44a45923ea10c7c7, 0x613dcff93baa6cb0}},
+            {{0x4974e5e6eafa94da, 0xe23c88bb36b6e68f, 0x0ce0b9802ea46814,
+              0x2e414799b1b20a3a, 0x92cbf491ddac006d, 0x61eed0958a291c68}}
+        },
+        {
+            {{0x2e7d0a16204be028, 0x4f1d082ed0e41851, 0x15f1ddc63eb317f9,
+              0xf02750715adf71d7, 0x2ce33c2eee858bc3, 0xa24c76d1da73b71a}},
+            {{0x9ef6a70a6c70c483, 0xefcf170505cf9612, 0x9f5bf5a67502de64,
+              0xd11122a1a4701973, 0x82cfaac2a2ea7b24, 0x6cad67cc0a4582e1}}
+        },
+        {
+            {{0xaffa27d7d737d652, 0xf0768af07e4b78db, 0xafe04814caafe0a9,
+              0x28b69f26ab46a47d, 0x9b0c6447783a2081, 0x07788054944655b0}},
+            {{0x9bd0e43afe1fad60, 0x3a23fc0504e2ed84, 0x43cd26b4dfede602,
+              0x79078cc77d0468f9, 0x9ef04fab6d82dcc5, 0x7b1901ca4e283c22}}
+        },
+        {
+            {{0xbfe43437cc33fbf2, 0x72da10b0270311f7, 0x212c14d8d05d37c8,
+              0x5d949fd3961889f1, 0x24285e35ab3e1bdb, 0xf1a0d8ca402e7c07}},
+            {{0x0faf34fbee5d9281, 0x67c8d79558341ef8, 0x24339b51a0ae8af4,
+              0x9405f0a6ab048008, 0x122a47d01a83c1b8, 0x554470c1938a1c21}}
+        },
+        {
+            {{0xe098517cfeb32792, 0x80514127039209f0, 0x95c71b928e331a36,
+              0x147e447a23175fea, 0x3bf93a3346bdd2d4, 0x35bfff59870d0afa}},
+            {{0x9843093f12da103a, 0x1fefe3b55fb4e482, 0xed624f7ce2f7c94b,
+              0x6cb2e4f4eb88e39f, 0x1d644910483ad883, 0x1443c3de20734a97}}
+        },
+        {
+            {{0x8bc4b390fbf367c8, 0x9d44525845f38aaf, 0xf373af73bd690ffa,
+              0xf4990deb0a072ca0, 0xa7c225250ab4d3fc, 0xc2977a65c9da9b38}},
+            {{0x31d21264318adbdc, 0x7f80852c59e37522, 0xc3a47a5c4042244a,
+              0x3968b14415b34a19, 0xf52f19ffc326ee89, 0xa5cc52e422ba44de}}
+        },
+        {
+            {{0xb6bf1df360e12707, 0x49e18d3de06ea42e, 0x27e2642a9fb217ae,
+              0x9d18f2a4abf3c768, 0xcbca16150144f80d, 0x22fef4da87de7e0d}},
+            {{0xd44505eb9d7294c8, 0x7a4cd6cb689996f8, 0x7d77f2dedfd9400e,
+              0x3dc897c3bbe4149e, 0xcdcc41238b1b954d, 0x2a0b2c2ab0e320a7}}
+        },
+        {
+            {{0x6df54aec688948f3, 0x4f3bc3741a380070, 0x836d51b3a6af7df5,
+              0x4da72b5c29ae6272, 0x240414e11755af57, 0xc370794590666ca7}},
+            {{0xfa2dcd66fd7833fb, 0x2b763a6ec6fdffb1, 0x6333d9fb245359e5,
+              0x4a90a761556525a7, 0x19df9f55d3a93ebe, 0xf7e5a576373b9c0c}}
+        },
+        {
+            {{0x6fd96f8517e6b135, 0x2d8d57e2e0072884, 0xf30c84ac138e611f,
+              0x27ddda90655cf1b8, 0xc76df08c000b9b2e, 0x93adfc7865b13697}},
+            {{0x83853360dd73a56e, 0xe987e8736b1ba120, 0x567cbea4a9171d05,
+              0x302c77697975f4fb, 0xba9ddd2ec6dabd16, 0xd6e7622fe350e5d6}}
+        },
+        {
+            {{0x7c55b3c23008fa2a, 0xc075a4268d31d7e8, 0xcc26d2912494fae0,
+              0x11fcdc1663769fbf, 0x549998b9e200bb00, 0xf624c68da71352ca}},
+            {{0x37e3f076910d5f3c, 0xeea69df2c06236f5, 0x2eb89642d6914df1,
+              0x02e85f36737adaaa, 0x9629990938d8e215, 0xf87d737b0dd2a09f}}
+        },
+        {
+            {{0x4d18e00e196586a3, 0x1f4526eaf2a6bb96, 0x0df4053343d3c649,
+              0x93e72565f3cff001, 0x72b2fe17e2503251, 0xf37fd73118d8ebe7}},
+            {{0x1bc83a97aae8ee51, 0x6fa591079ad72ce1, 0x5cb23c5c754c39f9,
+              0xf68c62e61575781a, 0x4e2a9f080cab7c81, 0xc844dc364d2e3269}}
+        },
+        {
+            {{0x78826d6365ec8537, 0x698e1a9b1ee67461, 0x7aba50bd99e81879,
+              0x058a363ef4168b04, 0xdd4e8bb490d043f5, 0x79ded89a3ffa97fc}},
+            {{0xd71a93e37a306bec, 0xf5ddc115fc74b0b4, 0x6f0adf78dfa39299,
+              0xa00bb33325f83f0a, 0x2b8a1f9e51e692f5, 0xaa75e86dfd525544}}
+        },
+        {
+            {{0xd4407e8fdec08b5e, 0xb79746f3a5600de7, 0xfefa8c0bcdf8cab9,
+              0x78d06bd2625985f5, 0xe3b221e67c391cae, 0xe086ce0cb484833f}},
+            {{0x2c426966ab1e46a9, 0x00c1165af34cb4b6, 0x45831eb841682553,
+              0x905420ccca6e3495, 0xa656127bf6e50ca2, 0x1a5e13fb6d15d49d}}
+        },
+        {
+            {{0x9fe285bae8e0b4a9, 0xd44c77f8a0c80413, 0x5f376ba4eaf35fa6,
+              0xc4a8aecbf7285807, 0x4804c3131fa02f4d, 0x18443636e481c62c}},
+            {{0x9aa1d58e3e49093c, 0xc79960e316723fa3, 0xd884fef0d1186074,
+              0xbdf4b77fe285d157, 0xcfbf592dc39c8728, 0x26df21c18d66ad2d}}
+        },
+        {
+            {{0x523973f2399293d6, 0x8324509452053f38, 0x915b7dfec271f828,
+              0xac9d901a64db45ff, 0xe495790b77f23f3b, 0x3c7ca6ddebc887d9}},
+            {{0xef5ee508b668e409, 0x9b1b50caac505d80, 0x8efca9fdd058b6d8,
+              0x7983efea8983fa49, 0xe946c8d091a437f6, 0xa8b9657da347a1f2}}
+        },
+        {
+            {{0xf3880fca5ce976a7, 0xcc10a2926ad9c401, 0x3634bed1fbf7fa34,
+              0xd4cb2db5d7230c7e, 0x377c36c17ac6104f, 0x098bcf90901c51df}},
+            {{0x81c9f5d918edd2d3, 0xa29a6552030cfaf8, 0xd9122b4f0a577702,
+              0xd819d2ce81194fbb, 0x381747a44efeca8f, 0xc08bc6e73d4fd1a3}}
+        },
+        {
+            {{0x51afa04b22933489, 0x2d82008fdbf383d7, 0xecc91d2c30965ed4,
+              0x35f148103e7c31b8, 0x7e3d48e8cb5dacb3, 0xb9f65487fffd44f2}},
+            {{0x6f4db2230b6eed56, 0x76f508a250fc02a3, 0xd326a104efb655e3,
+              0xb7d3a9ebee86d1e9, 0xfc84665f67df07ca, 0x5b44632dc877d836}}
+        }
+    }
+};
+
+/* The odd multiples of base point G in the Montgomery domain, PRE_COMPUTE_ODD_G[i] = (2*i + 1)*G */
+static const AffinePoint PRE_COMPUTE_ODD_G[TABLE_ODD_G_SIZE] = {
+    {
+        {{0x3dd0756649c0b528, 0x20e378e2a0d6ce38, 0x879c3afc541b4d6e,
+          0x6454868459a30eff, 0x812ff723614ede2b, 0x4d3aadc2299e1513}},
+        {{0x23043dad4b03a4fe, 0xa1bfa8bf7bb4a9ac, 0x8bade7562e83b050,
+          0xc6c3521968f4ffd9, 0xdd8002263969a840, 0x2b78abc25a15c5e9}}
+    },
+    {
+        {{0x05e4dbe6c1dc4073, 0xc54ea9fff04f779c, 0x6b2034e9a170ccf0,
+          0x3a48d732d51c6c3e, 0xe36f7e2d263aa470, 0xd283fe68e7c1c3ac}},
+        {{0x7e284821c04ee157, 0x92d789a77ae0e36d, 0x132663c04ef67446,
+          0x68012d5ad2e1d0b4, 0xf6db68b15102b339, 0x465465fc983292af}}
+    },
+    {
+        {{0xbb595eba68f1f0df, 0xc185c0cbcc873466, 0x7f1eb1b5293c703b,
+          0x60db2cf5aacc05e6, 0xc676b987e2e8e4c6, 0xe1bb26b11d178ffb}},
+        {{0x2b694ba07073fa21, 0x22c16e2e72f34566, 0x80b61b3101c35b99,
+          0x4b237faf982c0411, 0xe6c5944024de236d, 0x4db1c9d6e209e4a3}}
+    },
+    {
+        {{0xdf13b9d17d69222b, 0x4ce6415f874774b1, 0x731edcf8211faa95,
+          0x5f4215d1659753ed, 0xf893db589db2df55, 0x932c9f811c89025b}},
+        {{0x0996b2207706a61e, 0x135349d5a8641c79, 0x65aad76f50130844,
+          0x0ff37c0401fff780, 0xf57f238e693b0706, 0xd90a16b6af6c9b3e}}
+    },
+    {
+        {{0x2f5d200e2353b92f, 0xe35d87293fd7e4f9, 0x26094833a96d745d,
+          0xdc351dc13cbfff3f, 0x26d464c6dad54d6a, 0x5cab1d1d53636c6a}},
+        {{0xf2813072b18ec0b0, 0x3777e270d742aa2f, 0x27f061c7033ca7c2,
+          0xa6ecaccc68ead0d8, 0x7d9429f4ee69a754, 0xe770633431e8f5c6}}
+    },
+    {
+        {{0xc7708b19b68b8c7d, 0x4532077c44377aba, 0x0dcc67706cdad64f,
+          0x01b8bf56147b6602, 0xf8d89885f0561d79, 0x9c19e9fc7ba9c437}},
+        {{0x764eb146bdc4ba25, 0x604fe46bac144b83, 0x3ce813298a77e780,
+          0x2e070f36fe9e682e, 0x41821d0c3a53287a, 0x9aa62f9f3533f918}}
+    },
+    {
+        {{0x9b7aeb7e75ccbdfb, 0xb25e28c5f6749a95, 0x8a7a8e4633b7d4ae,
+          0xdb5203a8d9c1bd56, 0xd2657265ed22df97, 0xb51c56e18cf23c94}},
+        {{0xf4d394596c3d812d, 0xd8e88f1a87cae0c2, 0x789a2a48cf4d0fe3,
+          0xb7feac2dfec38d60, 0x81fdbd1c3b490ec3, 0x4617adb7cc6979e1}}
+    },
+    {
+        {{0x446ad8884709f4a9, 0x2b7210e2ec3dabd8, 0x83ccf19550e07b34,
+          0x59500917789b3075, 0x0fc01fd4eb085993, 0xfb62d26f4903026b}},
+        {{0x2309cc9d6fe989bb, 0x61609cbd144bd586, 0x4b23d3a0de06610c,
+          0xdddc2866d898f470, 0x8733fc41400c5797, 0x5a68c6fed0bc2716}}
+    },
+    {
+        {{0x8903e1304b4a3cd0, 0x3ea4ea4c8ff1f43e, 0xe6fc3f2af655a10d,
+          0x7be3737d524ffefc, 0x9f6928555330455e, 0x524f166ee475ce70}},
+        {{0x3fcc69cd6c12f055, 0x4e23b6ffd5b9c0da, 0x49ce6993336bf183,
+          0xf87d6d854a54504a, 0x25eb5df1b3c2677a, 0xac37986f55b164c9}}
+    },
+    {
+        {{0x82a2ed4abaa84c08, 0x22c4cc5f41a8c912, 0xca109c3b154aad5e,
+          0x23891298fc38538e, 0xb3b6639c539802ae, 0xfa0f1f450390d706}},
+        {{0x46b78e5db0dc21d0, 0xa8c72d3cc3da2eac, 0x9170b3786ff2f643,
+          0x3f5a799bb67f30c3, 0x15d1dc778264b672, 0xa1d47b23e9577764}}
+    },
+    {
+        {{0x08265e510422ce2f, 0x88e0d496dd2f9e21, 0x30128aa06177f75d,
+          0x2e59ab62bd9ebe69, 0x1b1a0f6c5df0e537, 0xab16c626dac012b5}},
+        {{0x8014214b008c5de7, 0xaa740a9e38f17bea, 0x262ebb498a149098,
+          0xb454111e8527cd59, 0x266ad15aacea5817, 0x21824f411353ccba}}
+    },
+    {
+        {{0xd1b4e74d12e3683b, 0x990ed20b569b8ef6, 0xb9d3dd25429c0a18,
+          0x1c75b8ab2a351783, 0x61e4ca2b905432f0, 0x80826a69eea8f224}},
+        {{0x7fc33a6bec52abad, 0x0bcca3f0a65e4813, 0x7ad8a132a527cebe,
+          0xf0138950eaf22c7e, 0x282d2437566718c1, 0x9dfccb0de2212559}}
+    },
+    {
+        {{0x1e93722758ce3b83, 0xbb280dfa3cb3fb36, 0x57d0f3d2e2be174a,
+          0x9bd51b99208abe1e, 0x3809ab50de248024, 0xc29c6e2ca5bb7331}},
+        {{0x9944fd2e61124f05, 0x83ccbc4e9009e391, 0x01628f059424a3cc,
+          0xd6a2f51dea8e4344, 0xda3e1a3d4cebc96e, 0x1fe6fb42e97809dc}}
+    },
+    {
+        {{0xa04482d2467d66e4, 0xcf1912934d78291d, 0x8e0d4168482396f9,
+          0x7228e2d5d18f14d0, 0x2f7e8d509c6a58fe, 0xe8ca780e373e5aec}},
+        {{0x42aad1d61b68e9f8, 0x58a6d7f569e2f8f4, 0xd779adfe31da1bea,
+          0x7d26540638c85a85, 0x67e67195d44d3cdf, 0x17820a0bc5134ed7}}
+    },
+    {
+        {{0x019d6ac5d3021470, 0x25846b66780443d6, 0xce3c15ed55c97647,
+          0x3dc22d490e3feb0f, 0x2065b7cba7df26e4, 0xc8b00ae8187cea1f}},
+        {{0x1a5284a0865dded3, 0x293c164920c83de2, 0xab178d26cce851b3,
+          0x8e6db10b404505fb, 0xf6f57e7190c82033, 0x1d2a1c015977f16c}}
+    },
+    {
+        {{0xa39c89317c8906a4, 0xb6e7ecdd9e821ee6, 0x2ecf8340f0df4fe6,
+          0xd42f7dc953c14965, 0x1afb51a3e3ba8285, 0x6c07c4040a3305d1}},
+        {{0xdab83288127fc1da, 0xbc0a699b374c4b08, 0x402a9bab42eb20dd,
+          0xd7dd464f045a7a1c, 0x5b3d0d6d36beecc4, 0x475a3e756398a19d}}
+    }
+};
+
+/* Select the point with subscript index in the table and place it in the point.
+   The anti-side channel processing exists. */
+static void GetAffinePointFromTable(AffinePoint *point, const AffinePoint table[],
+                                    uint32_t pointNum, const uint64_t index)
+{
+    uint64_t mask, i;
+    for (i = 0; i < pointNum; i++) {
+        /* If i is equal to index, the last mask is all Fs. Otherwise, the last mask is all 0s. */
+        /* Shift rightwards by 63 bits and get the most significant bit. */
+        mask = (0 - (i ^ index)) >> 63;
+        mask--;
+        /* Conditionally assign a value, which takes effect only when i = index. */
+        FelemAssignWithMask(&point->x, &table[i].x, mask);
+        FelemAssignWithMask(&point->y, &table[i].y, mask);
+    }
+}
+
+/* Select the point with subscript index in the table and place it in the point.
+   The anti-side channel processing exists. */
+static void GetPointFromTable(Point *point, const Point table[],
+                              uint32_t pointNum, const uint64_t index)
+{
+    uint64_t mask, i;
+    for (i = 0; i < pointNum; i++) {
+        /* If i is equal to index, the last mask is all Fs. Otherwise, the last mask is all 0s. */
+        /* Shift rightwards by 63 bits and get the most significant bit. */
+        mask = (0 - (i ^ index)) >> 63;
+        mask--;
+        /* Conditionally assign a value, which takes effect only when i = index. */
+        FelemPointAssignWithMask(point, &table[i], mask);
+    }
+}
+
+/*
+ * Five bits 20 bits apart are intercepted from the scalar k,
+   and then decoded to obtain the index of the comb table j
+ * input:
+ *      k   indicates a array of scalars, consisting of 64-bit data in little-endian order.
+ *      j   The comb table, the teeth of the table j start from bit 100*j.
+ *      i   Corresponding bit. The value is an integer ranging [0, 19]
+ * output:
+ *      Value range: 0–31, indicating the index of the comb table.
+ */
+static uint64_t GetIndexOfTableG(const Array64 *k, uint32_t j, uint32_t i)
+{
+    uint64_t bits = 0;
+    uint32_t base = j * COMB_TEETH * COMB_SPACING + i;
+    for (uint32_t m = 0; m < COMB_TEETH; m++) {
+        bits |= GET_ARRAY64_BIT(k, base + m * COMB_SPACING) << m;
+    }
+    return bits;
+}
+
+/*
+ * Six consecutive bits (i-1 to i+4) are intercepted from the scalar k2,
+   and then decoded to obtain the index of the precomputation table P
+ * input:
+ *      k2  indicates a array of scalars, consisting of 64-bit data in little-endian order.
+ *      i   Corresponding bit. The value range is [0, 380], which can be exactly divisible by 5.
+ * output:
+ *      sign    0 or 1: indicates whether the corresponding point needs negation.
+ *      value   0-16: indicates the index of the pre-computation table.
+ */
+static void GetIndexOfTableP(uint64_t *sign, uint64_t *value, const Array64 *k2, uint32_t i)
+{
+    uint32_t s, v;
+    uint64_t bits;
+    if (i == 0) {
+        // When i is the least significant bit, only the four least significant bits of k2 are truncated.
+        bits = k2->data[0] << 1;
+    } else {
+        uint32_t num = (i - 1) / 64;    // Each uint64_t contains 64 bits.
+        uint32_t shift = (i - 1) % 64;  // Each uint64_t contains 64 bits.
+        bits = (k2->data[num] >> shift);
+        if (shift + 6 > 64) { // (64 - shift) bits have been truncated. If it is less than 6 bits, continue truncating.
+            bits |= k2->data[num + 1] << (64 - shift);
+        }
+    }
+    // truncates six bits. (5-bit signed number complement + 1-bit low-order carry flag)
+    bits &= (1 << (WINDOW_SIZE + 1)) - 1;
+
+    DecodeScalarCode(&s, &v, (uint32_t)bits);
+    *sign = s;
+    *value = v;
+}
+
+/*
+ * Calculate r = k * G with the comb tables, 19 point doubles and 80 point additions. This is the ConstTime processing
+ * function.
+ */
+static void FelemPointMulG(Point *r, const Array64 *k)
+{
+    Point res = {0}; // res is initialized to the point at infinity.
+    AffinePoint tmp;
+    for (int32_t i = COMB_SPACING - 1; i >= 0; i--) {
+        if (i != COMB_SPACING - 1) {
+            FelemPointDouble(&res, &res);
+        }
+        for (uint32_t j = 0; j < COMB_TABLES; j++) {
+            GetAffinePointFromTable(&tmp, PRE_COMPUTE_G[j], TABLE_G_SIZE, GetIndexOfTableG(k, j, (uint32_t)i));
+            // The point at infinity of the table is handled by the mixed addition.
+            FelemPointMixAdd(&res, &res, &tmp);
+        }
+    }
+    FelemPointAssign(r, &res);
+}
+
+/*
+ * Calculate r = k * P with the signed 5-bit window. This is the ConstTime processing function.
+ * input:
+ *      k   a scalar multiplied by point P.
+ *      preCompute  P-point precalculation table (0P, 1P, ... 16P) 17 points in total.
+ * output:
+ *      r   Point of the calculation result
+ */
+static void FelemPointMulP(Point *r, const Array64 *k, const Point preCompute[TABLE_P_SIZE])
+{
+    Point res = {0};
+    Point tmp = {0};
+    Felem negY;
+    uint64_t mask, sign, index;
+    /* The most significant window starts from bit 380, the sign bit of which is bit 384. */
+    for (int32_t i = FELEM_BITS - WINDOW_SIZE + 1; i >= 0; i -= WINDOW_SIZE) {
+        GetIndexOfTableP(&sign, &index, k, (uint32_t)i);
+        GetPointFromTable(&tmp, preCompute, TABLE_P_SIZE, index);
+        /* If the value is a negative number, the point is also negative. */
+        FelemNeg(&negY, &tmp.y);
+        mask = 0 - sign;
+        FelemAssignWithMask(&tmp.y, &negY, mask);
+        if (i == FELEM_BITS - WINDOW_SIZE + 1) {
+            /* The point out is zero, the point addition operation is equivalent to direct assignment. */
+            FelemPointAssign(&res, &tmp);
+        } else {
+            FelemPointMultDouble(&res, &res, WINDOW_SIZE);
+            FelemPointAdd(&res, &res, &tmp);
+        }
+    }
+    FelemPointAssign(r, &res);
+}
+
+static inline bool Array64IsZero(const Array64 *k)
+{
+    uint64_t bits = 0;
+    for (uint32_t i = 0; i < SCALAR_LIMBS; i++) {
+        bits |= k->data[i];
+    }
+    return bits == 0;
+}
+
+/*
+ * Calculate the width-w NAF of the scalar k. Every non-zero digit is odd and less than 2^(w-1) in absolute value, and
+ * at most one of any w consecutive digits is non-zero. The scalar is public, so the time taken depends on it.
+ * Returns the number of digits.
+ */
+static uint32_t ComputeWnaf(int8_t wnaf[WNAF_MAX_LEN], const Array64 *k, uint32_t w)
+{
+    Array64 t = *k;
+    uint32_t len = 0;
+    const int32_t full = 1 << w;
+    while (!Array64IsZero(&t) && len < WNAF_MAX_LEN) {
+        int32_t digit = 0;
+        if ((t.data[0] & 1) != 0) {
+            digit = (int32_t)(t.data[0] & (uint64_t)(full - 1));
+            if (digit >= full / 2) {
+                digit -= full;
+            }
+            /* t -= digit, the lower w bits of t are cleared. */
+            if (digit > 0) {
+                t.data[0] -= (uint64_t)digit; // The lower w bits of t are the digit, there is no borrow.
+            } else {
+                uint64_t carry = (uint64_t)(-digit);
+                for (uint32_t i = 0; i < SCALAR_LIMBS && carry != 0; i++) {
+                    t.data[i] += carry;
+                    carry = (t.data[i] < carry) ? 1 : 0;
+                }
+            }
+        }
+        wnaf[len++] = (int8_t)digit;
+        /* t >>= 1 */
+        for (uint32_t i = 0; i + 1 < SCALAR_LIMBS; i++) {
+            t.data[i] = (t.data[i] >> 1) | (t.data[i + 1] << 63);
+        }
+        t.data[SCALAR_LIMBS - 1] >>= 1;
+    }
+    return len;
+}
+
+/*
+ * Calculate r = k1 * G + k2 * P with the interleaved wNAF, the point doubles are shared by both scalars.
+ * input:
+ *      k1  a scalar multiplied by point G.
+ *      k2  a scalar multiplied by point P.
+ *      preCompute  the odd multiples of point P, (1P, 3P, ... 15P) 8 points in total.
+ * output:
+ *      r   Point of the calculation result
+ */
+static void FelemPointMulAddWnaf(Point *r, const Array64 *k1, const Array64 *k2,
+                                 const Point preCompute[TABLE_ODD_P_SIZE])
+{
+    int8_t wnafG[WNAF_MAX_LEN];
+    int8_t wnafP[WNAF_MAX_LEN];
+    uint32_t lenG = ComputeWnaf(wnafG, k1, WNAF_G_WINDOW);
+    uint32_t lenP = ComputeWnaf(wnafP, k2, WNAF_P_WINDOW);
+    Point res = {0}; // res is initialized to the point at infinity.
+    Point tmp;
+    AffinePoint affine;
+    bool isZero = true; // Whether the res point has not been assigned.
+    for (int32_t i = (int32_t)(lenG > lenP ? lenG : lenP) - 1; i >= 0; i--) {
+        /* If the point out remains zero, the double point operation has no effect, skipping */
+        if (!isZero) {
+            FelemPointDouble(&res, &res);
+        }
+        int32_t digit = ((uint32_t)i < lenP) ? wnafP[i] : 0;
+        if (digit != 0) {
+            FelemPointAssign(&tmp, &preCompute[(digit < 0 ? -digit : digit) >> 1]);
+            if (digit < 0) {
+                FelemNeg(&tmp.y, &tmp.y);
+            }
+            if (isZero) {
+                FelemPointAssign(&res, &tmp);
+                isZero = false;
+            } else {
+                FelemPointAdd(&res, &res, &tmp);
+            }
+        }
+        digit = ((uint32_t)i < lenG) ? wnafG[i] : 0;
+        if (digit != 0) {
+            affine = PRE_COMPUTE_ODD_G[(digit < 0 ? -digit : digit) >> 1];
+            if (digit < 0) {
+                FelemNeg(&affine.y, &affine.y);
+            }
+            if (isZero) {
+                FelemAssign(&res.x, &affine.x);
+                FelemAssign(&res.y, &affine.y);
+                FelemAssign(&res.z, &FELEM_ONE);
+                isZero = false;
+            } else {
+                FelemPointMixAdd(&res, &res, &affine);
+            }
+        }
+    }
+    FelemPointAssign(r, &res);
+}
+
+/*
+ * calculate pre-calculation table for the P point
+ * input:
+ *      pt  P point
+ * output:
+ *      preCompute  precalculation table of P point, (0P, 1P, ... 16P) 17 points in total
+ */
+static int32_t InitPreComputeTable(Point preCompute[TABLE_P_SIZE], const ECC_Point *pt)
+{
+    int32_t ret;
+    /* zero point */
+    for (uint32_t i = 0; i < NUM_LIMBS; i++) {
+        preCompute[0].x.data[i] = 0;
+        preCompute[0].y.data[i] = 0;
+        preCompute[0].z.data[i] = 0;
+    }
+    /* 1x point */
+    GOTO_ERR_IF_EX(BN2Felem(&preCompute[1].x, pt->x), ret);
+    GOTO_ERR_IF_EX(BN2Felem(&preCompute[1].y, pt->y), ret);
+    GOTO_ERR_IF_EX(BN2Felem(&preCompute[1].z, pt->z), ret);
+    /* 2 to 16x points */
+    for (uint32_t i = 2; i < TABLE_P_SIZE; i++) {
+        if ((i & 1) == 0) {
+            /* If multiple for even times, use the multiple point formula (2n)*P = 2*(n*P), where i == 2n */
+            FelemPointDouble(&preCompute[i], &preCompute[i / 2]);
+        } else {
+            /* If multiple for odd times, use the point addition formula n*P = P + (n-1)*P, where i == n */
+            FelemPointAdd(&preCompute[i], &preCompute[1], &preCompute[i - 1]);
+        }
+    }
+ERR:
+    return ret;
+}
+
+/*
+ * calculate the odd multiples of the P point
+ * input:
+ *      pt  P point
+ * output:
+ *      preCompute  odd multiples of P point, (1P, 3P, ... 15P) 8 points in total
+ */
+static int32_t InitOddPreComputeTable(Point preCompute[TABLE_ODD_P_SIZE], const ECC_Point *pt)
+{
+    int32_t ret;
+    Point doubled;
+    GOTO_ERR_IF_EX(BN2Felem(&preCompute[0].x, pt->x), ret);
+    GOTO_ERR_IF_EX(BN2Felem(&preCompute[0].y, pt->y), ret);
+    GOTO_ERR_IF_EX(BN2Felem(&preCompute[0].z, pt->z), ret);
+    FelemPointDouble(&doubled, &preCompute[0]);
+    for (uint32_t i = 1; i < TABLE_ODD_P_SIZE; i++) {
+        /* (2i + 1)*P = (2i - 1)*P + 2*P */
+        FelemPointAdd(&preCompute[i], &preCompute[i - 1], &doubled);
+    }
+ERR:
+    return ret;
+}
+
+/* Calculate r = k1 * G + k2 * pt */
+int32_t ECP384_PointMulAdd(ECC_Para *para, ECC_Point *r,
+                           const BN_BigNum *k1, const BN_BigNum *k2, const ECC_Point *pt)
+{
+    int32_t ret;
+    Array64 binG = {0};
+    Array64 binP = {0};
+    Point preCompute[TABLE_ODD_P_SIZE]; /* Odd multiples of point pt */
+    Point out;
+    uint32_t len;
+    /* Input parameter check */
+    GOTO_ERR_IF(CheckParaValid(para, CRYPT_ECC_NISTP384), ret);
+    GOTO_ERR_IF(CheckPointValid(r, CRYPT_ECC_NISTP384), ret);
+    GOTO_ERR_IF(CheckBnValid(k1, FELEM_BITS), ret);
+    GOTO_ERR_IF(CheckBnValid(k2, FELEM_BITS), ret);
+    GOTO_ERR_IF(CheckPointValid(pt, CRYPT_ECC_NISTP384), ret);
+    if (BN_IsZero(pt->z)) {
+        BSL_ERR_PUSH_ERROR(CRYPT_ECC_POINT_AT_INFINITY);
+        return CRYPT_ECC_POINT_AT_INFINITY;
+    }
+    /* Convert the input BigNum */
+    len = NUM_LIMBS;
+    GOTO_ERR_IF(BN_Bn2U64Array(k1, binG.data, &len), ret);
+    len = NUM_LIMBS;
+    GOTO_ERR_IF(BN_Bn2U64Array(k2, binP.data, &len), ret);
+    /* Calculate */
+    GOTO_ERR_IF_EX(InitOddPreComputeTable(preCompute, pt), ret);
+    FelemPointMulAddWnaf(&out, &binG, &binP, preCompute);
+    /* Output result */
+    GOTO_ERR_IF_EX(Felem2BN(r->x, &out.x), ret);
+    GOTO_ERR_IF_EX(Felem2BN(r->y, &out.y), ret);
+    GOTO_ERR_IF_EX(Felem2BN(r->z, &out.z), ret);
+ERR:
+    return ret;
+}
+
+/* Calculate r = k * pt; If pt is NULL, calculate r = k * G. This is the ConstTime processing function. */
+int32_t ECP384_PointMul(ECC_Para *para, ECC_Point *r, const BN_BigNum *k, const ECC_Point *pt)
+{
+    int32_t ret;
+    Array64 bin = {0};
+    uint32_t len = NUM_LIMBS;
+    Point preCompute[TABLE_P_SIZE]; /* Pre-calculation table of Point pt */
+    Point out;
+    /* Input parameter check */
+    GOTO_ERR_IF(CheckParaValid(para, CRYPT_ECC_NISTP384), ret);
+    GOTO_ERR_IF(CheckPointValid(r, CRYPT_ECC_NISTP384), ret);
+    GOTO_ERR_IF(CheckBnValid(k, FELEM_BITS), ret);
+    if (pt != NULL) {
+        if (pt->id != CRYPT_ECC_NISTP384) {
+            BSL_ERR_PUSH_ERROR(CRYPT_ECC_POINT_ERR_CURVE_ID);
+            return CRYPT_ECC_POINT_ERR_CURVE_ID;
+        }
+        if (BN_IsZero(pt->z)) {
+            BSL_ERR_PUSH_ERROR(CRYPT_ECC_POINT_AT_INFINITY);
+            return CRYPT_ECC_POINT_AT_INFINITY;
+        }
+    }
+    /* Convert the input BigNum */
+    GOTO_ERR_IF(BN_Bn2U64Array(k, bin.data, &len), ret);
+    /* Calculate */
+    if (pt != NULL) {
+        GOTO_ERR_IF_EX(InitPreComputeTable(preCompute, pt), ret);
+        FelemPointMulP(&out, &bin, preCompute);
+    } else {
+        FelemPointMulG(&out, &bin);
+    }
+    /* Output result */
+    GOTO_ERR_IF_EX(Felem2BN(r->x, &out.x), ret);
+    GOTO_ERR_IF_EX(Felem2BN(r->y, &out.y), ret);
+    GOTO_ERR_IF_EX(Felem2BN(r->z, &out.z), ret);
+ERR:
+    return ret;
+}
+
+static int32_t MakeAffineWithInv(ECC_Point *r, const ECC_Point *a, const Felem *zInv)
+{
+    int32_t ret;
+    Felem x, y, tmp;
+    GOTO_ERR_IF_EX(BN2Felem(&x, a->x), ret);
+    GOTO_ERR_IF_EX(BN2Felem(&y, a->y), ret);
+    FelemMulReduce(&y, &y, zInv);  // y/z
+    FelemSqrReduce(&tmp, zInv);    // 1/(z^2)
+    FelemMulReduce(&x, &x, &tmp);  // x/(z^2)
+    FelemMulReduce(&y, &y, &tmp);  // y/(z^3)
+    GOTO_ERR_IF_EX(Felem2BN(r->x, &x), ret);
+    GOTO_ERR_IF_EX(Felem2BN(r->y, &y), ret);
+    GOTO_ERR_IF_EX(BN_SetLimb(r->z, 1), ret);
+ERR:
+    return ret;
+}
+
+/* Convert a point to affine coordinates. */
+int32_t ECP384_Point2Affine(const ECC_Para *para, ECC_Point *r, const ECC_Point *pt)
+{
+    int32_t ret;
+    Felem z, zInv;
+    /* Input parameter check */
+    GOTO_ERR_IF(CheckParaValid(para, CRYPT_ECC_NISTP384), ret);
+    GOTO_ERR_IF(CheckPointValid(r, CRYPT_ECC_NISTP384), ret);
+    GOTO_ERR_IF(CheckPointValid(pt, CRYPT_ECC_NISTP384), ret);
+    /* Special data processing */
+    if (BN_IsZero(pt->z)) {
+        BSL_ERR_PUSH_ERROR(CRYPT_ECC_POINT_AT_INFINITY);
+        return CRYPT_ECC_POINT_AT_INFINITY;
+    }
+    /* Convert the input data. */
+    GOTO_ERR_IF_EX(BN2Felem(&z, pt->z), ret);
+    /* Calculate and output result */
+    FelemInv(&zInv, &z);
+    GOTO_ERR_IF_EX(MakeAffineWithInv(r, pt, &zInv), ret);
+ERR:
+    return ret;
+}
+
+#endif /* defined(HITLS_CRYPTO_CURVE_NISTP384) && defined(HITLS_CRYPTO_NIST_USE_ACCEL) */
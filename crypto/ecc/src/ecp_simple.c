@@ -23,11 +23,6 @@
 #include "crypt_errno.h"
 #include "ecc_local.h"
 
-static bool BN_IsZeroOrOne(const BN_BigNum *bn)
-{
-    return (BN_IsZero(bn) || BN_IsOne(bn));
-}
-
 int32_t ECP_PointAtInfinity(const ECC_Para *para, const ECC_Point *pt)
 {
     if (para == NULL || pt == NULL) {
@@ -150,22 +145,16 @@ ERR:
 
 static int32_t Points2AffineParaCheck(const ECC_Para *para, ECC_Point *pt[], uint32_t ptNums)
 {
-    if (para == NULL || pt == NULL) {
+    if (para == NULL || pt == NULL || ptNums == 0) {
         BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
         return CRYPT_NULL_INPUT;
     }
-    if (ptNums == 0 || ptNums > PRE_COMPUTE_MAX_TABLELEN) {
-        BSL_ERR_PUSH_ERROR(CRYPT_ECC_POINT_WINDOW_TOO_MAX);
-        return CRYPT_ECC_POINT_WINDOW_TOO_MAX;
-    }
-    if (BN_IsZero(pt[0]->z)) {
-        // If the first point is an infinite point, exit directly.
-        BSL_ERR_PUSH_ERROR(CRYPT_ECC_POINT_AT_INFINITY);
-        return CRYPT_ECC_POINT_AT_INFINITY;
-    }
     // Check whether the point ID matches.
-    uint32_t i;
-    for (i = 0; i < ptNums; i++) {
+    for (uint32_t i = 0; i < ptNums; i++) {
+        if (pt[i] == NULL) {
+            BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
+            return CRYPT_NULL_INPUT;
+        }
         if (para->id != pt[i]->id) {
             BSL_ERR_PUSH_ERROR(CRYPT_ECC_POINT_ERR_CURVE_ID);
             return CRYPT_ECC_POINT_ERR_CURVE_ID;
@@ -174,21 +163,46 @@ static int32_t Points2AffineParaCheck(const ECC_Para *para, ECC_Point *pt[], uin
     return CRYPT_SUCCESS;
 }
 
-static int32_t Points2AffineCreatTmpData(BN_BigNum *pt[PRE_COMPUTE_MAX_TABLELEN], uint32_t ptNums,
-    BN_BigNum **inv, BN_Optimizer **opt, const BN_BigNum *p)
+typedef struct {
+    ECC_Point **pt;    // The points to be converted
+    BN_BigNum **z;     // z of the points
+    BN_BigNum **inv;   // 1/z of the points
+    uint32_t num;
+} Points2AffineData;
+
+static void Points2AffineDestroyTmpData(Points2AffineData *data)
 {
-    uint32_t bits = BN_Bits(p);
-    *opt = BN_OptimizerCreate();
-    *inv = BN_Create(bits);
-    if (*opt == NULL || *inv == NULL) {
+    if (data->inv != NULL) {
+        for (uint32_t i = 0; i < data->num; i++) {
+            BN_Destroy(data->inv[i]);
+        }
+    }
+    BSL_SAL_FREE(data->pt);
+    BSL_SAL_FREE(data->z);
+    BSL_SAL_FREE(data->inv);
+}
+
+// Collect the points to be converted, the points at infinity are skipped, and so are the affine points
+// out of the Montgomery domain.
+static int32_t Points2AffineCreatTmpData(Points2AffineData *data, ECC_Point *pt[], uint32_t ptNums, bool inMont,
+    uint32_t bits)
+{
+    data->pt = BSL_SAL_Malloc(ptNums * sizeof(ECC_Point *));
+    data->z = BSL_SAL_Malloc(ptNums * sizeof(BN_BigNum *));
+    data->inv = BSL_SAL_Calloc(ptNums, sizeof(BN_BigNum *));
+    if (data->pt == NULL || data->z == NULL || data->inv == NULL) {
         BSL_ERR_PUSH_ERROR(CRYPT_MEM_ALLOC_FAIL);
         return CRYPT_MEM_ALLOC_FAIL;
     }
-    uint32_t i;
-    // Apply for pre-calculation table data.
-    for (i = 0; i < ptNums; i++) {
-        pt[i] = BN_Create(bits);
-        if (pt[i] == NULL) {
+    for (uint32_t i = 0; i < ptNums; i++) {
+        if (BN_IsZero(pt[i]->z) || (!inMont && BN_IsOne(pt[i]->z))) {
+            continue;
+        }
+        data->pt[data->num] = pt[i];
+        data->z[data->num] = pt[i]->z;
+        data->inv[data->num] = BN_Create(bits);
+        data->num++;
+        if (data->inv[data->num - 1] == NULL) {
             BSL_ERR_PUSH_ERROR(CRYPT_MEM_ALLOC_FAIL);
             return CRYPT_MEM_ALLOC_FAIL;
         }
@@ -196,63 +210,70 @@ static int32_t Points2AffineCreatTmpData(BN_BigNum *pt[PRE_COMPUTE_MAX_TABLELEN]
     return CRYPT_SUCCESS;
 }
 
-static void Points2AffineDestroyTmpData(BN_BigNum *pt[PRE_COMPUTE_MAX_TABLELEN], uint32_t ptNums,
-    BN_BigNum *inv, BN_Optimizer *opt)
+// Calculate x = x/(z^2); y = y/(z^3); z = 1 with inv = 1/z, t is a temporary BigNum.
+static int32_t PointToAffineWithInv(const ECC_Para *para, ECC_Point *pt, BN_BigNum *inv, BN_BigNum *t,
+    bool inMont, BN_Optimizer *opt)
 {
-    for (uint32_t i = 0; i < ptNums; i++) {
-        BN_Destroy(pt[i]);
+    int32_t ret;
+    if (!inMont) {
+        GOTO_ERR_IF(BN_ModSqr(t, inv, para->p, opt), ret);
+        GOTO_ERR_IF(BN_ModMul(pt->x, pt->x, t, para->p, opt), ret);
+        GOTO_ERR_IF(BN_ModMul(t, t, inv, para->p, opt), ret);
+        GOTO_ERR_IF(BN_ModMul(pt->y, pt->y, t, para->p, opt), ret);
+        GOTO_ERR_IF(BN_SetLimb(pt->z, 1), ret);
+        goto ERR;
     }
-    BN_Destroy(inv);
+    // inv = 1/(z*R) is out of the domain, R/z is obtained by encoding it twice.
+    GOTO_ERR_IF(para->method->bnMontEnc(inv, para->montP, opt, false), ret);
+    GOTO_ERR_IF(para->method->bnMontEnc(inv, para->montP, opt, false), ret);
+    GOTO_ERR_IF(para->method->bnModNistEccSqr(t, inv, para->montP, opt), ret);
+    GOTO_ERR_IF(para->method->bnModNistEccMul(pt->x, pt->x, t, para->montP, opt), ret);
+    GOTO_ERR_IF(para->method->bnModNistEccMul(t, t, inv, para->montP, opt), ret);
+    GOTO_ERR_IF(para->method->bnModNistEccMul(pt->y, pt->y, t, para->montP, opt), ret);
+    GOTO_ERR_IF(BN_SetLimb(pt->z, 1), ret);
+    GOTO_ERR_IF(para->method->bnMontEnc(pt->z, para->montP, opt, false), ret);
+ERR:
+    return ret;
+}
+
+/*
+ * Multiple points are converted to the affine coordinate system with one inversion, in the Montgomery domain
+ * of the curve if inMont is true. The points at infinity are kept.
+ */
+static int32_t PointsToAffine(const ECC_Para *para, ECC_Point *pt[], uint32_t ptNums, bool inMont)
+{
+    int32_t ret;
+    uint32_t bits = BN_Bits(para->p);
+    Points2AffineData data = { 0 };
+    BN_Optimizer *opt = BN_OptimizerCreate();
+    BN_BigNum *t = BN_Create(bits);
+    if (opt == NULL || t == NULL) {
+        ret = CRYPT_MEM_ALLOC_FAIL;
+        BSL_ERR_PUSH_ERROR(ret);
+        goto ERR;
+    }
+    GOTO_ERR_IF_EX(Points2AffineCreatTmpData(&data, pt, ptNums, inMont, bits), ret);
+    if (data.num == 0) {
+        goto ERR;
+    }
+    GOTO_ERR_IF(BN_ModInvBatch(data.inv, data.z, data.num, para->p, opt), ret);
+    for (uint32_t i = 0; i < data.num; i++) {
+        GOTO_ERR_IF(PointToAffineWithInv(para, data.pt[i], data.inv[i], t, inMont, opt), ret);
+    }
+ERR:
+    Points2AffineDestroyTmpData(&data);
+    BN_Destroy(t);
     BN_OptimizerDestroy(opt);
+    return ret;
 }
 
-// Multiple points are converted to the affine coordinate system. pt[0] cannot be infinite.
 int32_t ECP_Points2Affine(const ECC_Para *para, ECC_Point *pt[], uint32_t ptNums)
 {
     int32_t ret = Points2AffineParaCheck(para, pt, ptNums);
     if (ret != CRYPT_SUCCESS) {
         return ret;
     }
-    BN_BigNum *t[PRE_COMPUTE_MAX_TABLELEN] = { 0 }; // pre-calculation table
-    BN_BigNum *inv = NULL;
-    BN_Optimizer *opt = NULL;
-    GOTO_ERR_IF(Points2AffineCreatTmpData(t, ptNums, &inv, &opt, para->p), ret);
-    // t[i] = z[0] * z[1]* ... * z[i]
-    GOTO_ERR_IF(BN_Copy(t[0], pt[0]->z), ret);
-    uint32_t i;
-    for (i = 1; i < ptNums; i++) {
-        if (BN_IsZeroOrOne(pt[i]->z)) {
-            GOTO_ERR_IF(BN_Copy(t[i], t[i - 1]), ret); // copy last one
-            continue;
-        }
-        GOTO_ERR_IF(BN_ModMul(t[i], t[i - 1], pt[i]->z, para->p, opt), ret);
-    }
-
-    // inv = 1 / (z[0] * z[1] * .... * z[ptNums - 1])
-    GOTO_ERR_IF(BN_ModInv(inv, t[ptNums - 1], para->p, opt), ret);
-
-    // t[i] = 1/z[i]
-    for (i = ptNums - 1; i > 0; i--) {
-        if (BN_IsZeroOrOne(pt[i]->z)) {
-            continue;
-        }
-        // t[i] *= z[0]*z[1]*...*z[i - 1] = 1/z[i]
-        GOTO_ERR_IF(BN_ModMul(t[i], t[i - 1], inv, para->p, opt), ret);
-        // inv *= z[i] = 1/(z[0]*z[1]*...z[i - 1])
-        GOTO_ERR_IF(BN_ModMul(inv, pt[i]->z, inv, para->p, opt), ret);
-    }
-    GOTO_ERR_IF(BN_Copy(t[0], inv), ret); // inv = 1/z[0]
-
-    // Calculate x = x/(z^2); y = y/(z^3)
-    for (i = 0; i < ptNums; i++) {
-        if (BN_IsZeroOrOne(pt[i]->z)) {
-            continue;
-        }
-        GOTO_ERR_IF(ECP_Point2AffineWithInv(para, pt[i], pt[i], t[i]), ret);
-    }
-ERR:
-    Points2AffineDestroyTmpData(t, ptNums, inv, opt);
-    return ret;
+    return PointsToAffine(para, pt, ptNums, false);
 }
 
 // consttime
@@ -516,7 +537,12 @@ ERR:
 // The default ECP window length is 5 bits and only odd points are calculated.
 #define WINDOW_TABLE_SIZE (PRE_COMPUTE_MAX_TABLELEN >> 1)
 
-static int32_t ECP_PointPreCompute(const ECC_Para *para, ECC_Point *windows[], const ECC_Point *pt)
+/*
+ * Calculate the odd multiples of pt, if affine is true, the table is converted to affine with one inversion,
+ * so that the additions of the table points are mixed. It only pays off for the cached table of G, as an
+ * inversion costs hundreds of modular multiplications.
+ */
+static int32_t ECP_PointPreCompute(const ECC_Para *para, ECC_Point *windows[], const ECC_Point *pt, bool affine)
 {
     int32_t ret;
     ECC_Point *doubleP = ECC_NewPoint(para);
@@ -549,6 +575,9 @@ static int32_t ECP_PointPreCompute(const ECC_Para *para, ECC_Point *windows[], c
     for (i = 1; i < (WINDOW_TABLE_SIZE >> 1); i++) {
         GOTO_ERR_IF(para->method->pointAdd(para, windows[i], windows[i - 1], doubleP), ret);
     }
+    if (affine) {
+        GOTO_ERR_IF_EX(PointsToAffine(para, windows, WINDOW_TABLE_SIZE >> 1, para->method->bnMontEnc != NULL), ret);
+    }
     for (i = WINDOW_TABLE_SIZE >> 1; i < WINDOW_TABLE_SIZE; i++) {
         GOTO_ERR_IF(ECP_PointInvertAtAffine(para, windows[i], windows[i - (WINDOW_TABLE_SIZE >> 1)]), ret);
     }
@@ -577,7 +606,7 @@ static int32_t ECP_ParaPrecompute(ECC_Para *para)
         BSL_ERR_PUSH_ERROR(CRYPT_MEM_ALLOC_FAIL);
         return CRYPT_MEM_ALLOC_FAIL;
     }
-    GOTO_ERR_IF(ECP_PointPreCompute(para, para->tableG, pt), ret);
+    GOTO_ERR_IF(ECP_PointPreCompute(para, para->tableG, pt, true), ret);
 ERR:
     ECC_FreePoint(pt);
     return ret;
@@ -774,11 +803,14 @@ int32_t ECP_PointMulFast(ECC_Para *para, ECC_Point *r, const BN_BigNum *k, const
 
     ECC_Point *windowsP[WINDOW_TABLE_SIZE] = { 0 };
     ECC_Point **windows = NULL;
+    // The table of G is affine.
+    int32_t (*pointAdd)(const ECC_Para *, ECC_Point *, const ECC_Point *, const ECC_Point *) =
+        (pt == NULL) ? para->method->pointAddAffine : para->method->pointAdd;
     if (pt == NULL) {
         GOTO_ERR_IF(ECP_ParaPrecompute(para), ret);
         windows = para->tableG;
     } else {
-        GOTO_ERR_IF(ECP_PointPreCompute(para, windowsP, pt), ret);
+        GOTO_ERR_IF(ECP_PointPreCompute(para, windowsP, pt, false), ret);
         windows = windowsP;
     }
 
@@ -793,7 +825,7 @@ int32_t ECP_PointMulFast(ECC_Para *para, ECC_Point *r, const BN_BigNum *k, const
     GOTO_ERR_IF(para->method->pointMultDouble(para, r, r, codeK->wide[0]), ret);
     for (uint32_t i = 1; i < codeK->size; i++) {
         offset = NUMTOOFFSET(codeK->num[i]);
-        GOTO_ERR_IF(para->method->pointAdd(para, r, r, windows[offset]), ret);
+        GOTO_ERR_IF(pointAdd(para, r, r, windows[offset]), ret);
         GOTO_ERR_IF(para->method->pointMultDouble(para, r, r, codeK->wide[i]), ret);
     }
 ERR:
@@ -835,7 +867,7 @@ int32_t ECP_PointMulAdd(ECC_Para *para, ECC_Point *r, const BN_BigNum *k1,
     ECC_Point *windowsP[WINDOW_TABLE_SIZE] = { 0 };
     ECC_Point **windowsG = NULL;
     GOTO_ERR_IF(ECP_ParaPrecompute(para), ret);
-    GOTO_ERR_IF(ECP_PointPreCompute(para, windowsP, pt), ret);
+    GOTO_ERR_IF(ECP_PointPreCompute(para, windowsP, pt, false), ret);
     windowsG = para->tableG;
     offData.codeK1 = ECC_ReCodeK(k1, PRE_COMPUTE_WINDOW);
     offData.codeK2 = ECC_ReCodeK(k2, PRE_COMPUTE_WINDOW);
@@ -855,7 +887,7 @@ int32_t ECP_PointMulAdd(ECC_Para *para, ECC_Point *r, const BN_BigNum *k1,
         GOTO_ERR_IF(para->method->pointMultDouble(para, r, r, offData.bit), ret);
         if (offData.bit == offData.bit1 && offData.offsetK1 < offData.codeK1->size) {
             int8_t offset = NUMTOOFFSET(offData.codeK1->num[offData.offsetK1]);
-            GOTO_ERR_IF(para->method->pointAdd(para, r, r, windowsG[offset]), ret);
+            GOTO_ERR_IF(para->method->pointAddAffine(para, r, r, windowsG[offset]), ret);
             offData.offsetK1++;
         }
         if (offData.bit == offData.bit2 && offData.offsetK2 < offData.codeK2->size) {
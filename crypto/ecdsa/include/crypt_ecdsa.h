@@ -267,6 +267,24 @@ int32_t CRYPT_ECDSA_Verify(const CRYPT_ECDSA_Ctx *ctx, int32_t algId, const uint
 int32_t CRYPT_ECDSA_VerifyData(const CRYPT_ECDSA_Ctx *ctx, const uint8_t *data, uint32_t dataLen,
     const uint8_t *sign, uint32_t signLen);
 
+/**
+ * @ingroup ecdsa
+ * @brief ECDSA verification of a batch of signatures, the inversions of the items on the same curve are batched.
+ *
+ * @param ctxs [IN] ecdsa context structures, ctxs[i] is the key of items[i]
+ * @param algId [IN] md algId
+ * @param items [IN] Messages and signatures
+ * @param num [IN] Number of items
+ * @param results [OUT] Verification result of every item, see CRYPT_ECDSA_Verify
+ *
+ * @retval CRYPT_NULL_INPUT         Error null pointer input
+ * @retval CRYPT_MEM_ALLOC_FAIL     Memory allocation failure
+ * @retval CRYPT_SUCCESS            All signatures are verified successfully.
+ * @retval Other error codes        The result of the first item that fails.
+ */
+int32_t CRYPT_ECDSA_VerifyBatch(const CRYPT_ECDSA_Ctx *const *ctxs, int32_t algId, const CRYPT_VerifyItem *items,
+    uint32_t num, int32_t *results);
+
 /**
  * @ingroup ecdsa
  * @brief ECDSA Set the private key data.
@@ -389,38 +389,22 @@ static int32_t VerifyCheckSign(const BN_BigNum *paraN, BN_BigNum *r, BN_BigNum *
     return CRYPT_SUCCESS;
 }
 
-static int32_t EcdsaVerifyCore(const CRYPT_ECDSA_Ctx *ctx, const BN_BigNum *paraN, BN_BigNum *d, const BN_BigNum *r,
-    const BN_BigNum *s)
+// tpt = u1*G + u2*pubkey, where u1 = msg*(1/s) mod n, u2 = r*(1/s) mod n and w = 1/s mod n
+static int32_t EcdsaVerifyPoint(const CRYPT_ECDSA_Ctx *ctx, const BN_BigNum *paraN, const BN_BigNum *d,
+    const BN_BigNum *r, const BN_BigNum *w, ECC_Point *tpt, BN_Optimizer *opt)
 {
-    BN_Optimizer *opt = BN_OptimizerCreate();
-    if (opt == NULL) {
-        BSL_ERR_PUSH_ERROR(CRYPT_MEM_ALLOC_FAIL);
-        return CRYPT_MEM_ALLOC_FAIL;
-    }
     (void)OptimizerStart(opt);
-    ECC_Point *tpt = ECC_NewPoint(ctx->para);
     uint32_t keyBits = CRYPT_ECDSA_GetBits(ctx);
     uint32_t room = BITS_TO_BN_UNIT(keyBits);
-    BN_BigNum *w = OptimizerGetBn(opt, room);
     BN_BigNum *u1 = OptimizerGetBn(opt, room);
     BN_BigNum *u2 = OptimizerGetBn(opt, room);
-    BN_BigNum *v = OptimizerGetBn(opt, room);
-    BN_BigNum *tptX = OptimizerGetBn(opt, room);
     int32_t ret;
-    if (tpt == NULL) {
-        ret = CRYPT_MEM_ALLOC_FAIL;
-        BSL_ERR_PUSH_ERROR(ret);
-        goto ERR;
-    }
-    if ((w == NULL) || (u1 == NULL) || (u2 == NULL) || (v == NULL) || (tptX == NULL)) {
+    if ((u1 == NULL) || (u2 == NULL)) {
         ret = CRYPT_BN_OPTIMIZER_GET_FAIL;
         BSL_ERR_PUSH_ERROR(ret);
         goto ERR;
     }
 
-    // w = 1/s mod n
-    GOTO_ERR_IF(ECC_ModOrderInv(ctx->para, w, s), ret);
-
     // u1 = msg*(1/s) mod n
     GOTO_ERR_IF(BN_ModMul(u1, d, w, paraN, opt), ret);
 
@@ -429,6 +413,26 @@ static int32_t EcdsaVerifyCore(const CRYPT_ECDSA_Ctx *ctx, const BN_BigNum *para
 
     // tpt : u1*G + u2*pubkey
     GOTO_ERR_IF(ECC_PointMulAdd(ctx->para, tpt, u1, u2, ctx->pubkey), ret);
+ERR:
+    OptimizerEnd(opt);
+    return ret;
+}
+
+// Check whether the x-coordinate of tpt mod n equals r.
+static int32_t EcdsaVerifyCheckX(const CRYPT_ECDSA_Ctx *ctx, const BN_BigNum *paraN, const BN_BigNum *r,
+    ECC_Point *tpt, BN_Optimizer *opt)
+{
+    (void)OptimizerStart(opt);
+    uint32_t keyBits = CRYPT_ECDSA_GetBits(ctx);
+    uint32_t room = BITS_TO_BN_UNIT(keyBits);
+    BN_BigNum *v = OptimizerGetBn(opt, room);
+    BN_BigNum *tptX = OptimizerGetBn(opt, room);
+    int32_t ret;
+    if ((v == NULL) || (tptX == NULL)) {
+        ret = CRYPT_BN_OPTIMIZER_GET_FAIL;
+        BSL_ERR_PUSH_ERROR(ret);
+        goto ERR;
+    }
 
     GOTO_ERR_IF(ECC_GetPointDataX(ctx->para, tpt, tptX), ret);
     GOTO_ERR_IF(BN_Mod(v, tptX, paraN, opt), ret);
@@ -437,7 +441,41 @@ static int32_t EcdsaVerifyCore(const CRYPT_ECDSA_Ctx *ctx, const BN_BigNum *para
         BSL_ERR_PUSH_ERROR(ret);
         ret = CRYPT_ECDSA_VERIFY_FAIL;
     }
+ERR:
+    OptimizerEnd(opt);
+    return ret;
+}
+
+static int32_t EcdsaVerifyCore(const CRYPT_ECDSA_Ctx *ctx, const BN_BigNum *paraN, BN_BigNum *d, const BN_BigNum *r,
+    const BN_BigNum *s)
+{
+    BN_Optimizer *opt = BN_OptimizerCreate();
+    if (opt == NULL) {
+        BSL_ERR_PUSH_ERROR(CRYPT_MEM_ALLOC_FAIL);
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    (void)OptimizerStart(opt);
+    ECC_Point *tpt = ECC_NewPoint(ctx->para);
+    uint32_t keyBits = CRYPT_ECDSA_GetBits(ctx);
+    BN_BigNum *w = OptimizerGetBn(opt, BITS_TO_BN_UNIT(keyBits));
+    int32_t ret;
+    if (tpt == NULL) {
+        ret = CRYPT_MEM_ALLOC_FAIL;
+        BSL_ERR_PUSH_ERROR(ret);
+        goto ERR;
+    }
+    if (w == NULL) {
+        ret = CRYPT_BN_OPTIMIZER_GET_FAIL;
+        BSL_ERR_PUSH_ERROR(ret);
+        goto ERR;
+    }
+
+    // w = 1/s mod n
+    GOTO_ERR_IF(ECC_ModOrderInv(ctx->para, w, s), ret);
+
+    GOTO_ERR_IF(EcdsaVerifyPoint(ctx, paraN, d, r, w, tpt, opt), ret);
 
+    ret = EcdsaVerifyCheckX(ctx, paraN, r, tpt, opt);
 ERR:
     ECC_FreePoint(tpt);
     OptimizerEnd(opt);
@@ -500,6 +538,170 @@ int32_t CRYPT_ECDSA_Verify(const CRYPT_ECDSA_Ctx *ctx, int32_t algId, const uint
     return CRYPT_ECDSA_VerifyData(ctx, hash, hashLen, sign, signLen);
 }
 
+typedef struct {
+    BN_BigNum *d;   // The truncated digest of the message
+    BN_BigNum *r;
+    BN_BigNum *s;
+    BN_BigNum *w;   // 1/s mod n
+    ECC_Point *pt;  // u1*G + u2*pubkey
+} EcdsaBatchItem;
+
+typedef struct {
+    EcdsaBatchItem *items;
+    uint32_t *idx;  // The batched items
+    BN_BigNum **s;  // s of the batched items
+    BN_BigNum **w;  // 1/s of the batched items
+    ECC_Point **pt; // The points of the batched items
+    uint32_t num;   // Number of the batched items
+} EcdsaBatch;
+
+static void EcdsaBatchFree(EcdsaBatch *batch, uint32_t num)
+{
+    if (batch->items != NULL) {
+        for (uint32_t i = 0; i < num; i++) {
+            BN_Destroy(batch->items[i].d);
+            BN_Destroy(batch->items[i].r);
+            BN_Destroy(batch->items[i].s);
+            BN_Destroy(batch->items[i].w);
+            ECC_FreePoint(batch->items[i].pt);
+        }
+    }
+    BSL_SAL_FREE(batch->items);
+    BSL_SAL_FREE(batch->idx);
+    BSL_SAL_FREE(batch->s);
+    BSL_SAL_FREE(batch->w);
+    BSL_SAL_FREE(batch->pt);
+}
+
+static bool EcdsaBatchNew(EcdsaBatch *batch, uint32_t num)
+{
+    batch->items = BSL_SAL_Calloc(num, sizeof(EcdsaBatchItem));
+    batch->idx = BSL_SAL_Malloc(num * sizeof(uint32_t));
+    batch->s = BSL_SAL_Malloc(num * sizeof(BN_BigNum *));
+    batch->w = BSL_SAL_Malloc(num * sizeof(BN_BigNum *));
+    batch->pt = BSL_SAL_Malloc(num * sizeof(ECC_Point *));
+    return batch->items != NULL && batch->idx != NULL && batch->s != NULL && batch->w != NULL && batch->pt != NULL;
+}
+
+// Hash the message and decode the signature of an item, the same checks as CRYPT_ECDSA_Verify.
+static int32_t EcdsaBatchPrepare(const CRYPT_ECDSA_Ctx *ctx, const BN_BigNum *paraN, int32_t algId,
+    const CRYPT_VerifyItem *item, EcdsaBatchItem *out)
+{
+    if (((item->data == NULL) && (item->dataLen != 0)) || (item->sign == NULL) || (item->signLen == 0)) {
+        BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
+        return CRYPT_NULL_INPUT;
+    }
+    if (ctx->pubkey == NULL) {
+        BSL_ERR_PUSH_ERROR(CRYPT_ECDSA_ERR_EMPTY_KEY);
+        return CRYPT_ECDSA_ERR_EMPTY_KEY;
+    }
+    uint8_t hash[64]; // 64 is max hash len
+    uint32_t hashLen = sizeof(hash) / sizeof(hash[0]);
+    int32_t ret = EAL_Md(algId, item->data, item->dataLen, hash, &hashLen);
+    if (ret != CRYPT_SUCCESS) {
+        BSL_ERR_PUSH_ERROR(ret);
+        return ret;
+    }
+    uint32_t keyBits = ECC_PkeyGetBits(ctx);
+    out->r = BN_Create(keyBits);
+    out->s = BN_Create(keyBits);
+    out->w = BN_Create(keyBits);
+    out->pt = ECC_NewPoint(ctx->para);
+    out->d = GetBnByData(paraN, hash, hashLen);
+    if (out->r == NULL || out->s == NULL || out->w == NULL || out->pt == NULL || out->d == NULL) {
+        BSL_ERR_PUSH_ERROR(CRYPT_MEM_ALLOC_FAIL);
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    GOTO_ERR_IF(CRYPT_EAL_DecodeSign(item->sign, item->signLen, out->r, out->s), ret);
+    ret = VerifyCheckSign(paraN, out->r, out->s);
+ERR:
+    return ret;
+}
+
+// Only the items whose key is on the given named curve join the batch.
+static bool EcdsaBatchJoin(const CRYPT_ECDSA_Ctx *ctx, CRYPT_PKEY_ParaId paraId)
+{
+    return (ctx != NULL) && (ctx->para != NULL) && (paraId != CRYPT_PKEY_PARAID_MAX) &&
+        (ECC_GetParaId(ctx->para) == paraId);
+}
+
+/*
+ * Verify the batched items, the items share one inversion of s mod n and one conversion of the points
+ * u1*G + u2*pubkey to affine, both with Montgomery's trick.
+ */
+static void EcdsaBatchVerify(const CRYPT_ECDSA_Ctx *const *ctxs, const BN_BigNum *paraN, EcdsaBatch *batch,
+    int32_t *results, BN_Optimizer *opt)
+{
+    uint32_t i;
+    uint32_t ptNum = 0;
+    const ECC_Para *para = ctxs[batch->idx[0]]->para;
+    int32_t ret = BN_ModInvBatch(batch->w, batch->s, batch->num, paraN, opt);
+    for (i = 0; i < batch->num; i++) {
+        uint32_t j = batch->idx[i];
+        EcdsaBatchItem *item = &batch->items[j];
+        results[j] = (ret != CRYPT_SUCCESS) ? ret :
+            EcdsaVerifyPoint(ctxs[j], paraN, item->d, item->r, item->w, item->pt, opt);
+        if (results[j] == CRYPT_SUCCESS) {
+            batch->pt[ptNum++] = item->pt;
+        }
+    }
+    ret = (ptNum == 0) ? CRYPT_SUCCESS : ECC_Points2Affine(para, batch->pt, ptNum);
+    for (i = 0; i < batch->num; i++) {
+        uint32_t j = batch->idx[i];
+        if (results[j] == CRYPT_SUCCESS) {
+            results[j] = (ret != CRYPT_SUCCESS) ? ret :
+                EcdsaVerifyCheckX(ctxs[j], paraN, batch->items[j].r, batch->items[j].pt, opt);
+        }
+    }
+}
+
+static int32_t EcdsaBatchFirstResult(const int32_t *results, uint32_t num)
+{
+    for (uint32_t i = 0; i < num; i++) {
+        if (results[i] != CRYPT_SUCCESS) {
+            return results[i];
+        }
+    }
+    return CRYPT_SUCCESS;
+}
+
+int32_t CRYPT_ECDSA_VerifyBatch(const CRYPT_ECDSA_Ctx *const *ctxs, int32_t algId, const CRYPT_VerifyItem *items,
+    uint32_t num, int32_t *results)
+{
+    if (ctxs == NULL || items == NULL || results == NULL || num == 0) {
+        BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
+        return CRYPT_NULL_INPUT;
+    }
+    // The curve of the first key decides which items are batched, the others are verified one by one.
+    CRYPT_PKEY_ParaId paraId = (ctxs[0] != NULL && ctxs[0]->para != NULL) ?
+        ECC_GetParaId(ctxs[0]->para) : CRYPT_PKEY_PARAID_MAX;
+    EcdsaBatch batch = { 0 };
+    bool batchOk = EcdsaBatchNew(&batch, num);
+    BN_BigNum *paraN = EcdsaBatchJoin(ctxs[0], paraId) ? ECC_GetParaN(ctxs[0]->para) : NULL;
+    BN_Optimizer *opt = BN_OptimizerCreate();
+    for (uint32_t i = 0; i < num; i++) {
+        if (!batchOk || paraN == NULL || opt == NULL || !EcdsaBatchJoin(ctxs[i], paraId)) {
+            results[i] = CRYPT_ECDSA_Verify(ctxs[i], algId, items[i].data, items[i].dataLen, items[i].sign,
+                items[i].signLen);
+            continue;
+        }
+        results[i] = EcdsaBatchPrepare(ctxs[i], paraN, algId, &items[i], &batch.items[i]);
+        if (results[i] == CRYPT_SUCCESS) {
+            batch.idx[batch.num] = i;
+            batch.s[batch.num] = batch.items[i].s;
+            batch.w[batch.num] = batch.items[i].w;
+            batch.num++;
+        }
+    }
+    if (batch.num != 0) {
+        EcdsaBatchVerify(ctxs, paraN, &batch, results, opt);
+    }
+    EcdsaBatchFree(&batch, num);
+    BN_Destroy(paraN);
+    BN_OptimizerDestroy(opt);
+    return EcdsaBatchFirstResult(results, num);
+}
+
 static int32_t CRYPT_ECDSA_GetLen(const CRYPT_ECDSA_Ctx *ctx, GetLenFunc func, void *val, uint32_t len)
 {
     if (val == NULL || len != sizeof(int32_t)) {
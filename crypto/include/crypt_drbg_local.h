@@ -38,6 +38,14 @@ struct EAL_RndCtx {
     bool working; // whether the system is in the working state
     bool isDefaultSeed;
     BSL_SAL_ThreadLockHandle lock; // thread lock
+    bool perThread; // whether every thread generates with its own DRBG seeded from this one
+    uint32_t reseedCnt; // reseed requests of the shared DRBG, a thread DRBG keeps the count it is seeded at
+    void *provCtx; // provider context of a provider DRBG, with which its thread DRBGs are created
+    BSL_SAL_ThreadKey threadKey; // the thread DRBG of every thread, freed by the key when the thread exits
+    CRYPT_EAL_RndCtx *threadDrbgs; // the thread DRBGs of the live threads, freed with the shared DRBG
+    CRYPT_EAL_RndCtx *shared; // of a thread DRBG: the shared DRBG it is seeded from and listed in
+    CRYPT_EAL_RndCtx *prev; // of a thread DRBG: neighbours in the list of the shared DRBG
+    CRYPT_EAL_RndCtx *next;
 };
 
 typedef struct {
@@ -114,6 +114,8 @@ typedef int32_t (*PkeyVerify)(const void *key, int32_t mdAlgId, const uint8_t *d
     const uint8_t *sign, uint32_t signLen);
 typedef int32_t (*PkeyVerifyData)(const void *key, const uint8_t *data, uint32_t dataLen,
     const uint8_t *sign, uint32_t signLen);
+typedef int32_t (*PkeyVerifyBatch)(const void *const *keys, int32_t mdAlgId, const CRYPT_VerifyItem *items,
+    uint32_t num, int32_t *results);
 typedef int32_t (*PkeyRecover)(const void *key, const uint8_t *sign, uint32_t signLen,
     uint8_t *data, uint32_t *dataLen);
 typedef int32_t (*PkeyComputeShareKey)(const void *key, const void *pub, uint8_t *share, uint32_t *shareLen);
@@ -172,6 +174,7 @@ typedef struct EAL_PkeyMethod {
     PkeyDecapsulate decaps;                // Key decapsulation.
     PkeyBlind blind;                        // msg blind
     PkeyUnBlind unBlind;                    // sig unBlind.
+    PkeyVerifyBatch verifyBatch;            // Verify the signatures of a batch.
 } EAL_PkeyMethod;
 
 typedef struct EAL_PkeyUnitaryMethod {
@@ -205,6 +208,7 @@ typedef struct EAL_PkeyUnitaryMethod {
     PkeyUnBlind unBlind;                    // sig unBlind.
     PkeyImport import;                      // import key
     PkeyExport export;                      // export key
+    PkeyVerifyBatch verifyBatch;            // Verify the signatures of a batch.
 } EAL_PkeyUnitaryMethod;
 /**
  * @ingroup  sym_algid
@@ -450,6 +450,9 @@ bool IsSupportAVX512F(void);
 bool IsSupportAVX512VL(void);
 bool IsSupportAVX512BW(void);
 bool IsSupportAVX512DQ(void);
+bool IsSupportGFNI(void);
+bool IsSupportVAES(void);
+bool IsSupportVPCLMULQDQ(void);
 bool IsSupportXSAVE(void);
 bool IsSupportOSXSAVE(void);
 bool IsOSSupportAVX(void);
@@ -190,41 +190,54 @@ static int32_t CoeffFromThreeBytes(uint8_t b0, uint8_t b1, uint8_t b2)
     return (((int32_t)b << 16) | ((int32_t)b1 << 8)) | b0;
 }
 
-// NIST.FIPS.204 Algorithm 30 RejNTTPoly(ρ)
-static int32_t RejNTTPoly(int32_t a[MLDSA_N], uint8_t seed[MLDSA_SEED_EXTEND_BYTES_LEN])
-{
-    int32_t ret;
-    unsigned int buflen = CRYPT_SHAKE128_BLOCKSIZE;
-    uint8_t buf[CRYPT_SHAKE128_BLOCKSIZE];
+// Five blocks of SHAKE128 give 280 candidates for the 256 coefficients, which is enough in almost all cases.
+#define MLDSA_REJ_NTT_BLOCKS 5
 
-    const EAL_MdMethod *hashMethod = EAL_MdFindMethod(CRYPT_MD_SHAKE128);
-    if (hashMethod == NULL) {
-        BSL_ERR_PUSH_ERROR(CRYPT_EAL_ALG_NOT_SUPPORT);
-        return CRYPT_EAL_ALG_NOT_SUPPORT;
-    }
-    void *mdCtx = hashMethod->newCtx();
-    if (mdCtx == NULL) {
-        BSL_ERR_PUSH_ERROR(CRYPT_MEM_ALLOC_FAIL);
-        return CRYPT_MEM_ALLOC_FAIL;
-    }
-    GOTO_ERR_IF(hashMethod->init(mdCtx, NULL), ret);
-    GOTO_ERR_IF(hashMethod->update(mdCtx, seed, MLDSA_SEED_EXTEND_BYTES_LEN), ret);
-    GOTO_ERR_IF(hashMethod->squeeze(mdCtx, buf, buflen), ret);
+// Sample the coefficients of a from the three bytes in buf, ctr is the number of the coefficients sampled before.
+static uint32_t RejUniform(int32_t a[MLDSA_N], uint32_t ctr, const uint8_t *buf, uint32_t bufLen)
+{
+    uint32_t i = ctr;
     uint32_t j = 0;
-    for (uint32_t i = 0; i < MLDSA_N;) {
-        a[i] = CoeffFromThreeBytes(buf[j], buf[j + 1], buf[j + 2]); // Data from 3 uint8_t to int32_t.
-        j += 3;
-        if (a[i] < MLDSA_Q) {  // a[i] is less than MLDSA_Q is an invalid value.
-            i++;
+#if defined(HITLS_CRYPTO_MLDSA_X8664) && defined(__x86_64__)
+    if (MlDsaIsAvx2Enabled()) {
+        i = MLDSA_RejUniformAvx2(a, i, buf, bufLen, &j);
+    }
+#endif
+    for (; i < MLDSA_N && j + 3 <= bufLen; j += 3) {
+        int32_t t = CoeffFromThreeBytes(buf[j], buf[j + 1], buf[j + 2]); // Data from 3 uint8_t to int32_t.
+        if (t < MLDSA_Q) {  // t is less than MLDSA_Q is an invalid value.
+            a[i++] = t;
         }
-        if (j >= CRYPT_SHAKE128_BLOCKSIZE) {
-            GOTO_ERR_IF(hashMethod->squeeze(mdCtx, buf, buflen), ret);
-            j = 0;
+    }
+    return i;
+}
+
+// NIST.FIPS.204 Algorithm 30 RejNTTPoly(ρ), four polynomials are sampled by one parallel SHAKE128.
+static int32_t RejNTTPolyX4(int32_t *a[CRYPT_SHAKE_X4_LANES], const uint8_t *const seed[CRYPT_SHAKE_X4_LANES])
+{
+    CRYPT_SHAKE_X4_Ctx shakeCtx;
+    uint8_t buf[CRYPT_SHAKE_X4_LANES][CRYPT_SHAKE128_BLOCKSIZE * MLDSA_REJ_NTT_BLOCKS];
+    uint8_t *out[CRYPT_SHAKE_X4_LANES] = {buf[0], buf[1], buf[2], buf[3]};
+    uint32_t ctr[CRYPT_SHAKE_X4_LANES];
+    int32_t ret = CRYPT_SHAKE128_X4Absorb(&shakeCtx, seed, MLDSA_SEED_EXTEND_BYTES_LEN);
+    RETURN_RET_IF(ret != CRYPT_SUCCESS, ret);
+    ret = CRYPT_SHAKE_X4SqueezeBlocks(&shakeCtx, out, MLDSA_REJ_NTT_BLOCKS);
+    RETURN_RET_IF(ret != CRYPT_SUCCESS, ret);
+    bool isDone = true;
+    for (uint32_t j = 0; j < CRYPT_SHAKE_X4_LANES; j++) {
+        ctr[j] = RejUniform(a[j], 0, buf[j], sizeof(buf[j]));
+        isDone = isDone && (ctr[j] == MLDSA_N);
+    }
+    while (!isDone) {
+        ret = CRYPT_SHAKE_X4SqueezeBlocks(&shakeCtx, out, 1);
+        RETURN_RET_IF(ret != CRYPT_SUCCESS, ret);
+        isDone = true;
+        for (uint32_t j = 0; j < CRYPT_SHAKE_X4_LANES; j++) {
+            ctr[j] = RejUniform(a[j], ctr[j], buf[j], CRYPT_SHAKE128_BLOCKSIZE);
+            isDone = isDone && (ctr[j] == MLDSA_N);
         }
     }
-ERR:
-    hashMethod->freeCtx(mdCtx);
-    return ret;
+    return CRYPT_SUCCESS;
 }
 
 // NIST.FIPS.204 Algorithm 32 ExpandA(ρ)
@@ -232,15 +245,22 @@ static int32_t ExpandA(const CRYPT_ML_DSA_Ctx *ctx, const uint8_t *pubSeed, int3
 {
     uint8_t k = ctx->info->k;
     uint8_t l = ctx->info->l;
-    uint8_t seed[MLDSA_SEED_EXTEND_BYTES_LEN];
-    (void)memcpy_s(seed, sizeof(seed), pubSeed, MLDSA_PUBLIC_SEED_LEN);
-    for (uint8_t i = 0; i < k; i++) {
-        for (uint8_t j = 0; j < l; j++) {
-            seed[MLDSA_PUBLIC_SEED_LEN] = j;
-            seed[MLDSA_PUBLIC_SEED_LEN + 1] = i;
-            int32_t ret = RejNTTPoly(matrix[i][j], seed);
-            RETURN_RET_IF(ret != CRYPT_SUCCESS, ret);
+    uint32_t total = (uint32_t)k * l;
+    uint8_t seed[CRYPT_SHAKE_X4_LANES][MLDSA_SEED_EXTEND_BYTES_LEN];
+    const uint8_t *in[CRYPT_SHAKE_X4_LANES];
+    int32_t *a[CRYPT_SHAKE_X4_LANES];
+    int32_t unused[MLDSA_N]; // The lanes beyond the matrix in the last round are sampled into it and dropped.
+    for (uint32_t idx = 0; idx < total; idx += CRYPT_SHAKE_X4_LANES) {
+        for (uint32_t n = 0; n < CRYPT_SHAKE_X4_LANES; n++) {
+            uint32_t pos = (idx + n < total) ? (idx + n) : idx;
+            (void)memcpy_s(seed[n], sizeof(seed[n]), pubSeed, MLDSA_PUBLIC_SEED_LEN);
+            seed[n][MLDSA_PUBLIC_SEED_LEN] = (uint8_t)(pos % l);
+            seed[n][MLDSA_PUBLIC_SEED_LEN + 1] = (uint8_t)(pos / l);
+            in[n] = seed[n];
+            a[n] = (idx + n < total) ? matrix[pos / l][pos % l] : unused;
         }
+        int32_t ret = RejNTTPolyX4(a, in);
+        RETURN_RET_IF(ret != CRYPT_SUCCESS, ret);
     }
     return CRYPT_SUCCESS;
 }
@@ -336,6 +356,12 @@ static void ComputesNTT(const CRYPT_ML_DSA_Ctx *ctx, int32_t *s[MLDSA_L_MAX], in
 
 static void VectorsMul(int32_t *t, int32_t *matrix, int32_t *s)
 {
+#if defined(HITLS_CRYPTO_MLDSA_X8664) && defined(__x86_64__)
+    if (MlDsaIsAvx2Enabled()) {
+        MLDSA_VectorsMulAvx2(t, matrix, s);
+        return;
+    }
+#endif
     for (uint32_t i = 0; i < MLDSA_N; i++) {
         t[i] = MLDSA_MontgomeryReduce((int64_t)matrix[i] * s[i]);
     }
@@ -670,24 +696,33 @@ static void SkDecode(const CRYPT_ML_DSA_Ctx *ctx, uint8_t *pubSeed, uint8_t *sig
     }
 }
 
-// Algorithm 34 ExpandMask(ρ, μ)
-static int32_t ExpandMask(const CRYPT_ML_DSA_Ctx *ctx, int32_t *y[MLDSA_L_MAX], uint8_t *p, uint16_t u)
+// Algorithm 34 ExpandMask(ρ, μ), the l calls of H run in parallel.
+static int32_t ExpandMask(const CRYPT_ML_DSA_Ctx *ctx, int32_t *y[MLDSA_L_MAX], const uint8_t *p, uint16_t u)
 {
-    uint16_t n = 0;
-    uint8_t v[640];  // The maximum length is 20 * 32 == 640 byte.
+    uint8_t l = ctx->info->l;
+    uint8_t seed[MLDSA_L_MAX][MLDSA_PRIVATE_SEED_LEN + 2];
+    uint8_t v[MLDSA_L_MAX][640];  // The maximum length is 20 * 32 == 640 byte.
+    const uint8_t *in[MLDSA_L_MAX];
+    uint8_t *out[MLDSA_L_MAX];
     uint32_t bits = (ctx->info->k == K_VALUE_OF_MLDSA_44) ? GAMMA_BITS_OF_MLDSA_44 : GAMMA_BITS_OF_MLDSA_65_87;
-    for (uint16_t i = 0; i < ctx->info->l; i++) {
-        n = u + i;
-        p[MLDSA_PRIVATE_SEED_LEN] = (uint8_t)n;
-        p[MLDSA_PRIVATE_SEED_LEN + 1] = (uint8_t)(n >> BITS_OF_BYTE);
-        // 𝑣 ← H(ρ′, 32𝑐)
-        int32_t ret = HashFuncH(p, MLDSA_PRIVATE_SEED_LEN + 2, NULL, 0, v, 32 * bits);
-        if (ret != CRYPT_SUCCESS) {
-            return ret;
+    for (uint16_t i = 0; i < l; i++) {
+        uint16_t n = u + i;
+        (void)memcpy_s(seed[i], sizeof(seed[i]), p, MLDSA_PRIVATE_SEED_LEN);
+        seed[i][MLDSA_PRIVATE_SEED_LEN] = (uint8_t)n;
+        seed[i][MLDSA_PRIVATE_SEED_LEN + 1] = (uint8_t)(n >> BITS_OF_BYTE);
+        in[i] = seed[i];
+        out[i] = v[i];
+    }
+    // 𝑣 ← H(ρ′, 32𝑐)
+    int32_t ret = CRYPT_SHAKE256_Batch(in, MLDSA_PRIVATE_SEED_LEN + 2, out, 32 * bits, l);
+    if (ret == CRYPT_SUCCESS) {
+        for (uint16_t i = 0; i < l; i++) {
+            SignBitUnPake(v[i], (uint32_t *)y[i], bits, ctx->info->gamma1);
         }
-        SignBitUnPake(v, (uint32_t *)y[i], bits, ctx->info->gamma1);
     }
-    return CRYPT_SUCCESS;
+    BSL_SAL_CleanseData(seed, sizeof(seed));
+    BSL_SAL_CleanseData(v, sizeof(v));
+    return ret;
 }
 
 // Algorithm 36 Decompose(r)
@@ -82,6 +82,22 @@ void MLDSA_ComputesNTT(int32_t w[MLDSA_N]);
 void MLDSA_ComputesINVNTT(int32_t w[MLDSA_N]);
 int32_t MLDSA_MontgomeryReduce(int64_t a);
 
+#if defined(HITLS_CRYPTO_MLDSA_X8664) && defined(__x86_64__)
+#include "crypt_utils.h"
+
+// The AVX2 kernels are used when the cpu capability obtained by CRYPT_EAL_Init supports them.
+static inline bool MlDsaIsAvx2Enabled(void)
+{
+    return IsSupportAVX() && IsOSSupportAVX() && IsSupportAVX2();
+}
+
+void MLDSA_ComputesNTTAvx2(int32_t w[MLDSA_N], const int32_t zetas[MLDSA_N]);
+void MLDSA_ComputesINVNTTAvx2(int32_t w[MLDSA_N], const int32_t zetas[MLDSA_N]);
+void MLDSA_VectorsMulAvx2(int32_t *t, const int32_t *a, const int32_t *b);
+uint32_t MLDSA_RejUniformAvx2(int32_t a[MLDSA_N], uint32_t ctr, const uint8_t *buf, uint32_t bufLen,
+    uint32_t *pos);
+#endif
+
 int32_t MLDSA_KeyGenInternal(CRYPT_ML_DSA_Ctx *ctx, uint8_t *d);
 
 int32_t MLDSA_SignInternal(const CRYPT_ML_DSA_Ctx *ctx, CRYPT_Data *msg, uint8_t *out, uint32_t *outLen,
@@ -70,6 +70,12 @@ int32_t MLDSA_MontgomeryReduce(int64_t a)
 // Algorithm 41 NTT(w)
 void MLDSA_ComputesNTT(int32_t w[MLDSA_N])
 {
+#if defined(HITLS_CRYPTO_MLDSA_X8664) && defined(__x86_64__)
+    if (MlDsaIsAvx2Enabled()) {
+        MLDSA_ComputesNTTAvx2(w, ZETAS);
+        return;
+    }
+#endif
     uint32_t m = 0;
     for (uint32_t len = MLDSA_N / 2; len > 0; len >>= 1) {
         for (uint32_t start = 0; start < MLDSA_N;) {
@@ -88,6 +94,12 @@ void MLDSA_ComputesNTT(int32_t w[MLDSA_N])
 // Algorithm 42 NTT^−1(w)
 void MLDSA_ComputesINVNTT(int32_t w[MLDSA_N])
 {
+#if defined(HITLS_CRYPTO_MLDSA_X8664) && defined(__x86_64__)
+    if (MlDsaIsAvx2Enabled()) {
+        MLDSA_ComputesINVNTTAvx2(w, ZETAS);
+        return;
+    }
+#endif
     const int64_t f = 41978;  // 41978 is mont^2/256
     uint32_t m = MLDSA_N;
     for (uint32_t len = 1; len < MLDSA_N; len <<= 1) {
@@ -0,0 +1,217 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include "hitls_build.h"
+#if defined(HITLS_CRYPTO_MLDSA) && defined(HITLS_CRYPTO_MLDSA_X8664) && defined(__x86_64__)
+
+#include <immintrin.h>
+#include "ml_dsa_local.h"
+
+/*
+ * AVX2 kernels of ML-DSA, 8 coefficients are processed by one 256-bit register. Every Montgomery reduction is the
+ * same as MLDSA_MontgomeryReduce, so the results are identical to the scalar code.
+ */
+#define MLDSA_AVX2 __attribute__((target("avx2")))
+
+/*
+ * The last three layers of the NTT work inside a pair of registers. The pair is exchanged so that the first register
+ * holds the x half and the second one the y half of every butterfly, the indexes below spread the 8 zetas loaded for
+ * the pair to the same layout. Applying an exchange twice restores the order of the coefficients.
+ */
+static const int32_t ZETAS_IDX_128[8] = {0, 0, 0, 0, 1, 1, 1, 1};     // length 4, 2 zetas in the pair
+static const int32_t ZETAS_IDX_64[8] = {0, 0, 2, 2, 1, 1, 3, 3};      // length 2, 4 zetas in the pair
+static const int32_t ZETAS_IDX_32[8] = {0, 4, 1, 5, 2, 6, 3, 7};      // length 1, 8 zetas in the pair
+// The inverse NTT uses the zetas in the descending order.
+static const int32_t ZETAS_INV_IDX_128[8] = {7, 7, 7, 7, 6, 6, 6, 6};
+static const int32_t ZETAS_INV_IDX_64[8] = {7, 7, 5, 5, 6, 6, 4, 4};
+static const int32_t ZETAS_INV_IDX_32[8] = {7, 3, 6, 2, 5, 1, 4, 0};
+
+MLDSA_AVX2 static inline __m256i Load(const int32_t *a)
+{
+    return _mm256_loadu_si256((const __m256i *)(uintptr_t)a);
+}
+
+MLDSA_AVX2 static inline void Store(int32_t *a, __m256i v)
+{
+    _mm256_storeu_si256((__m256i *)(uintptr_t)a, v);
+}
+
+// MLDSA_MontgomeryReduce(a * b) of 8 coefficients.
+MLDSA_AVX2 static inline __m256i MontMul(__m256i a, __m256i b)
+{
+    const __m256i q = _mm256_set1_epi32(MLDSA_Q);
+    const __m256i qinv = _mm256_set1_epi32(MLDSA_QINV);
+    __m256i even = _mm256_mul_epi32(a, b);
+    __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    __m256i tEven = _mm256_mul_epi32(_mm256_mul_epu32(even, qinv), q);
+    __m256i tOdd = _mm256_mul_epi32(_mm256_mul_epu32(odd, qinv), q);
+    // The low 32 bits of a * b - t * q are zero, the results are in the high 32 bits.
+    even = _mm256_srli_epi64(_mm256_sub_epi64(even, tEven), 32);
+    odd = _mm256_sub_epi64(odd, tOdd);
+    return _mm256_blend_epi32(even, odd, 0xaa);  // 0xaa: the odd 32-bit words
+}
+
+MLDSA_AVX2 static inline void Exchange128(__m256i *a, __m256i *b)
+{
+    __m256i t = _mm256_permute2x128_si256(*a, *b, 0x20);  // 0x20: the low halves of a and b
+    *b = _mm256_permute2x128_si256(*a, *b, 0x31);         // 0x31: the high halves of a and b
+    *a = t;
+}
+
+MLDSA_AVX2 static inline void Exchange64(__m256i *a, __m256i *b)
+{
+    __m256i t = _mm256_unpacklo_epi64(*a, *b);
+    *b = _mm256_unpackhi_epi64(*a, *b);
+    *a = t;
+}
+
+MLDSA_AVX2 static inline void Exchange32(__m256i *a, __m256i *b)
+{
+    __m256i t = _mm256_blend_epi32(*a, _mm256_slli_epi64(*b, 32), 0xaa);
+    *b = _mm256_blend_epi32(_mm256_srli_epi64(*a, 32), *b, 0xaa);
+    *a = t;
+}
+
+MLDSA_AVX2 static inline __m256i LoadZetas(const int32_t *zetas, const int32_t idx[8])
+{
+    return _mm256_permutevar8x32_epi32(Load(zetas), Load(idx));
+}
+
+MLDSA_AVX2 static inline void ButterflyCT(__m256i *x, __m256i *y, __m256i z)
+{
+    __m256i t = MontMul(z, *y);
+    *y = _mm256_sub_epi32(*x, t);
+    *x = _mm256_add_epi32(*x, t);
+}
+
+MLDSA_AVX2 static inline void ButterflyGS(__m256i *x, __m256i *y, __m256i z)
+{
+    __m256i t = *x;
+    *x = _mm256_add_epi32(t, *y);
+    *y = MontMul(z, _mm256_sub_epi32(t, *y));
+}
+
+// The same transform as MLDSA_ComputesNTT.
+MLDSA_AVX2 void MLDSA_ComputesNTTAvx2(int32_t w[MLDSA_N], const int32_t zetas[MLDSA_N])
+{
+    for (uint32_t m = 1, len = MLDSA_N / 2; len >= 8; m <<= 1, len >>= 1) {  // len >= 8: the length of one register
+        for (uint32_t i = 0; i < m; i++) {
+            __m256i z = _mm256_set1_epi32(zetas[m + i]);
+            for (uint32_t j = 2 * len * i; j < 2 * len * i + len; j += 8) {
+                __m256i x = Load(w + j);
+                __m256i y = Load(w + j + len);
+                ButterflyCT(&x, &y, z);
+                Store(w + j, x);
+                Store(w + j + len, y);
+            }
+        }
+    }
+    for (uint32_t p = 0; p < MLDSA_N / 16; p++) {  // 16 coefficients in a pair of registers
+        __m256i x = Load(w + 16 * p);
+        __m256i y = Load(w + 16 * p + 8);
+        Exchange128(&x, &y);
+        ButterflyCT(&x, &y, LoadZetas(zetas + 32 + 2 * p, ZETAS_IDX_128));
+        Exchange128(&x, &y);
+        Exchange64(&x, &y);
+        ButterflyCT(&x, &y, LoadZetas(zetas + 64 + 4 * p, ZETAS_IDX_64));
+        Exchange64(&x, &y);
+        Exchange32(&x, &y);
+        ButterflyCT(&x, &y, LoadZetas(zetas + 128 + 8 * p, ZETAS_IDX_32));
+        Exchange32(&x, &y);
+        Store(w + 16 * p, x);
+        Store(w + 16 * p + 8, y);
+    }
+}
+
+// The same transform as MLDSA_ComputesINVNTT.
+MLDSA_AVX2 void MLDSA_ComputesINVNTTAvx2(int32_t w[MLDSA_N], const int32_t zetas[MLDSA_N])
+{
+    const __m256i zero = _mm256_setzero_si256();
+    for (uint32_t p = 0; p < MLDSA_N / 16; p++) {
+        __m256i x = Load(w + 16 * p);
+        __m256i y = Load(w + 16 * p + 8);
+        Exchange32(&x, &y);
+        ButterflyGS(&x, &y, _mm256_sub_epi32(zero, LoadZetas(zetas + 248 - 8 * p, ZETAS_INV_IDX_32)));
+        Exchange32(&x, &y);
+        Exchange64(&x, &y);
+        ButterflyGS(&x, &y, _mm256_sub_epi32(zero, LoadZetas(zetas + 120 - 4 * p, ZETAS_INV_IDX_64)));
+        Exchange64(&x, &y);
+        Exchange128(&x, &y);
+        ButterflyGS(&x, &y, _mm256_sub_epi32(zero, LoadZetas(zetas + 56 - 2 * p, ZETAS_INV_IDX_128)));
+        Exchange128(&x, &y);
+        Store(w + 16 * p, x);
+        Store(w + 16 * p + 8, y);
+    }
+    for (uint32_t m = 16, len = 8; len < MLDSA_N; m >>= 1, len <<= 1) {
+        for (uint32_t i = 0; i < m; i++) {
+            __m256i z = _mm256_set1_epi32(-zetas[2 * m - 1 - i]);
+            for (uint32_t j = 2 * len * i; j < 2 * len * i + len; j += 8) {
+                __m256i x = Load(w + j);
+                __m256i y = Load(w + j + len);
+                ButterflyGS(&x, &y, z);
+                Store(w + j, x);
+                Store(w + j + len, y);
+            }
+        }
+    }
+    const __m256i f = _mm256_set1_epi32(41978);  // 41978 is mont^2/256
+    for (uint32_t j = 0; j < MLDSA_N; j += 8) {
+        Store(w + j, MontMul(f, Load(w + j)));
+    }
+}
+
+// t = MLDSA_MontgomeryReduce(a * b) for all coefficients.
+MLDSA_AVX2 void MLDSA_VectorsMulAvx2(int32_t *t, const int32_t *a, const int32_t *b)
+{
+    for (uint32_t i = 0; i < MLDSA_N; i += 8) {
+        Store(t + i, MontMul(Load(a + i), Load(b + i)));
+    }
+}
+
+/*
+ * The rejection sampling of NIST.FIPS.204 Algorithm 30 RejNTTPoly, 24 bytes give 8 candidates at a time. Stop when
+ * less than 32 bytes are left or the next candidates may exceed MLDSA_N, *pos returns the bytes consumed.
+ */
+MLDSA_AVX2 uint32_t MLDSA_RejUniformAvx2(int32_t a[MLDSA_N], uint32_t ctr, const uint8_t *buf, uint32_t bufLen,
+    uint32_t *pos)
+{
+    // Bytes 0 - 11 in the low half and bytes 12 - 23 in the high half, 3 bytes are spread to 1 candidate.
+    const __m256i idx = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+        4, 5, 6, -1, 7, 8, 9, -1, 10, 11, 12, -1, 13, 14, 15, -1);
+    const __m256i q = _mm256_set1_epi32(MLDSA_Q);
+    int32_t val[8];
+    uint32_t i = ctr;
+    uint32_t j = 0;
+    while (j + 32 <= bufLen && i + 8 <= MLDSA_N) {
+        __m256i b = _mm256_loadu_si256((const __m256i *)(uintptr_t)(buf + j));
+        b = _mm256_shuffle_epi8(_mm256_permute4x64_epi64(b, 0x94), idx);  // 0x94: the 64-bit words 0, 1, 1, 2
+        b = _mm256_and_si256(b, _mm256_set1_epi32(0x7fffff));
+        uint32_t good = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(q, b)));
+        if (good == 0xff) {  // Almost all candidates are less than MLDSA_Q.
+            Store(a + i, b);
+            i += 8;
+        } else {
+            Store(val, b);
+            for (; good != 0; good &= good - 1) {
+                a[i++] = val[__builtin_ctz(good)];
+            }
+        }
+        j += 24;  // 24 bytes are processed in each round.
+    }
+    *pos = j;
+    return i;
+}
+
+#endif
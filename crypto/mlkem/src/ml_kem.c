@@ -75,6 +75,7 @@ void CRYPT_ML_KEM_FreeCtx(CRYPT_ML_KEM_Ctx *ctx)
     BSL_SAL_CleanseData(ctx->dk, ctx->dkLen);
     BSL_SAL_FREE(ctx->dk);
     BSL_SAL_FREE(ctx->ek);
+    MLKEM_FreeMatrix(ctx);
     BSL_SAL_ReferencesFree(&(ctx->references));
     BSL_SAL_FREE(ctx);
 }
@@ -137,6 +138,15 @@ CRYPT_ML_KEM_Ctx *CRYPT_ML_KEM_DupCtx(CRYPT_ML_KEM_Ctx *ctx)
         }
         newCtx->dkLen = ctx->dkLen;
     }
+    newCtx->isCacheMatrix = ctx->isCacheMatrix;
+    if (ctx->matrix != NULL) {
+        newCtx->matrix = BSL_SAL_Dump(ctx->matrix, ctx->info->k * ctx->info->k * MLKEM_N * sizeof(int16_t));
+        if (newCtx->matrix == NULL) {
+            CRYPT_ML_KEM_FreeCtx(newCtx);
+            return NULL;
+        }
+        (void)memcpy_s(newCtx->matrixSeed, MLKEM_SEED_LEN, ctx->matrixSeed, MLKEM_SEED_LEN);
+    }
     return newCtx;
 }
 
@@ -196,6 +206,38 @@ static int32_t MlKemGetSharedLen(CRYPT_ML_KEM_Ctx *ctx, void *val, uint32_t len)
     return CRYPT_SUCCESS;
 }
 
+static int32_t MlKemUpdateMatrix(CRYPT_ML_KEM_Ctx *ctx, const uint8_t *ek)
+{
+    if (!ctx->isCacheMatrix) {
+        return CRYPT_SUCCESS;
+    }
+    return MLKEM_CacheMatrix(ctx, ek);
+}
+
+static int32_t MlKemSetCacheMatrixFlag(CRYPT_ML_KEM_Ctx *ctx, void *val, uint32_t len)
+{
+    if (len != sizeof(int32_t)) {
+        BSL_ERR_PUSH_ERROR(CRYPT_INVALID_ARG);
+        return CRYPT_INVALID_ARG;
+    }
+    ctx->isCacheMatrix = (*(int32_t *)val != 0);
+    if (!ctx->isCacheMatrix) {
+        MLKEM_FreeMatrix(ctx);
+        return CRYPT_SUCCESS;
+    }
+    if (ctx->info == NULL) {
+        return CRYPT_SUCCESS;
+    }
+    // If the key is already set, the matrix is expanded now, otherwise it is expanded when the key is set.
+    if (ctx->ek != NULL) {
+        return MLKEM_CacheMatrix(ctx, ctx->ek);
+    }
+    if (ctx->dk != NULL) {
+        return MLKEM_CacheMatrix(ctx, ctx->dk + MLKEM_CIPHER_LEN * ctx->info->k);
+    }
+    return CRYPT_SUCCESS;
+}
+
 int32_t CRYPT_ML_KEM_SetEncapsKey(CRYPT_ML_KEM_Ctx *ctx, const BSL_Param *param)
 {
     if (ctx == NULL || ctx->info == NULL || param == NULL) {
@@ -222,7 +264,7 @@ int32_t CRYPT_ML_KEM_SetEncapsKey(CRYPT_ML_KEM_Ctx *ctx, const BSL_Param *param)
     }
     ctx->ek = data;
     ctx->ekLen = ek->valueLen;
-    return CRYPT_SUCCESS;
+    return MlKemUpdateMatrix(ctx, ctx->ek);
 }
 
 int32_t CRYPT_ML_KEM_GetEncapsKey(const CRYPT_ML_KEM_Ctx *ctx, BSL_Param *param)
@@ -280,7 +322,8 @@ int32_t CRYPT_ML_KEM_SetDecapsKey(CRYPT_ML_KEM_Ctx *ctx, const BSL_Param *param)
     }
     ctx->dk = data;
     ctx->dkLen = dk->valueLen;
-    return CRYPT_SUCCESS;
+    // The decaps key embeds the encaps key, which is used by the re-encryption of Decaps.
+    return MlKemUpdateMatrix(ctx, ctx->dk + MLKEM_CIPHER_LEN * ctx->info->k);
 }
 
 int32_t CRYPT_ML_KEM_GetDecapsKey(const CRYPT_ML_KEM_Ctx *ctx, BSL_Param *param)
@@ -393,6 +436,8 @@ int32_t CRYPT_ML_KEM_Ctrl(CRYPT_ML_KEM_Ctx *ctx, int32_t opt, void *val, uint32_
             return MlKemGetCipherTextLen(ctx, val, len);
         case CRYPT_CTRL_GET_SHARED_KEY_LEN:
             return MlKemGetSharedLen(ctx, val, len);
+        case CRYPT_CTRL_SET_MLKEM_CACHE_MATRIX_FLAG:
+            return MlKemSetCacheMatrixFlag(ctx, val, len);
         default:
             BSL_ERR_PUSH_ERROR(CRYPT_MLKEM_CTRL_NOT_SUPPORT);
             return CRYPT_MLKEM_CTRL_NOT_SUPPORT;
@@ -445,7 +490,8 @@ int32_t CRYPT_ML_KEM_GenKey(CRYPT_ML_KEM_Ctx *ctx)
     ret = MLKEM_KeyGenInternal(ctx, d, z);
     BSL_SAL_CleanseData(d, MLKEM_SEED_LEN);
     BSL_SAL_CleanseData(z, MLKEM_SEED_LEN);
-    return ret;
+    RETURN_RET_IF(ret != CRYPT_SUCCESS, ret);
+    return MlKemUpdateMatrix(ctx, ctx->ek);
 }
 
 static int32_t EncCapsInputCheck(const CRYPT_ML_KEM_Ctx *ctx, uint8_t *ct, uint32_t *ctLen,
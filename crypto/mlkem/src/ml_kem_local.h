@@ -68,6 +68,9 @@ struct CryptMlKemCtx {
     uint32_t dkLen;
     BSL_SAL_RefCount references;
     void *libCtx;
+    bool isCacheMatrix;                    // whether to keep the expanded matrix in the context
+    int16_t *matrix;                       // the cached matrix used by encryption, k * k polynomials in NTT domain
+    uint8_t matrixSeed[MLKEM_SEED_LEN];    // the seed of the public key which the cached matrix is expanded from
 };
 
 void MLKEM_ComputNTT(int16_t *a, const int16_t *psi, uint32_t pruLength);
@@ -76,6 +79,29 @@ void MLKEM_SamplePolyCBD(int16_t *polyF, uint8_t *buf, uint8_t eta);
 void MLKEM_MatrixMulAdd(uint8_t k, int16_t *matrix[], int16_t *vectorS[], int16_t *vectorE,
     int16_t *vectorT, const int16_t *factor);
 
+#if defined(HITLS_CRYPTO_MLKEM_X8664) && defined(__x86_64__)
+#include "crypt_utils.h"
+
+// The AVX2 kernels are used when the cpu capability obtained by CRYPT_EAL_Init supports them.
+static inline bool MlKemIsAvx2Enabled(void)
+{
+    return IsSupportAVX() && IsOSSupportAVX() && IsSupportAVX2();
+}
+
+void MLKEM_ComputNTTAvx2(int16_t *a);
+void MLKEM_ComputINTTAvx2(int16_t *a);
+void MLKEM_MatrixMulAddAvx2(uint8_t k, int16_t *matrix[], int16_t *vectorS[], int16_t *vectorE,
+    int16_t *vectorT);
+void MLKEM_CompressAvx2(int16_t *poly, uint8_t d);
+void MLKEM_DeCompressAvx2(int16_t *poly, uint8_t d);
+uint32_t MLKEM_ParseAvx2(uint16_t *polyNtt, const uint8_t *arrayB, uint32_t arrayLen, uint32_t n,
+    uint32_t *pos);
+#endif
+
+int32_t MLKEM_CacheMatrix(CRYPT_ML_KEM_Ctx *ctx, const uint8_t *ek);
+
+void MLKEM_FreeMatrix(CRYPT_ML_KEM_Ctx *ctx);
+
 int32_t MLKEM_KeyGenInternal(CRYPT_ML_KEM_Ctx *ctx, uint8_t *d, uint8_t *z);
 
 int32_t MLKEM_EncapsInternal(const CRYPT_ML_KEM_Ctx *ctx, uint8_t *ct, uint32_t *ctLen, uint8_t *sk, uint32_t *skLen,
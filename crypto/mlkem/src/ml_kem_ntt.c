@@ -19,6 +19,12 @@
 
 void MLKEM_ComputNTT(int16_t *a, const int16_t *psi, uint32_t pruLength)
 {
+#if defined(HITLS_CRYPTO_MLKEM_X8664) && defined(__x86_64__)
+    if (MlKemIsAvx2Enabled()) {
+        MLKEM_ComputNTTAvx2(a);
+        return;
+    }
+#endif
     uint32_t t = MLKEM_N;
     for (uint32_t m = 1; m < pruLength; m <<= 1) {
         t >>= 1;
@@ -42,6 +48,12 @@ void MLKEM_ComputNTT(int16_t *a, const int16_t *psi, uint32_t pruLength)
 
 void MLKEM_ComputINTT(int16_t *a, const int16_t *psiInv, uint32_t pruLength)
 {
+#if defined(HITLS_CRYPTO_MLKEM_X8664) && defined(__x86_64__)
+    if (MlKemIsAvx2Enabled()) {
+        MLKEM_ComputINTTAvx2(a);
+        return;
+    }
+#endif
     uint32_t t = MLKEM_N / pruLength;
     for (uint32_t m = pruLength; m > 1; m >>= 1) {
         uint32_t j1 = 0;
@@ -68,4 +80,4 @@ void MLKEM_ComputINTT(int16_t *a, const int16_t *psiInv, uint32_t pruLength)
     }
 }
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -172,6 +172,32 @@ static int16_t DeCompress(int16_t x, uint8_t bits)
     return (int16_t)((product >> bits) + ((product & (power - 1)) >> (bits - 1)));
 }
 
+static void CompressPoly(int16_t *poly, uint8_t d)
+{
+#if defined(HITLS_CRYPTO_MLKEM_X8664) && defined(__x86_64__)
+    if (MlKemIsAvx2Enabled()) {
+        MLKEM_CompressAvx2(poly, d);
+        return;
+    }
+#endif
+    for (uint32_t n = 0; n < MLKEM_N; n++) {
+        poly[n] = Compress(poly[n], d);
+    }
+}
+
+static void DeCompressPoly(int16_t *poly, uint8_t d)
+{
+#if defined(HITLS_CRYPTO_MLKEM_X8664) && defined(__x86_64__)
+    if (MlKemIsAvx2Enabled()) {
+        MLKEM_DeCompressAvx2(poly, d);
+        return;
+    }
+#endif
+    for (uint32_t n = 0; n < MLKEM_N; n++) {
+        poly[n] = DeCompress(poly[n], d);
+    }
+}
+
 // hash functions
 static int32_t HashFuncH(const uint8_t *in, uint32_t inLen, uint8_t *out, uint32_t outLen)
 {
@@ -185,12 +211,6 @@ static int32_t HashFuncG(const uint8_t *in, uint32_t inLen, uint8_t *out, uint32
     return EAL_Md(CRYPT_MD_SHA3_512, in, inLen, out, &len);
 }
 
-static int32_t HashFuncXOF(const uint8_t *in, uint32_t inLen, uint8_t *out, uint32_t outLen)
-{
-    uint32_t len = outLen;
-    return EAL_Md(CRYPT_MD_SHAKE128, in, inLen, out, &len);
-}
-
 static int32_t HashFuncJ(const uint8_t *in, uint32_t inLen, uint8_t *out, uint32_t outLen)
 {
     uint32_t len = outLen;
@@ -207,6 +227,11 @@ static int32_t Parse(uint16_t *polyNtt, uint8_t *arrayB, uint32_t arrayLen, uint
 {
     uint32_t i = 0;
     uint32_t j = 0;
+#if defined(HITLS_CRYPTO_MLKEM_X8664) && defined(__x86_64__)
+    if (MlKemIsAvx2Enabled()) {
+        j = MLKEM_ParseAvx2(polyNtt, arrayB, arrayLen, n, &i);
+    }
+#endif
     while (j < n) {
         if (i + 3 > arrayLen) {  // 3 bytes of arrayB are read in each round.
             BSL_ERR_PUSH_ERROR(CRYPT_MLKEM_KEYLEN_ERROR);
@@ -464,61 +489,120 @@ static int32_t GenMatrix(const CRYPT_ML_KEM_Ctx *ctx, const uint8_t *digest,
     int16_t *polyMatrix[MLKEM_K_MAX][MLKEM_K_MAX], bool isEnc)
 {
     uint8_t k = ctx->info->k;
-    uint8_t p[MLKEM_SEED_LEN + 2];  // Reserved lengths of i and j is 2 byte.
-    uint8_t xofOut[MLKEM_XOF_OUTPUT_LENGTH];
+    uint8_t p[CRYPT_SHAKE_X4_LANES][MLKEM_SEED_LEN + 2];  // Reserved lengths of i and j is 2 byte.
+    uint8_t xofOut[CRYPT_SHAKE_X4_LANES][MLKEM_XOF_OUTPUT_LENGTH];
+    const uint8_t *in[CRYPT_SHAKE_X4_LANES] = {p[0], p[1], p[2], p[3]};
+    uint8_t *out[CRYPT_SHAKE_X4_LANES] = {xofOut[0], xofOut[1], xofOut[2], xofOut[3]};
+
+    // The k * k entries are independent, so that four of them are expanded by one parallel SHAKE128.
+    for (uint32_t idx = 0; idx < (uint32_t)k * k; idx += CRYPT_SHAKE_X4_LANES) {
+        uint32_t num = ((uint32_t)k * k - idx < CRYPT_SHAKE_X4_LANES) ? ((uint32_t)k * k - idx) : CRYPT_SHAKE_X4_LANES;
+        for (uint32_t n = 0; n < num; n++) {
+            uint8_t i = (uint8_t)((idx + n) / k);
+            uint8_t j = (uint8_t)((idx + n) % k);
+            (void)memcpy_s(p[n], MLKEM_SEED_LEN, digest, MLKEM_SEED_LEN);
+            p[n][MLKEM_SEED_LEN] = isEnc ? i : j;
+            p[n][MLKEM_SEED_LEN + 1] = isEnc ? j : i;
+        }
+        int32_t ret = CRYPT_SHAKE128_Batch(in, MLKEM_SEED_LEN + 2, out, MLKEM_XOF_OUTPUT_LENGTH, num);
+        RETURN_RET_IF(ret != CRYPT_SUCCESS, ret);
+        for (uint32_t n = 0; n < num; n++) {
+            ret = Parse((uint16_t *)polyMatrix[(idx + n) / k][(idx + n) % k], xofOut[n], MLKEM_XOF_OUTPUT_LENGTH,
+                MLKEM_N);
+            RETURN_RET_IF(ret != CRYPT_SUCCESS, ret);
+        }
+    }
+    return CRYPT_SUCCESS;
+}
+
+void MLKEM_FreeMatrix(CRYPT_ML_KEM_Ctx *ctx)
+{
+    BSL_SAL_FREE(ctx->matrix);
+}
 
-    (void)memcpy_s(p, MLKEM_SEED_LEN, digest, MLKEM_SEED_LEN);
+// Expand the matrix used by encryption from the seed of ek, and keep it in the context.
+int32_t MLKEM_CacheMatrix(CRYPT_ML_KEM_Ctx *ctx, const uint8_t *ek)
+{
+    uint8_t k = ctx->info->k;
+    const uint8_t *seed = ek + MLKEM_CIPHER_LEN * k;
+    if (ctx->matrix == NULL) {
+        ctx->matrix = BSL_SAL_Malloc(k * k * MLKEM_N * sizeof(int16_t));
+        if (ctx->matrix == NULL) {
+            BSL_ERR_PUSH_ERROR(CRYPT_MEM_ALLOC_FAIL);
+            return CRYPT_MEM_ALLOC_FAIL;
+        }
+    }
+    int16_t *matrix[MLKEM_K_MAX][MLKEM_K_MAX];
     for (uint8_t i = 0; i < k; i++) {
         for (uint8_t j = 0; j < k; j++) {
-            if (isEnc) {
-                p[MLKEM_SEED_LEN] = i;
-                p[MLKEM_SEED_LEN + 1] = j;
-            } else {
-                p[MLKEM_SEED_LEN] = j;
-                p[MLKEM_SEED_LEN + 1] = i;
-            }
-            int32_t ret = HashFuncXOF(p, MLKEM_SEED_LEN + 2, xofOut, MLKEM_XOF_OUTPUT_LENGTH);
-            RETURN_RET_IF(ret != CRYPT_SUCCESS, ret);
-            ret = Parse((uint16_t *)polyMatrix[i][j], xofOut, MLKEM_XOF_OUTPUT_LENGTH, MLKEM_N);
-            RETURN_RET_IF(ret != CRYPT_SUCCESS, ret);
+            matrix[i][j] = ctx->matrix + (i * k + j) * MLKEM_N;
         }
     }
+    int32_t ret = GenMatrix(ctx, seed, matrix, true);
+    if (ret != CRYPT_SUCCESS) {
+        MLKEM_FreeMatrix(ctx);
+        return ret;
+    }
+    (void)memcpy_s(ctx->matrixSeed, MLKEM_SEED_LEN, seed, MLKEM_SEED_LEN);
     return CRYPT_SUCCESS;
 }
 
-static int32_t SampleEta1(const CRYPT_ML_KEM_Ctx *ctx, uint8_t *digest, int16_t *polyS[], uint8_t *nonce)
+// Use the cached matrix if it is expanded from the same seed, otherwise expand the matrix into the buffer of st.
+static int32_t GetEncMatrix(const CRYPT_ML_KEM_Ctx *ctx, const uint8_t *seed, MLKEM_MatrixSt *st)
 {
-    uint8_t q[MLKEM_SEED_LEN + 1] = { 0 };  // Reserved lengths of nonce is 1 byte.
-    uint8_t prfOut[MLKEM_PRF_BLOCKSIZE * MLKEM_ETA1_MAX] = { 0 };
-    (void)memcpy_s(q, MLKEM_SEED_LEN, digest, MLKEM_SEED_LEN);
-
-    for (uint8_t i = 0; i < ctx->info->k; i++) {
-        q[MLKEM_SEED_LEN] = *nonce;
-        int32_t ret = PRF(q, MLKEM_SEED_LEN + 1, prfOut, MLKEM_PRF_BLOCKSIZE * MLKEM_ETA1_MAX);
-        RETURN_RET_IF(ret != CRYPT_SUCCESS, ret);
-        MLKEM_SamplePolyCBD(polyS[i], prfOut, ctx->info->eta1);
-        *nonce = *nonce + 1;
-        MLKEM_ComputNTT(polyS[i], PRE_COMPUT_TABLE_NTT, MLKEM_N_HALF);
+    uint8_t k = ctx->info->k;
+    if (ctx->matrix == NULL || memcmp(ctx->matrixSeed, seed, MLKEM_SEED_LEN) != 0) {
+        return GenMatrix(ctx, seed, st->matrix, true);
+    }
+    for (uint8_t i = 0; i < k; i++) {
+        for (uint8_t j = 0; j < k; j++) {
+            st->matrix[i][j] = ctx->matrix + (i * k + j) * MLKEM_N;
+        }
     }
     return CRYPT_SUCCESS;
 }
 
-static int32_t SampleEta2(const CRYPT_ML_KEM_Ctx *ctx, uint8_t *digest, int16_t *polyS[], uint8_t *nonce)
+// Sample k polynomials from the seeds digest || nonce, the k PRF calls run in parallel.
+static int32_t SamplePolyCBDVector(const CRYPT_ML_KEM_Ctx *ctx, uint8_t *digest, int16_t *polyS[], uint8_t *nonce,
+    uint8_t eta)
 {
-    uint8_t q[MLKEM_SEED_LEN + 1] = { 0 };  // Reserved lengths of nonce is 1 byte.
-    uint8_t prfOut[MLKEM_PRF_BLOCKSIZE * MLKEM_ETA2_MAX] = { 0 };
-    (void)memcpy_s(q, MLKEM_SEED_LEN, digest, MLKEM_SEED_LEN);
+    uint8_t k = ctx->info->k;
+    uint8_t q[MLKEM_K_MAX][MLKEM_SEED_LEN + 1];  // Reserved lengths of nonce is 1 byte.
+    uint8_t prfOut[MLKEM_K_MAX][MLKEM_PRF_BLOCKSIZE * MLKEM_ETA1_MAX];
+    const uint8_t *in[MLKEM_K_MAX] = { NULL };
+    uint8_t *out[MLKEM_K_MAX] = { NULL };
+    for (uint8_t i = 0; i < k; i++) {
+        (void)memcpy_s(q[i], MLKEM_SEED_LEN, digest, MLKEM_SEED_LEN);
+        q[i][MLKEM_SEED_LEN] = *nonce;
+        *nonce = *nonce + 1;
+        in[i] = q[i];
+        out[i] = prfOut[i];
+    }
+    int32_t ret = CRYPT_SHAKE256_Batch(in, MLKEM_SEED_LEN + 1, out, MLKEM_PRF_BLOCKSIZE * eta, k);
+    if (ret == CRYPT_SUCCESS) {
+        for (uint8_t i = 0; i < k; i++) {
+            MLKEM_SamplePolyCBD(polyS[i], prfOut[i], eta);
+        }
+    }
+    BSL_SAL_CleanseData(prfOut, sizeof(prfOut));
+    return ret;
+}
 
+static int32_t SampleEta1(const CRYPT_ML_KEM_Ctx *ctx, uint8_t *digest, int16_t *polyS[], uint8_t *nonce)
+{
+    int32_t ret = SamplePolyCBDVector(ctx, digest, polyS, nonce, ctx->info->eta1);
+    RETURN_RET_IF(ret != CRYPT_SUCCESS, ret);
     for (uint8_t i = 0; i < ctx->info->k; i++) {
-        q[MLKEM_SEED_LEN] = *nonce;
-        int32_t ret = PRF(q, MLKEM_SEED_LEN + 1, prfOut, MLKEM_PRF_BLOCKSIZE * MLKEM_ETA2_MAX);
-        RETURN_RET_IF(ret != CRYPT_SUCCESS, ret);
-        MLKEM_SamplePolyCBD(polyS[i], prfOut, ctx->info->eta2);
-        *nonce = *nonce + 1;
+        MLKEM_ComputNTT(polyS[i], PRE_COMPUT_TABLE_NTT, MLKEM_N_HALF);
     }
     return CRYPT_SUCCESS;
 }
 
+static int32_t SampleEta2(const CRYPT_ML_KEM_Ctx *ctx, uint8_t *digest, int16_t *polyS[], uint8_t *nonce)
+{
+    return SamplePolyCBDVector(ctx, digest, polyS, nonce, ctx->info->eta2);
+}
+
 // NIST.FIPS.203 Algorithm 13 K-PKE.KeyGen(𝑑)
 static int32_t PkeKeyGen(const CRYPT_ML_KEM_Ctx *ctx, uint8_t *pk, uint8_t *dk, uint8_t *d)
 {
@@ -579,7 +663,7 @@ static int32_t PkeEncrypt(const CRYPT_ML_KEM_Ctx *ctx, uint8_t *ct, const uint8_
     int32_t ret = CreateMatrixBuf(k, &st);
     RETURN_RET_IF(ret != CRYPT_SUCCESS, ret);
 
-    GOTO_ERR_IF(GenMatrix(ctx, ek + MLKEM_CIPHER_LEN * k, st.matrix, true), ret);  // Step 3 - 8
+    GOTO_ERR_IF(GetEncMatrix(ctx, ek + MLKEM_CIPHER_LEN * k, &st), ret);  // Step 3 - 8
     GOTO_ERR_IF(SampleEta1(ctx, r, st.vectorS, &nonce), ret);  // Step 9 - 12
     GOTO_ERR_IF(SampleEta2(ctx, r, st.vectorE, &nonce), ret);  // Step 13 - 16
 
@@ -598,8 +682,9 @@ static int32_t PkeEncrypt(const CRYPT_ML_KEM_Ctx *ctx, uint8_t *ct, const uint8_
     for (i = 0; i < k; i++) {
         MLKEM_ComputINTT(st.vectorT[i], PRE_COMPUT_TABLE_INTT, MLKEM_N_HALF);
         for (n = 0; n < MLKEM_N; n++) {
-            st.vectorT[i][n] = Compress(st.vectorT[i][n] + st.vectorE[i][n], ctx->info->du);
+            st.vectorT[i][n] = st.vectorT[i][n] + st.vectorE[i][n];
         }
+        CompressPoly(st.vectorT[i], ctx->info->du);
     }
 
     // Step 21
@@ -611,11 +696,11 @@ static int32_t PkeEncrypt(const CRYPT_ML_KEM_Ctx *ctx, uint8_t *ct, const uint8_
     ByteDecode(polyVectorM, m, 1);
     MLKEM_ComputINTT(polyVectorC2, PRE_COMPUT_TABLE_INTT, MLKEM_N_HALF);
 
+    DeCompressPoly(polyVectorM, 1); // Step 20
     for (n = 0; n < MLKEM_N; n++) {
-        polyVectorM[n] = DeCompress(polyVectorM[n], 1); // Step 20
-        // Step 22
-        polyVectorC2[n] = Compress(polyVectorC2[n] + polyVectorE2[n] + polyVectorM[n], ctx->info->dv);
+        polyVectorC2[n] = polyVectorC2[n] + polyVectorE2[n] + polyVectorM[n];
     }
+    CompressPoly(polyVectorC2, ctx->info->dv); // Step 22
 
     // Step 22
     for (i = 0; i < k; i++) {
@@ -646,13 +731,9 @@ static int32_t PkeDecrypt(const CRYPT_MlKemInfo *algInfo, uint8_t *result, const
     }
     ByteDecode(st.vectorC2, ciphertext + MLKEM_ENCODE_BLOCKSIZE * algInfo->du * k, algInfo->dv);   // Step 4
 
+    DeCompressPoly(st.vectorC2, algInfo->dv);  // Step 4
     for (i = 0; i < k; i++) {
-        for (n = 0; n < MLKEM_N; n++) {
-            st.vectorC1[i][n] = DeCompress(st.vectorC1[i][n], algInfo->du);  // Step 3
-            if (i == 0) {
-                st.vectorC2[n] = DeCompress(st.vectorC2[n], algInfo->dv);  // Step 4
-            }
-        }
+        DeCompressPoly(st.vectorC1[i], algInfo->du);  // Step 3
         MLKEM_ComputNTT(st.vectorC1[i], PRE_COMPUT_TABLE_NTT, MLKEM_N_HALF);
     }
 
@@ -663,8 +744,9 @@ static int32_t PkeDecrypt(const CRYPT_MlKemInfo *algInfo, uint8_t *result, const
 
     // c2 - polyM
     for (n = 0; n < MLKEM_N; n++) {
-        st.polyM[n] = Compress(st.vectorC2[n] - st.polyM[n], 1);
+        st.polyM[n] = st.vectorC2[n] - st.polyM[n];
     }
+    CompressPoly(st.polyM, 1);
 
     ByteEncode(result, st.polyM, 1);  // Step 7
     DecVectorBufFree(k, &st);
@@ -39,6 +39,12 @@ static void CircMul(int16_t dest[MLKEM_N], int16_t src1[MLKEM_N], int16_t src2[M
 void MLKEM_MatrixMulAdd(uint8_t k, int16_t *matrix[], int16_t *vectorS[], int16_t *vectorE,
     int16_t *vectorT, const int16_t *factor)
 {
+#if defined(HITLS_CRYPTO_MLKEM_X8664) && defined(__x86_64__)
+    if (MlKemIsAvx2Enabled()) {
+        MLKEM_MatrixMulAddAvx2(k, matrix, vectorS, vectorE, vectorT);
+        return;
+    }
+#endif
     int16_t dest[MLKEM_N] = { 0 };
     for (uint8_t j = 0; j < k; j++) {
         // factor is a half of the NTT table.
@@ -0,0 +1,371 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include "hitls_build.h"
+#if defined(HITLS_CRYPTO_MLKEM) && defined(HITLS_CRYPTO_MLKEM_X8664) && defined(__x86_64__)
+
+#include <immintrin.h>
+#include "ml_kem_local.h"
+
+/*
+ * AVX2 kernels of ML-KEM, 16 coefficients are processed by one 256-bit register. The coefficients are kept in
+ * the Montgomery domain inside the kernels, and all outputs are reduced to [0, MLKEM_Q) as the scalar code does.
+ */
+#define MLKEM_AVX2 __attribute__((target("avx2")))
+
+#define MLKEM_QINV       (-3327)  // MLKEM_Q^(-1) mod 2^16
+#define MLKEM_MONT       (-1044)  // 2^16 mod MLKEM_Q
+#define MLKEM_MONT2      1353     // 2^32 mod MLKEM_Q
+#define MLKEM_INVN_MONT  512      // MLKEM_INVN * 2^16 mod MLKEM_Q
+#define MLKEM_BARRETT_V  20159    // round(2^26 / MLKEM_Q)
+#define MLKEM_COMPRESS_M 20642679 // ceil(2^37 / (2 * MLKEM_Q))
+#define MLKEM_COMPRESS_SHIFT 37
+
+// PRE_COMPUT_TABLE_NTT * 2^16 mod MLKEM_Q
+static const int16_t ZETAS_MONT[MLKEM_N_HALF] = {
+    -1044, -758, -359, -1517, 1493, 1422, 287, 202, -171, 622, 1577, 182, 962, -1202, -1474, 1468, 573, -1325, 264,
+    383, -829, 1458, -1602, -130, -681, 1017, 732, 608, -1542, 411, -205, -1571, 1223, 652, -552, 1015, -1293, 1491,
+    -282, -1544, 516, -8, -320, -666, -1618, -1162, 126, 1469, -853, -90, -271, 830, 107, -1421, -247, -951, -398,
+    961, -1508, -725, 448, -1065, 677, -1275, -1103, 430, 555, 843, -1251, 871, 1550, 105, 422, 587, 177, -235,
+    -291, -460, 1574, 1653, -246, 778, 1159, -147, -777, 1483, -602, 1119, -1590, 644, -872, 349, 418, 329, -156,
+    -75, 817, 1097, 603, 610, 1322, -1285, -1465, 384, -1215, -136, 1218, -1335, -874, 220, -1187, -1659, -1185,
+    -1530, -1278, 794, -1510, -854, -870, 478, -108, -308, 996, 991, 958, -1460, 1522, 1628
+};
+
+// PRE_COMPUT_TABLE_INTT * 2^16 mod MLKEM_Q
+static const int16_t ZETAS_INV_MONT[MLKEM_N_HALF] = {
+    -1044, 758, 1517, 359, -202, -287, -1422, -1493, -1468, 1474, 1202, -962, -182, -1577, -622, 171, 1571, 205,
+    -411, 1542, -608, -732, -1017, 681, 130, 1602, -1458, 829, -383, -264, 1325, -573, 1275, -677, 1065, -448, 725,
+    1508, -961, 398, 951, 247, 1421, -107, -830, 271, 90, 853, -1469, -126, 1162, 1618, 666, 320, 8, -516, 1544,
+    282, -1491, 1293, -1015, 552, -652, -1223, -1628, -1522, 1460, -958, -991, -996, 308, 108, -478, 870, 854, 1510,
+    -794, 1278, 1530, 1185, 1659, 1187, -220, 874, 1335, -1218, 136, 1215, -384, 1465, 1285, -1322, -610, -603,
+    -1097, -817, 75, 156, -329, -418, -349, 872, -644, 1590, -1119, 602, -1483, 777, 147, -1159, -778, 246, -1653,
+    -1574, 460, 291, 235, -177, -587, -422, -105, -1550, -871, 1251, -843, -555, -430, 1103
+};
+
+/*
+ * The last three layers of the NTT work inside a pair of registers. The pair is exchanged so that the first register
+ * holds the x half and the second one the y half of every butterfly, the masks below spread the zetas of the
+ * butterflies in the pair to the same layout. Applying an exchange twice restores the order of the coefficients.
+ */
+static const int8_t ZETAS_MASK_128[32] = {  // distance 8, 2 zetas in the pair
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3
+};
+static const int8_t ZETAS_MASK_64[32] = {   // distance 4, 4 zetas in the pair
+    0, 1, 0, 1, 0, 1, 0, 1, 4, 5, 4, 5, 4, 5, 4, 5, 2, 3, 2, 3, 2, 3, 2, 3, 6, 7, 6, 7, 6, 7, 6, 7
+};
+static const int8_t ZETAS_MASK_32[32] = {   // distance 2, 8 zetas in the pair
+    0, 1, 0, 1, 8, 9, 8, 9, 2, 3, 2, 3, 10, 11, 10, 11, 4, 5, 4, 5, 12, 13, 12, 13, 6, 7, 6, 7, 14, 15, 14, 15
+};
+
+// a * b * 2^(-16) mod MLKEM_Q with bQinv = b * MLKEM_QINV mod 2^16, the result is in (-MLKEM_Q, MLKEM_Q).
+MLKEM_AVX2 static inline __m256i MontMulPre(__m256i a, __m256i b, __m256i bQinv)
+{
+    __m256i hi = _mm256_mulhi_epi16(a, b);
+    __m256i m = _mm256_mullo_epi16(a, bQinv);
+    m = _mm256_mulhi_epi16(m, _mm256_set1_epi16(MLKEM_Q));
+    return _mm256_sub_epi16(hi, m);
+}
+
+MLKEM_AVX2 static inline __m256i MontMul(__m256i a, __m256i b)
+{
+    return MontMulPre(a, b, _mm256_mullo_epi16(b, _mm256_set1_epi16(MLKEM_QINV)));
+}
+
+// Barrett reduction of any int16, the result is centered around 0 and its absolute value is less than MLKEM_Q.
+MLKEM_AVX2 static inline __m256i BarrettReduce(__m256i a)
+{
+    __m256i t = _mm256_mulhi_epi16(a, _mm256_set1_epi16(MLKEM_BARRETT_V));
+    t = _mm256_mulhrs_epi16(t, _mm256_set1_epi16(1 << 5));  // round(t / 2^10)
+    t = _mm256_mullo_epi16(t, _mm256_set1_epi16(MLKEM_Q));
+    return _mm256_sub_epi16(a, t);
+}
+
+// Map (-MLKEM_Q, MLKEM_Q) to [0, MLKEM_Q).
+MLKEM_AVX2 static inline __m256i CondAddQ(__m256i a)
+{
+    return _mm256_add_epi16(a, _mm256_and_si256(_mm256_set1_epi16(MLKEM_Q), _mm256_srai_epi16(a, 15)));
+}
+
+MLKEM_AVX2 static inline __m256i Load(const int16_t *a)
+{
+    return _mm256_loadu_si256((const __m256i *)(uintptr_t)a);
+}
+
+MLKEM_AVX2 static inline void Store(int16_t *a, __m256i v)
+{
+    _mm256_storeu_si256((__m256i *)(uintptr_t)a, v);
+}
+
+MLKEM_AVX2 static inline void Exchange128(__m256i *a, __m256i *b)
+{
+    __m256i t = _mm256_permute2x128_si256(*a, *b, 0x20);  // 0x20: the low halves of a and b
+    *b = _mm256_permute2x128_si256(*a, *b, 0x31);         // 0x31: the high halves of a and b
+    *a = t;
+}
+
+MLKEM_AVX2 static inline void Exchange64(__m256i *a, __m256i *b)
+{
+    __m256i t = _mm256_unpacklo_epi64(*a, *b);
+    *b = _mm256_unpackhi_epi64(*a, *b);
+    *a = t;
+}
+
+MLKEM_AVX2 static inline void Exchange32(__m256i *a, __m256i *b)
+{
+    __m256i t = _mm256_blend_epi32(*a, _mm256_slli_epi64(*b, 32), 0xaa);  // 0xaa: the odd 32-bit words
+    *b = _mm256_blend_epi32(_mm256_srli_epi64(*a, 32), *b, 0xaa);
+    *a = t;
+}
+
+MLKEM_AVX2 static inline void LoadZetas(const int16_t *zetas, const int8_t mask[32], __m256i *z, __m256i *zQinv)
+{
+    __m256i v = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(uintptr_t)zetas));
+    *z = _mm256_shuffle_epi8(v, _mm256_loadu_si256((const __m256i *)(uintptr_t)mask));
+    *zQinv = _mm256_mullo_epi16(*z, _mm256_set1_epi16(MLKEM_QINV));
+}
+
+MLKEM_AVX2 static inline void ButterflyCT(__m256i *x, __m256i *y, __m256i z, __m256i zQinv)
+{
+    __m256i t = MontMulPre(*y, z, zQinv);
+    *y = _mm256_sub_epi16(*x, t);
+    *x = _mm256_add_epi16(*x, t);
+}
+
+MLKEM_AVX2 static inline void ButterflyGS(__m256i *x, __m256i *y, __m256i z, __m256i zQinv)
+{
+    __m256i u = *x;
+    *x = BarrettReduce(_mm256_add_epi16(u, *y));
+    *y = MontMulPre(_mm256_sub_epi16(u, *y), z, zQinv);
+}
+
+/*
+ * The same transform as MLKEM_ComputNTT with PRE_COMPUT_TABLE_NTT. The inputs are less than MLKEM_Q in absolute value,
+ * each layer adds less than MLKEM_Q to the coefficients, so the 7 layers do not overflow without any reduction.
+ */
+MLKEM_AVX2 void MLKEM_ComputNTTAvx2(int16_t *a)
+{
+    __m256i z;
+    __m256i zQinv;
+    for (uint32_t m = 1, t = MLKEM_N_HALF; t >= 16; m <<= 1, t >>= 1) {  // t >= 16: the distance of one register
+        for (uint32_t i = 0; i < m; i++) {
+            z = _mm256_set1_epi16(ZETAS_MONT[m + i]);
+            zQinv = _mm256_mullo_epi16(z, _mm256_set1_epi16(MLKEM_QINV));
+            for (uint32_t j = 2 * t * i; j < 2 * t * i + t; j += 16) {
+                __m256i x = Load(a + j);
+                __m256i y = Load(a + j + t);
+                ButterflyCT(&x, &y, z, zQinv);
+                Store(a + j, x);
+                Store(a + j + t, y);
+            }
+        }
+    }
+    for (uint32_t p = 0; p < MLKEM_N / 32; p++) {  // 32 coefficients in a pair of registers
+        __m256i x = Load(a + 32 * p);
+        __m256i y = Load(a + 32 * p + 16);
+        Exchange128(&x, &y);
+        LoadZetas(ZETAS_MONT + 16 + 2 * p, ZETAS_MASK_128, &z, &zQinv);
+        ButterflyCT(&x, &y, z, zQinv);
+        Exchange128(&x, &y);
+        Exchange64(&x, &y);
+        LoadZetas(ZETAS_MONT + 32 + 4 * p, ZETAS_MASK_64, &z, &zQinv);
+        ButterflyCT(&x, &y, z, zQinv);
+        Exchange64(&x, &y);
+        Exchange32(&x, &y);
+        LoadZetas(ZETAS_MONT + 64 + 8 * p, ZETAS_MASK_32, &z, &zQinv);
+        ButterflyCT(&x, &y, z, zQinv);
+        Exchange32(&x, &y);
+        Store(a + 32 * p, CondAddQ(BarrettReduce(x)));
+        Store(a + 32 * p + 16, CondAddQ(BarrettReduce(y)));
+    }
+}
+
+// The same transform as MLKEM_ComputINTT with PRE_COMPUT_TABLE_INTT.
+MLKEM_AVX2 void MLKEM_ComputINTTAvx2(int16_t *a)
+{
+    __m256i z;
+    __m256i zQinv;
+    for (uint32_t p = 0; p < MLKEM_N / 32; p++) {
+        __m256i x = Load(a + 32 * p);
+        __m256i y = Load(a + 32 * p + 16);
+        Exchange32(&x, &y);
+        LoadZetas(ZETAS_INV_MONT + 64 + 8 * p, ZETAS_MASK_32, &z, &zQinv);
+        ButterflyGS(&x, &y, z, zQinv);
+        Exchange32(&x, &y);
+        Exchange64(&x, &y);
+        LoadZetas(ZETAS_INV_MONT + 32 + 4 * p, ZETAS_MASK_64, &z, &zQinv);
+        ButterflyGS(&x, &y, z, zQinv);
+        Exchange64(&x, &y);
+        Exchange128(&x, &y);
+        LoadZetas(ZETAS_INV_MONT + 16 + 2 * p, ZETAS_MASK_128, &z, &zQinv);
+        ButterflyGS(&x, &y, z, zQinv);
+        Exchange128(&x, &y);
+        Store(a + 32 * p, x);
+        Store(a + 32 * p + 16, y);
+    }
+    for (uint32_t h = 8, t = 16; t <= MLKEM_N_HALF; h >>= 1, t <<= 1) {
+        for (uint32_t i = 0; i < h; i++) {
+            z = _mm256_set1_epi16(ZETAS_INV_MONT[h + i]);
+            zQinv = _mm256_mullo_epi16(z, _mm256_set1_epi16(MLKEM_QINV));
+            for (uint32_t j = 2 * t * i; j < 2 * t * i + t; j += 16) {
+                __m256i x = Load(a + j);
+                __m256i y = Load(a + j + t);
+                ButterflyGS(&x, &y, z, zQinv);
+                Store(a + j, x);
+                Store(a + j + t, y);
+            }
+        }
+    }
+    const __m256i invN = _mm256_set1_epi16(MLKEM_INVN_MONT);
+    const __m256i invNQinv = _mm256_set1_epi16((int16_t)(MLKEM_INVN_MONT * MLKEM_QINV));
+    for (uint32_t j = 0; j < MLKEM_N; j += 16) {
+        Store(a + j, CondAddQ(MontMulPre(Load(a + j), invN, invNQinv)));
+    }
+}
+
+// Swap the two coefficients of each degree-one polynomial.
+MLKEM_AVX2 static inline __m256i SwapPairs(__m256i a)
+{
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(a, 0xb1), 0xb1);  // 0xb1: the order 1, 0, 3, 2
+}
+
+/*
+ * The factors of the 8 degree-one polynomials in 16 coefficients: 2^16 for the even coefficients, and the gamma
+ * of the polynomial for the odd ones, the sign of gamma alternates as in CircMul.
+ */
+MLKEM_AVX2 static inline __m256i LoadGamma(const int16_t *gamma)
+{
+    const __m256i mask = _mm256_setr_epi8(-1, -1, 0, 1, -1, -1, 0, 1, -1, -1, 2, 3, -1, -1, 2, 3,
+        -1, -1, 4, 5, -1, -1, 4, 5, -1, -1, 6, 7, -1, -1, 6, 7);
+    const __m256i sign = _mm256_setr_epi16(1, 1, 1, -1, 1, 1, 1, -1, 1, 1, 1, -1, 1, 1, 1, -1);
+    __m256i v = _mm256_broadcastq_epi64(_mm_loadl_epi64((const __m128i *)(uintptr_t)gamma));
+    v = _mm256_sign_epi16(_mm256_shuffle_epi8(v, mask), sign);
+    return _mm256_blend_epi16(v, _mm256_set1_epi16(MLKEM_MONT), 0x55);  // 0x55: the even coefficients
+}
+
+// The product of 8 pairs of degree-one polynomials, multiplied by 2^(-16).
+MLKEM_AVX2 static inline __m256i BaseMul(__m256i f, __m256i g, __m256i gamma, __m256i gammaQinv)
+{
+    __m256i p = MontMul(f, g);                // f0 * g0, f1 * g1
+    __m256i s = MontMul(f, SwapPairs(g));     // f0 * g1, f1 * g0
+    p = MontMulPre(p, gamma, gammaQinv);      // f0 * g0, f1 * g1 * gamma
+    p = _mm256_add_epi16(p, SwapPairs(p));
+    s = _mm256_add_epi16(s, SwapPairs(s));
+    return _mm256_blend_epi16(p, s, 0xaa);    // 0xaa: the odd coefficients
+}
+
+/*
+ * The same as MLKEM_MatrixMulAdd with PRE_COMPUT_TABLE_NTT. The products of the k <= 4 polynomials are summed up
+ * without reduction, each of them is less than 2 * MLKEM_Q in absolute value.
+ */
+MLKEM_AVX2 void MLKEM_MatrixMulAddAvx2(uint8_t k, int16_t *matrix[], int16_t *vectorS[], int16_t *vectorE,
+    int16_t *vectorT)
+{
+    const __m256i mont2 = _mm256_set1_epi16(MLKEM_MONT2);
+    const __m256i mont2Qinv = _mm256_set1_epi16((int16_t)(MLKEM_MONT2 * MLKEM_QINV));
+    for (uint32_t n = 0; n < MLKEM_N; n += 16) {
+        __m256i gamma = LoadGamma(ZETAS_MONT + MLKEM_N_HALF / 2 + n / 4);  // 4 coefficients share one gamma
+        __m256i gammaQinv = _mm256_mullo_epi16(gamma, _mm256_set1_epi16(MLKEM_QINV));
+        __m256i acc = _mm256_setzero_si256();
+        for (uint8_t j = 0; j < k; j++) {
+            acc = _mm256_add_epi16(acc, BaseMul(Load(matrix[j] + n), Load(vectorS[j] + n), gamma, gammaQinv));
+        }
+        acc = MontMulPre(acc, mont2, mont2Qinv);  // remove the factor 2^(-16) of the products
+        if (vectorE != NULL) {
+            acc = _mm256_add_epi16(acc, Load(vectorE + n));
+        }
+        Store(vectorT + n, CondAddQ(BarrettReduce(acc)));
+    }
+}
+
+// round(x * 2^d / MLKEM_Q) = floor((x * 2^(d + 1) + MLKEM_Q) / (2 * MLKEM_Q)) for 8 x in [0, MLKEM_Q).
+MLKEM_AVX2 static inline __m256i DivRoundQ(__m256i x, __m128i shift)
+{
+    const __m256i m = _mm256_set1_epi32(MLKEM_COMPRESS_M);
+    __m256i n = _mm256_add_epi32(_mm256_sll_epi32(x, shift), _mm256_set1_epi32(MLKEM_Q));
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(n, m), MLKEM_COMPRESS_SHIFT);
+    __m256i odd = _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(n, 32), m), MLKEM_COMPRESS_SHIFT);
+    return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xaa);
+}
+
+// Pack 16 uint32 into the 16 int16 in the same order.
+MLKEM_AVX2 static inline __m256i Pack32(__m256i lo, __m256i hi)
+{
+    return _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xd8);  // 0xd8: the order 0, 2, 1, 3
+}
+
+// Compress_d of NIST.FIPS.203 for all coefficients, the coefficients are in (-MLKEM_Q, 2 * MLKEM_Q).
+MLKEM_AVX2 void MLKEM_CompressAvx2(int16_t *poly, uint8_t d)
+{
+    const __m256i mask = _mm256_set1_epi32((1 << d) - 1);
+    const __m128i shift = _mm_cvtsi32_si128(d + 1);
+    for (uint32_t n = 0; n < MLKEM_N; n += 16) {
+        __m256i x = CondAddQ(BarrettReduce(Load(poly + n)));
+        __m256i lo = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(x));
+        __m256i hi = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(x, 1));
+        lo = _mm256_and_si256(DivRoundQ(lo, shift), mask);
+        hi = _mm256_and_si256(DivRoundQ(hi, shift), mask);
+        Store(poly + n, Pack32(lo, hi));
+    }
+}
+
+// Decompress_d of NIST.FIPS.203 for all coefficients, the coefficients are in [0, 2^d).
+MLKEM_AVX2 void MLKEM_DeCompressAvx2(int16_t *poly, uint8_t d)
+{
+    const __m256i q = _mm256_set1_epi32(MLKEM_Q);
+    const __m256i half = _mm256_set1_epi32(1 << (d - 1));
+    const __m128i shift = _mm_cvtsi32_si128(d);
+    for (uint32_t n = 0; n < MLKEM_N; n += 16) {
+        __m256i x = Load(poly + n);
+        __m256i lo = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(x));
+        __m256i hi = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(x, 1));
+        lo = _mm256_srl_epi32(_mm256_add_epi32(_mm256_mullo_epi32(lo, q), half), shift);
+        hi = _mm256_srl_epi32(_mm256_add_epi32(_mm256_mullo_epi32(hi, q), half), shift);
+        Store(poly + n, Pack32(lo, hi));
+    }
+}
+
+/*
+ * The rejection sampling of NIST.FIPS.203 Algorithm 7 SampleNTT, 24 bytes give 16 candidates at a time. Stop when
+ * less than 32 bytes are left or the next candidates may exceed n, *pos returns the bytes consumed.
+ */
+MLKEM_AVX2 uint32_t MLKEM_ParseAvx2(uint16_t *polyNtt, const uint8_t *arrayB, uint32_t arrayLen, uint32_t n,
+    uint32_t *pos)
+{
+    // Bytes 0 - 11 in the low half and bytes 12 - 23 in the high half, 3 bytes are spread to 2 candidates.
+    const __m256i idx = _mm256_setr_epi8(0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11,
+        4, 5, 5, 6, 7, 8, 8, 9, 10, 11, 11, 12, 13, 14, 14, 15);
+    const __m256i q = _mm256_set1_epi16(MLKEM_Q);
+    uint16_t val[16];
+    uint32_t i = 0;
+    uint32_t j = 0;
+    while (i + 32 <= arrayLen && j + 16 <= n) {
+        __m256i b = _mm256_loadu_si256((const __m256i *)(uintptr_t)(arrayB + i));
+        b = _mm256_shuffle_epi8(_mm256_permute4x64_epi64(b, 0x94), idx);  // 0x94: the 64-bit words 0, 1, 1, 2
+        b = _mm256_blend_epi16(_mm256_and_si256(b, _mm256_set1_epi16(0x0fff)), _mm256_srli_epi16(b, 4), 0xaa);
+        uint32_t good = (uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi16(q, b));  // 2 bits for each candidate
+        _mm256_storeu_si256((__m256i *)val, b);
+        while (good != 0) {
+            polyNtt[j++] = val[__builtin_ctz(good) >> 1];
+            good &= good - 1;
+            good &= good - 1;
+        }
+        i += 24;  // 24 bytes are processed in each round.
+    }
+    *pos = i;
+    return j;
+}
+
+#endif
@@ -69,6 +69,21 @@ static void GcmRemHandle(MODES_CipherGCMCtx *ctx, const uint8_t *in, uint8_t *ou
     ctx->lastLen = GCM_BLOCKSIZE - len;
 }
 
+// Counter mode and GHASH in one pass for the bulk of the data, on the CPUs that have the wide SM4 kernels.
+static uint32_t GcmCryptWide(MODES_CipherGCMCtx *ctx, const uint8_t *in, uint8_t *out, uint32_t len, bool enc)
+{
+#ifdef __x86_64__
+    return CRYPT_SM4_GCM_CryptWide(ctx->ciphCtx, in, out, len, ctx->iv, ctx->ghash, ctx->hTable, enc);
+#else
+    (void)ctx;
+    (void)in;
+    (void)out;
+    (void)len;
+    (void)enc;
+    return 0;
+#endif
+}
+
 int32_t MODES_SM4_GCM_EncryptBlock(MODES_CipherGCMCtx *ctx, const uint8_t *in, uint8_t *out, uint32_t len)
 {
     ctx->plaintextLen += len;
@@ -80,6 +95,10 @@ int32_t MODES_SM4_GCM_EncryptBlock(MODES_CipherGCMCtx *ctx, const uint8_t *in, u
     const uint8_t *tmpIn = in + lastLen;
     uint8_t *tmpOut = out + lastLen;
     uint32_t clen = len - lastLen;
+    uint32_t wideLen = GcmCryptWide(ctx, tmpIn, tmpOut, clen, true);
+    clen -= wideLen;
+    tmpIn += wideLen;
+    tmpOut += wideLen;
     if (clen >= GCM_BLOCKSIZE) {
         uint32_t calLen = clen & 0xfffffff0;
         (void)CRYPT_SM4_CTR_Encrypt(ctx->ciphCtx, tmpIn, tmpOut, calLen / GCM_BLOCKSIZE, ctx->iv);
@@ -105,6 +124,10 @@ int32_t MODES_SM4_GCM_DecryptBlock(MODES_CipherGCMCtx *ctx, const uint8_t *in, u
     const uint8_t *tmpIn = in + lastLen;
     uint8_t *tmpOut = out + lastLen;
     uint32_t clen = len - lastLen;
+    uint32_t wideLen = GcmCryptWide(ctx, tmpIn, tmpOut, clen, false);
+    clen -= wideLen;
+    tmpIn += wideLen;
+    tmpOut += wideLen;
     if (clen >= GCM_BLOCKSIZE) {
         uint32_t calLen = clen & 0xfffffff0; // Obtains the length that is an integer multiple of 16 bytes.
         GcmHashMultiBlock(ctx->ghash, ctx->hTable, tmpIn, calLen);
@@ -30,6 +30,9 @@
 #include "pbkdf2_local.h"
 #include "bsl_params.h"
 #include "crypt_params_key.h"
+#ifdef HITLS_CRYPTO_SHA256
+#include "crypt_sha2.h"
+#endif
 
 #define PBKDF2_MAX_BLOCKSIZE 64
 #define PBKDF2_MAX_KEYLEN 0xFFFFFFFF
@@ -140,6 +143,183 @@ int32_t CRYPT_PBKDF2_CalcT(const CRYPT_PBKDF2_Ctx *pCtx, uint32_t blockCount, ui
     return CRYPT_SUCCESS;
 }
 
+#ifdef HITLS_CRYPTO_SHA256
+#define PBKDF2_SHA256_WORDS (CRYPT_SHA2_256_DIGESTSIZE / sizeof(uint32_t))
+#define PBKDF2_SHA256_LANES CRYPT_SHA2_256_X8_LANES
+/* Below this number of T blocks, the eight lanes cost more than compressing the blocks one by one. Without the avx2
+   kernel of SHA-256, the lanes are always slower. */
+#define PBKDF2_SHA256_MIN_LANES 3
+
+/* The HMAC-SHA256 midstates, the chaining values after the blocks K ^ ipad and K ^ opad. */
+typedef struct {
+    uint32_t inner[PBKDF2_SHA256_WORDS];
+    uint32_t outer[PBKDF2_SHA256_WORDS];
+} Pbkdf2Sha256Pads;
+
+/* The key must not exceed the block size, so that it is used as it is. */
+static int32_t Pbkdf2Sha256InitPads(const CRYPT_PBKDF2_Ctx *pCtx, Pbkdf2Sha256Pads *pads)
+{
+    uint8_t block[CRYPT_SHA2_256_BLOCKSIZE];
+    CRYPT_SHA2_256_Ctx *mdCtx = CRYPT_SHA2_256_NewCtx();
+    if (mdCtx == NULL) {
+        BSL_ERR_PUSH_ERROR(CRYPT_MEM_ALLOC_FAIL);
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    for (uint32_t i = 0; i < CRYPT_SHA2_256_BLOCKSIZE; i++) {
+        block[i] = ((i < pCtx->passLen) ? pCtx->password[i] : 0) ^ 0x36; // ipad
+    }
+    (void)CRYPT_SHA2_256_Init(mdCtx, NULL);
+    (void)CRYPT_SHA2_256_Update(mdCtx, block, sizeof(block));
+    int32_t ret = CRYPT_SHA2_256_GetState(mdCtx, pads->inner);
+    for (uint32_t i = 0; i < CRYPT_SHA2_256_BLOCKSIZE; i++) {
+        block[i] ^= 0x36 ^ 0x5c; // ipad to opad
+    }
+    (void)CRYPT_SHA2_256_Init(mdCtx, NULL);
+    (void)CRYPT_SHA2_256_Update(mdCtx, block, sizeof(block));
+    if (ret == CRYPT_SUCCESS) {
+        ret = CRYPT_SHA2_256_GetState(mdCtx, pads->outer);
+    }
+    BSL_SAL_CleanseData(block, sizeof(block));
+    CRYPT_SHA2_256_FreeCtx(mdCtx);
+    return ret;
+}
+
+/*
+ * Both hashes of an iteration take a 32-byte digest after the pad block, so the message is one block: the digest,
+ * then the padding of a 96-byte input. Only the digest part changes between the iterations.
+ */
+static void Pbkdf2Sha256PadBlock(uint8_t block[CRYPT_SHA2_256_BLOCKSIZE])
+{
+    (void)memset_s(block + CRYPT_SHA2_256_DIGESTSIZE, CRYPT_SHA2_256_BLOCKSIZE - CRYPT_SHA2_256_DIGESTSIZE, 0,
+        CRYPT_SHA2_256_BLOCKSIZE - CRYPT_SHA2_256_DIGESTSIZE);
+    block[CRYPT_SHA2_256_DIGESTSIZE] = 0x80;
+    PUT_UINT32_BE((CRYPT_SHA2_256_BLOCKSIZE + CRYPT_SHA2_256_DIGESTSIZE) * 8, block, CRYPT_SHA2_256_BLOCKSIZE - 4);
+}
+
+/* The iterations U2 ... Uc of one T block, t holds U1 on input and T on output. */
+static void Pbkdf2Sha256Iterate(const Pbkdf2Sha256Pads *pads, uint32_t iterCnt, uint8_t *t)
+{
+    uint8_t block[CRYPT_SHA2_256_BLOCKSIZE];
+    uint32_t state[PBKDF2_SHA256_WORDS];
+    uint32_t sum[PBKDF2_SHA256_WORDS];
+    (void)memcpy_s(block, sizeof(block), t, CRYPT_SHA2_256_DIGESTSIZE);
+    Pbkdf2Sha256PadBlock(block);
+    for (uint32_t i = 0; i < PBKDF2_SHA256_WORDS; i++) {
+        sum[i] = GET_UINT32_BE(t, 4 * i); // 4 bytes in a word
+    }
+    for (uint32_t un = 1; un < iterCnt; un++) {
+        (void)memcpy_s(state, sizeof(state), pads->inner, sizeof(pads->inner));
+        CRYPT_SHA2_256_Compress(state, block, 1);
+        for (uint32_t i = 0; i < PBKDF2_SHA256_WORDS; i++) {
+            PUT_UINT32_BE(state[i], block, 4 * i); // 4 bytes in a word
+        }
+        (void)memcpy_s(state, sizeof(state), pads->outer, sizeof(pads->outer));
+        CRYPT_SHA2_256_Compress(state, block, 1);
+        for (uint32_t i = 0; i < PBKDF2_SHA256_WORDS; i++) {
+            PUT_UINT32_BE(state[i], block, 4 * i); // 4 bytes in a word
+            sum[i] ^= state[i];
+        }
+    }
+    for (uint32_t i = 0; i < PBKDF2_SHA256_WORDS; i++) {
+        PUT_UINT32_BE(sum[i], t, 4 * i); // 4 bytes in a word
+    }
+    BSL_SAL_CleanseData(block, sizeof(block));
+    BSL_SAL_CleanseData(state, sizeof(state));
+    BSL_SAL_CleanseData(sum, sizeof(sum));
+}
+
+/* Pbkdf2Sha256Iterate of up to eight T blocks, one per lane of the SHA-256 kernel. */
+static void Pbkdf2Sha256IterateX8(const Pbkdf2Sha256Pads *pads, uint32_t iterCnt, uint8_t t[][CRYPT_SHA2_256_DIGESTSIZE],
+    uint32_t lanes)
+{
+    uint8_t block[PBKDF2_SHA256_LANES][CRYPT_SHA2_256_BLOCKSIZE];
+    uint32_t state[PBKDF2_SHA256_WORDS * PBKDF2_SHA256_LANES];
+    uint32_t sum[PBKDF2_SHA256_WORDS * PBKDF2_SHA256_LANES];
+    const uint8_t *in[PBKDF2_SHA256_LANES];
+    for (uint32_t j = 0; j < PBKDF2_SHA256_LANES; j++) {
+        in[j] = block[(j < lanes) ? j : 0]; // the spare lanes repeat the lane 0
+    }
+    for (uint32_t j = 0; j < lanes; j++) {
+        (void)memcpy_s(block[j], CRYPT_SHA2_256_BLOCKSIZE, t[j], CRYPT_SHA2_256_DIGESTSIZE);
+        Pbkdf2Sha256PadBlock(block[j]);
+        for (uint32_t i = 0; i < PBKDF2_SHA256_WORDS; i++) {
+            sum[i * PBKDF2_SHA256_LANES + j] = GET_UINT32_BE(t[j], 4 * i); // 4 bytes in a word
+        }
+    }
+    for (uint32_t un = 1; un < iterCnt; un++) {
+        for (uint32_t i = 0; i < PBKDF2_SHA256_WORDS * PBKDF2_SHA256_LANES; i++) {
+            state[i] = pads->inner[i / PBKDF2_SHA256_LANES];
+        }
+        CRYPT_SHA2_256_CompressX8(state, in, 1);
+        for (uint32_t j = 0; j < lanes; j++) {
+            for (uint32_t i = 0; i < PBKDF2_SHA256_WORDS; i++) {
+                PUT_UINT32_BE(state[i * PBKDF2_SHA256_LANES + j], block[j], 4 * i); // 4 bytes in a word
+            }
+        }
+        for (uint32_t i = 0; i < PBKDF2_SHA256_WORDS * PBKDF2_SHA256_LANES; i++) {
+            state[i] = pads->outer[i / PBKDF2_SHA256_LANES];
+        }
+        CRYPT_SHA2_256_CompressX8(state, in, 1);
+        for (uint32_t j = 0; j < lanes; j++) {
+            for (uint32_t i = 0; i < PBKDF2_SHA256_WORDS; i++) {
+                PUT_UINT32_BE(state[i * PBKDF2_SHA256_LANES + j], block[j], 4 * i); // 4 bytes in a word
+                sum[i * PBKDF2_SHA256_LANES + j] ^= state[i * PBKDF2_SHA256_LANES + j];
+            }
+        }
+    }
+    for (uint32_t j = 0; j < lanes; j++) {
+        for (uint32_t i = 0; i < PBKDF2_SHA256_WORDS; i++) {
+            PUT_UINT32_BE(sum[i * PBKDF2_SHA256_LANES + j], t[j], 4 * i); // 4 bytes in a word
+        }
+    }
+    BSL_SAL_CleanseData(block, sizeof(block));
+    BSL_SAL_CleanseData(state, sizeof(state));
+    BSL_SAL_CleanseData(sum, sizeof(sum));
+}
+
+/*
+ * PBKDF2 with HMAC-SHA256, U1 is computed by the mac method which has been initialized with the password. The other
+ * iterations resume the HMAC midstates with the SHA-256 compression directly, several T blocks at a time with the
+ * avx2 kernel, otherwise one by one.
+ */
+static int32_t Pbkdf2Sha256GenDk(const CRYPT_PBKDF2_Ctx *pCtx, uint8_t *dk, uint32_t dkLen)
+{
+    Pbkdf2Sha256Pads pads;
+    uint8_t t[PBKDF2_SHA256_LANES][CRYPT_SHA2_256_DIGESTSIZE];
+    int32_t ret = Pbkdf2Sha256InitPads(pCtx, &pads);
+    bool x8 = CRYPT_SHA2_256_CompressX8IsFast();
+    uint32_t blockCount = 1;
+    for (uint32_t curLen = dkLen; curLen > 0 && ret == CRYPT_SUCCESS;) {
+        uint32_t lanes = 0;
+        for (uint32_t left = curLen; lanes < PBKDF2_SHA256_LANES && left > 0 && ret == CRYPT_SUCCESS; lanes++) {
+            uint32_t blockSize = CRYPT_SHA2_256_DIGESTSIZE;
+            ret = CRYPT_PBKDF2_U1(pCtx, blockCount + lanes, t[lanes], &blockSize);
+            left -= (left > CRYPT_SHA2_256_DIGESTSIZE) ? CRYPT_SHA2_256_DIGESTSIZE : left;
+        }
+        if (ret != CRYPT_SUCCESS) {
+            break;
+        }
+        if (x8 && lanes >= PBKDF2_SHA256_MIN_LANES) {
+            Pbkdf2Sha256IterateX8(&pads, pCtx->iterCnt, t, lanes);
+        } else {
+            for (uint32_t j = 0; j < lanes; j++) {
+                Pbkdf2Sha256Iterate(&pads, pCtx->iterCnt, t[j]);
+            }
+        }
+        for (uint32_t j = 0; j < lanes; j++) {
+            uint32_t len = (curLen > CRYPT_SHA2_256_DIGESTSIZE) ? CRYPT_SHA2_256_DIGESTSIZE : curLen;
+            (void)memcpy_s(dk, curLen, t[j], len);
+            dk += len;
+            curLen -= len;
+        }
+        blockCount += lanes;
+    }
+    BSL_SAL_CleanseData(&pads, sizeof(pads));
+    BSL_SAL_CleanseData(t, sizeof(t));
+    return ret;
+}
+#endif
+
 int32_t CRYPT_PBKDF2_GenDk(const CRYPT_PBKDF2_Ctx *pCtx, uint8_t *dk, uint32_t dkLen)
 {
     uint32_t curLen;
@@ -153,6 +333,11 @@ int32_t CRYPT_PBKDF2_GenDk(const CRYPT_PBKDF2_Ctx *pCtx, uint8_t *dk, uint32_t d
         BSL_ERR_PUSH_ERROR(ret);
         return ret;
     }
+#ifdef HITLS_CRYPTO_SHA256
+    if (pCtx->macId == CRYPT_MAC_HMAC_SHA256 && pCtx->iterCnt > 1 && pCtx->passLen <= CRYPT_SHA2_256_BLOCKSIZE) {
+        return Pbkdf2Sha256GenDk(pCtx, dk, dkLen);
+    }
+#endif
 
     /* DK = T1 + T2 + ⋯ + Tdklen/hlen */
     for (i = 1, curLen = dkLen; curLen > 0; i++) {
@@ -204,6 +389,7 @@ int32_t CRYPT_PBKDF2_HMAC(const EAL_MacMethod *macMeth, CRYPT_MAC_AlgId macId, c
         return CRYPT_MEM_ALLOC_FAIL;
     }
 
+    pCtx.macId = macId;
     pCtx.macMeth = macMeth;
     pCtx.macCtx = macCtx;
     pCtx.password = (uint8_t *)(uintptr_t)key;
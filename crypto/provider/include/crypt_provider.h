@@ -37,11 +37,24 @@ typedef enum {
     CRYPT_PROVIDER_CTRL_MAX,
 } CRYPT_ProviderCtrlCmd;
 
+// Number of slots in the resolved method cache, which must be a power of 2
+#define CRYPT_EAL_METHOD_CACHE_SIZE 64
+
+// A resolved (operaId, algId, attribute) query, so that repeated lookups skip the provider walk
+typedef struct {
+    int32_t operaId;
+    int32_t algId;
+    char *attribute; // Copy of the query attribute, NULL if the query has no attribute
+    const CRYPT_EAL_Func *funcs; // NULL if the slot is empty
+    CRYPT_EAL_ProvMgrCtx *mgrCtx;
+} EAL_MethodCacheEntry;
+
 struct EAL_LibCtx {
     BslList *providers; // managing providers
     BSL_SAL_ThreadLockHandle lock;
     char *searchProviderPath;
     void *drbg;
+    EAL_MethodCacheEntry methodCache[CRYPT_EAL_METHOD_CACHE_SIZE]; // cleared whenever the providers list changes
 };
 
 #if defined(HITLS_CRYPTO_ENTROPY) &&                                                        \
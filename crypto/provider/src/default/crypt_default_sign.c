@@ -70,6 +70,7 @@ const CRYPT_EAL_Func g_defSignEcdsa[] = {
     {CRYPT_EAL_IMPLPKEYSIGN_SIGNDATA, (CRYPT_EAL_ImplPkeySignData)CRYPT_ECDSA_SignData},
     {CRYPT_EAL_IMPLPKEYSIGN_VERIFY, (CRYPT_EAL_ImplPkeyVerify)CRYPT_ECDSA_Verify},
     {CRYPT_EAL_IMPLPKEYSIGN_VERIFYDATA, (CRYPT_EAL_ImplPkeyVerifyData)CRYPT_ECDSA_VerifyData},
+    {CRYPT_EAL_IMPLPKEYSIGN_VERIFYBATCH, (CRYPT_EAL_ImplPkeyVerifyBatch)CRYPT_ECDSA_VerifyBatch},
 #endif
     CRYPT_EAL_FUNC_END,
 };
@@ -78,6 +79,7 @@ const CRYPT_EAL_Func g_defSignSm2[] = {
 #ifdef HITLS_CRYPTO_SM2_SIGN
     {CRYPT_EAL_IMPLPKEYSIGN_SIGN, (CRYPT_EAL_ImplPkeySign)CRYPT_SM2_Sign},
     {CRYPT_EAL_IMPLPKEYSIGN_VERIFY, (CRYPT_EAL_ImplPkeyVerify)CRYPT_SM2_Verify},
+    {CRYPT_EAL_IMPLPKEYSIGN_VERIFYBATCH, (CRYPT_EAL_ImplPkeyVerifyBatch)CRYPT_SM2_VerifyBatch},
 #endif
     CRYPT_EAL_FUNC_END,
 };
@@ -56,6 +56,7 @@ void CRYPT_EAL_LibCtxFree(CRYPT_EAL_LibCtx *libCtx)
     if (libCtx->providers != NULL) {
         BSL_LIST_FREE(libCtx->providers, (BSL_LIST_PFUNC_FREE)CRYPT_EAL_ProviderMgrCtxFree);
     }
+    CRYPT_EAL_MethodCacheClear(libCtx);
 
     if (libCtx->lock != NULL) {
         BSL_SAL_ThreadLockFree(libCtx->lock);
@@ -178,6 +179,10 @@ static int32_t AddProviderToList(CRYPT_EAL_LibCtx *libCtx, CRYPT_EAL_ProvMgrCtx
     }
 
     ret = BSL_LIST_AddElement(libCtx->providers, providerMgr, BSL_LIST_POS_END);
+    if (ret == BSL_SUCCESS) {
+        // The new provider may offer a better match for the queries resolved before
+        CRYPT_EAL_MethodCacheClear(libCtx);
+    }
     (void)BSL_SAL_ThreadUnlock(libCtx->lock);
     if (ret != BSL_SUCCESS) {
         BSL_ERR_PUSH_ERROR(ret);
@@ -358,7 +363,7 @@ int32_t CRYPT_EAL_ProviderUnload(CRYPT_EAL_LibCtx *libCtx, BSL_SAL_LibFmtCmd cmd
     }
 
     // Search for the specified provider
-    ret = BSL_SAL_ThreadReadLock(localCtx->lock);
+    ret = BSL_SAL_ThreadWriteLock(localCtx->lock);
     if (ret != BSL_SUCCESS) {
         BSL_ERR_PUSH_ERROR(ret);
         BSL_SAL_FREE(providerFullName);
@@ -381,6 +386,7 @@ int32_t CRYPT_EAL_ProviderUnload(CRYPT_EAL_LibCtx *libCtx, BSL_SAL_LibFmtCmd cmd
     }
 
     if (refCount <= 0) {
+        CRYPT_EAL_MethodCacheClear(localCtx);
         RemoveAndFreeProvider(localCtx->providers, providerMgr);
     }
     (void)BSL_SAL_ThreadUnlock(localCtx->lock);
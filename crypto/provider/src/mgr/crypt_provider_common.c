@@ -274,6 +274,7 @@ int32_t CRYPT_EAL_LoadPreDefinedProvider(CRYPT_EAL_LibCtx *libCtx, const char* p
     ret = CRYPT_EAL_InitProviderMethod(mgrCtx, NULL, CRYPT_EAL_DefaultProvInit);
     if (ret == BSL_SUCCESS) {
         ret = BSL_LIST_AddElement(libCtx->providers, mgrCtx, BSL_LIST_POS_END);
+        CRYPT_EAL_MethodCacheClear(libCtx);
         if (ctx != NULL) {
             *ctx = mgrCtx;
         }
@@ -319,6 +320,7 @@ void CRYPT_EAL_FreePreDefinedProviders(void)
     if (libCtx->providers != NULL) {
         BSL_LIST_FREE(libCtx->providers, (BSL_LIST_PFUNC_FREE)CRYPT_EAL_ProviderMgrCtxFree);
     }
+    CRYPT_EAL_MethodCacheClear(libCtx);
 
     BSL_SAL_FREE(libCtx->searchProviderPath);
 
@@ -432,6 +432,77 @@ static void FindHighestScoreFunc(CRYPT_EAL_LibCtx *localCtx, int32_t operaId, in
     }
 }
 
+static EAL_MethodCacheEntry *MethodCacheSlot(CRYPT_EAL_LibCtx *localCtx, int32_t operaId, int32_t algId,
+    const char *attribute)
+{
+    int32_t id[2] = {operaId, algId};
+    uint32_t hashCode = BSL_HASH_CodeCalc(id, sizeof(id));
+    if (attribute != NULL) {
+        hashCode ^= BSL_HASH_CodeCalc((void *)(uintptr_t)attribute, (uint32_t)strlen(attribute));
+    }
+    return &localCtx->methodCache[hashCode & (CRYPT_EAL_METHOD_CACHE_SIZE - 1)];
+}
+
+static bool MethodCacheMatch(const EAL_MethodCacheEntry *entry, int32_t operaId, int32_t algId,
+    const char *attribute)
+{
+    if (entry->funcs == NULL || entry->operaId != operaId || entry->algId != algId) {
+        return false;
+    }
+    if (entry->attribute == NULL || attribute == NULL) {
+        return entry->attribute == attribute;
+    }
+    return strcmp(entry->attribute, attribute) == 0;
+}
+
+static bool MethodCacheFind(CRYPT_EAL_LibCtx *localCtx, int32_t operaId, int32_t algId, const char *attribute,
+    const CRYPT_EAL_Func **funcs, CRYPT_EAL_ProvMgrCtx **mgrCtx)
+{
+    if (BSL_SAL_ThreadReadLock(localCtx->lock) != BSL_SUCCESS) {
+        return false;
+    }
+    const EAL_MethodCacheEntry *entry = MethodCacheSlot(localCtx, operaId, algId, attribute);
+    bool found = MethodCacheMatch(entry, operaId, algId, attribute);
+    if (found) {
+        *funcs = entry->funcs;
+        *mgrCtx = entry->mgrCtx;
+    }
+    BSL_SAL_ThreadUnlock(localCtx->lock);
+    return found;
+}
+
+static void MethodCacheEntryClear(EAL_MethodCacheEntry *entry)
+{
+    BSL_SAL_FREE(entry->attribute);
+    entry->funcs = NULL;
+    entry->mgrCtx = NULL;
+}
+
+// Called with the write lock held. A failure to copy the attribute only leaves the query uncached.
+static void MethodCacheStore(CRYPT_EAL_LibCtx *localCtx, int32_t operaId, int32_t algId, const char *attribute,
+    const CRYPT_EAL_Func *funcs, CRYPT_EAL_ProvMgrCtx *mgrCtx)
+{
+    EAL_MethodCacheEntry *entry = MethodCacheSlot(localCtx, operaId, algId, attribute);
+    MethodCacheEntryClear(entry);
+    if (attribute != NULL) {
+        entry->attribute = BSL_SAL_Dump(attribute, (uint32_t)strlen(attribute) + 1);
+        if (entry->attribute == NULL) {
+            return;
+        }
+    }
+    entry->operaId = operaId;
+    entry->algId = algId;
+    entry->funcs = funcs;
+    entry->mgrCtx = mgrCtx;
+}
+
+void CRYPT_EAL_MethodCacheClear(CRYPT_EAL_LibCtx *libCtx)
+{
+    for (uint32_t i = 0; i < CRYPT_EAL_METHOD_CACHE_SIZE; i++) {
+        MethodCacheEntryClear(&libCtx->methodCache[i]);
+    }
+}
+
 int32_t CRYPT_EAL_CompareAlgAndAttr(CRYPT_EAL_LibCtx *localCtx, int32_t operaId,
     int32_t algId, const char *attribute, const CRYPT_EAL_Func **funcs, CRYPT_EAL_ProvMgrCtx **mgrCtx)
 {
@@ -440,6 +511,14 @@ int32_t CRYPT_EAL_CompareAlgAndAttr(CRYPT_EAL_LibCtx *localCtx, int32_t operaId,
     CRYPT_EAL_ProvMgrCtx *ctx = NULL;
     InputAttributeStrInfo attrInfo = {0};
 
+    // The query resolved before is answered by a single probe, without parsing the attribute again.
+    if (MethodCacheFind(localCtx, operaId, algId, attribute, &implFunc, &ctx)) {
+        *funcs = implFunc;
+        if (mgrCtx != NULL) {
+            *mgrCtx = ctx;
+        }
+        return CRYPT_SUCCESS;
+    }
     if (attribute != NULL) {
         attrInfo.attribute = attribute;
         ret = ParseAttributeString(&attrInfo);
@@ -456,6 +535,9 @@ int32_t CRYPT_EAL_CompareAlgAndAttr(CRYPT_EAL_LibCtx *localCtx, int32_t operaId,
     }
     
     FindHighestScoreFunc(localCtx, operaId, algId, attrInfo, &implFunc, &ctx);
+    if (implFunc != NULL) {
+        MethodCacheStore(localCtx, operaId, algId, attribute, implFunc, ctx);
+    }
 
     BSL_SAL_ThreadUnlock(localCtx->lock);
     BSL_HASH_Destory(attrInfo.hash);
@@ -58,6 +58,9 @@ int32_t CRYPT_EAL_CompareAlgAndAttr(CRYPT_EAL_LibCtx *localCtx, int32_t operaId,
 
 void CRYPT_EAL_ProviderMgrCtxFree(CRYPT_EAL_ProvMgrCtx  *ctx);
 
+// Drop all resolved methods, called whenever a provider is added to or removed from the list
+void CRYPT_EAL_MethodCacheClear(CRYPT_EAL_LibCtx *libCtx);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -49,6 +49,9 @@ CRYPT_SCRYPT_Ctx* CRYPT_SCRYPT_NewCtx(void);
  *
  * @param ctx   [in, out] Pointer to the SCRYPT context.
  * @param param [in] Either a MAC algorithm ID, a seed, a password, or a label.
+ *                   CRYPT_PARAM_KDF_THREAD_NUM spreads the p lanes over up to 16 threads, each thread takes the
+ *                   128 * r * N bytes of memory of a lane. It is 1 by default, and only available with
+ *                   HITLS_BSL_SAL_THREAD on Linux.
  *
  * @retval Success: CRYPT_SUCCESS
  *         For other error codes, see crypt_errno.h.
@@ -29,8 +29,10 @@
 #include "pbkdf2_local.h"
 #include "bsl_params.h"
 #include "crypt_params_key.h"
+#include "scrypt_local.h"
 
 #define SCRYPT_PR_MAX   ((1 << 30) - 1)
+#define SCRYPT_MAX_THREAD_NUM 16
 
 // Convert the little-endian array to the host order.
 #define SALSA_INPUT_TO_HOST(T, x) \
@@ -87,8 +89,10 @@ struct CryptScryptCtx {
     uint32_t n;
     uint32_t r;
     uint32_t p;
+    uint32_t threadNum;
 };
 
+#ifndef SCRYPT_ROMIX_SSE2
 /* This function is implemented by referring to the RFC standard.
    For details, see section 3 in https://www.rfc-editor.org/rfc/rfc7914.txt */
 static void SCRYPT_Salsa20WordSpecification(uint32_t t[16])
@@ -201,6 +205,103 @@ static void SCRYPT_ROMix(uint8_t *b, uint32_t n, uint32_t r, uint8_t *v, uint8_t
         SCRYPT_BlockMix(b, y, r);
     }
 }
+#endif // SCRYPT_ROMIX_SSE2
+
+/* The lanes first, first + step, ... of B, with the scratch v and y of this job. */
+typedef struct {
+    uint8_t *b;
+    uint8_t *v;
+    uint8_t *y;
+    uint32_t n;
+    uint32_t r;
+    uint32_t p;
+    uint32_t first;
+    uint32_t step;
+} ScryptLaneJob;
+
+static void SCRYPT_MixJobLanes(const ScryptLaneJob *job)
+{
+    uint32_t blockSize = job->r << 7; // r * 128
+    for (uint32_t i = job->first; i < job->p; i += job->step) {
+#ifdef SCRYPT_ROMIX_SSE2
+        SCRYPT_ROMixSse2(job->b + i * blockSize, job->n, job->r, job->v, job->y);
+#else
+        SCRYPT_ROMix(job->b + i * blockSize, job->n, job->r, job->v, job->y);
+#endif
+    }
+}
+
+#if defined(HITLS_BSL_SAL_THREAD) && defined(HITLS_BSL_SAL_LINUX)
+static void *SCRYPT_LaneWorker(void *arg)
+{
+    SCRYPT_MixJobLanes((const ScryptLaneJob *)arg);
+    return NULL;
+}
+
+// The lanes are dealt to threadNum jobs, the calling thread runs the first job and waits for the others.
+static void SCRYPT_MixLanesParallel(ScryptLaneJob *jobs, uint32_t threadNum)
+{
+    BSL_SAL_ThreadId thread[SCRYPT_MAX_THREAD_NUM] = {0};
+    for (uint32_t t = 1; t < threadNum; t++) {
+        if (BSL_SAL_ThreadCreate(&thread[t], SCRYPT_LaneWorker, &jobs[t]) != BSL_SUCCESS) {
+            thread[t] = NULL; // run by the calling thread below
+        }
+    }
+    SCRYPT_MixJobLanes(&jobs[0]);
+    for (uint32_t t = 1; t < threadNum; t++) {
+        if (thread[t] != NULL) {
+            BSL_SAL_ThreadClose(thread[t]);
+        } else {
+            SCRYPT_MixJobLanes(&jobs[t]);
+        }
+    }
+}
+#endif
+
+/*
+ * ROMix of the p lanes of b. Every job needs its own V and Y of blockSize * (n + 1) bytes, so threadNum is capped by
+ * p and SCRYPT_MAX_THREAD_NUM.
+ */
+static int32_t SCRYPT_MixLanes(uint8_t *b, uint32_t n, uint32_t r, uint32_t p, uint32_t threadNum)
+{
+    uint32_t blockSize = r << 7; // r * 128
+    uint32_t jobNum = (threadNum < p) ? threadNum : p;
+    jobNum = (jobNum == 0) ? 1 : jobNum;
+    if (blockSize * n > UINT32_MAX - blockSize) {
+        BSL_ERR_PUSH_ERROR(CRYPT_SCRYPT_DATA_TOO_MAX);
+        return CRYPT_SCRYPT_DATA_TOO_MAX;
+    }
+    uint32_t scratchLen = blockSize * n + blockSize;
+    // Fewer threads when the scratch of all of them does not fit.
+    jobNum = (jobNum > UINT32_MAX / scratchLen) ? (UINT32_MAX / scratchLen) : jobNum;
+    uint8_t *scratch = BSL_SAL_Malloc(scratchLen * jobNum);
+    if (scratch == NULL) {
+        BSL_ERR_PUSH_ERROR(CRYPT_MEM_ALLOC_FAIL);
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    ScryptLaneJob jobs[SCRYPT_MAX_THREAD_NUM];
+    for (uint32_t t = 0; t < jobNum; t++) {
+        jobs[t].b = b;
+        jobs[t].v = scratch + t * scratchLen;
+        jobs[t].y = jobs[t].v + blockSize * n;
+        jobs[t].n = n;
+        jobs[t].r = r;
+        jobs[t].p = p;
+        jobs[t].first = t;
+        jobs[t].step = jobNum;
+    }
+#if defined(HITLS_BSL_SAL_THREAD) && defined(HITLS_BSL_SAL_LINUX)
+    if (jobNum > 1) {
+        SCRYPT_MixLanesParallel(jobs, jobNum);
+    } else {
+        SCRYPT_MixJobLanes(&jobs[0]);
+    }
+#else
+    SCRYPT_MixJobLanes(&jobs[0]);
+#endif
+    BSL_SAL_ClearFree(scratch, scratchLen * jobNum);
+    return CRYPT_SUCCESS;
+}
 
 static int32_t SCRYPT_CheckParam(uint32_t n, uint32_t r, uint32_t p, const uint8_t *out, uint32_t len)
 {
@@ -254,9 +355,8 @@ int32_t CRYPT_SCRYPT(PBKDF2_PRF pbkdf2Prf, const EAL_MacMethod *macMeth,  CRYPT_
     uint32_t saltLen, uint32_t n, uint32_t r, uint32_t p, uint8_t *out, uint32_t len)
 {
     int32_t ret;
-    // V in ROMix and BlockMix is allocated here, reducing memory application and release costs
-    uint8_t *b = NULL, *v = NULL, *bi = NULL, *y = NULL;
-    uint32_t bLen, blockSize, sumLen;
+    uint8_t *b = NULL;
+    uint32_t bLen;
 
     if ((ret = SCRYPT_CheckParam(n, r, p, out, len)) != CRYPT_SUCCESS) {
         BSL_ERR_PUSH_ERROR(ret);
@@ -267,34 +367,19 @@ int32_t CRYPT_SCRYPT(PBKDF2_PRF pbkdf2Prf, const EAL_MacMethod *macMeth,  CRYPT_
         return ret;
     }
 
-    blockSize = r << 7; // block length: r << 7 (r * 128)
-    bLen = blockSize * p;
-
-    sumLen = bLen + blockSize * n + blockSize;
-    if (sumLen < bLen) {
-        BSL_ERR_PUSH_ERROR(CRYPT_SCRYPT_DATA_TOO_MAX);
-        return CRYPT_SCRYPT_DATA_TOO_MAX;
-    }
-    b = BSL_SAL_Malloc(sumLen);
+    bLen = (r << 7) * p; // block length: r << 7 (r * 128)
+    b = BSL_SAL_Malloc(bLen);
     if (b == NULL) {
         BSL_ERR_PUSH_ERROR(CRYPT_MEM_ALLOC_FAIL);
         return CRYPT_MEM_ALLOC_FAIL;
     }
 
-    v = b + bLen;
-    y = v + blockSize * n;
-
     GOTO_ERR_IF(pbkdf2Prf(macMeth, macId, mdMeth, key, keyLen, salt, saltLen, 1, b, bLen), ret);
-
-    bi = b;
-    for (uint32_t i = 0; i < p; i++, bi += blockSize) {
-        SCRYPT_ROMix(bi, n, r, v, y);
-    }
-
+    GOTO_ERR_IF(SCRYPT_MixLanes(b, n, r, p, 1), ret);
     GOTO_ERR_IF(pbkdf2Prf(macMeth, macId, mdMeth, key, keyLen, b, bLen, 1, out, len), ret);
 
 ERR:
-    BSL_SAL_FREE(b);
+    BSL_SAL_ClearFree(b, bLen);
 
     return ret;
 }
@@ -405,6 +490,22 @@ int32_t CRYPT_SCRYPT_SetP(CRYPT_SCRYPT_Ctx *ctx, const uint32_t p)
     return CRYPT_SUCCESS;
 }
 
+int32_t CRYPT_SCRYPT_SetThreadNum(CRYPT_SCRYPT_Ctx *ctx, const uint32_t threadNum)
+{
+    if (threadNum == 0 || threadNum > SCRYPT_MAX_THREAD_NUM) {
+        BSL_ERR_PUSH_ERROR(CRYPT_SCRYPT_PARAM_ERROR);
+        return CRYPT_SCRYPT_PARAM_ERROR;
+    }
+#if !defined(HITLS_BSL_SAL_THREAD) || !defined(HITLS_BSL_SAL_LINUX)
+    if (threadNum > 1) {
+        BSL_ERR_PUSH_ERROR(CRYPT_NOT_SUPPORT);
+        return CRYPT_NOT_SUPPORT;
+    }
+#endif
+    ctx->threadNum = threadNum;
+    return CRYPT_SUCCESS;
+}
+
 int32_t CRYPT_SCRYPT_SetParam(CRYPT_SCRYPT_Ctx *ctx, const BSL_Param *param)
 {
     uint32_t val = 0;
@@ -439,6 +540,12 @@ int32_t CRYPT_SCRYPT_SetParam(CRYPT_SCRYPT_Ctx *ctx, const BSL_Param *param)
             BSL_PARAM_TYPE_UINT32, &val, &len), ret);
         GOTO_ERR_IF(CRYPT_SCRYPT_SetP(ctx, val), ret);
     }
+    if ((temp = BSL_PARAM_FindConstParam(param, CRYPT_PARAM_KDF_THREAD_NUM)) != NULL) {
+        len = sizeof(val);
+        GOTO_ERR_IF(BSL_PARAM_GetValue(temp, CRYPT_PARAM_KDF_THREAD_NUM,
+            BSL_PARAM_TYPE_UINT32, &val, &len), ret);
+        GOTO_ERR_IF(CRYPT_SCRYPT_SetThreadNum(ctx, val), ret);
+    }
 ERR:
     return ret;
 }
@@ -447,8 +554,8 @@ int32_t CRYPT_SCRYPT_Derive(CRYPT_SCRYPT_Ctx *ctx, uint8_t *out, uint32_t len)
 {
     int32_t ret;
 
-    uint8_t *b = NULL, *v = NULL, *bi = NULL, *y = NULL;
-    uint32_t bLen, blockSize, sumLen;
+    uint8_t *b = NULL;
+    uint32_t bLen;
 
     const EAL_MacMethod *macMeth = ctx->macMeth;
     const EAL_MdMethod *mdMeth = ctx->mdMeth;
@@ -470,34 +577,19 @@ int32_t CRYPT_SCRYPT_Derive(CRYPT_SCRYPT_Ctx *ctx, uint8_t *out, uint32_t len)
         return ret;
     }
 
-    blockSize = r << 7;
-    bLen = blockSize * p;
-
-    sumLen = bLen + blockSize * n + blockSize;
-    if (sumLen < bLen) {
-        BSL_ERR_PUSH_ERROR(CRYPT_SCRYPT_DATA_TOO_MAX);
-        return CRYPT_SCRYPT_DATA_TOO_MAX;
-    }
-    b = BSL_SAL_Malloc(sumLen);
+    bLen = (r << 7) * p; // block length: r << 7 (r * 128)
+    b = BSL_SAL_Malloc(bLen);
     if (b == NULL) {
         BSL_ERR_PUSH_ERROR(CRYPT_MEM_ALLOC_FAIL);
         return CRYPT_MEM_ALLOC_FAIL;
     }
 
-    v = b + bLen;
-    y = v + blockSize * ctx->n;
-
     GOTO_ERR_IF(pbkdf2Prf(macMeth, CRYPT_MAC_HMAC_SHA256, mdMeth, password, passLen, salt, saltLen, 1, b, bLen), ret);
-
-    bi = b;
-    for (uint32_t i = 0; i < p; i++, bi += blockSize) {
-        SCRYPT_ROMix(bi, n, r, v, y);
-    }
-
+    GOTO_ERR_IF(SCRYPT_MixLanes(b, n, r, p, ctx->threadNum), ret);
     GOTO_ERR_IF(pbkdf2Prf(macMeth, CRYPT_MAC_HMAC_SHA256, mdMeth, password, passLen, b, bLen, 1, out, len), ret);
 
 ERR:
-    BSL_SAL_FREE(b);
+    BSL_SAL_ClearFree(b, bLen);
 
     return ret;
 }
@@ -0,0 +1,49 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#ifndef SCRYPT_LOCAL_H
+#define SCRYPT_LOCAL_H
+
+#include "hitls_build.h"
+#ifdef HITLS_CRYPTO_SCRYPT
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#if defined(__x86_64__)
+#define SCRYPT_ROMIX_SSE2
+
+/**
+ * @brief ROMix of RFC 7914 section 5 with an SSE2 Salsa20/8 core, SSE2 is always available on x86_64.
+ *
+ * @param b [IN/OUT] The 128 * r bytes block of one lane.
+ * @param n [IN] CPU/Memory cost parameter, a power of 2.
+ * @param r [IN] Block size parameter.
+ * @param v [IN] Scratch of 128 * r * n bytes.
+ * @param y [IN] Scratch of 128 * r bytes.
+ */
+void SCRYPT_ROMixSse2(uint8_t *b, uint32_t n, uint32_t r, uint8_t *v, uint8_t *y);
+#endif
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // HITLS_CRYPTO_SCRYPT
+
+#endif // SCRYPT_LOCAL_H
@@ -0,0 +1,165 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include "hitls_build.h"
+#if defined(HITLS_CRYPTO_SCRYPT) && defined(__x86_64__)
+
+#include <emmintrin.h>
+#include "securec.h"
+#include "crypt_utils.h"
+#include "scrypt_local.h"
+
+/*
+ * The 16 words of a 64-byte Salsa20 block are kept in four registers along the diagonals, so that the column and
+ * the row rounds both work on whole registers:
+ *     x[0]  x[5]  x[10] x[15]
+ *     x[4]  x[9]  x[14] x[3]
+ *     x[8]  x[13] x[2]  x[7]
+ *     x[12] x[1]  x[6]  x[11]
+ * ROMix converts its lane to this order once, the word x[0] used by Integerify stays in place.
+ */
+#define SCRYPT_ELEMENTSIZE 64
+#define SCRYPT_WORDS 16
+
+#define ROTL32X4(x, n) _mm_xor_si128(_mm_slli_epi32((x), (n)), _mm_srli_epi32((x), 32 - (n)))
+
+typedef struct {
+    __m128i x0;
+    __m128i x1;
+    __m128i x2;
+    __m128i x3;
+} SalsaState;
+
+// word i of the diagonal order is word (5 * i) % 16 of the block
+static void SalsaToDiagonal(uint8_t *blk)
+{
+    uint32_t w[SCRYPT_WORDS];
+    for (uint32_t i = 0; i < SCRYPT_WORDS; i++) {
+        w[i] = GET_UINT32_LE(blk, 4 * ((5 * i) % SCRYPT_WORDS)); // 4 bytes in a word
+    }
+    for (uint32_t i = 0; i < SCRYPT_WORDS; i++) {
+        PUT_UINT32_LE(w[i], blk, 4 * i); // 4 bytes in a word
+    }
+}
+
+static void SalsaFromDiagonal(uint8_t *blk)
+{
+    uint32_t w[SCRYPT_WORDS];
+    for (uint32_t i = 0; i < SCRYPT_WORDS; i++) {
+        w[(5 * i) % SCRYPT_WORDS] = GET_UINT32_LE(blk, 4 * i); // 4 bytes in a word
+    }
+    for (uint32_t i = 0; i < SCRYPT_WORDS; i++) {
+        PUT_UINT32_LE(w[i], blk, 4 * i); // 4 bytes in a word
+    }
+}
+
+// Salsa20/8 of RFC 7914 section 3, the input is added to the output.
+static inline void Salsa20Core8(SalsaState *s)
+{
+    __m128i x0 = s->x0;
+    __m128i x1 = s->x1;
+    __m128i x2 = s->x2;
+    __m128i x3 = s->x3;
+    for (uint32_t i = 0; i < 4; i++) { // 4 double rounds
+        // columns
+        x1 = _mm_xor_si128(x1, ROTL32X4(_mm_add_epi32(x0, x3), 7));
+        x2 = _mm_xor_si128(x2, ROTL32X4(_mm_add_epi32(x1, x0), 9));
+        x3 = _mm_xor_si128(x3, ROTL32X4(_mm_add_epi32(x2, x1), 13));
+        x0 = _mm_xor_si128(x0, ROTL32X4(_mm_add_epi32(x3, x2), 18));
+        x1 = _mm_shuffle_epi32(x1, 0x93);
+        x2 = _mm_shuffle_epi32(x2, 0x4E);
+        x3 = _mm_shuffle_epi32(x3, 0x39);
+        // rows
+        x3 = _mm_xor_si128(x3, ROTL32X4(_mm_add_epi32(x0, x1), 7));
+        x2 = _mm_xor_si128(x2, ROTL32X4(_mm_add_epi32(x3, x0), 9));
+        x1 = _mm_xor_si128(x1, ROTL32X4(_mm_add_epi32(x2, x3), 13));
+        x0 = _mm_xor_si128(x0, ROTL32X4(_mm_add_epi32(x1, x2), 18));
+        x1 = _mm_shuffle_epi32(x1, 0x39);
+        x2 = _mm_shuffle_epi32(x2, 0x4E);
+        x3 = _mm_shuffle_epi32(x3, 0x93);
+    }
+    s->x0 = _mm_add_epi32(s->x0, x0);
+    s->x1 = _mm_add_epi32(s->x1, x1);
+    s->x2 = _mm_add_epi32(s->x2, x2);
+    s->x3 = _mm_add_epi32(s->x3, x3);
+}
+
+static inline void SalsaXorLoad(SalsaState *s, const uint8_t *in)
+{
+    s->x0 = _mm_xor_si128(s->x0, _mm_loadu_si128((const __m128i *)(uintptr_t)in));
+    s->x1 = _mm_xor_si128(s->x1, _mm_loadu_si128((const __m128i *)(uintptr_t)(in + 16)));
+    s->x2 = _mm_xor_si128(s->x2, _mm_loadu_si128((const __m128i *)(uintptr_t)(in + 32)));
+    s->x3 = _mm_xor_si128(s->x3, _mm_loadu_si128((const __m128i *)(uintptr_t)(in + 48)));
+}
+
+static inline void SalsaStore(const SalsaState *s, uint8_t *out)
+{
+    _mm_storeu_si128((__m128i *)(uintptr_t)out, s->x0);
+    _mm_storeu_si128((__m128i *)(uintptr_t)(out + 16), s->x1);
+    _mm_storeu_si128((__m128i *)(uintptr_t)(out + 32), s->x2);
+    _mm_storeu_si128((__m128i *)(uintptr_t)(out + 48), s->x3);
+}
+
+/*
+ * BlockMix of RFC 7914 section 4 from in ^ inXor to out, inXor can be NULL. The even blocks of Y go to the first half
+ * of out and the odd ones to the second half.
+ */
+static void BlockMixSse2(const uint8_t *in, const uint8_t *inXor, uint8_t *out, uint32_t r)
+{
+    uint32_t last = ((r << 1) - 1) * SCRYPT_ELEMENTSIZE;
+    SalsaState s = {_mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128()};
+    SalsaXorLoad(&s, in + last);
+    if (inXor != NULL) {
+        SalsaXorLoad(&s, inXor + last);
+    }
+    for (uint32_t i = 0; i < (r << 1); i++) {
+        SalsaXorLoad(&s, in + i * SCRYPT_ELEMENTSIZE);
+        if (inXor != NULL) {
+            SalsaXorLoad(&s, inXor + i * SCRYPT_ELEMENTSIZE);
+        }
+        Salsa20Core8(&s);
+        SalsaStore(&s, out + (((i & 1) * r) + (i >> 1)) * SCRYPT_ELEMENTSIZE);
+    }
+}
+
+// j = Integerify(X) mod n, the word x[0] of the last 64-byte element.
+static inline uint32_t Integerify(const uint8_t *x, uint32_t r, uint32_t n)
+{
+    return GET_UINT32_LE(x, ((r << 1) - 1) * SCRYPT_ELEMENTSIZE) & (n - 1);
+}
+
+void SCRYPT_ROMixSse2(uint8_t *b, uint32_t n, uint32_t r, uint8_t *v, uint8_t *y)
+{
+    uint32_t blockSize = r << 7; // r * 128
+    for (uint32_t i = 0; i < (r << 1); i++) {
+        SalsaToDiagonal(b + i * SCRYPT_ELEMENTSIZE);
+    }
+    // V[i + 1] = BlockMix(V[i]) is written in place, instead of copying X to V at every step.
+    (void)memcpy_s(v, blockSize, b, blockSize);
+    for (uint32_t i = 0; i + 1 < n; i++) {
+        BlockMixSse2(v + i * blockSize, NULL, v + (i + 1) * blockSize, r);
+    }
+    BlockMixSse2(v + (n - 1) * blockSize, NULL, b, r);
+    // n is a power of 2 greater than 1, so the steps go in pairs, between b and y.
+    for (uint32_t i = 0; i < n; i += 2) {
+        BlockMixSse2(b, v + Integerify(b, r, n) * blockSize, y, r);
+        BlockMixSse2(y, v + Integerify(y, r, n) * blockSize, b, r);
+    }
+    for (uint32_t i = 0; i < (r << 1); i++) {
+        SalsaFromDiagonal(b + i * SCRYPT_ELEMENTSIZE);
+    }
+}
+
+#endif // HITLS_CRYPTO_SCRYPT && __x86_64__
@@ -20,6 +20,7 @@
 #ifdef HITLS_CRYPTO_SHA2
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include "crypt_types.h"
 #include "bsl_params.h"
@@ -502,6 +503,54 @@ int32_t CRYPT_SHA2_256_CopyCtx(CRYPT_SHA2_256_Ctx *dst, const CRYPT_SHA2_256_Ctx
  * @param src [in]   Pointer to the original SHA256 context.
  */
 CRYPT_SHA2_256_Ctx *CRYPT_SHA2_256_DupCtx(const CRYPT_SHA2_256_Ctx *src);
+
+/* Eight SHA256 instances computed in parallel */
+#define CRYPT_SHA2_256_X8_LANES 8
+
+/**
+ * @ingroup SHA256
+ * @brief Hash num inputs of inLen bytes, eight inputs at a time.
+ * @param prefix [in]   NULL, or the context every input continues, it must have absorbed whole blocks only.
+ * @param in [in]       num inputs of inLen bytes.
+ * @param out [out]     out[j] receives the first outLen bytes of the digest of in[j].
+ * @param outLen [in]   No more than CRYPT_SHA2_256_DIGESTSIZE.
+ * @param num [in]      Number of inputs.
+ */
+int32_t CRYPT_SHA2_256_Batch(const CRYPT_SHA2_256_Ctx *prefix, const uint8_t *const in[], uint32_t inLen,
+    uint8_t *const out[], uint32_t outLen, uint32_t num);
+
+/**
+ * @ingroup SHA256
+ * @brief Obtain the chaining value of a context, such as the midstate after an HMAC pad block.
+ * @param ctx [in]      The context, it must have absorbed whole blocks only.
+ * @param state [out]   The eight words of the chaining value.
+ */
+int32_t CRYPT_SHA2_256_GetState(const CRYPT_SHA2_256_Ctx *ctx, uint32_t state[8]);
+
+/**
+ * @ingroup SHA256
+ * @brief Compress whole blocks into a chaining value, the caller is in charge of the padding.
+ * @param state [in/out]  The eight words of the chaining value.
+ * @param in [in]         blockNum blocks.
+ * @param blockNum [in]   Number of blocks.
+ */
+void CRYPT_SHA2_256_Compress(uint32_t state[8], const uint8_t *in, uint32_t blockNum);
+
+/**
+ * @ingroup SHA256
+ * @brief CRYPT_SHA2_256_Compress of CRYPT_SHA2_256_X8_LANES chaining values at a time.
+ * @param state [in/out]  Word i of the chaining value j is state[i * CRYPT_SHA2_256_X8_LANES + j].
+ * @param in [in]         in[j] holds the blockNum blocks of the chaining value j.
+ * @param blockNum [in]   Number of blocks.
+ */
+void CRYPT_SHA2_256_CompressX8(uint32_t *state, const uint8_t *const in[], uint32_t blockNum);
+
+/**
+ * @ingroup SHA256
+ * @brief Whether CRYPT_SHA2_256_CompressX8 runs on the avx2 kernel. Otherwise it runs on generic code, which is
+ *        slower than CRYPT_SHA2_256_Compress of the chaining values one by one.
+ */
+bool CRYPT_SHA2_256_CompressX8IsFast(void);
 #endif // HITLS_CRYPTO_SHA256
 
 #ifdef HITLS_CRYPTO_SHA384
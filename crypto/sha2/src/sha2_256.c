@@ -269,6 +269,126 @@ int32_t CRYPT_SHA2_256_Final(CRYPT_SHA2_256_Ctx *ctx, uint8_t *digest, uint32_t
     return CRYPT_SUCCESS;
 }
 
+static int32_t BatchParamIsValid(const CRYPT_SHA2_256_Ctx *prefix, const uint8_t *const in[], uint8_t *const out[],
+    uint32_t outLen)
+{
+    if (in == NULL || out == NULL) {
+        BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
+        return CRYPT_NULL_INPUT;
+    }
+    if (outLen > CRYPT_SHA2_256_DIGESTSIZE || (prefix != NULL && prefix->blocklen != 0)) {
+        BSL_ERR_PUSH_ERROR(CRYPT_INVALID_ARG);
+        return CRYPT_INVALID_ARG;
+    }
+    if (prefix != NULL && prefix->errorCode != CRYPT_SUCCESS) {
+        BSL_ERR_PUSH_ERROR(CRYPT_SHA2_INPUT_OVERFLOW);
+        return CRYPT_SHA2_INPUT_OVERFLOW;
+    }
+    return CRYPT_SUCCESS;
+}
+
+// Pad the last left bytes of the input like CRYPT_SHA2_256_Final, return the number of padded blocks.
+static uint32_t BatchPadTail(uint8_t tail[2 * CRYPT_SHA2_256_BLOCKSIZE], const uint8_t *in, uint32_t left,
+    uint64_t bits)
+{
+    uint32_t blockNum = (left + 9 > CRYPT_SHA2_256_BLOCKSIZE) ? 2 : 1; // 9: the byte 0x80 and the 8 bytes length
+    uint32_t lenPos = blockNum * CRYPT_SHA2_256_BLOCKSIZE - 8;       // 8 bytes to save bits of input
+    (void)memset_s(tail, 2 * CRYPT_SHA2_256_BLOCKSIZE, 0, 2 * CRYPT_SHA2_256_BLOCKSIZE);
+    if (left != 0) {
+        (void)memcpy_s(tail, 2 * CRYPT_SHA2_256_BLOCKSIZE, in, left);
+    }
+    tail[left] = 0x80;
+    PUT_UINT32_BE((uint32_t)(bits >> 32), tail, lenPos);                // the high 32 bits
+    PUT_UINT32_BE((uint32_t)bits, tail, lenPos + sizeof(uint32_t));     // the low 32 bits
+    return blockNum;
+}
+
+// The lanes left over in the last round repeat the first input and are dropped.
+int32_t CRYPT_SHA2_256_Batch(const CRYPT_SHA2_256_Ctx *prefix, const uint8_t *const in[], uint32_t inLen,
+    uint8_t *const out[], uint32_t outLen, uint32_t num)
+{
+    int32_t ret = BatchParamIsValid(prefix, in, out, outLen);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    CRYPT_SHA2_256_Ctx start;
+    if (prefix == NULL) {
+        (void)CRYPT_SHA2_256_Init(&start, NULL);
+    } else {
+        (void)memcpy_s(&start, sizeof(start), prefix, sizeof(start));
+    }
+    ret = CheckIsCorrupted(&start, inLen);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    uint64_t bits = ((uint64_t)start.hNum << 32) | start.lNum;
+    uint32_t fullNum = inLen / CRYPT_SHA2_256_BLOCKSIZE;
+    uint32_t left = inLen % CRYPT_SHA2_256_BLOCKSIZE;
+    uint32_t state[CRYPT_SHA2_256_X8_LANES * 8]; // 8 words of every lane
+    uint8_t tail[CRYPT_SHA2_256_X8_LANES][2 * CRYPT_SHA2_256_BLOCKSIZE];
+    uint8_t digest[CRYPT_SHA2_256_DIGESTSIZE];
+    for (uint32_t done = 0; done < num; done += CRYPT_SHA2_256_X8_LANES) {
+        uint32_t lanes = (num - done < CRYPT_SHA2_256_X8_LANES) ? (num - done) : CRYPT_SHA2_256_X8_LANES;
+        const uint8_t *laneIn[CRYPT_SHA2_256_X8_LANES];
+        const uint8_t *laneTail[CRYPT_SHA2_256_X8_LANES];
+        uint32_t tailNum = 0;
+        for (uint32_t j = 0; j < CRYPT_SHA2_256_X8_LANES; j++) {
+            uint32_t idx = done + ((j < lanes) ? j : 0);
+            if ((in[idx] == NULL && inLen != 0) || out[idx] == NULL) {
+                BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
+                return CRYPT_NULL_INPUT;
+            }
+            for (uint32_t i = 0; i < 8; i++) { // 8 words of the state
+                state[i * CRYPT_SHA2_256_X8_LANES + j] = start.h[i];
+            }
+            laneIn[j] = in[idx];
+            laneTail[j] = tail[(j < lanes) ? j : 0];
+            if (j < lanes) {
+                tailNum = BatchPadTail(tail[j], in[idx] + fullNum * CRYPT_SHA2_256_BLOCKSIZE, left, bits);
+            }
+        }
+        if (fullNum != 0) {
+            SHA256CompressX8(state, laneIn, fullNum);
+        }
+        SHA256CompressX8(state, laneTail, tailNum);
+        for (uint32_t j = 0; j < lanes; j++) {
+            for (uint32_t i = 0; i < 8; i++) { // 8 words of the state
+                PUT_UINT32_BE(state[i * CRYPT_SHA2_256_X8_LANES + j], digest, sizeof(uint32_t) * i);
+            }
+            (void)memcpy_s(out[done + j], outLen, digest, outLen);
+        }
+    }
+    BSL_SAL_CleanseData(state, sizeof(state));
+    BSL_SAL_CleanseData(tail, sizeof(tail));
+    BSL_SAL_CleanseData(digest, sizeof(digest));
+    BSL_SAL_CleanseData(&start, sizeof(start));
+    return CRYPT_SUCCESS;
+}
+
+int32_t CRYPT_SHA2_256_GetState(const CRYPT_SHA2_256_Ctx *ctx, uint32_t state[8])
+{
+    if (ctx == NULL || state == NULL) {
+        BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
+        return CRYPT_NULL_INPUT;
+    }
+    if (ctx->blocklen != 0) {
+        BSL_ERR_PUSH_ERROR(CRYPT_INVALID_ARG);
+        return CRYPT_INVALID_ARG;
+    }
+    (void)memcpy_s(state, sizeof(ctx->h), ctx->h, sizeof(ctx->h));
+    return CRYPT_SUCCESS;
+}
+
+void CRYPT_SHA2_256_Compress(uint32_t state[8], const uint8_t *in, uint32_t blockNum)
+{
+    SHA256CompressMultiBlocks(state, in, blockNum);
+}
+
+void CRYPT_SHA2_256_CompressX8(uint32_t *state, const uint8_t *const in[], uint32_t blockNum)
+{
+    SHA256CompressX8(state, in, blockNum);
+}
+
 #ifdef HITLS_CRYPTO_SHA224
 
 
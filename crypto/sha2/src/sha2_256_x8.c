@@ -0,0 +1,155 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include "hitls_build.h"
+#ifdef HITLS_CRYPTO_SHA256
+
+#include "securec.h"
+#include "crypt_utils.h"
+#include "crypt_sha2.h"
+#include "sha2_core.h"
+
+#define SHA256_WORD_NUM 8
+#define SHA256_ROUND_NUM 64
+
+#if defined(__GNUC__) || defined(__clang__)
+// One vector holds the same word of the eight states, so that every operation of a round processes eight blocks.
+typedef uint32_t Sha256Lanes __attribute__((vector_size(4 * CRYPT_SHA2_256_X8_LANES)));
+#define SHA256_X8_VECTOR
+#define SHA256_X8_INLINE static inline __attribute__((always_inline))
+#else
+typedef uint32_t Sha256Lanes;
+#define SHA256_X8_INLINE static inline
+#endif
+
+static const uint32_t g_k256X8[SHA256_ROUND_NUM] = {
+    0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+    0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+    0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+    0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+    0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+    0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+    0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+    0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL,
+};
+
+#define ROTR32X8(x, n) (((x) >> (n)) | ((x) << (32 - (n)))) // 0 < n < 32
+
+// RFC 6234 section 5.1, the functions of SHA-224 and SHA-256
+#define BSIG0X8(x) (ROTR32X8((x), 2) ^ ROTR32X8((x), 13) ^ ROTR32X8((x), 22))
+#define BSIG1X8(x) (ROTR32X8((x), 6) ^ ROTR32X8((x), 11) ^ ROTR32X8((x), 25))
+#define SSIG0X8(x) (ROTR32X8((x), 7) ^ ROTR32X8((x), 18) ^ ((x) >> 3))
+#define SSIG1X8(x) (ROTR32X8((x), 17) ^ ROTR32X8((x), 19) ^ ((x) >> 10))
+
+// RFC 6234 section 6.2, w[0..15] holds the block and state[i] is word i of H(i-1).
+SHA256_X8_INLINE void Sha256LanesBlock(Sha256Lanes *state, Sha256Lanes *w)
+{
+    for (uint32_t t = 16; t < SHA256_ROUND_NUM; t++) { // w[0..15] is the block
+        w[t] = SSIG1X8(w[t - 2]) + w[t - 7] + SSIG0X8(w[t - 15]) + w[t - 16];
+    }
+    Sha256Lanes a = state[0];
+    Sha256Lanes b = state[1];
+    Sha256Lanes c = state[2];
+    Sha256Lanes d = state[3];
+    Sha256Lanes e = state[4];
+    Sha256Lanes f = state[5];
+    Sha256Lanes g = state[6];
+    Sha256Lanes h = state[7];
+    for (uint32_t t = 0; t < SHA256_ROUND_NUM; t++) {
+        Sha256Lanes t1 = h + BSIG1X8(e) + (g ^ (e & (f ^ g))) + g_k256X8[t] + w[t];
+        Sha256Lanes t2 = BSIG0X8(a) + ((a & (b | c)) | (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+SHA256_X8_INLINE void Sha256X8Blocks(uint32_t *state, const uint8_t *const in[], uint32_t blockNum)
+{
+    Sha256Lanes st[SHA256_WORD_NUM];
+    Sha256Lanes w[SHA256_ROUND_NUM];
+#ifdef SHA256_X8_VECTOR
+    (void)memcpy_s(st, sizeof(st), state, sizeof(st));
+    for (uint32_t b = 0; b < blockNum; b++) {
+        for (uint32_t t = 0; t < 16; t++) { // 16 words in a block
+            for (uint32_t j = 0; j < CRYPT_SHA2_256_X8_LANES; j++) {
+                w[t][j] = GET_UINT32_BE(in[j], b * CRYPT_SHA2_256_BLOCKSIZE + 4 * t); // 4 bytes in a word
+            }
+        }
+        Sha256LanesBlock(st, w);
+    }
+    (void)memcpy_s(state, sizeof(st), st, sizeof(st));
+#else
+    for (uint32_t j = 0; j < CRYPT_SHA2_256_X8_LANES; j++) {
+        for (uint32_t i = 0; i < SHA256_WORD_NUM; i++) {
+            st[i] = state[i * CRYPT_SHA2_256_X8_LANES + j];
+        }
+        for (uint32_t b = 0; b < blockNum; b++) {
+            for (uint32_t t = 0; t < 16; t++) { // 16 words in a block
+                w[t] = GET_UINT32_BE(in[j], b * CRYPT_SHA2_256_BLOCKSIZE + 4 * t); // 4 bytes in a word
+            }
+            Sha256LanesBlock(st, w);
+        }
+        for (uint32_t i = 0; i < SHA256_WORD_NUM; i++) {
+            state[i * CRYPT_SHA2_256_X8_LANES + j] = st[i];
+        }
+    }
+#endif
+}
+
+#if defined(SHA256_X8_VECTOR) && defined(__x86_64__) && defined(HITLS_CRYPTO_EALINIT)
+// A 256-bit register holds the eight lanes of one word. It is used when the cpu capability obtained by
+// CRYPT_EAL_Init supports avx2.
+__attribute__((target("avx2"))) static void Sha256X8Avx2(uint32_t *state, const uint8_t *const in[],
+    uint32_t blockNum)
+{
+    Sha256X8Blocks(state, in, blockNum);
+}
+#endif
+
+bool CRYPT_SHA2_256_CompressX8IsFast(void)
+{
+#if defined(SHA256_X8_VECTOR) && defined(__x86_64__) && defined(HITLS_CRYPTO_EALINIT)
+    return IsSupportAVX() && IsOSSupportAVX() && IsSupportAVX2();
+#else
+    return false;
+#endif
+}
+
+void SHA256CompressX8(uint32_t *state, const uint8_t *const in[], uint32_t blockNum)
+{
+#if defined(SHA256_X8_VECTOR) && defined(__x86_64__) && defined(HITLS_CRYPTO_EALINIT)
+    if (CRYPT_SHA2_256_CompressX8IsFast()) {
+        Sha256X8Avx2(state, in, blockNum);
+        return;
+    }
+#endif
+    Sha256X8Blocks(state, in, blockNum);
+}
+
+#endif // HITLS_CRYPTO_SHA256
@@ -28,6 +28,9 @@ extern "C" {
 
 #ifdef HITLS_CRYPTO_SHA256
 void SHA256CompressMultiBlocks(uint32_t hash[8], const uint8_t *in, uint32_t num);
+
+// Compress blockNum blocks of in[j] into lane j, word i of lane j is state[i * CRYPT_SHA2_256_X8_LANES + j].
+void SHA256CompressX8(uint32_t *state, const uint8_t *const in[], uint32_t blockNum);
 #endif
 
 #ifdef HITLS_CRYPTO_SHA512
@@ -57,6 +57,14 @@ extern "C" {
 
 typedef struct CryptSha3Ctx CRYPT_SHA3_Ctx;
 
+/* Four SHAKE instances computed in parallel */
+#define CRYPT_SHAKE_X4_LANES 4
+
+typedef struct {
+    uint64_t state[25 * CRYPT_SHAKE_X4_LANES]; // The states are interleaved, word w of instance j is state[w * 4 + j]
+    uint32_t blockSize;
+} CRYPT_SHAKE_X4_Ctx;
+
 typedef CRYPT_SHA3_Ctx CRYPT_SHA3_224_Ctx;
 
 typedef CRYPT_SHA3_Ctx CRYPT_SHA3_256_Ctx;
@@ -122,6 +130,19 @@ int32_t CRYPT_SHAKE256_Final(CRYPT_SHAKE256_Ctx *ctx, uint8_t *out, uint32_t *le
 int32_t CRYPT_SHAKE128_Squeeze(CRYPT_SHAKE128_Ctx *ctx, uint8_t *out, uint32_t len);
 int32_t CRYPT_SHAKE256_Squeeze(CRYPT_SHAKE256_Ctx *ctx, uint8_t *out, uint32_t len);
 
+// Start four instances, absorb the four inputs of inLen bytes and pad them. The output is read block by block.
+int32_t CRYPT_SHAKE128_X4Absorb(CRYPT_SHAKE_X4_Ctx *ctx, const uint8_t *const in[], uint32_t inLen);
+int32_t CRYPT_SHAKE256_X4Absorb(CRYPT_SHAKE_X4_Ctx *ctx, const uint8_t *const in[], uint32_t inLen);
+
+// Squeeze blockNum blocks from every instance, out[j] receives blockNum * blockSize bytes of instance j.
+int32_t CRYPT_SHAKE_X4SqueezeBlocks(CRYPT_SHAKE_X4_Ctx *ctx, uint8_t *const out[], uint32_t blockNum);
+
+// Hash num inputs of inLen bytes into num outputs of outLen bytes, four inputs at a time.
+int32_t CRYPT_SHAKE128_Batch(const uint8_t *const in[], uint32_t inLen, uint8_t *const out[], uint32_t outLen,
+    uint32_t num);
+int32_t CRYPT_SHAKE256_Batch(const uint8_t *const in[], uint32_t inLen, uint8_t *const out[], uint32_t outLen,
+    uint32_t num);
+
 // Clear the context
 void CRYPT_SHA3_224_Deinit(CRYPT_SHA3_224_Ctx *ctx);
 
@@ -0,0 +1,332 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include "hitls_build.h"
+#ifdef HITLS_CRYPTO_SHA3
+
+#include <stdlib.h>
+#include "securec.h"
+#include "crypt_errno.h"
+#include "crypt_utils.h"
+#include "bsl_err_internal.h"
+#include "bsl_sal.h"
+#include "crypt_sha3.h"
+
+#define KECCAK_WORD_NUM 25
+#define SHAKE_PAD_CHR 0x1f
+
+#if defined(__GNUC__) || defined(__clang__)
+// One vector holds the same word of the four states, so that every operation of a round processes four states.
+typedef uint64_t KeccakLanes __attribute__((vector_size(8 * CRYPT_SHAKE_X4_LANES)));
+#define KECCAK_X4_VECTOR
+#define KECCAK_X4_INLINE static inline __attribute__((always_inline))
+#else
+typedef uint64_t KeccakLanes;
+#define KECCAK_X4_INLINE static inline
+#endif
+
+// The shift count is masked, so that ROL64X4(a, 0) is a instead of an undefined shift.
+#define ROL64X4(a, offset) (((a) << (offset)) ^ ((a) >> ((64 - (offset)) & 63)))
+
+// the rotation offsets, see https://keccak.team/keccak_specs_summary.html
+static const uint8_t g_rotationOffsetX4[5][5] = {
+    {  0,  1, 62, 28, 27 },
+    { 36, 44,  6, 55, 20 },
+    {  3, 10, 43, 25, 39 },
+    { 41, 45, 15, 21,  8 },
+    { 18,  2, 61, 56, 14 }
+};
+
+// the round constants, see https://keccak.team/keccak_specs_summary.html
+static const uint64_t g_roundConstantX4[24] = {
+    (uint64_t)0x0000000000000001, (uint64_t)0x0000000000008082,
+    (uint64_t)0x800000000000808a, (uint64_t)0x8000000080008000,
+    (uint64_t)0x000000000000808b, (uint64_t)0x0000000080000001,
+    (uint64_t)0x8000000080008081, (uint64_t)0x8000000000008009,
+    (uint64_t)0x000000000000008a, (uint64_t)0x0000000000000088,
+    (uint64_t)0x0000000080008009, (uint64_t)0x000000008000000a,
+    (uint64_t)0x000000008000808b, (uint64_t)0x800000000000008b,
+    (uint64_t)0x8000000000008089, (uint64_t)0x8000000000008003,
+    (uint64_t)0x8000000000008002, (uint64_t)0x8000000000000080,
+    (uint64_t)0x000000000000800a, (uint64_t)0x800000008000000a,
+    (uint64_t)0x8000000080008081, (uint64_t)0x8000000000008080,
+    (uint64_t)0x0000000080000001, (uint64_t)0x8000000080008008
+};
+
+// The same round as noasm_sha3.c, see section 2.4 Algorithm 1 in
+// https://keccak.team/files/Keccak-implementation-3.2.pdf
+KECCAK_X4_INLINE void RoundX4(const KeccakLanes *a, KeccakLanes *e, uint32_t i)
+{
+    KeccakLanes c[5], d[5];
+
+    // THETA operation
+    c[0] = a[0] ^ a[5] ^ a[10] ^ a[15] ^ a[20];
+    c[1] = a[1] ^ a[6] ^ a[11] ^ a[16] ^ a[21];
+    c[2] = a[2] ^ a[7] ^ a[12] ^ a[17] ^ a[22];
+    c[3] = a[3] ^ a[8] ^ a[13] ^ a[18] ^ a[23];
+    c[4] = a[4] ^ a[9] ^ a[14] ^ a[19] ^ a[24];
+
+    d[0] = ROL64X4(c[1], 1) ^ c[4];
+    d[1] = ROL64X4(c[2], 1) ^ c[0];
+    d[2] = ROL64X4(c[3], 1) ^ c[1];
+    d[3] = ROL64X4(c[4], 1) ^ c[2];
+    d[4] = ROL64X4(c[0], 1) ^ c[3];
+
+    // THETA RHO PI CHI IOTA operation
+    c[0] =         a[0]  ^ d[0];
+    c[1] = ROL64X4(a[6]  ^ d[1], g_rotationOffsetX4[1][1]);
+    c[2] = ROL64X4(a[12] ^ d[2], g_rotationOffsetX4[2][2]);
+    c[3] = ROL64X4(a[18] ^ d[3], g_rotationOffsetX4[3][3]);
+    c[4] = ROL64X4(a[24] ^ d[4], g_rotationOffsetX4[4][4]);
+    e[0] = c[0] ^ (~c[1] & c[2]) ^ g_roundConstantX4[i];
+    e[1] = c[1] ^ (~c[2] & c[3]);
+    e[2] = c[2] ^ (~c[3] & c[4]);
+    e[3] = c[3] ^ (~c[4] & c[0]);
+    e[4] = c[4] ^ (~c[0] & c[1]);
+
+    // THETA RHO PI CHI operation
+    c[0] = ROL64X4(a[3] ^ d[3], g_rotationOffsetX4[0][3]);
+    c[1] = ROL64X4(a[9] ^ d[4], g_rotationOffsetX4[1][4]);
+    c[2] = ROL64X4(a[10] ^ d[0], g_rotationOffsetX4[2][0]);
+    c[3] = ROL64X4(a[16] ^ d[1], g_rotationOffsetX4[3][1]);
+    c[4] = ROL64X4(a[22] ^ d[2], g_rotationOffsetX4[4][2]);
+    e[5] = c[0] ^ (~c[1] & c[2]);
+    e[6] = c[1] ^ (~c[2] & c[3]);
+    e[7] = c[2] ^ (~c[3] & c[4]);
+    e[8] = c[3] ^ (~c[4] & c[0]);
+    e[9] = c[4] ^ (~c[0] & c[1]);
+
+    c[0] = ROL64X4(a[1] ^ d[1], g_rotationOffsetX4[0][1]);
+    c[1] = ROL64X4(a[7] ^ d[2], g_rotationOffsetX4[1][2]);
+    c[2] = ROL64X4(a[13] ^ d[3], g_rotationOffsetX4[2][3]);
+    c[3] = ROL64X4(a[19] ^ d[4], g_rotationOffsetX4[3][4]);
+    c[4] = ROL64X4(a[20] ^ d[0], g_rotationOffsetX4[4][0]);
+    e[10] = c[0] ^ (~c[1] & c[2]);
+    e[11] = c[1] ^ (~c[2] & c[3]);
+    e[12] = c[2] ^ (~c[3] & c[4]);
+    e[13] = c[3] ^ (~c[4] & c[0]);
+    e[14] = c[4] ^ (~c[0] & c[1]);
+
+    c[0] = ROL64X4(a[4] ^ d[4], g_rotationOffsetX4[0][4]);
+    c[1] = ROL64X4(a[5] ^ d[0], g_rotationOffsetX4[1][0]);
+    c[2] = ROL64X4(a[11] ^ d[1], g_rotationOffsetX4[2][1]);
+    c[3] = ROL64X4(a[17] ^ d[2], g_rotationOffsetX4[3][2]);
+    c[4] = ROL64X4(a[23] ^ d[3], g_rotationOffsetX4[4][3]);
+    e[15] = c[0] ^ (~c[1] & c[2]);
+    e[16] = c[1] ^ (~c[2] & c[3]);
+    e[17] = c[2] ^ (~c[3] & c[4]);
+    e[18] = c[3] ^ (~c[4] & c[0]);
+    e[19] = c[4] ^ (~c[0] & c[1]);
+
+    c[0] = ROL64X4(a[2] ^ d[2], g_rotationOffsetX4[0][2]);
+    c[1] = ROL64X4(a[8] ^ d[3], g_rotationOffsetX4[1][3]);
+    c[2] = ROL64X4(a[14] ^ d[4], g_rotationOffsetX4[2][4]);
+    c[3] = ROL64X4(a[15] ^ d[0], g_rotationOffsetX4[3][0]);
+    c[4] = ROL64X4(a[21] ^ d[1], g_rotationOffsetX4[4][1]);
+    e[20] = c[0] ^ (~c[1] & c[2]);
+    e[21] = c[1] ^ (~c[2] & c[3]);
+    e[22] = c[2] ^ (~c[3] & c[4]);
+    e[23] = c[3] ^ (~c[4] & c[0]);
+    e[24] = c[4] ^ (~c[0] & c[1]);
+}
+
+KECCAK_X4_INLINE void KeccakLanesRounds(KeccakLanes *a)
+{
+    KeccakLanes e[KECCAK_WORD_NUM];
+    for (uint32_t i = 0; i < 24; i += 2) {
+        RoundX4(a, e, i);
+        RoundX4(e, a, i + 1);
+    }
+}
+
+// Keccak-p[1600, 24] on the four interleaved states, the word w of the state j is state[w * 4 + j].
+KECCAK_X4_INLINE void KeccakX4Rounds(uint64_t *state)
+{
+    KeccakLanes a[KECCAK_WORD_NUM];
+#ifdef KECCAK_X4_VECTOR
+    (void)memcpy_s(a, sizeof(a), state, sizeof(a));
+    KeccakLanesRounds(a);
+    (void)memcpy_s(state, sizeof(a), a, sizeof(a));
+#else
+    for (uint32_t j = 0; j < CRYPT_SHAKE_X4_LANES; j++) {
+        for (uint32_t w = 0; w < KECCAK_WORD_NUM; w++) {
+            a[w] = state[w * CRYPT_SHAKE_X4_LANES + j];
+        }
+        KeccakLanesRounds(a);
+        for (uint32_t w = 0; w < KECCAK_WORD_NUM; w++) {
+            state[w * CRYPT_SHAKE_X4_LANES + j] = a[w];
+        }
+    }
+#endif
+}
+
+#if defined(KECCAK_X4_VECTOR) && defined(__x86_64__) && defined(HITLS_CRYPTO_EALINIT)
+// A 256-bit register holds the four lanes of one word. It is used when the cpu capability obtained by
+// CRYPT_EAL_Init supports avx2.
+__attribute__((target("avx2"))) static void KeccakX4Avx2(uint64_t *state)
+{
+    KeccakX4Rounds(state);
+}
+#endif
+
+static void KeccakX4(uint64_t *state)
+{
+#if defined(KECCAK_X4_VECTOR) && defined(__x86_64__) && defined(HITLS_CRYPTO_EALINIT)
+    if (IsSupportAVX() && IsOSSupportAVX() && IsSupportAVX2()) {
+        KeccakX4Avx2(state);
+        return;
+    }
+#endif
+    KeccakX4Rounds(state);
+}
+
+static void XorBlockX4(uint64_t *state, const uint8_t *const in[], uint32_t offset, uint32_t blockInWord)
+{
+    for (uint32_t w = 0; w < blockInWord; w++) {
+        for (uint32_t j = 0; j < CRYPT_SHAKE_X4_LANES; j++) {
+            state[w * CRYPT_SHAKE_X4_LANES + j] ^= GET_UINT64_LE(in[j], offset + (w << 3));
+        }
+    }
+}
+
+static int32_t ShakeX4Absorb(CRYPT_SHAKE_X4_Ctx *ctx, const uint8_t *const in[], uint32_t inLen, uint32_t blockSize)
+{
+    if (ctx == NULL || in == NULL) {
+        BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
+        return CRYPT_NULL_INPUT;
+    }
+    for (uint32_t j = 0; j < CRYPT_SHAKE_X4_LANES; j++) {
+        if (in[j] == NULL && inLen != 0) {
+            BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
+            return CRYPT_NULL_INPUT;
+        }
+    }
+    uint32_t blockInWord = blockSize / 8;
+    uint32_t offset = 0;
+    (void)memset_s(ctx->state, sizeof(ctx->state), 0, sizeof(ctx->state));
+    ctx->blockSize = blockSize;
+    for (; inLen - offset >= blockSize; offset += blockSize) {
+        XorBlockX4(ctx->state, in, offset, blockInWord);
+        KeccakX4(ctx->state);
+    }
+
+    // Pad the last block of every input, the permutation of it is left to the first squeeze.
+    uint8_t lastBlock[CRYPT_SHAKE_X4_LANES][CRYPT_SHAKE128_BLOCKSIZE];
+    const uint8_t *last[CRYPT_SHAKE_X4_LANES];
+    uint32_t left = inLen - offset;
+    for (uint32_t j = 0; j < CRYPT_SHAKE_X4_LANES; j++) {
+        (void)memset_s(lastBlock[j], sizeof(lastBlock[j]), 0, sizeof(lastBlock[j]));
+        if (left != 0) {
+            (void)memcpy_s(lastBlock[j], sizeof(lastBlock[j]), in[j] + offset, left);
+        }
+        lastBlock[j][left] = SHAKE_PAD_CHR;
+        lastBlock[j][blockSize - 1] |= 0x80; // 0x80 is the last 1 of pad 10*1 mode
+        last[j] = lastBlock[j];
+    }
+    XorBlockX4(ctx->state, last, 0, blockInWord);
+    BSL_SAL_CleanseData(lastBlock, sizeof(lastBlock));
+    return CRYPT_SUCCESS;
+}
+
+int32_t CRYPT_SHAKE128_X4Absorb(CRYPT_SHAKE_X4_Ctx *ctx, const uint8_t *const in[], uint32_t inLen)
+{
+    return ShakeX4Absorb(ctx, in, inLen, CRYPT_SHAKE128_BLOCKSIZE);
+}
+
+int32_t CRYPT_SHAKE256_X4Absorb(CRYPT_SHAKE_X4_Ctx *ctx, const uint8_t *const in[], uint32_t inLen)
+{
+    return ShakeX4Absorb(ctx, in, inLen, CRYPT_SHAKE256_BLOCKSIZE);
+}
+
+int32_t CRYPT_SHAKE_X4SqueezeBlocks(CRYPT_SHAKE_X4_Ctx *ctx, uint8_t *const out[], uint32_t blockNum)
+{
+    if (ctx == NULL || out == NULL) {
+        BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
+        return CRYPT_NULL_INPUT;
+    }
+    for (uint32_t j = 0; j < CRYPT_SHAKE_X4_LANES; j++) {
+        if (out[j] == NULL) {
+            BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
+            return CRYPT_NULL_INPUT;
+        }
+    }
+    uint32_t blockInWord = ctx->blockSize / 8;
+    for (uint32_t b = 0; b < blockNum; b++) {
+        KeccakX4(ctx->state);
+        uint32_t offset = b * ctx->blockSize;
+        for (uint32_t w = 0; w < blockInWord; w++) {
+            for (uint32_t j = 0; j < CRYPT_SHAKE_X4_LANES; j++) {
+                PUT_UINT64_LE(ctx->state[w * CRYPT_SHAKE_X4_LANES + j], out[j], offset + (w << 3));
+            }
+        }
+    }
+    return CRYPT_SUCCESS;
+}
+
+// Hash four inputs at a time, the lanes left over in the last round repeat the first input and are dropped.
+static int32_t ShakeBatch(const uint8_t *const in[], uint32_t inLen, uint8_t *const out[], uint32_t outLen,
+    uint32_t num, uint32_t blockSize)
+{
+    if (in == NULL || out == NULL) {
+        BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
+        return CRYPT_NULL_INPUT;
+    }
+    // Check every pointer before any absorbing, so that no output is written when the call fails.
+    for (uint32_t i = 0; i < num; i++) {
+        if ((in[i] == NULL && inLen != 0) || out[i] == NULL) {
+            BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
+            return CRYPT_NULL_INPUT;
+        }
+    }
+    int32_t ret = CRYPT_SUCCESS;
+    CRYPT_SHAKE_X4_Ctx ctx;
+    uint8_t block[CRYPT_SHAKE_X4_LANES][CRYPT_SHAKE128_BLOCKSIZE];
+    uint8_t *blockOut[CRYPT_SHAKE_X4_LANES] = {block[0], block[1], block[2], block[3]};
+    for (uint32_t done = 0; done < num; done += CRYPT_SHAKE_X4_LANES) {
+        uint32_t lanes = (num - done < CRYPT_SHAKE_X4_LANES) ? (num - done) : CRYPT_SHAKE_X4_LANES;
+        const uint8_t *laneIn[CRYPT_SHAKE_X4_LANES];
+        for (uint32_t j = 0; j < CRYPT_SHAKE_X4_LANES; j++) {
+            laneIn[j] = in[done + ((j < lanes) ? j : 0)];
+        }
+        ret = ShakeX4Absorb(&ctx, laneIn, inLen, blockSize);
+        if (ret != CRYPT_SUCCESS) {
+            break;
+        }
+        for (uint32_t offset = 0; offset < outLen; offset += blockSize) {
+            uint32_t copyLen = (outLen - offset < blockSize) ? (outLen - offset) : blockSize;
+            (void)CRYPT_SHAKE_X4SqueezeBlocks(&ctx, blockOut, 1);
+            for (uint32_t j = 0; j < lanes; j++) {
+                (void)memcpy_s(out[done + j] + offset, outLen - offset, block[j], copyLen);
+            }
+        }
+    }
+    BSL_SAL_CleanseData(&ctx, sizeof(ctx));
+    BSL_SAL_CleanseData(block, sizeof(block));
+    return ret;
+}
+
+int32_t CRYPT_SHAKE128_Batch(const uint8_t *const in[], uint32_t inLen, uint8_t *const out[], uint32_t outLen,
+    uint32_t num)
+{
+    return ShakeBatch(in, inLen, out, outLen, num, CRYPT_SHAKE128_BLOCKSIZE);
+}
+
+int32_t CRYPT_SHAKE256_Batch(const uint8_t *const in[], uint32_t inLen, uint8_t *const out[], uint32_t outLen,
+    uint32_t num)
+{
+    return ShakeBatch(in, inLen, out, outLen, num, CRYPT_SHAKE256_BLOCKSIZE);
+}
+
+#endif // HITLS_CRYPTO_SHA3
@@ -238,6 +238,42 @@ void BaseB(const uint8_t *x, uint32_t xLen, uint32_t b, uint32_t *out, uint32_t
     }
 }
 
+int32_t SlhDsaTreeHash(uint8_t *nodes, uint32_t idx, uint32_t height, uint32_t leafIdx, uint8_t *auth,
+                       const SlhDsaAdrs *adrs, const CryptSlhDsaCtx *ctx)
+{
+    uint32_t n = ctx->para.n;
+    uint32_t lanes = ctx->hashFuncs.lanes;
+    SlhDsaAdrs laneAdrs[SLH_DSA_MAX_LANES];
+    uint8_t parent[SLH_DSA_MAX_LANES][SLH_DSA_MAX_N];
+    const uint8_t *in[SLH_DSA_MAX_LANES];
+    uint8_t *out[SLH_DSA_MAX_LANES];
+    for (uint32_t h = 0; h < height; h++) {
+        if (auth != NULL) {
+            (void)memcpy_s(auth + h * n, n, nodes + (((leafIdx >> h) ^ 1) * n), n);
+        }
+        uint32_t num = 1U << (height - h - 1); // the nodes at height h + 1
+        for (uint32_t i = 0; i < num; i += lanes) {
+            uint32_t cnt = (num - i < lanes) ? (num - i) : lanes;
+            for (uint32_t j = 0; j < cnt; j++) {
+                laneAdrs[j] = *adrs;
+                ctx->adrsOps.setTreeHeight(&laneAdrs[j], h + 1);
+                ctx->adrsOps.setTreeIndex(&laneAdrs[j], (idx << (height - h - 1)) + i + j);
+                in[j] = nodes + 2 * (i + j) * n; // 2: the left and the right child are adjacent
+                out[j] = parent[j];
+            }
+            int32_t ret = ctx->hashFuncs.hBatch(ctx, laneAdrs, in, 2 * n, out, cnt);
+            if (ret != CRYPT_SUCCESS) {
+                return ret;
+            }
+            // The children of the parents that are not hashed yet start from 2 * (i + cnt), so they are kept.
+            for (uint32_t j = 0; j < cnt; j++) {
+                (void)memcpy_s(nodes + (i + j) * n, n, parent[j], n);
+            }
+        }
+    }
+    return CRYPT_SUCCESS;
+}
+
 // ToInt(b[0:l]) mod 2^m
 static uint64_t ToIntMod(const uint8_t *b, uint32_t l, uint32_t m)
 {
@@ -281,6 +317,7 @@ void CRYPT_SLH_DSA_FreeCtx(CryptSlhDsaCtx *ctx)
     BSL_SAL_ClearFree(ctx->addrand, ctx->addrandLen);
     BSL_SAL_CleanseData(ctx->prvKey.seed, sizeof(ctx->prvKey.seed));
     BSL_SAL_CleanseData(ctx->prvKey.prf, sizeof(ctx->prvKey.prf));
+    SlhDsaFreeSeededMd(ctx);
     BSL_SAL_Free(ctx);
 }
 
@@ -315,10 +352,20 @@ int32_t CRYPT_SLH_DSA_Gen(CryptSlhDsaCtx *ctx)
         BSL_ERR_PUSH_ERROR(ret);
         return ret;
     }
+    ret = SlhDsaInitSeededMd(ctx);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    CryptSlhDsaCtx opCtx;
+    ret = SlhDsaOpCtxInit(&opCtx, ctx);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
     SlhDsaAdrs adrs = {0};
     ctx->adrsOps.setLayerAddr(&adrs, d - 1);
     uint8_t node[SLH_DSA_MAX_N] = {0};
-    ret = XmssNode(node, 0, hp, &adrs, ctx);
+    ret = XmssNode(node, 0, hp, &adrs, &opCtx);
+    SlhDsaOpCtxDeinit(&opCtx);
     if (ret != CRYPT_SUCCESS) {
         BSL_ERR_PUSH_ERROR(ret);
         return ret;
@@ -372,31 +419,21 @@ static void GetTreeAndLeafIdx(const uint8_t *digest, const CryptSlhDsaCtx *ctx,
     *leafIdx = (uint32_t)ToIntMod(digest + mdIdx + treeIdxLen, leafIdxLen, h / d);
 }
 
-static int32_t CRYPT_SLH_DSA_SignInternal(CryptSlhDsaCtx *ctx, const uint8_t *msg, uint32_t msgLen, uint8_t *sig,
-                                          uint32_t *sigLen)
+// ctx is the copy of the key context for this signature.
+static int32_t SlhDsaSignWithOpCtx(const CryptSlhDsaCtx *ctx, const uint8_t *msg, uint32_t msgLen, uint8_t *sig,
+                                   uint32_t *sigLen)
 {
     int32_t ret;
     uint32_t n = ctx->para.n;
     uint32_t a = ctx->para.a;
     uint32_t k = ctx->para.k;
-    uint32_t sigBytes = ctx->para.sigBytes;
     uint32_t mdIdx = SPLIT_BYTES(k * a);
     uint64_t treeIdx;
     uint32_t leafIdx;
-
-    if (*sigLen < sigBytes) {
-        BSL_ERR_PUSH_ERROR(CRYPT_SLHDSA_ERR_INVALID_SIG_LEN);
-        return CRYPT_SLHDSA_ERR_INVALID_SIG_LEN;
-    }
     SlhDsaAdrs adrs = {0};
     uint32_t offset = 0;
     uint32_t left = *sigLen;
 
-    ret = GetAddRand(ctx);
-    if (ret != CRYPT_SUCCESS) {
-        return ret;
-    }
-
     ret = ctx->hashFuncs.prfmsg(ctx, ctx->addrand, msg, msgLen, sig);
     if (ret != CRYPT_SUCCESS) {
         BSL_ERR_PUSH_ERROR(ret);
@@ -436,8 +473,30 @@ static int32_t CRYPT_SLH_DSA_SignInternal(CryptSlhDsaCtx *ctx, const uint8_t *ms
     return CRYPT_SUCCESS;
 }
 
-static int32_t CRYPT_SLH_DSA_VerifyInternal(const CryptSlhDsaCtx *ctx, const uint8_t *msg, uint32_t msgLen,
-                                            const uint8_t *sig, uint32_t sigLen)
+static int32_t CRYPT_SLH_DSA_SignInternal(CryptSlhDsaCtx *ctx, const uint8_t *msg, uint32_t msgLen, uint8_t *sig,
+                                          uint32_t *sigLen)
+{
+    if (*sigLen < ctx->para.sigBytes) {
+        BSL_ERR_PUSH_ERROR(CRYPT_SLHDSA_ERR_INVALID_SIG_LEN);
+        return CRYPT_SLHDSA_ERR_INVALID_SIG_LEN;
+    }
+    int32_t ret = GetAddRand(ctx);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    CryptSlhDsaCtx opCtx;
+    ret = SlhDsaOpCtxInit(&opCtx, ctx);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    ret = SlhDsaSignWithOpCtx(&opCtx, msg, msgLen, sig, sigLen);
+    SlhDsaOpCtxDeinit(&opCtx);
+    return ret;
+}
+
+// ctx is the copy of the key context for this verification.
+static int32_t SlhDsaVerifyWithOpCtx(const CryptSlhDsaCtx *ctx, const uint8_t *msg, uint32_t msgLen,
+                                     const uint8_t *sig, uint32_t sigLen)
 {
     int32_t ret;
     uint32_t n = ctx->para.n;
@@ -483,6 +542,19 @@ static int32_t CRYPT_SLH_DSA_VerifyInternal(const CryptSlhDsaCtx *ctx, const uin
     return CRYPT_SUCCESS;
 }
 
+static int32_t CRYPT_SLH_DSA_VerifyInternal(const CryptSlhDsaCtx *ctx, const uint8_t *msg, uint32_t msgLen,
+                                            const uint8_t *sig, uint32_t sigLen)
+{
+    CryptSlhDsaCtx opCtx;
+    int32_t ret = SlhDsaOpCtxInit(&opCtx, ctx);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    ret = SlhDsaVerifyWithOpCtx(&opCtx, msg, msgLen, sig, sigLen);
+    SlhDsaOpCtxDeinit(&opCtx);
+    return ret;
+}
+
 static uint32_t GetMdSize(const EAL_MdMethod *hashMethod, int32_t hashId)
 {
     if (hashId == CRYPT_MD_SHAKE128) {
@@ -608,6 +680,7 @@ static void SlhDsaSetAlgId(CryptSlhDsaCtx *ctx, CRYPT_SLH_DSA_AlgId algId)
     ctx->para.sigBytes = g_slhDsaSigBytes[algId];
     ctx->para.secCategory = g_secCategory[algId];
     SlhDsaInitHashFuncs(ctx);
+    SlhDsaFreeSeededMd(ctx);
     if (ctx->para.isCompressed) {
         ctx->adrsOps = g_adrsOps[1];
     } else {
@@ -690,6 +763,19 @@ int32_t CRYPT_SLH_DSA_Ctrl(CryptSlhDsaCtx *ctx, int32_t opt, void *val, uint32_t
             ctx->addrand = rand;
             ctx->addrandLen = len;
             return CRYPT_SUCCESS;
+        case CRYPT_CTRL_SET_SLH_DSA_THREAD_NUM:
+            if (val == NULL || len != sizeof(uint32_t)) {
+                BSL_ERR_PUSH_ERROR(CRYPT_INVALID_ARG);
+                return CRYPT_INVALID_ARG;
+            }
+#if !defined(HITLS_BSL_SAL_THREAD) || !defined(HITLS_BSL_SAL_LINUX)
+            if (*(uint32_t *)val > 1) {
+                BSL_ERR_PUSH_ERROR(CRYPT_NOT_SUPPORT);
+                return CRYPT_NOT_SUPPORT;
+            }
+#endif
+            ctx->threadNum = *(uint32_t *)val;
+            return CRYPT_SUCCESS;
         default:
             BSL_ERR_PUSH_ERROR(CRYPT_NOT_SUPPORT);
             return CRYPT_NOT_SUPPORT;
@@ -785,7 +871,7 @@ int32_t CRYPT_SLH_DSA_SetPubKey(CryptSlhDsaCtx *ctx, const BSL_Param *para)
     (void)memcpy_s(ctx->prvKey.pub.seed, ctx->para.n, pub.pubSeed->value, ctx->para.n);
     (void)memcpy_s(ctx->prvKey.pub.root, ctx->para.n, pub.pubRoot->value, ctx->para.n);
 
-    return CRYPT_SUCCESS;
+    return SlhDsaInitSeededMd(ctx);
 }
 
 int32_t CRYPT_SLH_DSA_SetPrvKey(CryptSlhDsaCtx *ctx, const BSL_Param *para)
@@ -802,7 +888,7 @@ int32_t CRYPT_SLH_DSA_SetPrvKey(CryptSlhDsaCtx *ctx, const BSL_Param *para)
     (void)memcpy_s(ctx->prvKey.pub.seed, sizeof(ctx->prvKey.pub.seed), prv.pubSeed->value, ctx->para.n);
     (void)memcpy_s(ctx->prvKey.pub.root, sizeof(ctx->prvKey.pub.root), prv.pubRoot->value, ctx->para.n);
 
-    return CRYPT_SUCCESS;
+    return SlhDsaInitSeededMd(ctx);
 }
 
 #endif // HITLS_CRYPTO_SLH_DSA
\ No newline at end of file
@@ -25,6 +25,54 @@
 #include "slh_dsa_local.h"
 #include "slh_dsa_fors.h"
 
+/*
+ * Compute the 2^a leaves of the FORS tree treeIdx and hash them up to the root, the leaves are computed
+ * ctx->hashFuncs.lanes at a time. The authentication path of the leaf leafIdx of the tree is saved to auth.
+ */
+static int32_t ForsAuthPath(uint32_t treeIdx, uint32_t leafIdx, const SlhDsaAdrs *adrs, const CryptSlhDsaCtx *ctx,
+                            uint8_t *auth)
+{
+    int32_t ret = CRYPT_SUCCESS;
+    uint32_t n = ctx->para.n;
+    uint32_t a = ctx->para.a;
+    uint32_t lanes = ctx->hashFuncs.lanes;
+    uint32_t leafNum = 1U << a;
+    SlhDsaAdrs skAdrs[SLH_DSA_MAX_LANES];
+    SlhDsaAdrs leafAdrs[SLH_DSA_MAX_LANES];
+    uint8_t *leaf[SLH_DSA_MAX_LANES];
+    uint8_t *nodes = (uint8_t *)BSL_SAL_Malloc(leafNum * n);
+    if (nodes == NULL) {
+        return BSL_MALLOC_FAIL;
+    }
+    for (uint32_t i = 0; i < leafNum; i += lanes) {
+        uint32_t num = (leafNum - i < lanes) ? (leafNum - i) : lanes;
+        for (uint32_t j = 0; j < num; j++) {
+            uint32_t idx = (treeIdx << a) + i + j;
+            skAdrs[j] = *adrs;
+            ctx->adrsOps.setType(&skAdrs[j], FORS_PRF);
+            ctx->adrsOps.copyKeyPairAddr(&skAdrs[j], adrs);
+            ctx->adrsOps.setTreeIndex(&skAdrs[j], idx);
+            leafAdrs[j] = *adrs;
+            ctx->adrsOps.setTreeHeight(&leafAdrs[j], 0);
+            ctx->adrsOps.setTreeIndex(&leafAdrs[j], idx);
+            leaf[j] = nodes + (i + j) * n;
+        }
+        ret = ctx->hashFuncs.prfBatch(ctx, skAdrs, leaf, num);
+        if (ret != 0) {
+            goto ERR;
+        }
+        ret = ctx->hashFuncs.fBatch(ctx, leafAdrs, (const uint8_t *const *)leaf, n, leaf, num);
+        if (ret != 0) {
+            goto ERR;
+        }
+    }
+    ret = SlhDsaTreeHash(nodes, treeIdx, a, leafIdx, auth, adrs, ctx);
+ERR:
+    BSL_SAL_CleanseData(nodes, leafNum * n);
+    BSL_SAL_Free(nodes);
+    return ret;
+}
+
 int32_t ForsSign(const uint8_t *md, uint32_t mdLen, SlhDsaAdrs *adrs, const CryptSlhDsaCtx *ctx, uint8_t *sig,
                  uint32_t *sigLen)
 {
@@ -50,14 +98,11 @@ int32_t ForsSign(const uint8_t *md, uint32_t mdLen, SlhDsaAdrs *adrs, const Cryp
             goto ERR;
         }
         offset += n;
-        for (uint32_t j = 0; j < a; j++) {
-            uint32_t s = (indices[i] >> j) ^ 1;
-            ret = ForsNode((i << (a - j)) + s, j, adrs, ctx, sig + offset);
-            if (ret != 0) {
-                goto ERR;
-            }
-            offset += n;
+        ret = ForsAuthPath(i, indices[i], adrs, ctx, sig + offset);
+        if (ret != 0) {
+            goto ERR;
         }
+        offset += a * n;
     }
     *sigLen = offset;
 ERR:
@@ -65,6 +110,10 @@ ERR:
     return ret;
 }
 
+/*
+ * The k trees are independent, so the leaves of all trees are computed first and then the trees are climbed one
+ * level at a time, ctx->hashFuncs.lanes trees at a time.
+ */
 int32_t ForsPkFromSig(const uint8_t *sig, uint32_t sigLen, const uint8_t *md, uint32_t mdLen, SlhDsaAdrs *adrs,
                       const CryptSlhDsaCtx *ctx, uint8_t *pk)
 {
@@ -74,6 +123,7 @@ int32_t ForsPkFromSig(const uint8_t *sig, uint32_t sigLen, const uint8_t *md, ui
     uint32_t n = ctx->para.n;
     uint32_t a = ctx->para.a;
     uint32_t k = ctx->para.k;
+    uint32_t lanes = ctx->hashFuncs.lanes;
 
     if (sigLen < (a + 1) * n * k) {
         return CRYPT_SLHDSA_ERR_SIG_LEN_NOT_ENOUGH;
@@ -92,38 +142,43 @@ int32_t ForsPkFromSig(const uint8_t *sig, uint32_t sigLen, const uint8_t *md, ui
 
     BaseB(md, mdLen, a, indices, k);
 
-    uint8_t node0[SLH_DSA_MAX_N] = {0};
-    uint8_t node1[SLH_DSA_MAX_N] = {0};
-
-    for (uint32_t i = 0; i < k; i++) {
-        ctx->adrsOps.setTreeHeight(adrs, 0);
-        ctx->adrsOps.setTreeIndex(adrs, (i << a) + indices[i]);
-
-        ret = ctx->hashFuncs.f(ctx, adrs, sig + (a + 1) * n * i, n, node0);
-        if (ret != 0) {
-            goto ERR;
-        }
-        const uint8_t *auth = sig + (a + 1) * n * i + n;
-        for (uint32_t j = 0; j < a; j++) {
-            uint8_t tmp[SLH_DSA_MAX_N * 2];
-            ctx->adrsOps.setTreeHeight(adrs, j + 1);
-            if (((indices[i] >> j) & 1) == 1) {
-                ctx->adrsOps.setTreeIndex(adrs, (ctx->adrsOps.getTreeIndex(adrs) - 1) >> 1);
-                (void)memcpy_s(tmp, sizeof(tmp), auth + j * n, n);
-                (void)memcpy_s(tmp + n, sizeof(tmp) - n, node0, n);
+    SlhDsaAdrs laneAdrs[SLH_DSA_MAX_LANES];
+    uint8_t tmp[SLH_DSA_MAX_LANES][SLH_DSA_MAX_N * 2];
+    const uint8_t *in[SLH_DSA_MAX_LANES];
+    uint8_t *out[SLH_DSA_MAX_LANES];
+    for (uint32_t j = 0; j <= a; j++) { // j = 0: the leaves, j > 0: the nodes at height j
+        for (uint32_t i = 0; i < k; i += lanes) {
+            uint32_t num = (k - i < lanes) ? (k - i) : lanes;
+            for (uint32_t l = 0; l < num; l++) {
+                uint32_t t = i + l;
+                const uint8_t *treeSig = sig + (a + 1) * n * t;
+                laneAdrs[l] = *adrs;
+                ctx->adrsOps.setTreeHeight(&laneAdrs[l], j);
+                ctx->adrsOps.setTreeIndex(&laneAdrs[l], ((t << a) + indices[t]) >> j);
+                out[l] = root + t * n;
+                if (j == 0) {
+                    in[l] = treeSig;
+                    continue;
+                }
+                const uint8_t *auth = treeSig + n + (j - 1) * n;
+                if (((indices[t] >> (j - 1)) & 1) == 1) {
+                    (void)memcpy_s(tmp[l], sizeof(tmp[l]), auth, n);
+                    (void)memcpy_s(tmp[l] + n, sizeof(tmp[l]) - n, root + t * n, n);
+                } else {
+                    (void)memcpy_s(tmp[l], sizeof(tmp[l]), root + t * n, n);
+                    (void)memcpy_s(tmp[l] + n, sizeof(tmp[l]) - n, auth, n);
+                }
+                in[l] = tmp[l];
+            }
+            if (j == 0) {
+                ret = ctx->hashFuncs.fBatch(ctx, laneAdrs, in, n, out, num);
             } else {
-                ctx->adrsOps.setTreeIndex(adrs, ctx->adrsOps.getTreeIndex(adrs) >> 1);
-                (void)memcpy_s(tmp, sizeof(tmp), node0, n);
-                (void)memcpy_s(tmp + n, sizeof(tmp) - n, auth + j * n, n);
+                ret = ctx->hashFuncs.hBatch(ctx, laneAdrs, in, 2 * n, out, num);
             }
-
-            ret = ctx->hashFuncs.h(ctx, adrs, tmp, 2 * n, node1);
             if (ret != 0) {
                 goto ERR;
             }
-            (void)memcpy_s(node0, sizeof(node0), node1, sizeof(node1));
         }
-        (void)memcpy_s(root + i * n, (k - i) * n, node0, n);
     }
 
     SlhDsaAdrs forspkAdrs = *adrs;
@@ -151,33 +206,4 @@ int32_t ForsGenPrvKey(const SlhDsaAdrs *adrs, uint32_t idx, const CryptSlhDsaCtx
     return ctx->hashFuncs.prf(ctx, &skadrs, sk);
 }
 
-int32_t ForsNode(uint32_t idx, uint32_t height, SlhDsaAdrs *adrs, const CryptSlhDsaCtx *ctx, uint8_t *node)
-{
-    int32_t ret;
-    uint32_t n = ctx->para.n;
-
-    if (height == 0) {
-        uint8_t sk[SLH_DSA_MAX_N] = {0};
-        ret = ForsGenPrvKey(adrs, idx, ctx, sk);
-        if (ret != 0) {
-            return ret;
-        }
-        ctx->adrsOps.setTreeHeight(adrs, height);
-        ctx->adrsOps.setTreeIndex(adrs, idx);
-        return ctx->hashFuncs.f(ctx, adrs, sk, n, node);
-    }
-
-    uint8_t dnode[SLH_DSA_MAX_N * 2];
-    ret = ForsNode(idx * 2, height - 1, adrs, ctx, dnode);
-    if (ret != 0) {
-        return ret;
-    }
-    ret = ForsNode(idx * 2 + 1, height - 1, adrs, ctx, dnode + n);
-    if (ret != 0) {
-        return ret;
-    }
-    ctx->adrsOps.setTreeHeight(adrs, height);
-    ctx->adrsOps.setTreeIndex(adrs, idx);
-    return ctx->hashFuncs.h(ctx, adrs, dnode, 2 * n, node);
-}
 #endif // HITLS_CRYPTO_SLH_DSA
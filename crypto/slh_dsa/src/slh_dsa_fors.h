@@ -63,17 +63,5 @@ int32_t ForsPkFromSig(const uint8_t *sig, uint32_t sigLen, const uint8_t *md, ui
  */
 int32_t ForsGenPrvKey(const SlhDsaAdrs *adrs, uint32_t idx, const CryptSlhDsaCtx *ctx, uint8_t *sk);
 
-/**
- * @brief Generate a FORS node
- * 
- * @param idx Tree index
- * @param height Height of the tree
- * @param adrs Address structure for domain separation
- * @param ctx Context
- * @param node Output node, the length is n
- * @return int 0 on success, error code otherwise
- */
-int32_t ForsNode(uint32_t idx, uint32_t height, SlhDsaAdrs *adrs, const CryptSlhDsaCtx *ctx, uint8_t *node);
-
 #endif // HITLS_CRYPTO_SLH_DSA
 #endif // CRYPT_SLH_DSA_FORS_H
\ No newline at end of file
@@ -17,17 +17,19 @@
 #ifdef HITLS_CRYPTO_SLH_DSA
 
 #include "securec.h"
+#include "bsl_sal.h"
 #include "bsl_err_internal.h"
 #include "crypt_errno.h"
 #include "crypt_types.h"
 #include "crypt_eal_md.h"
 #include "crypt_eal_mac.h"
 #include "eal_md_local.h"
+#include "crypt_sha2.h"
+#include "crypt_sha3.h"
 #include "slh_dsa_local.h"
 #include "slh_dsa_hash.h"
 
 #define MAX_MDSIZE         64
-#define SHA256_PADDING_LEN 64
 #define SHA512_PADDING_LEN 128
 
 static int32_t CalcMultiMsgHash(CRYPT_MD_AlgId mdId, const CRYPT_ConstData *hashData, uint32_t hashDataLen,
@@ -90,6 +92,46 @@ static int32_t FShake256(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, cons
     return HShake256(ctx, adrs, msg, msgLen, out);
 }
 
+// The copies of the inputs are cleansed if they hold the private seed.
+static int32_t Shake256Batch(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, const uint8_t *const msg[],
+                             uint32_t msgLen, uint8_t *const out[], uint32_t num, bool isPrf)
+{
+    uint32_t n = ctx->para.n;
+    uint32_t adrsLen = ctx->adrsOps.getAdrsLen();
+    uint8_t buf[SLH_DSA_MAX_LANES][SLH_DSA_MAX_N + SLH_DSA_ADRS_LEN + 2 * SLH_DSA_MAX_N]; // 2: H takes two nodes
+    const uint8_t *in[SLH_DSA_MAX_LANES];
+    if (msgLen > 2 * SLH_DSA_MAX_N || num > SLH_DSA_MAX_LANES) {
+        BSL_ERR_PUSH_ERROR(CRYPT_INVALID_ARG);
+        return CRYPT_INVALID_ARG;
+    }
+    for (uint32_t j = 0; j < num; j++) {
+        (void)memcpy_s(buf[j], sizeof(buf[j]), ctx->prvKey.pub.seed, n);
+        (void)memcpy_s(buf[j] + n, sizeof(buf[j]) - n, adrs[j].bytes, adrsLen);
+        (void)memcpy_s(buf[j] + n + adrsLen, sizeof(buf[j]) - n - adrsLen, msg[j], msgLen);
+        in[j] = buf[j];
+    }
+    int32_t ret = CRYPT_SHAKE256_Batch(in, n + adrsLen + msgLen, out, n, num);
+    if (isPrf) {
+        BSL_SAL_CleanseData(buf, num * sizeof(buf[0]));
+    }
+    return ret;
+}
+
+static int32_t HShake256Batch(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, const uint8_t *const msg[],
+                              uint32_t msgLen, uint8_t *const out[], uint32_t num)
+{
+    return Shake256Batch(ctx, adrs, msg, msgLen, out, num, false);
+}
+
+static int32_t PrfShake256Batch(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, uint8_t *const out[], uint32_t num)
+{
+    const uint8_t *msg[SLH_DSA_MAX_LANES];
+    for (uint32_t j = 0; j < num && j < SLH_DSA_MAX_LANES; j++) {
+        msg[j] = ctx->prvKey.seed;
+    }
+    return Shake256Batch(ctx, adrs, msg, ctx->para.n, out, num, true);
+}
+
 static int32_t Prfmsg(const CryptSlhDsaCtx *ctx, const uint8_t *rand, const uint8_t *msg, uint32_t msgLen, uint8_t *out,
                       CRYPT_MAC_AlgId macId)
 {
@@ -160,27 +202,45 @@ static int32_t HmsgSha512(const CryptSlhDsaCtx *ctx, const uint8_t *r, const uin
     return HmsgSha(ctx, r, ctx->prvKey.pub.seed, ctx->prvKey.pub.root, msg, msgLen, out, CRYPT_MD_SHA512);
 }
 
-static int32_t PrfSha256(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, uint8_t *out)
+/*
+ * Hash PK.seed || toByte(0, blockSize - n) || ADRS || msg. The state after the first block is copied from seededMd to
+ * workMd, the whole input is hashed if the state has not been computed or there is no working context.
+ */
+static int32_t CalcSeededHash(const CryptSlhDsaCtx *ctx, const void *seededMd, void *workMd, CRYPT_MD_AlgId mdId,
+                              const SlhDsaAdrs *adrs, const uint8_t *msg, uint32_t msgLen, uint8_t *out)
 {
     uint32_t n = ctx->para.n;
-    uint8_t padding[SHA256_PADDING_LEN] = {0};
-    const CRYPT_ConstData hashData[] = {{ctx->prvKey.pub.seed, n},
-                                        {padding, sizeof(padding) - n},
-                                        {adrs->bytes, ctx->adrsOps.getAdrsLen()},
-                                        {ctx->prvKey.seed, n}};
-    return CalcMultiMsgHash(CRYPT_MD_SHA256, hashData, sizeof(hashData) / sizeof(hashData[0]), out, n);
+    const EAL_MdMethod *method = EAL_MdFindMethod(mdId);
+    if (seededMd == NULL || workMd == NULL) {
+        uint8_t padding[SHA512_PADDING_LEN] = {0};
+        const CRYPT_ConstData hashData[] = {{ctx->prvKey.pub.seed, n},
+                                            {padding, method->blockSize - n},
+                                            {adrs->bytes, ctx->adrsOps.getAdrsLen()},
+                                            {msg, msgLen}};
+        return CalcMultiMsgHash(mdId, hashData, sizeof(hashData) / sizeof(hashData[0]), out, n);
+    }
+    uint8_t tmp[MAX_MDSIZE] = {0};
+    uint32_t tmpLen = sizeof(tmp);
+    int32_t ret;
+    GOTO_ERR_IF(method->copyCtx(workMd, (void *)(uintptr_t)seededMd), ret);
+    GOTO_ERR_IF(method->update(workMd, adrs->bytes, ctx->adrsOps.getAdrsLen()), ret);
+    GOTO_ERR_IF(method->update(workMd, msg, msgLen), ret);
+    GOTO_ERR_IF(method->final(workMd, tmp, &tmpLen), ret);
+    (void)memcpy_s(out, n, tmp, n);
+ERR:
+    return ret;
+}
+
+static int32_t PrfSha256(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, uint8_t *out)
+{
+    return CalcSeededHash(ctx, ctx->sha256Seeded, ctx->sha256Work, CRYPT_MD_SHA256, adrs, ctx->prvKey.seed,
+        ctx->para.n, out);
 }
 
 static int32_t HSha256(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, const uint8_t *msg, uint32_t msgLen,
                        uint8_t *out)
 {
-    uint32_t n = ctx->para.n;
-    uint8_t padding[SHA256_PADDING_LEN] = {0};
-    const CRYPT_ConstData hashData[] = {{ctx->prvKey.pub.seed, n},
-                                        {padding, sizeof(padding) - n},
-                                        {adrs->bytes, ctx->adrsOps.getAdrsLen()},
-                                        {msg, msgLen}};
-    return CalcMultiMsgHash(CRYPT_MD_SHA256, hashData, sizeof(hashData) / sizeof(hashData[0]), out, n);
+    return CalcSeededHash(ctx, ctx->sha256Seeded, ctx->sha256Work, CRYPT_MD_SHA256, adrs, msg, msgLen, out);
 }
 
 static int32_t FSha256(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, const uint8_t *msg, uint32_t msgLen,
@@ -198,13 +258,7 @@ static int32_t TlSha256(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, const
 static int32_t HSha512(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, const uint8_t *msg, uint32_t msgLen,
                        uint8_t *out)
 {
-    uint32_t n = ctx->para.n;
-    uint8_t padding[SHA512_PADDING_LEN] = {0};
-    const CRYPT_ConstData hashData[] = {{ctx->prvKey.pub.seed, n},
-                                        {padding, sizeof(padding) - n},
-                                        {adrs->bytes, ctx->adrsOps.getAdrsLen()},
-                                        {msg, msgLen}};
-    return CalcMultiMsgHash(CRYPT_MD_SHA512, hashData, sizeof(hashData) / sizeof(hashData[0]), out, n);
+    return CalcSeededHash(ctx, ctx->sha512Seeded, ctx->sha512Work, CRYPT_MD_SHA512, adrs, msg, msgLen, out);
 }
 
 static int32_t TlSha512(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, const uint8_t *msg, uint32_t msgLen,
@@ -213,25 +267,123 @@ static int32_t TlSha512(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, const
     return HSha512(ctx, adrs, msg, msgLen, out);
 }
 
+// The inputs of a batch are hashed one by one by the seeded SHA-256.
+static int32_t HSha256Serial(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, const uint8_t *const msg[],
+                             uint32_t msgLen, uint8_t *const out[], uint32_t num)
+{
+    for (uint32_t j = 0; j < num; j++) {
+        int32_t ret = HSha256(ctx, &adrs[j], msg[j], msgLen, out[j]);
+        if (ret != CRYPT_SUCCESS) {
+            return ret;
+        }
+    }
+    return CRYPT_SUCCESS;
+}
+
+static int32_t PrfSha256Serial(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, uint8_t *const out[], uint32_t num)
+{
+    for (uint32_t j = 0; j < num; j++) {
+        int32_t ret = PrfSha256(ctx, &adrs[j], out[j]);
+        if (ret != CRYPT_SUCCESS) {
+            return ret;
+        }
+    }
+    return CRYPT_SUCCESS;
+}
+
+/*
+ * The SHA-256 instances of a batch resume from the state after PK.seed and hash ADRS || msg in parallel, they are
+ * hashed one by one if the state has not been computed. The copies of the inputs are cleansed if they hold the
+ * private seed.
+ */
+static int32_t Sha256Batch(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, const uint8_t *const msg[],
+                           uint32_t msgLen, uint8_t *const out[], uint32_t num, bool isPrf)
+{
+    int32_t ret;
+    if (ctx->sha256Seeded == NULL) {
+        return HSha256Serial(ctx, adrs, msg, msgLen, out, num);
+    }
+    uint32_t adrsLen = ctx->adrsOps.getAdrsLen();
+    uint8_t buf[SLH_DSA_MAX_LANES][SLH_DSA_ADRS_LEN + 2 * SLH_DSA_MAX_N]; // 2: H takes two nodes
+    const uint8_t *in[SLH_DSA_MAX_LANES];
+    if (msgLen > 2 * SLH_DSA_MAX_N || num > SLH_DSA_MAX_LANES) {
+        BSL_ERR_PUSH_ERROR(CRYPT_INVALID_ARG);
+        return CRYPT_INVALID_ARG;
+    }
+    for (uint32_t j = 0; j < num; j++) {
+        (void)memcpy_s(buf[j], sizeof(buf[j]), adrs[j].bytes, adrsLen);
+        (void)memcpy_s(buf[j] + adrsLen, sizeof(buf[j]) - adrsLen, msg[j], msgLen);
+        in[j] = buf[j];
+    }
+    ret = CRYPT_SHA2_256_Batch((const CRYPT_SHA2_256_Ctx *)ctx->sha256Seeded, in, adrsLen + msgLen, out, ctx->para.n,
+        num);
+    if (isPrf) {
+        BSL_SAL_CleanseData(buf, num * sizeof(buf[0]));
+    }
+    return ret;
+}
+
+static int32_t HSha256Batch(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, const uint8_t *const msg[],
+                            uint32_t msgLen, uint8_t *const out[], uint32_t num)
+{
+    return Sha256Batch(ctx, adrs, msg, msgLen, out, num, false);
+}
+
+static int32_t PrfSha256Batch(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, uint8_t *const out[], uint32_t num)
+{
+    const uint8_t *msg[SLH_DSA_MAX_LANES];
+    for (uint32_t j = 0; j < num && j < SLH_DSA_MAX_LANES; j++) {
+        msg[j] = ctx->prvKey.seed;
+    }
+    return Sha256Batch(ctx, adrs, msg, ctx->para.n, out, num, true);
+}
+
+// There is no parallel SHA-512, H of category 3 and 5 is computed one by one.
+static int32_t HSha512Batch(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, const uint8_t *const msg[],
+                            uint32_t msgLen, uint8_t *const out[], uint32_t num)
+{
+    for (uint32_t j = 0; j < num; j++) {
+        int32_t ret = HSha512(ctx, &adrs[j], msg[j], msgLen, out[j]);
+        if (ret != CRYPT_SUCCESS) {
+            return ret;
+        }
+    }
+    return CRYPT_SUCCESS;
+}
+
+static bool IsSha2ParaSet(CRYPT_SLH_DSA_AlgId algId)
+{
+    return algId == CRYPT_SLH_DSA_SHA2_128S || algId == CRYPT_SLH_DSA_SHA2_128F || algId == CRYPT_SLH_DSA_SHA2_192S ||
+        algId == CRYPT_SLH_DSA_SHA2_192F || algId == CRYPT_SLH_DSA_SHA2_256S || algId == CRYPT_SLH_DSA_SHA2_256F;
+}
+
 void SlhDsaInitHashFuncs(CryptSlhDsaCtx *ctx)
 {
-    CRYPT_SLH_DSA_AlgId algId = ctx->para.algId;
     SlhDsaHashFuncs *hashFuncs = &ctx->hashFuncs;
-    if (algId == CRYPT_SLH_DSA_SHA2_128S || algId == CRYPT_SLH_DSA_SHA2_128F || algId == CRYPT_SLH_DSA_SHA2_192S ||
-        algId == CRYPT_SLH_DSA_SHA2_192F || algId == CRYPT_SLH_DSA_SHA2_256S || algId == CRYPT_SLH_DSA_SHA2_256F) {
+    if (IsSha2ParaSet(ctx->para.algId)) {
         ctx->para.isCompressed = true;
         hashFuncs->prf = PrfSha256;
         hashFuncs->f = FSha256;
+        /*
+         * Without the avx2 kernel, the eight-way SHA-256 is slower than the serial one, so the callers batch one
+         * input at a time and every input is hashed by the serial compression.
+         */
+        bool x8 = CRYPT_SHA2_256_CompressX8IsFast();
+        hashFuncs->prfBatch = x8 ? PrfSha256Batch : PrfSha256Serial;
+        hashFuncs->fBatch = x8 ? HSha256Batch : HSha256Serial;
+        hashFuncs->lanes = x8 ? CRYPT_SHA2_256_X8_LANES : 1;
         if (ctx->para.secCategory == 1) {
             hashFuncs->prfmsg = PrfmsgSha256;
             hashFuncs->hmsg = HmsgSha256;
             hashFuncs->tl = TlSha256;
             hashFuncs->h = HSha256;
+            hashFuncs->hBatch = hashFuncs->fBatch;
         } else {
             hashFuncs->prfmsg = PrfmsgSha512;
             hashFuncs->hmsg = HmsgSha512;
             hashFuncs->tl = TlSha512;
             hashFuncs->h = HSha512;
+            hashFuncs->hBatch = HSha512Batch;
         }
     } else {
         ctx->para.isCompressed = false;
@@ -241,7 +393,92 @@ void SlhDsaInitHashFuncs(CryptSlhDsaCtx *ctx)
         hashFuncs->tl = TlShake256;
         hashFuncs->f = FShake256;
         hashFuncs->h = HShake256;
+        hashFuncs->prfBatch = PrfShake256Batch;
+        hashFuncs->fBatch = HShake256Batch;
+        hashFuncs->hBatch = HShake256Batch;
+        hashFuncs->lanes = CRYPT_SHAKE_X4_LANES;
+    }
+}
+
+static int32_t SeededMdInit(const uint8_t *seed, uint32_t n, CRYPT_MD_AlgId mdId, void **seededMd)
+{
+    int32_t ret;
+    uint8_t padding[SHA512_PADDING_LEN] = {0};
+    const EAL_MdMethod *method = EAL_MdFindMethod(mdId);
+    if (*seededMd == NULL) {
+        *seededMd = method->newCtx();
+        if (*seededMd == NULL) {
+            BSL_ERR_PUSH_ERROR(CRYPT_MEM_ALLOC_FAIL);
+            return CRYPT_MEM_ALLOC_FAIL;
+        }
+    }
+    GOTO_ERR_IF(method->init(*seededMd, NULL), ret);
+    GOTO_ERR_IF(method->update(*seededMd, seed, n), ret);
+    GOTO_ERR_IF(method->update(*seededMd, padding, method->blockSize - n), ret);
+    return CRYPT_SUCCESS;
+ERR:
+    method->freeCtx(*seededMd);
+    *seededMd = NULL;
+    return ret;
+}
+
+int32_t SlhDsaInitSeededMd(CryptSlhDsaCtx *ctx)
+{
+    if (!IsSha2ParaSet(ctx->para.algId)) {
+        return CRYPT_SUCCESS;
+    }
+    int32_t ret = SeededMdInit(ctx->prvKey.pub.seed, ctx->para.n, CRYPT_MD_SHA256, &ctx->sha256Seeded);
+    if (ret != CRYPT_SUCCESS || ctx->para.secCategory == 1) {
+        return ret;
+    }
+    return SeededMdInit(ctx->prvKey.pub.seed, ctx->para.n, CRYPT_MD_SHA512, &ctx->sha512Seeded);
+}
+
+void SlhDsaFreeSeededMd(CryptSlhDsaCtx *ctx)
+{
+    if (ctx->sha256Seeded != NULL) {
+        EAL_MdFindMethod(CRYPT_MD_SHA256)->freeCtx(ctx->sha256Seeded);
+        ctx->sha256Seeded = NULL;
+    }
+    if (ctx->sha512Seeded != NULL) {
+        EAL_MdFindMethod(CRYPT_MD_SHA512)->freeCtx(ctx->sha512Seeded);
+        ctx->sha512Seeded = NULL;
+    }
+}
+
+int32_t SlhDsaOpCtxInit(CryptSlhDsaCtx *opCtx, const CryptSlhDsaCtx *ctx)
+{
+    (void)memcpy_s(opCtx, sizeof(CryptSlhDsaCtx), ctx, sizeof(CryptSlhDsaCtx));
+    opCtx->sha256Work = NULL;
+    opCtx->sha512Work = NULL;
+    if (ctx->sha256Seeded != NULL) {
+        opCtx->sha256Work = EAL_MdFindMethod(CRYPT_MD_SHA256)->newCtx();
+        if (opCtx->sha256Work == NULL) {
+            goto ERR;
+        }
+    }
+    if (ctx->sha512Seeded != NULL) {
+        opCtx->sha512Work = EAL_MdFindMethod(CRYPT_MD_SHA512)->newCtx();
+        if (opCtx->sha512Work == NULL) {
+            goto ERR;
+        }
+    }
+    return CRYPT_SUCCESS;
+ERR:
+    SlhDsaOpCtxDeinit(opCtx);
+    BSL_ERR_PUSH_ERROR(CRYPT_MEM_ALLOC_FAIL);
+    return CRYPT_MEM_ALLOC_FAIL;
+}
+
+void SlhDsaOpCtxDeinit(CryptSlhDsaCtx *opCtx)
+{
+    if (opCtx->sha256Work != NULL) {
+        EAL_MdFindMethod(CRYPT_MD_SHA256)->freeCtx(opCtx->sha256Work);
+    }
+    if (opCtx->sha512Work != NULL) {
+        EAL_MdFindMethod(CRYPT_MD_SHA512)->freeCtx(opCtx->sha512Work);
     }
+    BSL_SAL_CleanseData(opCtx, sizeof(CryptSlhDsaCtx));
 }
 
 #endif // HITLS_CRYPTO_SLH_DSA
\ No newline at end of file
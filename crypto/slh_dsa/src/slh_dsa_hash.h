@@ -35,6 +35,17 @@ typedef int32_t (*SlhDsaH)(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, co
 typedef int32_t (*SlhDsaF)(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, const uint8_t *msg, uint32_t msgLen,
                            uint8_t *out);
 
+#define SLH_DSA_MAX_LANES 8 // The most inputs of one call of the batch functions
+
+// F or H of num (at most SLH_DSA_MAX_LANES) inputs, adrs[j], msg[j] and out[j] belong to the input j.
+// The length of "out[j]" is n, out[j] may be the same as msg[j]
+typedef int32_t (*SlhDsaHashBatch)(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, const uint8_t *const msg[],
+                                   uint32_t msgLen, uint8_t *const out[], uint32_t num);
+
+// PRF of num (at most SLH_DSA_MAX_LANES) addresses, the length of "out[j]" is n
+typedef int32_t (*SlhDsaPrfBatch)(const CryptSlhDsaCtx *ctx, const SlhDsaAdrs *adrs, uint8_t *const out[],
+                                  uint32_t num);
+
 // The length of "prf", "rand" and "out" is n, the max length is SLH_DSA_MAX_N
 typedef int32_t (*SlhDsaPrfMsg)(const CryptSlhDsaCtx *ctx, const uint8_t *rand, const uint8_t *msg, uint32_t msgLen,
                                 uint8_t *out);
@@ -50,9 +61,30 @@ struct HashFuncs {
     SlhDsaF f;
     SlhDsaPrfMsg prfmsg;
     SlhDsaHmsg hmsg;
+    SlhDsaPrfBatch prfBatch;
+    SlhDsaHashBatch fBatch;
+    SlhDsaHashBatch hBatch;
+    uint32_t lanes; // The inputs computed in parallel by the batch functions, the callers batch this many at a time
 };
 
 void SlhDsaInitHashFuncs(CryptSlhDsaCtx *ctx);
 
+/*
+ * The first block of F, H, T_l and PRF of the SHA2 parameter sets is PK.seed || padding, it is compressed once
+ * when PK.seed is set and the hash functions resume from the saved state. Nothing is done for the SHAKE sets.
+ */
+int32_t SlhDsaInitSeededMd(CryptSlhDsaCtx *ctx);
+
+void SlhDsaFreeSeededMd(CryptSlhDsaCtx *ctx);
+
+/*
+ * Copy ctx to opCtx for one key generation, sign or verify, and allocate the working contexts of opCtx which the SHA2
+ * hash functions copy the seeded states into. opCtx must not be shared by threads, ctx is not modified.
+ */
+int32_t SlhDsaOpCtxInit(CryptSlhDsaCtx *opCtx, const CryptSlhDsaCtx *ctx);
+
+// Free the working contexts of opCtx and cleanse the copy of the keys.
+void SlhDsaOpCtxDeinit(CryptSlhDsaCtx *opCtx);
+
 #endif // HITLS_CRYPTO_SLH_DSA
 #endif // SLH_DSA_HASH_H
\ No newline at end of file
@@ -18,13 +18,112 @@
 #include <stdint.h>
 #include <stddef.h>
 #include "securec.h"
+#include "bsl_errno.h"
 #include "bsl_err_internal.h"
 #include "bsl_sal.h"
 #include "crypt_errno.h"
 #include "slh_dsa_local.h"
 #include "slh_dsa_xmss.h"
+#include "slh_dsa_wots.h"
 #include "slh_dsa_hypertree.h"
 
+#define SLH_DSA_MAX_D 22 // The most layers of the hypertree, d of SLH-DSA-*-128f
+/*
+ * The least height of the XMSS trees whose layers are spread over threads. A layer of the fast sets (hp 3 or 4) has
+ * 8 or 16 WOTS+ keys, too few for the thread creation and the copy of the context of every signature to pay off,
+ * only the layers of the small sets (hp 8 or 9, 256 or 512 keys) are.
+ */
+#define SLH_DSA_THREAD_MIN_HP 8
+
+typedef struct {
+    const CryptSlhDsaCtx *ctx;
+    const uint64_t *treeIdx; // tree address of every layer
+    const uint32_t *leafIdx; // the signing WOTS+ key pair of every layer
+    uint8_t *sig;            // XMSS signature of the layer 0
+    uint8_t *roots;          // root of the XMSS tree of every layer
+    uint32_t first;          // the first layer of the job
+    uint32_t step;           // the job computes the layers first, first + step, ...
+    int32_t ret;
+} HypertreeJob;
+
+/*
+ * The authentication path and the root of a layer depend on the tree address and the signing key pair only, so the
+ * layers are independent of each other. Only the WOTS+ signature of a layer needs the root of the layer below.
+ */
+static int32_t HypertreeAuthPaths(HypertreeJob *job)
+{
+    const CryptSlhDsaCtx *ctx = job->ctx;
+    uint32_t n = ctx->para.n;
+    uint32_t len = 2 * n + 3;
+    uint32_t xmssLen = (len + ctx->para.hp) * n;
+    for (uint32_t j = job->first; j < ctx->para.d; j += job->step) {
+        SlhDsaAdrs adrs = {0};
+        ctx->adrsOps.setLayerAddr(&adrs, j);
+        ctx->adrsOps.setTreeAddr(&adrs, job->treeIdx[j]);
+        int32_t ret = XmssAuthPath(job->leafIdx[j], &adrs, ctx, job->sig + j * xmssLen + len * n, job->roots + j * n);
+        if (ret != CRYPT_SUCCESS) {
+            return ret;
+        }
+    }
+    return CRYPT_SUCCESS;
+}
+
+#if defined(HITLS_BSL_SAL_THREAD) && defined(HITLS_BSL_SAL_LINUX)
+static void *HypertreeWorker(void *arg)
+{
+    HypertreeJob *job = (HypertreeJob *)arg;
+    job->ret = HypertreeAuthPaths(job);
+    // The error stack of a worker is not seen by the caller, the caller pushes job->ret instead.
+    BSL_ERR_RemoveErrorStack(false);
+    return NULL;
+}
+
+/*
+ * The layers are dealt to threadNum jobs, the calling thread runs the first job and waits for the others. Every other
+ * job hashes with its own copy of the context, since the working hash contexts of a copy must not be shared.
+ * A failed job returns its error in the job, and the error is pushed on the error stack of the calling thread.
+ */
+static int32_t HypertreeAuthPathsParallel(HypertreeJob *jobs, uint32_t threadNum)
+{
+    BSL_SAL_ThreadId thread[SLH_DSA_MAX_D] = {0};
+    CryptSlhDsaCtx jobCtx[SLH_DSA_MAX_D];
+    uint32_t jobNum = 1;
+    int32_t ret = CRYPT_SUCCESS;
+    for (; jobNum < threadNum; jobNum++) {
+        uint32_t t = jobNum;
+        ret = SlhDsaOpCtxInit(&jobCtx[t], jobs[0].ctx);
+        if (ret != CRYPT_SUCCESS) {
+            break;
+        }
+        jobs[t] = jobs[0];
+        jobs[t].ctx = &jobCtx[t];
+        jobs[t].first = t;
+        jobs[t].step = threadNum;
+        jobs[t].ret = CRYPT_SUCCESS;
+        if (BSL_SAL_ThreadCreate(&thread[t], HypertreeWorker, &jobs[t]) != BSL_SUCCESS) {
+            thread[t] = NULL; // run by the calling thread below
+        }
+    }
+    if (ret == CRYPT_SUCCESS) {
+        jobs[0].step = threadNum;
+        ret = HypertreeAuthPaths(&jobs[0]);
+    }
+    for (uint32_t t = 1; t < jobNum; t++) {
+        if (thread[t] != NULL) {
+            BSL_SAL_ThreadClose(thread[t]);
+        } else if (ret == CRYPT_SUCCESS) {
+            jobs[t].ret = HypertreeAuthPaths(&jobs[t]);
+        }
+        if (ret == CRYPT_SUCCESS && jobs[t].ret != CRYPT_SUCCESS) {
+            ret = jobs[t].ret;
+            BSL_ERR_PUSH_ERROR(ret);
+        }
+        SlhDsaOpCtxDeinit(&jobCtx[t]);
+    }
+    return ret;
+}
+#endif
+
 int32_t HypertreeSign(const uint8_t *msg, uint32_t msgLen, uint64_t treeIdx, uint32_t leafIdx,
                       const CryptSlhDsaCtx *ctx, uint8_t *sig, uint32_t *sigLen)
 {
@@ -39,31 +138,48 @@ int32_t HypertreeSign(const uint8_t *msg, uint32_t msgLen, uint64_t treeIdx, uin
         return CRYPT_SLHDSA_ERR_SIG_LEN_NOT_ENOUGH;
     }
 
-    SlhDsaAdrs adrs = {0};
-
-    uint32_t offset = 0;
-    uint32_t tmpLen = *sigLen;
-    uint8_t root[SLH_DSA_MAX_N] = {0};
-    // the msgLen is actually n.
-    (void)memcpy_s(root, sizeof(root), msg, msgLen);
-
+    uint64_t layerTree[SLH_DSA_MAX_D];
+    uint32_t layerLeaf[SLH_DSA_MAX_D];
+    uint8_t roots[SLH_DSA_MAX_D * SLH_DSA_MAX_N];
     for (uint32_t j = 0; j < d; j++) {
         if (j != 0) {
             leafIdx = treeIdx & ((1UL << hp) - 1);
             treeIdx = treeIdx >> hp;
-            ctx->adrsOps.setLayerAddr(&adrs, j);
-        }
-        ctx->adrsOps.setTreeAddr(&adrs, treeIdx);
-        tmpLen = retLen - offset;
-        ret = XmssSign(root, n, leafIdx, &adrs, ctx, sig + offset, &tmpLen);
-        if (ret != CRYPT_SUCCESS) {
-            return ret;
         }
-        ret = XmssPkFromSig(leafIdx, sig + offset, tmpLen, root, n, &adrs, ctx, root);
+        layerTree[j] = treeIdx;
+        layerLeaf[j] = leafIdx;
+    }
+
+    HypertreeJob jobs[SLH_DSA_MAX_D] = {{ctx, layerTree, layerLeaf, sig, roots, 0, 1, CRYPT_SUCCESS}};
+    uint32_t threadNum = (hp < SLH_DSA_THREAD_MIN_HP) ? 1 : ((ctx->threadNum < d) ? ctx->threadNum : d);
+#if defined(HITLS_BSL_SAL_THREAD) && defined(HITLS_BSL_SAL_LINUX)
+    if (threadNum > 1) {
+        ret = HypertreeAuthPathsParallel(jobs, threadNum);
+    } else {
+        ret = HypertreeAuthPaths(&jobs[0]);
+    }
+#else
+    (void)threadNum;
+    ret = HypertreeAuthPaths(&jobs[0]);
+#endif
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+
+    // The layer j signs the root of the layer j - 1, the layer 0 signs msg.
+    for (uint32_t j = 0; j < d; j++) {
+        SlhDsaAdrs adrs = {0};
+        ctx->adrsOps.setLayerAddr(&adrs, j);
+        ctx->adrsOps.setTreeAddr(&adrs, layerTree[j]);
+        ctx->adrsOps.setType(&adrs, WOTS_HASH);
+        ctx->adrsOps.setKeyPairAddr(&adrs, layerLeaf[j]);
+        uint32_t tmpLen = len * n;
+        // the msgLen is actually n.
+        ret = WotsSign(sig + j * (len + hp) * n, &tmpLen, (j == 0) ? msg : roots + (j - 1) * n, (j == 0) ? msgLen : n,
+            &adrs, ctx);
         if (ret != CRYPT_SUCCESS) {
             return ret;
         }
-        offset += tmpLen;
     }
     *sigLen = retLen;
     return CRYPT_SUCCESS;
@@ -111,6 +111,15 @@ typedef struct {
 // so use uint32_t to receive the BaseB value
 void BaseB(const uint8_t *x, uint32_t xLen, uint32_t b, uint32_t *out, uint32_t outLen);
 
+/*
+ * Hash the 2^height nodes at the bottom of the subtree rooted at (idx, height) level by level, the nodes of one level
+ * are hashed ctx->hashFuncs.lanes at a time and the root is left in nodes[0, n). If auth is not NULL, the sibling
+ * at height h of the path from the leaf leafIdx of the subtree is saved to auth + h * n.
+ * adrs carries the layer, tree, type and key pair addresses, the tree height and index are set for every node.
+ */
+int32_t SlhDsaTreeHash(uint8_t *nodes, uint32_t idx, uint32_t height, uint32_t leafIdx, uint8_t *auth,
+                       const SlhDsaAdrs *adrs, const CryptSlhDsaCtx *ctx);
+
 typedef struct {
     CRYPT_SLH_DSA_AlgId algId;
     bool isCompressed;
@@ -149,6 +158,11 @@ struct SlhDsaCtx {
     bool isPrehash;
     SlhDsaPrvKey prvKey;
     SlhDsaHashFuncs hashFuncs;
+    void *sha256Seeded; // SHA-256 state after PK.seed || toByte(0, 64 - n), only for the SHA2 parameter sets
+    void *sha512Seeded; // SHA-512 state after PK.seed || toByte(0, 128 - n), only for category 3 and 5 of SHA2
+    void *sha256Work;   // the seeded SHA-256 state is copied here by every hash, only in the copy of one operation
+    void *sha512Work;   // the seeded SHA-512 state is copied here by every hash, only in the copy of one operation
+    uint32_t threadNum; // the hypertree layers of the s sets are computed by up to threadNum threads, 0 means 1
     AdrsOps adrsOps;
     void *libCtx;
 };
@@ -24,6 +24,8 @@
 #include "slh_dsa_local.h"
 #include "slh_dsa_wots.h"
 
+#define WOTS_MAX_LEN (2 * SLH_DSA_MAX_N + 3) // len of the WOTS+ key with the largest n
+
 static int32_t MsgToBaseW(const CryptSlhDsaCtx *ctx, const uint8_t *msg, uint32_t msgLen, uint32_t *out)
 {
     uint32_t n = ctx->para.n;
@@ -46,24 +48,81 @@ static int32_t MsgToBaseW(const CryptSlhDsaCtx *ctx, const uint8_t *msg, uint32_
     return 0;
 }
 
-int32_t WotsChain(const uint8_t *x, uint32_t xLen, uint32_t start, uint32_t end, const uint8_t *seed, SlhDsaAdrs *adrs,
-                  const CryptSlhDsaCtx *ctx, uint8_t *output)
+/*
+ * Run the chain i of the key pair in adrs from start[i] to end[i] for every i in [0, len), the values are updated in
+ * place in chains + i * n. The chains are hashed ctx->hashFuncs.lanes at a time, a chain leaves its lane when it
+ * reaches its end and the next chain takes the lane.
+ */
+static int32_t WotsChains(uint8_t *chains, const uint32_t *start, const uint32_t *end, uint32_t len,
+                          const SlhDsaAdrs *adrs, const CryptSlhDsaCtx *ctx)
 {
-    (void)seed;
-    int32_t ret;
-    uint8_t tmp[SLH_DSA_MAX_N];
-    (void)memcpy_s(tmp, sizeof(tmp), x, xLen);
-    uint32_t tmpLen = xLen;
-
-    for (uint32_t i = start; i < start + end; i++) {
-        ctx->adrsOps.setHashAddr(adrs, i);
-        ret = ctx->hashFuncs.f(ctx, adrs, tmp, tmpLen, tmp);
+    uint32_t n = ctx->para.n;
+    uint32_t lanes = ctx->hashFuncs.lanes;
+    SlhDsaAdrs laneAdrs[SLH_DSA_MAX_LANES];
+    uint32_t chain[SLH_DSA_MAX_LANES];
+    uint32_t pos[SLH_DSA_MAX_LANES];
+    uint8_t *val[SLH_DSA_MAX_LANES];
+    uint32_t num = 0;
+    uint32_t next = 0;
+    while (true) {
+        for (; num < lanes && next < len; next++) {
+            if (start[next] >= end[next]) {
+                continue;
+            }
+            chain[num] = next;
+            pos[num] = start[next];
+            laneAdrs[num] = *adrs;
+            ctx->adrsOps.setChainAddr(&laneAdrs[num], next);
+            val[num] = chains + next * n;
+            num++;
+        }
+        if (num == 0) {
+            return 0;
+        }
+        for (uint32_t j = 0; j < num; j++) {
+            ctx->adrsOps.setHashAddr(&laneAdrs[j], pos[j]);
+        }
+        int32_t ret = ctx->hashFuncs.fBatch(ctx, laneAdrs, (const uint8_t *const *)val, n, val, num);
         if (ret != 0) {
             return ret;
         }
+        uint32_t kept = 0;
+        for (uint32_t j = 0; j < num; j++) {
+            pos[j]++;
+            if (pos[j] == end[chain[j]]) {
+                continue;
+            }
+            chain[kept] = chain[j];
+            pos[kept] = pos[j];
+            laneAdrs[kept] = laneAdrs[j];
+            val[kept] = val[j];
+            kept++;
+        }
+        num = kept;
     }
+}
 
-    (void)memcpy_s(output, tmpLen, tmp, tmpLen);
+// Generate the private values of the len chains of the key pair in adrs into sk, lanes at a time.
+static int32_t WotsGenPrvKeys(uint8_t *sk, uint32_t len, const SlhDsaAdrs *adrs, const CryptSlhDsaCtx *ctx)
+{
+    uint32_t n = ctx->para.n;
+    uint32_t lanes = ctx->hashFuncs.lanes;
+    SlhDsaAdrs skAdrs[SLH_DSA_MAX_LANES];
+    uint8_t *out[SLH_DSA_MAX_LANES];
+    for (uint32_t i = 0; i < len; i += lanes) {
+        uint32_t num = (len - i < lanes) ? (len - i) : lanes;
+        for (uint32_t j = 0; j < num; j++) {
+            skAdrs[j] = *adrs;
+            ctx->adrsOps.setType(&skAdrs[j], WOTS_PRF);
+            ctx->adrsOps.copyKeyPairAddr(&skAdrs[j], adrs);
+            ctx->adrsOps.setChainAddr(&skAdrs[j], i + j);
+            out[j] = sk + (i + j) * n;
+        }
+        int32_t ret = ctx->hashFuncs.prfBatch(ctx, skAdrs, out, num);
+        if (ret != 0) {
+            return ret;
+        }
+    }
     return 0;
 }
 
@@ -73,27 +132,24 @@ int WotsGeneratePublicKey(uint8_t *pub, SlhDsaAdrs *adrs, const CryptSlhDsaCtx *
 
     uint32_t n = ctx->para.n;
     uint32_t len = 2 * n + 3;
-    SlhDsaAdrs skAdrs = *adrs;
-    ctx->adrsOps.setType(&skAdrs, WOTS_PRF);
-    ctx->adrsOps.copyKeyPairAddr(&skAdrs, adrs);
+    uint32_t start[WOTS_MAX_LEN];
+    uint32_t end[WOTS_MAX_LEN];
+    for (uint32_t i = 0; i < len; i++) {
+        start[i] = 0;
+        end[i] = SLH_DSA_W - 1;
+    }
 
     uint8_t *tmp = (uint8_t *)BSL_SAL_Malloc(len * n);
     if (tmp == NULL) {
         return BSL_MALLOC_FAIL;
     }
-
-    for (uint32_t i = 0; i < len; i++) {
-        ctx->adrsOps.setChainAddr(&skAdrs, i);
-        uint8_t sk[SLH_DSA_MAX_N] = {0};
-        ret = ctx->hashFuncs.prf(ctx, &skAdrs, sk);
-        if (ret != 0) {
-            goto ERR;
-        }
-        ctx->adrsOps.setChainAddr(adrs, i);
-        ret = WotsChain(sk, n, 0, SLH_DSA_W - 1, ctx->prvKey.pub.seed, adrs, ctx, (tmp + i * n));
-        if (ret != 0) {
-            goto ERR;
-        }
+    ret = WotsGenPrvKeys(tmp, len, adrs, ctx);
+    if (ret != 0) {
+        goto ERR;
+    }
+    ret = WotsChains(tmp, start, end, len, adrs, ctx);
+    if (ret != 0) {
+        goto ERR;
     }
 
     // compress public key
@@ -104,6 +160,7 @@ int WotsGeneratePublicKey(uint8_t *pub, SlhDsaAdrs *adrs, const CryptSlhDsaCtx *
     ret = ctx->hashFuncs.tl(ctx, &wotspk, tmp, len * n, pub);
 
 ERR:
+    BSL_SAL_CleanseData(tmp, len * n);
     BSL_SAL_Free(tmp);
     return ret;
 }
@@ -114,38 +171,23 @@ int32_t WotsSign(uint8_t *sig, uint32_t *sigLen, const uint8_t *msg, uint32_t ms
     int32_t ret;
     uint32_t n = ctx->para.n;
     uint32_t len = 2 * n + 3;
+    uint32_t msgw[WOTS_MAX_LEN];
+    uint32_t start[WOTS_MAX_LEN] = {0};
 
     if (*sigLen < len * n) {
         return CRYPT_BN_BUFF_LEN_NOT_ENOUGH;
     }
 
-    uint32_t *msgw = (uint32_t *)BSL_SAL_Malloc(len * sizeof(uint32_t));
-    if (msgw == NULL) {
-        return BSL_MALLOC_FAIL;
-    }
     ret = MsgToBaseW(ctx, msg, msgLen, msgw);
     if (ret != 0) {
-        goto ERR;
+        return ret;
     }
-
-    SlhDsaAdrs skAdrs = *adrs;
-    ctx->adrsOps.setType(&skAdrs, WOTS_PRF);
-    ctx->adrsOps.copyKeyPairAddr(&skAdrs, adrs);
-    for (uint32_t i = 0; i < len; i++) {
-        ctx->adrsOps.setChainAddr(&skAdrs, i);
-        uint8_t sk[SLH_DSA_MAX_N] = {0};
-        ret = ctx->hashFuncs.prf(ctx, &skAdrs, sk);
-        if (ret != 0) {
-            goto ERR;
-        }
-        ctx->adrsOps.setChainAddr(adrs, i);
-        ret = WotsChain(sk, n, 0, msgw[i], ctx->prvKey.pub.seed, adrs, ctx, sig + i * n);
-        if (ret != 0) {
-            goto ERR;
-        }
+    // The chains start from the private values and stop at msgw[i].
+    ret = WotsGenPrvKeys(sig, len, adrs, ctx);
+    if (ret != 0) {
+        return ret;
     }
-ERR:
-    BSL_SAL_Free(msgw);
+    ret = WotsChains(sig, start, msgw, len, adrs, ctx);
     *sigLen = len * n;
     return ret;
 }
@@ -156,33 +198,30 @@ int WotsPubKeyFromSig(const uint8_t *msg, uint32_t msgLen, const uint8_t *sig, u
     int32_t ret;
     uint32_t n = ctx->para.n;
     uint32_t len = 2 * n + 3;
-    uint32_t *msgw = NULL;
+    uint32_t msgw[WOTS_MAX_LEN];
+    uint32_t end[WOTS_MAX_LEN];
     uint8_t *tmp = NULL;
 
     if (sigLen < len * n) {
         return CRYPT_SLHDSA_ERR_SIG_LEN_NOT_ENOUGH;
     }
 
-    msgw = (uint32_t *)BSL_SAL_Malloc(len * sizeof(uint32_t));
-    if (msgw == NULL) {
-        return BSL_MALLOC_FAIL;
-    }
     ret = MsgToBaseW(ctx, msg, msgLen, msgw);
     if (ret != 0) {
-        goto ERR;
+        return ret;
+    }
+    for (uint32_t i = 0; i < len; i++) {
+        end[i] = SLH_DSA_W - 1;
     }
     tmp = (uint8_t *)BSL_SAL_Malloc(len * n);
     if (tmp == NULL) {
-        ret = BSL_MALLOC_FAIL;
-        goto ERR;
+        return BSL_MALLOC_FAIL;
     }
+    (void)memcpy_s(tmp, len * n, sig, len * n);
 
-    for (uint32_t i = 0; i < len; i++) {
-        ctx->adrsOps.setChainAddr(adrs, i);
-        ret = WotsChain(sig + i * n, n, msgw[i], SLH_DSA_W - 1 - msgw[i], ctx->prvKey.pub.seed, adrs, ctx, tmp + i * n);
-        if (ret != 0) {
-            goto ERR;
-        }
+    ret = WotsChains(tmp, msgw, end, len, adrs, ctx);
+    if (ret != 0) {
+        goto ERR;
     }
     SlhDsaAdrs wotspk = *adrs;
     ctx->adrsOps.setType(&wotspk, WOTS_PK);
@@ -190,10 +229,7 @@ int WotsPubKeyFromSig(const uint8_t *msg, uint32_t msgLen, const uint8_t *sig, u
     ret = ctx->hashFuncs.tl(ctx, &wotspk, tmp, len * n, pub);
 
 ERR:
-    BSL_SAL_Free(msgw);
-    if (tmp != NULL) {
-        BSL_SAL_Free(tmp);
-    }
+    BSL_SAL_Free(tmp);
     return ret;
 }
 
@@ -60,21 +60,5 @@ int32_t WotsSign(uint8_t *sig, uint32_t *sigLen, const uint8_t *msg, uint32_t ms
 int WotsPubKeyFromSig(const uint8_t *msg, uint32_t msgLen, const uint8_t *sig, uint32_t sigLen, SlhDsaAdrs *adrs,
                       const CryptSlhDsaCtx *ctx, uint8_t *pub);
 
-/**
- * @brief Compute a WOTS+ chain
- * 
- * @param x Input private key value to chain
- * @param xLen Length of the input private key value
- * @param start Starting position in the chain
- * @param end Ending position in the chain
- * @param seed Public seed for chain computation
- * @param adrs Address structure for domain separation
- * @param ctx SLH-DSA context
- * @param output Output chain result, the length is n
- * @return int 0 on success, error code otherwise
- */
-int32_t WotsChain(const uint8_t *x, uint32_t xLen, uint32_t start, uint32_t end, const uint8_t *seed, SlhDsaAdrs *adrs,
-                  const CryptSlhDsaCtx *ctx, uint8_t *output);
-
 #endif // HITLS_CRYPTO_SLH_DSA
 #endif // CRYPT_SLH_DSA_WOTS_H
\ No newline at end of file
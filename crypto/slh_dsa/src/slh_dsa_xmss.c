@@ -25,81 +25,50 @@
 #include "slh_dsa_xmss.h"
 #include "slh_dsa_wots.h"
 
-int32_t XmssNode(uint8_t *node, uint32_t idx, uint32_t height, SlhDsaAdrs *adrs, const CryptSlhDsaCtx *ctx)
+/*
+ * Compute the WOTS+ public keys of the 2^height leaves under the node (idx, height) and hash them up to the node. The
+ * authentication path of the leaf leafIdx of the subtree is saved to auth if it is not NULL.
+ */
+static int32_t XmssSubtree(uint8_t *node, uint32_t idx, uint32_t height, uint32_t leafIdx, uint8_t *auth,
+                           SlhDsaAdrs *adrs, const CryptSlhDsaCtx *ctx)
 {
-    int32_t ret;
-    if (node == NULL || adrs == NULL || ctx == NULL) {
-        return CRYPT_NULL_INPUT;
-    }
-
+    int32_t ret = CRYPT_SUCCESS;
     uint32_t n = ctx->para.n;
-
-    // If height is 0, compute WOTS+ public key
-    if (height == 0) {
-        ctx->adrsOps.setType(adrs, WOTS_HASH);
-        ctx->adrsOps.setKeyPairAddr(adrs, idx);
-        return WotsGeneratePublicKey(node, adrs, ctx);
+    uint32_t leafNum = 1U << height;
+    uint8_t *nodes = (uint8_t *)BSL_SAL_Malloc(leafNum * n);
+    if (nodes == NULL) {
+        return BSL_MALLOC_FAIL;
     }
-    // Compute internal node
-    uint8_t leftNode[SLH_DSA_MAX_N] = {0};
-    uint8_t rightNode[SLH_DSA_MAX_N] = {0};
-
-    // Compute left child
-    ret = XmssNode(leftNode, 2 * idx, height - 1, adrs, ctx);
-    if (ret != CRYPT_SUCCESS) {
-        return ret;
+    for (uint32_t i = 0; i < leafNum; i++) {
+        ctx->adrsOps.setType(adrs, WOTS_HASH);
+        ctx->adrsOps.setKeyPairAddr(adrs, (idx << height) + i);
+        ret = WotsGeneratePublicKey(nodes + i * n, adrs, ctx);
+        if (ret != CRYPT_SUCCESS) {
+            goto ERR;
+        }
     }
-
-    // Compute right child
-    ret = XmssNode(rightNode, 2 * idx + 1, height - 1, adrs, ctx);
+    ctx->adrsOps.setType(adrs, TREE);
+    ret = SlhDsaTreeHash(nodes, idx, height, leafIdx, auth, adrs, ctx);
     if (ret != CRYPT_SUCCESS) {
-        return ret;
+        goto ERR;
     }
-
-    // Hash children to get parent node
-    ctx->adrsOps.setType(adrs, TREE);
-    ctx->adrsOps.setTreeHeight(adrs, height);
-    ctx->adrsOps.setTreeIndex(adrs, idx);
-
-    uint8_t tmp[SLH_DSA_MAX_N * 2];
-    (void)memcpy_s(tmp, SLH_DSA_MAX_N * 2, leftNode, n);
-    (void)memcpy_s(tmp + n, SLH_DSA_MAX_N * 2 - n, rightNode, n);
-
-    return ctx->hashFuncs.h(ctx, adrs, tmp, 2 * n, node);
+    (void)memcpy_s(node, n, nodes, n);
+ERR:
+    BSL_SAL_Free(nodes);
+    return ret;
 }
 
-int32_t XmssSign(const uint8_t *msg, size_t msgLen, uint32_t idx, SlhDsaAdrs *adrs, const CryptSlhDsaCtx *ctx,
-                 uint8_t *sig, uint32_t *sigLen)
+int32_t XmssNode(uint8_t *node, uint32_t idx, uint32_t height, SlhDsaAdrs *adrs, const CryptSlhDsaCtx *ctx)
 {
-    int32_t ret;
-
-    uint32_t n = ctx->para.n;
-    uint32_t hp = ctx->para.hp;
-    uint32_t len = 2 * n + 3;
-
-    if (*sigLen < (len + hp) * n) {
-        return CRYPT_SLHDSA_ERR_SIG_LEN_NOT_ENOUGH;
-    }
-
-    for (uint32_t j = 0; j < hp; j++) {
-        uint32_t k = (idx >> j) ^ 1;
-        uint8_t node[SLH_DSA_MAX_N] = {0};
-        ret = XmssNode(node, k, j, adrs, ctx);
-        if (ret != CRYPT_SUCCESS) {
-            return ret;
-        }
-        (void)memcpy_s((sig + (len + j) * n), n, node, n);
+    if (node == NULL || adrs == NULL || ctx == NULL) {
+        return CRYPT_NULL_INPUT;
     }
+    return XmssSubtree(node, idx, height, 0, NULL, adrs, ctx);
+}
 
-    ctx->adrsOps.setType(adrs, WOTS_HASH);
-    ctx->adrsOps.setKeyPairAddr(adrs, idx);
-    uint32_t tmpLen = len * n;
-    ret = WotsSign(sig, &tmpLen, msg, msgLen, adrs, ctx);
-    if (ret != CRYPT_SUCCESS) {
-        return ret;
-    }
-    *sigLen = (len + hp) * n;
-    return CRYPT_SUCCESS;
+int32_t XmssAuthPath(uint32_t idx, SlhDsaAdrs *adrs, const CryptSlhDsaCtx *ctx, uint8_t *auth, uint8_t *root)
+{
+    return XmssSubtree(root, 0, ctx->para.hp, idx, auth, adrs, ctx);
 }
 
 int32_t XmssPkFromSig(uint32_t idx, const uint8_t *sig, uint32_t sigLen, const uint8_t *msg, uint32_t msgLen,
@@ -22,31 +22,28 @@
 #include <stdint.h>
 
 /**
- * @brief Sign a message using XMSS
+ * @brief Compute an internal node of the XMSS tree
  * 
- * @param sig Output XMSS signature
- * @param sigLen Length of the signature
- * @param msg Input message to sign
- * @param msgLen Length of the message
- * @param idx Index of the used WOTS+ key pair
+ * @param node Output internal node
+ * @param idx Node index at the given height
+ * @param height Node height in the tree
  * @param adrs Address structure for domain separation
  * @param ctx SLH-DSA context
  * @return int 0 on success, error code otherwise
  */
-int32_t XmssSign(const uint8_t *msg, size_t msgLen, uint32_t idx, SlhDsaAdrs *adrs, const CryptSlhDsaCtx *ctx,
-                 uint8_t *sig, uint32_t *sigLen);
+int32_t XmssNode(uint8_t *node, uint32_t idx, uint32_t height, SlhDsaAdrs *adrs, const CryptSlhDsaCtx *ctx);
 
 /**
- * @brief Compute an internal node of the XMSS tree
+ * @brief Compute the authentication path of a WOTS+ key pair and the root of the XMSS tree
  * 
- * @param node Output internal node
- * @param idx Node index at the given height
- * @param height Node height in the tree
+ * @param idx Index of the used WOTS+ key pair
  * @param adrs Address structure for domain separation
  * @param ctx SLH-DSA context
+ * @param auth Output authentication path, the length is hp * n
+ * @param root Output root of the XMSS tree, the length is n
  * @return int 0 on success, error code otherwise
  */
-int32_t XmssNode(uint8_t *node, uint32_t idx, uint32_t height, SlhDsaAdrs *adrs, const CryptSlhDsaCtx *ctx);
+int32_t XmssAuthPath(uint32_t idx, SlhDsaAdrs *adrs, const CryptSlhDsaCtx *ctx, uint8_t *auth, uint8_t *root);
 
 /**
  * @brief Compute a public key from a signature and message
@@ -150,6 +150,23 @@ int32_t CRYPT_SM2_Sign(const CRYPT_SM2_Ctx *ctx, int32_t algId, const uint8_t *d
  */
 int32_t CRYPT_SM2_Verify(const CRYPT_SM2_Ctx *ctx, int32_t algId, const uint8_t *data, uint32_t dataLen,
     const uint8_t *sign, uint32_t signLen);
+
+/**
+ * @ingroup sm2
+ * @brief SM2 verification of a batch of signatures, the Z digest is computed once for the items of the same key.
+ *
+ * @param ctxs [IN] sm2 context structures, ctxs[i] is the key of items[i]
+ * @param algId [IN] md algId
+ * @param items [IN] Messages and signatures
+ * @param num [IN] Number of items
+ * @param results [OUT] Verification result of every item, see CRYPT_SM2_Verify
+ *
+ * @retval CRYPT_NULL_INPUT         Invalid null pointer input
+ * @retval CRYPT_SUCCESS            All signatures are verified successfully.
+ * @retval Other error codes        The result of the first item that fails.
+ */
+int32_t CRYPT_SM2_VerifyBatch(const CRYPT_SM2_Ctx *const *ctxs, int32_t algId, const CRYPT_VerifyItem *items,
+    uint32_t num, int32_t *results);
 #endif
 
 /**
@@ -52,12 +52,16 @@ struct SM2_Ctx {
     uint8_t sumCheck[SM3_MD_SIZE]; // Hash value used as a check
     uint8_t sumSend[SM3_MD_SIZE]; // Hash value sent to the peer end
     uint8_t isSumValid; // Indicates whether the checksum is valid. 1: valid; 0: invalid.
+    uint8_t za[SM3_MD_SIZE]; // Z digest of the user ID and the public key
+    uint8_t isZaValid; // Indicates whether za is computed or imported. 1: valid; 0: to be computed.
     BSL_SAL_RefCount references;
 };
 
 /**
  * @ingroup sm2
  * @brief The sm2 invokes the SM3 to calculate the hash value.
+ *        The value is computed when the public key, the curve or the user ID is set, and only read here, unless
+ *        the public key has not been set yet.
  *
  * @param ctx [IN] sm2 context structure
  * @param out [IN/OUT] Hash value
@@ -107,9 +107,11 @@ CRYPT_SM2_Ctx *CRYPT_SM2_DupCtx(CRYPT_SM2_Ctx *ctx)
     newCtx->hashMethod = ctx->hashMethod;
     newCtx->server = ctx->server;
     newCtx->isSumValid = ctx->isSumValid;
+    newCtx->isZaValid = ctx->isZaValid;
     BSL_SAL_ReferencesInit(&(newCtx->references));
     (void)memcpy_s(newCtx->sumCheck, SM3_MD_SIZE, ctx->sumCheck, SM3_MD_SIZE);
     (void)memcpy_s(newCtx->sumSend, SM3_MD_SIZE, ctx->sumSend, SM3_MD_SIZE);
+    (void)memcpy_s(newCtx->za, SM3_MD_SIZE, ctx->za, SM3_MD_SIZE);
 
     return newCtx;
 ERR:
@@ -137,7 +139,7 @@ void CRYPT_SM2_FreeCtx(CRYPT_SM2_Ctx *ctx)
     return;
 }
 
-int32_t Sm2ComputeZDigest(const CRYPT_SM2_Ctx *ctx, uint8_t *out, uint32_t *outLen)
+static int32_t Sm2CalcZDigest(const CRYPT_SM2_Ctx *ctx, uint8_t *out, uint32_t *outLen)
 {
     int32_t ret;
     if (ctx->userIdLen >= (UINT16_MAX / 8)) {
@@ -196,8 +198,41 @@ ERR:
     return ret;
 }
 
+int32_t Sm2ComputeZDigest(const CRYPT_SM2_Ctx *ctx, uint8_t *out, uint32_t *outLen)
+{
+    if (*outLen < SM3_MD_SIZE) {
+        BSL_ERR_PUSH_ERROR(CRYPT_SM2_BUFF_LEN_NOT_ENOUGH);
+        return CRYPT_SM2_BUFF_LEN_NOT_ENOUGH;
+    }
+    // The ctx may be shared by the threads which sign or verify, so a missing za is not stored here.
+    if (ctx->isZaValid == 0) {
+        return Sm2CalcZDigest(ctx, out, outLen);
+    }
+    (void)memcpy_s(out, *outLen, ctx->za, SM3_MD_SIZE);
+    *outLen = SM3_MD_SIZE;
+    return CRYPT_SUCCESS;
+}
+
+// Compute the Z digest whenever the public key, the curve or the user ID is changed.
+static int32_t Sm2UpdateZDigest(CRYPT_SM2_Ctx *ctx)
+{
+    ctx->isZaValid = 0;
+    if (ctx->pkey->pubkey == NULL) {
+        return CRYPT_SUCCESS;
+    }
+    uint32_t zaLen = SM3_MD_SIZE;
+    int32_t ret = Sm2CalcZDigest(ctx, ctx->za, &zaLen);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    ctx->isZaValid = 1;
+    return CRYPT_SUCCESS;
+}
+
 #ifdef HITLS_CRYPTO_SM2_SIGN
-static int32_t Sm2ComputeMsgHash(const CRYPT_SM2_Ctx *ctx, const uint8_t *msg, uint32_t msgLen, BN_BigNum *e)
+// e = H(Z || M), z is the Z digest of the ctx.
+static int32_t Sm2ComputeMsgHashWithZ(const CRYPT_SM2_Ctx *ctx, const uint8_t *z, uint32_t zLen,
+    const uint8_t *msg, uint32_t msgLen, BN_BigNum *e)
 {
     int ret;
     uint8_t out[SM3_MD_SIZE];
@@ -208,9 +243,8 @@ static int32_t Sm2ComputeMsgHash(const CRYPT_SM2_Ctx *ctx, const uint8_t *msg, u
         BSL_ERR_PUSH_ERROR(ret);
         goto ERR;
     }
-    GOTO_ERR_IF_EX(Sm2ComputeZDigest(ctx, out, &outLen), ret);
     GOTO_ERR_IF(ctx->hashMethod->init(mdCtx, NULL), ret);
-    GOTO_ERR_IF(ctx->hashMethod->update(mdCtx, out, outLen), ret);
+    GOTO_ERR_IF(ctx->hashMethod->update(mdCtx, z, zLen), ret);
     GOTO_ERR_IF(ctx->hashMethod->update(mdCtx, msg, msgLen), ret);
     GOTO_ERR_IF(ctx->hashMethod->final(mdCtx, out, &outLen), ret);
     GOTO_ERR_IF_EX(BN_Bin2Bn(e, out, outLen), ret);
@@ -218,6 +252,17 @@ ERR:
     ctx->hashMethod->freeCtx(mdCtx);
     return ret;
 }
+
+static int32_t Sm2ComputeMsgHash(const CRYPT_SM2_Ctx *ctx, const uint8_t *msg, uint32_t msgLen, BN_BigNum *e)
+{
+    uint8_t z[SM3_MD_SIZE];
+    uint32_t zLen = sizeof(z);
+    int32_t ret = Sm2ComputeZDigest(ctx, z, &zLen);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    return Sm2ComputeMsgHashWithZ(ctx, z, zLen, msg, msgLen, e);
+}
 #endif
 
 uint32_t CRYPT_SM2_GetBits(const CRYPT_SM2_Ctx *ctx)
@@ -244,7 +289,12 @@ int32_t CRYPT_SM2_SetPubKey(CRYPT_SM2_Ctx *ctx, const BSL_Param *para)
         BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
         return CRYPT_NULL_INPUT;
     }
-    return ECC_PkeySetPubKey(ctx->pkey, para);
+    int32_t ret = ECC_PkeySetPubKey(ctx->pkey, para);
+    if (ret != CRYPT_SUCCESS) {
+        ctx->isZaValid = 0;
+        return ret;
+    }
+    return Sm2UpdateZDigest(ctx);
 }
 
 int32_t CRYPT_SM2_GetPrvKey(const CRYPT_SM2_Ctx *ctx, BSL_Param *para)
@@ -273,8 +323,12 @@ int32_t CRYPT_SM2_Gen(CRYPT_SM2_Ctx *ctx)
         BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
         return CRYPT_NULL_INPUT;
     }
-
-    return ECC_PkeyGen(ctx->pkey);
+    int32_t ret = ECC_PkeyGen(ctx->pkey);
+    if (ret != CRYPT_SUCCESS) {
+        ctx->isZaValid = 0;
+        return ret;
+    }
+    return Sm2UpdateZDigest(ctx);
 }
 
 #ifdef HITLS_CRYPTO_PROVIDER
@@ -594,7 +648,7 @@ static int32_t IsParaVaild(const CRYPT_SM2_Ctx *ctx)
     return CRYPT_SUCCESS;
 }
 
-int32_t CRYPT_SM2_Verify(const CRYPT_SM2_Ctx *ctx, int32_t algId, const uint8_t *data, uint32_t dataLen,
+static int32_t Sm2VerifyCheck(const CRYPT_SM2_Ctx *ctx, int32_t algId, const uint8_t *data, uint32_t dataLen,
     const uint8_t *sign, uint32_t signLen)
 {
     if (algId != CRYPT_MD_SM3) {
@@ -605,11 +659,15 @@ int32_t CRYPT_SM2_Verify(const CRYPT_SM2_Ctx *ctx, int32_t algId, const uint8_t
         BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
         return CRYPT_NULL_INPUT;
     }
+    return IsParaVaild(ctx);
+}
+
+// Verify the signature with the Z digest of the ctx, the input parameters have been checked by Sm2VerifyCheck.
+static int32_t Sm2VerifyWithZ(const CRYPT_SM2_Ctx *ctx, const uint8_t *z, uint32_t zLen, const uint8_t *data,
+    uint32_t dataLen, const uint8_t *sign, uint32_t signLen)
+{
+    int32_t ret;
     uint32_t keyBits = CRYPT_SM2_GetBits(ctx);
-    int32_t ret = IsParaVaild(ctx);
-    if (ret != CRYPT_SUCCESS) {
-        return ret;
-    }
     BN_BigNum *r = BN_Create(keyBits);
     BN_BigNum *s = BN_Create(keyBits);
     BN_BigNum *e = BN_Create(keyBits);
@@ -618,7 +676,7 @@ int32_t CRYPT_SM2_Verify(const CRYPT_SM2_Ctx *ctx, int32_t algId, const uint8_t
         BSL_ERR_PUSH_ERROR(ret);
         goto ERR;
     }
-    GOTO_ERR_IF_EX(Sm2ComputeMsgHash(ctx, data, dataLen, e), ret);
+    GOTO_ERR_IF_EX(Sm2ComputeMsgHashWithZ(ctx, z, zLen, data, dataLen, e), ret);
     GOTO_ERR_IF(CRYPT_EAL_DecodeSign(sign, signLen, r, s), ret);
     // Verify that r->s and s->s are within the range of 1~n-1.
     GOTO_ERR_IF_EX(VerifyCheckSign(ctx, r, s), ret);
@@ -629,6 +687,52 @@ ERR:
     BN_Destroy(e);
     return ret;
 }
+
+int32_t CRYPT_SM2_Verify(const CRYPT_SM2_Ctx *ctx, int32_t algId, const uint8_t *data, uint32_t dataLen,
+    const uint8_t *sign, uint32_t signLen)
+{
+    int32_t ret = Sm2VerifyCheck(ctx, algId, data, dataLen, sign, signLen);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    uint8_t z[SM3_MD_SIZE];
+    uint32_t zLen = sizeof(z);
+    ret = Sm2ComputeZDigest(ctx, z, &zLen);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    return Sm2VerifyWithZ(ctx, z, zLen, data, dataLen, sign, signLen);
+}
+
+int32_t CRYPT_SM2_VerifyBatch(const CRYPT_SM2_Ctx *const *ctxs, int32_t algId, const CRYPT_VerifyItem *items,
+    uint32_t num, int32_t *results)
+{
+    if (ctxs == NULL || items == NULL || results == NULL || num == 0) {
+        BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
+        return CRYPT_NULL_INPUT;
+    }
+    uint8_t z[SM3_MD_SIZE];
+    uint32_t zLen = sizeof(z);
+    const CRYPT_SM2_Ctx *zCtx = NULL; // The ctx of z, consecutive items of the same key share it.
+    int32_t first = CRYPT_SUCCESS;
+    for (uint32_t i = 0; i < num; i++) {
+        const CRYPT_VerifyItem *item = &items[i];
+        int32_t ret = Sm2VerifyCheck(ctxs[i], algId, item->data, item->dataLen, item->sign, item->signLen);
+        if (ret == CRYPT_SUCCESS && ctxs[i] != zCtx) {
+            zLen = sizeof(z);
+            ret = Sm2ComputeZDigest(ctxs[i], z, &zLen);
+            zCtx = (ret == CRYPT_SUCCESS) ? ctxs[i] : NULL;
+        }
+        if (ret == CRYPT_SUCCESS) {
+            ret = Sm2VerifyWithZ(ctxs[i], z, zLen, item->data, item->dataLen, item->sign, item->signLen);
+        }
+        results[i] = ret;
+        if (first == CRYPT_SUCCESS) {
+            first = ret;
+        }
+    }
+    return first;
+}
 #endif
 
 static void Sm2Clean(CRYPT_SM2_Ctx *ctx)
@@ -835,8 +939,54 @@ static int32_t CtrlUserId(CRYPT_SM2_Ctx *ctx, const void *val, uint32_t len)
         BSL_ERR_PUSH_ERROR(CRYPT_ECC_PKEY_ERR_CTRL_LEN);
         return CRYPT_ECC_PKEY_ERR_CTRL_LEN;
     }
+    // The same ID is set before every signature by some callers, keep the Z digest then.
+    if (ctx->userId != NULL && ctx->userIdLen == len && memcmp(ctx->userId, val, len) == 0) {
+        return CRYPT_SUCCESS;
+    }
     BSL_SAL_FREE(ctx->userId);
-    return Sm2SetUserId(ctx, val, len);
+    ctx->userIdLen = 0;
+    int32_t ret = Sm2SetUserId(ctx, val, len);
+    if (ret != CRYPT_SUCCESS) {
+        ctx->isZaValid = 0;
+        return ret;
+    }
+    return Sm2UpdateZDigest(ctx);
+}
+
+static int32_t CtrlSetZa(CRYPT_SM2_Ctx *ctx, const void *val, uint32_t len)
+{
+    if (val == NULL) {
+        BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
+        return CRYPT_NULL_INPUT;
+    }
+    if (len != SM3_MD_SIZE) {
+        BSL_ERR_PUSH_ERROR(CRYPT_SM2_ERR_CTRL_LEN);
+        return CRYPT_SM2_ERR_CTRL_LEN;
+    }
+    (void)memcpy_s(ctx->za, SM3_MD_SIZE, val, len);
+    ctx->isZaValid = 1;
+    return CRYPT_SUCCESS;
+}
+
+static int32_t CtrlGetZa(CRYPT_SM2_Ctx *ctx, void *val, uint32_t len)
+{
+    if (val == NULL) {
+        BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
+        return CRYPT_NULL_INPUT;
+    }
+    if (len != SM3_MD_SIZE) {
+        BSL_ERR_PUSH_ERROR(CRYPT_SM2_ERR_CTRL_LEN);
+        return CRYPT_SM2_ERR_CTRL_LEN;
+    }
+    if (ctx->isZaValid == 0 && (ctx->pkey == NULL || ctx->pkey->pubkey == NULL)) {
+        BSL_ERR_PUSH_ERROR(CRYPT_SM2_NO_PUBKEY);
+        return CRYPT_SM2_NO_PUBKEY;
+    }
+    if (ctx->isZaValid == 0 && ctx->hashMethod == NULL) {
+        BSL_ERR_PUSH_ERROR(CRYPT_SM2_ERR_NO_HASH_METHOD);
+        return CRYPT_SM2_ERR_NO_HASH_METHOD;
+    }
+    return Sm2ComputeZDigest(ctx, val, &len);
 }
 
 static int32_t Sm2SetPKG(CRYPT_SM2_Ctx *ctx, const void *val, uint32_t len)
@@ -920,6 +1070,21 @@ int32_t CRYPT_SM2_Ctrl(CRYPT_SM2_Ctx *ctx, int32_t opt, void *val, uint32_t len)
         case CRYPT_CTRL_UP_REFERENCES:
             ret = SM2UpReferences(ctx, val, len);
             break;
+        case CRYPT_CTRL_SET_SM2_ZA:
+            ret = CtrlSetZa(ctx, val, len);
+            break;
+        case CRYPT_CTRL_GET_SM2_ZA:
+            ret = CtrlGetZa(ctx, val, len);
+            break;
+        case CRYPT_CTRL_SET_PARA_BY_ID:
+        case CRYPT_CTRL_GEN_ECC_PUBLICKEY:
+            ret = ECC_PkeyCtrl(ctx->pkey, opt, val, len);
+            if (ret == CRYPT_SUCCESS) {
+                ret = Sm2UpdateZDigest(ctx);
+            } else {
+                ctx->isZaValid = 0;
+            }
+            break;
         default:
             ret = ECC_PkeyCtrl(ctx->pkey, opt, val, len);
             break;
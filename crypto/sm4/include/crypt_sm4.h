@@ -245,6 +245,25 @@ int32_t CRYPT_SM4_CTR_Encrypt(CRYPT_SM4_Ctx *ctx, const uint8_t *in, uint8_t *ou
 int32_t CRYPT_SM4_CTR_Decrypt(CRYPT_SM4_Ctx *ctx, const uint8_t *in, uint8_t *out, uint32_t len, uint8_t *iv);
 #endif
 
+#if defined(HITLS_CRYPTO_GCM) && defined(__x86_64__)
+/**
+ * @brief SM4-GCM bulk encryption or decryption, the counter mode and GHASH are computed in one pass.
+ *        Only whole groups of 32 blocks are processed, and nothing without AVX-512, GFNI and VPCLMULQDQ.
+ * @param ctx [IN] sm4 Context
+ * @param in [IN] Input data
+ * @param out [OUT] Output data
+ * @param len [IN] Length of the input data
+ * @param iv [IN/OUT] Counter block, increased by the number of blocks processed
+ * @param ghash [IN/OUT] GHASH value
+ * @param hTable [IN] GHASH key table of the GCM context, see GcmTableGen4bit
+ * @param enc [IN] true for encryption
+ *
+ * @return Number of bytes processed
+ */
+uint32_t CRYPT_SM4_GCM_CryptWide(const CRYPT_SM4_Ctx *ctx, const uint8_t *in, uint8_t *out, uint32_t len,
+    uint8_t *iv, uint8_t *ghash, const void *hTable, bool enc);
+#endif
+
 #ifdef HITLS_CRYPTO_OFB
 /**
  * @brief SM4 OFB mode encryption (optimized).
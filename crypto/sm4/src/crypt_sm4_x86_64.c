@@ -46,6 +46,13 @@ void SM4_XTS_Calculate_Tweak(unsigned char *t, const unsigned int idx)
     }
 }
 
+static void SM4_XTS_CryptBlocks(const uint8_t *in, uint8_t *out, uint32_t len, const uint32_t *rk, uint8_t *t)
+{
+    if (!SM4_XTS_EncryptBlocksWide(in, out, len, rk, t)) {
+        SM4_XTS_Encrypt_Blocks(in, out, len, rk, t);
+    }
+}
+
 static void SM4_XTS_Encrypt_Helper(uint32_t left, const uint32_t dataLen, uint8_t* t, uint8_t *x,
                                    const uint8_t* plain, uint8_t* cipher, const uint32_t* dataRk)
 {
@@ -111,7 +118,7 @@ int32_t SM4_XTS_En(uint8_t* cipher, const uint8_t* plain, const uint32_t* dataRk
     memcpy_s(t, CRYPT_SM4_BLOCKSIZE_16, tweak, CRYPT_SM4_BLOCKSIZE);
 
     if (dataLen >= CRYPT_SM4_BLOCKSIZE_16) {
-        SM4_XTS_Encrypt_Blocks(plain, cipher, dataLen, dataRk, t);
+        SM4_XTS_CryptBlocks(plain, cipher, dataLen, dataRk, t);
     }
 
     if (left == 0) {
@@ -205,7 +212,7 @@ int32_t SM4_XTS_De(uint8_t* plain, const uint8_t* cipher, const uint32_t* dataRk
     (void)memcpy_s(t, CRYPT_SM4_BLOCKSIZE_16, tweak, CRYPT_SM4_BLOCKSIZE);
 
     if (dataLen >= CRYPT_SM4_BLOCKSIZE_16) {
-        SM4_XTS_Encrypt_Blocks(cipher, plain, dataLen, dataRk, t);
+        SM4_XTS_CryptBlocks(cipher, plain, dataLen, dataRk, t);
     }
 
     if (left != 0) {
@@ -433,13 +440,19 @@ int32_t CRYPT_SM4_CFB_Decrypt(CRYPT_SM4_Ctx *ctx, const uint8_t *in, uint8_t *ou
 #endif
 
 #if defined(HITLS_CRYPTO_CTR) || defined(HITLS_CRYPTO_GCM)
+static void SM4_CTR_CryptBlocks(const uint8_t *in, uint8_t *out, uint32_t blocks, const uint32_t *rk, uint8_t *iv)
+{
+    uint64_t done = SM4_CTR_EncryptBlocksWide(in, out, blocks, rk, iv);
+    SM4_CTR_EncryptBlocks(in + done * CRYPT_SM4_BLOCKSIZE, out + done * CRYPT_SM4_BLOCKSIZE, blocks - done, rk, iv);
+}
+
 int32_t CRYPT_SM4_CTR_Encrypt(CRYPT_SM4_Ctx *ctx, const uint8_t *in, uint8_t *out, uint32_t len, uint8_t *iv)
 {
     if (ctx == NULL) {
         BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
         return CRYPT_NULL_INPUT;
     }
-    SM4_CTR_EncryptBlocks(in, out, len, ctx->rk, iv);
+    SM4_CTR_CryptBlocks(in, out, len, ctx->rk, iv);
     return CRYPT_SUCCESS;
 }
 
@@ -449,9 +462,19 @@ int32_t CRYPT_SM4_CTR_Decrypt(CRYPT_SM4_Ctx *ctx, const uint8_t *in, uint8_t *ou
         BSL_ERR_PUSH_ERROR(CRYPT_NULL_INPUT);
         return CRYPT_NULL_INPUT;
     }
-    SM4_CTR_EncryptBlocks(in, out, len, ctx->rk, iv);
+    SM4_CTR_CryptBlocks(in, out, len, ctx->rk, iv);
     return CRYPT_SUCCESS;
 }
 #endif
 
+#ifdef HITLS_CRYPTO_GCM
+uint32_t CRYPT_SM4_GCM_CryptWide(const CRYPT_SM4_Ctx *ctx, const uint8_t *in, uint8_t *out, uint32_t len,
+    uint8_t *iv, uint8_t *ghash, const void *hTable, bool enc)
+{
+    uint32_t blocks = SM4_GCM_CryptBlocksWide(in, out, len / CRYPT_SM4_BLOCKSIZE, ctx->rk, iv, ghash,
+        (const uint8_t *)hTable, enc);
+    return blocks * CRYPT_SM4_BLOCKSIZE;
+}
+#endif
+
 #endif /* HITLS_CRYPTO_SM4 */
@@ -20,6 +20,7 @@
 #ifdef HITLS_CRYPTO_SM4
 
 #include <stdint.h>
+#include <stdbool.h>
 
 void SM4_SetEncKey(const uint8_t *key, uint32_t *rk);
 
@@ -40,5 +41,18 @@ void SM4_CFB128_Encrypt(const uint8_t *in, uint8_t *out, uint64_t len, const uin
 void SM4_CFB128_Decrypt(const uint8_t *in, uint8_t *out, uint64_t len, const uint32_t *key, uint8_t *iv, int *num);
 void SM4_CTR_EncryptBlocks(const uint8_t *in, uint8_t *out, uint64_t blocks, const uint32_t *key, const uint8_t *iv);
 
+/*
+ * Wide kernels for AVX-512 + GFNI or AVX2 + VAES CPUs, see x8664_sm4_wide.c. They only process whole groups of
+ * blocks and do nothing on the other CPUs.
+ */
+// Returns the number of blocks processed, the counter in iv is increased as SM4_CTR_EncryptBlocks does.
+uint64_t SM4_CTR_EncryptBlocksWide(const uint8_t *in, uint8_t *out, uint64_t blocks, const uint32_t *key,
+    uint8_t *iv);
+// Same as SM4_XTS_Encrypt_Blocks, returns false if there is no wide kernel.
+bool SM4_XTS_EncryptBlocksWide(const uint8_t *in, uint8_t *out, uint64_t len, const uint32_t *key, uint8_t *t);
+// SM4-CTR and GHASH in one pass, returns the number of blocks processed. Needs AVX-512 + GFNI + VPCLMULQDQ.
+uint32_t SM4_GCM_CryptBlocksWide(const uint8_t *in, uint8_t *out, uint32_t blocks, const uint32_t *key,
+    uint8_t *iv, uint8_t *ghash, const uint8_t *hTable, bool enc);
+
 #endif /* HITLS_CRYPTO_SM4 */
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
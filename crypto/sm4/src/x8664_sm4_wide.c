@@ -0,0 +1,584 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include "hitls_build.h"
+#if defined(HITLS_CRYPTO_SM4) && defined(__x86_64__)
+
+#include <immintrin.h>
+#include "securec.h"
+#include "bsl_sal.h"
+#include "crypt_utils.h"
+#include "crypt_sm4.h"
+#include "crypt_sm4_x86_64.h"
+
+/*
+ * Wide SM4 kernels. The blocks are transposed so that register k holds the word k of every block, and two groups
+ * of registers are interleaved to hide the latency of the rounds:
+ *   - AVX-512 + GFNI: the S-box is two affine instructions, 2 * 16 blocks per iteration in zmm registers.
+ *   - AVX2 + VAES (CPUs without GFNI): the S-box goes through AESENCLAST on ymm registers, 2 * 8 blocks.
+ * In the transposed order, the dword m of the 128-bit lane l of a register belongs to the block 4 * m + l for zmm
+ * and 2 * m + l for ymm.
+ */
+#define SM4_AVX512 __attribute__((target("avx512f,avx512bw,avx512vl,gfni")))
+#define SM4_AVX512_GCM __attribute__((target("avx512f,avx512bw,avx512vl,gfni,vpclmulqdq")))
+#define SM4_VAES256 __attribute__((target("avx2,aes,vaes")))
+
+#define SM4_PRE_AFFINE   0x4c287db91a22505dULL // A1 of S(x) = A2 * inv(A1 * x + C1) + C2
+#define SM4_PRE_CONST    0x3e
+#define SM4_POST_AFFINE  0xf3ab34a974a6b589ULL
+#define SM4_POST_CONST   0xd3
+#define SM4_WORDS        4
+#define SM4_XTS_TWEAK_POLY 0xe100000000000000ULL
+
+#define SM4_AVX512_BLOCKS 32
+#define SM4_AVX512_HALF   16
+#define SM4_VAES_BLOCKS   16
+
+static bool Sm4SupportAvx512(void)
+{
+    return IsSupportAVX512F() && IsSupportAVX512BW() && IsSupportAVX512VL() && IsOSSupportAVX512() &&
+        IsSupportGFNI();
+}
+
+// The AVX2 assembly already uses GFNI when it exists, VAES only pays off on the CPUs without it.
+static bool Sm4SupportVaes256(void)
+{
+    return IsSupportAVX() && IsOSSupportAVX() && IsSupportAVX2() && IsSupportVAES() && !IsSupportGFNI();
+}
+
+/* The XTS tweaks of n consecutive blocks, hi:lo is the big-endian tweak of the first one and becomes the next. */
+static void Sm4XtsTweaks(uint64_t *hi, uint64_t *lo, uint8_t *tw, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        PUT_UINT64_BE(*hi, tw, i * CRYPT_SM4_BLOCKSIZE);
+        PUT_UINT64_BE(*lo, tw, i * CRYPT_SM4_BLOCKSIZE + 8); // the low 8 bytes
+        uint64_t carry = (0 - (*lo & 1)) & SM4_XTS_TWEAK_POLY;
+        *lo = (*lo >> 1) | (*hi << 63); // 63: the low bit of hi moves to the top of lo
+        *hi = (*hi >> 1) ^ carry;
+    }
+}
+
+/* ---------------------------------------- AVX-512 + GFNI ---------------------------------------- */
+
+SM4_AVX512 static inline __m512i Sm4TAvx512(__m512i x)
+{
+    x = _mm512_gf2p8affine_epi64_epi8(x, _mm512_set1_epi64((long long)SM4_PRE_AFFINE), SM4_PRE_CONST);
+    x = _mm512_gf2p8affineinv_epi64_epi8(x, _mm512_set1_epi64((long long)SM4_POST_AFFINE), SM4_POST_CONST);
+    // L(B) = B ^ (B <<< 2) ^ (B <<< 10) ^ (B <<< 18) ^ (B <<< 24), 0x96 is the three-way XOR
+    __m512i t = _mm512_ternarylogic_epi32(x, _mm512_rol_epi32(x, 2), _mm512_rol_epi32(x, 10), 0x96);
+    return _mm512_ternarylogic_epi32(t, _mm512_rol_epi32(x, 18), _mm512_rol_epi32(x, 24), 0x96);
+}
+
+#define SM4_ROUND_AVX512(a0, a1, a2, a3, k) \
+    (a0) = _mm512_xor_si512((a0), Sm4TAvx512(_mm512_ternarylogic_epi32((a1), (a2), _mm512_xor_si512((a3), (k)), 0x96)))
+
+// 32 rounds on the transposed words x[0..3] of 16 blocks, and x[4..7] of 16 more if two is set.
+SM4_AVX512 static inline void Sm4RoundsAvx512(__m512i x[8], const uint32_t *rk, bool two)
+{
+    for (uint32_t i = 0; i < CRYPT_SM4_ROUNDS; i += SM4_WORDS) {
+        __m512i k0 = _mm512_set1_epi32((int)rk[i]);
+        __m512i k1 = _mm512_set1_epi32((int)rk[i + 1]);
+        __m512i k2 = _mm512_set1_epi32((int)rk[i + 2]);
+        __m512i k3 = _mm512_set1_epi32((int)rk[i + 3]);
+        if (two) {
+            SM4_ROUND_AVX512(x[0], x[1], x[2], x[3], k0);
+            SM4_ROUND_AVX512(x[4], x[5], x[6], x[7], k0);
+            SM4_ROUND_AVX512(x[1], x[2], x[3], x[0], k1);
+            SM4_ROUND_AVX512(x[5], x[6], x[7], x[4], k1);
+            SM4_ROUND_AVX512(x[2], x[3], x[0], x[1], k2);
+            SM4_ROUND_AVX512(x[6], x[7], x[4], x[5], k2);
+            SM4_ROUND_AVX512(x[3], x[0], x[1], x[2], k3);
+            SM4_ROUND_AVX512(x[7], x[4], x[5], x[6], k3);
+        } else {
+            SM4_ROUND_AVX512(x[0], x[1], x[2], x[3], k0);
+            SM4_ROUND_AVX512(x[1], x[2], x[3], x[0], k1);
+            SM4_ROUND_AVX512(x[2], x[3], x[0], x[1], k2);
+            SM4_ROUND_AVX512(x[3], x[0], x[1], x[2], k3);
+        }
+    }
+}
+
+// 4x4 transposition of the dwords inside every 128-bit lane.
+SM4_AVX512 static inline void Sm4TransposeAvx512(__m512i *a0, __m512i *a1, __m512i *a2, __m512i *a3)
+{
+    __m512i t0 = _mm512_unpacklo_epi32(*a0, *a1);
+    __m512i t1 = _mm512_unpackhi_epi32(*a0, *a1);
+    __m512i t2 = _mm512_unpacklo_epi32(*a2, *a3);
+    __m512i t3 = _mm512_unpackhi_epi32(*a2, *a3);
+    *a0 = _mm512_unpacklo_epi64(t0, t2);
+    *a1 = _mm512_unpackhi_epi64(t0, t2);
+    *a2 = _mm512_unpacklo_epi64(t1, t3);
+    *a3 = _mm512_unpackhi_epi64(t1, t3);
+}
+
+SM4_AVX512 static inline __m512i Sm4Bswap32Avx512(__m512i x)
+{
+    const __m512i mask = _mm512_broadcast_i32x4(_mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+    return _mm512_shuffle_epi8(x, mask);
+}
+
+// Blocks of 64-byte rows r[0..3] to the transposed host-order words.
+SM4_AVX512 static inline void Sm4LoadAvx512(__m512i r[SM4_WORDS])
+{
+    for (uint32_t i = 0; i < SM4_WORDS; i++) {
+        r[i] = Sm4Bswap32Avx512(r[i]);
+    }
+    Sm4TransposeAvx512(&r[0], &r[1], &r[2], &r[3]);
+}
+
+// The output words are X35, X34, X33, X32, back to 64-byte rows of blocks.
+SM4_AVX512 static inline void Sm4StoreAvx512(__m512i x[SM4_WORDS])
+{
+    __m512i t = x[0];
+    x[0] = x[3];
+    x[3] = t;
+    t = x[1];
+    x[1] = x[2];
+    x[2] = t;
+    Sm4TransposeAvx512(&x[0], &x[1], &x[2], &x[3]);
+    for (uint32_t i = 0; i < SM4_WORDS; i++) {
+        x[i] = Sm4Bswap32Avx512(x[i]);
+    }
+}
+
+// Counter blocks iv, iv + 1, ... of the lanes of x[0..3], then x[4..7] from iv + 16.
+SM4_AVX512 static inline void Sm4CounterAvx512(__m512i x[8], const uint8_t *iv, uint32_t ctr)
+{
+    const __m512i idx = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+    for (uint32_t i = 0; i < SM4_WORDS - 1; i++) {
+        x[i] = _mm512_set1_epi32((int)GET_UINT32_BE(iv, i * SM4_WORDS));
+        x[i + SM4_WORDS] = x[i];
+    }
+    x[3] = _mm512_add_epi32(_mm512_set1_epi32((int)ctr), idx);
+    x[7] = _mm512_add_epi32(x[3], _mm512_set1_epi32(SM4_AVX512_HALF));
+}
+
+SM4_AVX512 static uint64_t Sm4CtrAvx512(const uint8_t *in, uint8_t *out, uint64_t blocks, const uint32_t *rk,
+    uint8_t *iv)
+{
+    uint32_t ctr = GET_UINT32_BE(iv, 12); // the 32-bit counter is the last 4 bytes
+    uint64_t done = 0;
+    for (; blocks - done >= SM4_AVX512_HALF; ) {
+        bool two = blocks - done >= SM4_AVX512_BLOCKS;
+        __m512i x[8];
+        Sm4CounterAvx512(x, iv, ctr);
+        Sm4RoundsAvx512(x, rk, two);
+        for (uint32_t g = 0; g < (two ? 2u : 1u); g++) {
+            Sm4StoreAvx512(&x[g * SM4_WORDS]);
+            for (uint32_t i = 0; i < SM4_WORDS; i++) {
+                uint64_t off = (done + g * SM4_AVX512_HALF) * CRYPT_SM4_BLOCKSIZE + i * 64; // 64 bytes per row
+                __m512i d = _mm512_loadu_si512((const void *)(in + off));
+                _mm512_storeu_si512((void *)(out + off), _mm512_xor_si512(d, x[g * SM4_WORDS + i]));
+            }
+        }
+        uint32_t n = two ? SM4_AVX512_BLOCKS : SM4_AVX512_HALF;
+        ctr += n;
+        done += n;
+    }
+    PUT_UINT32_BE(ctr, iv, 12); // the 32-bit counter is the last 4 bytes
+    return done;
+}
+
+SM4_AVX512 static void Sm4XtsAvx512(const uint8_t *in, uint8_t *out, uint64_t groups, const uint32_t *rk,
+    uint8_t *t)
+{
+    uint8_t tw[SM4_AVX512_BLOCKS * CRYPT_SM4_BLOCKSIZE];
+    uint64_t hi = ((uint64_t)GET_UINT32_BE(t, 0) << 32) | GET_UINT32_BE(t, 4);  // 32: high word, 4: second word
+    uint64_t lo = ((uint64_t)GET_UINT32_BE(t, 8) << 32) | GET_UINT32_BE(t, 12); // 32: high word, 8/12: low words
+    uint8_t *last = tw;
+    while (groups > 0) {
+        bool two = groups >= 2; // one group is 16 blocks
+        uint32_t sets = two ? 2u : 1u;
+        Sm4XtsTweaks(&hi, &lo, tw, sets * SM4_AVX512_HALF);
+        __m512i x[8];
+        __m512i tv[8];
+        for (uint32_t i = 0; i < sets * SM4_WORDS; i++) {
+            tv[i] = _mm512_loadu_si512((const void *)(tw + i * 64)); // 64 bytes per row
+            x[i] = _mm512_xor_si512(_mm512_loadu_si512((const void *)(in + i * 64)), tv[i]);
+        }
+        for (uint32_t g = 0; g < sets; g++) {
+            Sm4LoadAvx512(&x[g * SM4_WORDS]);
+        }
+        Sm4RoundsAvx512(x, rk, two);
+        for (uint32_t g = 0; g < sets; g++) {
+            Sm4StoreAvx512(&x[g * SM4_WORDS]);
+        }
+        for (uint32_t i = 0; i < sets * SM4_WORDS; i++) {
+            _mm512_storeu_si512((void *)(out + i * 64), _mm512_xor_si512(x[i], tv[i])); // 64 bytes per row
+        }
+        last = tw + (sets - 1) * CRYPT_SM4_BLOCKSIZE_16;
+        in += sets * CRYPT_SM4_BLOCKSIZE_16;
+        out += sets * CRYPT_SM4_BLOCKSIZE_16;
+        groups -= sets;
+    }
+    // As SM4_XTS_Encrypt_Blocks, t keeps the tweaks of the last 16 blocks.
+    (void)memcpy_s(t, CRYPT_SM4_BLOCKSIZE_16, last, CRYPT_SM4_BLOCKSIZE_16);
+    BSL_SAL_CleanseData(tw, sizeof(tw));
+}
+
+/* --------------------------------- AVX-512 + GFNI + VPCLMULQDQ GCM ---------------------------------- */
+#ifdef HITLS_CRYPTO_GCM
+
+/*
+ * GHASH follows ghash_x86_64.S: the blocks are byte-reversed and multiplied by the twisted H of GcmTableGen4bit,
+ * H^1..H^4 are at the entries 0, 1, 3 and 4 of its table.
+ */
+#define GHASH_POLY 0xc200000000000000ULL
+#define GHASH_H1_OFF 0x00
+#define GHASH_H2_OFF 0x10
+#define GHASH_H3_OFF 0x30
+#define GHASH_H4_OFF 0x40
+
+SM4_AVX512_GCM static inline __m512i GhashBswapAvx512(__m512i x)
+{
+    const __m512i mask = _mm512_broadcast_i32x4(_mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+    return _mm512_shuffle_epi8(x, mask);
+}
+
+// Reduction of the 256-bit products hi:lo of every lane, as REDUCTION_256BIT.
+SM4_AVX512_GCM static inline __m512i GhashReduceAvx512(__m512i lo, __m512i hi)
+{
+    const __m512i poly = _mm512_set1_epi64((long long)GHASH_POLY);
+    __m512i t = _mm512_alignr_epi8(lo, lo, 8); // swap the two halves
+    lo = _mm512_xor_si512(_mm512_clmulepi64_epi128(lo, poly, 0x10), t);
+    t = _mm512_alignr_epi8(lo, lo, 8); // swap the two halves
+    lo = _mm512_clmulepi64_epi128(lo, poly, 0x10);
+    return _mm512_ternarylogic_epi64(lo, t, hi, 0x96);
+}
+
+// Lane-wise products a * b
+SM4_AVX512_GCM static inline __m512i GhashMulAvx512(__m512i a, __m512i b)
+{
+    __m512i lo = _mm512_clmulepi64_epi128(a, b, 0x00);
+    __m512i hi = _mm512_clmulepi64_epi128(a, b, 0x11);
+    __m512i mid = _mm512_xor_si512(_mm512_clmulepi64_epi128(a, b, 0x01), _mm512_clmulepi64_epi128(a, b, 0x10));
+    lo = _mm512_xor_si512(lo, _mm512_bslli_epi128(mid, 8));
+    hi = _mm512_xor_si512(hi, _mm512_bsrli_epi128(mid, 8));
+    return GhashReduceAvx512(lo, hi);
+}
+
+// hp[0..3] = {H^16..H^13}, {H^12..H^9}, {H^8..H^5}, {H^4..H^1}, the lane 0 holds the highest power.
+SM4_AVX512_GCM static void GhashPowersAvx512(const uint8_t *hTable, __m512i hp[SM4_WORDS])
+{
+    __m128i h1 = _mm_loadu_si128((const __m128i *)(uintptr_t)(hTable + GHASH_H1_OFF));
+    __m128i h2 = _mm_loadu_si128((const __m128i *)(uintptr_t)(hTable + GHASH_H2_OFF));
+    __m128i h3 = _mm_loadu_si128((const __m128i *)(uintptr_t)(hTable + GHASH_H3_OFF));
+    __m128i h4 = _mm_loadu_si128((const __m128i *)(uintptr_t)(hTable + GHASH_H4_OFF));
+    hp[3] = _mm512_inserti32x4(_mm512_castsi128_si512(h4), h3, 1);
+    hp[3] = _mm512_inserti32x4(hp[3], h2, 2); // lane 2
+    hp[3] = _mm512_inserti32x4(hp[3], h1, 3); // lane 3
+    hp[2] = GhashMulAvx512(hp[3], _mm512_broadcast_i32x4(h4));
+    __m512i h8 = _mm512_broadcast_i32x4(_mm512_castsi512_si128(hp[2]));
+    hp[1] = GhashMulAvx512(hp[3], h8);
+    hp[0] = GhashMulAvx512(hp[2], h8);
+}
+
+// xi = (xi + d[0]) * H^16 + d[1] * H^15 + ... for the 16 byte-reversed blocks of d[0..3].
+SM4_AVX512_GCM static inline __m128i Ghash16Avx512(__m128i xi, const __m512i d[SM4_WORDS],
+    const __m512i hp[SM4_WORDS])
+{
+    __m512i a = _mm512_xor_si512(d[0], _mm512_zextsi128_si512(xi));
+    __m512i lo = _mm512_clmulepi64_epi128(a, hp[0], 0x00);
+    __m512i hi = _mm512_clmulepi64_epi128(a, hp[0], 0x11);
+    __m512i mid = _mm512_xor_si512(_mm512_clmulepi64_epi128(a, hp[0], 0x01),
+        _mm512_clmulepi64_epi128(a, hp[0], 0x10));
+    for (uint32_t i = 1; i < SM4_WORDS; i++) {
+        lo = _mm512_xor_si512(lo, _mm512_clmulepi64_epi128(d[i], hp[i], 0x00));
+        hi = _mm512_xor_si512(hi, _mm512_clmulepi64_epi128(d[i], hp[i], 0x11));
+        mid = _mm512_ternarylogic_epi64(mid, _mm512_clmulepi64_epi128(d[i], hp[i], 0x01),
+            _mm512_clmulepi64_epi128(d[i], hp[i], 0x10), 0x96);
+    }
+    // sum of the 4 lanes, then one reduction
+    __m256i lo2 = _mm256_xor_si256(_mm512_castsi512_si256(lo), _mm512_extracti64x4_epi64(lo, 1));
+    __m256i hi2 = _mm256_xor_si256(_mm512_castsi512_si256(hi), _mm512_extracti64x4_epi64(hi, 1));
+    __m256i mid2 = _mm256_xor_si256(_mm512_castsi512_si256(mid), _mm512_extracti64x4_epi64(mid, 1));
+    __m128i l = _mm_xor_si128(_mm256_castsi256_si128(lo2), _mm256_extracti128_si256(lo2, 1));
+    __m128i h = _mm_xor_si128(_mm256_castsi256_si128(hi2), _mm256_extracti128_si256(hi2, 1));
+    __m128i m = _mm_xor_si128(_mm256_castsi256_si128(mid2), _mm256_extracti128_si256(mid2, 1));
+    l = _mm_xor_si128(l, _mm_slli_si128(m, 8));
+    h = _mm_xor_si128(h, _mm_srli_si128(m, 8));
+    return _mm512_castsi512_si128(GhashReduceAvx512(_mm512_castsi128_si512(l), _mm512_castsi128_si512(h)));
+}
+
+/*
+ * 32 blocks per iteration: the counter blocks go through SM4 while the GHASH of the previous ciphertext (encryption)
+ * or of the current one (decryption) is computed, the two chains are independent.
+ */
+SM4_AVX512_GCM static uint32_t Sm4GcmAvx512(const uint8_t *in, uint8_t *out, uint32_t blocks, const uint32_t *rk,
+    uint8_t *iv, uint8_t *ghash, const uint8_t *hTable, bool enc)
+{
+    __m512i hp[SM4_WORDS];
+    __m512i pend[8];
+    bool hasPend = false;
+    GhashPowersAvx512(hTable, hp);
+    const __m128i bswap = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    __m128i xi = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(uintptr_t)ghash), bswap);
+    uint32_t ctr = GET_UINT32_BE(iv, 12); // the 32-bit counter is the last 4 bytes
+    uint32_t done = 0;
+    for (; blocks - done >= SM4_AVX512_BLOCKS; done += SM4_AVX512_BLOCKS, ctr += SM4_AVX512_BLOCKS) {
+        const uint8_t *src = in + (size_t)done * CRYPT_SM4_BLOCKSIZE;
+        uint8_t *dst = out + (size_t)done * CRYPT_SM4_BLOCKSIZE;
+        __m512i d[8];
+        __m512i x[8];
+        for (uint32_t i = 0; i < 8; i++) { // 8 rows of 4 blocks
+            d[i] = _mm512_loadu_si512((const void *)(src + i * 64)); // 64 bytes per row
+        }
+        if (!enc) {
+            for (uint32_t i = 0; i < 8; i++) { // 8 rows of 4 blocks
+                pend[i] = GhashBswapAvx512(d[i]);
+            }
+            hasPend = true;
+        }
+        Sm4CounterAvx512(x, iv, ctr);
+        Sm4RoundsAvx512(x, rk, true);
+        if (hasPend) {
+            xi = Ghash16Avx512(xi, &pend[0], hp);
+            xi = Ghash16Avx512(xi, &pend[SM4_WORDS], hp);
+        }
+        Sm4StoreAvx512(&x[0]);
+        Sm4StoreAvx512(&x[SM4_WORDS]);
+        for (uint32_t i = 0; i < 8; i++) { // 8 rows of 4 blocks
+            x[i] = _mm512_xor_si512(x[i], d[i]);
+            _mm512_storeu_si512((void *)(dst + i * 64), x[i]); // 64 bytes per row
+            if (enc) {
+                pend[i] = GhashBswapAvx512(x[i]);
+            }
+        }
+        hasPend = enc;
+    }
+    if (hasPend) {
+        xi = Ghash16Avx512(xi, &pend[0], hp);
+        xi = Ghash16Avx512(xi, &pend[SM4_WORDS], hp);
+    }
+    _mm_storeu_si128((__m128i *)(uintptr_t)ghash, _mm_shuffle_epi8(xi, bswap));
+    PUT_UINT32_BE(ctr, iv, 12); // the 32-bit counter is the last 4 bytes
+    return done;
+}
+#endif // HITLS_CRYPTO_GCM
+
+/* ---------------------------------------- AVX2 + VAES ---------------------------------------- */
+
+SM4_VAES256 static inline __m256i Sm4Bcast128(const uint8_t *tab)
+{
+    return _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(uintptr_t)tab));
+}
+
+// x = M * x + C per byte, through the two 16-entry tables of the high and the low nibbles.
+SM4_VAES256 static inline __m256i Sm4AffineVaes256(__m256i x, __m256i hiTab, __m256i loTab)
+{
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble); // 4: the high nibble
+    __m256i lo = _mm256_and_si256(x, nibble);
+    return _mm256_xor_si256(_mm256_shuffle_epi8(hiTab, hi), _mm256_shuffle_epi8(loTab, lo));
+}
+
+static const uint8_t SM4_AES_TABLES[][16] = {
+    // inverse ShiftRows, undoes the ShiftRows of AESENCLAST
+    {0x00, 0x0d, 0x0a, 0x07, 0x04, 0x01, 0x0e, 0x0b, 0x08, 0x05, 0x02, 0x0f, 0x0c, 0x09, 0x06, 0x03},
+    // A1 = M1 * x + C1, high and low nibbles
+    {0x00, 0xa2, 0x49, 0xeb, 0x09, 0xab, 0x40, 0xe2, 0x12, 0xb0, 0x5b, 0xf9, 0x1b, 0xb9, 0x52, 0xf0},
+    {0x01, 0x07, 0x72, 0x74, 0xe4, 0xe2, 0x97, 0x91, 0x57, 0x51, 0x24, 0x22, 0xb2, 0xb4, 0xc1, 0xc7},
+    // A2 = M2 * x + C2, high and low nibbles
+    {0x00, 0xdc, 0xaf, 0x73, 0xdd, 0x01, 0x72, 0xae, 0xbf, 0x63, 0x10, 0xcc, 0x62, 0xbe, 0xcd, 0x11},
+    {0x34, 0x08, 0x9d, 0xa1, 0xce, 0xf2, 0x67, 0x5b, 0x82, 0xbe, 0x2b, 0x17, 0x78, 0x44, 0xd1, 0xed},
+    // left rotations of the dwords by 8, 16 and 24 bits
+    {3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14},
+    {2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13},
+    {1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12},
+    // byte swap of the dwords
+    {3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12},
+};
+
+enum {
+    SM4_TAB_INV_SHIFT_ROWS,
+    SM4_TAB_A1_HI,
+    SM4_TAB_A1_LO,
+    SM4_TAB_A2_HI,
+    SM4_TAB_A2_LO,
+    SM4_TAB_ROL8,
+    SM4_TAB_ROL16,
+    SM4_TAB_ROL24,
+    SM4_TAB_BSWAP32,
+};
+
+// S(x) = A2(AES-S(A1(x))), the AES S-box is AESENCLAST with a zero round key.
+SM4_VAES256 static inline __m256i Sm4TVaes256(__m256i x)
+{
+    x = _mm256_shuffle_epi8(x, Sm4Bcast128(SM4_AES_TABLES[SM4_TAB_INV_SHIFT_ROWS]));
+    x = Sm4AffineVaes256(x, Sm4Bcast128(SM4_AES_TABLES[SM4_TAB_A1_HI]), Sm4Bcast128(SM4_AES_TABLES[SM4_TAB_A1_LO]));
+    x = _mm256_aesenclast_epi128(x, _mm256_setzero_si256());
+    x = Sm4AffineVaes256(x, Sm4Bcast128(SM4_AES_TABLES[SM4_TAB_A2_HI]), Sm4Bcast128(SM4_AES_TABLES[SM4_TAB_A2_LO]));
+    // L(B) = B ^ (B <<< 24) ^ ((B ^ (B <<< 8) ^ (B <<< 16)) <<< 2)
+    __m256i y = _mm256_xor_si256(_mm256_shuffle_epi8(x, Sm4Bcast128(SM4_AES_TABLES[SM4_TAB_ROL8])),
+        _mm256_shuffle_epi8(x, Sm4Bcast128(SM4_AES_TABLES[SM4_TAB_ROL16])));
+    y = _mm256_xor_si256(y, x);
+    y = _mm256_or_si256(_mm256_slli_epi32(y, 2), _mm256_srli_epi32(y, 30)); // 2 + 30 = 32
+    x = _mm256_xor_si256(x, _mm256_shuffle_epi8(x, Sm4Bcast128(SM4_AES_TABLES[SM4_TAB_ROL24])));
+    return _mm256_xor_si256(x, y);
+}
+
+#define SM4_ROUND_VAES256(a0, a1, a2, a3, k) \
+    (a0) = _mm256_xor_si256((a0), \
+        Sm4TVaes256(_mm256_xor_si256(_mm256_xor_si256((a1), (a2)), _mm256_xor_si256((a3), (k)))))
+
+// 32 rounds on the transposed words x[0..3] and x[4..7] of 2 * 8 blocks.
+SM4_VAES256 static inline void Sm4RoundsVaes256(__m256i x[8], const uint32_t *rk)
+{
+    for (uint32_t i = 0; i < CRYPT_SM4_ROUNDS; i += SM4_WORDS) {
+        __m256i k0 = _mm256_set1_epi32((int)rk[i]);
+        __m256i k1 = _mm256_set1_epi32((int)rk[i + 1]);
+        __m256i k2 = _mm256_set1_epi32((int)rk[i + 2]);
+        __m256i k3 = _mm256_set1_epi32((int)rk[i + 3]);
+        SM4_ROUND_VAES256(x[0], x[1], x[2], x[3], k0);
+        SM4_ROUND_VAES256(x[4], x[5], x[6], x[7], k0);
+        SM4_ROUND_VAES256(x[1], x[2], x[3], x[0], k1);
+        SM4_ROUND_VAES256(x[5], x[6], x[7], x[4], k1);
+        SM4_ROUND_VAES256(x[2], x[3], x[0], x[1], k2);
+        SM4_ROUND_VAES256(x[6], x[7], x[4], x[5], k2);
+        SM4_ROUND_VAES256(x[3], x[0], x[1], x[2], k3);
+        SM4_ROUND_VAES256(x[7], x[4], x[5], x[6], k3);
+    }
+}
+
+SM4_VAES256 static inline void Sm4TransposeVaes256(__m256i *a0, __m256i *a1, __m256i *a2, __m256i *a3)
+{
+    __m256i t0 = _mm256_unpacklo_epi32(*a0, *a1);
+    __m256i t1 = _mm256_unpackhi_epi32(*a0, *a1);
+    __m256i t2 = _mm256_unpacklo_epi32(*a2, *a3);
+    __m256i t3 = _mm256_unpackhi_epi32(*a2, *a3);
+    *a0 = _mm256_unpacklo_epi64(t0, t2);
+    *a1 = _mm256_unpackhi_epi64(t0, t2);
+    *a2 = _mm256_unpacklo_epi64(t1, t3);
+    *a3 = _mm256_unpackhi_epi64(t1, t3);
+}
+
+SM4_VAES256 static inline void Sm4LoadVaes256(__m256i r[SM4_WORDS])
+{
+    const __m256i bswap = Sm4Bcast128(SM4_AES_TABLES[SM4_TAB_BSWAP32]);
+    for (uint32_t i = 0; i < SM4_WORDS; i++) {
+        r[i] = _mm256_shuffle_epi8(r[i], bswap);
+    }
+    Sm4TransposeVaes256(&r[0], &r[1], &r[2], &r[3]);
+}
+
+SM4_VAES256 static inline void Sm4StoreVaes256(__m256i x[SM4_WORDS])
+{
+    const __m256i bswap = Sm4Bcast128(SM4_AES_TABLES[SM4_TAB_BSWAP32]);
+    __m256i t = x[0];
+    x[0] = x[3];
+    x[3] = t;
+    t = x[1];
+    x[1] = x[2];
+    x[2] = t;
+    Sm4TransposeVaes256(&x[0], &x[1], &x[2], &x[3]);
+    for (uint32_t i = 0; i < SM4_WORDS; i++) {
+        x[i] = _mm256_shuffle_epi8(x[i], bswap);
+    }
+}
+
+SM4_VAES256 static uint64_t Sm4CtrVaes256(const uint8_t *in, uint8_t *out, uint64_t blocks, const uint32_t *rk,
+    uint8_t *iv)
+{
+    const __m256i idx = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    uint32_t ctr = GET_UINT32_BE(iv, 12); // the 32-bit counter is the last 4 bytes
+    uint64_t done = 0;
+    for (; blocks - done >= SM4_VAES_BLOCKS; done += SM4_VAES_BLOCKS, ctr += SM4_VAES_BLOCKS) {
+        __m256i x[8];
+        for (uint32_t i = 0; i < SM4_WORDS - 1; i++) {
+            x[i] = _mm256_set1_epi32((int)GET_UINT32_BE(iv, i * SM4_WORDS));
+            x[i + SM4_WORDS] = x[i];
+        }
+        x[3] = _mm256_add_epi32(_mm256_set1_epi32((int)ctr), idx);
+        x[7] = _mm256_add_epi32(x[3], _mm256_set1_epi32(SM4_VAES_BLOCKS / 2)); // the second half
+        Sm4RoundsVaes256(x, rk);
+        Sm4StoreVaes256(&x[0]);
+        Sm4StoreVaes256(&x[SM4_WORDS]);
+        for (uint32_t i = 0; i < 8; i++) { // 8 rows of 2 blocks
+            size_t off = (size_t)done * CRYPT_SM4_BLOCKSIZE + i * 32; // 32 bytes per row
+            __m256i d = _mm256_loadu_si256((const __m256i *)(uintptr_t)(in + off));
+            _mm256_storeu_si256((__m256i *)(uintptr_t)(out + off), _mm256_xor_si256(d, x[i]));
+        }
+    }
+    PUT_UINT32_BE(ctr, iv, 12); // the 32-bit counter is the last 4 bytes
+    return done;
+}
+
+SM4_VAES256 static void Sm4XtsVaes256(const uint8_t *in, uint8_t *out, uint64_t groups, const uint32_t *rk,
+    uint8_t *t)
+{
+    uint64_t hi = ((uint64_t)GET_UINT32_BE(t, 0) << 32) | GET_UINT32_BE(t, 4);  // 32: high word, 4: second word
+    uint64_t lo = ((uint64_t)GET_UINT32_BE(t, 8) << 32) | GET_UINT32_BE(t, 12); // 32: high word, 8/12: low words
+    for (uint64_t g = 0; g < groups; g++) {
+        // t ends with the tweaks of the last 16 blocks, as SM4_XTS_Encrypt_Blocks
+        Sm4XtsTweaks(&hi, &lo, t, SM4_VAES_BLOCKS);
+        __m256i x[8];
+        __m256i tv[8];
+        for (uint32_t i = 0; i < 8; i++) { // 8 rows of 2 blocks
+            tv[i] = _mm256_loadu_si256((const __m256i *)(uintptr_t)(t + i * 32)); // 32 bytes per row
+            x[i] = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(uintptr_t)(in + i * 32)), tv[i]);
+        }
+        Sm4LoadVaes256(&x[0]);
+        Sm4LoadVaes256(&x[SM4_WORDS]);
+        Sm4RoundsVaes256(x, rk);
+        Sm4StoreVaes256(&x[0]);
+        Sm4StoreVaes256(&x[SM4_WORDS]);
+        for (uint32_t i = 0; i < 8; i++) { // 8 rows of 2 blocks
+            _mm256_storeu_si256((__m256i *)(uintptr_t)(out + i * 32), _mm256_xor_si256(x[i], tv[i]));
+        }
+        in += CRYPT_SM4_BLOCKSIZE_16;
+        out += CRYPT_SM4_BLOCKSIZE_16;
+    }
+}
+
+/* ---------------------------------------- dispatch ---------------------------------------- */
+
+uint64_t SM4_CTR_EncryptBlocksWide(const uint8_t *in, uint8_t *out, uint64_t blocks, const uint32_t *rk,
+    uint8_t *iv)
+{
+    if (Sm4SupportAvx512()) {
+        return Sm4CtrAvx512(in, out, blocks, rk, iv);
+    }
+    if (Sm4SupportVaes256()) {
+        return Sm4CtrVaes256(in, out, blocks, rk, iv);
+    }
+    return 0;
+}
+
+bool SM4_XTS_EncryptBlocksWide(const uint8_t *in, uint8_t *out, uint64_t len, const uint32_t *rk, uint8_t *t)
+{
+    uint64_t groups = len / CRYPT_SM4_BLOCKSIZE_16;
+    if (Sm4SupportAvx512()) {
+        Sm4XtsAvx512(in, out, groups, rk, t);
+        return true;
+    }
+    if (Sm4SupportVaes256()) {
+        Sm4XtsVaes256(in, out, groups, rk, t);
+        return true;
+    }
+    return false;
+}
+
+#ifdef HITLS_CRYPTO_GCM
+uint32_t SM4_GCM_CryptBlocksWide(const uint8_t *in, uint8_t *out, uint32_t blocks, const uint32_t *rk,
+    uint8_t *iv, uint8_t *ghash, const uint8_t *hTable, bool enc)
+{
+    if (!Sm4SupportAvx512() || !IsSupportVPCLMULQDQ()) {
+        return 0;
+    }
+    return Sm4GcmAvx512(in, out, blocks, rk, iv, ghash, hTable, enc);
+}
+#endif
+
+#endif // HITLS_CRYPTO_SM4 && __x86_64__
@@ -73,6 +73,8 @@ void BSL_ERR_DeInit(void);
  * Delete the error stack, which is called when a process or thread exits.
  *
  * @attention This function must be called when the thread exits. Otherwise, memory leakage occurs.
+ *            When the error stack is kept in thread local storage, which is the default unless HITLS_ERR_THREAD_LOCK
+ *            is defined, only the stack of the calling thread is cleared and no memory is held by the stacks.
  * @param isRemoveAll [IN] Indicates whether to delete all error stacks.
  *                         The value is true when a process exits and false when a thread exits.
  */
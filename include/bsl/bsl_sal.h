@@ -43,6 +43,13 @@ typedef void *BSL_SAL_ThreadLockHandle;
  */
 typedef void *BSL_SAL_ThreadId;
 
+/**
+ * @ingroup bsl_sal
+ *
+ * Thread-specific data key, each thread keeps its own value of it.
+ */
+typedef void *BSL_SAL_ThreadKey;
+
 /**
  * @ingroup bsl_sal
  *
@@ -279,6 +286,53 @@ int32_t BSL_SAL_ThreadCreate(BSL_SAL_ThreadId *thread, void *(*startFunc)(void *
  */
 void BSL_SAL_ThreadClose(BSL_SAL_ThreadId thread);
 
+/**
+ * @ingroup bsl_sal
+ * @brief Create a thread-specific data key.
+ *
+ * Create a key with which every thread keeps its own value, initially NULL.
+ *
+ * @attention The destructor is called with the value of a thread when the thread exits and the value is not NULL.
+ * It is not called for the values left when the key is freed.
+ * @param key [OUT] Key handle
+ * @param destructor [IN] Destructor of the values, which can be NULL.
+ * @retval #BSL_SUCCESS, created successfully.
+ * @retval #BSL_MALLOC_FAIL, memory space is insufficient.
+ * @retval #BSL_SAL_ERR_UNKNOWN, failed to create a key.
+ * @retval #BSL_SAL_ERR_BAD_PARAM, parameter error.
+ */
+int32_t BSL_SAL_ThreadKeyNew(BSL_SAL_ThreadKey *key, void (*destructor)(void *));
+
+/**
+ * @ingroup bsl_sal
+ * @brief Free a thread-specific data key.
+ *
+ * @attention The values of the threads are not freed.
+ * @param key [IN] Key handle
+ */
+void BSL_SAL_ThreadKeyFree(BSL_SAL_ThreadKey key);
+
+/**
+ * @ingroup bsl_sal
+ * @brief Set the value of the calling thread for a key.
+ *
+ * @param key [IN] Key handle
+ * @param value [IN] Value of the calling thread
+ * @retval #BSL_SUCCESS, succeeded.
+ * @retval #BSL_SAL_ERR_UNKNOWN, failed to set the value.
+ * @retval #BSL_SAL_ERR_BAD_PARAM, parameter error.
+ */
+int32_t BSL_SAL_ThreadSetSpecific(BSL_SAL_ThreadKey key, void *value);
+
+/**
+ * @ingroup bsl_sal
+ * @brief Obtain the value of the calling thread for a key.
+ *
+ * @param key [IN] Key handle
+ * @retval Value of the calling thread, NULL if it is not set.
+ */
+void *BSL_SAL_ThreadGetSpecific(BSL_SAL_ThreadKey key);
+
 /**
  * @ingroup bsl_sal
  * @brief Create a condition variable.
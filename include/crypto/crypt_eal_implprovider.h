@@ -166,6 +166,7 @@ typedef int32_t (*CRYPT_EAL_ImplPkeyMgmtExport)(const void *ctx, BSL_Param *para
 #define CRYPT_EAL_IMPLPKEYSIGN_RECOVER    5
 #define CRYPT_EAL_IMPLPKEYSIGN_BLIND      6
 #define CRYPT_EAL_IMPLPKEYSIGN_UNBLIND    7
+#define CRYPT_EAL_IMPLPKEYSIGN_VERIFYBATCH 8
 
 typedef int32_t (*CRYPT_EAL_ImplPkeySign)(void *ctx, int32_t mdAlgId, const uint8_t *data, uint32_t dataLen,
     uint8_t *sign, uint32_t *signLen);
@@ -181,6 +182,8 @@ typedef int32_t (*CRYPT_EAL_ImplPkeyBlind)(void *ctx, int32_t mdAlgId, const uin
     uint8_t *out, uint32_t *outLen);
 typedef int32_t (*CRYPT_EAL_ImplPkeyUnBlind)(const void *ctx, const uint8_t *input, uint32_t inputLen,
     uint8_t *out, uint32_t *outLen);
+typedef int32_t (*CRYPT_EAL_ImplPkeyVerifyBatch)(const void *const *ctxs, int32_t mdAlgId,
+    const CRYPT_VerifyItem *items, uint32_t num, int32_t *results);
 
 // CRYPT_EAL_OPERAID_ASYMCIPHER
 #define CRYPT_EAL_IMPLPKEYCIPHER_ENCRYPT  1
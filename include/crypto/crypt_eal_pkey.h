@@ -418,6 +418,29 @@ int32_t CRYPT_EAL_PkeySignData(const CRYPT_EAL_PkeyCtx *pkey, const uint8_t *has
 int32_t CRYPT_EAL_PkeyVerifyData(const CRYPT_EAL_PkeyCtx *pkey, const uint8_t *hash, uint32_t hashLen,
     const uint8_t *sign, uint32_t signLen);
 
+/**
+ * @ingroup crypt_eal_pkey
+ * @brief   Verify a batch of signatures
+ *
+ * Item i is the message and the signature to be verified with pkeys[i], a key session can be used by several items.
+ * Consecutive items of ECDSA or SM2 keys are verified together: ECDSA shares one modular inversion among the items
+ * on the same curve, SM2 computes the Z digest once for consecutive items of the same key. The items of the
+ * other algorithms are verified one by one by CRYPT_EAL_PkeyVerify.
+ *
+ * @param   pkeys     [IN] Key sessions of the items
+ * @param   id        [IN] Hash algorithm ID.
+ * @param   items     [IN] Messages and signatures
+ * @param   num       [IN] Number of items
+ * @param   threadNum [IN] The items are dealt to up to threadNum threads, 0 or 1 verifies in the calling thread only.
+ *                         Threads are available with HITLS_BSL_SAL_THREAD on Linux, the value is ignored otherwise.
+ * @param   results   [OUT] Result of every item, the same as the return value of CRYPT_EAL_PkeyVerify
+ *
+ * @retval  #CRYPT_SUCCESS, if all the signatures are valid.
+ *          Otherwise the result of the first item that fails, or CRYPT_NULL_INPUT for null input.
+ */
+int32_t CRYPT_EAL_PkeyVerifyBatch(const CRYPT_EAL_PkeyCtx *const *pkeys, CRYPT_MD_AlgId id,
+    const CRYPT_VerifyItem *items, uint32_t num, uint32_t threadNum, int32_t *results);
+
 /**
  * @ingroup crypt_eal_pkey
  * @brief   Encrypt data.
@@ -117,7 +117,9 @@ int32_t CRYPT_EAL_RandInit(CRYPT_RAND_AlgId id, CRYPT_RandSeedMethod *seedMeth,
  * @param attrName [IN] Specify expected attribute values
  * @param pers [IN] Personal data, which can be NULL.
  * @param persLen [IN] Personal data length. the range is [0,0x7FFFFFF0].
- * @param param [IN] Transparent transmission of underlying parameters
+ * @param param [IN] Transparent transmission of underlying parameters. If CRYPT_PARAM_RAND_PER_THREAD is true, every
+ *                   thread lazily gets its own DRBG seeded from the global one, so generating takes no exclusive
+ *                   shared lock. The DRBG of a thread is freed when the thread exits.
  *
  * @retval #CRYPT_SUCCESS, if successful.
  *         For other error codes, see the crypt_errno.h file.
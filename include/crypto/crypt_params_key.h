@@ -43,6 +43,7 @@ extern "C" {
 #define CRYPT_PARAM_KDF_N                                   (CRYPT_PARAM_KDF_BASE + 13)
 #define CRYPT_PARAM_KDF_P                                   (CRYPT_PARAM_KDF_BASE + 14)
 #define CRYPT_PARAM_KDF_R                                   (CRYPT_PARAM_KDF_BASE + 15)
+#define CRYPT_PARAM_KDF_THREAD_NUM                          (CRYPT_PARAM_KDF_BASE + 16)
 
 #define CRYPT_PARAM_EC_BASE                                 200
 #define CRYPT_PARAM_EC_POINT_UNCOMPRESSED                   (CRYPT_PARAM_EC_BASE + 1)
@@ -87,6 +88,7 @@ extern "C" {
 #define CRYPT_PARAM_RAND_SEED_CLEANENTROPY                  (CRYPT_PARAM_RAND_BASE + 4)
 #define CRYPT_PARAM_RAND_SEED_GETNONCE                      (CRYPT_PARAM_RAND_BASE + 5)
 #define CRYPT_PARAM_RAND_SEED_CLEANNONCE                    (CRYPT_PARAM_RAND_BASE + 6)
+#define CRYPT_PARAM_RAND_PER_THREAD                         (CRYPT_PARAM_RAND_BASE + 7)
 
 #define CRYPT_PARAM_CURVE25519_BASE                         700
 #define CRYPT_PARAM_CURVE25519_PUBKEY                       (CRYPT_PARAM_CURVE25519_BASE + 1)
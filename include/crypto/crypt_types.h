@@ -50,6 +50,18 @@ typedef struct {
     uint32_t len;
 } CRYPT_ConstData;
 
+/**
+ * @ingroup crypt_types
+ *
+ * Message and signature of an item of the batch verification
+ */
+typedef struct {
+    const uint8_t *data;  /**< Plaintext data */
+    uint32_t dataLen;     /**< Plaintext length */
+    const uint8_t *sign;  /**< Signature data */
+    uint32_t signLen;     /**< Length of the signature data */
+} CRYPT_VerifyItem;
+
 /**
  * @ingroup crypt_types
  *
@@ -654,13 +666,24 @@ typedef enum {
     CRYPT_CTRL_GET_ECC_ORDER_BITS,      /**< Get the number of bits in the group order. */
     CRYPT_CTRL_GET_ECC_NAME,            /**< Obtain the name of the ECC curve. */
     CRYPT_CTRL_GEN_X25519_PUBLICKEY,    /**< Use prikey genarate x25519 pubkey. */
+    CRYPT_CTRL_SET_SM2_ZA,              /**< SM2 set the precomputed 32-byte Z digest of the user ID and the public key.
+                                             It is used until the key or the user ID is changed, so set it after them. */
+    CRYPT_CTRL_GET_SM2_ZA,              /**< SM2 obtain the 32-byte Z digest of the user ID and the public key. */
 
     // slh-dsa
     CRYPT_CTRL_GET_SLH_DSA_KEY_LEN = 600,     /**< Get the SLH-DSA key length. */
     CRYPT_CTRL_SET_SLH_DSA_ADDRAND, /**< Set the SLH-DSA additional random bytes. */
+    CRYPT_CTRL_SET_SLH_DSA_THREAD_NUM, /**< Set the number of threads that compute the hypertree layers of an SLH-DSA
+                                            signature, the default 1 signs in the calling thread only. Only the
+                                            small (s) parameter sets use the threads, the layers of the fast (f)
+                                            sets are too small. */
 
 	CRYPT_CTRL_SET_MLDSA_ENCODE_FLAG = 700,  /**< Set the flag for encode messages. */
     CRYPT_CTRL_SET_MLDSA_MUMSG_FLAG,         /**< Whether to calculate message representative */
+
+    // ml-kem
+    CRYPT_CTRL_SET_MLKEM_CACHE_MATRIX_FLAG = 800, /**< Whether to keep the matrix expanded from the key in the context,
+                                                       so that it is not expanded again by every Encaps or Decaps. */
 } CRYPT_PkeyCtrl;
 
 
@@ -675,6 +698,9 @@ typedef enum {
     CRYPT_CTRL_SET_GM_LEVEL,    /**<  Set the authentication level of gm drbg */
     CRYPT_CTRL_SET_RESEED_INTERVAL,
     CRYPT_CTRL_SET_RESEED_TIME,
+    CRYPT_CTRL_SET_RAND_PER_THREAD, /**< Every thread generates with its own DRBG seeded from this one, which is
+                                         freed when the thread exits. The value is an int32_t flag. Set it before
+                                         the DRBG is instantiated. */
     CRYPT_CTRL_RAND_MAX = 0xff,
 } CRYPT_RandCtrl;
 
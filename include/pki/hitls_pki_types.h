@@ -284,6 +284,8 @@ typedef enum {
     HITLS_X509_STORECTX_SET_CRL,
     HITLS_X509_STORECTX_REF_UP,
     HITLS_X509_STORECTX_SET_VFY_SM2_USERID,
+    /* counter of the changes of the cas and the depth, which affect the chains built by the store */
+    HITLS_X509_STORECTX_GET_CHAIN_GEN,
     HITLS_X509_STORECTX_MAX
 } HITLS_X509_StoreCtxCmd;
 
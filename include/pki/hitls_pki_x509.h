@@ -68,6 +68,7 @@ void HITLS_X509_StoreCtxFree(HITLS_X509_StoreCtx *storeCtx);
  *        HITLS_X509_STORECTX_SET_CRL                   HITLS_X509_Crl      -
  *        HITLS_X509_STORECTX_REF_UP                    int                 sizeof(int)
  *        HITLS_X509_STORECTX_SET_VFY_SM2_USERID        buffer              > 0
+ *        HITLS_X509_STORECTX_GET_CHAIN_GEN             uint32_t            sizeof(uint32_t)
  * @param val [IN/OUT] input and output value.
  * @param valLen [IN] value length.
  * @retval #HITLS_PKI_SUCCESS, success.
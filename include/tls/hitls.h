@@ -171,6 +171,9 @@ int32_t HITLS_Accept(HITLS_Ctx *ctx);
  * by a single record is 16 KB. This will result in a partial copy of the application data
  * You can call HITLS_GetReadPendingBytes to obtain the size of the remaining readable application data
  * in the current record. This is useful in DTLS scenarios.
+ * If read ahead and a read batch number are set by HITLS_CFG_SetReadAhead and HITLS_CFG_SetReadBatchNum, the complete
+ * application records which have been received are decrypted back-to-back into the buffer as long as they fit, so that
+ * one call may return the data of multiple records.
  * @param   ctx [IN] TLS context
  * @param   data [OUT] Read data
  * @param   bufSize [IN] Size of the buffer
@@ -444,7 +447,7 @@ int32_t HITLS_ReadHasPending(const HITLS_Ctx *ctx, uint8_t *isPending);
 
 /**
  * @ingroup hitls
- * @brief   Obtain the number of bytes of application data to be read from the current record from the HiTLS object.
+ * @brief   Obtain the number of bytes of decrypted application data to be read from the HiTLS object.
  *
  * @attention When the HiTLS works in data packet transmission (DTLS), the HITLS_Read may
  * copy part of the application packet because the input buffer is not large enough.
@@ -89,6 +89,8 @@ typedef enum {
     CERT_KEY_CTRL_IS_KEY_AGREEMENT_USAGE,     /**< Is it the certificate verification permission. */
     CERT_KEY_CTRL_GET_PARAM_ID,               /**< Obtain the parameter ID. */
 
+    CERT_STORE_CTRL_GET_CHAIN_GEN,      /**< Obtain the counter of the store changes which affect the built chains. */
+
     CERT_CTRL_BUTT,
 } HITLS_CERT_CtrlCmd;
 
@@ -1466,6 +1466,59 @@ int32_t HITLS_CFG_SetReadAhead(HITLS_Config *config, int32_t onOff);
  */
 int32_t HITLS_CFG_GetReadAhead(HITLS_Config *config, int32_t *onOff);
 
+/**
+ * @ingroup hitls_config
+ * @brief   Set the max number of app records which are encrypted back-to-back and sent by one write.
+ *
+ * If the value is greater than 1, HITLS_Write sends up to batchNum records at a time, so one call may write up to
+ * batchNum times the length returned by HITLS_GetMaxWriteSize. It takes no effect on DTLS.
+ *
+ * @param   config [OUT] Hitls config
+ * @param   batchNum [IN] The max number of records, ranges from 0 to 16, 0 or 1 indicates no batching
+ * @retval  HITLS_NULL_INPUT
+ * @retval  HITLS_CONFIG_INVALID_SET, batchNum is greater than 16.
+ * @retval  HITLS_SUCCESS
+ */
+int32_t HITLS_CFG_SetWriteBatchNum(HITLS_Config *config, uint32_t batchNum);
+
+/**
+ * @ingroup hitls_config
+ * @brief   Get the max number of app records sent by one write
+ *
+ * @param   config [IN] Hitls config
+ * @param   batchNum [OUT] The max number of records
+ * @retval  HITLS_NULL_INPUT
+ * @retval  HITLS_SUCCESS
+ */
+int32_t HITLS_CFG_GetWriteBatchNum(const HITLS_Config *config, uint32_t *batchNum);
+
+/**
+ * @ingroup hitls_config
+ * @brief   Set the max number of app records which are fetched by one socket read and decrypted by one read.
+ *
+ * If the value is greater than 1 and read ahead is set by HITLS_CFG_SetReadAhead, the read buffer holds up to batchNum
+ * records, and HITLS_Read decrypts the complete app records in the buffer back-to-back as long as they fit, so that
+ * one call may return the data of multiple records. It takes no effect on DTLS.
+ *
+ * @param   config [OUT] Hitls config
+ * @param   batchNum [IN] The max number of records, ranges from 0 to 16, 0 or 1 indicates no batching
+ * @retval  HITLS_NULL_INPUT
+ * @retval  HITLS_CONFIG_INVALID_SET, batchNum is greater than 16.
+ * @retval  HITLS_SUCCESS
+ */
+int32_t HITLS_CFG_SetReadBatchNum(HITLS_Config *config, uint32_t batchNum);
+
+/**
+ * @ingroup hitls_config
+ * @brief   Get the max number of app records decrypted by one read
+ *
+ * @param   config [IN] Hitls config
+ * @param   batchNum [OUT] The max number of records
+ * @retval  HITLS_NULL_INPUT
+ * @retval  HITLS_SUCCESS
+ */
+int32_t HITLS_CFG_GetReadBatchNum(const HITLS_Config *config, uint32_t *batchNum);
+
 #ifdef __cplusplus
 }
 #endif
@@ -45,6 +45,18 @@ extern "C" {
  */
 #define HITLS_SESSION_ID_MAX_SIZE 32u
 
+/**
+ * @ingroup hitls_session
+ * @brief   Statistics of the session cache
+ */
+typedef struct {
+    uint64_t hits;          /**< Number of lookups that found a valid session */
+    uint64_t misses;        /**< Number of lookups that found no valid session */
+    uint64_t evictions;     /**< Number of sessions evicted to make room for new ones */
+    uint64_t timeouts;      /**< Number of timed out sessions removed from the cache */
+    uint32_t number;        /**< Number of sessions in the cache */
+} HITLS_SessCacheStats;
+
 /**
  * @ingroup hitls_session
  * @brief   Set whether to support the session ticket function.
@@ -146,6 +158,7 @@ int32_t HITLS_CFG_SetNewSessionCb(HITLS_Config *config, const HITLS_NewSessionCb
 #define HITLS_TICKET_KEY_RET_SUCCESS_RENEW 2      // If the callback is successful, the key can be used for encryption
                                                   // and decryption. In the decryption scenario,
                                                   // the ticket needs to be renewed
+#define HITLS_TICKET_KEY_MAX_NUM           8u     // maximum number of default ticket keys kept for decryption
 /**
  * @ingroup hitls_session
  * @brief   Obtain and verify ticket_key on the server.
@@ -227,6 +240,56 @@ int32_t HITLS_CFG_GetSessionTicketKey(const HITLS_Config *config, uint8_t *key,
  */
 int32_t HITLS_CFG_SetSessionTicketKey(HITLS_Config *config, const uint8_t *key, uint32_t keySize);
 
+/**
+ * @ingroup hitls_session
+ * @brief   Add a default ticket key of the HiTLS. The key encrypts the new tickets from now on, the previous keys
+ * still decrypt the tickets they issued, until more keys than the number set by HITLS_CFG_SetTicketKeyRotation
+ * are added.
+ *
+ * @attention The key value is as follows: 16-byte key name + 32-byte AES key + 32-byte HMAC key.
+ *            The key name must differ from the names of the keys in use.
+ *
+ * @param   config [OUT] Config Context.
+ * @param   key [IN] Ticket key to be added.
+ * @param   keySize [IN] Size of the ticket key.
+ *
+ * @retval  HITLS_SUCCESS, if successful.
+ * @retval  HITLS_NULL_INPUT, config or key is null, or the size of the key is incorrect.
+ * @retval  HITLS_CONFIG_INVALID_SET, the key name is in use.
+ */
+int32_t HITLS_CFG_AddSessionTicketKey(HITLS_Config *config, const uint8_t *key, uint32_t keySize);
+
+/**
+ * @ingroup hitls_session
+ * @brief   Set the rotation of the default ticket keys.
+ *
+ * Every interval seconds, a random key replaces the current key for the new tickets. The keyNum newest keys decrypt
+ * the tickets, so a ticket remains valid for at least (keyNum - 1) * interval seconds after the key that encrypted
+ * it is replaced. By default there is one key and it is never replaced.
+ *
+ * @param   config [OUT] Config Context.
+ * @param   interval [IN] Seconds a key encrypts the new tickets, 0 means the key is never replaced.
+ * @param   keyNum [IN] Number of keys that decrypt the tickets, from 1 to HITLS_TICKET_KEY_MAX_NUM.
+ *
+ * @retval  HITLS_SUCCESS, if successful.
+ * @retval  HITLS_NULL_INPUT, config is null.
+ * @retval  HITLS_CONFIG_INVALID_SET, keyNum is out of range.
+ */
+int32_t HITLS_CFG_SetTicketKeyRotation(HITLS_Config *config, uint64_t interval, uint32_t keyNum);
+
+/**
+ * @ingroup hitls_session
+ * @brief   Obtain the rotation of the default ticket keys.
+ *
+ * @param   config [IN] Config Context.
+ * @param   interval [OUT] Seconds a key encrypts the new tickets, 0 means the key is never replaced.
+ * @param   keyNum [OUT] Number of keys that decrypt the tickets.
+ *
+ * @retval  HITLS_SUCCESS, if successful.
+ * @retval  HITLS_NULL_INPUT, an input is null.
+ */
+int32_t HITLS_CFG_GetTicketKeyRotation(const HITLS_Config *config, uint64_t *interval, uint32_t *keyNum);
+
 /**
  * @ingroup hitls_session
  * @brief   Set the user-specific session ID ctx, only on the server.
@@ -285,6 +348,19 @@ int32_t HITLS_CFG_SetSessionCacheSize(HITLS_Config *config, uint32_t size);
  */
 int32_t HITLS_CFG_GetSessionCacheSize(HITLS_Config *config, uint32_t *size);
 
+/**
+ * @ingroup hitls_session
+ * @brief   Obtain the statistics of the session cache.
+ *
+ * When the cache is full, the least recently used session is evicted to make room for a new one.
+ *
+ * @param   config  [IN] Config context.
+ * @param   stats [OUT] Statistics of the session cache.
+ * @retval  HITLS_SUCCESS, if successful.
+ * @retval  HITLS_NULL_INPUT, config or stats is null.
+ */
+int32_t HITLS_CFG_GetSessionCacheStats(HITLS_Config *config, HITLS_SessCacheStats *stats);
+
 /**
  * @ingroup hitls_session
  * @brief   Set the session timeout interval.
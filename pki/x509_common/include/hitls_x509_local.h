@@ -279,6 +279,9 @@ int32_t HITLS_X509_CheckAki(HITLS_X509_Ext *issueExt, HITLS_X509_Ext *subjectExt
     BSL_ASN1_Buffer *serialNum);
 
 int32_t HITLS_X509_CmpNameNode(BSL_ASN1_List *nameOri, BSL_ASN1_List *name);
+
+/* Non-cryptographic hash of a distinguished name, used to index the certificates and crls of the store. */
+uint32_t HITLS_X509_NameHash(BSL_ASN1_List *name);
 #endif
 
 bool X509_CheckCmdValid(int32_t *cmdSet, uint32_t cmdSize, int32_t cmd);
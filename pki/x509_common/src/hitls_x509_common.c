@@ -546,6 +546,43 @@ int32_t HITLS_X509_CmpNameNode(BSL_ASN1_List *nameOri, BSL_ASN1_List *name)
     }
     return 0;
 }
+
+#define X509_NAME_HASH_OFFSET 0x811c9dc5U // FNV-1a 32-bit offset basis
+#define X509_NAME_HASH_PRIME  0x01000193U // FNV-1a 32-bit prime
+
+static uint32_t X509_NameHashUpdate(uint32_t hash, const uint8_t *data, uint32_t len, bool ignoreCase)
+{
+    uint32_t h = hash;
+    for (uint32_t i = 0; i < len; i++) {
+        uint8_t c = data[i];
+        if (ignoreCase && 'A' <= c && c <= 'Z') {
+            c = (uint8_t)(c + ('a' - 'A'));
+        }
+        h = (h ^ c) * X509_NAME_HASH_PRIME;
+    }
+    return h;
+}
+
+/**
+ * The hash is consistent with HITLS_X509_CmpNameNode: names which compare equal have the same hash, so the
+ * UTF8String and PrintableString values are hashed without their tag and case insensitively.
+ */
+uint32_t HITLS_X509_NameHash(BSL_ASN1_List *name)
+{
+    uint32_t hash = X509_NAME_HASH_OFFSET;
+    for (HITLS_X509_NameNode *node = BSL_LIST_GET_FIRST(name); node != NULL; node = BSL_LIST_GET_NEXT(name)) {
+        uint8_t head[] = {node->layer, node->nameType.tag};
+        hash = X509_NameHashUpdate(hash, head, sizeof(head), false);
+        hash = X509_NameHashUpdate(hash, node->nameType.buff, node->nameType.len, false);
+        bool isStr = node->nameValue.tag == BSL_ASN1_TAG_UTF8STRING ||
+            node->nameValue.tag == BSL_ASN1_TAG_PRINTABLESTRING;
+        if (!isStr) {
+            hash = X509_NameHashUpdate(hash, &node->nameValue.tag, sizeof(node->nameValue.tag), false);
+        }
+        hash = X509_NameHashUpdate(hash, node->nameValue.buff, node->nameValue.len, isStr);
+    }
+    return hash;
+}
 #endif // HITLS_PKI_X509_VFY
 
 #ifdef HITLS_CRYPTO_RSA
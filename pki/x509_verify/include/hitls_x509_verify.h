@@ -22,6 +22,8 @@
 #include "bsl_asn1.h"
 #include "hitls_pki_x509.h"
 #include "sal_atomic.h"
+#include "bsl_hash.h"
+#include "hitls_crl_local.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -42,9 +44,29 @@ typedef struct _HITLS_X509_VerifyParam {
 #endif
 } HITLS_X509_VerifyParam;
 
+/*
+ * Index of a crl in the store, built once when the crl is set, so that the revocation check neither walks the
+ * revoked list nor verifies the crl signature again for every certificate.
+ */
+typedef struct _HITLS_X509_CrlIndex {
+    HITLS_X509_Crl *crl;            // Held by storeCtx->crl
+    uint32_t issuerHash;            // HITLS_X509_NameHash of the crl issuer
+    bool hasAki;                    // The crl has an authority key identifier extension
+    bool akiHasIssuer;              // The aki contains more than the key identifier, or can not be parsed
+    BSL_Buffer akiKid;              // Key identifier of the aki, point to the crl extension
+    bool hasCriticalExt;            // The crl contains critical extensions which can not be processed
+    uint32_t revokedNum;
+    HITLS_X509_CrlEntry **revoked;  // Revoked entries sorted by serial number
+    HITLS_X509_Cert *signer;        // Trusted ca which has verified the crl signature, NULL if not verified yet
+} HITLS_X509_CrlIndex;
+
 struct _HITLS_X509_StoreCtx {
     HITLS_X509_List *store;
-    HITLS_X509_List *crl;
+    BSL_HASH_Hash *caIndex;           // Lists of the cas in store keyed by subject name hash, created with the first ca
+    uint32_t chainGen;                // Increased whenever the cas or the max depth change the chains built by the store
+    HITLS_X509_List *crl;             // Changed only by HITLS_X509_STORECTX_SET_CRL, which also indexes the crl
+    BSL_HASH_Hash *crlIndex;          // Lists of HITLS_X509_CrlIndex keyed by issuer name hash, created with 1st crl
+    uint32_t crlIndexNum;             // Crls in crlIndex, the index is unused if crl holds a different number of crls
     BSL_SAL_RefCount references;
     HITLS_X509_VerifyParam verifyParam;
     CRYPT_EAL_LibCtx *libCtx;         // Provider context
@@ -54,6 +76,37 @@ struct _HITLS_X509_StoreCtx {
 
 int32_t HITLS_X509_VerifyParamAndExt(HITLS_X509_StoreCtx *storeCtx, HITLS_X509_List *chain);
 
+int32_t X509_StoreCheckSignature(const BSL_Buffer *sm2UserId, const CRYPT_EAL_PkeyCtx *pubKey,
+    uint8_t *rawData, uint32_t rawDataLen, HITLS_X509_Asn1AlgId *alg, BSL_ASN1_BitString *signature);
+
+/*
+ * Get the trusted cas whose subject name hash is nameHash, the cas are not held by the returned list.
+ * The whole store is returned if it has not been indexed, and NULL is returned if there is no candidate.
+ */
+HITLS_X509_List *X509_StoreFindCaByName(HITLS_X509_StoreCtx *storeCtx, uint32_t nameHash);
+
+/* Index the crl which has been added to storeCtx->crl, and count it in storeCtx->crlIndexNum. */
+int32_t HITLS_X509_CrlIndexAdd(HITLS_X509_StoreCtx *storeCtx, HITLS_X509_Crl *crl);
+
+/* Drop the index and index all crls in storeCtx->crl again. */
+int32_t HITLS_X509_CrlIndexRebuild(HITLS_X509_StoreCtx *storeCtx);
+
+/* Get the indexed crls whose issuer name hash is nameHash, NULL is returned if there is no candidate. */
+HITLS_X509_List *HITLS_X509_CrlIndexFind(const HITLS_X509_StoreCtx *storeCtx, uint32_t nameHash);
+
+/* Whether the crl signature has been verified with the public key of the parent. */
+bool HITLS_X509_CrlIndexIsSignedBy(const HITLS_X509_CrlIndex *crlIdx, const HITLS_X509_Cert *parent);
+
+/* Try to verify the signature of the crls which are issued by the ca and have not been verified yet. */
+void HITLS_X509_CrlIndexAddSigner(HITLS_X509_StoreCtx *storeCtx, HITLS_X509_Cert *ca);
+
+/* Drop the cached signature verdicts and verify the crls again, called when the verify parameters change. */
+void HITLS_X509_CrlIndexResetSigner(HITLS_X509_StoreCtx *storeCtx);
+
+/* Search the revoked entry of the serial number by binary search, return NULL if it is not revoked. */
+HITLS_X509_CrlEntry *HITLS_X509_CrlIndexFindRevoked(const HITLS_X509_CrlIndex *crlIdx,
+    const BSL_ASN1_Buffer *serialNum);
+
 /*
  * Verify the CRL, which is the default full certificate chain validation.
  * You can configure not to verify or only verify the terminal certificate
@@ -0,0 +1,325 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include "hitls_build.h"
+#ifdef HITLS_PKI_X509_VFY
+#include <stdlib.h>
+#include <string.h>
+#include "securec.h"
+#include "bsl_sal.h"
+#include "bsl_err_internal.h"
+#include "bsl_list.h"
+#include "crypt_errno.h"
+#include "crypt_eal_pkey.h"
+#include "hitls_pki_errno.h"
+#include "hitls_pki_utils.h"
+#include "hitls_x509_local.h"
+#include "hitls_cert_local.h"
+#include "hitls_crl_local.h"
+#include "hitls_x509_verify.h"
+
+static int32_t X509_CmpSerial(const BSL_ASN1_Buffer *a, const BSL_ASN1_Buffer *b)
+{
+    if (a->tag != b->tag) {
+        return a->tag < b->tag ? -1 : 1;
+    }
+    if (a->len != b->len) {
+        return a->len < b->len ? -1 : 1;
+    }
+    if (a->len == 0) {
+        return 0;
+    }
+    return memcmp(a->buff, b->buff, a->len);
+}
+
+static int X509_CmpCrlEntry(const void *a, const void *b)
+{
+    const HITLS_X509_CrlEntry *entryA = *(const HITLS_X509_CrlEntry * const *)a;
+    const HITLS_X509_CrlEntry *entryB = *(const HITLS_X509_CrlEntry * const *)b;
+    return X509_CmpSerial(&entryA->serialNumber, &entryB->serialNumber);
+}
+
+static int32_t X509_CrlIndexBuildRevoked(HITLS_X509_CrlIndex *crlIdx, BslList *revokedCerts)
+{
+    int32_t num = BSL_LIST_COUNT(revokedCerts);
+    if (num <= 0) {
+        return HITLS_PKI_SUCCESS;
+    }
+    crlIdx->revoked = BSL_SAL_Malloc((uint32_t)num * sizeof(HITLS_X509_CrlEntry *));
+    if (crlIdx->revoked == NULL) {
+        BSL_ERR_PUSH_ERROR(BSL_MALLOC_FAIL);
+        return BSL_MALLOC_FAIL;
+    }
+    uint32_t i = 0;
+    for (BslListNode *node = BSL_LIST_FirstNode(revokedCerts); node != NULL && i < (uint32_t)num;
+        node = BSL_LIST_GetNextNode(revokedCerts, node)) {
+        crlIdx->revoked[i++] = BSL_LIST_GetData(node);
+    }
+    crlIdx->revokedNum = i;
+    qsort(crlIdx->revoked, crlIdx->revokedNum, sizeof(HITLS_X509_CrlEntry *), X509_CmpCrlEntry);
+    return HITLS_PKI_SUCCESS;
+}
+
+static void X509_CrlIndexSetAki(HITLS_X509_CrlIndex *crlIdx, HITLS_X509_Crl *crl)
+{
+    HITLS_X509_ExtAki aki = {0};
+    int32_t ret = X509_ExtCtrl(&crl->tbs.crlExt, HITLS_X509_EXT_GET_AKI, &aki, sizeof(HITLS_X509_ExtAki));
+    if (ret == HITLS_X509_ERR_EXT_NOT_FOUND) {
+        return;
+    }
+    crlIdx->hasAki = true;
+    if (ret != HITLS_PKI_SUCCESS) {
+        // Leave the aki to HITLS_X509_CheckAki, which reports the same error when it is checked.
+        crlIdx->akiHasIssuer = true;
+        return;
+    }
+    crlIdx->akiKid = aki.kid;
+    crlIdx->akiHasIssuer = aki.issuerName != NULL || aki.serialNum.dataLen != 0;
+    HITLS_X509_ClearAuthorityKeyId(&aki);
+}
+
+static bool X509_HasCriticalExt(BslList *extList)
+{
+    for (BslListNode *node = BSL_LIST_FirstNode(extList); node != NULL; node = BSL_LIST_GetNextNode(extList, node)) {
+        HITLS_X509_ExtEntry *extNode = BSL_LIST_GetData(node);
+        if (extNode->cid != BSL_CID_CE_KEYUSAGE && extNode->cid != BSL_CID_CE_BASICCONSTRAINTS &&
+            extNode->critical) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool X509_CrlIndexTrySigner(HITLS_X509_StoreCtx *storeCtx, HITLS_X509_CrlIndex *crlIdx, HITLS_X509_Cert *ca)
+{
+    HITLS_X509_Crl *crl = crlIdx->crl;
+    if (crl->tbs.tbsRawData == NULL || HITLS_X509_NameHash(ca->tbs.subjectName) != crlIdx->issuerHash ||
+        HITLS_X509_CmpNameNode(crl->tbs.issuerName, ca->tbs.subjectName) != 0) {
+        return false;
+    }
+    // If the verification fails, the crl is left unverified and its signature is checked again when it is used.
+#ifdef HITLS_CRYPTO_SM2
+    int32_t ret = X509_StoreCheckSignature(&storeCtx->verifyParam.sm2UserId, ca->tbs.ealPubKey,
+        crl->tbs.tbsRawData, crl->tbs.tbsRawDataLen, &crl->signAlgId, &crl->signature);
+#else
+    (void)storeCtx;
+    int32_t ret = X509_StoreCheckSignature(NULL, ca->tbs.ealPubKey, crl->tbs.tbsRawData, crl->tbs.tbsRawDataLen,
+        &crl->signAlgId, &crl->signature);
+#endif
+    if (ret != HITLS_PKI_SUCCESS) {
+        return false;
+    }
+    int ref;
+    if (HITLS_X509_CertCtrl(ca, HITLS_X509_REF_UP, &ref, sizeof(int)) != HITLS_PKI_SUCCESS) {
+        return false;
+    }
+    crlIdx->signer = ca;
+    return true;
+}
+
+static void X509_CrlIndexFindSigner(HITLS_X509_StoreCtx *storeCtx, HITLS_X509_CrlIndex *crlIdx)
+{
+    HITLS_X509_List *caList = X509_StoreFindCaByName(storeCtx, crlIdx->issuerHash);
+    for (BslListNode *node = BSL_LIST_FirstNode(caList); node != NULL; node = BSL_LIST_GetNextNode(caList, node)) {
+        if (X509_CrlIndexTrySigner(storeCtx, crlIdx, BSL_LIST_GetData(node))) {
+            return;
+        }
+    }
+}
+
+#define HITLS_X509_CRL_INDEX_BKT_SIZE 64
+
+static HITLS_X509_CrlIndex *X509_CrlIndexNew(HITLS_X509_StoreCtx *storeCtx, HITLS_X509_Crl *crl)
+{
+    HITLS_X509_CrlIndex *crlIdx = BSL_SAL_Calloc(1, sizeof(HITLS_X509_CrlIndex));
+    if (crlIdx == NULL) {
+        BSL_ERR_PUSH_ERROR(BSL_MALLOC_FAIL);
+        return NULL;
+    }
+    crlIdx->crl = crl;
+    crlIdx->issuerHash = HITLS_X509_NameHash(crl->tbs.issuerName);
+    crlIdx->hasCriticalExt = X509_HasCriticalExt(crl->tbs.crlExt.extList);
+    X509_CrlIndexSetAki(crlIdx, crl);
+    if (X509_CrlIndexBuildRevoked(crlIdx, crl->tbs.revokedCerts) != HITLS_PKI_SUCCESS) {
+        BSL_SAL_Free(crlIdx);
+        return NULL;
+    }
+    X509_CrlIndexFindSigner(storeCtx, crlIdx);
+    return crlIdx;
+}
+
+static void X509_CrlIndexFree(HITLS_X509_CrlIndex *crlIdx)
+{
+    if (crlIdx == NULL) {
+        return;
+    }
+    HITLS_X509_CertFree(crlIdx->signer);
+    BSL_SAL_Free(crlIdx->revoked);
+    BSL_SAL_Free(crlIdx);
+}
+
+static void X509_CrlIndexListFree(void *crlIdxList)
+{
+    HITLS_X509_List *list = crlIdxList;
+    BSL_LIST_FREE(list, (BSL_LIST_PFUNC_FREE)X509_CrlIndexFree);
+}
+
+HITLS_X509_List *HITLS_X509_CrlIndexFind(const HITLS_X509_StoreCtx *storeCtx, uint32_t nameHash)
+{
+    if (storeCtx->crlIndex == NULL) {
+        return NULL;
+    }
+    BSL_HASH_Iterator it = BSL_HASH_Find(storeCtx->crlIndex, nameHash);
+    if (it == BSL_HASH_IterEnd(storeCtx->crlIndex)) {
+        return NULL;
+    }
+    return (HITLS_X509_List *)BSL_HASH_IterValue(storeCtx->crlIndex, it);
+}
+
+static int32_t X509_CrlIndexInsert(HITLS_X509_StoreCtx *storeCtx, HITLS_X509_CrlIndex *crlIdx)
+{
+    HITLS_X509_List *crlIdxList = HITLS_X509_CrlIndexFind(storeCtx, crlIdx->issuerHash);
+    if (crlIdxList != NULL) {
+        int32_t ret = BSL_LIST_AddElement(crlIdxList, crlIdx, BSL_LIST_POS_END);
+        if (ret != BSL_SUCCESS) {
+            BSL_ERR_PUSH_ERROR(ret);
+        }
+        return ret;
+    }
+    crlIdxList = BSL_LIST_New(sizeof(HITLS_X509_CrlIndex *));
+    if (crlIdxList == NULL) {
+        BSL_ERR_PUSH_ERROR(BSL_MALLOC_FAIL);
+        return BSL_MALLOC_FAIL;
+    }
+    int32_t ret = BSL_LIST_AddElement(crlIdxList, crlIdx, BSL_LIST_POS_END);
+    if (ret != BSL_SUCCESS) {
+        BSL_LIST_FreeWithoutData(crlIdxList);
+        BSL_ERR_PUSH_ERROR(ret);
+        return ret;
+    }
+    ret = BSL_HASH_Insert(storeCtx->crlIndex, crlIdx->issuerHash, 0, (uintptr_t)crlIdxList, 0);
+    if (ret != BSL_SUCCESS) {
+        BSL_LIST_FreeWithoutData(crlIdxList);
+        BSL_ERR_PUSH_ERROR(ret);
+    }
+    return ret;
+}
+
+int32_t HITLS_X509_CrlIndexAdd(HITLS_X509_StoreCtx *storeCtx, HITLS_X509_Crl *crl)
+{
+    if (storeCtx->crlIndex == NULL) {
+        ListDupFreeFuncPair valueFunc = {NULL, X509_CrlIndexListFree};
+        storeCtx->crlIndex = BSL_HASH_Create(HITLS_X509_CRL_INDEX_BKT_SIZE, NULL, NULL, NULL, &valueFunc);
+        if (storeCtx->crlIndex == NULL) {
+            BSL_ERR_PUSH_ERROR(BSL_MALLOC_FAIL);
+            return BSL_MALLOC_FAIL;
+        }
+    }
+    HITLS_X509_CrlIndex *crlIdx = X509_CrlIndexNew(storeCtx, crl);
+    if (crlIdx == NULL) {
+        return BSL_MALLOC_FAIL;
+    }
+    int32_t ret = X509_CrlIndexInsert(storeCtx, crlIdx);
+    if (ret != HITLS_PKI_SUCCESS) {
+        X509_CrlIndexFree(crlIdx);
+        return ret;
+    }
+    storeCtx->crlIndexNum++;
+    return ret;
+}
+
+int32_t HITLS_X509_CrlIndexRebuild(HITLS_X509_StoreCtx *storeCtx)
+{
+    BSL_HASH_Destory(storeCtx->crlIndex);
+    storeCtx->crlIndex = NULL;
+    storeCtx->crlIndexNum = 0;
+    for (BslListNode *node = BSL_LIST_FirstNode(storeCtx->crl); node != NULL;
+        node = BSL_LIST_GetNextNode(storeCtx->crl, node)) {
+        int32_t ret = HITLS_X509_CrlIndexAdd(storeCtx, BSL_LIST_GetData(node));
+        if (ret != HITLS_PKI_SUCCESS) {
+            BSL_HASH_Destory(storeCtx->crlIndex);
+            storeCtx->crlIndex = NULL;
+            storeCtx->crlIndexNum = 0;
+            return ret;
+        }
+    }
+    return HITLS_PKI_SUCCESS;
+}
+
+/*
+ * The verdict only depends on the public key, so it also holds for another copy of the signer, or for a ca
+ * which is issued again with the same key.
+ */
+bool HITLS_X509_CrlIndexIsSignedBy(const HITLS_X509_CrlIndex *crlIdx, const HITLS_X509_Cert *parent)
+{
+    if (crlIdx->signer == NULL) {
+        return false;
+    }
+    if (crlIdx->signer == parent) {
+        return true;
+    }
+    return CRYPT_EAL_PkeyCmp(crlIdx->signer->tbs.ealPubKey, parent->tbs.ealPubKey) == CRYPT_SUCCESS;
+}
+
+void HITLS_X509_CrlIndexAddSigner(HITLS_X509_StoreCtx *storeCtx, HITLS_X509_Cert *ca)
+{
+    HITLS_X509_List *crlIdxList = HITLS_X509_CrlIndexFind(storeCtx, HITLS_X509_NameHash(ca->tbs.subjectName));
+    for (BslListNode *node = BSL_LIST_FirstNode(crlIdxList); node != NULL;
+        node = BSL_LIST_GetNextNode(crlIdxList, node)) {
+        HITLS_X509_CrlIndex *crlIdx = BSL_LIST_GetData(node);
+        if (crlIdx->signer == NULL) {
+            (void)X509_CrlIndexTrySigner(storeCtx, crlIdx, ca);
+        }
+    }
+}
+
+void HITLS_X509_CrlIndexResetSigner(HITLS_X509_StoreCtx *storeCtx)
+{
+    if (storeCtx->crlIndex == NULL) {
+        return;
+    }
+    for (BSL_HASH_Iterator it = BSL_HASH_IterBegin(storeCtx->crlIndex); it != BSL_HASH_IterEnd(storeCtx->crlIndex);
+        it = BSL_HASH_IterNext(storeCtx->crlIndex, it)) {
+        HITLS_X509_List *crlIdxList = (HITLS_X509_List *)BSL_HASH_IterValue(storeCtx->crlIndex, it);
+        for (BslListNode *node = BSL_LIST_FirstNode(crlIdxList); node != NULL;
+            node = BSL_LIST_GetNextNode(crlIdxList, node)) {
+            HITLS_X509_CrlIndex *crlIdx = BSL_LIST_GetData(node);
+            HITLS_X509_CertFree(crlIdx->signer);
+            crlIdx->signer = NULL;
+            X509_CrlIndexFindSigner(storeCtx, crlIdx);
+        }
+    }
+}
+
+HITLS_X509_CrlEntry *HITLS_X509_CrlIndexFindRevoked(const HITLS_X509_CrlIndex *crlIdx,
+    const BSL_ASN1_Buffer *serialNum)
+{
+    uint32_t low = 0;
+    uint32_t high = crlIdx->revokedNum;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        int32_t cmp = X509_CmpSerial(&crlIdx->revoked[mid]->serialNumber, serialNum);
+        if (cmp == 0) {
+            return crlIdx->revoked[mid];
+        }
+        if (cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return NULL;
+}
+#endif // HITLS_PKI_X509_VFY
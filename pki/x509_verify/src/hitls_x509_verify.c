@@ -27,6 +27,7 @@
 #include "hitls_pki_errno.h"
 #include "bsl_list.h"
 #include "bsl_list_internal.h"
+#include "bsl_hash.h"
 #include "hitls_x509_verify.h"
 
 typedef int32_t (*HITLS_X509_TrvListCallBack)(void *ctx, void *node);
@@ -65,6 +66,7 @@ static int32_t HITLS_X509_TrvListWithParent(BslList *list, HITLS_X509_TrvListWit
 }
 
 #define HITLS_X509_MAX_DEPTH 20
+#define HITLS_X509_CA_INDEX_BKT_SIZE 256
 
 void HITLS_X509_StoreCtxFree(HITLS_X509_StoreCtx *storeCtx)
 {
@@ -80,6 +82,8 @@ void HITLS_X509_StoreCtxFree(HITLS_X509_StoreCtx *storeCtx)
 #ifdef HITLS_CRYPTO_SM2
     BSL_SAL_FREE(storeCtx->verifyParam.sm2UserId.data);
 #endif
+    BSL_HASH_Destory(storeCtx->crlIndex);
+    BSL_HASH_Destory(storeCtx->caIndex);
     BSL_LIST_FREE(storeCtx->store, (BSL_LIST_PFUNC_FREE)HITLS_X509_CertFree);
     BSL_LIST_FREE(storeCtx->crl, (BSL_LIST_PFUNC_FREE)HITLS_X509_CrlFree);
     BSL_SAL_ReferencesFree(&storeCtx->references);
@@ -155,7 +159,10 @@ static int32_t X509_SetMaxDepth(HITLS_X509_StoreCtx *storeCtx, int32_t *val, uin
         BSL_ERR_PUSH_ERROR(HITLS_X509_ERR_INVALID_PARAM);
         return HITLS_X509_ERR_INVALID_PARAM;
     }
-    storeCtx->verifyParam.maxDepth = depth;
+    if (storeCtx->verifyParam.maxDepth != depth) {
+        storeCtx->verifyParam.maxDepth = depth;
+        storeCtx->chainGen++;
+    }
     return HITLS_PKI_SUCCESS;
 }
 
@@ -205,14 +212,64 @@ static int32_t X509_ClearParamFlag(HITLS_X509_StoreCtx *storeCtx, uint64_t *val,
     return HITLS_PKI_SUCCESS;
 }
 
+HITLS_X509_List *X509_StoreFindCaByName(HITLS_X509_StoreCtx *storeCtx, uint32_t nameHash)
+{
+    if (storeCtx->caIndex == NULL) {
+        return storeCtx->store;
+    }
+    BSL_HASH_Iterator it = BSL_HASH_Find(storeCtx->caIndex, nameHash);
+    if (it == BSL_HASH_IterEnd(storeCtx->caIndex)) {
+        return NULL;
+    }
+    return (HITLS_X509_List *)BSL_HASH_IterValue(storeCtx->caIndex, it);
+}
+
+static int32_t X509_CaIndexAdd(HITLS_X509_StoreCtx *storeCtx, HITLS_X509_Cert *cert)
+{
+    if (storeCtx->caIndex == NULL) {
+        ListDupFreeFuncPair valueFunc = {NULL, (ListFreeFunc)BSL_LIST_FreeWithoutData};
+        storeCtx->caIndex = BSL_HASH_Create(HITLS_X509_CA_INDEX_BKT_SIZE, NULL, NULL, NULL, &valueFunc);
+        if (storeCtx->caIndex == NULL) {
+            BSL_ERR_PUSH_ERROR(BSL_MALLOC_FAIL);
+            return BSL_MALLOC_FAIL;
+        }
+    }
+    uint32_t nameHash = HITLS_X509_NameHash(cert->tbs.subjectName);
+    HITLS_X509_List *caList = X509_StoreFindCaByName(storeCtx, nameHash);
+    if (caList != NULL) {
+        int32_t ret = BSL_LIST_AddElement(caList, cert, BSL_LIST_POS_BEGIN);
+        if (ret != BSL_SUCCESS) {
+            BSL_ERR_PUSH_ERROR(ret);
+        }
+        return ret;
+    }
+    caList = BSL_LIST_New(sizeof(HITLS_X509_Cert *));
+    if (caList == NULL) {
+        BSL_ERR_PUSH_ERROR(BSL_MALLOC_FAIL);
+        return BSL_MALLOC_FAIL;
+    }
+    int32_t ret = BSL_LIST_AddElement(caList, cert, BSL_LIST_POS_BEGIN);
+    if (ret != BSL_SUCCESS) {
+        BSL_LIST_FreeWithoutData(caList);
+        BSL_ERR_PUSH_ERROR(ret);
+        return ret;
+    }
+    ret = BSL_HASH_Insert(storeCtx->caIndex, nameHash, 0, (uintptr_t)caList, 0);
+    if (ret != BSL_SUCCESS) {
+        BSL_LIST_FreeWithoutData(caList);
+        BSL_ERR_PUSH_ERROR(ret);
+    }
+    return ret;
+}
+
 static int32_t X509_CheckCert(HITLS_X509_StoreCtx *storeCtx, HITLS_X509_Cert *cert)
 {
     if (!HITLS_X509_CertIsCA(cert)) {
         BSL_ERR_PUSH_ERROR(HITLS_X509_ERR_CERT_NOT_CA);
         return HITLS_X509_ERR_CERT_NOT_CA;
     }
-    HITLS_X509_List *certStore = storeCtx->store;
-    HITLS_X509_Cert *tmp = BSL_LIST_SearchEx(certStore, cert, (BSL_LIST_PFUNC_CMP)X509_CertCmp);
+    HITLS_X509_List *caList = X509_StoreFindCaByName(storeCtx, HITLS_X509_NameHash(cert->tbs.subjectName));
+    HITLS_X509_Cert *tmp = BSL_LIST_SearchEx(caList, cert, (BSL_LIST_PFUNC_CMP)X509_CertCmp);
     if (tmp != NULL) {
         BSL_ERR_PUSH_ERROR(HITLS_X509_ERR_CERT_EXIST);
         return HITLS_X509_ERR_CERT_EXIST;
@@ -241,7 +298,18 @@ static int32_t X509_SetCA(HITLS_X509_StoreCtx *storeCtx, void *val, bool isCopy)
             HITLS_X509_CertFree(val);
         }
         BSL_ERR_PUSH_ERROR(ret);
+        return ret;
     }
+    ret = X509_CaIndexAdd(storeCtx, val);
+    if (ret != HITLS_PKI_SUCCESS) {
+        BSL_LIST_DetachCurrent(storeCtx->store);
+        if (isCopy) {
+            HITLS_X509_CertFree(val);
+        }
+        return ret;
+    }
+    HITLS_X509_CrlIndexAddSigner(storeCtx, val);
+    storeCtx->chainGen++;
     return ret;
 }
 
@@ -268,13 +336,34 @@ static int32_t X509_SetCRL(HITLS_X509_StoreCtx *storeCtx, void *val)
     if (ret != HITLS_PKI_SUCCESS) {
         return ret;
     }
+    bool isIndexed = storeCtx->crlIndexNum == (uint32_t)BSL_LIST_COUNT(storeCtx->crl);
     ret = BSL_LIST_AddElement(storeCtx->crl, val, BSL_LIST_POS_BEFORE);
     if (ret != HITLS_PKI_SUCCESS) {
         HITLS_X509_CrlFree(val);
         BSL_ERR_PUSH_ERROR(ret);
+        return ret;
+    }
+    // Crls have been put into the list without the ctrl, so the whole list is indexed again.
+    ret = isIndexed ? HITLS_X509_CrlIndexAdd(storeCtx, val) : HITLS_X509_CrlIndexRebuild(storeCtx);
+    if (ret != HITLS_PKI_SUCCESS) {
+        BSL_LIST_DetachCurrent(storeCtx->crl);
+        HITLS_X509_CrlFree(val);
+    }
+    return ret;
+}
+
+#ifdef HITLS_CRYPTO_SM2
+static int32_t X509_SetVfySm2UserId(HITLS_X509_StoreCtx *storeCtx, void *val, uint32_t valLen)
+{
+    int32_t ret = HITLS_X509_SetSm2UserId(&storeCtx->verifyParam.sm2UserId, val, valLen);
+    if (ret != HITLS_PKI_SUCCESS) {
+        return ret;
     }
+    // The sm2 signatures of the crls depend on the user id.
+    HITLS_X509_CrlIndexResetSigner(storeCtx);
     return ret;
 }
+#endif
 
 static int32_t X509_RefUp(HITLS_X509_StoreCtx *storeCtx, void *val, uint32_t valLen)
 {
@@ -286,6 +375,17 @@ static int32_t X509_RefUp(HITLS_X509_StoreCtx *storeCtx, void *val, uint32_t val
     return BSL_SAL_AtomicUpReferences(&storeCtx->references, val);
 }
 
+static int32_t X509_GetChainGen(HITLS_X509_StoreCtx *storeCtx, uint32_t *val, uint32_t valLen)
+{
+    if (valLen != sizeof(uint32_t)) {
+        BSL_ERR_PUSH_ERROR(HITLS_X509_ERR_INVALID_PARAM);
+        return HITLS_X509_ERR_INVALID_PARAM;
+    }
+
+    *val = storeCtx->chainGen;
+    return HITLS_PKI_SUCCESS;
+}
+
 int32_t HITLS_X509_StoreCtxCtrl(HITLS_X509_StoreCtx *storeCtx, int32_t cmd, void *val, uint32_t valLen)
 {
     if (storeCtx == NULL || val == NULL) {
@@ -313,8 +413,10 @@ int32_t HITLS_X509_StoreCtxCtrl(HITLS_X509_StoreCtx *storeCtx, int32_t cmd, void
             return X509_RefUp(storeCtx, val, valLen);
 #ifdef HITLS_CRYPTO_SM2
         case HITLS_X509_STORECTX_SET_VFY_SM2_USERID:
-            return HITLS_X509_SetSm2UserId(&storeCtx->verifyParam.sm2UserId, val, valLen);
+            return X509_SetVfySm2UserId(storeCtx, val, valLen);
 #endif
+        case HITLS_X509_STORECTX_GET_CHAIN_GEN:
+            return X509_GetChainGen(storeCtx, val, valLen);
         default:
             BSL_ERR_PUSH_ERROR(HITLS_X509_ERR_INVALID_PARAM);
             return HITLS_X509_ERR_INVALID_PARAM;
@@ -373,7 +475,9 @@ static int32_t X509_AddCertToChain(HITLS_X509_List *chain, HITLS_X509_Cert *cert
 int32_t X509_GetIssueFromChain(HITLS_X509_List *certChain, HITLS_X509_Cert *cert, HITLS_X509_Cert **issue)
 {
     int32_t ret;
-    for (HITLS_X509_Cert *tmp = BSL_LIST_GET_FIRST(certChain); tmp != NULL; tmp = BSL_LIST_GET_NEXT(certChain)) {
+    for (BslListNode *node = BSL_LIST_FirstNode(certChain); node != NULL;
+        node = BSL_LIST_GetNextNode(certChain, node)) {
+        HITLS_X509_Cert *tmp = BSL_LIST_GetData(node);
         bool res = false;
         ret = HITLS_X509_CheckIssued(tmp, cert, &res);
         if (ret != HITLS_PKI_SUCCESS) {
@@ -392,7 +496,8 @@ int32_t X509_GetIssueFromChain(HITLS_X509_List *certChain, HITLS_X509_Cert *cert
 int32_t X509_FindIssueCert(HITLS_X509_StoreCtx *storeCtx, HITLS_X509_List *certChain, HITLS_X509_Cert *cert,
     HITLS_X509_Cert **issue, bool *issueInTrust)
 {
-    HITLS_X509_List *store = storeCtx->store;
+    // Only the trusted cas with the same subject name hash as the issuer name of the cert can issue it.
+    HITLS_X509_List *store = X509_StoreFindCaByName(storeCtx, HITLS_X509_NameHash(cert->tbs.issuerName));
     int32_t ret = X509_GetIssueFromChain(store, cert, issue);
     if (ret == HITLS_PKI_SUCCESS) {
         *issueInTrust = true;
@@ -580,7 +685,7 @@ int32_t HITLS_X509_CheckCertRevoked(HITLS_X509_Cert *cert, HITLS_X509_CrlEntry *
     return HITLS_PKI_SUCCESS;
 }
 
-static int32_t X509_StoreCheckSignature(const BSL_Buffer *sm2UserId, const CRYPT_EAL_PkeyCtx *pubKey,
+int32_t X509_StoreCheckSignature(const BSL_Buffer *sm2UserId, const CRYPT_EAL_PkeyCtx *pubKey,
     uint8_t *rawData, uint32_t rawDataLen, HITLS_X509_Asn1AlgId *alg, BSL_ASN1_BitString *signature)
 {
 #ifdef HITLS_CRYPTO_SM2
@@ -606,10 +711,8 @@ static int32_t X509_StoreCheckSignature(const BSL_Buffer *sm2UserId, const CRYPT
     return ret;
 }
 
-int32_t HITLS_X509_CheckCertCrl(HITLS_X509_StoreCtx *storeCtx, HITLS_X509_Cert *cert, HITLS_X509_Cert *parent)
+static int32_t X509_CheckCrlKeyUsage(HITLS_X509_Cert *parent)
 {
-    int32_t ret = HITLS_X509_ERR_CRL_NOT_FOUND;
-    HITLS_X509_Crl *crl = BSL_LIST_GET_FIRST(storeCtx->crl);
     HITLS_X509_CertExt *certExt = (HITLS_X509_CertExt *)parent->tbs.ext.extData;
     if ((certExt->extFlags & HITLS_X509_EXT_FLAG_KUSAGE) != 0) {
         if ((certExt->keyUsage & HITLS_X509_EXT_KU_CRL_SIGN) == 0) {
@@ -617,6 +720,14 @@ int32_t HITLS_X509_CheckCertCrl(HITLS_X509_StoreCtx *storeCtx, HITLS_X509_Cert *
             return HITLS_X509_ERR_VFY_KU_NO_CRLSIGN;
         }
     }
+    return HITLS_PKI_SUCCESS;
+}
+
+static int32_t X509_CheckCertCrlByList(HITLS_X509_StoreCtx *storeCtx, HITLS_X509_Cert *cert,
+    HITLS_X509_Cert *parent)
+{
+    int32_t ret = HITLS_X509_ERR_CRL_NOT_FOUND;
+    HITLS_X509_Crl *crl = BSL_LIST_GET_FIRST(storeCtx->crl);
     while (crl != NULL) {
         if (HITLS_X509_CmpNameNode(crl->tbs.issuerName, parent->tbs.subjectName) != 0) {
             crl = BSL_LIST_GET_NEXT(storeCtx->crl);
@@ -662,6 +773,91 @@ int32_t HITLS_X509_CheckCertCrl(HITLS_X509_StoreCtx *storeCtx, HITLS_X509_Cert *
     return ret;
 }
 
+/* Same result as HITLS_X509_CheckAki, but the aki of the crl has been parsed when it was indexed. */
+static bool X509_CrlIndexAkiMatch(HITLS_X509_CrlIndex *crlIdx, HITLS_X509_Cert *parent, int32_t skiRet,
+    const HITLS_X509_ExtSki *ski)
+{
+    if (skiRet == HITLS_X509_ERR_EXT_NOT_FOUND || !crlIdx->hasAki) {
+        return true;
+    }
+    if (skiRet != HITLS_PKI_SUCCESS) {
+        return false;
+    }
+    if (!crlIdx->akiHasIssuer) {
+        return ski->kid.dataLen == crlIdx->akiKid.dataLen &&
+            memcmp(ski->kid.data, crlIdx->akiKid.data, ski->kid.dataLen) == 0;
+    }
+    return HITLS_X509_CheckAki(&parent->tbs.ext, &crlIdx->crl->tbs.crlExt, parent->tbs.issuerName,
+        &parent->tbs.serialNum) == HITLS_PKI_SUCCESS;
+}
+
+static int32_t X509_CheckCertCrlByIndex(HITLS_X509_StoreCtx *storeCtx, HITLS_X509_Cert *cert,
+    HITLS_X509_Cert *parent)
+{
+    int32_t ret = HITLS_X509_ERR_CRL_NOT_FOUND;
+    uint32_t parentHash = HITLS_X509_NameHash(parent->tbs.subjectName);
+    HITLS_X509_ExtSki ski = {0};
+    int32_t skiRet = HITLS_X509_ERR_EXT_NOT_FOUND;
+    bool skiLoaded = false;
+    HITLS_X509_List *crlIdxList = HITLS_X509_CrlIndexFind(storeCtx, parentHash);
+    for (BslListNode *node = BSL_LIST_FirstNode(crlIdxList); node != NULL;
+        node = BSL_LIST_GetNextNode(crlIdxList, node)) {
+        HITLS_X509_CrlIndex *crlIdx = BSL_LIST_GetData(node);
+        HITLS_X509_Crl *crl = crlIdx->crl;
+        if (HITLS_X509_CmpNameNode(crl->tbs.issuerName, parent->tbs.subjectName) != 0) {
+            continue;
+        }
+        if (cert->tbs.version == HITLS_X509_VERSION_3 && crl->tbs.version == 1) {
+            if (!skiLoaded) {
+                skiRet = X509_ExtCtrl(&parent->tbs.ext, HITLS_X509_EXT_GET_SKI, &ski, sizeof(HITLS_X509_ExtSki));
+                skiLoaded = true;
+            }
+            if (!X509_CrlIndexAkiMatch(crlIdx, parent, skiRet, &ski)) {
+                continue;
+            }
+        }
+        if (HITLS_X509_CheckTime(storeCtx, &(crl->tbs.validTime)) != HITLS_PKI_SUCCESS) {
+            continue;
+        }
+        if (crlIdx->hasCriticalExt) {
+            BSL_ERR_PUSH_ERROR(HITLS_X509_ERR_PROCESS_CRITICALEXT);
+            return HITLS_X509_ERR_PROCESS_CRITICALEXT;
+        }
+        if (!HITLS_X509_CrlIndexIsSignedBy(crlIdx, parent)) {
+#ifdef HITLS_CRYPTO_SM2
+            ret = X509_StoreCheckSignature(&storeCtx->verifyParam.sm2UserId, parent->tbs.ealPubKey,
+                crl->tbs.tbsRawData, crl->tbs.tbsRawDataLen, &(crl->signAlgId), &(crl->signature));
+#else
+            ret = X509_StoreCheckSignature(NULL, parent->tbs.ealPubKey, crl->tbs.tbsRawData,
+                crl->tbs.tbsRawDataLen, &(crl->signAlgId), &(crl->signature));
+#endif
+            if (ret != HITLS_PKI_SUCCESS) {
+                BSL_ERR_PUSH_ERROR(ret);
+                return ret;
+            }
+        }
+        if (HITLS_X509_CrlIndexFindRevoked(crlIdx, &cert->tbs.serialNum) != NULL) {
+            BSL_ERR_PUSH_ERROR(HITLS_X509_ERR_VFY_CERT_REVOKED);
+            return HITLS_X509_ERR_VFY_CERT_REVOKED;
+        }
+        ret = HITLS_PKI_SUCCESS;
+    }
+    return ret;
+}
+
+int32_t HITLS_X509_CheckCertCrl(HITLS_X509_StoreCtx *storeCtx, HITLS_X509_Cert *cert, HITLS_X509_Cert *parent)
+{
+    int32_t ret = X509_CheckCrlKeyUsage(parent);
+    if (ret != HITLS_PKI_SUCCESS) {
+        return ret;
+    }
+    // The crls which are not set by HITLS_X509_STORECTX_SET_CRL have no index.
+    if (storeCtx->crlIndex != NULL && storeCtx->crlIndexNum == (uint32_t)BSL_LIST_COUNT(storeCtx->crl)) {
+        return X509_CheckCertCrlByIndex(storeCtx, cert, parent);
+    }
+    return X509_CheckCertCrlByList(storeCtx, cert, parent);
+}
+
 int32_t HITLS_X509_VerifyCrl(HITLS_X509_StoreCtx *storeCtx, HITLS_X509_List *chain)
 {
     // Only the self-signed certificate, and the CRL is not verified
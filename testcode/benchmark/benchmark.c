@@ -17,41 +17,288 @@
 #include <stdlib.h>
 #include <getopt.h>
 #include <string.h>
+#include <math.h>
+#include <inttypes.h>
 #include "crypt_errno.h"
 #include "crypt_algid.h"
 #include "crypt_eal_rand.h"
 #include "benchmark.h"
 
 extern BenchCtx Sm2BenchCtx;
+extern BenchCtx X509VfyBenchCtx;
+extern BenchCtx ErrBenchCtx;
+extern BenchCtx MdBenchCtx;
+extern BenchCtx MacBenchCtx;
+extern BenchCtx CipherBenchCtx;
+extern BenchCtx KdfBenchCtx;
+extern BenchCtx ConnBenchCtx;
+extern BenchCtx MlKemBenchCtx;
+extern BenchCtx RandBenchCtx;
 
 BenchCtx *g_benchs[] = {
     &Sm2BenchCtx,
+    &X509VfyBenchCtx,
+    &ErrBenchCtx,
+    &MdBenchCtx,
+    &MacBenchCtx,
+    &CipherBenchCtx,
+    &KdfBenchCtx,
+    &ConnBenchCtx,
+    &MlKemBenchCtx,
+    &RandBenchCtx,
 };
 
+static const uint32_t g_defaultLens[] = {16, 64, 256, 1024, 8192, 16384};
+
 // 定义命令行选项结构
 typedef struct {
     char *algorithm;     // -a 选项指定的算法
     uint32_t times;      // -t 选项指定的运行次数
     uint32_t seconds;    // -s 选项指定的运行时间
-    uint32_t len;
+    uint32_t warmup;     // -w 选项指定的预热次数
+    uint32_t repeats;    // -r 选项指定的重复轮数
+    uint32_t lens[BENCH_MAX_LENS]; // -l 选项指定的消息长度
+    uint32_t lenNum;
+    BenchFormat format;  // -o 选项指定的输出格式
 } BenchOptions;
 
+#define BENCH_MAX_REPEATS 64
+
+#define BENCH_CALIBRATE_TIMES 1000
+
+// State of the BENCH_RUN in progress
+typedef struct {
+    const BenchCtx *bench;
+    int32_t repeat;          // index of the current repetition
+    uint64_t repCalls;       // calls of the current repetition
+    uint64_t repTarget;      // calls, or nanoseconds in seconds mode, of every repetition
+    uint64_t repStart;
+    uint64_t repCycles;      // cycle counter at the start of the current repetition
+    uint64_t batch;          // calls of the batch in progress
+    double repOps[BENCH_MAX_REPEATS]; // ops/s of every repetition
+    uint64_t calls;
+    uint64_t cycles;
+    uint64_t *samples;       // per call latency in nanoseconds
+    uint32_t sampleNum;
+} BenchRun;
+
+static BenchRun g_run;
+static BenchFormat g_format = BENCH_FMT_TEXT;
+static uint32_t g_reportNum = 0;
+static uint64_t g_clockNs = 0; // cost of the two clock reads around a timed call
+
+// The cheapest of many back to back clock reads, taken off every latency sample.
+static void BenchCalibrate(void)
+{
+    uint64_t best = UINT64_MAX;
+    for (uint32_t i = 0; i < BENCH_CALIBRATE_TIMES; i++) {
+        uint64_t start = BenchNowNs();
+        uint64_t ns = BenchNowNs() - start;
+        best = (ns < best) ? ns : best;
+    }
+    g_clockNs = best;
+}
+
+void BenchRunStart(const BenchCtx *bench)
+{
+    g_run.bench = bench;
+    g_run.repeat = -1;
+    g_run.repCalls = 0;
+    g_run.batch = 0;
+    g_run.calls = 0;
+    g_run.cycles = 0;
+    g_run.sampleNum = 0;
+    int32_t repeats = bench->repeats;
+    if (bench->seconds > 0) {
+        g_run.repTarget = (uint64_t)bench->seconds * 1000000000 / (uint64_t)repeats;
+    } else {
+        g_run.repTarget = ((uint64_t)bench->times + (uint64_t)repeats - 1) / (uint64_t)repeats;
+    }
+}
+
+/*
+ * In seconds mode the next batch doubles the calls run so far in the repetition, but does not go past the time left
+ * at the rate seen so far, so the clock is read a logarithmic number of times per repetition.
+ */
+static uint64_t BenchNextBatch(uint64_t elapsed)
+{
+    uint64_t left = g_run.repTarget - elapsed;
+    uint64_t batch = g_run.repCalls;
+    if (elapsed != 0 && (double)batch * elapsed > (double)left * g_run.repCalls) {
+        batch = (uint64_t)((double)left * g_run.repCalls / elapsed);
+    }
+    return (batch == 0) ? 1 : batch;
+}
+
+/*
+ * Finish the batch of calls just run and return the calls of the next one, 0 when the run is over. A repetition is a
+ * single batch of its calls in times mode, or batches until its time is up in seconds mode.
+ */
+uint64_t BenchRunNext(void)
+{
+    const BenchCtx *bench = g_run.bench;
+    if (g_run.repeat >= 0) {
+        uint64_t elapsed = BenchNowNs() - g_run.repStart;
+        uint64_t cycles = BenchCycles() - g_run.repCycles;
+        g_run.repCalls += g_run.batch;
+        if (bench->seconds > 0 && elapsed < g_run.repTarget) {
+            g_run.batch = BenchNextBatch(elapsed);
+            return g_run.batch;
+        }
+        g_run.repOps[g_run.repeat] = (elapsed == 0) ? 0 : (double)g_run.repCalls * 1000000000 / elapsed;
+        g_run.calls += g_run.repCalls;
+        g_run.cycles += cycles;
+    }
+    g_run.repeat++;
+    if (g_run.repeat >= bench->repeats) {
+        return 0;
+    }
+    g_run.repCalls = 0;
+    g_run.batch = (bench->seconds > 0) ? 1 : g_run.repTarget;
+    g_run.repCycles = BenchCycles();
+    g_run.repStart = BenchNowNs();
+    return g_run.batch;
+}
+
+// The latency pass takes as many calls as one repetition, no more than the samples kept.
+uint32_t BenchSampleNum(void)
+{
+    uint64_t num = g_run.calls / (uint64_t)g_run.bench->repeats;
+    if (g_run.samples == NULL) {
+        return 0;
+    }
+    num = (num < BENCH_MAX_SAMPLES) ? num : BENCH_MAX_SAMPLES;
+    return (num == 0) ? 1 : (uint32_t)num;
+}
+
+void BenchSample(uint64_t ns)
+{
+    if (g_run.samples != NULL && g_run.sampleNum < BENCH_MAX_SAMPLES) {
+        g_run.samples[g_run.sampleNum++] = (ns > g_clockNs) ? ns - g_clockNs : 0;
+    }
+}
+
+static int CompareSample(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t Percentile(uint32_t percent)
+{
+    if (g_run.sampleNum == 0) {
+        return 0;
+    }
+    uint32_t idx = (uint32_t)(((uint64_t)g_run.sampleNum * percent) / 100);
+    return g_run.samples[idx < g_run.sampleNum ? idx : g_run.sampleNum - 1];
+}
+
+static void PrintHeader(void)
+{
+    switch (g_format) {
+        case BENCH_FMT_CSV:
+            printf("operation,len,runs,ops_per_sec,rsd_percent,p50_ns,p99_ns,mb_per_sec,cycles_per_byte\n");
+            break;
+        case BENCH_FMT_JSON:
+            printf("[\n");
+            break;
+        default:
+            printf("%-32s, %6s, %10s, %14s, %7s, %10s, %10s, %10s, %9s\n", "algorithm operation", "len", "run times",
+                "ops/s", "rsd(%)", "p50(ns)", "p99(ns)", "MB/s", "cycles/B");
+            break;
+    }
+}
+
+static void PrintFooter(void)
+{
+    if (g_format == BENCH_FMT_JSON) {
+        printf("\n]\n");
+    }
+}
+
+void BenchReport(const char *header, uint32_t len)
+{
+    int32_t repeats = g_run.bench->repeats;
+    double mean = 0;
+    for (int32_t i = 0; i < repeats; i++) {
+        mean += g_run.repOps[i];
+    }
+    mean /= repeats;
+    double variance = 0;
+    for (int32_t i = 0; i < repeats; i++) {
+        variance += (g_run.repOps[i] - mean) * (g_run.repOps[i] - mean);
+    }
+    double rsd = (repeats > 1 && mean > 0) ? sqrt(variance / (repeats - 1)) * 100 / mean : 0;
+    qsort(g_run.samples, g_run.sampleNum, sizeof(uint64_t), CompareSample);
+    uint64_t p50 = Percentile(50);
+    uint64_t p99 = Percentile(99);
+    double mbps = (double)len * mean / 1000000;
+    // cycles/byte is negative when it does not apply: no message length or no cycle counter
+    double cpb = (len == 0 || g_run.cycles == 0) ? -1 : (double)g_run.cycles / ((double)g_run.calls * len);
+
+    switch (g_format) {
+        case BENCH_FMT_CSV:
+            printf("%s,%u,%" PRIu64 ",%.2f,%.2f,%" PRIu64 ",%" PRIu64 ",%.2f,%.2f\n", header, len, g_run.calls, mean, rsd, p50, p99, mbps, cpb);
+            break;
+        case BENCH_FMT_JSON:
+            printf("%s  {\"operation\": \"%s\", \"len\": %u, \"runs\": %" PRIu64 ", \"ops_per_sec\": %.2f, "
+                "\"rsd_percent\": %.2f, \"p50_ns\": %" PRIu64 ", \"p99_ns\": %" PRIu64 ", \"mb_per_sec\": %.2f, "
+                "\"cycles_per_byte\": %.2f}", g_reportNum == 0 ? "" : ",\n", header, len, g_run.calls, mean, rsd,
+                p50, p99, mbps, cpb);
+            break;
+        default:
+            printf("%-32s, %6u, %10" PRIu64 ", %14.2f, %7.2f, %10" PRIu64 ", %10" PRIu64 ", %10.2f, %9.2f\n", header, len, g_run.calls, mean,
+                rsd, p50, p99, mbps, cpb);
+            break;
+    }
+    g_reportNum++;
+}
+
 static void PrintUsage(void)
 {
     printf("Usage: openhitls_benchmark [options]\n");
     printf("Options:\n");
     printf("  -a <algorithm>  Specify algorithm to benchmark (e.g., sm2*, sm2-KeyGen, *KeyGen)\n");
     printf("  -t <times>      Number of times to run each benchmark\n");
-    printf("  -s <seconds>    Number of seconds to run each benchmark\n");
-    printf("  -l <len>        Length of the payload to benchmark\n");
-    printf("  -h             Show this help message\n");
+    printf("  -s <seconds>    Number of seconds to run each benchmark, instead of a number of times\n");
+    printf("  -l <len,...>    Comma separated payload lengths of the hash, mac, cipher and kdf benchmarks\n");
+    printf("  -w <times>      Number of untimed warm-up runs before each benchmark\n");
+    printf("  -r <repeats>    Number of repetitions the runs are split into, for the relative standard deviation\n");
+    printf("  -o <format>     Output format: text, csv or json\n");
+    printf("  -h              Show this help message\n");
+}
+
+static void ParseLens(const char *arg, BenchOptions *opts)
+{
+    char buf[256];
+    (void)snprintf(buf, sizeof(buf), "%s", arg);
+    opts->lenNum = 0;
+    for (char *tok = strtok(buf, ","); tok != NULL && opts->lenNum < BENCH_MAX_LENS; tok = strtok(NULL, ",")) {
+        opts->lens[opts->lenNum++] = (uint32_t)atoi(tok);
+    }
+}
+
+static BenchFormat ParseFormat(const char *arg)
+{
+    if (strcmp(arg, "csv") == 0) {
+        return BENCH_FMT_CSV;
+    }
+    if (strcmp(arg, "json") == 0) {
+        return BENCH_FMT_JSON;
+    }
+    if (strcmp(arg, "text") != 0) {
+        PrintUsage();
+        exit(1);
+    }
+    return BENCH_FMT_TEXT;
 }
 
 static void ParseOptions(int argc, char **argv, BenchOptions *opts)
 {
     int c;
 
-    while ((c = getopt(argc, argv, "a:t:s:h")) != -1) {
+    while ((c = getopt(argc, argv, "a:t:s:l:w:r:o:h")) != -1) {
         switch (c) {
             case 'a':
                 opts->algorithm = optarg;
@@ -63,7 +310,16 @@ static void ParseOptions(int argc, char **argv, BenchOptions *opts)
                 opts->seconds = (uint32_t)atoi(optarg);
                 break;
             case 'l':
-                opts->len = (uint32_t)atoi(optarg);
+                ParseLens(optarg, opts);
+                break;
+            case 'w':
+                opts->warmup = (uint32_t)atoi(optarg);
+                break;
+            case 'r':
+                opts->repeats = (uint32_t)atoi(optarg);
+                break;
+            case 'o':
+                opts->format = ParseFormat(optarg);
                 break;
             case 'h':
                 PrintUsage();
@@ -107,7 +363,10 @@ static void FilterBenchs(BenchOptions *opts, BenchCtx *benchs[], uint32_t *num)
         benchs[*num] = g_benchs[i];
         benchs[*num]->times = opts->times;
         benchs[*num]->seconds = opts->seconds;
-        benchs[*num]->len = opts->len;
+        benchs[*num]->warmup = opts->warmup;
+        benchs[*num]->repeats = opts->repeats;
+        (void)memcpy(benchs[*num]->lens, opts->lens, sizeof(opts->lens));
+        benchs[*num]->lenNum = opts->lenNum;
         (*num)++;
     }
 }
@@ -132,6 +391,25 @@ static int32_t InstantOperation(const Operation *op, void *ctx, BenchCtx *bench)
     if (op->id & VERIFY_ID) {
         return ((Verify)op->oper)(ctx, bench);
     }
+    if (op->id & CONTEND_ID) {
+        return ((Contend)op->oper)(ctx, bench);
+    }
+    if (op->id & HASH_ID) {
+        return ((Hash)op->oper)(ctx, bench);
+    }
+    if (op->id & MAC_ID) {
+        return ((Mac)op->oper)(ctx, bench);
+    }
+    if (op->id & CIPHER_ID) {
+        return ((Cipher)op->oper)(ctx, bench);
+    }
+    if (op->id & KDF_ID) {
+        return ((Kdf)op->oper)(ctx, bench);
+    }
+    if (op->id & CONN_ID) {
+        return ((Conn)op->oper)(ctx, bench);
+    }
+    return CRYPT_NOT_SUPPORT;
 }
 
 int main(int argc, char **argv)
@@ -141,10 +419,25 @@ int main(int argc, char **argv)
     memset(&opts, 0, sizeof(BenchOptions));
 
     // default options
-    opts.times = 10000;
-    opts.seconds = 3;
-    opts.len = 1024;
+    opts.times = BENCH_DEFAULT_TIMES;
+    opts.seconds = 0;
+    opts.warmup = BENCH_DEFAULT_WARMUP;
+    opts.repeats = BENCH_DEFAULT_REPEATS;
+    opts.lenNum = sizeof(g_defaultLens) / sizeof(g_defaultLens[0]);
+    (void)memcpy(opts.lens, g_defaultLens, sizeof(g_defaultLens));
+    opts.format = BENCH_FMT_TEXT;
     ParseOptions(argc, argv, &opts);
+    if (opts.repeats == 0 || opts.repeats > BENCH_MAX_REPEATS || opts.lenNum == 0) {
+        PrintUsage();
+        return -1;
+    }
+    g_format = opts.format;
+    g_run.samples = malloc(BENCH_MAX_SAMPLES * sizeof(uint64_t));
+    if (g_run.samples == NULL) {
+        printf("Failed to allocate the latency samples\n");
+        return -1;
+    }
+    BenchCalibrate();
     
     if (CRYPT_EAL_RandInit(CRYPT_RAND_SHA256, NULL, NULL, NULL, 0) != CRYPT_SUCCESS) {
         printf("Failed to initialize random number generator\n");
@@ -156,7 +449,7 @@ int main(int argc, char **argv)
     FilterBenchs(&opts, benchs, &num);
 
     if (num > 0) {
-        printf("%-25s, %15s, %20s, %20s\n", "algorithm operation", "time elapsed(s)", "run times", "ops");
+        PrintHeader();
     }
 
     for (int i = 0; i < num; i++) {
@@ -176,5 +469,9 @@ int main(int argc, char **argv)
         BENCH_TEARDOWN(ctx, ctxOps);
     }
 
+    if (num > 0) {
+        PrintFooter();
+    }
+    free(g_run.samples);
     return 0;
 }
\ No newline at end of file
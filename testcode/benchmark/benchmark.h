@@ -17,48 +17,85 @@
 #define BENCHMARK_H
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #include <stdio.h>
 #include <time.h>
 #include <sys/time.h>
 
-#define BENCH_TIMES(func, rc, ok, times, header)                                                         \
-    {                                                                                                    \
-        struct timespec start, end;                                                                      \
-        clock_gettime(CLOCK_REALTIME, &start);                                                           \
-        for (int i = 0; i < times; i++) {                                                                \
-            rc = func;                                                                                   \
-            if (rc != ok) {                                                                              \
-                printf("Error: %s, ret = %08x\n", #func, rc);                                            \
-                break;                                                                                   \
-            }                                                                                            \
-        }                                                                                                \
-        clock_gettime(CLOCK_REALTIME, &end);                                                             \
-        uint64_t elapsedTime = (end.tv_sec - start.tv_sec) * 1000000000 + (end.tv_nsec - start.tv_nsec); \
-        printf("%-25s, %15ld, %20d, %20.2f\n", header, elapsedTime / 1000000000, times,                  \
-               ((double)times * 1000000000) / elapsedTime);                                              \
-    }
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
-#define BENCH_SECONDS(func, rc, ok, secs, header)                                                    \
-    {                                                                                                \
-        struct timespec start, end;                                                                  \
-        uint64_t totalTime = secs * 1000000000;                                                      \
-        uint64_t elapsedTime = 0;                                                                    \
-        uint64_t cnt = 0;                                                                            \
-        while (elapsedTime < totalTime) {                                                            \
-            clock_gettime(CLOCK_REALTIME, &start);                                                   \
-            rc = func;                                                                               \
-            if (rc != ok) {                                                                          \
-                printf("Error: %s, ret = %08x\n", #func, rc);                                        \
-                break;                                                                               \
-            }                                                                                        \
-            clock_gettime(CLOCK_REALTIME, &end);                                                     \
-            elapsedTime += (end.tv_sec - start.tv_sec) * 1000000000 + (end.tv_nsec - start.tv_nsec); \
-            cnt++;                                                                                   \
-        }                                                                                            \
-        printf("%-25s, %15ld, %20d, %20.2f\n", header, elapsedTime / 1000000000, cnt,                \
-               ((double)times * 1000000000) / elapsedTime);                                          \
-    }
+#define BENCH_DEFAULT_TIMES 10000
+#define BENCH_DEFAULT_WARMUP 100
+#define BENCH_DEFAULT_REPEATS 5
+// At most this many calls are timed one by one for the percentiles of one run.
+#define BENCH_MAX_SAMPLES (1U << 20)
+#define BENCH_MAX_LENS 16
+
+typedef enum {
+    BENCH_FMT_TEXT,
+    BENCH_FMT_CSV,
+    BENCH_FMT_JSON,
+} BenchFormat;
+
+static inline uint64_t BenchNowNs(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
+
+// Time stamp counter, 0 if the platform has none, in which case cycles/byte is not reported.
+static inline uint64_t BenchCycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+typedef struct BenchCtx_ BenchCtx;
+
+void BenchRunStart(const BenchCtx *bench);
+uint64_t BenchRunNext(void);
+uint32_t BenchSampleNum(void);
+void BenchSample(uint64_t ns);
+void BenchReport(const char *header, uint32_t len);
+
+/*
+ * Run func after bench->warmup untimed calls, in bench->repeats repetitions that together take bench->times calls,
+ * or bench->seconds seconds when it is positive. The calls of a repetition run back to back, the clock and the
+ * cycle counter are only read between batches of calls, so the mean ops/s, its relative standard deviation across
+ * the repetitions and, when len is not 0, the throughput and cycles/byte carry no per call overhead. The p50/p99
+ * latency comes from an extra pass of as many calls as one repetition, each timed on CLOCK_MONOTONIC less the
+ * calibrated cost of reading the clock.
+ */
+#define BENCH_RUN(bench, func, rc, ok, len, header)                                 \
+    do {                                                                            \
+        rc = ok;                                                                    \
+        for (int32_t warm_ = 0; warm_ < (bench)->warmup && rc == ok; warm_++) {     \
+            rc = func;                                                              \
+        }                                                                           \
+        BenchRunStart(bench);                                                       \
+        for (uint64_t calls_ = BenchRunNext(); rc == ok && calls_ != 0; calls_ = BenchRunNext()) { \
+            for (uint64_t i_ = 0; i_ < calls_ && rc == ok; i_++) {                  \
+                rc = func;                                                          \
+            }                                                                       \
+        }                                                                           \
+        for (uint32_t samples_ = BenchSampleNum(); rc == ok && samples_ > 0; samples_--) { \
+            uint64_t start_ = BenchNowNs();                                         \
+            rc = func;                                                              \
+            BenchSample(BenchNowNs() - start_);                                     \
+        }                                                                           \
+        if (rc != ok) {                                                             \
+            printf("Error: %s, ret = %08x\n", #func, rc);                           \
+        } else {                                                                    \
+            BenchReport(header, len);                                               \
+        }                                                                           \
+    } while (0)
 
 #define BENCH_SETUP(ctx, ops)                     \
     do                                            \
@@ -85,7 +122,6 @@ static inline void Hex2Bin(const char *hex, uint8_t *bin, uint32_t *len)
     }
 }
 
-typedef struct BenchCtx_ BenchCtx;
 // every benchmark testcase should define "NewCtx" and "FreeCtx"
 typedef int32_t (*NewCtx)(void **ctx);
 typedef void (*FreeCtx)(void *ctx);
@@ -95,6 +131,15 @@ typedef int32_t (*Enc)(void *ctx, BenchCtx *bench);
 typedef int32_t (*Dec)(void *ctx, BenchCtx *bench);
 typedef int32_t (*Sign)(void *ctx, BenchCtx *bench);
 typedef int32_t (*Verify)(void *ctx, BenchCtx *bench);
+// Run the operation from many threads at once to measure lock contention.
+typedef int32_t (*Contend)(void *ctx, BenchCtx *bench);
+// The streaming operations below are run once for every message length in bench->lens.
+typedef int32_t (*Hash)(void *ctx, BenchCtx *bench);
+typedef int32_t (*Mac)(void *ctx, BenchCtx *bench);
+typedef int32_t (*Cipher)(void *ctx, BenchCtx *bench);
+typedef int32_t (*Kdf)(void *ctx, BenchCtx *bench);
+// Create and free a tls connection.
+typedef int32_t (*Conn)(void *ctx, BenchCtx *bench);
 
 typedef struct {
     uint32_t id;
@@ -129,6 +174,12 @@ typedef struct {
 #define DEC_ID 8U
 #define SIGN_ID 16U
 #define VERIFY_ID 32U
+#define CONTEND_ID 64U
+#define HASH_ID 128U
+#define MAC_ID 256U
+#define CIPHER_ID 512U
+#define KDF_ID 1024U
+#define CONN_ID 2048U
 
 typedef struct BenchCtx_ {
     const char *name;
@@ -137,17 +188,32 @@ typedef struct BenchCtx_ {
     int32_t filteredOpsNum;
     int32_t times;
     int32_t seconds;
-    int32_t len;
+    int32_t warmup;
+    int32_t repeats;
+    uint32_t lens[BENCH_MAX_LENS]; // message lengths of the streaming operations
+    uint32_t lenNum;
 } BenchCtx;
 
+// The largest message length of the streaming operations, to size their buffers.
+static inline uint32_t BenchMaxLen(const BenchCtx *bench)
+{
+    uint32_t maxLen = 0;
+    for (uint32_t i = 0; i < bench->lenNum; i++) {
+        maxLen = bench->lens[i] > maxLen ? bench->lens[i] : maxLen;
+    }
+    return maxLen;
+}
+
 #define DEFINE_BENCH_CTX(alg) \
     BenchCtx alg##BenchCtx = { \
         .name = #alg, \
         .desc = #alg " benchmark", \
         .ctxOps = &alg##CtxOps, \
         .filteredOpsNum = sizeof(alg##CtxOps.ops) / sizeof(alg##CtxOps.ops[0]), \
-        .times = 10000, \
+        .times = BENCH_DEFAULT_TIMES, \
         .seconds = -1, \
+        .warmup = BENCH_DEFAULT_WARMUP, \
+        .repeats = BENCH_DEFAULT_REPEATS, \
     }
 
 #endif /* BENCHMARK_H */
\ No newline at end of file
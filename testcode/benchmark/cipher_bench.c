@@ -0,0 +1,163 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "crypt_algid.h"
+#include "crypt_errno.h"
+#include "crypt_types.h"
+#include "crypt_eal_cipher.h"
+#include "benchmark.h"
+
+#define CIPHER_BENCH_KEY_LEN 16
+#define CIPHER_BENCH_IV_LEN 16
+#define CIPHER_BENCH_GCM_IV_LEN 12
+#define CIPHER_BENCH_AAD_LEN 13 // as the additional data of a tls 1.2 record
+#define CIPHER_BENCH_TAG_LEN 16
+#define CIPHER_BENCH_BLOCK_LEN 16
+
+typedef struct {
+    CRYPT_CIPHER_AlgId id;
+    uint32_t ivLen;
+    bool isAead;
+    bool needFinal; // the block modes pad the message and output the last block in final
+    const char *header;
+} CipherBenchAlg;
+
+typedef struct {
+    const CipherBenchAlg *alg;
+    CRYPT_EAL_CipherCtx *cipher;
+    uint8_t iv[CIPHER_BENCH_IV_LEN];
+    uint8_t *in;
+    uint8_t *out;
+} CipherBenchRun;
+
+static int32_t CipherNewCtx(void **ctx)
+{
+    *ctx = NULL;
+    return CRYPT_SUCCESS;
+}
+
+static void CipherFreeCtx(void *ctx)
+{
+    (void)ctx;
+}
+
+// Every call encrypts one message under a fresh iv, the key schedule is done once.
+static int32_t CipherOnce(CipherBenchRun *run, uint32_t len)
+{
+    uint8_t aad[CIPHER_BENCH_AAD_LEN] = {0};
+    uint8_t tag[CIPHER_BENCH_TAG_LEN];
+    uint32_t outLen = len + CIPHER_BENCH_BLOCK_LEN;
+    int32_t ret = CRYPT_EAL_CipherReinit(run->cipher, run->iv, run->alg->ivLen);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    if (run->alg->isAead) {
+        ret = CRYPT_EAL_CipherCtrl(run->cipher, CRYPT_CTRL_SET_AAD, aad, sizeof(aad));
+    } else if (run->alg->needFinal) {
+        // Reinit resets the padding along with the iv.
+        ret = CRYPT_EAL_CipherSetPadding(run->cipher, CRYPT_PADDING_PKCS7);
+    }
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    ret = CRYPT_EAL_CipherUpdate(run->cipher, run->in, len, run->out, &outLen);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    if (run->alg->isAead) {
+        return CRYPT_EAL_CipherCtrl(run->cipher, CRYPT_CTRL_GET_TAG, tag, sizeof(tag));
+    }
+    if (run->alg->needFinal) {
+        uint32_t finalLen = len + CIPHER_BENCH_BLOCK_LEN - outLen;
+        return CRYPT_EAL_CipherFinal(run->cipher, run->out + outLen, &finalLen);
+    }
+    return CRYPT_SUCCESS;
+}
+
+static int32_t CipherRunInit(CipherBenchRun *run, uint32_t maxLen)
+{
+    uint8_t key[CIPHER_BENCH_KEY_LEN] = {0};
+    run->cipher = CRYPT_EAL_CipherNewCtx(run->alg->id);
+    run->in = calloc(1, maxLen + 1);
+    run->out = calloc(1, maxLen + CIPHER_BENCH_BLOCK_LEN);
+    if (run->cipher == NULL || run->in == NULL || run->out == NULL) {
+        printf("Failed to create cipher context\n");
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    int32_t ret = CRYPT_EAL_CipherInit(run->cipher, key, sizeof(key), run->iv, run->alg->ivLen, true);
+    if (ret != CRYPT_SUCCESS) {
+        printf("Failed to init cipher context\n");
+    }
+    return ret;
+}
+
+static int32_t CipherRun(BenchCtx *bench, const CipherBenchAlg *alg)
+{
+    CipherBenchRun run = {0};
+    run.alg = alg;
+    int32_t rc = CipherRunInit(&run, BenchMaxLen(bench));
+    for (uint32_t i = 0; i < bench->lenNum && rc == CRYPT_SUCCESS; i++) {
+        uint32_t len = bench->lens[i];
+        BENCH_RUN(bench, CipherOnce(&run, len), rc, CRYPT_SUCCESS, len, alg->header);
+    }
+    free(run.in);
+    free(run.out);
+    CRYPT_EAL_CipherFreeCtx(run.cipher);
+    return rc;
+}
+
+static int32_t CipherAes128Gcm(void *ctx, BenchCtx *bench)
+{
+    (void)ctx;
+    static const CipherBenchAlg alg = {CRYPT_CIPHER_AES128_GCM, CIPHER_BENCH_GCM_IV_LEN, true, false,
+        "aes128-gcm enc"};
+    return CipherRun(bench, &alg);
+}
+
+static int32_t CipherSm4Cbc(void *ctx, BenchCtx *bench)
+{
+    (void)ctx;
+    static const CipherBenchAlg alg = {CRYPT_CIPHER_SM4_CBC, CIPHER_BENCH_IV_LEN, false, true, "sm4-cbc enc"};
+    return CipherRun(bench, &alg);
+}
+
+static int32_t CipherSm4Ctr(void *ctx, BenchCtx *bench)
+{
+    (void)ctx;
+    static const CipherBenchAlg alg = {CRYPT_CIPHER_SM4_CTR, CIPHER_BENCH_IV_LEN, false, false, "sm4-ctr enc"};
+    return CipherRun(bench, &alg);
+}
+
+static int32_t CipherSm4Gcm(void *ctx, BenchCtx *bench)
+{
+    (void)ctx;
+    static const CipherBenchAlg alg = {CRYPT_CIPHER_SM4_GCM, CIPHER_BENCH_GCM_IV_LEN, true, false, "sm4-gcm enc"};
+    return CipherRun(bench, &alg);
+}
+
+static const CtxOps CipherCtxOps = {
+    .newCtx = CipherNewCtx,
+    .freeCtx = CipherFreeCtx,
+    .ops = {
+        DEFINE_OPER(CIPHER_ID, CipherAes128Gcm),
+        DEFINE_OPER(CIPHER_ID, CipherSm4Cbc),
+        DEFINE_OPER(CIPHER_ID, CipherSm4Ctr),
+        DEFINE_OPER(CIPHER_ID, CipherSm4Gcm),
+    },
+};
+
+DEFINE_BENCH_CTX(Cipher);
@@ -0,0 +1,103 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "bsl_sal.h"
+#include "crypt_algid.h"
+#include "crypt_errno.h"
+#include "crypt_eal_rand.h"
+#include "hitls.h"
+#include "hitls_config.h"
+#include "hitls_error.h"
+#include "benchmark.h"
+
+static uint64_t g_connMallocBytes = 0;
+static uint32_t g_connMallocNum = 0;
+
+// Count the heap taken by HITLS_New. The memory is still released by the default free.
+static void *ConnCountMalloc(uint32_t size)
+{
+    g_connMallocBytes += size;
+    g_connMallocNum++;
+    return malloc(size);
+}
+
+static int32_t ConnMeasureHeap(HITLS_Config *config)
+{
+    g_connMallocBytes = 0;
+    g_connMallocNum = 0;
+    (void)BSL_SAL_CallBack_Ctrl(BSL_SAL_MEM_MALLOC, ConnCountMalloc);
+    HITLS_Ctx *ctx = HITLS_New(config);
+    (void)BSL_SAL_CallBack_Ctrl(BSL_SAL_MEM_MALLOC, NULL);
+    if (ctx == NULL) {
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    HITLS_Free(ctx);
+    printf("HITLS_New allocates %llu bytes in %u blocks per connection\n", (unsigned long long)g_connMallocBytes,
+        g_connMallocNum);
+    return CRYPT_SUCCESS;
+}
+
+static int32_t ConnNewCtx(void **ctx)
+{
+    // The tls config takes its random from the lib ctx when the provider is built, otherwise the global one is used.
+    (void)CRYPT_EAL_ProviderRandInitCtx(NULL, CRYPT_RAND_SHA256, "provider=default", NULL, 0, NULL);
+    HITLS_Config *config = HITLS_CFG_NewTLSConfig();
+    if (config == NULL) {
+        printf("Failed to create tls config\n");
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    int32_t ret = ConnMeasureHeap(config);
+    if (ret != CRYPT_SUCCESS) {
+        printf("Failed to create tls connection\n");
+        HITLS_CFG_FreeConfig(config);
+        return ret;
+    }
+    *ctx = config;
+    return CRYPT_SUCCESS;
+}
+
+static void ConnFreeCtx(void *ctx)
+{
+    HITLS_CFG_FreeConfig(ctx);
+}
+
+static int32_t ConnNewFreeOnce(HITLS_Config *config)
+{
+    HITLS_Ctx *ctx = HITLS_New(config);
+    if (ctx == NULL) {
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    HITLS_Free(ctx);
+    return CRYPT_SUCCESS;
+}
+
+static int32_t ConnNewFree(void *ctx, BenchCtx *bench)
+{
+    int rc = CRYPT_SUCCESS;
+    BENCH_RUN(bench, ConnNewFreeOnce(ctx), rc, CRYPT_SUCCESS, 0, "HITLS_New + HITLS_Free");
+    return rc;
+}
+
+static const CtxOps ConnCtxOps = {
+    .newCtx = ConnNewCtx,
+    .freeCtx = ConnFreeCtx,
+    .ops = {
+        DEFINE_OPER(CONN_ID, ConnNewFree),
+    },
+};
+
+DEFINE_BENCH_CTX(Conn);
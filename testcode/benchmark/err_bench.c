@@ -0,0 +1,112 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "bsl_err.h"
+#include "bsl_errno.h"
+#include "crypt_errno.h"
+#include "crypt_eal_md.h"
+#include "benchmark.h"
+
+#define ERR_BENCH_THREAD_NUM 64
+#define ERR_BENCH_PUSH_NUM 1000
+
+// Every failing call pushes an error, the caller then reads it and clears the stack, as a worker thread would do.
+static int32_t ErrPushOnce(void)
+{
+    if (CRYPT_EAL_MdUpdate(NULL, NULL, 0) != CRYPT_NULL_INPUT) {
+        return CRYPT_INVALID_ARG;
+    }
+    if (BSL_ERR_GetLastError() != CRYPT_NULL_INPUT) {
+        return CRYPT_INVALID_ARG;
+    }
+    BSL_ERR_ClearError();
+    return CRYPT_SUCCESS;
+}
+
+static void *ErrPushThread(void *arg)
+{
+    int32_t *rc = arg;
+    for (int32_t i = 0; i < ERR_BENCH_PUSH_NUM; i++) {
+        *rc = ErrPushOnce();
+        if (*rc != CRYPT_SUCCESS) {
+            break;
+        }
+    }
+    BSL_ERR_RemoveErrorStack(false);
+    return NULL;
+}
+
+static int32_t ErrPushThreads(void)
+{
+    pthread_t threads[ERR_BENCH_THREAD_NUM];
+    int32_t threadRc[ERR_BENCH_THREAD_NUM];
+    uint32_t created = 0;
+    int32_t rc = CRYPT_SUCCESS;
+    for (; created < ERR_BENCH_THREAD_NUM; created++) {
+        threadRc[created] = CRYPT_SUCCESS;
+        if (pthread_create(&threads[created], NULL, ErrPushThread, &threadRc[created]) != 0) {
+            printf("Failed to create thread %u\n", created);
+            rc = CRYPT_INVALID_ARG;
+            break;
+        }
+    }
+    for (uint32_t i = 0; i < created; i++) {
+        (void)pthread_join(threads[i], NULL);
+        if (threadRc[i] != CRYPT_SUCCESS) {
+            rc = threadRc[i];
+        }
+    }
+    return rc;
+}
+
+static int32_t ErrNewCtx(void **ctx)
+{
+    *ctx = NULL;
+    return BSL_ERR_Init();
+}
+
+static void ErrFreeCtx(void *ctx)
+{
+    (void)ctx;
+    BSL_ERR_RemoveErrorStack(true);
+}
+
+static int32_t ErrPush(void *ctx, BenchCtx *bench)
+{
+    (void)ctx;
+    int32_t rc;
+    // Every call pushes a batch of errors on each thread, so the number of calls is scaled down accordingly.
+    BenchCtx batch = *bench;
+    batch.times = bench->times / ERR_BENCH_PUSH_NUM;
+    if (batch.times < batch.repeats) {
+        batch.times = batch.repeats;
+    }
+    batch.warmup = 1;
+    BENCH_RUN(&batch, ErrPushThreads(), rc, CRYPT_SUCCESS, 0, "err push 64 threads x1000");
+    return rc;
+}
+
+static const CtxOps ErrCtxOps = {
+    .newCtx = ErrNewCtx,
+    .freeCtx = ErrFreeCtx,
+    .ops = {
+        DEFINE_OPER(CONTEND_ID, ErrPush),
+    },
+};
+
+DEFINE_BENCH_CTX(Err);
@@ -0,0 +1,187 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "bsl_params.h"
+#include "crypt_algid.h"
+#include "crypt_errno.h"
+#include "crypt_types.h"
+#include "crypt_params_key.h"
+#include "crypt_eal_kdf.h"
+#include "benchmark.h"
+
+#define KDF_BENCH_SALT_LEN 32
+#define KDF_BENCH_INFO_LEN 32
+#define KDF_BENCH_OUT_LEN 32
+#define KDF_BENCH_PASS_LEN 16
+#define KDF_BENCH_PBKDF2_ITER 1024
+#define KDF_BENCH_LONG_OUT_LEN 256
+#define KDF_BENCH_SCRYPT_N 1024
+#define KDF_BENCH_SCRYPT_R 8
+#define KDF_BENCH_SCRYPT_P 4
+
+static int32_t KdfNewCtx(void **ctx)
+{
+    *ctx = NULL;
+    return CRYPT_SUCCESS;
+}
+
+static void KdfFreeCtx(void *ctx)
+{
+    (void)ctx;
+}
+
+// Every call sets the parameters again, as every handshake derives its secrets from new input keying material.
+static int32_t HkdfOnce(CRYPT_EAL_KdfCTX *ctx, uint8_t *key, uint32_t keyLen)
+{
+    uint32_t macId = CRYPT_MAC_HMAC_SHA256;
+    uint32_t mode = CRYPT_KDF_HKDF_MODE_FULL;
+    uint8_t salt[KDF_BENCH_SALT_LEN] = {0};
+    uint8_t info[KDF_BENCH_INFO_LEN] = {0};
+    uint8_t out[KDF_BENCH_OUT_LEN];
+    BSL_Param params[6] = {
+        {CRYPT_PARAM_KDF_MAC_ID, BSL_PARAM_TYPE_UINT32, &macId, sizeof(macId), 0},
+        {CRYPT_PARAM_KDF_MODE, BSL_PARAM_TYPE_UINT32, &mode, sizeof(mode), 0},
+        {CRYPT_PARAM_KDF_KEY, BSL_PARAM_TYPE_OCTETS, key, keyLen, 0},
+        {CRYPT_PARAM_KDF_SALT, BSL_PARAM_TYPE_OCTETS, salt, sizeof(salt), 0},
+        {CRYPT_PARAM_KDF_INFO, BSL_PARAM_TYPE_OCTETS, info, sizeof(info), 0},
+        BSL_PARAM_END
+    };
+    int32_t ret = CRYPT_EAL_KdfSetParam(ctx, params);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    return CRYPT_EAL_KdfDerive(ctx, out, sizeof(out));
+}
+
+static int32_t Pbkdf2Once(CRYPT_EAL_KdfCTX *ctx, uint32_t outLen)
+{
+    uint32_t macId = CRYPT_MAC_HMAC_SHA256;
+    uint32_t iter = KDF_BENCH_PBKDF2_ITER;
+    uint8_t pass[KDF_BENCH_PASS_LEN] = {0};
+    uint8_t salt[KDF_BENCH_SALT_LEN] = {0};
+    uint8_t out[KDF_BENCH_LONG_OUT_LEN];
+    BSL_Param params[5] = {
+        {CRYPT_PARAM_KDF_MAC_ID, BSL_PARAM_TYPE_UINT32, &macId, sizeof(macId), 0},
+        {CRYPT_PARAM_KDF_PASSWORD, BSL_PARAM_TYPE_OCTETS, pass, sizeof(pass), 0},
+        {CRYPT_PARAM_KDF_SALT, BSL_PARAM_TYPE_OCTETS, salt, sizeof(salt), 0},
+        {CRYPT_PARAM_KDF_ITER, BSL_PARAM_TYPE_UINT32, &iter, sizeof(iter), 0},
+        BSL_PARAM_END
+    };
+    int32_t ret = CRYPT_EAL_KdfSetParam(ctx, params);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    return CRYPT_EAL_KdfDerive(ctx, out, outLen);
+}
+
+static int32_t ScryptOnce(CRYPT_EAL_KdfCTX *ctx, uint32_t p, uint32_t threadNum)
+{
+    uint32_t n = KDF_BENCH_SCRYPT_N;
+    uint32_t r = KDF_BENCH_SCRYPT_R;
+    uint8_t pass[KDF_BENCH_PASS_LEN] = {0};
+    uint8_t salt[KDF_BENCH_SALT_LEN] = {0};
+    uint8_t out[KDF_BENCH_OUT_LEN];
+    BSL_Param params[7] = {
+        {CRYPT_PARAM_KDF_PASSWORD, BSL_PARAM_TYPE_OCTETS, pass, sizeof(pass), 0},
+        {CRYPT_PARAM_KDF_SALT, BSL_PARAM_TYPE_OCTETS, salt, sizeof(salt), 0},
+        {CRYPT_PARAM_KDF_N, BSL_PARAM_TYPE_UINT32, &n, sizeof(n), 0},
+        {CRYPT_PARAM_KDF_R, BSL_PARAM_TYPE_UINT32, &r, sizeof(r), 0},
+        {CRYPT_PARAM_KDF_P, BSL_PARAM_TYPE_UINT32, &p, sizeof(p), 0},
+        {CRYPT_PARAM_KDF_THREAD_NUM, BSL_PARAM_TYPE_UINT32, &threadNum, sizeof(threadNum), 0},
+        BSL_PARAM_END
+    };
+    int32_t ret = CRYPT_EAL_KdfSetParam(ctx, params);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    return CRYPT_EAL_KdfDerive(ctx, out, sizeof(out));
+}
+
+// The lengths are those of the input keying material.
+static int32_t KdfHkdfSha256(void *ctx, BenchCtx *bench)
+{
+    (void)ctx;
+    int32_t rc = CRYPT_SUCCESS;
+    CRYPT_EAL_KdfCTX *kdf = CRYPT_EAL_KdfNewCtx(CRYPT_KDF_HKDF);
+    uint8_t *key = calloc(1, BenchMaxLen(bench) + 1);
+    if (kdf == NULL || key == NULL) {
+        printf("Failed to create kdf context\n");
+        rc = CRYPT_MEM_ALLOC_FAIL;
+        goto EXIT;
+    }
+    for (uint32_t i = 0; i < bench->lenNum && rc == CRYPT_SUCCESS; i++) {
+        uint32_t len = bench->lens[i];
+        BENCH_RUN(bench, HkdfOnce(kdf, key, len), rc, CRYPT_SUCCESS, len, "hkdf-sha256 derive");
+    }
+EXIT:
+    free(key);
+    CRYPT_EAL_KdfFreeCtx(kdf);
+    return rc;
+}
+
+// The cost is set by the iteration count rather than the message length, so it is run once.
+static int32_t KdfPbkdf2Sha256(void *ctx, BenchCtx *bench)
+{
+    (void)ctx;
+    int32_t rc = CRYPT_SUCCESS;
+    CRYPT_EAL_KdfCTX *kdf = CRYPT_EAL_KdfNewCtx(CRYPT_KDF_PBKDF2);
+    if (kdf == NULL) {
+        printf("Failed to create kdf context\n");
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    BENCH_RUN(bench, Pbkdf2Once(kdf, KDF_BENCH_OUT_LEN), rc, CRYPT_SUCCESS, 0, "pbkdf2-sha256 iter 1024");
+    if (rc == CRYPT_SUCCESS) {
+        BENCH_RUN(bench, Pbkdf2Once(kdf, KDF_BENCH_LONG_OUT_LEN), rc, CRYPT_SUCCESS, 0,
+            "pbkdf2-sha256 iter 1024 dk 256");
+    }
+    CRYPT_EAL_KdfFreeCtx(kdf);
+    return rc;
+}
+
+// N = 1024, r = 8, with one lane and with four lanes over four threads.
+static int32_t KdfScrypt(void *ctx, BenchCtx *bench)
+{
+    (void)ctx;
+    int32_t rc = CRYPT_SUCCESS;
+    CRYPT_EAL_KdfCTX *kdf = CRYPT_EAL_KdfNewCtx(CRYPT_KDF_SCRYPT);
+    if (kdf == NULL) {
+        printf("Failed to create kdf context\n");
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    BENCH_RUN(bench, ScryptOnce(kdf, 1, 1), rc, CRYPT_SUCCESS, 0, "scrypt N 1024 r 8 p 1");
+    if (rc == CRYPT_SUCCESS) {
+        BENCH_RUN(bench, ScryptOnce(kdf, KDF_BENCH_SCRYPT_P, 1), rc, CRYPT_SUCCESS, 0, "scrypt N 1024 r 8 p 4");
+    }
+    if (rc == CRYPT_SUCCESS) {
+        BENCH_RUN(bench, ScryptOnce(kdf, KDF_BENCH_SCRYPT_P, KDF_BENCH_SCRYPT_P), rc, CRYPT_SUCCESS, 0,
+            "scrypt N 1024 r 8 p 4, 4 threads");
+    }
+    CRYPT_EAL_KdfFreeCtx(kdf);
+    return rc;
+}
+
+static const CtxOps KdfCtxOps = {
+    .newCtx = KdfNewCtx,
+    .freeCtx = KdfFreeCtx,
+    .ops = {
+        DEFINE_OPER(KDF_ID, KdfHkdfSha256),
+        DEFINE_OPER(KDF_ID, KdfPbkdf2Sha256),
+        DEFINE_OPER(KDF_ID, KdfScrypt),
+    },
+};
+
+DEFINE_BENCH_CTX(Kdf);
@@ -0,0 +1,100 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "crypt_algid.h"
+#include "crypt_errno.h"
+#include "crypt_eal_mac.h"
+#include "benchmark.h"
+
+#define MAC_BENCH_KEY_LEN 32
+#define MAC_BENCH_MAX_OUT 64
+
+static int32_t MacNewCtx(void **ctx)
+{
+    *ctx = NULL;
+    return CRYPT_SUCCESS;
+}
+
+static void MacFreeCtx(void *ctx)
+{
+    (void)ctx;
+}
+
+// The key is set once, every call then starts over with the same key as a record layer does.
+static int32_t MacOnce(CRYPT_EAL_MacCtx *ctx, const uint8_t *msg, uint32_t len)
+{
+    uint8_t out[MAC_BENCH_MAX_OUT];
+    uint32_t outLen = sizeof(out);
+    int32_t ret = CRYPT_EAL_MacReinit(ctx);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    ret = CRYPT_EAL_MacUpdate(ctx, msg, len);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    return CRYPT_EAL_MacFinal(ctx, out, &outLen);
+}
+
+static int32_t MacRun(BenchCtx *bench, CRYPT_MAC_AlgId id, const char *header)
+{
+    int32_t rc = CRYPT_SUCCESS;
+    uint8_t key[MAC_BENCH_KEY_LEN] = {0};
+    CRYPT_EAL_MacCtx *mac = CRYPT_EAL_MacNewCtx(id);
+    uint8_t *msg = calloc(1, BenchMaxLen(bench) + 1);
+    if (mac == NULL || msg == NULL) {
+        printf("Failed to create mac context\n");
+        rc = CRYPT_MEM_ALLOC_FAIL;
+        goto EXIT;
+    }
+    rc = CRYPT_EAL_MacInit(mac, key, sizeof(key));
+    if (rc != CRYPT_SUCCESS) {
+        printf("Failed to init mac context\n");
+        goto EXIT;
+    }
+    for (uint32_t i = 0; i < bench->lenNum && rc == CRYPT_SUCCESS; i++) {
+        uint32_t len = bench->lens[i];
+        BENCH_RUN(bench, MacOnce(mac, msg, len), rc, CRYPT_SUCCESS, len, header);
+    }
+EXIT:
+    free(msg);
+    CRYPT_EAL_MacFreeCtx(mac);
+    return rc;
+}
+
+static int32_t MacHmacSha256(void *ctx, BenchCtx *bench)
+{
+    (void)ctx;
+    return MacRun(bench, CRYPT_MAC_HMAC_SHA256, "hmac-sha256 mac");
+}
+
+static int32_t MacHmacSm3(void *ctx, BenchCtx *bench)
+{
+    (void)ctx;
+    return MacRun(bench, CRYPT_MAC_HMAC_SM3, "hmac-sm3 mac");
+}
+
+static const CtxOps MacCtxOps = {
+    .newCtx = MacNewCtx,
+    .freeCtx = MacFreeCtx,
+    .ops = {
+        DEFINE_OPER(MAC_ID, MacHmacSha256),
+        DEFINE_OPER(MAC_ID, MacHmacSm3),
+    },
+};
+
+DEFINE_BENCH_CTX(Mac);
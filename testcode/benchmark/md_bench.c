@@ -0,0 +1,92 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "crypt_algid.h"
+#include "crypt_errno.h"
+#include "crypt_eal_md.h"
+#include "benchmark.h"
+
+#define MD_BENCH_MAX_OUT 64
+
+static int32_t MdNewCtx(void **ctx)
+{
+    *ctx = NULL;
+    return CRYPT_SUCCESS;
+}
+
+static void MdFreeCtx(void *ctx)
+{
+    (void)ctx;
+}
+
+static int32_t MdOnce(CRYPT_EAL_MdCTX *ctx, const uint8_t *msg, uint32_t len)
+{
+    uint8_t out[MD_BENCH_MAX_OUT];
+    uint32_t outLen = sizeof(out);
+    int32_t ret = CRYPT_EAL_MdInit(ctx);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    ret = CRYPT_EAL_MdUpdate(ctx, msg, len);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    return CRYPT_EAL_MdFinal(ctx, out, &outLen);
+}
+
+static int32_t MdRun(BenchCtx *bench, CRYPT_MD_AlgId id, const char *header)
+{
+    int32_t rc = CRYPT_SUCCESS;
+    CRYPT_EAL_MdCTX *md = CRYPT_EAL_MdNewCtx(id);
+    uint8_t *msg = calloc(1, BenchMaxLen(bench) + 1);
+    if (md == NULL || msg == NULL) {
+        printf("Failed to create md context\n");
+        rc = CRYPT_MEM_ALLOC_FAIL;
+        goto EXIT;
+    }
+    for (uint32_t i = 0; i < bench->lenNum && rc == CRYPT_SUCCESS; i++) {
+        uint32_t len = bench->lens[i];
+        BENCH_RUN(bench, MdOnce(md, msg, len), rc, CRYPT_SUCCESS, len, header);
+    }
+EXIT:
+    free(msg);
+    CRYPT_EAL_MdFreeCtx(md);
+    return rc;
+}
+
+static int32_t MdSha256(void *ctx, BenchCtx *bench)
+{
+    (void)ctx;
+    return MdRun(bench, CRYPT_MD_SHA256, "sha256 hash");
+}
+
+static int32_t MdSm3(void *ctx, BenchCtx *bench)
+{
+    (void)ctx;
+    return MdRun(bench, CRYPT_MD_SM3, "sm3 hash");
+}
+
+static const CtxOps MdCtxOps = {
+    .newCtx = MdNewCtx,
+    .freeCtx = MdFreeCtx,
+    .ops = {
+        DEFINE_OPER(HASH_ID, MdSha256),
+        DEFINE_OPER(HASH_ID, MdSm3),
+    },
+};
+
+DEFINE_BENCH_CTX(Md);
@@ -0,0 +1,135 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "crypt_algid.h"
+#include "crypt_errno.h"
+#include "crypt_eal_pkey.h"
+#include "benchmark.h"
+
+#define MLKEM_BENCH_CIPHER_LEN 1088
+#define MLKEM_BENCH_SHARED_LEN 32
+
+typedef struct {
+    CRYPT_EAL_PkeyCtx *pkey;
+    CRYPT_EAL_PkeyCtx *cachedPkey; // The same key pair with the expanded matrix kept in the context
+    uint8_t cipher[MLKEM_BENCH_CIPHER_LEN];
+} MlKemCtx;
+
+static void MlKemFreeCtx(void *ctx)
+{
+    MlKemCtx *benchCtx = ctx;
+    if (benchCtx == NULL) {
+        return;
+    }
+    CRYPT_EAL_PkeyFreeCtx(benchCtx->pkey);
+    CRYPT_EAL_PkeyFreeCtx(benchCtx->cachedPkey);
+    free(benchCtx);
+}
+
+static int32_t MlKemNewCtxInner(MlKemCtx *benchCtx)
+{
+    benchCtx->pkey = CRYPT_EAL_PkeyNewCtx(CRYPT_PKEY_ML_KEM);
+    if (benchCtx->pkey == NULL) {
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    uint32_t val = CRYPT_KEM_TYPE_MLKEM_768;
+    int32_t ret = CRYPT_EAL_PkeyCtrl(benchCtx->pkey, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val));
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    ret = CRYPT_EAL_PkeyGen(benchCtx->pkey);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    benchCtx->cachedPkey = CRYPT_EAL_PkeyDupCtx(benchCtx->pkey);
+    if (benchCtx->cachedPkey == NULL) {
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    int32_t flag = 1;
+    ret = CRYPT_EAL_PkeyCtrl(benchCtx->cachedPkey, CRYPT_CTRL_SET_MLKEM_CACHE_MATRIX_FLAG, &flag, sizeof(flag));
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    uint32_t cipherLen = sizeof(benchCtx->cipher);
+    uint8_t share[MLKEM_BENCH_SHARED_LEN];
+    uint32_t shareLen = sizeof(share);
+    return CRYPT_EAL_PkeyEncaps(benchCtx->pkey, benchCtx->cipher, &cipherLen, share, &shareLen);
+}
+
+static int32_t MlKemNewCtx(void **ctx)
+{
+    MlKemCtx *benchCtx = calloc(1, sizeof(MlKemCtx));
+    if (benchCtx == NULL) {
+        printf("Failed to create ml-kem context\n");
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    int32_t ret = MlKemNewCtxInner(benchCtx);
+    if (ret != CRYPT_SUCCESS) {
+        printf("Failed to generate the ml-kem key, ret = %08x\n", ret);
+        MlKemFreeCtx(benchCtx);
+        return ret;
+    }
+    *ctx = benchCtx;
+    return CRYPT_SUCCESS;
+}
+
+static int32_t MlKemEncapsOnce(CRYPT_EAL_PkeyCtx *pkey)
+{
+    uint8_t cipher[MLKEM_BENCH_CIPHER_LEN];
+    uint32_t cipherLen = sizeof(cipher);
+    uint8_t share[MLKEM_BENCH_SHARED_LEN];
+    uint32_t shareLen = sizeof(share);
+    return CRYPT_EAL_PkeyEncaps(pkey, cipher, &cipherLen, share, &shareLen);
+}
+
+static int32_t MlKemDecapsOnce(CRYPT_EAL_PkeyCtx *pkey, uint8_t *cipher)
+{
+    uint8_t share[MLKEM_BENCH_SHARED_LEN];
+    uint32_t shareLen = sizeof(share);
+    return CRYPT_EAL_PkeyDecaps(pkey, cipher, MLKEM_BENCH_CIPHER_LEN, share, &shareLen);
+}
+
+static int32_t MlKemEncaps(void *ctx, BenchCtx *bench)
+{
+    int rc = CRYPT_SUCCESS;
+    MlKemCtx *benchCtx = ctx;
+    BENCH_RUN(bench, MlKemEncapsOnce(benchCtx->pkey), rc, CRYPT_SUCCESS, 0, "ml-kem-768 encaps");
+    BENCH_RUN(bench, MlKemEncapsOnce(benchCtx->cachedPkey), rc, CRYPT_SUCCESS, 0, "ml-kem-768 encaps cached");
+    return rc;
+}
+
+static int32_t MlKemDecaps(void *ctx, BenchCtx *bench)
+{
+    int rc = CRYPT_SUCCESS;
+    MlKemCtx *benchCtx = ctx;
+    BENCH_RUN(bench, MlKemDecapsOnce(benchCtx->pkey, benchCtx->cipher), rc, CRYPT_SUCCESS, 0,
+              "ml-kem-768 decaps");
+    BENCH_RUN(bench, MlKemDecapsOnce(benchCtx->cachedPkey, benchCtx->cipher), rc, CRYPT_SUCCESS, 0,
+              "ml-kem-768 decaps cached");
+    return rc;
+}
+
+static const CtxOps MlKemCtxOps = {
+    .newCtx = MlKemNewCtx,
+    .freeCtx = MlKemFreeCtx,
+    .ops = {
+        DEFINE_OPER(ENC_ID, MlKemEncaps),
+        DEFINE_OPER(DEC_ID, MlKemDecaps),
+    },
+};
+
+DEFINE_BENCH_CTX(MlKem);
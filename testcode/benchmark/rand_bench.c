@@ -0,0 +1,152 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "crypt_algid.h"
+#include "crypt_errno.h"
+#include "crypt_types.h"
+#include "crypt_eal_rand.h"
+#include "benchmark.h"
+
+#define RAND_BENCH_MAX_THREAD_NUM 64
+#define RAND_BENCH_GEN_NUM 1000
+#define RAND_BENCH_LEN 32 // a tls random or an ecdhe private key
+
+typedef struct {
+    CRYPT_EAL_RndCtx *shared;    // every thread generates under the lock of the DRBG
+    CRYPT_EAL_RndCtx *perThread; // every thread generates with its own DRBG seeded from this one
+} RandCtx;
+
+typedef struct {
+    CRYPT_EAL_RndCtx *drbg;
+    int32_t rc;
+} RandThreadArg;
+
+static void RandFreeCtx(void *ctx)
+{
+    RandCtx *benchCtx = ctx;
+    if (benchCtx == NULL) {
+        return;
+    }
+    CRYPT_EAL_DrbgDeinit(benchCtx->shared);
+    CRYPT_EAL_DrbgDeinit(benchCtx->perThread);
+    free(benchCtx);
+}
+
+static CRYPT_EAL_RndCtx *RandNewDrbg(int32_t perThread)
+{
+    CRYPT_EAL_RndCtx *drbg = CRYPT_EAL_DrbgNew(CRYPT_RAND_SHA256, NULL, NULL);
+    if (drbg == NULL) {
+        return NULL;
+    }
+    if (CRYPT_EAL_DrbgCtrl(drbg, CRYPT_CTRL_SET_RAND_PER_THREAD, &perThread, sizeof(perThread)) != CRYPT_SUCCESS ||
+        CRYPT_EAL_DrbgInstantiate(drbg, NULL, 0) != CRYPT_SUCCESS) {
+        CRYPT_EAL_DrbgDeinit(drbg);
+        return NULL;
+    }
+    return drbg;
+}
+
+static int32_t RandNewCtx(void **ctx)
+{
+    RandCtx *benchCtx = calloc(1, sizeof(RandCtx));
+    if (benchCtx == NULL) {
+        printf("Failed to create rand context\n");
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    benchCtx->shared = RandNewDrbg(0);
+    benchCtx->perThread = RandNewDrbg(1);
+    if (benchCtx->shared == NULL || benchCtx->perThread == NULL) {
+        printf("Failed to instantiate the drbg\n");
+        RandFreeCtx(benchCtx);
+        return CRYPT_EAL_ERR_DRBG_INIT_FAIL;
+    }
+    *ctx = benchCtx;
+    return CRYPT_SUCCESS;
+}
+
+static void *RandGenThread(void *arg)
+{
+    RandThreadArg *threadArg = arg;
+    uint8_t out[RAND_BENCH_LEN];
+    for (int32_t i = 0; i < RAND_BENCH_GEN_NUM; i++) {
+        threadArg->rc = CRYPT_EAL_Drbgbytes(threadArg->drbg, out, sizeof(out));
+        if (threadArg->rc != CRYPT_SUCCESS) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+static int32_t RandGenThreads(CRYPT_EAL_RndCtx *drbg, uint32_t threadNum)
+{
+    pthread_t threads[RAND_BENCH_MAX_THREAD_NUM];
+    RandThreadArg args[RAND_BENCH_MAX_THREAD_NUM];
+    uint32_t created = 0;
+    int32_t rc = CRYPT_SUCCESS;
+    for (; created < threadNum; created++) {
+        args[created].drbg = drbg;
+        args[created].rc = CRYPT_SUCCESS;
+        if (pthread_create(&threads[created], NULL, RandGenThread, &args[created]) != 0) {
+            printf("Failed to create thread %u\n", created);
+            rc = CRYPT_INVALID_ARG;
+            break;
+        }
+    }
+    for (uint32_t i = 0; i < created; i++) {
+        (void)pthread_join(threads[i], NULL);
+        if (args[i].rc != CRYPT_SUCCESS) {
+            rc = args[i].rc;
+        }
+    }
+    return rc;
+}
+
+// Every call generates RAND_BENCH_GEN_NUM randoms on each thread, the throughput is that of all threads together.
+static int32_t RandGen(void *ctx, BenchCtx *bench)
+{
+    RandCtx *benchCtx = ctx;
+    int32_t rc = CRYPT_SUCCESS;
+    BenchCtx batch = *bench;
+    batch.times = bench->times / RAND_BENCH_GEN_NUM;
+    if (batch.times < batch.repeats) {
+        batch.times = batch.repeats;
+    }
+    batch.warmup = 1;
+    for (uint32_t threadNum = 1; threadNum <= RAND_BENCH_MAX_THREAD_NUM && rc == CRYPT_SUCCESS; threadNum *= 2) {
+        uint32_t len = threadNum * RAND_BENCH_GEN_NUM * RAND_BENCH_LEN;
+        char header[64];
+        (void)snprintf(header, sizeof(header), "drbg shared %u threads", threadNum);
+        BENCH_RUN(&batch, RandGenThreads(benchCtx->shared, threadNum), rc, CRYPT_SUCCESS, len, header);
+        if (rc != CRYPT_SUCCESS) {
+            break;
+        }
+        (void)snprintf(header, sizeof(header), "drbg per-thread %u threads", threadNum);
+        BENCH_RUN(&batch, RandGenThreads(benchCtx->perThread, threadNum), rc, CRYPT_SUCCESS, len, header);
+    }
+    return rc;
+}
+
+static const CtxOps RandCtxOps = {
+    .newCtx = RandNewCtx,
+    .freeCtx = RandFreeCtx,
+    .ops = {
+        DEFINE_OPER(CONTEND_ID, RandGen),
+    },
+};
+
+DEFINE_BENCH_CTX(Rand);
@@ -14,6 +14,7 @@
  */
 
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 #include "crypt_algid.h"
 #include "crypt_errno.h"
@@ -39,7 +40,7 @@ static void Sm2FreeCtx(void *ctx)
 static int32_t Sm2KeyGen(void *ctx, BenchCtx *bench)
 {
     int rc = CRYPT_SUCCESS;
-    BENCH_TIMES(rc = CRYPT_EAL_PkeyGen(ctx), rc, CRYPT_SUCCESS, bench->times, "sm2 keyGen");
+    BENCH_RUN(bench, CRYPT_EAL_PkeyGen(ctx), rc, CRYPT_SUCCESS, 0, "sm2 keyGen");
     return rc;
 }
 
@@ -83,7 +84,7 @@ static int32_t Sm2KeyDerive(void *ctx, BenchCtx *bench)
         printf("Failed to set R\n");
         goto ERR_OUT;
     }
-    BENCH_TIMES(Sm2KeyDeriveInner(ctx, peerCtx), rc, CRYPT_SUCCESS, bench->times, "sm2 keyDerive");
+    BENCH_RUN(bench, Sm2KeyDeriveInner(ctx, peerCtx), rc, CRYPT_SUCCESS, 0, "sm2 keyDerive");
 ERR_OUT:
     CRYPT_EAL_PkeyFreeCtx(peerCtx);
     return rc;
@@ -100,15 +101,21 @@ static int32_t Sm2EncInner(void *ctx)
 static int32_t Sm2Enc(void *ctx, BenchCtx *bench)
 {
     int rc = CRYPT_SUCCESS;
-    BENCH_TIMES(Sm2EncInner(ctx), rc, CRYPT_SUCCESS, bench->times, "sm2 enc");
+    BENCH_RUN(bench, Sm2EncInner(ctx), rc, CRYPT_SUCCESS, 0, "sm2 enc");
     return rc;
 }
 
+static int32_t Sm2DecInner(void *ctx, const uint8_t *cipherText, uint32_t cipherTextLen)
+{
+    uint8_t plainText[32];
+    uint32_t plainTextLen = sizeof(plainText);
+    return CRYPT_EAL_PkeyDecrypt(ctx, cipherText, cipherTextLen, plainText, &plainTextLen);
+}
+
 static int32_t Sm2Dec(void *ctx, BenchCtx *bench)
 {
     int rc;
     uint8_t plainText[32];
-    uint32_t plainTextLen = sizeof(plainText);
     uint8_t cipherText[256]; // > 32 + 97 + 12
     uint32_t outLen = sizeof(cipherText);
     rc = CRYPT_EAL_PkeyEncrypt(ctx, plainText, sizeof(plainText), cipherText, &outLen);
@@ -116,8 +123,7 @@ static int32_t Sm2Dec(void *ctx, BenchCtx *bench)
         printf("Failed to encrypt\n");
         return rc;
     }
-    BENCH_TIMES(CRYPT_EAL_PkeyDecrypt(ctx, cipherText, outLen, plainText, &plainTextLen), rc, CRYPT_SUCCESS, bench->times,
-                "sm2 dec");
+    BENCH_RUN(bench, Sm2DecInner(ctx, cipherText, outLen), rc, CRYPT_SUCCESS, 0, "sm2 dec");
     return rc;
 }
 
@@ -132,23 +138,65 @@ static int32_t Sm2SignInner(void *ctx)
 static int32_t Sm2Sign(void *ctx, BenchCtx *bench)
 {
     int rc;
-    BENCH_TIMES(Sm2SignInner(ctx), rc, CRYPT_SUCCESS, bench->times, "sm2 sign");
+    BENCH_RUN(bench, Sm2SignInner(ctx), rc, CRYPT_SUCCESS, 0, "sm2 sign");
     return rc;
 }
 
+// What a verifier that does not keep a ctx per peer holds: the public key and, optionally, the ZA of the peer.
+typedef struct {
+    CRYPT_EAL_PkeyPub pub;
+    const uint8_t *za;
+    uint8_t plainText[32];
+    uint8_t signature[256];
+    uint32_t signatureLen;
+} Sm2VerifyData;
+
+/* Every operation starts from a fresh ctx, so the ZA is computed from the user ID and the public key unless it is
+ * imported. */
+static int32_t Sm2VerifyFreshInner(const Sm2VerifyData *data)
+{
+    CRYPT_EAL_PkeyCtx *ctx = CRYPT_EAL_PkeyNewCtx(CRYPT_PKEY_SM2);
+    if (ctx == NULL) {
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    int32_t ret = CRYPT_EAL_PkeySetPub(ctx, &data->pub);
+    if (ret == CRYPT_SUCCESS && data->za != NULL) {
+        ret = CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_SET_SM2_ZA, (void *)(uintptr_t)data->za, 32); // 32: the SM3 digest
+    }
+    if (ret == CRYPT_SUCCESS) {
+        ret = CRYPT_EAL_PkeyVerify(ctx, CRYPT_MD_SM3, data->plainText, sizeof(data->plainText), data->signature,
+            data->signatureLen);
+    }
+    CRYPT_EAL_PkeyFreeCtx(ctx);
+    return ret;
+}
+
 static int32_t Sm2Verify(void *ctx, BenchCtx *bench)
 {
     int rc;
-    uint8_t plainText[32];
-    uint8_t signature[256];
-    uint32_t signatureLen = sizeof(signature);
-    rc = CRYPT_EAL_PkeySign(ctx, CRYPT_MD_SM3, plainText, sizeof(plainText), signature, &signatureLen);
+    uint8_t pubKey[65]; // 65: the uncompressed point
+    uint8_t za[32];
+    Sm2VerifyData data = {0};
+    data.pub.id = CRYPT_PKEY_SM2;
+    data.pub.key.eccPub.data = pubKey;
+    data.pub.key.eccPub.len = sizeof(pubKey);
+    data.signatureLen = sizeof(data.signature);
+    rc = CRYPT_EAL_PkeySign(ctx, CRYPT_MD_SM3, data.plainText, sizeof(data.plainText), data.signature,
+        &data.signatureLen);
     if (rc != CRYPT_SUCCESS) {
         printf("Failed to sign\n");
         return rc;
     }
-    BENCH_TIMES(CRYPT_EAL_PkeyVerify(ctx, CRYPT_MD_SM3, plainText, sizeof(plainText), signature, signatureLen), rc,
-                CRYPT_SUCCESS, bench->times, "sm2 verify");
+    BENCH_RUN(bench, CRYPT_EAL_PkeyVerify(ctx, CRYPT_MD_SM3, data.plainText, sizeof(data.plainText), data.signature,
+              data.signatureLen), rc, CRYPT_SUCCESS, 0, "sm2 verify");
+    if (CRYPT_EAL_PkeyGetPub(ctx, &data.pub) != CRYPT_SUCCESS ||
+        CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_GET_SM2_ZA, za, sizeof(za)) != CRYPT_SUCCESS) {
+        printf("Failed to get the public key and ZA\n");
+        return CRYPT_NULL_INPUT;
+    }
+    BENCH_RUN(bench, Sm2VerifyFreshInner(&data), rc, CRYPT_SUCCESS, 0, "sm2 verify, new ctx");
+    data.za = za;
+    BENCH_RUN(bench, Sm2VerifyFreshInner(&data), rc, CRYPT_SUCCESS, 0, "sm2 verify, new ctx, ZA imported");
     return rc;
 }
 
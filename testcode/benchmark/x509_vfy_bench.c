@@ -0,0 +1,195 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bsl_sal.h"
+#include "bsl_list.h"
+#include "bsl_obj.h"
+#include "bsl_types.h"
+#include "crypt_algid.h"
+#include "crypt_errno.h"
+#include "crypt_eal_pkey.h"
+#include "hitls_pki_errno.h"
+#include "hitls_pki_cert.h"
+#include "hitls_pki_utils.h"
+#include "hitls_pki_x509.h"
+#include "benchmark.h"
+
+#define X509_VFY_BENCH_STORE_SIZE 10000
+
+typedef struct {
+    CRYPT_EAL_PkeyCtx *key;
+    HITLS_X509_StoreCtx *store;
+    HITLS_X509_List *chain; // The end entity cert followed by the untrusted intermediate ca
+} X509VfyCtx;
+
+static HITLS_X509_Cert *X509VfyBenchNewCert(CRYPT_EAL_PkeyCtx *key, const char *subject, const char *issuer,
+    uint32_t serial, bool isCa)
+{
+    HITLS_X509_Cert *parsed = NULL;
+    BSL_Buffer encode = {0};
+    HITLS_X509_Cert *cert = HITLS_X509_CertNew();
+    BslList *subjectDn = HITLS_X509_DnListNew();
+    BslList *issuerDn = HITLS_X509_DnListNew();
+    if (cert == NULL || subjectDn == NULL || issuerDn == NULL) {
+        goto EXIT;
+    }
+    HITLS_X509_DN subjectName[1] = {{BSL_CID_AT_COMMONNAME, (uint8_t *)(uintptr_t)subject, (uint32_t)strlen(subject)}};
+    HITLS_X509_DN issuerName[1] = {{BSL_CID_AT_COMMONNAME, (uint8_t *)(uintptr_t)issuer, (uint32_t)strlen(issuer)}};
+    int32_t version = HITLS_X509_VERSION_3;
+    uint8_t serialNum[4] = {(uint8_t)(serial >> 24), (uint8_t)(serial >> 16), (uint8_t)(serial >> 8), (uint8_t)serial};
+    BSL_TIME beforeTime = {2024, 1, 1, 0, 0, 0, 0, 0};
+    BSL_TIME afterTime = {2050, 1, 1, 0, 0, 0, 0, 0};
+    HITLS_X509_ExtBCons bCons = {true, isCa, -1};
+    HITLS_X509_ExtKeyUsage keyUsage = {true, isCa ? HITLS_X509_EXT_KU_KEY_CERT_SIGN : HITLS_X509_EXT_KU_DIGITAL_SIGN};
+    if (HITLS_X509_AddDnName(subjectDn, subjectName, 1) != HITLS_PKI_SUCCESS ||
+        HITLS_X509_AddDnName(issuerDn, issuerName, 1) != HITLS_PKI_SUCCESS ||
+        HITLS_X509_CertCtrl(cert, HITLS_X509_SET_VERSION, &version, sizeof(int32_t)) != HITLS_PKI_SUCCESS ||
+        HITLS_X509_CertCtrl(cert, HITLS_X509_SET_SERIALNUM, serialNum, sizeof(serialNum)) != HITLS_PKI_SUCCESS ||
+        HITLS_X509_CertCtrl(cert, HITLS_X509_SET_BEFORE_TIME, &beforeTime, sizeof(BSL_TIME)) != HITLS_PKI_SUCCESS ||
+        HITLS_X509_CertCtrl(cert, HITLS_X509_SET_AFTER_TIME, &afterTime, sizeof(BSL_TIME)) != HITLS_PKI_SUCCESS ||
+        HITLS_X509_CertCtrl(cert, HITLS_X509_SET_PUBKEY, key, sizeof(void *)) != HITLS_PKI_SUCCESS ||
+        HITLS_X509_CertCtrl(cert, HITLS_X509_SET_SUBJECT_DN, subjectDn, sizeof(BslList)) != HITLS_PKI_SUCCESS ||
+        HITLS_X509_CertCtrl(cert, HITLS_X509_SET_ISSUER_DN, issuerDn, sizeof(BslList)) != HITLS_PKI_SUCCESS ||
+        HITLS_X509_CertCtrl(cert, HITLS_X509_EXT_SET_BCONS, &bCons, sizeof(HITLS_X509_ExtBCons)) !=
+            HITLS_PKI_SUCCESS ||
+        HITLS_X509_CertCtrl(cert, HITLS_X509_EXT_SET_KUSAGE, &keyUsage, sizeof(HITLS_X509_ExtKeyUsage)) !=
+            HITLS_PKI_SUCCESS ||
+        HITLS_X509_CertSign(CRYPT_MD_SHA256, key, NULL, cert) != HITLS_PKI_SUCCESS ||
+        HITLS_X509_CertGenBuff(BSL_FORMAT_ASN1, cert, &encode) != HITLS_PKI_SUCCESS) {
+        goto EXIT;
+    }
+    // Parse the encoded cert again, as the certs in a trust store are loaded from files.
+    (void)HITLS_X509_CertParseBuff(BSL_FORMAT_ASN1, &encode, &parsed);
+EXIT:
+    BSL_SAL_Free(encode.data);
+    HITLS_X509_DnListFree(subjectDn);
+    HITLS_X509_DnListFree(issuerDn);
+    HITLS_X509_CertFree(cert);
+    return parsed;
+}
+
+static int32_t X509VfyBenchAddCa(HITLS_X509_StoreCtx *store, HITLS_X509_Cert *ca)
+{
+    if (ca == NULL) {
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    int32_t ret = HITLS_X509_StoreCtxCtrl(store, HITLS_X509_STORECTX_SHALLOW_COPY_SET_CA, ca, 0);
+    if (ret != HITLS_PKI_SUCCESS) {
+        HITLS_X509_CertFree(ca);
+    }
+    return ret;
+}
+
+static int32_t X509VfyBenchAddChain(HITLS_X509_List *chain, HITLS_X509_Cert *cert)
+{
+    if (cert == NULL) {
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    int32_t ret = BSL_LIST_AddElement(chain, cert, BSL_LIST_POS_END);
+    if (ret != BSL_SUCCESS) {
+        HITLS_X509_CertFree(cert);
+    }
+    return ret;
+}
+
+static void X509VfyFreeCtx(void *ctx)
+{
+    X509VfyCtx *benchCtx = ctx;
+    if (benchCtx == NULL) {
+        return;
+    }
+    BSL_LIST_FREE(benchCtx->chain, (BSL_LIST_PFUNC_FREE)HITLS_X509_CertFree);
+    HITLS_X509_StoreCtxFree(benchCtx->store);
+    CRYPT_EAL_PkeyFreeCtx(benchCtx->key);
+    free(benchCtx);
+}
+
+static int32_t X509VfyNewCtxInner(X509VfyCtx *benchCtx)
+{
+    benchCtx->key = CRYPT_EAL_PkeyNewCtx(CRYPT_PKEY_ECDSA);
+    benchCtx->store = HITLS_X509_StoreCtxNew();
+    benchCtx->chain = BSL_LIST_New(sizeof(HITLS_X509_Cert *));
+    if (benchCtx->key == NULL || benchCtx->store == NULL || benchCtx->chain == NULL) {
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    int32_t ret = CRYPT_EAL_PkeySetParaById(benchCtx->key, CRYPT_ECC_NISTP256);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    ret = CRYPT_EAL_PkeyGen(benchCtx->key);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    // All cas share one key, only the names differ, so that the store is filled quickly.
+    char name[32];
+    for (uint32_t i = 0; i < X509_VFY_BENCH_STORE_SIZE; i++) {
+        (void)snprintf(name, sizeof(name), "Bench CA %05u", i);
+        ret = X509VfyBenchAddCa(benchCtx->store, X509VfyBenchNewCert(benchCtx->key, name, name, i + 1, true));
+        if (ret != HITLS_PKI_SUCCESS) {
+            return ret;
+        }
+    }
+    ret = X509VfyBenchAddCa(benchCtx->store,
+        X509VfyBenchNewCert(benchCtx->key, "Bench Root", "Bench Root", X509_VFY_BENCH_STORE_SIZE + 1, true));
+    if (ret != HITLS_PKI_SUCCESS) {
+        return ret;
+    }
+    ret = X509VfyBenchAddChain(benchCtx->chain,
+        X509VfyBenchNewCert(benchCtx->key, "Bench Leaf", "Bench Inter", X509_VFY_BENCH_STORE_SIZE + 3, false));
+    if (ret != BSL_SUCCESS) {
+        return ret;
+    }
+    return X509VfyBenchAddChain(benchCtx->chain,
+        X509VfyBenchNewCert(benchCtx->key, "Bench Inter", "Bench Root", X509_VFY_BENCH_STORE_SIZE + 2, true));
+}
+
+static int32_t X509VfyNewCtx(void **ctx)
+{
+    X509VfyCtx *benchCtx = calloc(1, sizeof(X509VfyCtx));
+    if (benchCtx == NULL) {
+        printf("Failed to create x509 verify context\n");
+        return CRYPT_MEM_ALLOC_FAIL;
+    }
+    int32_t ret = X509VfyNewCtxInner(benchCtx);
+    if (ret != CRYPT_SUCCESS) {
+        printf("Failed to build the trust store, ret = %08x\n", ret);
+        X509VfyFreeCtx(benchCtx);
+        return ret;
+    }
+    *ctx = benchCtx;
+    return CRYPT_SUCCESS;
+}
+
+static int32_t X509VfyVerify(void *ctx, BenchCtx *bench)
+{
+    int rc = CRYPT_SUCCESS;
+    X509VfyCtx *benchCtx = ctx;
+    BENCH_RUN(bench, HITLS_X509_CertVerify(benchCtx->store, benchCtx->chain), rc, HITLS_PKI_SUCCESS, 0,
+              "x509 verify 10k store");
+    return rc;
+}
+
+static const CtxOps X509VfyCtxOps = {
+    .newCtx = X509VfyNewCtx,
+    .freeCtx = X509VfyFreeCtx,
+    .ops = {
+        DEFINE_OPER(VERIFY_ID, X509VfyVerify),
+    },
+};
+
+DEFINE_BENCH_CTX(X509Vfy);
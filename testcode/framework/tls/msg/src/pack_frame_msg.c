@@ -19,6 +19,7 @@
 #include "hitls_error.h"
 #include "hitls.h"
 #include "tls.h"
+#include "config.h"
 #include "hs_ctx.h"
 #include "pack_common.h"
 #include "pack.h"
@@ -75,7 +76,7 @@ int32_t GenClientHelloMandatoryCtx(TLS_Ctx *tlsCtx, FRAME_Msg *msg)
 
     tlsConfig->cipherSuitesSize = clientHello->cipherSuitesSize;
     uint32_t suitsLen = clientHello->cipherSuitesSize * sizeof(uint16_t);
-    tlsConfig->cipherSuites = (uint16_t *)BSL_SAL_Dump(clientHello->cipherSuites, suitsLen);
+    tlsConfig->cipherSuites = (uint16_t *)CFG_ListDump(clientHello->cipherSuites, suitsLen);
     if (tlsConfig->cipherSuites == NULL) {
         return HITLS_MEMALLOC_FAIL;
     }
@@ -91,7 +92,7 @@ int32_t GenClientHelloExtensionCtx(TLS_Ctx *tlsCtx, FRAME_Msg *msg)
     tlsConfig->signAlgorithmsSize = clientHello->extension.content.signatureAlgorithmsSize;
     if (tlsConfig->signAlgorithmsSize > 0) {
         uint32_t signAlgorithmsLen = tlsConfig->signAlgorithmsSize * sizeof(uint16_t);
-        tlsConfig->signAlgorithms = (uint16_t *)BSL_SAL_Dump(clientHello->extension.content.signatureAlgorithms,
+        tlsConfig->signAlgorithms = (uint16_t *)CFG_ListDump(clientHello->extension.content.signatureAlgorithms,
             signAlgorithmsLen);
         if (tlsConfig->signAlgorithms == NULL) {
             return HITLS_MEMALLOC_FAIL;
@@ -101,7 +102,7 @@ int32_t GenClientHelloExtensionCtx(TLS_Ctx *tlsCtx, FRAME_Msg *msg)
     tlsConfig->groupsSize = clientHello->extension.content.supportedGroupsSize;
     if (tlsConfig->groupsSize > 0) {
         uint32_t groupsLen = tlsConfig->groupsSize * sizeof(uint16_t);
-        tlsConfig->groups = (uint16_t *)BSL_SAL_Dump(clientHello->extension.content.supportedGroups, groupsLen);
+        tlsConfig->groups = (uint16_t *)CFG_ListDump(clientHello->extension.content.supportedGroups, groupsLen);
         if (tlsConfig->groups == NULL) {
             return HITLS_MEMALLOC_FAIL;
         }
@@ -110,7 +111,7 @@ int32_t GenClientHelloExtensionCtx(TLS_Ctx *tlsCtx, FRAME_Msg *msg)
     tlsConfig->pointFormatsSize = clientHello->extension.content.pointFormatsSize;
     if (tlsConfig->pointFormatsSize > 0) {
         uint32_t pointFormatsLen = tlsConfig->pointFormatsSize * sizeof(uint8_t);
-        tlsConfig->pointFormats = (uint8_t *)BSL_SAL_Dump(clientHello->extension.content.pointFormats, pointFormatsLen);
+        tlsConfig->pointFormats = (uint8_t *)CFG_ListDump(clientHello->extension.content.pointFormats, pointFormatsLen);
         if (tlsConfig->pointFormats == NULL) {
             return HITLS_MEMALLOC_FAIL;
         }
@@ -44,6 +44,7 @@
 #define LONG_BN_BITS_256 256
 #define UINT8_MAX_NUM 255
 #define BN_SIZE 1024
+#define BN_INV_BATCH_MAX_NUM 8
 
 extern int32_t ModExpInputCheck(
     const BN_BigNum *r, const BN_BigNum *a, const BN_BigNum *e, const BN_BigNum *m, const BN_Optimizer *opt);
@@ -581,6 +582,60 @@ EXIT:
 }
 /* END_CASE */
 
+/**
+ * @test   SDV_CRYPTO_BN_MODINV_BATCH_FUNC_TC001
+ * @title  BN_ModInvBatch test.
+ * @precon Vectors: hex, modulo
+ * @brief
+ *    1. Call BN_ModInvBatch with a[i] = hex + i, expected result 1.
+ *    2. If success is returned in the previous step, compare r[i] with the result of BN_ModInv, expected result 2.
+ *    3. Call BN_ModInvBatch with invalid parameters, expected result 3.
+ * @expect
+ *    1. The return value is the same as expect.
+ *    2. The results are the same.
+ *    3. CRYPT_NULL_INPUT
+ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_BN_MODINV_BATCH_FUNC_TC001(Hex *hex, Hex *modulo, int num, int expect)
+{
+    TestMemInit();
+    BN_BigNum *a[BN_INV_BATCH_MAX_NUM] = {0};
+    BN_BigNum *r[BN_INV_BATCH_MAX_NUM] = {0};
+    BN_BigNum *inv = NULL;
+    BN_Optimizer *opt = BN_OptimizerCreate();
+    BN_BigNum *m = TEST_VectorToBN(0, modulo->x, modulo->len);
+    ASSERT_TRUE(m != NULL && opt != NULL && num > 0 && num <= BN_INV_BATCH_MAX_NUM);
+    inv = BN_Create(BN_Bits(m));
+    ASSERT_TRUE(inv != NULL);
+    for (int i = 0; i < num; i++) {
+        a[i] = TEST_VectorToBN(0, hex->x, hex->len);
+        r[i] = BN_Create(0); // The space of the results is extended by BN_ModInvBatch.
+        ASSERT_TRUE(a[i] != NULL && r[i] != NULL);
+        ASSERT_EQ(BN_AddLimb(a[i], a[i], (BN_UINT)i), CRYPT_SUCCESS);
+    }
+
+    ASSERT_EQ(BN_ModInvBatch(r, a, num, m, opt), expect);
+    for (int i = 0; i < num && expect == CRYPT_SUCCESS; i++) {
+        ASSERT_EQ(BN_ModInv(inv, a[i], m, opt), CRYPT_SUCCESS);
+        ASSERT_EQ(BN_Cmp(r[i], inv), 0);
+    }
+
+    ASSERT_EQ(BN_ModInvBatch(NULL, a, num, m, opt), CRYPT_NULL_INPUT);
+    ASSERT_EQ(BN_ModInvBatch(r, NULL, num, m, opt), CRYPT_NULL_INPUT);
+    ASSERT_EQ(BN_ModInvBatch(r, a, 0, m, opt), CRYPT_NULL_INPUT);
+    ASSERT_EQ(BN_ModInvBatch(r, a, num, NULL, opt), CRYPT_NULL_INPUT);
+    ASSERT_EQ(BN_ModInvBatch(r, a, num, m, NULL), CRYPT_NULL_INPUT);
+EXIT:
+    for (int i = 0; i < BN_INV_BATCH_MAX_NUM; i++) {
+        BN_Destroy(a[i]);
+        BN_Destroy(r[i]);
+    }
+    BN_Destroy(inv);
+    BN_Destroy(m);
+    BN_OptimizerDestroy(opt);
+}
+/* END_CASE */
+
 /**
  * @test   SDV_CRYPTO_BN_MOD_EXP_INPUT_CHECK_API_TC001
  * @title  ModExpInputCheck: Test invalid parameters and normal functions.
@@ -1671,6 +1671,270 @@ EXIT:
 }
 /* END_CASE */
 
+#define DRBG_PER_THREAD_NUM 8
+#define DRBG_PER_THREAD_OUT_SIZE 32
+
+typedef struct {
+    void *drbgCtx; // NULL: the global random of the lib ctx
+    uint8_t first[DRBG_PER_THREAD_OUT_SIZE];
+    int32_t ret;
+} DrbgPerThreadArg;
+
+static void *sdvCryptPerThreadTest(void *arg)
+{
+    DrbgPerThreadArg *threadArg = arg;
+    uint8_t output[DRBG_OUTPUT_SIZE];
+    for (int i = 0; i < 100; i++) { // Perform 100 times random number generation in the thread.
+        if (threadArg->drbgCtx == NULL) {
+            threadArg->ret = CRYPT_EAL_RandbytesEx(NULL, output, sizeof(output));
+        } else {
+            threadArg->ret = CRYPT_EAL_Drbgbytes(threadArg->drbgCtx, output, sizeof(output));
+        }
+        if (threadArg->ret != CRYPT_SUCCESS) {
+            break;
+        }
+        if (i == 0) {
+            (void)memcpy_s(threadArg->first, sizeof(threadArg->first), output, sizeof(threadArg->first));
+        }
+    }
+    return NULL;
+}
+
+static int32_t RunPerThreadTest(void *drbgCtx, DrbgPerThreadArg *args)
+{
+    pthread_t thrd[DRBG_PER_THREAD_NUM];
+    for (uint32_t i = 0; i < DRBG_PER_THREAD_NUM; i++) {
+        args[i].drbgCtx = drbgCtx;
+        if (pthread_create(&thrd[i], NULL, sdvCryptPerThreadTest, &args[i]) != 0) {
+            for (uint32_t j = 0; j < i; j++) {
+                pthread_join(thrd[j], NULL);
+            }
+            return CRYPT_INVALID_ARG;
+        }
+    }
+    for (uint32_t i = 0; i < DRBG_PER_THREAD_NUM; i++) {
+        pthread_join(thrd[i], NULL);
+    }
+    for (uint32_t i = 0; i < DRBG_PER_THREAD_NUM; i++) {
+        if (args[i].ret != CRYPT_SUCCESS) {
+            return args[i].ret;
+        }
+        // Every thread generates with its own DRBG, so no two threads share an output.
+        for (uint32_t j = 0; j < i; j++) {
+            if (memcmp(args[i].first, args[j].first, DRBG_PER_THREAD_OUT_SIZE) == 0) {
+                return CRYPT_INVALID_ARG;
+            }
+        }
+    }
+    return CRYPT_SUCCESS;
+}
+
+static uint32_t CountThreadDrbgs(const CRYPT_EAL_RndCtx *ctx)
+{
+    uint32_t num = 0;
+    for (const CRYPT_EAL_RndCtx *drbg = ctx->threadDrbgs; drbg != NULL; drbg = drbg->next) {
+        num++;
+    }
+    return num;
+}
+
+/**
+ * @test   SDV_CRYPT_DRBG_PER_THREAD_FUNC_TC001
+ * @title  Per-thread DRBG function test.
+ * @precon nan
+ * @brief
+ *    1.Initialize drbgCtx in the per-thread mode, expected result 1.
+ *    2.Create 8 threads for execute CRYPT_EAL_Drbgbytes at the same time, expected result 2.
+ *    3.Reseed drbgCtx and generate again in all threads, expected result 2.
+ *    4.Run 8 more times 8 threads that generate and exit, and count the thread DRBGs, expected result 3.
+ *    5.Initialize the global random with CRYPT_PARAM_RAND_PER_THREAD, create 8 threads for execute
+ *      CRYPT_EAL_RandbytesEx, expected result 2.
+ *    6.Generate with the global random and check the thread DRBG, expected result 4.
+ * @expect
+ *    1.init successful.
+ *    2.All threads are executed successfully and get different random numbers.
+ *    3.The DRBG of a thread is freed when the thread exits, no thread DRBG is left.
+ *    4.The thread DRBG is created by the provider of the global random.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPT_DRBG_PER_THREAD_FUNC_TC001(int agId)
+{
+    if (IsRandAlgDisabled(agId)) {
+        SKIP_TEST();
+    }
+    CRYPT_Data data = { 0 };
+    CRYPT_RandSeedMethod seedMeth = { 0 };
+    DRBG_Vec_t seedCtx = { 0 };
+    DrbgPerThreadArg args[DRBG_PER_THREAD_NUM];
+    uint8_t output[DRBG_OUTPUT_SIZE];
+    int32_t perThread = 1;
+    bool perThreadParam = true;
+    void *drbgCtx = NULL;
+    CRYPT_EAL_RndCtx *global = NULL;
+    CRYPT_EAL_RndCtx *threadDrbg = NULL;
+
+    TestMemInit();
+    RegThreadFunc();
+    regSeedMeth(&seedMeth);
+    drbgDataInit(&data, TEST_DRBG_DATA_SIZE);
+
+    seedCtx.entropy = &data;
+    seedCtx.nonce = &data;
+    drbgCtx = CRYPT_EAL_DrbgNew(agId, &seedMeth, &seedCtx);
+    ASSERT_TRUE(drbgCtx != NULL);
+    ASSERT_EQ(CRYPT_EAL_DrbgCtrl(drbgCtx, CRYPT_CTRL_SET_RAND_PER_THREAD, &perThread, sizeof(perThread)),
+        CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_DrbgInstantiate(drbgCtx, NULL, 0), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_DrbgCtrl(drbgCtx, CRYPT_CTRL_SET_RAND_PER_THREAD, &perThread, sizeof(perThread)),
+        CRYPT_EAL_ERR_RAND_WORKING);
+
+    ASSERT_EQ(CRYPT_EAL_Drbgbytes(drbgCtx, output, sizeof(output)), CRYPT_SUCCESS);
+    ASSERT_EQ(RunPerThreadTest(drbgCtx, args), CRYPT_SUCCESS);
+    ASSERT_EQ(CountThreadDrbgs(drbgCtx), 1); // the DRBG of the main thread
+    ASSERT_EQ(CRYPT_EAL_DrbgSeed(drbgCtx), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_Drbgbytes(drbgCtx, output, sizeof(output)), CRYPT_SUCCESS);
+    ASSERT_EQ(RunPerThreadTest(drbgCtx, args), CRYPT_SUCCESS);
+    for (uint32_t i = 0; i < DRBG_PER_THREAD_NUM; i++) {
+        ASSERT_EQ(RunPerThreadTest(drbgCtx, args), CRYPT_SUCCESS);
+    }
+    ASSERT_EQ(CountThreadDrbgs(drbgCtx), 1);
+
+    BSL_Param param[7] = {0};
+    ASSERT_EQ(BSL_PARAM_InitValue(&param[0],
+        CRYPT_PARAM_RAND_SEEDCTX, BSL_PARAM_TYPE_CTX_PTR, &seedCtx, 0), BSL_SUCCESS);
+    ASSERT_EQ(BSL_PARAM_InitValue(&param[1],
+        CRYPT_PARAM_RAND_SEED_GETENTROPY, BSL_PARAM_TYPE_FUNC_PTR, seedMeth.getEntropy, 0), BSL_SUCCESS);
+    ASSERT_EQ(BSL_PARAM_InitValue(&param[2],
+        CRYPT_PARAM_RAND_SEED_CLEANENTROPY, BSL_PARAM_TYPE_FUNC_PTR, seedMeth.cleanEntropy, 0), BSL_SUCCESS);
+    ASSERT_EQ(BSL_PARAM_InitValue(&param[3],
+        CRYPT_PARAM_RAND_SEED_GETNONCE, BSL_PARAM_TYPE_FUNC_PTR, seedMeth.getNonce, 0), BSL_SUCCESS);
+    ASSERT_EQ(BSL_PARAM_InitValue(&param[4],
+        CRYPT_PARAM_RAND_SEED_CLEANNONCE, BSL_PARAM_TYPE_FUNC_PTR, seedMeth.cleanNonce, 0), BSL_SUCCESS);
+    ASSERT_EQ(BSL_PARAM_InitValue(&param[5],
+        CRYPT_PARAM_RAND_PER_THREAD, BSL_PARAM_TYPE_BOOL, &perThreadParam, sizeof(perThreadParam)), BSL_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_ProviderRandInitCtx(NULL, agId, "provider=default", NULL, 0, param), CRYPT_SUCCESS);
+    ASSERT_EQ(RunPerThreadTest(NULL, args), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_RandSeedEx(NULL), CRYPT_SUCCESS);
+    ASSERT_EQ(RunPerThreadTest(NULL, args), CRYPT_SUCCESS);
+#ifdef HITLS_CRYPTO_PROVIDER
+    // The thread DRBGs of a provider DRBG are created by the same provider.
+    ASSERT_EQ(CRYPT_EAL_RandbytesEx(NULL, output, sizeof(output)), CRYPT_SUCCESS);
+    global = CRYPT_EAL_GetGlobalLibCtx()->drbg;
+    threadDrbg = BSL_SAL_ThreadGetSpecific(global->threadKey);
+    ASSERT_TRUE(threadDrbg != NULL && threadDrbg->isProvider);
+    ASSERT_TRUE(threadDrbg->provCtx == global->provCtx && threadDrbg->meth->gen == global->meth->gen);
+#endif
+EXIT:
+    CRYPT_EAL_RandDeinitEx(NULL);
+    CRYPT_EAL_DrbgDeinit(drbgCtx);
+    drbgDataFree(&data);
+    return;
+}
+/* END_CASE */
+
+#define DRBG_CONCURRENT_THREAD_NUM 64
+
+typedef struct {
+    CRYPT_EAL_RndCtx *drbgCtx;
+    pthread_barrier_t *generated; // every thread has generated, the thread DRBGs are counted
+    pthread_barrier_t *counted;   // the threads may exit
+    const CRYPT_EAL_RndCtx *drbg; // the thread DRBG the thread generated with
+    int32_t ret;
+} DrbgConcurrentArg;
+
+static void *sdvCryptConcurrentThreadTest(void *arg)
+{
+    DrbgConcurrentArg *threadArg = arg;
+    uint8_t output[DRBG_OUTPUT_SIZE];
+    threadArg->ret = CRYPT_EAL_Drbgbytes(threadArg->drbgCtx, output, sizeof(output));
+    threadArg->drbg = BSL_SAL_ThreadGetSpecific(threadArg->drbgCtx->threadKey);
+    (void)pthread_barrier_wait(threadArg->generated);
+    (void)pthread_barrier_wait(threadArg->counted);
+    return NULL;
+}
+
+/**
+ * @test   SDV_CRYPT_DRBG_PER_THREAD_FUNC_TC002
+ * @title  Every live thread has its own DRBG in the per-thread mode.
+ * @precon nan
+ * @brief
+ *    1.Initialize drbgCtx in the per-thread mode, expected result 1.
+ *    2.Create 64 threads that execute CRYPT_EAL_Drbgbytes and wait until all of them have generated,
+ *      expected result 2.
+ *    3.Let the threads exit and count the thread DRBGs, expected result 3.
+ * @expect
+ *    1.init successful.
+ *    2.All threads are executed successfully, there are 64 thread DRBGs and every thread has a different one.
+ *    3.No thread DRBG is left.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPT_DRBG_PER_THREAD_FUNC_TC002(int agId)
+{
+    if (IsRandAlgDisabled(agId)) {
+        SKIP_TEST();
+    }
+    CRYPT_Data data = { 0 };
+    CRYPT_RandSeedMethod seedMeth = { 0 };
+    DRBG_Vec_t seedCtx = { 0 };
+    DrbgConcurrentArg args[DRBG_CONCURRENT_THREAD_NUM] = { 0 };
+    pthread_t thrd[DRBG_CONCURRENT_THREAD_NUM];
+    pthread_barrier_t generated;
+    pthread_barrier_t counted;
+    uint32_t created = 0;
+    uint32_t drbgNum = 0;
+    int32_t perThread = 1;
+    CRYPT_EAL_RndCtx *drbgCtx = NULL;
+
+    TestMemInit();
+    RegThreadFunc();
+    regSeedMeth(&seedMeth);
+    drbgDataInit(&data, TEST_DRBG_DATA_SIZE);
+    ASSERT_EQ(pthread_barrier_init(&generated, NULL, DRBG_CONCURRENT_THREAD_NUM + 1), 0);
+    ASSERT_EQ(pthread_barrier_init(&counted, NULL, DRBG_CONCURRENT_THREAD_NUM + 1), 0);
+
+    seedCtx.entropy = &data;
+    seedCtx.nonce = &data;
+    drbgCtx = CRYPT_EAL_DrbgNew(agId, &seedMeth, &seedCtx);
+    ASSERT_TRUE(drbgCtx != NULL);
+    ASSERT_EQ(CRYPT_EAL_DrbgCtrl(drbgCtx, CRYPT_CTRL_SET_RAND_PER_THREAD, &perThread, sizeof(perThread)),
+        CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_DrbgInstantiate(drbgCtx, NULL, 0), CRYPT_SUCCESS);
+
+    for (; created < DRBG_CONCURRENT_THREAD_NUM; created++) {
+        args[created].drbgCtx = drbgCtx;
+        args[created].generated = &generated;
+        args[created].counted = &counted;
+        if (pthread_create(&thrd[created], NULL, sdvCryptConcurrentThreadTest, &args[created]) != 0) {
+            break;
+        }
+    }
+    if (created == DRBG_CONCURRENT_THREAD_NUM) {
+        (void)pthread_barrier_wait(&generated);
+        drbgNum = CountThreadDrbgs(drbgCtx);
+        (void)pthread_barrier_wait(&counted);
+    }
+    for (uint32_t i = 0; i < created; i++) {
+        pthread_join(thrd[i], NULL);
+    }
+    ASSERT_EQ(created, DRBG_CONCURRENT_THREAD_NUM);
+    ASSERT_EQ(drbgNum, DRBG_CONCURRENT_THREAD_NUM);
+    for (uint32_t i = 0; i < DRBG_CONCURRENT_THREAD_NUM; i++) {
+        ASSERT_EQ(args[i].ret, CRYPT_SUCCESS);
+        ASSERT_TRUE(args[i].drbg != NULL);
+        for (uint32_t j = 0; j < i; j++) {
+            ASSERT_TRUE(args[i].drbg != args[j].drbg);
+        }
+    }
+    ASSERT_EQ(CountThreadDrbgs(drbgCtx), 0);
+EXIT:
+    (void)pthread_barrier_destroy(&generated);
+    (void)pthread_barrier_destroy(&counted);
+    CRYPT_EAL_DrbgDeinit(drbgCtx);
+    drbgDataFree(&data);
+    return;
+}
+/* END_CASE */
+
 static int32_t getEntropyWithoutSeedCtx(void *ctx, CRYPT_Data *entropy, uint32_t strength, CRYPT_Range *lenRange)
 {
     (void)ctx;
@@ -31,6 +31,8 @@ EXIT:
 }
 /* END_HEADER */
 #define CRYPT_EAL_PKEY_KEYMGMT_OPERATE 0
+#define ECDSA_BATCH_KEY_NUM 3
+#define ECDSA_BATCH_ITEM_NUM 8
 /**
  * @test   SDV_CRYPTO_ECDSA_NEW_CTX_API_TC001
  * @title  ECDSA CRYPT_EAL_PkeyNewCtx test.
@@ -1416,3 +1418,78 @@ EXIT:
 }
 /* END_CASE */
 
+
+/**
+ * @test   SDV_CRYPTO_ECDSA_VERIFY_BATCH_FUNC_TC001
+ * @title  ECDSA CRYPT_EAL_PkeyVerifyBatch: keys on two curves, one tampered message.
+ * @precon Registering memory-related functions.
+ * @brief
+ *    1. Generate two keys on curve eccId and one key on curve eccId2, expected result 1
+ *    2. Sign the messages of the items with the keys, expected result 2
+ *    3. Tamper the message of an item, expected result 3
+ *    4. Call the CRYPT_EAL_PkeyVerifyBatch method with null input, expected result 4
+ *    5. Clear the error stack and call the CRYPT_EAL_PkeyVerifyBatch method, expected result 5
+ *    6. Get the last error of the calling thread, expected result 6
+ * @expect
+ *    1-2. CRYPT_SUCCESS
+ *    4. CRYPT_NULL_INPUT
+ *    5. Return CRYPT_ECDSA_VERIFY_FAIL, and the result of every item is the same as CRYPT_EAL_PkeyVerify.
+ *    6. CRYPT_ECDSA_VERIFY_FAIL, also when the tampered item is verified by a worker thread.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_ECDSA_VERIFY_BATCH_FUNC_TC001(int eccId, int eccId2, int mdId, int threadNum, int isProvider)
+{
+    if (IsCurveDisabled(eccId) || IsCurveDisabled(eccId2)) {
+        SKIP_TEST();
+    }
+    const uint32_t keyIdx[ECDSA_BATCH_ITEM_NUM] = {0, 0, 1, 2, 0, 1, 2, 1};
+    const uint32_t tampered = 4;
+    CRYPT_EAL_PkeyCtx *keys[ECDSA_BATCH_KEY_NUM] = {0};
+    const CRYPT_EAL_PkeyCtx *pkeys[ECDSA_BATCH_ITEM_NUM];
+    CRYPT_VerifyItem items[ECDSA_BATCH_ITEM_NUM];
+    int32_t results[ECDSA_BATCH_ITEM_NUM];
+    uint8_t msg[ECDSA_BATCH_ITEM_NUM][32];
+    uint8_t sign[ECDSA_BATCH_ITEM_NUM][160];
+
+    TestMemInit();
+    ASSERT_EQ(TestRandInit(), CRYPT_SUCCESS);
+    for (uint32_t i = 0; i < ECDSA_BATCH_KEY_NUM; i++) {
+        keys[i] = TestPkeyNewCtx(NULL, CRYPT_PKEY_ECDSA,
+            CRYPT_EAL_PKEY_KEYMGMT_OPERATE + CRYPT_EAL_PKEY_SIGN_OPERATE, "provider=default", isProvider);
+        ASSERT_TRUE(keys[i] != NULL);
+        ASSERT_EQ(CRYPT_EAL_PkeySetParaById(keys[i], (i == ECDSA_BATCH_KEY_NUM - 1) ? eccId2 : eccId),
+            CRYPT_SUCCESS);
+        ASSERT_EQ(CRYPT_EAL_PkeyGen(keys[i]), CRYPT_SUCCESS);
+    }
+    for (uint32_t i = 0; i < ECDSA_BATCH_ITEM_NUM; i++) {
+        uint32_t signLen = sizeof(sign[i]);
+        (void)memset_s(msg[i], sizeof(msg[i]), (int)i, sizeof(msg[i]));
+        pkeys[i] = keys[keyIdx[i]];
+        ASSERT_EQ(CRYPT_EAL_PkeySign(pkeys[i], mdId, msg[i], sizeof(msg[i]), sign[i], &signLen), CRYPT_SUCCESS);
+        items[i].data = msg[i];
+        items[i].dataLen = sizeof(msg[i]);
+        items[i].sign = sign[i];
+        items[i].signLen = signLen;
+    }
+    msg[tampered][0] ^= 1;
+
+    ASSERT_EQ(CRYPT_EAL_PkeyVerifyBatch(NULL, mdId, items, ECDSA_BATCH_ITEM_NUM, threadNum, results),
+        CRYPT_NULL_INPUT);
+    ASSERT_EQ(CRYPT_EAL_PkeyVerifyBatch(pkeys, mdId, items, 0, threadNum, results), CRYPT_NULL_INPUT);
+
+    BSL_ERR_ClearError();
+    ASSERT_EQ(CRYPT_EAL_PkeyVerifyBatch(pkeys, mdId, items, ECDSA_BATCH_ITEM_NUM, threadNum, results),
+        CRYPT_ECDSA_VERIFY_FAIL);
+    ASSERT_EQ(BSL_ERR_GetLastError(), CRYPT_ECDSA_VERIFY_FAIL);
+    for (uint32_t i = 0; i < ECDSA_BATCH_ITEM_NUM; i++) {
+        ASSERT_EQ(results[i], (i == tampered) ? CRYPT_ECDSA_VERIFY_FAIL : CRYPT_SUCCESS);
+        ASSERT_EQ(CRYPT_EAL_PkeyVerify(pkeys[i], mdId, items[i].data, items[i].dataLen, items[i].sign,
+            items[i].signLen), results[i]);
+    }
+EXIT:
+    for (uint32_t i = 0; i < ECDSA_BATCH_KEY_NUM; i++) {
+        CRYPT_EAL_PkeyFreeCtx(keys[i]);
+    }
+    TestRandDeInit();
+}
+/* END_CASE */
@@ -0,0 +1,232 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+/* BEGIN_HEADER */
+#include <stdlib.h>
+#include "securec.h"
+#include "bsl_sal.h"
+#include "crypt_errno.h"
+#include "crypt_bn.h"
+#include "crypt_ecc.h"
+#include "ecc_local.h"
+#include "crypto_test_util.h"
+/* END_HEADER */
+
+#define AFFINE_BATCH_NUM 6
+#define AFFINE_TABLE_HALF 8 // The cached table of G holds G, 3G, ..., 15G, then their negations.
+
+// Set r to the affine point k * G.
+static int32_t AffineMulG(ECC_Para *para, ECC_Point *r, uint32_t k)
+{
+    BN_BigNum *bnK = BN_Create(BN_Bits(para->n));
+    ECC_Point *g = ECC_GetGFromPara(para);
+    int32_t ret = (bnK == NULL || g == NULL) ? CRYPT_MEM_ALLOC_FAIL : BN_SetLimb(bnK, k);
+    if (ret == CRYPT_SUCCESS) {
+        ret = ECC_PointMul(para, r, bnK, g);
+    }
+    if (ret == CRYPT_SUCCESS) {
+        ret = para->method->point2Affine(para, r, r);
+    }
+    BN_Destroy(bnK);
+    ECC_FreePoint(g);
+    return ret;
+}
+
+// Move the affine point pt to the Jacobian coordinates (x * z^2, y * z^3, z) with z = lambda.
+static int32_t AffineToJacobian(const ECC_Para *para, ECC_Point *pt, BN_UINT lambda, BN_Optimizer *opt)
+{
+    BN_BigNum *z = BN_Create(BN_Bits(para->p));
+    BN_BigNum *t = BN_Create(BN_Bits(para->p));
+    int32_t ret = (z == NULL || t == NULL) ? CRYPT_MEM_ALLOC_FAIL : BN_SetLimb(z, lambda);
+    if (ret == CRYPT_SUCCESS) {
+        ret = BN_ModSqr(t, z, para->p, opt);
+    }
+    if (ret == CRYPT_SUCCESS) {
+        ret = BN_ModMul(pt->x, pt->x, t, para->p, opt);
+    }
+    if (ret == CRYPT_SUCCESS) {
+        ret = BN_ModMul(t, t, z, para->p, opt);
+    }
+    if (ret == CRYPT_SUCCESS) {
+        ret = BN_ModMul(pt->y, pt->y, t, para->p, opt);
+    }
+    if (ret == CRYPT_SUCCESS) {
+        ret = BN_Copy(pt->z, z);
+    }
+    BN_Destroy(z);
+    BN_Destroy(t);
+    return ret;
+}
+
+/**
+ * @test   SDV_CRYPTO_ECC_POINTS2AFFINE_FUNC_TC001
+ * @title  Convert a batch of Jacobian, affine and infinite points to affine with one inversion.
+ * @brief
+ *    1. Build the batch 3G (Jacobian), O, 5G (affine), 7G (Jacobian), O, 9G (Jacobian), where the points at
+ *       infinity have z = 0 and the affine point has z = 1.
+ *    2. Convert every finite point by the point2Affine method, one point at a time, expected result 1.
+ *    3. Convert the batch by ECC_Points2Affine, expected result 2.
+ *    4. Convert a batch of the points at infinity only by ECC_Points2Affine, expected result 3.
+ * @expect
+ *    1. CRYPT_SUCCESS.
+ *    2. CRYPT_SUCCESS, the finite points equal the results of step 2 with z = 1, the points at infinity are kept.
+ *    3. CRYPT_SUCCESS, the points are kept.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_ECC_POINTS2AFFINE_FUNC_TC001(int curveId)
+{
+    TestMemInit();
+    ECC_Point *pt[AFFINE_BATCH_NUM] = { 0 };
+    ECC_Point *expect[AFFINE_BATCH_NUM] = { 0 };
+    ECC_Point *inf[2] = { 0 };
+    const uint32_t mul[AFFINE_BATCH_NUM] = { 3, 0, 5, 7, 0, 9 };
+    const BN_UINT lambda[AFFINE_BATCH_NUM] = { 0x1234567, 0, 1, 0x7654321, 0, 2 };
+    ECC_Para *para = ECC_NewPara(curveId);
+    ECC_Point *g = ECC_GetGFromPara(para);
+    BN_Optimizer *opt = BN_OptimizerCreate();
+    ASSERT_TRUE(para != NULL && g != NULL && opt != NULL);
+    ASSERT_EQ(TestRandInit(), CRYPT_SUCCESS); // the point multiplication blinds the point
+
+    // Step 1
+    for (uint32_t i = 0; i < AFFINE_BATCH_NUM; i++) {
+        pt[i] = ECC_NewPoint(para);
+        expect[i] = ECC_NewPoint(para);
+        ASSERT_TRUE(pt[i] != NULL && expect[i] != NULL);
+        if (mul[i] == 0) {
+            // Keep the coordinates of G, only z marks the point at infinity.
+            ASSERT_EQ(ECC_CopyPoint(pt[i], g), CRYPT_SUCCESS);
+            ASSERT_EQ(BN_Zeroize(pt[i]->z), CRYPT_SUCCESS);
+            continue;
+        }
+        ASSERT_EQ(AffineMulG(para, pt[i], mul[i]), CRYPT_SUCCESS);
+        ASSERT_TRUE(BN_IsOne(pt[i]->z));
+        if (lambda[i] != 1) {
+            ASSERT_EQ(AffineToJacobian(para, pt[i], lambda[i], opt), CRYPT_SUCCESS);
+        }
+    }
+
+    // Step 2
+    for (uint32_t i = 0; i < AFFINE_BATCH_NUM; i++) {
+        if (mul[i] != 0) {
+            ASSERT_EQ(para->method->point2Affine(para, expect[i], pt[i]), CRYPT_SUCCESS);
+        }
+    }
+
+    // Step 3
+    ASSERT_EQ(ECC_Points2Affine(para, pt, AFFINE_BATCH_NUM), CRYPT_SUCCESS);
+    for (uint32_t i = 0; i < AFFINE_BATCH_NUM; i++) {
+        if (mul[i] == 0) {
+            ASSERT_TRUE(BN_IsZero(pt[i]->z));
+            ASSERT_EQ(BN_Cmp(pt[i]->x, g->x), 0);
+            ASSERT_EQ(BN_Cmp(pt[i]->y, g->y), 0);
+            continue;
+        }
+        ASSERT_TRUE(BN_IsOne(pt[i]->z));
+        ASSERT_EQ(BN_Cmp(pt[i]->x, expect[i]->x), 0);
+        ASSERT_EQ(BN_Cmp(pt[i]->y, expect[i]->y), 0);
+    }
+
+    // Step 4
+    inf[0] = pt[1];
+    inf[1] = pt[4];
+    ASSERT_EQ(ECC_Points2Affine(para, inf, 2), CRYPT_SUCCESS);
+    ASSERT_TRUE(BN_IsZero(inf[0]->z) && BN_IsZero(inf[1]->z));
+    ASSERT_EQ(BN_Cmp(inf[0]->x, g->x), 0);
+EXIT:
+    for (uint32_t i = 0; i < AFFINE_BATCH_NUM; i++) {
+        ECC_FreePoint(pt[i]);
+        ECC_FreePoint(expect[i]);
+    }
+    ECC_FreePoint(g);
+    BN_OptimizerDestroy(opt);
+    ECC_FreePara(para);
+}
+/* END_CASE */
+
+/**
+ * @test   SDV_CRYPTO_ECC_TABLEG_AFFINE_FUNC_TC001
+ * @title  The cached table of the odd multiples of G is affine, in the Montgomery domain of the curve if any.
+ * @brief
+ *    1. Compute 1 * G by the window method with the cached table of G, the curves with a dedicated method use the
+ *       generic one, expected result 1.
+ *    2. Decode the table points out of the Montgomery domain and compare them with (2i + 1) * G and their
+ *       negations computed one point at a time, expected result 2.
+ * @expect
+ *    1. CRYPT_SUCCESS, the result decoded out of the Montgomery domain is G.
+ *    2. z = 1 and the coordinates are equal, z is R mod p before decoding for the Montgomery methods.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_ECC_TABLEG_AFFINE_FUNC_TC001(int curveId)
+{
+    TestMemInit();
+    ECC_Method generic;
+    ECC_Para *para = ECC_NewPara(curveId);
+    ECC_Point *g = ECC_GetGFromPara(para);
+    ECC_Point *r = ECC_NewPoint(para);
+    ECC_Point *expect = ECC_NewPoint(para);
+    ECC_Point *t = NULL;
+    BN_BigNum *k = NULL;
+    BN_BigNum *negY = NULL;
+    ASSERT_TRUE(para != NULL && g != NULL && r != NULL && expect != NULL);
+    k = BN_Create(BN_Bits(para->n));
+    negY = BN_Create(BN_Bits(para->p));
+    ASSERT_TRUE(k != NULL && negY != NULL);
+    ASSERT_EQ(TestRandInit(), CRYPT_SUCCESS);
+    if (para->method->pointMulFast != ECP_PointMulFast) {
+        // The method of the accelerated curves without a Montgomery domain, with the window method of G.
+        generic = *para->method;
+        generic.pointMul = ECP_PointMul;
+        generic.pointMulFast = ECP_PointMulFast;
+        generic.pointAdd = ECP_NistPointAdd;
+        generic.point2Affine = ECP_Point2Affine;
+        para->method = &generic;
+    }
+    bool inMont = para->method->bnMontEnc != NULL;
+
+    // Step 1
+    ASSERT_EQ(BN_SetLimb(k, 1), CRYPT_SUCCESS);
+    ASSERT_EQ(ECP_PointMulFast(para, r, k, NULL), CRYPT_SUCCESS);
+    ECC_PointFromMont(para, r); // The window method leaves the result in the Montgomery domain.
+    ASSERT_EQ(ECC_PointCmp(para, r, g), CRYPT_SUCCESS);
+
+    // Step 2
+    for (uint32_t i = 0; i < AFFINE_TABLE_HALF * 2; i++) {
+        ASSERT_TRUE(para->tableG[i] != NULL);
+        ASSERT_EQ(BN_IsOne(para->tableG[i]->z), !inMont);
+        t = ECC_DupPoint(para->tableG[i]);
+        ASSERT_TRUE(t != NULL);
+        ECC_PointFromMont(para, t);
+        ASSERT_TRUE(BN_IsOne(t->z));
+        ASSERT_EQ(AffineMulG(para, expect, (i % AFFINE_TABLE_HALF) * 2 + 1), CRYPT_SUCCESS);
+        ASSERT_EQ(BN_Cmp(t->x, expect->x), 0);
+        if (i < AFFINE_TABLE_HALF) {
+            ASSERT_EQ(BN_Cmp(t->y, expect->y), 0);
+        } else {
+            ASSERT_EQ(BN_Sub(negY, para->p, expect->y), CRYPT_SUCCESS);
+            ASSERT_EQ(BN_Cmp(t->y, negY), 0);
+        }
+        ECC_FreePoint(t);
+        t = NULL;
+    }
+EXIT:
+    BN_Destroy(k);
+    BN_Destroy(negY);
+    ECC_FreePoint(g);
+    ECC_FreePoint(r);
+    ECC_FreePoint(expect);
+    ECC_FreePoint(t);
+    ECC_FreePara(para);
+}
+/* END_CASE */
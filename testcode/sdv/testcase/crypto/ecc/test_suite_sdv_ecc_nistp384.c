@@ -0,0 +1,312 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+/* BEGIN_HEADER */
+#include <stdlib.h>
+#include "securec.h"
+#include "bsl_sal.h"
+#include "crypt_errno.h"
+#include "crypt_bn.h"
+#include "crypt_ecc.h"
+#include "ecc_local.h"
+#include "crypto_test_util.h"
+/* END_HEADER */
+
+#define P384_BYTES 48
+#define P384_SCALAR_ZERO 0
+#define P384_SCALAR_ONE 1
+#define P384_SCALAR_N_MINUS_ONE 2
+
+#if defined(HITLS_CRYPTO_CURVE_NISTP384) && defined(HITLS_CRYPTO_NIST_USE_ACCEL)
+/* The P-384 method with the generic point multiplications, as used by the builds without
+   HITLS_CRYPTO_NIST_USE_ACCEL. */
+static void P384GenericMethod(ECC_Method *generic, const ECC_Para *para)
+{
+    *generic = *para->method;
+    generic->pointMulAdd = ECP_PointMulAdd;
+    generic->pointMul = ECP_PointMul;
+    generic->pointMulFast = ECP_PointMulFast;
+    generic->pointAdd = ECP_NistPointAdd;
+    generic->point2Affine = ECP_Point2Affine;
+}
+
+// Deterministic bytes, so that a failed cross-check can be reproduced.
+static void P384TestBytes(uint8_t *buf, uint32_t len, uint32_t *state)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        *state = *state * 1103515245u + 12345u;
+        buf[i] = (uint8_t)(*state >> 16);
+    }
+}
+
+static int32_t P384TestScalar(BN_BigNum *k, const ECC_Para *para, uint32_t *state, BN_Optimizer *opt)
+{
+    uint8_t buf[P384_BYTES];
+    P384TestBytes(buf, sizeof(buf), state);
+    int32_t ret = BN_Bin2Bn(k, buf, sizeof(buf));
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    return BN_Mod(k, k, para->n, opt);
+}
+#endif
+
+/**
+ * @test   SDV_CRYPTO_ECC_NISTP384_SPECIAL_SCALAR_FUNC_TC001
+ * @title  The P-384 point multiplications with the scalars 0, 1 and n - 1.
+ * @brief
+ *    1. Compute k * G by the fixed base comb, by the window method with G as the point, and by k * G + 0 * G and
+ *       0 * G + k * G, expected result 1.
+ *    2. Compute k * G by the generic method, expected result 1.
+ * @expect
+ *    1. The results are the point at infinity, G or -G for k = 0, 1 and n - 1.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_ECC_NISTP384_SPECIAL_SCALAR_FUNC_TC001(int kType)
+{
+#if !defined(HITLS_CRYPTO_CURVE_NISTP384) || !defined(HITLS_CRYPTO_NIST_USE_ACCEL)
+    (void)kType;
+    SKIP_TEST();
+#else
+    TestMemInit();
+    ECC_Method generic;
+    ECC_Para *para = ECC_NewPara(CRYPT_ECC_NISTP384);
+    ECC_Para *genericPara = ECC_NewPara(CRYPT_ECC_NISTP384);
+    ECC_Point *g = ECC_GetGFromPara(para);
+    ECC_Point *expect = ECC_NewPoint(para);
+    ECC_Point *r = ECC_NewPoint(para);
+    BN_BigNum *k = BN_Create(P384_BYTES * 8);
+    BN_BigNum *zero = BN_Create(P384_BYTES * 8);
+    ASSERT_TRUE(para != NULL && genericPara != NULL && g != NULL && expect != NULL && r != NULL);
+    ASSERT_TRUE(k != NULL && zero != NULL);
+    P384GenericMethod(&generic, genericPara);
+    genericPara->method = &generic;
+    ASSERT_EQ(TestRandInit(), CRYPT_SUCCESS); // the generic method blinds the point
+
+    if (kType == P384_SCALAR_ZERO) {
+        ASSERT_EQ(BN_Zeroize(k), CRYPT_SUCCESS);
+        ASSERT_EQ(BN_Zeroize(expect->z), CRYPT_SUCCESS);
+    } else if (kType == P384_SCALAR_ONE) {
+        ASSERT_EQ(BN_SetLimb(k, 1), CRYPT_SUCCESS);
+        ASSERT_EQ(ECC_CopyPoint(expect, g), CRYPT_SUCCESS);
+    } else {
+        ASSERT_EQ(BN_SubLimb(k, para->n, 1), CRYPT_SUCCESS);
+        ASSERT_EQ(ECC_CopyPoint(expect, g), CRYPT_SUCCESS);
+        ASSERT_EQ(BN_Sub(expect->y, para->p, g->y), CRYPT_SUCCESS);
+    }
+
+    // Step 1
+    ASSERT_EQ(ECC_PointMul(para, r, k, NULL), CRYPT_SUCCESS);
+    ASSERT_EQ(ECC_PointCmp(para, r, expect), CRYPT_SUCCESS);
+    ASSERT_EQ(ECC_PointMul(para, r, k, g), CRYPT_SUCCESS);
+    ASSERT_EQ(ECC_PointCmp(para, r, expect), CRYPT_SUCCESS);
+    ASSERT_EQ(ECC_PointMulAdd(para, r, k, zero, g), CRYPT_SUCCESS);
+    ASSERT_EQ(ECC_PointCmp(para, r, expect), CRYPT_SUCCESS);
+    ASSERT_EQ(ECC_PointMulAdd(para, r, zero, k, g), CRYPT_SUCCESS);
+    ASSERT_EQ(ECC_PointCmp(para, r, expect), CRYPT_SUCCESS);
+
+    // Step 2
+    ASSERT_EQ(ECC_PointMul(genericPara, r, k, NULL), CRYPT_SUCCESS);
+    ASSERT_EQ(ECC_PointCmp(para, r, expect), CRYPT_SUCCESS);
+EXIT:
+    BN_Destroy(k);
+    BN_Destroy(zero);
+    ECC_FreePoint(g);
+    ECC_FreePoint(expect);
+    ECC_FreePoint(r);
+    ECC_FreePara(para);
+    ECC_FreePara(genericPara);
+    TestRandDeInit();
+#endif
+}
+/* END_CASE */
+
+/**
+ * @test   SDV_CRYPTO_ECC_NISTP384_POINT_ADD_FUNC_TC001
+ * @title  The P-384 k1 * G + k2 * P when the sum adds a point to itself or to its inverse.
+ * @brief
+ *    1. Compute P = s * G, expected result 1.
+ *    2. Compute k1 * G + k2 * P, where k1 = -k2 * s mod n if isInverse is not 0, expected result 2.
+ * @expect
+ *    1. Success.
+ *    2. The result is (k1 + k2 * s) * G, the point at infinity if isInverse is not 0.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_ECC_NISTP384_POINT_ADD_FUNC_TC001(Hex *s, Hex *k1, Hex *k2, int isInverse)
+{
+#if !defined(HITLS_CRYPTO_CURVE_NISTP384) || !defined(HITLS_CRYPTO_NIST_USE_ACCEL)
+    (void)s;
+    (void)k1;
+    (void)k2;
+    (void)isInverse;
+    SKIP_TEST();
+#else
+    TestMemInit();
+    ECC_Para *para = ECC_NewPara(CRYPT_ECC_NISTP384);
+    ECC_Point *pt = ECC_NewPoint(para);
+    ECC_Point *expect = ECC_NewPoint(para);
+    ECC_Point *r = ECC_NewPoint(para);
+    BN_BigNum *bnS = BN_Create(P384_BYTES * 8);
+    BN_BigNum *bnK1 = BN_Create(P384_BYTES * 8);
+    BN_BigNum *bnK2 = BN_Create(P384_BYTES * 8);
+    BN_BigNum *sum = BN_Create(P384_BYTES * 8);
+    BN_Optimizer *opt = BN_OptimizerCreate();
+    ASSERT_TRUE(para != NULL && pt != NULL && expect != NULL && r != NULL && opt != NULL);
+    ASSERT_TRUE(bnS != NULL && bnK1 != NULL && bnK2 != NULL && sum != NULL);
+    ASSERT_EQ(BN_Bin2Bn(bnS, s->x, s->len), CRYPT_SUCCESS);
+    ASSERT_EQ(BN_Bin2Bn(bnK1, k1->x, k1->len), CRYPT_SUCCESS);
+    ASSERT_EQ(BN_Bin2Bn(bnK2, k2->x, k2->len), CRYPT_SUCCESS);
+
+    // Step 1
+    ASSERT_EQ(ECC_PointMul(para, pt, bnS, NULL), CRYPT_SUCCESS);
+
+    // Step 2
+    ASSERT_EQ(BN_ModMul(sum, bnK2, bnS, para->n, opt), CRYPT_SUCCESS);
+    if (isInverse != 0) {
+        ASSERT_EQ(BN_Sub(bnK1, para->n, sum), CRYPT_SUCCESS);
+        ASSERT_EQ(BN_Zeroize(expect->z), CRYPT_SUCCESS);
+    } else {
+        ASSERT_EQ(BN_ModAdd(sum, sum, bnK1, para->n, opt), CRYPT_SUCCESS);
+        ASSERT_EQ(ECC_PointMul(para, expect, sum, NULL), CRYPT_SUCCESS);
+    }
+    ASSERT_EQ(ECC_PointMulAdd(para, r, bnK1, bnK2, pt), CRYPT_SUCCESS);
+    ASSERT_EQ(ECC_PointCmp(para, r, expect), CRYPT_SUCCESS);
+    ASSERT_EQ(BN_IsZero(r->z), isInverse != 0);
+EXIT:
+    BN_Destroy(bnS);
+    BN_Destroy(bnK1);
+    BN_Destroy(bnK2);
+    BN_Destroy(sum);
+    BN_OptimizerDestroy(opt);
+    ECC_FreePoint(pt);
+    ECC_FreePoint(expect);
+    ECC_FreePoint(r);
+    ECC_FreePara(para);
+#endif
+}
+/* END_CASE */
+
+/**
+ * @test   SDV_CRYPTO_ECC_NISTP384_INFINITY_FUNC_TC001
+ * @title  The P-384 method rejects the point at infinity as the generic method does.
+ * @brief
+ *    1. Compute k * O, k * G + k * O and the affine coordinates of O by the P-384 and the generic method,
+ *       expected result 1.
+ * @expect
+ *    1. Both methods return CRYPT_ECC_POINT_AT_INFINITY.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_ECC_NISTP384_INFINITY_FUNC_TC001(void)
+{
+#if !defined(HITLS_CRYPTO_CURVE_NISTP384) || !defined(HITLS_CRYPTO_NIST_USE_ACCEL)
+    SKIP_TEST();
+#else
+    TestMemInit();
+    ECC_Method generic;
+    ECC_Para *para = ECC_NewPara(CRYPT_ECC_NISTP384);
+    ECC_Para *genericPara = ECC_NewPara(CRYPT_ECC_NISTP384);
+    ECC_Point *inf = ECC_NewPoint(para);
+    ECC_Point *r = ECC_NewPoint(para);
+    BN_BigNum *k = BN_Create(P384_BYTES * 8);
+    ASSERT_TRUE(para != NULL && genericPara != NULL && inf != NULL && r != NULL && k != NULL);
+    P384GenericMethod(&generic, genericPara);
+    genericPara->method = &generic;
+    ASSERT_EQ(BN_SetLimb(k, 3), CRYPT_SUCCESS);
+    ASSERT_EQ(BN_Zeroize(inf->z), CRYPT_SUCCESS);
+
+    ASSERT_EQ(ECC_PointMul(para, r, k, inf), CRYPT_ECC_POINT_AT_INFINITY);
+    ASSERT_EQ(ECC_PointMul(genericPara, r, k, inf), CRYPT_ECC_POINT_AT_INFINITY);
+    ASSERT_EQ(ECC_PointMulAdd(para, r, k, k, inf), CRYPT_ECC_POINT_AT_INFINITY);
+    ASSERT_EQ(ECC_PointMulAdd(genericPara, r, k, k, inf), CRYPT_ECC_POINT_AT_INFINITY);
+    ASSERT_EQ(para->method->point2Affine(para, r, inf), CRYPT_ECC_POINT_AT_INFINITY);
+    ASSERT_EQ(genericPara->method->point2Affine(genericPara, r, inf), CRYPT_ECC_POINT_AT_INFINITY);
+EXIT:
+    BN_Destroy(k);
+    ECC_FreePoint(inf);
+    ECC_FreePoint(r);
+    ECC_FreePara(para);
+    ECC_FreePara(genericPara);
+#endif
+}
+/* END_CASE */
+
+/**
+ * @test   SDV_CRYPTO_ECC_NISTP384_CROSS_CHECK_FUNC_TC001
+ * @title  The P-384 method gives the same points as the generic method for random scalars.
+ * @brief
+ *    1. For num rounds, draw the scalars s, k1 and k2 and compute P = s * G, expected result 1.
+ *    2. Compute k1 * G, k1 * P and k1 * G + k2 * P by the P-384 and the generic method, expected result 2.
+ * @expect
+ *    1. Success.
+ *    2. The points are the same.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_ECC_NISTP384_CROSS_CHECK_FUNC_TC001(int seed, int num)
+{
+#if !defined(HITLS_CRYPTO_CURVE_NISTP384) || !defined(HITLS_CRYPTO_NIST_USE_ACCEL)
+    (void)seed;
+    (void)num;
+    SKIP_TEST();
+#else
+    TestMemInit();
+    uint32_t state = (uint32_t)seed;
+    ECC_Method generic;
+    ECC_Para *para = ECC_NewPara(CRYPT_ECC_NISTP384);
+    ECC_Para *genericPara = ECC_NewPara(CRYPT_ECC_NISTP384);
+    ECC_Point *pt = ECC_NewPoint(para);
+    ECC_Point *r = ECC_NewPoint(para);
+    ECC_Point *expect = ECC_NewPoint(para);
+    BN_BigNum *s = BN_Create(P384_BYTES * 8);
+    BN_BigNum *k1 = BN_Create(P384_BYTES * 8);
+    BN_BigNum *k2 = BN_Create(P384_BYTES * 8);
+    BN_Optimizer *opt = BN_OptimizerCreate();
+    ASSERT_TRUE(para != NULL && genericPara != NULL && pt != NULL && r != NULL && expect != NULL);
+    ASSERT_TRUE(s != NULL && k1 != NULL && k2 != NULL && opt != NULL);
+    P384GenericMethod(&generic, genericPara);
+    genericPara->method = &generic;
+    ASSERT_EQ(TestRandInit(), CRYPT_SUCCESS); // the generic method blinds the point
+
+    for (int i = 0; i < num; i++) {
+        // Step 1
+        ASSERT_EQ(P384TestScalar(s, para, &state, opt), CRYPT_SUCCESS);
+        ASSERT_EQ(P384TestScalar(k1, para, &state, opt), CRYPT_SUCCESS);
+        ASSERT_EQ(P384TestScalar(k2, para, &state, opt), CRYPT_SUCCESS);
+        ASSERT_EQ(ECC_PointMul(genericPara, pt, s, NULL), CRYPT_SUCCESS);
+
+        // Step 2
+        ASSERT_EQ(ECC_PointMul(para, r, k1, NULL), CRYPT_SUCCESS);
+        ASSERT_EQ(ECC_PointMul(genericPara, expect, k1, NULL), CRYPT_SUCCESS);
+        ASSERT_EQ(ECC_PointCmp(para, r, expect), CRYPT_SUCCESS);
+        ASSERT_EQ(ECC_PointMul(para, r, k1, pt), CRYPT_SUCCESS);
+        ASSERT_EQ(ECC_PointMul(genericPara, expect, k1, pt), CRYPT_SUCCESS);
+        ASSERT_EQ(ECC_PointCmp(para, r, expect), CRYPT_SUCCESS);
+        ASSERT_EQ(ECC_PointMulAdd(para, r, k1, k2, pt), CRYPT_SUCCESS);
+        ASSERT_EQ(ECC_PointMulAdd(genericPara, expect, k1, k2, pt), CRYPT_SUCCESS);
+        ASSERT_EQ(ECC_PointCmp(para, r, expect), CRYPT_SUCCESS);
+    }
+EXIT:
+    BN_Destroy(s);
+    BN_Destroy(k1);
+    BN_Destroy(k2);
+    BN_OptimizerDestroy(opt);
+    ECC_FreePoint(pt);
+    ECC_FreePoint(r);
+    ECC_FreePoint(expect);
+    ECC_FreePara(para);
+    ECC_FreePara(genericPara);
+    TestRandDeInit();
+#endif
+}
+/* END_CASE */
@@ -27,6 +27,8 @@
 #include "crypt_eal_rand.h"
 #include "crypt_eal_md.h"
 #include "crypt_util_rand.h"
+#include "ml_dsa_local.h"
+#include "stub_replace.h"
 /* END_HEADER */
 
 static uint8_t gMlDsaRandBuf[3][32] = { 0 };
@@ -667,3 +669,199 @@ EXIT:
     TestRandDeInit();
 }
 /* END_CASE */
+
+#if defined(HITLS_CRYPTO_MLDSA_X8664) && defined(__x86_64__)
+static bool STUB_IsSupportAVX2(void)
+{
+    return false;
+}
+
+static uint32_t g_mlDsaTestSeed = 1;
+
+static uint32_t MlDsaTestRand(void)
+{
+    g_mlDsaTestSeed = g_mlDsaTestSeed * 1103515245u + 12345u;
+    return g_mlDsaTestSeed >> 8;
+}
+
+/*
+ * Polynomials for the transforms: random coefficients in (-q, q), then the reduction boundaries, all q - 1, all
+ * -(q - 1), alternating q - 1 and -(q - 1), and the small values around 0.
+ */
+#define MLDSA_TEST_POLY_NUM 5
+#define MLDSA_TEST_PUBKEY_MAX 2592  // The public key of ML-DSA-87
+#define MLDSA_TEST_PRVKEY_MAX 4896  // The private key of ML-DSA-87
+#define MLDSA_TEST_REJ_BYTES (168 * 5)  // Five blocks of SHAKE128, as sampled by RejNTTPoly
+static void MlDsaTestPoly(int32_t *poly, uint32_t kind)
+{
+    static const int32_t small[] = {0, 1, -1, 2, -2};
+    for (uint32_t n = 0; n < MLDSA_N; n++) {
+        switch (kind) {
+            case 0:
+                poly[n] = (int32_t)(MlDsaTestRand() % (2 * MLDSA_Q - 1)) - (MLDSA_Q - 1);
+                break;
+            case 1:
+                poly[n] = MLDSA_Q - 1;
+                break;
+            case 2:
+                poly[n] = 1 - MLDSA_Q;
+                break;
+            case 3:
+                poly[n] = (n % 2 == 0) ? MLDSA_Q - 1 : 1 - MLDSA_Q;
+                break;
+            default:
+                poly[n] = small[n % (sizeof(small) / sizeof(small[0]))];
+                break;
+        }
+    }
+}
+#endif
+
+/* @
+* @test  SDV_CRYPTO_MLDSA_AVX2_FUNC_TC001
+* @spec  -
+* @title The AVX2 kernels give the same results as the scalar code
+* @precon The cpu supports AVX2.
+* @brief
+* 1. Transform random polynomials and polynomials at the reduction boundaries by the AVX2 NTT and inverse NTT, and
+*    again with IsSupportAVX2 stubbed to false.
+* 2. Multiply random and boundary coefficients by the AVX2 kernel, and compare them with MLDSA_MontgomeryReduce.
+* 3. Sample coefficients from random bytes with the candidates q - 1, q, 2^23 - 1 and the ignored top bit planted,
+*    by the AVX2 kernel, and compare them with NIST.FIPS.204 Algorithm 30 RejNTTPoly.
+* 4. Generate a key from a fixed seed and sign a message with a fixed random, and again with IsSupportAVX2 stubbed
+*    to false.
+* @expect 1-4. The results are the same.
+* @prior  nan
+* @auto  FALSE
+@ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_MLDSA_AVX2_FUNC_TC001(int type)
+{
+#if !defined(HITLS_CRYPTO_MLDSA_X8664) || !defined(__x86_64__)
+    (void)type;
+    SKIP_TEST();
+#else
+    if (!MlDsaIsAvx2Enabled()) {
+        SKIP_TEST();
+    }
+    TestMemInit();
+    FuncStubInfo tmpStubInfo = {0};
+    STUB_Init();
+    CRYPT_EAL_PkeyCtx *ctx = NULL;
+    uint8_t *out[2] = {NULL, NULL};
+    uint8_t *pub[2] = {NULL, NULL};
+    uint8_t *prv[2] = {NULL, NULL};
+    int32_t a[MLDSA_N];
+    int32_t b[MLDSA_N];
+    int32_t t[MLDSA_N];
+    g_mlDsaTestSeed = (uint32_t)type;
+
+    // Step 1
+    for (uint32_t kind = 0; kind < MLDSA_TEST_POLY_NUM; kind++) {
+        MlDsaTestPoly(a, kind);
+        (void)memcpy_s(b, sizeof(b), a, sizeof(a));
+        MLDSA_ComputesNTT(a);
+        STUB_Replace(&tmpStubInfo, IsSupportAVX2, STUB_IsSupportAVX2);
+        MLDSA_ComputesNTT(b);
+        STUB_Reset(&tmpStubInfo);
+        ASSERT_COMPARE("ntt", a, sizeof(a), b, sizeof(b));
+
+        MlDsaTestPoly(a, kind);
+        (void)memcpy_s(b, sizeof(b), a, sizeof(a));
+        MLDSA_ComputesINVNTT(a);
+        STUB_Replace(&tmpStubInfo, IsSupportAVX2, STUB_IsSupportAVX2);
+        MLDSA_ComputesINVNTT(b);
+        STUB_Reset(&tmpStubInfo);
+        ASSERT_COMPARE("inverse ntt", a, sizeof(a), b, sizeof(b));
+    }
+
+    // Step 2
+    for (uint32_t kind = 0; kind < MLDSA_TEST_POLY_NUM; kind++) {
+        MlDsaTestPoly(a, kind);
+        MlDsaTestPoly(b, (kind + 1) % MLDSA_TEST_POLY_NUM);
+        MLDSA_VectorsMulAvx2(t, a, b);
+        for (uint32_t n = 0; n < MLDSA_N; n++) {
+            a[n] = MLDSA_MontgomeryReduce((int64_t)a[n] * b[n]);
+        }
+        ASSERT_COMPARE("vectors multiply", t, sizeof(t), a, sizeof(a));
+    }
+
+    // Step 3
+    static const uint8_t planted[][3] = {
+        {0x00, 0xe0, 0x7f}, {0x01, 0xe0, 0x7f}, {0xff, 0xff, 0xff}, {0x00, 0xe0, 0xff}, {0x00, 0x00, 0x80}
+    };
+    uint8_t buf[MLDSA_TEST_REJ_BYTES];
+    for (uint32_t i = 0; i < sizeof(buf); i++) {
+        buf[i] = (uint8_t)(MlDsaTestRand() >> 8);
+    }
+    for (uint32_t i = 0; i + 3 <= sizeof(buf); i += 3 * 7) {  // Every 7th candidate is a boundary one.
+        (void)memcpy_s(buf + i, 3, planted[(i / 21) % (sizeof(planted) / sizeof(planted[0]))], 3);
+    }
+    for (uint32_t ctr = 0; ctr < MLDSA_N; ctr += 100) {
+        uint32_t pos = 0;
+        uint32_t num = MLDSA_RejUniformAvx2(a, ctr, buf, sizeof(buf), &pos);
+        ASSERT_TRUE(num > ctr && num <= MLDSA_N && pos <= sizeof(buf));
+        uint32_t j = ctr;
+        for (uint32_t i = 0; i + 3 <= pos && j < MLDSA_N; i += 3) {
+            int32_t d = (int32_t)buf[i] | ((int32_t)buf[i + 1] << 8) | ((int32_t)(buf[i + 2] & 0x7f) << 16);
+            if (d < MLDSA_Q) {
+                b[j++] = d;
+            }
+        }
+        ASSERT_EQ(j, num);
+        ASSERT_COMPARE("rejection sampling", a + ctr, (num - ctr) * sizeof(int32_t), b + ctr,
+            (num - ctr) * sizeof(int32_t));
+    }
+
+    // Step 4
+    for (uint32_t i = 0; i < sizeof(gMlDsaRandBuf); i++) {
+        gMlDsaRandBuf[i / 32][i % 32] = (uint8_t)(MlDsaTestRand() >> 8);
+    }
+    CRYPT_RandRegist(TEST_MLDSARandom);
+    CRYPT_RandRegistEx(TEST_MLDSARandomEx);
+    uint8_t msg[32] = {0};
+    uint32_t outLen[2];
+    CRYPT_EAL_PkeyPub pubKey = {.id = CRYPT_PKEY_ML_DSA};
+    CRYPT_EAL_PkeyPrv prvKey = {.id = CRYPT_PKEY_ML_DSA};
+    for (uint32_t i = 0; i < 2; i++) {
+        gMlDsaRandNum = 0;
+        ctx = CRYPT_EAL_PkeyNewCtx(CRYPT_PKEY_ML_DSA);
+        ASSERT_TRUE(ctx != NULL);
+        ASSERT_EQ(CRYPT_EAL_PkeySetParaById(ctx, (uint32_t)type), CRYPT_SUCCESS);
+        outLen[i] = CRYPT_EAL_PkeyGetSignLen(ctx);
+        out[i] = BSL_SAL_Malloc(outLen[i]);
+        pub[i] = BSL_SAL_Malloc(MLDSA_TEST_PUBKEY_MAX);
+        prv[i] = BSL_SAL_Malloc(MLDSA_TEST_PRVKEY_MAX);
+        ASSERT_TRUE(out[i] != NULL && pub[i] != NULL && prv[i] != NULL);
+        if (i == 1) {
+            STUB_Replace(&tmpStubInfo, IsSupportAVX2, STUB_IsSupportAVX2);
+        }
+        ASSERT_EQ(CRYPT_EAL_PkeyGen(ctx), CRYPT_SUCCESS);
+        ASSERT_EQ(CRYPT_EAL_PkeySign(ctx, CRYPT_MD_MAX, msg, sizeof(msg), out[i], &outLen[i]), CRYPT_SUCCESS);
+        STUB_Reset(&tmpStubInfo);
+        pubKey.key.mldsaPub.data = pub[i];
+        pubKey.key.mldsaPub.len = MLDSA_TEST_PUBKEY_MAX;
+        ASSERT_EQ(CRYPT_EAL_PkeyGetPub(ctx, &pubKey), CRYPT_SUCCESS);
+        prvKey.key.mldsaPrv.data = prv[i];
+        prvKey.key.mldsaPrv.len = MLDSA_TEST_PRVKEY_MAX;
+        ASSERT_EQ(CRYPT_EAL_PkeyGetPrv(ctx, &prvKey), CRYPT_SUCCESS);
+        CRYPT_EAL_PkeyFreeCtx(ctx);
+        ctx = NULL;
+    }
+    ASSERT_COMPARE("pubkey", pub[0], pubKey.key.mldsaPub.len, pub[1], pubKey.key.mldsaPub.len);
+    ASSERT_COMPARE("prvkey", prv[0], prvKey.key.mldsaPrv.len, prv[1], prvKey.key.mldsaPrv.len);
+    ASSERT_COMPARE("sign", out[0], outLen[0], out[1], outLen[1]);
+EXIT:
+    STUB_Reset(&tmpStubInfo);
+    CRYPT_EAL_PkeyFreeCtx(ctx);
+    for (uint32_t i = 0; i < 2; i++) {
+        BSL_SAL_FREE(out[i]);
+        BSL_SAL_FREE(pub[i]);
+        BSL_SAL_FREE(prv[i]);
+    }
+    CRYPT_RandRegist(NULL);
+    CRYPT_RandRegistEx(NULL);
+    return;
+#endif
+}
+/* END_CASE */
@@ -19,6 +19,8 @@
 #include "crypt_eal_pkey.h"
 #include "crypt_util_rand.h"
 #include "eal_pkey_local.h"
+#include "ml_kem_local.h"
+#include "stub_replace.h"
 #include "securec.h"
 /* END_HEADER */
 
@@ -988,3 +990,281 @@ EXIT:
     return;
 }
 /* END_CASE */
+
+/* @
+* @test  SDV_CRYPTO_MLKEM_CACHE_MATRIX_FUNC_TC001
+* @spec  -
+* @title  Vector test for encapsulation and decapsulation with the matrix cached in the context
+* @precon nan
+* @brief
+* 1. Set the cache matrix flag with an invalid length.
+* 2. Set the cache matrix flag, then set the encapsulation key and call CRYPT_EAL_PkeyEncaps.
+* 3. Set the decapsulation key and call CRYPT_EAL_PkeyDecaps.
+* 4. Duplicate the context and call CRYPT_EAL_PkeyDecaps with the duplicated context.
+* 5. Set the cache matrix flag again after the key is set, and call CRYPT_EAL_PkeyEncaps.
+* 6. Generate a new key pair, then encapsulate and decapsulate with it.
+* @expect 1. CRYPT_INVALID_ARG 2-4. The results are the same as the test vector 5. The results are the same as
+*         the test vector 6. The shared keys are the same
+* @prior  nan
+* @auto  FALSE
+@ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_MLKEM_CACHE_MATRIX_FUNC_TC001(int bits, Hex *m, Hex *testEK, Hex *testDK, Hex *testCT, Hex *testSK)
+{
+    TestMemInit();
+    gKyberRandNum = 0;
+    memcpy_s(gKyberRandBuf[0], 32, m->x, m->len);
+    memcpy_s(gKyberRandBuf[1], 32, m->x, m->len);
+    CRYPT_RandRegist(TEST_KyberRandom);
+    CRYPT_RandRegistEx(TEST_KyberRandomEx);
+
+    uint8_t ciphertext[1568];  // 1568 is the max ciphertext length
+    uint8_t sharedKey[32];
+    uint8_t decSharedKey[32];
+    uint32_t cipherLen = sizeof(ciphertext);
+    uint32_t sharedLen = sizeof(sharedKey);
+    uint32_t decSharedLen = sizeof(decSharedKey);
+    int32_t flag = 1;
+    CRYPT_EAL_PkeyCtx *dupCtx = NULL;
+    CRYPT_EAL_PkeyCtx *ctx = CRYPT_EAL_PkeyNewCtx(CRYPT_PKEY_ML_KEM);
+    ASSERT_NE(ctx, NULL);
+    ASSERT_EQ(CRYPT_EAL_PkeySetParaById(ctx, (uint32_t)bits), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_SET_MLKEM_CACHE_MATRIX_FLAG, &flag, sizeof(flag) - 1),
+        CRYPT_INVALID_ARG);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_SET_MLKEM_CACHE_MATRIX_FLAG, &flag, sizeof(flag)), CRYPT_SUCCESS);
+
+    CRYPT_EAL_PkeyPub ek = { 0 };
+    ek.id = CRYPT_PKEY_ML_KEM;
+    ek.key.kemEk.len = testEK->len;
+    ek.key.kemEk.data = testEK->x;
+    CRYPT_EAL_PkeyPrv dk = { 0 };
+    dk.id = CRYPT_PKEY_ML_KEM;
+    dk.key.kemDk.len = testDK->len;
+    dk.key.kemDk.data = testDK->x;
+
+    ASSERT_EQ(CRYPT_EAL_PkeySetPub(ctx, &ek), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyEncaps(ctx, ciphertext, &cipherLen, sharedKey, &sharedLen), CRYPT_SUCCESS);
+    ASSERT_COMPARE("compare ct", ciphertext, cipherLen, testCT->x, testCT->len);
+    ASSERT_COMPARE("compare sk", sharedKey, sharedLen, testSK->x, testSK->len);
+
+    ASSERT_EQ(CRYPT_EAL_PkeySetPrv(ctx, &dk), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyDecaps(ctx, testCT->x, testCT->len, decSharedKey, &decSharedLen), CRYPT_SUCCESS);
+    ASSERT_COMPARE("compare dec sk", decSharedKey, decSharedLen, testSK->x, testSK->len);
+
+    dupCtx = CRYPT_EAL_PkeyDupCtx(ctx);
+    ASSERT_NE(dupCtx, NULL);
+    decSharedLen = sizeof(decSharedKey);
+    ASSERT_EQ(CRYPT_EAL_PkeyDecaps(dupCtx, testCT->x, testCT->len, decSharedKey, &decSharedLen), CRYPT_SUCCESS);
+    ASSERT_COMPARE("compare dup dec sk", decSharedKey, decSharedLen, testSK->x, testSK->len);
+
+    flag = 0;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_SET_MLKEM_CACHE_MATRIX_FLAG, &flag, sizeof(flag)), CRYPT_SUCCESS);
+    flag = 1;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_SET_MLKEM_CACHE_MATRIX_FLAG, &flag, sizeof(flag)), CRYPT_SUCCESS);
+    cipherLen = sizeof(ciphertext);
+    sharedLen = sizeof(sharedKey);
+    ASSERT_EQ(CRYPT_EAL_PkeyEncaps(ctx, ciphertext, &cipherLen, sharedKey, &sharedLen), CRYPT_SUCCESS);
+    ASSERT_COMPARE("compare ct again", ciphertext, cipherLen, testCT->x, testCT->len);
+    ASSERT_COMPARE("compare sk again", sharedKey, sharedLen, testSK->x, testSK->len);
+
+    CRYPT_RandRegist(NULL);
+    CRYPT_RandRegistEx(NULL);
+    TestRandInit();
+    ASSERT_EQ(CRYPT_EAL_PkeyGen(ctx), CRYPT_SUCCESS);
+    cipherLen = sizeof(ciphertext);
+    sharedLen = sizeof(sharedKey);
+    decSharedLen = sizeof(decSharedKey);
+    ASSERT_EQ(CRYPT_EAL_PkeyEncaps(ctx, ciphertext, &cipherLen, sharedKey, &sharedLen), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyDecaps(ctx, ciphertext, cipherLen, decSharedKey, &decSharedLen), CRYPT_SUCCESS);
+    ASSERT_COMPARE("compare new key sk", sharedKey, sharedLen, decSharedKey, decSharedLen);
+EXIT:
+    CRYPT_EAL_PkeyFreeCtx(ctx);
+    CRYPT_EAL_PkeyFreeCtx(dupCtx);
+    CRYPT_RandRegist(NULL);
+    CRYPT_RandRegistEx(NULL);
+    TestRandDeInit();
+    return;
+}
+/* END_CASE */
+
+#if defined(HITLS_CRYPTO_MLKEM_X8664) && defined(__x86_64__)
+static bool STUB_IsSupportAVX2(void)
+{
+    return false;
+}
+
+static uint32_t g_mlKemTestSeed = 1;
+
+// Values in [lower, lower + range) from a fixed linear congruential sequence.
+static void MlKemTestRandPoly(int16_t *poly, int32_t lower, uint32_t range)
+{
+    for (uint32_t n = 0; n < MLKEM_N; n++) {
+        g_mlKemTestSeed = g_mlKemTestSeed * 1103515245u + 12345u;
+        poly[n] = (int16_t)(lower + (int32_t)((g_mlKemTestSeed >> 8) % range));
+    }
+}
+
+// psi[i] = 17^BitRev7(i) and psiInv[i] = psi[i]^(-1) mod MLKEM_Q, the tables of NIST.FIPS.203 Appendix A.
+static void MlKemTestZetas(int16_t psi[MLKEM_N_HALF], int16_t psiInv[MLKEM_N_HALF])
+{
+    for (uint32_t i = 0; i < MLKEM_N_HALF; i++) {
+        uint32_t rev = 0;
+        for (uint32_t b = 0; b < 7; b++) {
+            rev |= ((i >> b) & 1) << (6 - b);
+        }
+        uint32_t z = 1;
+        for (uint32_t e = 0; e < rev; e++) {
+            z = z * 17 % MLKEM_Q;
+        }
+        psi[i] = (int16_t)z;
+        uint32_t inv = 1;
+        for (uint32_t e = 0; e < MLKEM_Q - 2; e++) {
+            inv = inv * z % MLKEM_Q;
+        }
+        psiInv[i] = (int16_t)inv;
+    }
+}
+
+static void MlKemTestCanonical(int16_t *poly)
+{
+    for (uint32_t n = 0; n < MLKEM_N; n++) {
+        poly[n] = (int16_t)(((poly[n] % MLKEM_Q) + MLKEM_Q) % MLKEM_Q);
+    }
+}
+#endif
+
+/* @
+* @test  SDV_CRYPTO_MLKEM_AVX2_FUNC_TC001
+* @spec  -
+* @title The AVX2 kernels give the same results as the scalar code
+* @precon The cpu supports AVX2.
+* @brief
+* 1. Transform random polynomials by the AVX2 NTT and inverse NTT, and again with IsSupportAVX2 stubbed to false.
+* 2. Multiply and accumulate k random polynomials in the same way, with and without the error polynomial.
+* 3. Compress all coefficients in (-q, 2q) and decompress all values in [0, 2^d) by the AVX2 kernels, and compare
+*    them with Compress_d and Decompress_d of NIST.FIPS.203.
+* 4. Sample a polynomial from random bytes by the AVX2 parser, and compare it with the rejection sampling of
+*    NIST.FIPS.203 Algorithm 7.
+* @expect 1-4. The results are the same modulo q.
+* @prior  nan
+* @auto  FALSE
+@ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_MLKEM_AVX2_FUNC_TC001(int k)
+{
+#if !defined(HITLS_CRYPTO_MLKEM_X8664) || !defined(__x86_64__)
+    (void)k;
+    SKIP_TEST();
+#else
+    if (!MlKemIsAvx2Enabled()) {
+        SKIP_TEST();
+    }
+    FuncStubInfo tmpStubInfo = {0};
+    STUB_Init();
+    int16_t psi[MLKEM_N_HALF];
+    int16_t psiInv[MLKEM_N_HALF];
+    int16_t a[MLKEM_N];
+    int16_t b[MLKEM_N];
+    int16_t buf[2 * MLKEM_N * 4 + MLKEM_N];
+    int16_t *matrix[4];
+    int16_t *vectorS[4];
+    int16_t *vectorE = buf + 2 * MLKEM_N * 4;
+    MlKemTestZetas(psi, psiInv);
+    g_mlKemTestSeed = (uint32_t)k;
+    for (int32_t i = 0; i < k; i++) {
+        matrix[i] = buf + MLKEM_N * i;
+        vectorS[i] = buf + MLKEM_N * (4 + i);
+        MlKemTestRandPoly(matrix[i], 0, MLKEM_Q);
+        MlKemTestRandPoly(vectorS[i], 0, MLKEM_Q);
+    }
+    MlKemTestRandPoly(vectorE, 0, MLKEM_Q);
+
+    // Step 1
+    MlKemTestRandPoly(a, 1 - MLKEM_Q, 2 * MLKEM_Q - 1);
+    (void)memcpy_s(b, sizeof(b), a, sizeof(a));
+    MLKEM_ComputNTT(a, psi, MLKEM_N_HALF);
+    STUB_Replace(&tmpStubInfo, IsSupportAVX2, STUB_IsSupportAVX2);
+    MLKEM_ComputNTT(b, psi, MLKEM_N_HALF);
+    STUB_Reset(&tmpStubInfo);
+    MlKemTestCanonical(a);
+    MlKemTestCanonical(b);
+    ASSERT_COMPARE("ntt", a, sizeof(a), b, sizeof(b));
+
+    MlKemTestRandPoly(a, 1 - MLKEM_Q, 2 * MLKEM_Q - 1);
+    (void)memcpy_s(b, sizeof(b), a, sizeof(a));
+    MLKEM_ComputINTT(a, psiInv, MLKEM_N_HALF);
+    STUB_Replace(&tmpStubInfo, IsSupportAVX2, STUB_IsSupportAVX2);
+    MLKEM_ComputINTT(b, psiInv, MLKEM_N_HALF);
+    STUB_Reset(&tmpStubInfo);
+    MlKemTestCanonical(a);
+    MlKemTestCanonical(b);
+    ASSERT_COMPARE("inverse ntt", a, sizeof(a), b, sizeof(b));
+
+    // Step 2
+    for (int32_t withE = 0; withE < 2; withE++) {
+        MLKEM_MatrixMulAdd((uint8_t)k, matrix, vectorS, withE ? vectorE : NULL, a, psi);
+        STUB_Replace(&tmpStubInfo, IsSupportAVX2, STUB_IsSupportAVX2);
+        MLKEM_MatrixMulAdd((uint8_t)k, matrix, vectorS, withE ? vectorE : NULL, b, psi);
+        STUB_Reset(&tmpStubInfo);
+        MlKemTestCanonical(a);
+        MlKemTestCanonical(b);
+        ASSERT_COMPARE("matrix multiply add", a, sizeof(a), b, sizeof(b));
+    }
+
+    // Step 3
+    static const uint8_t bits[] = {1, 4, 5, 10, 11};
+    for (uint32_t t = 0; t < sizeof(bits); t++) {
+        uint32_t d = bits[t];
+        for (int32_t x = 1 - MLKEM_Q; x < 2 * MLKEM_Q; x += MLKEM_N) {
+            for (uint32_t n = 0; n < MLKEM_N; n++) {
+                a[n] = (int16_t)((x + (int32_t)n < 2 * MLKEM_Q) ? x + (int32_t)n : 0);
+            }
+            MLKEM_CompressAvx2(a, (uint8_t)d);
+            for (uint32_t n = 0; n < MLKEM_N; n++) {
+                uint32_t v = (uint32_t)((((x + (int32_t)n < 2 * MLKEM_Q) ? x + (int32_t)n : 0) + MLKEM_Q) % MLKEM_Q);
+                // round(2^d * v / q) mod 2^d
+                b[n] = (int16_t)((((v << (d + 1)) + MLKEM_Q) / (2 * MLKEM_Q)) & ((1u << d) - 1));
+            }
+            ASSERT_COMPARE("compress", a, sizeof(a), b, sizeof(b));
+        }
+        for (uint32_t y = 0; y < (1u << d); y += MLKEM_N) {
+            for (uint32_t n = 0; n < MLKEM_N; n++) {
+                a[n] = (int16_t)((y + n) & ((1u << d) - 1));
+                // round(q * y / 2^d)
+                b[n] = (int16_t)(((uint32_t)a[n] * MLKEM_Q + (1u << (d - 1))) >> d);
+            }
+            MLKEM_DeCompressAvx2(a, (uint8_t)d);
+            ASSERT_COMPARE("decompress", a, sizeof(a), b, sizeof(b));
+        }
+    }
+
+    // Step 4
+    uint8_t arrayB[MLKEM_XOF_OUTPUT_LENGTH];
+    uint16_t parsed[MLKEM_N];
+    uint32_t pos = 0;
+    for (uint32_t i = 0; i < sizeof(arrayB); i++) {
+        g_mlKemTestSeed = g_mlKemTestSeed * 1103515245u + 12345u;
+        arrayB[i] = (uint8_t)(g_mlKemTestSeed >> 16);
+    }
+    uint32_t num = MLKEM_ParseAvx2(parsed, arrayB, sizeof(arrayB), MLKEM_N, &pos);
+    ASSERT_TRUE(num > 0 && num <= MLKEM_N);
+    uint16_t expect[MLKEM_N + 1];
+    uint32_t j = 0;
+    for (uint32_t i = 0; i + 3 <= pos && j < MLKEM_N; i += 3) {  // 3 bytes give 2 candidates.
+        uint16_t d1 = (uint16_t)(arrayB[i] | ((arrayB[i + 1] & 0x0f) << 8));
+        uint16_t d2 = (uint16_t)((arrayB[i + 1] >> 4) | (arrayB[i + 2] << 4));
+        if (d1 < MLKEM_Q) {
+            expect[j++] = d1;
+        }
+        if (d2 < MLKEM_Q) {
+            expect[j++] = d2;
+        }
+    }
+    ASSERT_EQ(j, num);
+    ASSERT_COMPARE("parse", parsed, num * sizeof(uint16_t), expect, num * sizeof(uint16_t));
+EXIT:
+    STUB_Reset(&tmpStubInfo);
+    return;
+#endif
+}
+/* END_CASE */
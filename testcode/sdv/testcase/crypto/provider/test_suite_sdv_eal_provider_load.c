@@ -400,6 +400,75 @@ EXIT:
 }
 /* END_CASE */
 
+/**
+ * @test SDV_CRYPTO_PROVIDER_LOAD_CACHE_TC001
+ * @title Test that resolved provider methods are cached and refreshed when providers change
+ * @precon None
+ * @brief
+ *    1. Load test1 and look up the same query twice, once with a copy of the attribute string
+ *    2. Load test2, which matches the query better, and look up the query again
+ *    3. Unload test2 and look up the query again
+ * @expect
+ *    1. Both lookups return the funcs of test1
+ *    2. The funcs of test2 are returned
+ *    3. The funcs of test1 are returned, and test2 can no longer be found
+ * @prior Level 1
+ * @auto TRUE
+ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_PROVIDER_LOAD_CACHE_TC001(char *path, char *test1, char *test2, int cmd, char *attribute,
+    int result1, int result2)
+{
+#ifndef HITLS_CRYPTO_PROVIDER
+    (void)path;
+    (void)test1;
+    (void)test2;
+    (void)cmd;
+    (void)attribute;
+    (void)result1;
+    (void)result2;
+    SKIP_TEST();
+#else
+    CRYPT_EAL_LibCtx *libCtx = NULL;
+    char attrCopy[64] = {0};
+    const CRYPT_EAL_Func *funcs = NULL;
+    const CRYPT_EAL_Func *cachedFuncs = NULL;
+    void *provCtx = NULL;
+    ASSERT_EQ(strcpy_s(attrCopy, sizeof(attrCopy), attribute), EOK);
+
+    libCtx = CRYPT_EAL_LibCtxNew();
+    ASSERT_TRUE(libCtx != NULL);
+    ASSERT_EQ(CRYPT_EAL_ProviderSetLoadPath(libCtx, path), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_ProviderLoad(libCtx, cmd, test1, NULL, NULL), CRYPT_SUCCESS);
+
+    ASSERT_EQ(CRYPT_EAL_ProviderGetFuncs(libCtx, CRYPT_EAL_OPERAID_HASH, CRYPT_MD_MD5, attribute, &funcs, &provCtx),
+        CRYPT_SUCCESS);
+    ASSERT_EQ(((CRYPT_EAL_ImplMdInitCtx)(funcs[1].func))(provCtx, NULL), result1);
+    ASSERT_EQ(CRYPT_EAL_ProviderGetFuncs(libCtx, CRYPT_EAL_OPERAID_HASH, CRYPT_MD_MD5, attrCopy, &cachedFuncs,
+        &provCtx), CRYPT_SUCCESS);
+    ASSERT_TRUE(cachedFuncs == funcs);
+
+    ASSERT_EQ(CRYPT_EAL_ProviderLoad(libCtx, cmd, test2, NULL, NULL), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_ProviderGetFuncs(libCtx, CRYPT_EAL_OPERAID_HASH, CRYPT_MD_MD5, attribute, &funcs, &provCtx),
+        CRYPT_SUCCESS);
+    ASSERT_EQ(((CRYPT_EAL_ImplMdInitCtx)(funcs[1].func))(provCtx, NULL), result2);
+    ASSERT_EQ(CRYPT_EAL_ProviderGetFuncs(libCtx, CRYPT_EAL_OPERAID_HASH, CRYPT_MD_MD5, "provider=test2", &funcs,
+        &provCtx), CRYPT_SUCCESS);
+
+    ASSERT_EQ(CRYPT_EAL_ProviderUnload(libCtx, cmd, test2), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_ProviderGetFuncs(libCtx, CRYPT_EAL_OPERAID_HASH, CRYPT_MD_MD5, attribute, &funcs, &provCtx),
+        CRYPT_SUCCESS);
+    ASSERT_EQ(((CRYPT_EAL_ImplMdInitCtx)(funcs[1].func))(provCtx, NULL), result1);
+    ASSERT_EQ(CRYPT_EAL_ProviderGetFuncs(libCtx, CRYPT_EAL_OPERAID_HASH, CRYPT_MD_MD5, "provider=test2", &funcs,
+        &provCtx), CRYPT_NOT_SUPPORT);
+
+EXIT:
+    CRYPT_EAL_LibCtxFree(libCtx);
+    return;
+#endif
+}
+/* END_CASE */
+
 /**
  * @test SDV_CRYPTO_PROVIDER_LOAD_UNINSTALL_TC001
  * @title Test whether the external interface of each algorithm reports an error
@@ -330,6 +330,61 @@ EXIT:
 }
 /* END_CASE */
 
+/**
+ * @test   SDV_CRYPT_EAL_KDF_SCRYPT_THREAD_FUNC_TC001
+ * @title  scrypt with the p lanes spread over several threads.
+ * @precon nan
+ * @brief
+ *    1.Set an invalid number of threads, expected result 1.
+ *    2.Set the number of threads and calculate the output result, expected result 2.
+ *    3.Compare the calculated result with the standard value, expected result 3.
+ * @expect
+ *    1.CRYPT_SCRYPT_PARAM_ERROR
+ *    2.Calculation succeeded.
+ *    3.The results are the same.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPT_EAL_KDF_SCRYPT_THREAD_FUNC_TC001(Hex *key, Hex *salt, int N, int r, int p, int threadNum, Hex *result)
+{
+    TestMemInit();
+    uint32_t outLen = result->len;
+    uint32_t badNum = 0;
+    uint8_t *out = malloc(outLen * sizeof(uint8_t));
+    ASSERT_TRUE(out != NULL);
+
+    CRYPT_EAL_KdfCTX *ctx = CRYPT_EAL_KdfNewCtx(CRYPT_KDF_SCRYPT);
+    ASSERT_TRUE(ctx != NULL);
+    BSL_Param badParams[2] = {{0}, BSL_PARAM_END};
+    ASSERT_EQ(BSL_PARAM_InitValue(&badParams[0], CRYPT_PARAM_KDF_THREAD_NUM, BSL_PARAM_TYPE_UINT32,
+        &badNum, sizeof(badNum)), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_KdfSetParam(ctx, badParams), CRYPT_SCRYPT_PARAM_ERROR);
+    badNum = 17; // more than the 16 threads supported
+    ASSERT_EQ(CRYPT_EAL_KdfSetParam(ctx, badParams), CRYPT_SCRYPT_PARAM_ERROR);
+
+    BSL_Param params[7] = {{0}, {0}, {0}, {0}, {0}, {0}, BSL_PARAM_END};
+    ASSERT_EQ(BSL_PARAM_InitValue(&params[0], CRYPT_PARAM_KDF_PASSWORD, BSL_PARAM_TYPE_OCTETS,
+        key->x, key->len), CRYPT_SUCCESS);
+    ASSERT_EQ(BSL_PARAM_InitValue(&params[1], CRYPT_PARAM_KDF_SALT, BSL_PARAM_TYPE_OCTETS,
+        salt->x, salt->len), CRYPT_SUCCESS);
+    ASSERT_EQ(BSL_PARAM_InitValue(&params[2], CRYPT_PARAM_KDF_N, BSL_PARAM_TYPE_UINT32,
+        &N, sizeof(N)), CRYPT_SUCCESS);
+    ASSERT_EQ(BSL_PARAM_InitValue(&params[3], CRYPT_PARAM_KDF_R, BSL_PARAM_TYPE_UINT32,
+        &r, sizeof(r)), CRYPT_SUCCESS);
+    ASSERT_EQ(BSL_PARAM_InitValue(&params[4], CRYPT_PARAM_KDF_P, BSL_PARAM_TYPE_UINT32,
+        &p, sizeof(p)), CRYPT_SUCCESS);
+    ASSERT_EQ(BSL_PARAM_InitValue(&params[5], CRYPT_PARAM_KDF_THREAD_NUM, BSL_PARAM_TYPE_UINT32,
+        &threadNum, sizeof(threadNum)), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_KdfSetParam(ctx, params), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_KdfDerive(ctx, out, outLen), CRYPT_SUCCESS);
+    ASSERT_COMPARE("result cmp", out, outLen, result->x, result->len);
+EXIT:
+    if (out != NULL) {
+        free(out);
+    }
+    CRYPT_EAL_KdfFreeCtx(ctx);
+}
+/* END_CASE */
+
 /**
  * @test   SDV_CRYPTO_SCRYPT_DEFAULT_PROVIDER_FUNC_TC001
  * @title  Default provider testing
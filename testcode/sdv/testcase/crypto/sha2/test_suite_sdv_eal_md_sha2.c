@@ -20,6 +20,9 @@
 #include "crypt_eal_md.h"
 #include "crypt_errno.h"
 #include "bsl_sal.h"
+#include "crypt_sha2.h"
+#include "crypt_utils.h"
+#include "stub_replace.h"
 /* END_HEADER */
 
 // 100 is greater than the digest length of all SHA algorithms.
@@ -489,3 +492,79 @@ EXIT:
     CRYPT_EAL_MdFreeCtx(ctx);
 }
 /* END_CASE */
+
+#if defined(__x86_64__) && defined(HITLS_CRYPTO_EALINIT)
+static bool STUB_IsSupportAVX2(void)
+{
+    return false;
+}
+#endif
+
+/**
+ * @test   SDV_CRYPTO_SHA2_256_BATCH_FUNC_TC001
+ * @title  The parallel SHA256 gives the same results as SHA256 of every input.
+ * @precon nan
+ * @brief
+ *    1. Absorb prefixLen bytes into a SHA256 context if prefixLen is not 0, expected result 1.
+ *    2. Hash nine different inputs of inLen bytes after the prefix by CRYPT_SHA2_256_Batch, expected result 2.
+ *    3. Compare the outputs with CRYPT_EAL_Md of the prefix and every input, expected result 3.
+ *    4. On x86-64, stub IsSupportAVX2 to return false and repeat steps 2 and 3 with the generic eight-way kernel.
+ * @expect
+ *    1. CRYPT_SUCCESS
+ *    2. CRYPT_SUCCESS
+ *    3. The first outLen bytes are the same.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_SHA2_256_BATCH_FUNC_TC001(int prefixLen, int inLen, int outLen)
+{
+    TestMemInit();
+    FuncStubInfo tmpStubInfo = {0};
+    STUB_Init();
+    const uint32_t num = CRYPT_SHA2_256_X8_LANES + 1;
+    uint8_t *inBuf = malloc(prefixLen + num * inLen + 1);
+    uint8_t *outBuf = malloc(num * outLen + 1);
+    uint8_t *msg = malloc(prefixLen + inLen + 1);
+    CRYPT_SHA2_256_Ctx *prefix = NULL;
+    ASSERT_TRUE(inBuf != NULL && outBuf != NULL && msg != NULL);
+    const uint8_t *in[CRYPT_SHA2_256_X8_LANES + 1];
+    uint8_t *out[CRYPT_SHA2_256_X8_LANES + 1];
+    for (uint32_t i = 0; i < prefixLen + num * inLen; i++) {
+        inBuf[i] = (uint8_t)(i * 7 + 1);
+    }
+    for (uint32_t j = 0; j < num; j++) {
+        in[j] = inBuf + prefixLen + j * inLen;
+        out[j] = outBuf + j * outLen;
+    }
+    if (prefixLen != 0) {
+        prefix = CRYPT_SHA2_256_NewCtx();
+        ASSERT_TRUE(prefix != NULL);
+        ASSERT_EQ(CRYPT_SHA2_256_Init(prefix, NULL), CRYPT_SUCCESS);
+        ASSERT_EQ(CRYPT_SHA2_256_Update(prefix, inBuf, prefixLen), CRYPT_SUCCESS);
+    }
+    for (uint32_t pass = 0; pass < 2; pass++) {
+#if defined(__x86_64__) && defined(HITLS_CRYPTO_EALINIT)
+        if (pass == 1) {
+            STUB_Replace(&tmpStubInfo, IsSupportAVX2, STUB_IsSupportAVX2);
+        }
+#endif
+        (void)memset(outBuf, 0, num * outLen);
+        ASSERT_EQ(CRYPT_SHA2_256_Batch(prefix, in, inLen, out, outLen, num), CRYPT_SUCCESS);
+        STUB_Reset(&tmpStubInfo);
+
+        for (uint32_t j = 0; j < num; j++) {
+            uint8_t expect[CRYPT_SHA2_256_DIGESTSIZE];
+            uint32_t expectLen = sizeof(expect);
+            (void)memcpy(msg, inBuf, prefixLen);
+            (void)memcpy(msg + prefixLen, in[j], inLen);
+            ASSERT_EQ(CRYPT_EAL_Md(CRYPT_MD_SHA256, msg, prefixLen + inLen, expect, &expectLen), CRYPT_SUCCESS);
+            ASSERT_COMPARE("batch", out[j], outLen, expect, outLen);
+        }
+    }
+EXIT:
+    STUB_Reset(&tmpStubInfo);
+    CRYPT_SHA2_256_FreeCtx(prefix);
+    free(inBuf);
+    free(outBuf);
+    free(msg);
+}
+/* END_CASE */
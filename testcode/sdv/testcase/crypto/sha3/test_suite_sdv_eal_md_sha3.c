@@ -22,6 +22,8 @@
 #include "crypt_algid.h"
 #include "crypt_errno.h"
 #include "crypt_sha3.h"
+#include "crypt_utils.h"
+#include "stub_replace.h"
 #include "securec.h"
 /* END_HEADER */
 
@@ -523,4 +525,170 @@ EXIT:
     free(out2);
     CRYPT_EAL_MdFreeCtx(ctx);
 }
-/* END_CASE */
\ No newline at end of file
+/* END_CASE */
+
+/**
+ * @test   SDV_CRYPT_EAL_SHA3_FUNC_TC008
+ * @title  The parallel SHAKE gives the same results as SHAKE of every input.
+ * @precon nan
+ * @brief
+ *    1. Hash five different inputs of inLen bytes by CRYPT_SHAKE*_Batch, expected result 1.
+ *    2. Hash the first four inputs by CRYPT_SHAKE*_X4Absorb and CRYPT_SHAKE_X4SqueezeBlocks, expected result 2.
+ *    3. Compare the outputs with CRYPT_EAL_Md of every input, expected result 3.
+ *    4. Hash the inputs by CRYPT_SHAKE*_Batch again with the last output NULL, expected result 4.
+ * @expect
+ *    1. CRYPT_SUCCESS
+ *    2. CRYPT_SUCCESS
+ *    3. The results are the same.
+ *    4. CRYPT_NULL_INPUT, and no output is written.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPT_EAL_SHA3_FUNC_TC008(int algId, int inLen, int outLen)
+{
+    TestMemInit();
+    const uint32_t num = CRYPT_SHAKE_X4_LANES + 1;
+    uint32_t blockSize = (algId == CRYPT_MD_SHAKE128) ? CRYPT_SHAKE128_BLOCKSIZE : CRYPT_SHAKE256_BLOCKSIZE;
+    uint32_t blockNum = (outLen + blockSize - 1) / blockSize;
+    uint8_t *inBuf = malloc(num * inLen + 1);
+    uint8_t *outBuf = malloc(num * outLen);
+    uint8_t *blockBuf = malloc(CRYPT_SHAKE_X4_LANES * blockNum * blockSize);
+    uint8_t *expect = malloc(outLen);
+    ASSERT_TRUE(inBuf != NULL && outBuf != NULL && blockBuf != NULL && expect != NULL);
+    const uint8_t *in[CRYPT_SHAKE_X4_LANES + 1];
+    uint8_t *out[CRYPT_SHAKE_X4_LANES + 1];
+    uint8_t *blockOut[CRYPT_SHAKE_X4_LANES];
+    for (uint32_t i = 0; i < num * inLen; i++) {
+        inBuf[i] = (uint8_t)(i * 7 + 1);
+    }
+    for (uint32_t j = 0; j < num; j++) {
+        in[j] = inBuf + j * inLen;
+        out[j] = outBuf + j * outLen;
+    }
+    for (uint32_t j = 0; j < CRYPT_SHAKE_X4_LANES; j++) {
+        blockOut[j] = blockBuf + j * blockNum * blockSize;
+    }
+
+    CRYPT_SHAKE_X4_Ctx ctx;
+    if (algId == CRYPT_MD_SHAKE128) {
+        ASSERT_EQ(CRYPT_SHAKE128_Batch(in, inLen, out, outLen, num), CRYPT_SUCCESS);
+        ASSERT_EQ(CRYPT_SHAKE128_X4Absorb(&ctx, in, inLen), CRYPT_SUCCESS);
+    } else {
+        ASSERT_EQ(CRYPT_SHAKE256_Batch(in, inLen, out, outLen, num), CRYPT_SUCCESS);
+        ASSERT_EQ(CRYPT_SHAKE256_X4Absorb(&ctx, in, inLen), CRYPT_SUCCESS);
+    }
+    ASSERT_EQ(CRYPT_SHAKE_X4SqueezeBlocks(&ctx, blockOut, blockNum), CRYPT_SUCCESS);
+
+    for (uint32_t j = 0; j < num; j++) {
+        uint32_t expectLen = outLen;
+        ASSERT_EQ(CRYPT_EAL_Md(algId, in[j], inLen, expect, &expectLen), CRYPT_SUCCESS);
+        ASSERT_COMPARE("batch", out[j], outLen, expect, outLen);
+        if (j < CRYPT_SHAKE_X4_LANES) {
+            ASSERT_COMPARE("x4", blockOut[j], outLen, expect, outLen);
+        }
+    }
+
+    (void)memset_s(outBuf, num * outLen, 0, num * outLen);
+    (void)memset_s(expect, outLen, 0, outLen);
+    out[num - 1] = NULL;
+    if (algId == CRYPT_MD_SHAKE128) {
+        ASSERT_EQ(CRYPT_SHAKE128_Batch(in, inLen, out, outLen, num), CRYPT_NULL_INPUT);
+    } else {
+        ASSERT_EQ(CRYPT_SHAKE256_Batch(in, inLen, out, outLen, num), CRYPT_NULL_INPUT);
+    }
+    ASSERT_COMPARE("no output", out[0], outLen, expect, outLen);
+EXIT:
+    free(inBuf);
+    free(outBuf);
+    free(blockBuf);
+    free(expect);
+}
+/* END_CASE */
+
+#if defined(__x86_64__) && defined(HITLS_CRYPTO_EALINIT)
+static bool STUB_IsSupportAVX2(void)
+{
+    return false;
+}
+#endif
+
+static int32_t ShakeX4Squeeze(int algId, const uint8_t *const in[], uint32_t inLen, uint8_t *const out[],
+    uint32_t blockNum)
+{
+    CRYPT_SHAKE_X4_Ctx ctx;
+    int32_t ret = (algId == CRYPT_MD_SHAKE128) ? CRYPT_SHAKE128_X4Absorb(&ctx, in, inLen) :
+        CRYPT_SHAKE256_X4Absorb(&ctx, in, inLen);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    return CRYPT_SHAKE_X4SqueezeBlocks(&ctx, out, blockNum);
+}
+
+/**
+ * @test   SDV_CRYPT_EAL_SHA3_FUNC_TC009
+ * @title  The avx2 and the generic four-way Keccak give the same results as four scalar SHAKE runs.
+ * @precon The cpu supports avx2.
+ * @brief
+ *    1. Obtain the cpu capability and hash four inputs by the x4 SHAKE, which uses the avx2 kernel,
+ *       expected result 1.
+ *    2. Stub IsSupportAVX2 to return false and hash the inputs again, expected result 1.
+ *    3. Compare both outputs with CRYPT_EAL_Md of every input, expected result 2.
+ * @expect
+ *    1. CRYPT_SUCCESS
+ *    2. The results are the same.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPT_EAL_SHA3_FUNC_TC009(int algId, int inLen, int outLen)
+{
+#if !defined(__x86_64__) || !defined(HITLS_CRYPTO_EALINIT)
+    (void)algId;
+    (void)inLen;
+    (void)outLen;
+    SKIP_TEST();
+#else
+    TestMemInit();
+    FuncStubInfo tmpStubInfo = {0};
+    STUB_Init();
+    GetCpuInstrSupportState();
+    if (!IsSupportAVX() || !IsOSSupportAVX() || !IsSupportAVX2()) {
+        SKIP_TEST();
+    }
+    uint32_t blockSize = (algId == CRYPT_MD_SHAKE128) ? CRYPT_SHAKE128_BLOCKSIZE : CRYPT_SHAKE256_BLOCKSIZE;
+    uint32_t blockNum = (outLen + blockSize - 1) / blockSize;
+    uint32_t laneLen = blockNum * blockSize;
+    uint8_t *inBuf = malloc(CRYPT_SHAKE_X4_LANES * inLen + 1);
+    uint8_t *avx2Buf = malloc(CRYPT_SHAKE_X4_LANES * laneLen);
+    uint8_t *genericBuf = malloc(CRYPT_SHAKE_X4_LANES * laneLen);
+    uint8_t *expect = malloc(outLen);
+    ASSERT_TRUE(inBuf != NULL && avx2Buf != NULL && genericBuf != NULL && expect != NULL);
+    const uint8_t *in[CRYPT_SHAKE_X4_LANES];
+    uint8_t *avx2Out[CRYPT_SHAKE_X4_LANES];
+    uint8_t *genericOut[CRYPT_SHAKE_X4_LANES];
+    for (uint32_t i = 0; i < (uint32_t)(CRYPT_SHAKE_X4_LANES * inLen); i++) {
+        inBuf[i] = (uint8_t)(i * 13 + 5);
+    }
+    for (uint32_t j = 0; j < CRYPT_SHAKE_X4_LANES; j++) {
+        in[j] = inBuf + j * inLen;
+        avx2Out[j] = avx2Buf + j * laneLen;
+        genericOut[j] = genericBuf + j * laneLen;
+    }
+
+    ASSERT_EQ(ShakeX4Squeeze(algId, in, inLen, avx2Out, blockNum), CRYPT_SUCCESS);
+    STUB_Replace(&tmpStubInfo, IsSupportAVX2, STUB_IsSupportAVX2);
+    ASSERT_EQ(ShakeX4Squeeze(algId, in, inLen, genericOut, blockNum), CRYPT_SUCCESS);
+    STUB_Reset(&tmpStubInfo);
+
+    for (uint32_t j = 0; j < CRYPT_SHAKE_X4_LANES; j++) {
+        uint32_t expectLen = outLen;
+        ASSERT_EQ(CRYPT_EAL_Md(algId, in[j], inLen, expect, &expectLen), CRYPT_SUCCESS);
+        ASSERT_COMPARE("avx2", avx2Out[j], outLen, expect, outLen);
+        ASSERT_COMPARE("generic", genericOut[j], outLen, expect, outLen);
+    }
+EXIT:
+    STUB_Reset(&tmpStubInfo);
+    free(inBuf);
+    free(avx2Buf);
+    free(genericBuf);
+    free(expect);
+#endif
+}
+/* END_CASE */
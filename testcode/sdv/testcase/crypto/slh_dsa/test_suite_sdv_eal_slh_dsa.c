@@ -22,9 +22,13 @@
 #include "bsl_sal.h"
 #include "crypt_errno.h"
 #include "crypt_eal_pkey.h"
+#include "crypt_eal_md.h"
 #include "crypt_util_rand.h"
 #include "crypt_bn.h"
+#include "crypt_sha2.h"
+#include "crypt_utils.h"
 #include "eal_pkey_local.h"
+#include "slh_dsa_local.h"
 #include "stub_replace.h"
 #include "test.h"
 /* END_HEADER */
@@ -342,4 +346,301 @@ EXIT:
     CRYPT_EAL_PkeyFreeCtx(pkey);
     return;
 }
-/* END_CASE */
\ No newline at end of file
+/* END_CASE */
+
+#define SLH_DSA_TEST_LANES 5 // more than the lanes of SHAKE and less than the lanes of SHA-256
+
+static void SlhDsaTestFill(uint8_t *buf, uint32_t len, uint8_t start)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)(start + i * 31);
+    }
+}
+
+/**
+ * @test   SDV_CRYPTO_SLH_DSA_SEEDED_HASH_FUNC_TC001
+ * @title  The hash functions give the same results with and without the seeded state.
+ * @brief
+ *    1. Set a private key and copy the key context for one operation, expected result 1.
+ *    2. Compute PRF, F, H and T_l, one by one and in batches, by the copy and by a copy without the seeded states,
+ *       expected result 2.
+ * @expect
+ *    1. The copy has the seeded and the working states for the SHA2 parameter sets only.
+ *    2. The results are the same.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_SLH_DSA_SEEDED_HASH_FUNC_TC001(int id, int isSha2)
+{
+    TestMemInit();
+    CryptSlhDsaCtx opCtx = {0};
+    CryptSlhDsaCtx plainCtx = {0};
+    bool opCtxInited = false;
+    CRYPT_EAL_PkeyCtx *pkey = CRYPT_EAL_PkeyNewCtx(CRYPT_PKEY_SLH_DSA);
+    ASSERT_TRUE(pkey != NULL);
+    ASSERT_EQ(CRYPT_EAL_PkeySetParaById(pkey, id), CRYPT_SUCCESS);
+    uint32_t n = 0;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(pkey, CRYPT_CTRL_GET_SLH_DSA_KEY_LEN, (void *)&n, sizeof(n)), CRYPT_SUCCESS);
+    uint8_t key[4 * SLH_DSA_MAX_N];
+    SlhDsaTestFill(key, sizeof(key), 1);
+    CRYPT_EAL_PkeyPrv prv = {0};
+    prv.id = CRYPT_PKEY_SLH_DSA;
+    prv.key.slhDsaPrv.seed = key;
+    prv.key.slhDsaPrv.prf = key + n;
+    prv.key.slhDsaPrv.pub.seed = key + n * 2;
+    prv.key.slhDsaPrv.pub.root = key + n * 3;
+    prv.key.slhDsaPrv.pub.len = n;
+    ASSERT_EQ(CRYPT_EAL_PkeySetPrv(pkey, &prv), CRYPT_SUCCESS);
+
+    // Step 1
+    const CryptSlhDsaCtx *ctx = (const CryptSlhDsaCtx *)pkey->key;
+    ASSERT_EQ(SlhDsaOpCtxInit(&opCtx, ctx), CRYPT_SUCCESS);
+    opCtxInited = true;
+    ASSERT_EQ(opCtx.sha256Seeded != NULL, isSha2 != 0);
+    ASSERT_EQ(opCtx.sha256Work != NULL, isSha2 != 0);
+    ASSERT_EQ(opCtx.sha512Work != NULL, isSha2 != 0 && ctx->para.secCategory != 1);
+    ASSERT_EQ(ctx->sha256Work == NULL && ctx->sha512Work == NULL, true);
+    (void)memcpy_s(&plainCtx, sizeof(plainCtx), ctx, sizeof(plainCtx));
+    plainCtx.sha256Seeded = NULL;
+    plainCtx.sha512Seeded = NULL;
+
+    // Step 2
+    SlhDsaAdrs adrs[SLH_DSA_TEST_LANES];
+    uint8_t msg[SLH_DSA_TEST_LANES][2 * SLH_DSA_MAX_N];
+    uint8_t tlMsg[35 * SLH_DSA_MAX_N]; // 35: len of WOTS+ when n is 16
+    uint8_t out[SLH_DSA_TEST_LANES][SLH_DSA_MAX_N];
+    uint8_t expect[SLH_DSA_MAX_N];
+    const uint8_t *in[SLH_DSA_TEST_LANES];
+    uint8_t *outs[SLH_DSA_TEST_LANES];
+    SlhDsaTestFill(tlMsg, sizeof(tlMsg), 7);
+    for (uint32_t j = 0; j < SLH_DSA_TEST_LANES; j++) {
+        SlhDsaTestFill(adrs[j].bytes, sizeof(adrs[j].bytes), (uint8_t)(j + 3));
+        SlhDsaTestFill(msg[j], sizeof(msg[j]), (uint8_t)(j * 5 + 11));
+        in[j] = msg[j];
+        outs[j] = out[j];
+    }
+    ASSERT_EQ(opCtx.hashFuncs.prf(&opCtx, &adrs[0], out[0]), CRYPT_SUCCESS);
+    ASSERT_EQ(plainCtx.hashFuncs.prf(&plainCtx, &adrs[0], expect), CRYPT_SUCCESS);
+    ASSERT_COMPARE("prf", out[0], n, expect, n);
+    ASSERT_EQ(opCtx.hashFuncs.f(&opCtx, &adrs[0], msg[0], n, out[0]), CRYPT_SUCCESS);
+    ASSERT_EQ(plainCtx.hashFuncs.f(&plainCtx, &adrs[0], msg[0], n, expect), CRYPT_SUCCESS);
+    ASSERT_COMPARE("f", out[0], n, expect, n);
+    ASSERT_EQ(opCtx.hashFuncs.h(&opCtx, &adrs[0], msg[0], 2 * n, out[0]), CRYPT_SUCCESS);
+    ASSERT_EQ(plainCtx.hashFuncs.h(&plainCtx, &adrs[0], msg[0], 2 * n, expect), CRYPT_SUCCESS);
+    ASSERT_COMPARE("h", out[0], n, expect, n);
+    ASSERT_EQ(opCtx.hashFuncs.tl(&opCtx, &adrs[0], tlMsg, sizeof(tlMsg), out[0]), CRYPT_SUCCESS);
+    ASSERT_EQ(plainCtx.hashFuncs.tl(&plainCtx, &adrs[0], tlMsg, sizeof(tlMsg), expect), CRYPT_SUCCESS);
+    ASSERT_COMPARE("tl", out[0], n, expect, n);
+
+    ASSERT_EQ(opCtx.hashFuncs.prfBatch(&opCtx, adrs, outs, SLH_DSA_TEST_LANES), CRYPT_SUCCESS);
+    for (uint32_t j = 0; j < SLH_DSA_TEST_LANES; j++) {
+        ASSERT_EQ(plainCtx.hashFuncs.prf(&plainCtx, &adrs[j], expect), CRYPT_SUCCESS);
+        ASSERT_COMPARE("prf batch", out[j], n, expect, n);
+    }
+    ASSERT_EQ(opCtx.hashFuncs.fBatch(&opCtx, adrs, in, n, outs, SLH_DSA_TEST_LANES), CRYPT_SUCCESS);
+    for (uint32_t j = 0; j < SLH_DSA_TEST_LANES; j++) {
+        ASSERT_EQ(plainCtx.hashFuncs.f(&plainCtx, &adrs[j], msg[j], n, expect), CRYPT_SUCCESS);
+        ASSERT_COMPARE("f batch", out[j], n, expect, n);
+    }
+    ASSERT_EQ(opCtx.hashFuncs.hBatch(&opCtx, adrs, in, 2 * n, outs, SLH_DSA_TEST_LANES), CRYPT_SUCCESS);
+    for (uint32_t j = 0; j < SLH_DSA_TEST_LANES; j++) {
+        ASSERT_EQ(plainCtx.hashFuncs.h(&plainCtx, &adrs[j], msg[j], 2 * n, expect), CRYPT_SUCCESS);
+        ASSERT_COMPARE("h batch", out[j], n, expect, n);
+    }
+EXIT:
+    if (opCtxInited) {
+        SlhDsaOpCtxDeinit(&opCtx);
+    }
+    BSL_SAL_CleanseData(&plainCtx, sizeof(plainCtx));
+    CRYPT_EAL_PkeyFreeCtx(pkey);
+    return;
+}
+/* END_CASE */
+
+static int32_t SlhDsaTestSetKey(CRYPT_EAL_PkeyCtx *pkey, int32_t id, const Hex *key)
+{
+    uint32_t n = (uint32_t)key->len / 4;
+    int32_t isDeterministic = 1;
+    CRYPT_EAL_PkeyPrv prv = {0};
+    prv.id = CRYPT_PKEY_SLH_DSA;
+    prv.key.slhDsaPrv.seed = key->x;
+    prv.key.slhDsaPrv.prf = key->x + n;
+    prv.key.slhDsaPrv.pub.seed = key->x + n * 2;
+    prv.key.slhDsaPrv.pub.root = key->x + n * 3;
+    prv.key.slhDsaPrv.pub.len = n;
+    int32_t ret = CRYPT_EAL_PkeySetParaById(pkey, id);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    ret = CRYPT_EAL_PkeyCtrl(pkey, CRYPT_CTRL_SET_DETERMINISTIC_FLAG, (void *)&isDeterministic,
+        sizeof(isDeterministic));
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    return CRYPT_EAL_PkeySetPrv(pkey, &prv);
+}
+
+/**
+ * @test   SDV_CRYPTO_SLH_DSA_SIGN_THREAD_FUNC_TC001
+ * @title  A signature computed with several hypertree threads is the same as with one thread.
+ * @brief
+ *    1. Set the same private key to two contexts and set threadNum hypertree threads to the second, expected result 1.
+ *       Only the s sets spread the layers over the threads, the f sets sign in the calling thread.
+ *    2. Sign a message deterministically by both contexts, expected result 2.
+ *    3. Hash the signature of the threaded context, expected result 3.
+ *    4. Verify the signature by the threaded context, expected result 4.
+ * @expect
+ *    1. Success.
+ *    2. Success, and the signatures are the same.
+ *    3. The digest is the digest of the known signature.
+ *    4. Success.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_SLH_DSA_SIGN_THREAD_FUNC_TC001(int id, Hex *key, Hex *msg, int threadNum, Hex *sigDigest)
+{
+    TestMemInit();
+    uint32_t num = (uint32_t)threadNum;
+    uint8_t *sig = NULL;
+    uint8_t *sigThread = NULL;
+    uint32_t sigLen = 50000;
+    uint32_t sigThreadLen = 50000;
+    uint8_t digest[32] = {0};
+    uint32_t digestLen = sizeof(digest);
+    CRYPT_EAL_PkeyCtx *pkey = CRYPT_EAL_PkeyNewCtx(CRYPT_PKEY_SLH_DSA);
+    CRYPT_EAL_PkeyCtx *pkeyThread = CRYPT_EAL_PkeyNewCtx(CRYPT_PKEY_SLH_DSA);
+    ASSERT_TRUE(pkey != NULL && pkeyThread != NULL);
+    sig = (uint8_t *)BSL_SAL_Malloc(sigLen);
+    sigThread = (uint8_t *)BSL_SAL_Malloc(sigThreadLen);
+    ASSERT_TRUE(sig != NULL && sigThread != NULL);
+
+    // Step 1
+    ASSERT_EQ(SlhDsaTestSetKey(pkey, id, key), CRYPT_SUCCESS);
+    ASSERT_EQ(SlhDsaTestSetKey(pkeyThread, id, key), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(pkeyThread, CRYPT_CTRL_SET_SLH_DSA_THREAD_NUM, (void *)&num, sizeof(num)),
+        CRYPT_SUCCESS);
+
+    // Step 2
+    ASSERT_EQ(CRYPT_EAL_PkeySign(pkey, CRYPT_MD_SHA256, msg->x, msg->len, sig, &sigLen), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeySign(pkeyThread, CRYPT_MD_SHA256, msg->x, msg->len, sigThread, &sigThreadLen),
+        CRYPT_SUCCESS);
+    ASSERT_COMPARE("threaded signature", sigThread, sigThreadLen, sig, sigLen);
+
+    // Step 3
+    ASSERT_EQ(CRYPT_EAL_Md(CRYPT_MD_SHA256, sigThread, sigThreadLen, digest, &digestLen), CRYPT_SUCCESS);
+    ASSERT_COMPARE("signature digest", digest, digestLen, sigDigest->x, sigDigest->len);
+
+    // Step 4
+    ASSERT_EQ(CRYPT_EAL_PkeyVerify(pkeyThread, CRYPT_MD_SHA256, msg->x, msg->len, sigThread, sigThreadLen),
+        CRYPT_SUCCESS);
+EXIT:
+    BSL_SAL_Free(sig);
+    BSL_SAL_Free(sigThread);
+    CRYPT_EAL_PkeyFreeCtx(pkey);
+    CRYPT_EAL_PkeyFreeCtx(pkeyThread);
+    return;
+}
+/* END_CASE */
+
+#if defined(__x86_64__) && defined(HITLS_CRYPTO_EALINIT)
+static bool STUB_IsSupportAVX2(void)
+{
+    return false;
+}
+#endif
+
+// Generate the key pair from seeds (sk.seed || sk.prf || pk.seed) and sign msg deterministically.
+static int32_t SlhDsaTestGenSign(CRYPT_EAL_PkeyCtx *pkey, const Hex *seeds, const Hex *msg, uint8_t *root,
+    uint8_t *sig, uint32_t *sigLen)
+{
+    uint32_t n = (uint32_t)seeds->len / 3;
+    int32_t isDeterministic = 1;
+    uint8_t pubSeed[SLH_DSA_MAX_N] = {0};
+    uint8_t *stubRand[3] = {seeds->x, seeds->x + n, seeds->x + n * 2};
+    uint32_t stubRandLen[3] = {n, n, n};
+    RandInjectionInit();
+    RandInjectionSet(stubRand, stubRandLen);
+    CRYPT_RandRegist(RandInjection);
+    CRYPT_RandRegistEx(RandInjectionEx);
+    int32_t ret = CRYPT_EAL_PkeyGen(pkey);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    CRYPT_EAL_PkeyPub pub = {0};
+    pub.id = CRYPT_PKEY_SLH_DSA;
+    pub.key.slhDsaPub.seed = pubSeed;
+    pub.key.slhDsaPub.root = root;
+    pub.key.slhDsaPub.len = n;
+    ret = CRYPT_EAL_PkeyGetPub(pkey, &pub);
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    ret = CRYPT_EAL_PkeyCtrl(pkey, CRYPT_CTRL_SET_DETERMINISTIC_FLAG, (void *)&isDeterministic,
+        sizeof(isDeterministic));
+    if (ret != CRYPT_SUCCESS) {
+        return ret;
+    }
+    return CRYPT_EAL_PkeySign(pkey, CRYPT_MD_SHA256, msg->x, msg->len, sig, sigLen);
+}
+
+/**
+ * @test   SDV_CRYPTO_SLH_DSA_SHA2_SERIAL_FUNC_TC001
+ * @title  The SHA2 parameter sets give the same keys and signatures with the serial and the eight-way SHA-256.
+ * @brief
+ *    1. Set the parameter set to two contexts, the second one with IsSupportAVX2 stubbed to return false on x86-64,
+ *       expected result 1.
+ *    2. Generate the key pair from the same seeds and sign a message deterministically by both contexts,
+ *       expected result 2.
+ *    3. Verify the signature of every context by the other one, expected result 3.
+ * @expect
+ *    1. The first context hashes eight inputs at a time if the eight-way SHA-256 is fast, the second one hashes one
+ *       input at a time.
+ *    2. Success, and the roots and the signatures are the same.
+ *    3. Success.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_SLH_DSA_SHA2_SERIAL_FUNC_TC001(int id, Hex *seeds, Hex *msg)
+{
+    TestMemInit();
+    FuncStubInfo tmpStubInfo = {0};
+    STUB_Init();
+    uint8_t *sig = NULL;
+    uint8_t *sigSerial = NULL;
+    uint32_t sigLen = 50000;
+    uint32_t sigSerialLen = 50000;
+    uint8_t root[SLH_DSA_MAX_N] = {0};
+    uint8_t rootSerial[SLH_DSA_MAX_N] = {0};
+    CRYPT_EAL_PkeyCtx *pkey = CRYPT_EAL_PkeyNewCtx(CRYPT_PKEY_SLH_DSA);
+    CRYPT_EAL_PkeyCtx *pkeySerial = CRYPT_EAL_PkeyNewCtx(CRYPT_PKEY_SLH_DSA);
+    ASSERT_TRUE(pkey != NULL && pkeySerial != NULL);
+    sig = (uint8_t *)BSL_SAL_Malloc(sigLen);
+    sigSerial = (uint8_t *)BSL_SAL_Malloc(sigSerialLen);
+    ASSERT_TRUE(sig != NULL && sigSerial != NULL);
+
+    // Step 1
+    ASSERT_EQ(CRYPT_EAL_PkeySetParaById(pkey, id), CRYPT_SUCCESS);
+    ASSERT_EQ(((CryptSlhDsaCtx *)pkey->key)->hashFuncs.lanes,
+        CRYPT_SHA2_256_CompressX8IsFast() ? CRYPT_SHA2_256_X8_LANES : 1);
+#if defined(__x86_64__) && defined(HITLS_CRYPTO_EALINIT)
+    STUB_Replace(&tmpStubInfo, IsSupportAVX2, STUB_IsSupportAVX2);
+#endif
+    ASSERT_EQ(CRYPT_EAL_PkeySetParaById(pkeySerial, id), CRYPT_SUCCESS);
+    STUB_Reset(&tmpStubInfo);
+    ASSERT_EQ(((CryptSlhDsaCtx *)pkeySerial->key)->hashFuncs.lanes, 1);
+
+    // Step 2
+    ASSERT_EQ(SlhDsaTestGenSign(pkey, seeds, msg, root, sig, &sigLen), CRYPT_SUCCESS);
+    ASSERT_EQ(SlhDsaTestGenSign(pkeySerial, seeds, msg, rootSerial, sigSerial, &sigSerialLen), CRYPT_SUCCESS);
+    ASSERT_COMPARE("root", rootSerial, sizeof(rootSerial), root, sizeof(root));
+    ASSERT_COMPARE("signature", sigSerial, sigSerialLen, sig, sigLen);
+
+    // Step 3
+    ASSERT_EQ(CRYPT_EAL_PkeyVerify(pkey, CRYPT_MD_SHA256, msg->x, msg->len, sigSerial, sigSerialLen), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyVerify(pkeySerial, CRYPT_MD_SHA256, msg->x, msg->len, sig, sigLen), CRYPT_SUCCESS);
+EXIT:
+    STUB_Reset(&tmpStubInfo);
+    BSL_SAL_Free(sig);
+    BSL_SAL_Free(sigSerial);
+    CRYPT_EAL_PkeyFreeCtx(pkey);
+    CRYPT_EAL_PkeyFreeCtx(pkeySerial);
+    return;
+}
+/* END_CASE */
@@ -16,13 +16,37 @@
 
 /* BEGIN_HEADER */
 
+#include <pthread.h>
 #include "crypt_eal_pkey.h"
 #include "eal_pkey_local.h"
+#include "sm2_local.h"
 
 #define SM2_SIGN_MAX_LEN 74
 #define SM2_PRVKEY_MAX_LEN 32
 #define SM2_PUBKEY_LEN 65
 #define CRYPT_EAL_PKEY_KEYMGMT_OPERATE 0
+#define SM2_BATCH_KEY_NUM 2
+#define SM2_BATCH_ITEM_NUM 6
+#define SM2_ZA_LEN 32
+#define SM2_VERIFY_THREAD_NUM 4
+#define SM2_VERIFY_THREAD_LOOP 8
+
+typedef struct {
+    CRYPT_EAL_PkeyCtx *ctx;
+    Hex *msg;
+    uint8_t *sign;
+    uint32_t signLen;
+    int32_t ret;
+} Sm2VerifyJob;
+
+static void *Sm2VerifyThread(void *arg)
+{
+    Sm2VerifyJob *job = (Sm2VerifyJob *)arg;
+    for (int i = 0; i < SM2_VERIFY_THREAD_LOOP && job->ret == CRYPT_SUCCESS; i++) {
+        job->ret = CRYPT_EAL_PkeyVerify(job->ctx, CRYPT_MD_SM3, job->msg->x, job->msg->len, job->sign, job->signLen);
+    }
+    return NULL;
+}
 /* END_HEADER */
 
 /**
@@ -875,6 +899,77 @@ EXIT:
 }
 /* END_CASE */
 
+/**
+ * @test   SDV_CRYPTO_SM2_VERIFY_BATCH_FUNC_TC001
+ * @title  SM2 CRYPT_EAL_PkeyVerifyBatch: two keys with different user ids, one tampered message.
+ * @precon nan
+ * @brief
+ *    1. Generate two key pairs and set different user ids, expected result 1
+ *    2. Sign the messages of the items with the keys, expected result 2
+ *    3. Tamper the message of an item, expected result 3
+ *    4. Call the CRYPT_EAL_PkeyVerifyBatch method with a hash algorithm other than SM3, expected result 4
+ *    5. Call the CRYPT_EAL_PkeyVerifyBatch method, expected result 5
+ * @expect
+ *    1-2. CRYPT_SUCCESS
+ *    4. CRYPT_EAL_ERR_ALGID
+ *    5. Return CRYPT_SM2_VERIFY_FAIL, and the result of every item is the same as CRYPT_EAL_PkeyVerify.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_SM2_VERIFY_BATCH_FUNC_TC001(int threadNum, int isProvider)
+{
+    const uint32_t keyIdx[SM2_BATCH_ITEM_NUM] = {0, 0, 1, 1, 0, 1};
+    const uint32_t tampered = 3;
+    CRYPT_EAL_PkeyCtx *keys[SM2_BATCH_KEY_NUM] = {0};
+    const CRYPT_EAL_PkeyCtx *pkeys[SM2_BATCH_ITEM_NUM];
+    CRYPT_VerifyItem items[SM2_BATCH_ITEM_NUM];
+    int32_t results[SM2_BATCH_ITEM_NUM];
+    uint8_t msg[SM2_BATCH_ITEM_NUM][SM2_PRVKEY_MAX_LEN];
+    uint8_t sign[SM2_BATCH_ITEM_NUM][SM2_SIGN_MAX_LEN];
+    uint8_t userId[SM2_PRVKEY_MAX_LEN] = {0};
+
+    TestMemInit();
+    CRYPT_RandRegist(RandFunc);
+    CRYPT_RandRegistEx(RandFuncEx);
+    for (uint32_t i = 0; i < SM2_BATCH_KEY_NUM; i++) {
+        keys[i] = TestPkeyNewCtx(NULL, CRYPT_PKEY_SM2,
+            CRYPT_EAL_PKEY_KEYMGMT_OPERATE + CRYPT_EAL_PKEY_SIGN_OPERATE, "provider=default", isProvider);
+        ASSERT_TRUE(keys[i] != NULL);
+        ASSERT_EQ(CRYPT_EAL_PkeyGen(keys[i]), CRYPT_SUCCESS);
+        userId[0] = (uint8_t)i;
+        ASSERT_EQ(CRYPT_EAL_PkeyCtrl(keys[i], CRYPT_CTRL_SET_SM2_USER_ID, userId, sizeof(userId)), CRYPT_SUCCESS);
+    }
+    for (uint32_t i = 0; i < SM2_BATCH_ITEM_NUM; i++) {
+        uint32_t signLen = sizeof(sign[i]);
+        (void)memset_s(msg[i], sizeof(msg[i]), (int)i, sizeof(msg[i]));
+        pkeys[i] = keys[keyIdx[i]];
+        ASSERT_EQ(CRYPT_EAL_PkeySign(pkeys[i], CRYPT_MD_SM3, msg[i], sizeof(msg[i]), sign[i], &signLen),
+            CRYPT_SUCCESS);
+        items[i].data = msg[i];
+        items[i].dataLen = sizeof(msg[i]);
+        items[i].sign = sign[i];
+        items[i].signLen = signLen;
+    }
+    msg[tampered][0] ^= 1;
+
+    ASSERT_EQ(CRYPT_EAL_PkeyVerifyBatch(pkeys, CRYPT_MD_SHA256, items, SM2_BATCH_ITEM_NUM, threadNum, results),
+        CRYPT_EAL_ERR_ALGID);
+
+    ASSERT_EQ(CRYPT_EAL_PkeyVerifyBatch(pkeys, CRYPT_MD_SM3, items, SM2_BATCH_ITEM_NUM, threadNum, results),
+        CRYPT_SM2_VERIFY_FAIL);
+    for (uint32_t i = 0; i < SM2_BATCH_ITEM_NUM; i++) {
+        ASSERT_EQ(results[i], (i == tampered) ? CRYPT_SM2_VERIFY_FAIL : CRYPT_SUCCESS);
+        ASSERT_EQ(CRYPT_EAL_PkeyVerify(pkeys[i], CRYPT_MD_SM3, items[i].data, items[i].dataLen, items[i].sign,
+            items[i].signLen), results[i]);
+    }
+EXIT:
+    for (uint32_t i = 0; i < SM2_BATCH_KEY_NUM; i++) {
+        CRYPT_EAL_PkeyFreeCtx(keys[i]);
+    }
+    CRYPT_RandRegist(NULL);
+    CRYPT_RandRegistEx(NULL);
+}
+/* END_CASE */
+
 /**
  * @test   SDV_CRYPTO_SM2_VERIFY_FUNC_TC003
  * @title  SM2: Test verification failure scenario.
@@ -1026,3 +1121,152 @@ EXIT:
     CRYPT_EAL_PkeyFreeCtx(pkey);
 }
 /* END_CASE */
+
+/**
+ * @test   SDV_CRYPTO_SM2_ZA_FUNC_TC001
+ * @title  SM2: The Z digest is kept in the ctx, can be imported and is updated with the userId and the public key.
+ * @precon public key, userId, msg, signature, Z digest of the public key and the userId.
+ * @brief
+ *    1. Create the contexts(ctx, zaCtx) of the sm2 algorithm, expected result 1
+ *    2. Set the userId and public key of ctx, get the Z digest, expected result 2
+ *    3. Get the Z digest with a wrong length, expected result 3
+ *    4. Set another userId and get the Z digest, then set back the userId, expected result 4
+ *    5. Verify with ctx, expected result 5
+ *    6. Set the public key of zaCtx, import a wrong Z digest and verify, expected result 6
+ *    7. Import the Z digest with a wrong length, expected result 7
+ *    8. Import the right Z digest and verify, expected result 8
+ *    9. Set the public key of zaCtx again and verify, expected result 9
+ * @expect
+ *    1. Success, and contexts are not NULL.
+ *    2. CRYPT_SUCCESS, and the Z digest is the expected one.
+ *    3. CRYPT_SM2_ERR_CTRL_LEN
+ *    4. The Z digest of the other userId is different, and the Z digest is the expected one after setting back.
+ *    5. CRYPT_SUCCESS
+ *    6. CRYPT_SM2_VERIFY_FAIL
+ *    7. CRYPT_SM2_ERR_CTRL_LEN
+ *    8. CRYPT_SUCCESS
+ *    9. The imported Z digest is dropped, the Z digest of the unset userId is used, CRYPT_SM2_VERIFY_FAIL.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_SM2_ZA_FUNC_TC001(Hex *pubKey, Hex *userId, Hex *msg, Hex *sign, Hex *za, int isProvider)
+{
+    uint8_t out[SM2_ZA_LEN] = {0};
+    uint8_t wrongZa[SM2_ZA_LEN] = {0};
+    uint8_t otherId[] = "another user id";
+    CRYPT_EAL_PkeyPub pub = {0};
+    SetSm2PubKey(&pub, pubKey->x, pubKey->len);
+
+    TestMemInit();
+    CRYPT_EAL_PkeyCtx *ctx = TestPkeyNewCtx(NULL, CRYPT_PKEY_SM2,
+        CRYPT_EAL_PKEY_KEYMGMT_OPERATE  + CRYPT_EAL_PKEY_SIGN_OPERATE, "provider=default", isProvider);
+    CRYPT_EAL_PkeyCtx *zaCtx = TestPkeyNewCtx(NULL, CRYPT_PKEY_SM2,
+        CRYPT_EAL_PKEY_KEYMGMT_OPERATE  + CRYPT_EAL_PKEY_SIGN_OPERATE, "provider=default", isProvider);
+    ASSERT_TRUE(ctx != NULL && zaCtx != NULL);
+
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_SET_SM2_USER_ID, userId->x, userId->len), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeySetPub(ctx, &pub), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_GET_SM2_ZA, out, sizeof(out)), CRYPT_SUCCESS);
+    ASSERT_COMPARE("za", out, sizeof(out), za->x, za->len);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_GET_SM2_ZA, out, sizeof(out) - 1), CRYPT_SM2_ERR_CTRL_LEN);
+
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_SET_SM2_USER_ID, otherId, sizeof(otherId) - 1), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_GET_SM2_ZA, out, sizeof(out)), CRYPT_SUCCESS);
+    ASSERT_TRUE(memcmp(out, za->x, za->len) != 0);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_SET_SM2_USER_ID, userId->x, userId->len), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_GET_SM2_ZA, out, sizeof(out)), CRYPT_SUCCESS);
+    ASSERT_COMPARE("za", out, sizeof(out), za->x, za->len);
+    ASSERT_EQ(CRYPT_EAL_PkeyVerify(ctx, CRYPT_MD_SM3, msg->x, msg->len, sign->x, sign->len), CRYPT_SUCCESS);
+
+    ASSERT_EQ(CRYPT_EAL_PkeySetPub(zaCtx, &pub), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(zaCtx, CRYPT_CTRL_SET_SM2_ZA, wrongZa, sizeof(wrongZa)), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyVerify(zaCtx, CRYPT_MD_SM3, msg->x, msg->len, sign->x, sign->len),
+        CRYPT_SM2_VERIFY_FAIL);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(zaCtx, CRYPT_CTRL_SET_SM2_ZA, za->x, za->len - 1), CRYPT_SM2_ERR_CTRL_LEN);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(zaCtx, CRYPT_CTRL_SET_SM2_ZA, za->x, za->len), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyVerify(zaCtx, CRYPT_MD_SM3, msg->x, msg->len, sign->x, sign->len), CRYPT_SUCCESS);
+
+    ASSERT_EQ(CRYPT_EAL_PkeySetPub(zaCtx, &pub), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyVerify(zaCtx, CRYPT_MD_SM3, msg->x, msg->len, sign->x, sign->len),
+        CRYPT_SM2_VERIFY_FAIL);
+
+EXIT:
+    CRYPT_EAL_PkeyFreeCtx(ctx);
+    CRYPT_EAL_PkeyFreeCtx(zaCtx);
+}
+/* END_CASE */
+
+/**
+ * @test   SDV_CRYPTO_SM2_ZA_FUNC_TC002
+ * @title  SM2: The Z digest is computed when the public key or the userId is set, signing and verifying only read it.
+ * @precon private key, public key, userId, msg, Z digest of the public key and the userId.
+ * @brief
+ *    1. Set the userId and the private key only, and sign, expected result 1
+ *    2. Set the public key, expected result 2
+ *    3. Verify the signature with the ctx shared by several threads, expected result 3
+ *    4. Set another userId, expected result 4
+ * @expect
+ *    1. CRYPT_SUCCESS, and the Z digest computed for the signature is not stored in the ctx.
+ *    2. CRYPT_SUCCESS, and the expected Z digest is stored in the ctx.
+ *    3. All verifications succeed, and the Z digest is unchanged.
+ *    4. CRYPT_SUCCESS, and the Z digest of the other userId is stored in the ctx.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_SM2_ZA_FUNC_TC002(Hex *prvKey, Hex *pubKey, Hex *userId, Hex *msg, Hex *za, int isProvider)
+{
+    uint8_t signBuf[SM2_SIGN_MAX_LEN];
+    uint32_t signLen = sizeof(signBuf);
+    uint8_t otherId[] = "another user id";
+    pthread_t threads[SM2_VERIFY_THREAD_NUM];
+    Sm2VerifyJob jobs[SM2_VERIFY_THREAD_NUM];
+    int threadNum = 0;
+    CRYPT_EAL_PkeyPrv prv = {0};
+    CRYPT_EAL_PkeyPub pub = {0};
+    SetSm2PrvKey(&prv, prvKey->x, prvKey->len);
+    SetSm2PubKey(&pub, pubKey->x, pubKey->len);
+
+    TestMemInit();
+    CRYPT_RandRegist(RandFunc);
+    CRYPT_RandRegistEx(RandFuncEx);
+    CRYPT_EAL_PkeyCtx *ctx = TestPkeyNewCtx(NULL, CRYPT_PKEY_SM2,
+        CRYPT_EAL_PKEY_KEYMGMT_OPERATE  + CRYPT_EAL_PKEY_SIGN_OPERATE, "provider=default", isProvider);
+    ASSERT_TRUE(ctx != NULL);
+    CRYPT_SM2_Ctx *sm2Ctx = (CRYPT_SM2_Ctx *)ctx->key;
+
+    // Step 1
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_SET_SM2_USER_ID, userId->x, userId->len), CRYPT_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeySetPrv(ctx, &prv), CRYPT_SUCCESS);
+    ASSERT_EQ(sm2Ctx->isZaValid, 0);
+    ASSERT_EQ(CRYPT_EAL_PkeySign(ctx, CRYPT_MD_SM3, msg->x, msg->len, signBuf, &signLen), CRYPT_SUCCESS);
+    ASSERT_EQ(sm2Ctx->isZaValid, 0);
+
+    // Step 2
+    ASSERT_EQ(CRYPT_EAL_PkeySetPub(ctx, &pub), CRYPT_SUCCESS);
+    ASSERT_EQ(sm2Ctx->isZaValid, 1);
+    ASSERT_COMPARE("za", sm2Ctx->za, SM2_ZA_LEN, za->x, za->len);
+
+    // Step 3
+    for (; threadNum < SM2_VERIFY_THREAD_NUM; threadNum++) {
+        jobs[threadNum] = (Sm2VerifyJob){ctx, msg, signBuf, signLen, CRYPT_SUCCESS};
+        ASSERT_EQ(pthread_create(&threads[threadNum], NULL, Sm2VerifyThread, &jobs[threadNum]), 0);
+    }
+    for (; threadNum > 0; threadNum--) {
+        pthread_join(threads[threadNum - 1], NULL);
+    }
+    for (int i = 0; i < SM2_VERIFY_THREAD_NUM; i++) {
+        ASSERT_EQ(jobs[i].ret, CRYPT_SUCCESS);
+    }
+    ASSERT_COMPARE("za", sm2Ctx->za, SM2_ZA_LEN, za->x, za->len);
+
+    // Step 4
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_SET_SM2_USER_ID, otherId, sizeof(otherId) - 1), CRYPT_SUCCESS);
+    ASSERT_EQ(sm2Ctx->isZaValid, 1);
+    ASSERT_TRUE(memcmp(sm2Ctx->za, za->x, za->len) != 0);
+EXIT:
+    for (; threadNum > 0; threadNum--) {
+        pthread_join(threads[threadNum - 1], NULL);
+    }
+    CRYPT_EAL_PkeyFreeCtx(ctx);
+    CRYPT_RandRegist(NULL);
+    CRYPT_RandRegistEx(NULL);
+}
+/* END_CASE */
@@ -21,6 +21,8 @@
 #include "pthread.h"
 #include "securec.h"
 #include "eal_cipher_local.h"
+#include "crypt_utils.h"
+#include "stub_replace.h"
 
 #define BLOCKSIZE 16
 #define KEYSIZE 32
@@ -1617,4 +1619,163 @@ EXIT:
     CRYPT_EAL_CipherDeinit(ctxDec);
     CRYPT_EAL_CipherFreeCtx(ctxDec);
 }
-/* END_CASE */
\ No newline at end of file
+/* END_CASE */
+
+static int32_t Sm4CryptInSteps(CRYPT_EAL_CipherCtx *ctx, bool enc, Hex *key, Hex *iv, const uint8_t *in,
+    uint32_t inLen, uint32_t step, uint8_t *out, uint8_t *tag)
+{
+    uint8_t aad[BLOCKSIZE + 4] = {0};
+    bool isGcm = tag != NULL; // only gcm has a tag
+    int32_t ret = CRYPT_EAL_CipherInit(ctx, key->x, key->len, iv->x, iv->len, enc);
+    if (ret == CRYPT_SUCCESS && isGcm) {
+        ret = CRYPT_EAL_CipherCtrl(ctx, CRYPT_CTRL_SET_AAD, aad, sizeof(aad));
+    }
+    for (uint32_t off = 0; off < inLen && ret == CRYPT_SUCCESS; off += step) {
+        uint32_t len = (inLen - off < step) ? inLen - off : step;
+        uint32_t outLen = MAX_DATASZIE - off;
+        ret = CRYPT_EAL_CipherUpdate(ctx, in + off, len, out + off, &outLen);
+        if (ret == CRYPT_SUCCESS && outLen != len) {
+            ret = CRYPT_INVALID_ARG;
+        }
+    }
+    if (ret == CRYPT_SUCCESS && isGcm) {
+        ret = CRYPT_EAL_CipherCtrl(ctx, CRYPT_CTRL_GET_TAG, tag, BLOCKSIZE);
+    }
+    CRYPT_EAL_CipherDeinit(ctx);
+    return ret;
+}
+
+/**
+ * @test  SDV_CRYPTO_SM4_ENCRYPT_FUNC_TC016
+ * @title  Long messages processed at once match the messages processed block by block Test
+ * @precon Registering memory-related functions.
+ * @brief
+ *    1.Encrypt the message with one Update call. Expected result 1 is obtained.
+ *    2.Encrypt the message with one Update call per block. Expected result 2 is obtained.
+ *    3.Decrypt the ciphertext of step 1 with one Update call. Expected result 3 is obtained.
+ * @expect
+ *    1.The encryption is successful.
+ *    2.The ciphertext and the tag are the same as in step 1.
+ *    3.The plaintext is the message, and the tag is the same as in step 1.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_SM4_ENCRYPT_FUNC_TC016(int algId, Hex *key, Hex *iv, int inLen)
+{
+    TestMemInit();
+    uint8_t input[MAX_DATASZIE];
+    uint8_t whole[MAX_DATASZIE] = {0};
+    uint8_t result[MAX_DATASZIE] = {0};
+    uint8_t tag[BLOCKSIZE] = {0};
+    uint8_t resultTag[BLOCKSIZE] = {0};
+    bool isGcm = algId == CRYPT_CIPHER_SM4_GCM;
+    CRYPT_EAL_CipherCtx *ctx = NULL;
+
+    ASSERT_TRUE(inLen <= MAX_DATASZIE);
+    for (int i = 0; i < inLen; i++) {
+        input[i] = (uint8_t)(i * 31 + 5); // 31, 5: any pattern that differs between the blocks
+    }
+    ctx = CRYPT_EAL_CipherNewCtx(algId);
+    ASSERT_TRUE(ctx != NULL);
+
+    ASSERT_EQ(Sm4CryptInSteps(ctx, true, key, iv, input, inLen, inLen, whole, isGcm ? tag : NULL),
+        CRYPT_SUCCESS);
+    ASSERT_EQ(Sm4CryptInSteps(ctx, true, key, iv, input, inLen, BLOCKSIZE, result, isGcm ? resultTag : NULL),
+        CRYPT_SUCCESS);
+    ASSERT_COMPARE("Whole and blocks", whole, inLen, result, inLen);
+    ASSERT_COMPARE("Encrypt tag", tag, BLOCKSIZE, resultTag, BLOCKSIZE);
+
+    ASSERT_EQ(Sm4CryptInSteps(ctx, false, key, iv, whole, inLen, inLen, result, isGcm ? resultTag : NULL),
+        CRYPT_SUCCESS);
+    ASSERT_COMPARE("Decrypt", input, inLen, result, inLen);
+    ASSERT_COMPARE("Decrypt tag", tag, BLOCKSIZE, resultTag, BLOCKSIZE);
+EXIT:
+    CRYPT_EAL_CipherFreeCtx(ctx);
+}
+/* END_CASE */
+
+#if defined(__x86_64__) && defined(HITLS_CRYPTO_EALINIT)
+#define SM4_KERNEL_ASM    0 // the assembly, none of the wide kernels
+#define SM4_KERNEL_VAES   1 // AVX2 + VAES
+#define SM4_KERNEL_AVX512 2 // AVX-512 + GFNI, with the stitched GCM
+
+static bool STUB_IsSupportFalse(void)
+{
+    return false;
+}
+
+/* Makes the dispatch of the wide kernels pick the kernel, false if the CPU does not have it. */
+static bool Sm4ForceKernel(int kernel, FuncStubInfo *gfniStub, FuncStubInfo *vaesStub)
+{
+    if (kernel == SM4_KERNEL_AVX512) {
+        return IsSupportAVX512F() && IsSupportAVX512BW() && IsSupportAVX512VL() && IsOSSupportAVX512() &&
+            IsSupportGFNI() && IsSupportVPCLMULQDQ();
+    }
+    if (kernel == SM4_KERNEL_VAES && !(IsSupportAVX() && IsOSSupportAVX() && IsSupportAVX2() && IsSupportVAES())) {
+        return false;
+    }
+    // the AVX-512 kernel needs GFNI and the VAES kernel is only used without it
+    STUB_Replace(gfniStub, IsSupportGFNI, STUB_IsSupportFalse);
+    if (kernel == SM4_KERNEL_ASM) {
+        STUB_Replace(vaesStub, IsSupportVAES, STUB_IsSupportFalse);
+    }
+    return true;
+}
+#endif
+
+/**
+ * @test  SDV_CRYPTO_SM4_ENCRYPT_FUNC_TC017
+ * @title  Every x86-64 kernel of long messages matches the reference vectors Test
+ * @precon Registering memory-related functions.
+ * @brief
+ *    1.On x86-64, stub the CPU features so that the kernel is selected. Expected result 1 is obtained.
+ *    2.Encrypt the message with one Update call. Expected result 2 is obtained.
+ *    3.Decrypt the ciphertext with one Update call. Expected result 3 is obtained.
+ * @expect
+ *    1.The test is skipped if the CPU does not have the kernel.
+ *    2.The ciphertext and the tag are the expected ones.
+ *    3.The plaintext is the message, and the tag is the expected one.
+ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_SM4_ENCRYPT_FUNC_TC017(int kernel, int algId, Hex *key, Hex *iv, Hex *out, Hex *tag)
+{
+    FuncStubInfo gfniStub = {0};
+    FuncStubInfo vaesStub = {0};
+    STUB_Init();
+#if defined(__x86_64__) && defined(HITLS_CRYPTO_EALINIT)
+    if (!Sm4ForceKernel(kernel, &gfniStub, &vaesStub)) {
+        SKIP_TEST();
+    }
+#else
+    if (kernel != 0) { // only the x86-64 build has more than one kernel
+        SKIP_TEST();
+    }
+#endif
+    TestMemInit();
+    uint8_t input[MAX_DATASZIE];
+    uint8_t result[MAX_DATASZIE] = {0};
+    uint8_t resultTag[BLOCKSIZE] = {0};
+    bool isGcm = algId == CRYPT_CIPHER_SM4_GCM;
+    CRYPT_EAL_CipherCtx *ctx = NULL;
+
+    ASSERT_TRUE(out->len <= MAX_DATASZIE);
+    for (uint32_t i = 0; i < out->len; i++) {
+        input[i] = (uint8_t)(i * 31 + 5); // 31, 5: the message of SDV_CRYPTO_SM4_ENCRYPT_FUNC_TC016
+    }
+    ctx = CRYPT_EAL_CipherNewCtx(algId);
+    ASSERT_TRUE(ctx != NULL);
+
+    ASSERT_EQ(Sm4CryptInSteps(ctx, true, key, iv, input, out->len, out->len, result, isGcm ? resultTag : NULL),
+        CRYPT_SUCCESS);
+    ASSERT_COMPARE("Encrypt", out->x, out->len, result, out->len);
+    ASSERT_COMPARE("Encrypt tag", tag->x, tag->len, resultTag, tag->len);
+
+    ASSERT_EQ(Sm4CryptInSteps(ctx, false, key, iv, out->x, out->len, out->len, result, isGcm ? resultTag : NULL),
+        CRYPT_SUCCESS);
+    ASSERT_COMPARE("Decrypt", input, out->len, result, out->len);
+    ASSERT_COMPARE("Decrypt tag", tag->x, tag->len, resultTag, tag->len);
+EXIT:
+    CRYPT_EAL_CipherFreeCtx(ctx);
+    STUB_Reset(&vaesStub);
+    STUB_Reset(&gfniStub);
+}
+/* END_CASE */
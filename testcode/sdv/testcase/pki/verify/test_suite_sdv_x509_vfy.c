@@ -26,6 +26,7 @@
 #include "hitls_x509_verify.h"
 #include "hitls_cert_local.h"
 #include "hitls_crl_local.h"
+#include "hitls_x509_local.h"
 #include "bsl_list_internal.h"
 
 /* END_HEADER */
@@ -557,6 +558,141 @@ EXIT:
 /* END_CASE */
 
 
+/* BEGIN_CASE */
+void SDV_X509_STORE_CRL_INDEX_FUNC_TC001(char *rootPath, char *caPath, char *certPath, char *crlPath)
+{
+    TestMemInit();
+    HITLS_X509_Cert *root = NULL;
+    HITLS_X509_Cert *ca = NULL;
+    HITLS_X509_Cert *entity = NULL;
+    HITLS_X509_Cert *caCopy = NULL;
+    HITLS_X509_Crl *crl = NULL;
+    HITLS_X509_List *chain = NULL;
+    HITLS_X509_StoreCtx *store = HITLS_X509_StoreCtxNew();
+    ASSERT_TRUE(store != NULL);
+
+    ASSERT_EQ(HITLS_AddCrlToStoreTest(crlPath, store, &crl), HITLS_PKI_SUCCESS);
+    HITLS_X509_List *crlIdxList = HITLS_X509_CrlIndexFind(store, HITLS_X509_NameHash(crl->tbs.issuerName));
+    ASSERT_EQ(BSL_LIST_COUNT(crlIdxList), 1);
+    HITLS_X509_CrlIndex *crlIdx = BSL_LIST_GET_FIRST(crlIdxList);
+    ASSERT_TRUE(crlIdx->crl == crl);
+    ASSERT_EQ(crlIdx->revokedNum, BSL_LIST_COUNT(crl->tbs.revokedCerts));
+    ASSERT_TRUE(crlIdx->signer == NULL);
+
+    ASSERT_EQ(HITLS_AddCertToStoreTest(rootPath, store, &root), HITLS_PKI_SUCCESS);
+    ASSERT_TRUE(crlIdx->signer == NULL);
+    ASSERT_EQ(HITLS_AddCertToStoreTest(caPath, store, &ca), HITLS_PKI_SUCCESS);
+    ASSERT_TRUE(crlIdx->signer == ca);
+    // The verdict holds for any copy of the signer, but not for another ca.
+    ASSERT_EQ(HITLS_X509_CertParseFile(BSL_FORMAT_UNKNOWN, caPath, &caCopy), HITLS_PKI_SUCCESS);
+    ASSERT_TRUE(HITLS_X509_CrlIndexIsSignedBy(crlIdx, caCopy));
+    ASSERT_TRUE(!HITLS_X509_CrlIndexIsSignedBy(crlIdx, root));
+
+    ASSERT_EQ(HITLS_X509_CertParseFile(BSL_FORMAT_UNKNOWN, certPath, &entity), HITLS_PKI_SUCCESS);
+    ASSERT_TRUE(HITLS_X509_CrlIndexFindRevoked(crlIdx, &entity->tbs.serialNum) != NULL);
+    ASSERT_TRUE(HITLS_X509_CrlIndexFindRevoked(crlIdx, &ca->tbs.serialNum) == NULL);
+
+    ASSERT_EQ(HITLS_X509_CertChainBuild(store, false, entity, &chain), HITLS_PKI_SUCCESS);
+    int64_t flag = HITLS_X509_VFY_FLAG_CRL_DEV;
+    ASSERT_EQ(HITLS_X509_StoreCtxCtrl(store, HITLS_X509_STORECTX_SET_PARAM_FLAGS, &flag, sizeof(int64_t)),
+        HITLS_PKI_SUCCESS);
+    ASSERT_EQ(HITLS_X509_CertVerify(store, chain), HITLS_X509_ERR_VFY_CERT_REVOKED);
+EXIT:
+    HITLS_X509_StoreCtxFree(store);
+    HITLS_X509_CertFree(root);
+    HITLS_X509_CertFree(ca);
+    HITLS_X509_CertFree(caCopy);
+    HITLS_X509_CertFree(entity);
+    HITLS_X509_CrlFree(crl);
+    BSL_LIST_FREE(chain, (BSL_LIST_PFUNC_FREE)HITLS_X509_CertFree);
+}
+/* END_CASE */
+
+/* BEGIN_CASE */
+void SDV_X509_STORE_CRL_INDEX_FUNC_TC002(char *rootPath, char *caPath, char *certPath, char *crlPath,
+    char *newCrlPath)
+{
+    TestMemInit();
+    HITLS_X509_Cert *root = NULL;
+    HITLS_X509_Cert *ca = NULL;
+    HITLS_X509_Cert *entity = NULL;
+    HITLS_X509_Crl *crl = NULL;
+    HITLS_X509_Crl *newCrl = NULL;
+    HITLS_X509_List *chain = NULL;
+    HITLS_X509_StoreCtx *store = HITLS_X509_StoreCtxNew();
+    ASSERT_TRUE(store != NULL);
+    ASSERT_EQ(HITLS_AddCertToStoreTest(rootPath, store, &root), HITLS_PKI_SUCCESS);
+    ASSERT_EQ(HITLS_AddCertToStoreTest(caPath, store, &ca), HITLS_PKI_SUCCESS);
+    ASSERT_EQ(HITLS_X509_CertParseFile(BSL_FORMAT_UNKNOWN, certPath, &entity), HITLS_PKI_SUCCESS);
+    ASSERT_EQ(HITLS_X509_CertChainBuild(store, false, entity, &chain), HITLS_PKI_SUCCESS);
+    int64_t flag = HITLS_X509_VFY_FLAG_CRL_DEV;
+    ASSERT_EQ(HITLS_X509_StoreCtxCtrl(store, HITLS_X509_STORECTX_SET_PARAM_FLAGS, &flag, sizeof(int64_t)),
+        HITLS_PKI_SUCCESS);
+
+    // A crl which revokes nothing.
+    ASSERT_EQ(HITLS_AddCrlToStoreTest(newCrlPath, store, &newCrl), HITLS_PKI_SUCCESS);
+    ASSERT_EQ(HITLS_X509_CertVerify(store, chain), HITLS_PKI_SUCCESS);
+    ASSERT_EQ(HITLS_X509_StoreCtxCtrl(store, HITLS_X509_STORECTX_SET_CRL, newCrl, sizeof(HITLS_X509_Crl)),
+        HITLS_X509_ERR_CRL_EXIST);
+    ASSERT_EQ(HITLS_X509_CertVerify(store, chain), HITLS_PKI_SUCCESS);
+
+    // Another crl of the same issuer which revokes the entity is indexed along with the first one.
+    ASSERT_EQ(HITLS_AddCrlToStoreTest(crlPath, store, &crl), HITLS_PKI_SUCCESS);
+    ASSERT_EQ(HITLS_X509_CertVerify(store, chain), HITLS_X509_ERR_VFY_CERT_REVOKED);
+    ASSERT_EQ(HITLS_X509_StoreCtxCtrl(store, HITLS_X509_STORECTX_SET_CRL, crl, sizeof(HITLS_X509_Crl)),
+        HITLS_X509_ERR_CRL_EXIST);
+    ASSERT_EQ(HITLS_X509_CertVerify(store, chain), HITLS_X509_ERR_VFY_CERT_REVOKED);
+EXIT:
+    HITLS_X509_StoreCtxFree(store);
+    HITLS_X509_CertFree(root);
+    HITLS_X509_CertFree(ca);
+    HITLS_X509_CertFree(entity);
+    HITLS_X509_CrlFree(crl);
+    HITLS_X509_CrlFree(newCrl);
+    BSL_LIST_FREE(chain, (BSL_LIST_PFUNC_FREE)HITLS_X509_CertFree);
+}
+/* END_CASE */
+
+/* BEGIN_CASE */
+void SDV_X509_STORE_CA_INDEX_FUNC_TC001(char *rootPath, char *caPath, char *certPath)
+{
+    TestMemInit();
+    HITLS_X509_Cert *root = NULL;
+    HITLS_X509_Cert *ca = NULL;
+    HITLS_X509_Cert *entity = NULL;
+    HITLS_X509_List *chain = NULL;
+    HITLS_X509_StoreCtx *store = HITLS_X509_StoreCtxNew();
+    ASSERT_TRUE(store != NULL);
+    ASSERT_TRUE(store->caIndex == NULL);
+
+    ASSERT_EQ(HITLS_AddCertToStoreTest(rootPath, store, &root), HITLS_PKI_SUCCESS);
+    ASSERT_TRUE(store->caIndex != NULL);
+    ASSERT_EQ(HITLS_AddCertToStoreTest(caPath, store, &ca), HITLS_PKI_SUCCESS);
+    ASSERT_EQ(HITLS_X509_StoreCtxCtrl(store, HITLS_X509_STORECTX_DEEP_COPY_SET_CA, ca, sizeof(HITLS_X509_Cert)),
+        HITLS_X509_ERR_CERT_EXIST);
+
+    HITLS_X509_List *caList = X509_StoreFindCaByName(store, HITLS_X509_NameHash(ca->tbs.subjectName));
+    ASSERT_EQ(BSL_LIST_COUNT(caList), 1);
+    ASSERT_TRUE(BSL_LIST_GET_FIRST(caList) == ca);
+    caList = X509_StoreFindCaByName(store, HITLS_X509_NameHash(root->tbs.subjectName));
+    ASSERT_EQ(BSL_LIST_COUNT(caList), 1);
+    ASSERT_TRUE(BSL_LIST_GET_FIRST(caList) == root);
+
+    ASSERT_EQ(HITLS_X509_CertParseFile(BSL_FORMAT_UNKNOWN, certPath, &entity), HITLS_PKI_SUCCESS);
+    ASSERT_TRUE(X509_StoreFindCaByName(store, HITLS_X509_NameHash(entity->tbs.subjectName)) == NULL);
+    ASSERT_EQ(HITLS_X509_CertChainBuild(store, false, entity, &chain), HITLS_PKI_SUCCESS);
+    ASSERT_EQ(BSL_LIST_COUNT(chain), 2);
+    ASSERT_TRUE(BSL_LIST_GET_LAST(chain) == ca);
+    ASSERT_EQ(HITLS_X509_CertVerify(store, chain), HITLS_PKI_SUCCESS);
+EXIT:
+    HITLS_X509_StoreCtxFree(store);
+    HITLS_X509_CertFree(root);
+    HITLS_X509_CertFree(ca);
+    HITLS_X509_CertFree(entity);
+    BSL_LIST_FREE(chain, (BSL_LIST_PFUNC_FREE)HITLS_X509_CertFree);
+}
+/* END_CASE */
+
 /* BEGIN_CASE */
 void SDV_X509_BUILD_CERT_CHAIN_FUNC_TC009(void)
 {
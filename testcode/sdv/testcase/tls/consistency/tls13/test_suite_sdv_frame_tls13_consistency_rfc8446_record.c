@@ -2556,4 +2556,69 @@ EXIT:
     FRAME_FreeLink(client);
     FRAME_FreeLink(server);
 }
-/* END_CASE */
\ No newline at end of file
+/* END_CASE */
+
+#define TEST_RECORD_PADDING_LEN 100u
+#define TEST_RECORD_TAG_LEN 16u
+
+static uint64_t TestRecordPaddingCb(HITLS_Ctx *ctx, int32_t type, uint64_t length, void *arg)
+{
+    (void)ctx;
+    (void)type;
+    (void)length;
+    (void)arg;
+    return TEST_RECORD_PADDING_LEN;
+}
+
+/** @
+* @test     UT_TLS_TLS13_RFC8446_CONSISTENCY_RECORD_PADDING_FUNC_TC001
+* @spec     struct {
+*               opaque content[TLSPlaintext.length];
+*               ContentType type;
+*               uint8 zeros[length_of_padding];
+*           } TLSInnerPlaintext;
+* @title    The TLSInnerPlaintext with padding is packed into the record and decrypted by the peer.
+* @precon   nan
+* @brief    5.4. Record Padding
+*           1. Set the record padding callback and establish a TLS1.3 connection. Expected result 1.
+*           2. The client sends app data. Expected result 2.
+*           3. The server reads the app data. Expected result 3.
+* @expect   1. The connection is established.
+*           2. The record length is the length of the data, content type, padding and tag.
+*           3. The data read by the server is the same as the data sent by the client.
+@ */
+/* BEGIN_CASE */
+void UT_TLS_TLS13_RFC8446_CONSISTENCY_RECORD_PADDING_FUNC_TC001(void)
+{
+    FRAME_Init();
+    HITLS_Config *tlsConfig = HITLS_CFG_NewTLS13Config();
+    ASSERT_TRUE(tlsConfig != NULL);
+    uint16_t cipherSuite = HITLS_AES_128_GCM_SHA256;
+    ASSERT_EQ(HITLS_CFG_SetCipherSuites(tlsConfig, &cipherSuite, 1), HITLS_SUCCESS);
+    ASSERT_EQ(HITLS_CFG_SetRecordPaddingCb(tlsConfig, TestRecordPaddingCb), HITLS_SUCCESS);
+
+    FRAME_LinkObj *client = FRAME_CreateLink(tlsConfig, BSL_UIO_TCP);
+    FRAME_LinkObj *server = FRAME_CreateLink(tlsConfig, BSL_UIO_TCP);
+    ASSERT_TRUE(client != NULL);
+    ASSERT_TRUE(server != NULL);
+    ASSERT_EQ(FRAME_CreateConnection(client, server, true, HS_STATE_BUTT), HITLS_SUCCESS);
+
+    uint8_t src[] = "Client is sending msg with record padding";
+    uint32_t writeLen = 0;
+    ASSERT_EQ(HITLS_Write(client->ssl, src, sizeof(src), &writeLen), HITLS_SUCCESS);
+    FrameUioUserData *ioClientData = BSL_UIO_GetUserData(client->io);
+    ASSERT_EQ(ioClientData->sndMsg.len,
+        REC_TLS_RECORD_HEADER_LEN + sizeof(src) + sizeof(uint8_t) + TEST_RECORD_PADDING_LEN + TEST_RECORD_TAG_LEN);
+    ASSERT_EQ(FRAME_TrasferMsgBetweenLink(client, server), HITLS_SUCCESS);
+
+    uint8_t dest[READ_BUF_SIZE] = {0};
+    uint32_t readbytes = 0;
+    ASSERT_EQ(HITLS_Read(server->ssl, dest, READ_BUF_SIZE, &readbytes), HITLS_SUCCESS);
+    ASSERT_EQ(readbytes, sizeof(src));
+    ASSERT_EQ(memcmp(dest, src, sizeof(src)), 0);
+EXIT:
+    HITLS_CFG_FreeConfig(tlsConfig);
+    FRAME_FreeLink(client);
+    FRAME_FreeLink(server);
+}
+/* END_CASE */
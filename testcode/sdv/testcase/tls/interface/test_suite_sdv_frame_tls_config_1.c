@@ -899,6 +899,219 @@ EXIT:
 }
 /* END_CASE */
 
+static void NewTestTicketKey(uint8_t *key, uint8_t name)
+{
+    for (uint32_t i = 0; i < HITLS_TICKET_KEY_NAME_SIZE + HITLS_TICKET_KEY_SIZE + HITLS_TICKET_KEY_SIZE; i++) {
+        key[i] = (uint8_t)(name + i);
+    }
+}
+
+/* Whether the ticket decrypts with the default keys. The ticket is released */
+static bool DecryptTestTicket(HITLS_Ctx *ctx, uint8_t *ticket, uint32_t ticketSize)
+{
+    HITLS_Session *sess = NULL;
+    bool isTicketExpect = false;
+    int32_t ret = SESSMGR_DecryptSessionTicket(LIBCTX_FROM_CTX(ctx), ATTRIBUTE_FROM_CTX(ctx),
+        ctx->config.tlsConfig.sessMgr, &sess, ticket, ticketSize, &isTicketExpect);
+    BSL_SAL_Free(ticket);
+    bool found = ret == HITLS_SUCCESS && sess != NULL && !isTicketExpect;
+    HITLS_SESS_Free(sess);
+    return found;
+}
+
+/** @
+* @test UT_TLS_CFG_TICKET_KEY_ROTATION_FUNC_TC001
+* @title   Test the rotation of the default ticket keys
+* @brief   1. Invoke HITLS_CFG_SetTicketKeyRotation with invalid input. Expected result 1.
+*          2. Keep 2 keys, encrypt a ticket, add a key and encrypt a ticket. Expected result 2.
+*          3. Decrypt the two tickets. Expected result 3.
+*          4. Add a third key, add it again, and decrypt the ticket of the first key. Expected result 4.
+*          5. Make the current key older than the interval and encrypt a ticket. Expected result 5.
+* @expect  1. Return HITLS_NULL_INPUT or HITLS_CONFIG_INVALID_SET.
+*          2. The second ticket carries the name of the added key.
+*          3. Both tickets are decrypted, the cipher contexts of the keys are back in their pools.
+*          4. The key name is in use, and the ticket of the first key is no longer accepted.
+*          5. The ticket is encrypted by a new key, and the ticket of the second key is no longer accepted.
+@ */
+/* BEGIN_CASE */
+void UT_TLS_CFG_TICKET_KEY_ROTATION_FUNC_TC001()
+{
+    HitlsInit();
+    uint8_t key[HITLS_TICKET_KEY_NAME_SIZE + HITLS_TICKET_KEY_SIZE + HITLS_TICKET_KEY_SIZE] = {0};
+    uint8_t masterKey[MAX_MASTER_KEY_SIZE] = {0};
+    uint8_t *tickets[5] = {0};
+    uint32_t ticketSizes[5] = {0};
+    uint64_t interval = 0;
+    uint32_t keyNum = 0;
+    HITLS_Ctx *ctx = NULL;
+    HITLS_Session *sess = NULL;
+    HITLS_Config *config = HITLS_CFG_NewTLS12Config();
+    ASSERT_TRUE(config != NULL);
+    TLS_SessionMgr *mgr = config->sessMgr;
+
+    ASSERT_EQ(HITLS_CFG_SetTicketKeyRotation(NULL, 3600, 2), HITLS_NULL_INPUT);
+    ASSERT_EQ(HITLS_CFG_SetTicketKeyRotation(config, 3600, 0), HITLS_CONFIG_INVALID_SET);
+    ASSERT_EQ(HITLS_CFG_SetTicketKeyRotation(config, 3600, HITLS_TICKET_KEY_MAX_NUM + 1), HITLS_CONFIG_INVALID_SET);
+    ASSERT_EQ(HITLS_CFG_GetTicketKeyRotation(config, NULL, &keyNum), HITLS_NULL_INPUT);
+    ASSERT_EQ(HITLS_CFG_SetTicketKeyRotation(config, 3600, 2), HITLS_SUCCESS);
+    ASSERT_EQ(HITLS_CFG_GetTicketKeyRotation(config, &interval, &keyNum), HITLS_SUCCESS);
+    ASSERT_EQ(interval, 3600);
+    ASSERT_EQ(keyNum, 2);
+
+    ctx = HITLS_New(config);
+    ASSERT_TRUE(ctx != NULL);
+    sess = HITLS_SESS_New();
+    ASSERT_TRUE(sess != NULL);
+    ASSERT_EQ(HITLS_SESS_SetProtocolVersion(sess, HITLS_VERSION_TLS12), HITLS_SUCCESS);
+    ASSERT_EQ(HITLS_SESS_SetCipherSuite(sess, HITLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256), HITLS_SUCCESS);
+    ASSERT_EQ(HITLS_SESS_SetMasterKey(sess, masterKey, sizeof(masterKey)), HITLS_SUCCESS);
+
+    ASSERT_EQ(SESSMGR_EncryptSessionTicket(ctx, mgr, sess, &tickets[0], &ticketSizes[0]), HITLS_SUCCESS);
+    tickets[4] = BSL_SAL_Dump(tickets[0], ticketSizes[0]); // kept for step 4, step 3 consumes tickets[0]
+    ASSERT_TRUE(tickets[4] != NULL);
+    ticketSizes[4] = ticketSizes[0];
+    NewTestTicketKey(key, 'B');
+    ASSERT_EQ(HITLS_CFG_AddSessionTicketKey(config, key, sizeof(key)), HITLS_SUCCESS);
+    ASSERT_EQ(SESSMGR_EncryptSessionTicket(ctx, mgr, sess, &tickets[1], &ticketSizes[1]), HITLS_SUCCESS);
+    ASSERT_TRUE(memcmp(tickets[1], key, HITLS_TICKET_KEY_NAME_SIZE) == 0);
+    ASSERT_TRUE(memcmp(tickets[0], key, HITLS_TICKET_KEY_NAME_SIZE) != 0);
+    ASSERT_EQ(SESSMGR_EncryptSessionTicket(ctx, mgr, sess, &tickets[2], &ticketSizes[2]), HITLS_SUCCESS);
+
+    ASSERT_TRUE(DecryptTestTicket(ctx, tickets[0], ticketSizes[0]));
+    tickets[0] = NULL;
+    ASSERT_TRUE(DecryptTestTicket(ctx, tickets[1], ticketSizes[1]));
+    tickets[1] = NULL;
+    ASSERT_EQ(mgr->ticketKeyNum, 2);
+    ASSERT_TRUE(mgr->ticketKeys[0].encCtxNum == 1 && mgr->ticketKeys[0].decCtxNum == 1);
+    ASSERT_TRUE(mgr->ticketKeys[1].encCtxNum == 1 && mgr->ticketKeys[1].decCtxNum == 1);
+
+    ASSERT_EQ(SESSMGR_EncryptSessionTicket(ctx, mgr, sess, &tickets[0], &ticketSizes[0]), HITLS_SUCCESS);
+    NewTestTicketKey(key, 'C');
+    ASSERT_EQ(HITLS_CFG_AddSessionTicketKey(config, key, sizeof(key)), HITLS_SUCCESS);
+    ASSERT_EQ(HITLS_CFG_AddSessionTicketKey(config, key, sizeof(key)), HITLS_CONFIG_INVALID_SET);
+    ASSERT_EQ(SESSMGR_EncryptSessionTicket(ctx, mgr, sess, &tickets[3], &ticketSizes[3]), HITLS_SUCCESS);
+    ASSERT_TRUE(DecryptTestTicket(ctx, tickets[2], ticketSizes[2]));
+    tickets[2] = NULL;
+    ASSERT_TRUE(!DecryptTestTicket(ctx, tickets[4], ticketSizes[4]));
+    tickets[4] = NULL;
+
+    mgr->ticketKeys[0].createTime -= 3600;
+    ASSERT_EQ(SESSMGR_EncryptSessionTicket(ctx, mgr, sess, &tickets[2], &ticketSizes[2]), HITLS_SUCCESS);
+    ASSERT_TRUE(memcmp(tickets[2], key, HITLS_TICKET_KEY_NAME_SIZE) != 0);
+    ASSERT_TRUE(DecryptTestTicket(ctx, tickets[2], ticketSizes[2]));
+    tickets[2] = NULL;
+    ASSERT_TRUE(DecryptTestTicket(ctx, tickets[3], ticketSizes[3]));
+    tickets[3] = NULL;
+    ASSERT_TRUE(!DecryptTestTicket(ctx, tickets[0], ticketSizes[0]));
+    tickets[0] = NULL;
+EXIT:
+    for (uint32_t i = 0; i < 5; i++) {
+        BSL_SAL_Free(tickets[i]);
+    }
+    HITLS_SESS_Free(sess);
+    HITLS_Free(ctx);
+    HITLS_CFG_FreeConfig(config);
+}
+/* END_CASE */
+
+#define TICKET_KEY_THREAD_NUM 4
+#define TICKET_KEY_THREAD_LOOPS 200
+#define TICKET_KEY_ADDED_NUM (HITLS_TICKET_KEY_MAX_NUM - 1) // no key leaves the ring
+
+typedef struct {
+    HITLS_Ctx *ctx;
+    HITLS_Session *sess;
+    HITLS_Config *config;      /* the thread adds the keys if not NULL */
+    bool ok;
+} TicketKeyJob;
+
+static void *TicketKeyThread(void *arg)
+{
+    TicketKeyJob *job = (TicketKeyJob *)arg;
+    TLS_SessionMgr *mgr = job->ctx->config.tlsConfig.sessMgr;
+    uint8_t key[HITLS_TICKET_KEY_NAME_SIZE + HITLS_TICKET_KEY_SIZE + HITLS_TICKET_KEY_SIZE] = {0};
+    uint32_t added = 0;
+    job->ok = true;
+    for (uint32_t i = 0; i < TICKET_KEY_THREAD_LOOPS && job->ok; i++) {
+        if (job->config != NULL && added < TICKET_KEY_ADDED_NUM &&
+            i % (TICKET_KEY_THREAD_LOOPS / TICKET_KEY_ADDED_NUM) == 0) {
+            NewTestTicketKey(key, (uint8_t)('D' + added));
+            job->ok = HITLS_CFG_AddSessionTicketKey(job->config, key, sizeof(key)) == HITLS_SUCCESS;
+            added++;
+        }
+        uint8_t *ticket = NULL;
+        uint32_t ticketSize = 0;
+        if (job->ok) {
+            job->ok = SESSMGR_EncryptSessionTicket(job->ctx, mgr, job->sess, &ticket, &ticketSize) == HITLS_SUCCESS;
+        }
+        if (job->ok) {
+            job->ok = DecryptTestTicket(job->ctx, ticket, ticketSize);
+        }
+    }
+    return NULL;
+}
+
+/** @
+* @test UT_TLS_CFG_TICKET_KEY_ROTATION_FUNC_TC002
+* @title   Test the default ticket keys used by several threads at once
+* @brief   1. Keep HITLS_TICKET_KEY_MAX_NUM keys, and encrypt and decrypt tickets in several threads while one of
+*             them adds keys. Expected result 1.
+*          2. Check the context pools of the keys. Expected result 2.
+* @expect  1. Every ticket is decrypted, no key is dropped while its tickets are in flight.
+*          2. The pools are not empty and do not exceed their size.
+@ */
+/* BEGIN_CASE */
+void UT_TLS_CFG_TICKET_KEY_ROTATION_FUNC_TC002()
+{
+    HitlsInit();
+    uint8_t masterKey[MAX_MASTER_KEY_SIZE] = {0};
+    TicketKeyJob jobs[TICKET_KEY_THREAD_NUM] = {0};
+    pthread_t threads[TICKET_KEY_THREAD_NUM];
+    uint32_t threadNum = 0;
+    HITLS_Config *config = HITLS_CFG_NewTLS12Config();
+    ASSERT_TRUE(config != NULL);
+    TLS_SessionMgr *mgr = config->sessMgr;
+    ASSERT_EQ(HITLS_CFG_SetTicketKeyRotation(config, 3600, HITLS_TICKET_KEY_MAX_NUM), HITLS_SUCCESS);
+
+    for (uint32_t i = 0; i < TICKET_KEY_THREAD_NUM; i++) {
+        jobs[i].ctx = HITLS_New(config);
+        ASSERT_TRUE(jobs[i].ctx != NULL);
+        jobs[i].sess = HITLS_SESS_New();
+        ASSERT_TRUE(jobs[i].sess != NULL);
+        ASSERT_EQ(HITLS_SESS_SetProtocolVersion(jobs[i].sess, HITLS_VERSION_TLS12), HITLS_SUCCESS);
+        ASSERT_EQ(HITLS_SESS_SetCipherSuite(jobs[i].sess, HITLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256), HITLS_SUCCESS);
+        ASSERT_EQ(HITLS_SESS_SetMasterKey(jobs[i].sess, masterKey, sizeof(masterKey)), HITLS_SUCCESS);
+    }
+    jobs[0].config = config;
+
+    for (; threadNum < TICKET_KEY_THREAD_NUM; threadNum++) {
+        ASSERT_EQ(pthread_create(&threads[threadNum], NULL, TicketKeyThread, &jobs[threadNum]), 0);
+    }
+    for (; threadNum > 0; threadNum--) {
+        pthread_join(threads[threadNum - 1], NULL);
+    }
+    for (uint32_t i = 0; i < TICKET_KEY_THREAD_NUM; i++) {
+        ASSERT_TRUE(jobs[i].ok);
+    }
+
+    ASSERT_EQ(mgr->ticketKeyNum, HITLS_TICKET_KEY_MAX_NUM);
+    for (uint32_t i = 0; i < mgr->ticketKeyNum; i++) {
+        ASSERT_TRUE(mgr->ticketKeys[i].encCtxNum <= SESSION_TICKET_CTX_POOL_SIZE);
+        ASSERT_TRUE(mgr->ticketKeys[i].decCtxNum <= SESSION_TICKET_CTX_POOL_SIZE);
+    }
+    ASSERT_TRUE(mgr->ticketKeys[0].encCtxNum > 0 && mgr->ticketKeys[0].decCtxNum > 0);
+EXIT:
+    for (; threadNum > 0; threadNum--) {
+        pthread_join(threads[threadNum - 1], NULL);
+    }
+    for (uint32_t i = 0; i < TICKET_KEY_THREAD_NUM; i++) {
+        HITLS_SESS_Free(jobs[i].sess);
+        HITLS_Free(jobs[i].ctx);
+    }
+    HITLS_CFG_FreeConfig(config);
+}
+/* END_CASE */
+
 /** @
 * @test UT_TLS_CFG_ADD_CAINDICATION_API_TC001
 * @title:  Test Add different CA flag indication types.
@@ -1047,6 +1260,156 @@ EXIT:
 }
 /* END_CASE */
 
+static HITLS_Session *NewCacheTestSession(uint16_t idx, uint64_t timeout)
+{
+    uint8_t sessionId[HITLS_SESSION_ID_MAX_SIZE] = {0};
+    sessionId[0] = (uint8_t)idx;
+    sessionId[1] = (uint8_t)(idx >> 8);
+    HITLS_Session *sess = HITLS_SESS_New();
+    if (sess == NULL) {
+        return NULL;
+    }
+    if (HITLS_SESS_SetSessionId(sess, sessionId, sizeof(sessionId)) != HITLS_SUCCESS ||
+        HITLS_SESS_SetTimeout(sess, timeout) != HITLS_SUCCESS) {
+        HITLS_SESS_Free(sess);
+        return NULL;
+    }
+    return sess;
+}
+
+static bool FindCacheTestSession(TLS_SessionMgr *mgr, uint16_t idx)
+{
+    uint8_t sessionId[HITLS_SESSION_ID_MAX_SIZE] = {0};
+    sessionId[0] = (uint8_t)idx;
+    sessionId[1] = (uint8_t)(idx >> 8);
+    HITLS_Session *sess = SESSMGR_Find(mgr, sessionId, sizeof(sessionId));
+    HITLS_SESS_Free(sess);
+    return sess != NULL;
+}
+
+/* @
+* @test UT_TLS_CFG_GET_SESSIONCACHESTATS_FUNC_TC001
+* @title   Test HITLS_CFG_GetSessionCacheStats interface and the eviction of the session cache
+* @brief   1. Invoke HITLS_CFG_GetSessionCacheStats with null input. Expected result 1.
+*          2. Set the cache size to 4 and insert 6 sessions. Expected result 2.
+*          3. Find the 6 sessions. Expected result 3.
+*          4. Insert a timed out session and find it. Expected result 4.
+*          5. Insert a timed out session and clear the timed out sessions. Expected result 5.
+* @expect  1. Return HITLS_NULL_INPUT.
+*          2. 4 sessions are cached, 2 sessions are evicted.
+*          3. 4 hits and 2 misses.
+*          4. The session is not found, and it is removed from the cache.
+*          5. The session is removed from the cache.
+@ */
+/* BEGIN_CASE */
+void UT_TLS_CFG_GET_SESSIONCACHESTATS_FUNC_TC001()
+{
+    HitlsInit();
+    HITLS_Session *sess = NULL;
+    HITLS_SessCacheStats stats = {0};
+    HITLS_Config *config = HITLS_CFG_NewTLS12Config();
+    ASSERT_TRUE(config != NULL);
+    ASSERT_EQ(HITLS_CFG_GetSessionCacheStats(NULL, &stats), HITLS_NULL_INPUT);
+    ASSERT_EQ(HITLS_CFG_GetSessionCacheStats(config, NULL), HITLS_NULL_INPUT);
+
+    ASSERT_EQ(HITLS_CFG_SetSessionCacheSize(config, 4), HITLS_SUCCESS);
+    for (uint8_t i = 0; i < 6; i++) {
+        sess = NewCacheTestSession(i, 7200);
+        ASSERT_TRUE(sess != NULL);
+        SESSMGR_InsertSession(config->sessMgr, sess, false);
+        HITLS_SESS_Free(sess);
+        sess = NULL;
+    }
+    ASSERT_EQ(HITLS_CFG_GetSessionCacheStats(config, &stats), HITLS_SUCCESS);
+    ASSERT_EQ(stats.number, 4);
+    ASSERT_EQ(stats.evictions, 2);
+    ASSERT_EQ(stats.hits, 0);
+
+    uint32_t found = 0;
+    for (uint8_t i = 0; i < 6; i++) {
+        found += FindCacheTestSession(config->sessMgr, i) ? 1 : 0;
+    }
+    ASSERT_EQ(found, 4);
+    ASSERT_EQ(HITLS_CFG_GetSessionCacheStats(config, &stats), HITLS_SUCCESS);
+    ASSERT_EQ(stats.hits, 4);
+    ASSERT_EQ(stats.misses, 2);
+
+    sess = NewCacheTestSession(10, 0);
+    ASSERT_TRUE(sess != NULL);
+    SESSMGR_InsertSession(config->sessMgr, sess, false);
+    ASSERT_TRUE(SESSMGR_HasMacthSessionId(config->sessMgr, sess->sessionId, (uint8_t)sess->sessionIdSize));
+    ASSERT_TRUE(!FindCacheTestSession(config->sessMgr, 10));
+    ASSERT_TRUE(!SESSMGR_HasMacthSessionId(config->sessMgr, sess->sessionId, (uint8_t)sess->sessionIdSize));
+    ASSERT_EQ(HITLS_CFG_GetSessionCacheStats(config, &stats), HITLS_SUCCESS);
+    ASSERT_EQ(stats.number, 3);
+    ASSERT_EQ(stats.timeouts, 1);
+    HITLS_SESS_Free(sess);
+
+    sess = NewCacheTestSession(11, 0);
+    ASSERT_TRUE(sess != NULL);
+    SESSMGR_InsertSession(config->sessMgr, sess, false);
+    SESSMGR_ClearTimeout(config->sessMgr);
+    ASSERT_TRUE(!SESSMGR_HasMacthSessionId(config->sessMgr, sess->sessionId, (uint8_t)sess->sessionIdSize));
+    ASSERT_EQ(HITLS_CFG_GetSessionCacheStats(config, &stats), HITLS_SUCCESS);
+    ASSERT_EQ(stats.number, 3);
+    ASSERT_EQ(stats.timeouts, 2);
+EXIT:
+    HITLS_SESS_Free(sess);
+    HITLS_CFG_FreeConfig(config);
+}
+/* END_CASE */
+
+/* @
+* @test UT_TLS_CFG_SESSIONCACHE_CLEAR_TIMEOUT_FUNC_TC001
+* @title   Test that SESSMGR_ClearTimeout removes all timed out sessions over successive calls
+* @brief   1. Insert 4096 valid sessions, then 2048 timed out sessions. Expected result 1.
+*          2. Clear the timed out sessions once. Expected result 2.
+*          3. Clear the timed out sessions until the cache holds only the valid ones. Expected result 3.
+* @expect  1. The timed out sessions are ahead of the valid ones in the lru order of the shards.
+*          2. Only a bounded number of sessions is checked, the valid ones at the back of the shards are checked first
+*             and no timed out session is removed.
+*          3. All timed out sessions are removed within a bounded number of calls, and the valid ones are kept.
+@ */
+/* BEGIN_CASE */
+void UT_TLS_CFG_SESSIONCACHE_CLEAR_TIMEOUT_FUNC_TC001()
+{
+    HitlsInit();
+    HITLS_Session *sess = NULL;
+    HITLS_SessCacheStats stats = {0};
+    HITLS_Config *config = HITLS_CFG_NewTLS12Config();
+    ASSERT_TRUE(config != NULL);
+    ASSERT_EQ(HITLS_CFG_SetSessionCacheSize(config, 8192), HITLS_SUCCESS);
+    for (uint16_t i = 0; i < 6144; i++) {
+        sess = NewCacheTestSession(i, i < 4096 ? 7200 : 0);
+        ASSERT_TRUE(sess != NULL);
+        SESSMGR_InsertSession(config->sessMgr, sess, false);
+        HITLS_SESS_Free(sess);
+        sess = NULL;
+    }
+
+    SESSMGR_ClearTimeout(config->sessMgr);
+    ASSERT_EQ(HITLS_CFG_GetSessionCacheStats(config, &stats), HITLS_SUCCESS);
+    ASSERT_EQ(stats.number, 6144);
+    ASSERT_EQ(stats.timeouts, 0);
+
+    uint32_t calls = 1;
+    while (stats.number > 4096 && calls < 1024) {  // 1024: far more calls than the sessions of a shard need
+        SESSMGR_ClearTimeout(config->sessMgr);
+        calls++;
+        ASSERT_EQ(HITLS_CFG_GetSessionCacheStats(config, &stats), HITLS_SUCCESS);
+    }
+    ASSERT_EQ(stats.number, 4096);
+    ASSERT_EQ(stats.timeouts, 2048);
+    ASSERT_EQ(stats.evictions, 0);
+    ASSERT_TRUE(FindCacheTestSession(config->sessMgr, 0));
+    ASSERT_TRUE(FindCacheTestSession(config->sessMgr, 4095));
+    ASSERT_TRUE(!FindCacheTestSession(config->sessMgr, 4096));
+EXIT:
+    HITLS_SESS_Free(sess);
+    HITLS_CFG_FreeConfig(config);
+}
+/* END_CASE */
+
 /* @
 * @test UT_TLS_CFG_SET_GET_SESSION_TIMEOUT_API_TC001
 * @title   Test HITLS_CFG_GetSessionTimeout interface
@@ -1662,6 +2025,153 @@ EXIT:
 }
 /* END_CASE */
 
+static int32_t TestAppendSndMsg(FRAME_LinkObj *link, uint8_t *buf, uint32_t bufLen, uint32_t *len)
+{
+    FrameUioUserData *ioUserData = BSL_UIO_GetUserData(link->io);
+    if (memcpy_s(&buf[*len], bufLen - *len, ioUserData->sndMsg.msg, ioUserData->sndMsg.len) != EOK) {
+        return HITLS_MEMCPY_FAIL;
+    }
+    *len += ioUserData->sndMsg.len;
+    ioUserData->sndMsg.len = 0;
+    return HITLS_SUCCESS;
+}
+
+/* @
+* @test  UT_TLS_CFG_SET_READ_BATCH_FUNC_TC001
+* @title  The app records received by one socket read are decrypted by one read if read batching is set
+* @precon  nan
+* @brief  1. Establish a TLS1.3 connection with read ahead and a read batch number of 4. Expected result 1.
+*         2. The client sends two app records, a KeyUpdate message and an app record, and the server receives them by
+*            one socket read. Expected result 2.
+*         3. The server reads the app data with a small buffer and obtains the pending bytes. Expected result 3.
+*         4. The server reads the app data. Expected result 4.
+* @expect 1. The connection is established.
+*         2. The first read returns the data of the two app records, and the record after the KeyUpdate message is
+*            not read.
+*         3. The remaining data of the last record is pending.
+*         4. The remaining data of the last record is read.
+@ */
+/* BEGIN_CASE */
+void UT_TLS_CFG_SET_READ_BATCH_FUNC_TC001(void)
+{
+    FRAME_Init();
+    FRAME_LinkObj *client = NULL;
+    FRAME_LinkObj *server = NULL;
+    uint8_t msg[DATA_MAX_LEN] = {0};
+    uint32_t msgLen = 0;
+    HITLS_Config *config = HITLS_CFG_NewTLS13Config();
+    ASSERT_TRUE(config != NULL);
+    ASSERT_EQ(HITLS_CFG_SetReadAhead(config, 1), HITLS_SUCCESS);
+    ASSERT_EQ(HITLS_CFG_SetReadBatchNum(config, HITLS_MAX_READ_BATCH_NUM + 1), HITLS_CONFIG_INVALID_SET);
+    ASSERT_EQ(HITLS_CFG_SetReadBatchNum(config, 4), HITLS_SUCCESS);
+    uint32_t batchNum = 0;
+    ASSERT_EQ(HITLS_CFG_GetReadBatchNum(config, &batchNum), HITLS_SUCCESS);
+    ASSERT_EQ(batchNum, 4);
+
+    client = FRAME_CreateLink(config, BSL_UIO_TCP);
+    server = FRAME_CreateLink(config, BSL_UIO_TCP);
+    ASSERT_TRUE(client != NULL);
+    ASSERT_TRUE(server != NULL);
+    ASSERT_EQ(FRAME_CreateConnection(client, server, true, HS_STATE_BUTT), HITLS_SUCCESS);
+
+    uint32_t writeLen = 0;
+    ASSERT_EQ(HITLS_Write(client->ssl, (const uint8_t *)"hello", strlen("hello"), &writeLen), HITLS_SUCCESS);
+    ASSERT_EQ(TestAppendSndMsg(client, msg, sizeof(msg), &msgLen), HITLS_SUCCESS);
+    ASSERT_EQ(HITLS_Write(client->ssl, (const uint8_t *)"world", strlen("world"), &writeLen), HITLS_SUCCESS);
+    ASSERT_EQ(TestAppendSndMsg(client, msg, sizeof(msg), &msgLen), HITLS_SUCCESS);
+    ASSERT_EQ(HITLS_KeyUpdate(client->ssl, HITLS_UPDATE_NOT_REQUESTED), HITLS_SUCCESS);
+    ASSERT_EQ(HITLS_Connect(client->ssl), HITLS_SUCCESS);
+    ASSERT_EQ(TestAppendSndMsg(client, msg, sizeof(msg), &msgLen), HITLS_SUCCESS);
+    ASSERT_EQ(HITLS_Write(client->ssl, (const uint8_t *)"again", strlen("again"), &writeLen), HITLS_SUCCESS);
+    ASSERT_EQ(TestAppendSndMsg(client, msg, sizeof(msg), &msgLen), HITLS_SUCCESS);
+    ASSERT_EQ(FRAME_TransportRecMsg(server->io, msg, msgLen), HITLS_SUCCESS);
+
+    uint8_t dest[DATA_MAX_LEN] = {0};
+    uint32_t readLen = 0;
+    ASSERT_EQ(HITLS_Read(server->ssl, dest, sizeof(dest), &readLen), HITLS_SUCCESS);
+    ASSERT_EQ(readLen, strlen("helloworld"));
+    ASSERT_EQ(memcmp(dest, "helloworld", readLen), 0);
+
+    ASSERT_EQ(HITLS_Read(server->ssl, dest, 2, &readLen), HITLS_SUCCESS);
+    ASSERT_EQ(readLen, 2);
+    ASSERT_EQ(memcmp(dest, "ag", readLen), 0);
+    ASSERT_EQ(HITLS_GetReadPendingBytes(server->ssl), strlen("ain"));
+    ASSERT_EQ(HITLS_Read(server->ssl, dest, sizeof(dest), &readLen), HITLS_SUCCESS);
+    ASSERT_EQ(readLen, strlen("ain"));
+    ASSERT_EQ(memcmp(dest, "ain", readLen), 0);
+    ASSERT_EQ(HITLS_GetReadPendingBytes(server->ssl), 0);
+EXIT:
+    HITLS_CFG_FreeConfig(config);
+    FRAME_FreeLink(client);
+    FRAME_FreeLink(server);
+}
+/* END_CASE */
+
+/* @
+* @test  UT_TLS_CFG_SET_WRITE_BATCH_FUNC_TC001
+* @title  The app data longer than one record is sent by one write if write batching is set
+* @precon  nan
+* @brief  1. Call HITLS_CFG_SetWriteBatchNum to set the batch number to 17. Expected result 1.
+*         2. Set the batch number to 2 and call HITLS_CFG_GetWriteBatchNum. Expected result 2.
+*         3. Establish a connection and the client writes data longer than one record. Expected result 3.
+*         4. The server reads the data. Expected result 4.
+* @expect 1. return HITLS_CONFIG_INVALID_SET
+*         2. The batch number is 2.
+*         3. All data is written and the two records are sent by one write back-to-back.
+*         4. The data read by the server is the same as the data sent by the client.
+@ */
+/* BEGIN_CASE */
+void UT_TLS_CFG_SET_WRITE_BATCH_FUNC_TC001(int tlsVersion)
+{
+    FRAME_Init();
+    FRAME_LinkObj *client = NULL;
+    FRAME_LinkObj *server = NULL;
+    uint8_t src[REC_MAX_PLAIN_TEXT_LENGTH + DATA_MAX_LEN];
+    uint8_t dest[REC_MAX_PLAIN_TEXT_LENGTH + DATA_MAX_LEN];
+    HITLS_Config *config = GetHitlsConfigViaVersion(tlsVersion);
+    ASSERT_TRUE(config != NULL);
+
+    uint32_t batchNum = 0;
+    ASSERT_EQ(HITLS_CFG_SetWriteBatchNum(config, HITLS_MAX_WRITE_BATCH_NUM + 1), HITLS_CONFIG_INVALID_SET);
+    ASSERT_EQ(HITLS_CFG_SetWriteBatchNum(config, 2), HITLS_SUCCESS);
+    ASSERT_EQ(HITLS_CFG_GetWriteBatchNum(config, &batchNum), HITLS_SUCCESS);
+    ASSERT_EQ(batchNum, 2);
+
+    client = FRAME_CreateLink(config, BSL_UIO_TCP);
+    server = FRAME_CreateLink(config, BSL_UIO_TCP);
+    ASSERT_TRUE(client != NULL);
+    ASSERT_TRUE(server != NULL);
+    ASSERT_EQ(FRAME_CreateConnection(client, server, true, HS_STATE_BUTT), HITLS_SUCCESS);
+
+    for (uint32_t i = 0; i < sizeof(src); i++) {
+        src[i] = (uint8_t)i;
+    }
+    uint32_t writeLen = 0;
+    ASSERT_EQ(HITLS_Write(client->ssl, src, sizeof(src), &writeLen), HITLS_SUCCESS);
+    ASSERT_EQ(writeLen, sizeof(src));
+
+    FrameUioUserData *ioClientData = BSL_UIO_GetUserData(client->io);
+    uint8_t *firstRecord = ioClientData->sndMsg.msg;
+    uint32_t firstRecordLen = REC_TLS_RECORD_HEADER_LEN + BSL_ByteToUint16(&firstRecord[REC_TLS_RECORD_LENGTH_OFFSET]);
+    ASSERT_TRUE(ioClientData->sndMsg.len > firstRecordLen + REC_TLS_RECORD_HEADER_LEN + DATA_MAX_LEN);
+    ASSERT_EQ(firstRecord[0], REC_TYPE_APP);
+    ASSERT_EQ(firstRecord[firstRecordLen], REC_TYPE_APP);
+    ASSERT_EQ(FRAME_TrasferMsgBetweenLink(client, server), HITLS_SUCCESS);
+
+    uint32_t readLen = 0;
+    while (readLen < sizeof(dest)) {
+        uint32_t readbytes = 0;
+        ASSERT_EQ(HITLS_Read(server->ssl, &dest[readLen], sizeof(dest) - readLen, &readbytes), HITLS_SUCCESS);
+        readLen += readbytes;
+    }
+    ASSERT_EQ(memcmp(dest, src, sizeof(src)), 0);
+EXIT:
+    HITLS_CFG_FreeConfig(config);
+    FRAME_FreeLink(client);
+    FRAME_FreeLink(server);
+}
+/* END_CASE */
+
 /* @
 * @test  UT_CONFIG_SET_KeyLogCb_TC001
 * @spec  -
@@ -1687,4 +2197,57 @@ void UT_TLS_CFG_SET_KeyLogCb_TC001()
 EXIT:
     HITLS_CFG_FreeConfig(config);
 }
-/* END_CASE */
\ No newline at end of file
+/* END_CASE */
+
+/* @
+* @test  UT_TLS_CFG_SHARE_LIST_FUNC_TC001
+* @spec  -
+* @title  The lists of the config are shared with the connection until one side sets them.
+* @precon  nan
+* @brief   1. Create a connection from a config with an alpn list. Expected result 1 is obtained.
+*          2. Set the cipher suites on the connection. Expected result 2 is obtained.
+*          3. Set the groups on the config. Expected result 3 is obtained.
+* @expect  1. The connection refers to the cipher suites, groups and alpn list of the config.
+*          2. The connection gets its own cipher suites, those of the config are unchanged.
+*          3. The config gets new groups, those of the connection are unchanged.
+@ */
+/* BEGIN_CASE */
+void UT_TLS_CFG_SHARE_LIST_FUNC_TC001()
+{
+    FRAME_Init();
+    HITLS_Ctx *ctx = NULL;
+    uint8_t alpn[] = {2, 'h', '2'};
+    uint16_t cipherSuite[] = {HITLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256};
+    uint16_t group[] = {HITLS_EC_GROUP_CURVE25519};
+    HITLS_Config *config = HITLS_CFG_NewTLS12Config();
+    ASSERT_TRUE(config != NULL);
+    ASSERT_EQ(HITLS_CFG_SetAlpnProtos(config, alpn, sizeof(alpn)), HITLS_SUCCESS);
+
+    ctx = HITLS_New(config);
+    ASSERT_TRUE(ctx != NULL);
+    TLS_Config *ctxConfig = &ctx->config.tlsConfig;
+    ASSERT_TRUE(ctxConfig->cipherSuites == config->cipherSuites);
+    ASSERT_TRUE(ctxConfig->groups == config->groups);
+    ASSERT_TRUE(ctxConfig->alpnList == config->alpnList);
+
+    uint16_t *cfgCipherSuites = config->cipherSuites;
+    uint32_t cfgCipherSuitesSize = config->cipherSuitesSize;
+    ASSERT_EQ(HITLS_SetCipherSuites(ctx, cipherSuite, sizeof(cipherSuite) / sizeof(uint16_t)), HITLS_SUCCESS);
+    ASSERT_TRUE(ctxConfig->cipherSuites != cfgCipherSuites);
+    ASSERT_EQ(ctxConfig->cipherSuitesSize, 1);
+    ASSERT_TRUE(config->cipherSuites == cfgCipherSuites);
+    ASSERT_EQ(config->cipherSuitesSize, cfgCipherSuitesSize);
+
+    uint16_t *ctxGroups = ctxConfig->groups;
+    uint32_t ctxGroupsSize = ctxConfig->groupsSize;
+    uint16_t firstGroup = ctxGroups[0];
+    ASSERT_EQ(HITLS_CFG_SetGroups(config, group, sizeof(group) / sizeof(uint16_t)), HITLS_SUCCESS);
+    ASSERT_TRUE(config->groups != ctxGroups);
+    ASSERT_TRUE(ctxConfig->groups == ctxGroups);
+    ASSERT_EQ(ctxConfig->groupsSize, ctxGroupsSize);
+    ASSERT_EQ(ctxConfig->groups[0], firstGroup);
+EXIT:
+    HITLS_Free(ctx);
+    HITLS_CFG_FreeConfig(config);
+}
+/* END_CASE */
@@ -306,4 +306,176 @@ EXIT:
     HITLS_CFG_FreeConfig(tlsConfig);
     HITLS_Free(ctx);
 }
-/* END_CASE */
\ No newline at end of file
+/* END_CASE */
+
+static uint32_t g_certEncodeNum = 0;
+
+/* Counts the certificates which are encoded, a list served from the cache encodes none. */
+static int32_t STUB_SAL_CERT_X509Encode(HITLS_Ctx *ctx, HITLS_CERT_X509 *cert, uint8_t *buf, uint32_t len,
+    uint32_t *usedLen)
+{
+    g_certEncodeNum++;
+    return HITLS_X509_Adapt_CertEncode(ctx, cert, buf, len, usedLen);
+}
+
+static int32_t EncodeCertChainOfCtx(HITLS_Ctx *ctx, uint8_t *buf, uint32_t bufLen, uint32_t *usedLen)
+{
+    ctx->negotiatedInfo.version = ctx->config.tlsConfig.maxVersion;
+    return SAL_CERT_EncodeCertChain(ctx, buf, bufLen, usedLen);
+}
+
+/* @
+* @test  UT_TLS_CERT_ENCODE_CERT_CHAIN_CACHE_FUNC_TC001
+* @title  The encoded certificate list is shared by the connections of a config until the certificates are changed.
+* @precon  nan
+* @brief  1. Load the certificate, the private key and an intermediate certificate to the config, and create two
+*            connections. Expected result 1
+*         2. Encode the certificate list of both connections, counting the encoded certificates. Expected result 2
+*         3. Add the CA certificate to the chain of the second connection and encode both lists again. Expected
+*            result 3
+*         4. Add the CA certificate to the chain of the config and encode the list of a new connection. Expected
+*            result 4
+* @expect  1. The connections share the cache of the config
+*          2. The lists are the same, and no certificate is encoded for the second one
+*          3. The list of the second connection includes the CA certificate, the list of the first one is unchanged
+*          4. The list is the same as the one of the second connection
+@ */
+/* BEGIN_CASE */
+void UT_TLS_CERT_ENCODE_CERT_CHAIN_CACHE_FUNC_TC001(int version, char *certFile, char *keyFile, char *interFile,
+    char *caFile)
+{
+    HitlsInit();
+    HITLS_Config *tlsConfig = NULL;
+    HITLS_Ctx *ctx1 = NULL;
+    HITLS_Ctx *ctx2 = NULL;
+    HITLS_Ctx *ctx3 = NULL;
+    uint8_t buf1[BUF_MAX_SIZE] = {0};
+    uint8_t buf2[BUF_MAX_SIZE] = {0};
+    uint8_t buf3[BUF_MAX_SIZE] = {0};
+    uint32_t len1 = 0;
+    uint32_t len2 = 0;
+    uint32_t len3 = 0;
+    FuncStubInfo tmpStubInfo = {0};
+
+    tlsConfig = HitlsNewCtx(version);
+    ASSERT_TRUE(tlsConfig != NULL);
+    ASSERT_EQ(HITLS_CFG_LoadCertFile(tlsConfig, certFile, TLS_PARSE_FORMAT_ASN1), HITLS_SUCCESS);
+    ASSERT_EQ(HITLS_CFG_LoadKeyFile(tlsConfig, keyFile, TLS_PARSE_FORMAT_ASN1), HITLS_SUCCESS);
+    HITLS_CERT_X509 *inter = HiTLS_X509_LoadCertFile(tlsConfig, interFile);
+    ASSERT_TRUE(inter != NULL);
+    ASSERT_EQ(HITLS_CFG_AddChainCert(tlsConfig, inter, false), HITLS_SUCCESS);
+
+    ctx1 = HITLS_New(tlsConfig);
+    ASSERT_TRUE(ctx1 != NULL);
+    ctx2 = HITLS_New(tlsConfig);
+    ASSERT_TRUE(ctx2 != NULL);
+    ASSERT_TRUE(ctx1->config.tlsConfig.certMgrCtx->encodeCache != NULL);
+    ASSERT_TRUE(ctx1->config.tlsConfig.certMgrCtx->encodeCache == tlsConfig->certMgrCtx->encodeCache);
+    ASSERT_TRUE(ctx2->config.tlsConfig.certMgrCtx->encodeCache == tlsConfig->certMgrCtx->encodeCache);
+
+    STUB_Init();
+    STUB_Replace(&tmpStubInfo, SAL_CERT_X509Encode, STUB_SAL_CERT_X509Encode);
+    g_certEncodeNum = 0;
+    ASSERT_EQ(EncodeCertChainOfCtx(ctx1, buf1, sizeof(buf1), &len1), HITLS_SUCCESS);
+    ASSERT_EQ(g_certEncodeNum, 2);
+    ASSERT_EQ(EncodeCertChainOfCtx(ctx2, buf2, sizeof(buf2), &len2), HITLS_SUCCESS);
+    ASSERT_EQ(g_certEncodeNum, 2);
+    ASSERT_TRUE(len1 > 0);
+    ASSERT_COMPARE("cached list", buf1, len1, buf2, len2);
+
+    HITLS_CERT_X509 *ca = HiTLS_X509_LoadCertFile(tlsConfig, caFile);
+    ASSERT_TRUE(ca != NULL);
+    ASSERT_EQ(HITLS_CFG_AddChainCert(&ctx2->config.tlsConfig, ca, false), HITLS_SUCCESS);
+    ASSERT_TRUE(ctx2->config.tlsConfig.certMgrCtx->encodeCache != tlsConfig->certMgrCtx->encodeCache);
+    ASSERT_EQ(EncodeCertChainOfCtx(ctx2, buf2, sizeof(buf2), &len2), HITLS_SUCCESS);
+    ASSERT_TRUE(len2 > len1);
+    ASSERT_COMPARE("unchanged prefix", buf1, len1, buf2, len1);
+    ASSERT_EQ(EncodeCertChainOfCtx(ctx1, buf3, sizeof(buf3), &len3), HITLS_SUCCESS);
+    ASSERT_COMPARE("unchanged list", buf1, len1, buf3, len3);
+
+    ca = HiTLS_X509_LoadCertFile(tlsConfig, caFile);
+    ASSERT_TRUE(ca != NULL);
+    ASSERT_EQ(HITLS_CFG_AddChainCert(tlsConfig, ca, false), HITLS_SUCCESS);
+    ctx3 = HITLS_New(tlsConfig);
+    ASSERT_TRUE(ctx3 != NULL);
+    ASSERT_EQ(EncodeCertChainOfCtx(ctx3, buf3, sizeof(buf3), &len3), HITLS_SUCCESS);
+    ASSERT_COMPARE("changed list", buf2, len2, buf3, len3);
+EXIT:
+    STUB_Reset(&tmpStubInfo);
+    HITLS_CFG_FreeConfig(tlsConfig);
+    HITLS_Free(ctx1);
+    HITLS_Free(ctx2);
+    HITLS_Free(ctx3);
+}
+/* END_CASE */
+
+/* @
+* @test  UT_TLS_CERT_ENCODE_CERT_CHAIN_CACHE_FUNC_TC002
+* @title  The encoded certificate list built from the cert store is encoded again after the store is changed through
+*         the handle of the config.
+* @precon  nan
+* @brief  1. Load the certificate and the private key to the config without a chain, and create two connections.
+*            Expected result 1
+*         2. Encode the certificate list of both connections, counting the encoded certificates. Expected result 2
+*         3. Add the intermediate certificate to the store returned by HITLS_CFG_GetCertStore and encode the list of
+*            the first connection. Expected result 3
+*         4. Encode the list of the second connection. Expected result 4
+* @expect  1. Success
+*          2. The lists are the same, and no certificate is encoded for the second one
+*          3. The list is encoded again and includes the intermediate certificate
+*          4. The list is the same as the one of the first connection, and no certificate is encoded
+@ */
+/* BEGIN_CASE */
+void UT_TLS_CERT_ENCODE_CERT_CHAIN_CACHE_FUNC_TC002(int version, char *certFile, char *keyFile, char *interFile)
+{
+    HitlsInit();
+    HITLS_Config *tlsConfig = NULL;
+    HITLS_Ctx *ctx1 = NULL;
+    HITLS_Ctx *ctx2 = NULL;
+    HITLS_CERT_X509 *inter = NULL;
+    uint8_t buf1[BUF_MAX_SIZE] = {0};
+    uint8_t buf2[BUF_MAX_SIZE] = {0};
+    uint32_t len1 = 0;
+    uint32_t len2 = 0;
+    FuncStubInfo tmpStubInfo = {0};
+
+    tlsConfig = HitlsNewCtx(version);
+    ASSERT_TRUE(tlsConfig != NULL);
+    ASSERT_EQ(HITLS_CFG_LoadCertFile(tlsConfig, certFile, TLS_PARSE_FORMAT_ASN1), HITLS_SUCCESS);
+    ASSERT_EQ(HITLS_CFG_LoadKeyFile(tlsConfig, keyFile, TLS_PARSE_FORMAT_ASN1), HITLS_SUCCESS);
+    ctx1 = HITLS_New(tlsConfig);
+    ASSERT_TRUE(ctx1 != NULL);
+    ctx2 = HITLS_New(tlsConfig);
+    ASSERT_TRUE(ctx2 != NULL);
+
+    STUB_Init();
+    STUB_Replace(&tmpStubInfo, SAL_CERT_X509Encode, STUB_SAL_CERT_X509Encode);
+    g_certEncodeNum = 0;
+    ASSERT_EQ(EncodeCertChainOfCtx(ctx1, buf1, sizeof(buf1), &len1), HITLS_SUCCESS);
+    ASSERT_EQ(g_certEncodeNum, 1);
+    ASSERT_EQ(EncodeCertChainOfCtx(ctx2, buf2, sizeof(buf2), &len2), HITLS_SUCCESS);
+    ASSERT_EQ(g_certEncodeNum, 1);
+    ASSERT_COMPARE("cached list", buf1, len1, buf2, len2);
+
+    inter = HiTLS_X509_LoadCertFile(tlsConfig, interFile);
+    ASSERT_TRUE(inter != NULL);
+    HITLS_CERT_Store *store = HITLS_CFG_GetCertStore(tlsConfig);
+    ASSERT_TRUE(store != NULL);
+    ASSERT_EQ(HITLS_X509_Adapt_StoreCtrl(tlsConfig, store, CERT_STORE_CTRL_ADD_CERT_LIST, inter, NULL), HITLS_SUCCESS);
+    inter = NULL;
+    ASSERT_EQ(EncodeCertChainOfCtx(ctx1, buf1, sizeof(buf1), &len1), HITLS_SUCCESS);
+    ASSERT_EQ(g_certEncodeNum, 3);
+    ASSERT_TRUE(len1 > len2);
+    ASSERT_COMPARE("unchanged prefix", buf1, len2, buf2, len2);
+
+    ASSERT_EQ(EncodeCertChainOfCtx(ctx2, buf2, sizeof(buf2), &len2), HITLS_SUCCESS);
+    ASSERT_EQ(g_certEncodeNum, 3);
+    ASSERT_COMPARE("changed list", buf1, len1, buf2, len2);
+EXIT:
+    STUB_Reset(&tmpStubInfo);
+    HITLS_X509_CertFree(inter);
+    HITLS_CFG_FreeConfig(tlsConfig);
+    HITLS_Free(ctx1);
+    HITLS_Free(ctx2);
+}
+/* END_CASE */
@@ -86,7 +86,7 @@ static int32_t SavePendingData(TLS_Ctx *ctx, const uint8_t *data, uint32_t dataL
 static int32_t CheckDataLen(TLS_Ctx *ctx, const uint8_t *data, uint32_t *sendLen)
 {
     uint32_t maxWriteLen = 0u;
-    int32_t ret = REC_GetMaxWriteSize(ctx, &maxWriteLen);
+    int32_t ret = REC_GetMaxAppWriteSize(ctx, &maxWriteLen);
     if (ret != HITLS_SUCCESS) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID15660, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN,
             "APP: Get record max write size fail.", 0, 0, 0, 0);
@@ -719,6 +719,44 @@ static int32_t EncodeCertStore(HITLS_Ctx *ctx, uint8_t *buf, uint32_t bufLen, ui
     *usedLen = offset;
     return HITLS_SUCCESS;
 }
+
+static int32_t EncodeCertList(HITLS_Ctx *ctx, CERT_Pair *currentCertPair, uint8_t *buf, uint32_t bufLen,
+    uint32_t *usedLen)
+{
+    HITLS_CERT_X509 *cert = NULL;
+    uint32_t offset = 0;
+    int32_t ret = EncodeEECert(ctx, buf, bufLen, usedLen, &cert);
+    if (ret != HITLS_SUCCESS) {
+        return RETURN_ERROR_NUMBER_PROCESS(ret, BINLOG_ID15046, "encode device cert err");
+    }
+    offset += *usedLen;
+    uint32_t listSize = (uint32_t)BSL_LIST_COUNT(currentCertPair->chain);
+    // Check the size. If a certificate exists in the chain, directly put the data in the chain into the buf and return.
+    if (listSize > 0) {
+        return EncodeCertificateChain(ctx, buf, bufLen, usedLen, offset);
+    }
+    *usedLen = offset;
+    return EncodeCertStore(ctx, buf, bufLen, usedLen, cert);
+}
+
+/*
+ * The encoded list only depends on the certificates of the manager, unless the certificate entries of TLS 1.3 carry
+ * custom extensions, which are packed by the callbacks of the connection.
+ */
+static bool IsEncodeCacheUsable(const HITLS_Ctx *ctx)
+{
+    if (ctx->config.tlsConfig.certMgrCtx->encodeCache == NULL) {
+        return false;
+    }
+#ifdef HITLS_TLS_PROTO_TLS13
+    if (ctx->negotiatedInfo.version == HITLS_VERSION_TLS13 &&
+        IsPackNeedCustomExtensions(CUSTOM_EXT_FROM_CTX(ctx), HITLS_EX_TYPE_TLS1_3_CERTIFICATE)) {
+        return false;
+    }
+#endif
+    return true;
+}
+
 /*
  * The constructed certificate chain is incomplete (excluding the root certificate).
  * Therefore, in the buildCertChain callback, the return value is ignored, even if the error returned by this call.
@@ -734,7 +772,6 @@ int32_t SAL_CERT_EncodeCertChain(HITLS_Ctx *ctx, uint8_t *buf, uint32_t bufLen,
         BSL_ERR_PUSH_ERROR(HITLS_NULL_INPUT);
         return RETURN_ERROR_NUMBER_PROCESS(HITLS_NULL_INPUT, BINLOG_ID16323, "input null");
     }
-    HITLS_CERT_X509 *cert = NULL;
     HITLS_Config *config = &ctx->config.tlsConfig;
     CERT_MgrCtx *mgrCtx = config->certMgrCtx;
     if (mgrCtx == NULL) {
@@ -748,19 +785,17 @@ int32_t SAL_CERT_EncodeCertChain(HITLS_Ctx *ctx, uint8_t *buf, uint32_t bufLen,
         *usedLen = 0;
         return HITLS_SUCCESS;
     }
-    uint32_t offset = 0;
-    ret = EncodeEECert(ctx, buf, bufLen, usedLen, &cert);
-    if (ret != HITLS_SUCCESS) {
-        return RETURN_ERROR_NUMBER_PROCESS(ret, BINLOG_ID15046, "encode device cert err");
+    CERT_EncodeCacheKey key = { 0 };
+    bool useCache = IsEncodeCacheUsable(ctx) && SAL_CERT_EncodeCacheGetKey(ctx, currentCertPair, &key);
+    uint32_t generation = 0;
+    if (useCache && SAL_CERT_EncodeCacheGet(ctx, &key, buf, bufLen, usedLen, &generation)) {
+        return HITLS_SUCCESS;
     }
-    offset += *usedLen;
-    uint32_t listSize = (uint32_t)BSL_LIST_COUNT(currentCertPair->chain);
-    // Check the size. If a certificate exists in the chain, directly put the data in the chain into the buf and return.
-    if (listSize > 0) {
-        return EncodeCertificateChain(ctx, buf, bufLen, usedLen, offset);
+    ret = EncodeCertList(ctx, currentCertPair, buf, bufLen, usedLen);
+    if (ret == HITLS_SUCCESS && useCache) {
+        SAL_CERT_EncodeCacheSet(ctx, &key, generation, buf, *usedLen);
     }
-    *usedLen = offset;
-    return EncodeCertStore(ctx, buf, bufLen, usedLen, cert);
+    return ret;
 }
 
 #ifdef HITLS_TLS_PROTO_TLS13
@@ -0,0 +1,208 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hitls_build.h"
+#include "securec.h"
+#include "bsl_sal.h"
+#include "bsl_list.h"
+#include "hitls_error.h"
+#include "hitls_security.h"
+#include "hitls_x509_adapt.h"
+#include "tls.h"
+#include "cert_mgr.h"
+#include "cert_mgr_ctx.h"
+
+/* A server has one certificate of each key type and negotiates few versions, the oldest entry is replaced. */
+#define CERT_ENCODE_CACHE_SIZE 8u
+
+typedef struct {
+    CERT_EncodeCacheKey key;
+    uint8_t *data;          /* NULL if the entry is not used */
+    uint32_t dataLen;
+} EncodeCacheEntry;
+
+struct CertEncodeCacheInner {
+    BSL_SAL_RefCount references;
+    BSL_SAL_ThreadLockHandle lock;
+    uint32_t generation;    /* increased on every flush, so that an encoding started before it is not inserted */
+    uint32_t next;          /* entry to be replaced when the cache is full */
+    EncodeCacheEntry entries[CERT_ENCODE_CACHE_SIZE];
+};
+
+/* Not through SAL_CERT_StoreCtrl, a store method which does not count the changes only disables the cache. */
+static int32_t EncodeCacheGetStoreGen(HITLS_Config *config, HITLS_CERT_Store *store, uint32_t *storeGen)
+{
+#ifdef HITLS_TLS_FEATURE_PROVIDER
+    return HITLS_X509_Adapt_StoreCtrl(config, store, CERT_STORE_CTRL_GET_CHAIN_GEN, NULL, storeGen);
+#else
+    return config->certMgrCtx->method.certStoreCtrl(config, store, CERT_STORE_CTRL_GET_CHAIN_GEN, NULL, storeGen);
+#endif
+}
+
+bool SAL_CERT_EncodeCacheGetKey(HITLS_Ctx *ctx, CERT_Pair *certPair, CERT_EncodeCacheKey *key)
+{
+    HITLS_Config *config = &ctx->config.tlsConfig;
+    CERT_MgrCtx *mgrCtx = config->certMgrCtx;
+    key->keyType = mgrCtx->currentCertKeyType;
+    key->version = ctx->negotiatedInfo.version;
+    key->securityCb = config->securityCb;
+    key->securityExData = config->securityExData;
+    key->securityLevel = config->securityLevel;
+    key->store = NULL;
+    key->storeGen = 0;
+    if (BSL_LIST_COUNT(certPair->chain) > 0) {
+        return true;
+    }
+    /* The chain is built from the store, which may be changed without the manager knowing it. */
+    key->store = (mgrCtx->chainStore != NULL) ? mgrCtx->chainStore : mgrCtx->certStore;
+    return key->store == NULL || EncodeCacheGetStoreGen(config, key->store, &key->storeGen) == HITLS_SUCCESS;
+}
+
+static bool EncodeCacheKeyEqual(const CERT_EncodeCacheKey *a, const CERT_EncodeCacheKey *b)
+{
+    return a->keyType == b->keyType && a->version == b->version && a->securityCb == b->securityCb &&
+        a->securityExData == b->securityExData && a->securityLevel == b->securityLevel && a->store == b->store &&
+        a->storeGen == b->storeGen;
+}
+
+static EncodeCacheEntry *EncodeCacheFind(CERT_EncodeCache *cache, const CERT_EncodeCacheKey *key)
+{
+    for (uint32_t i = 0; i < CERT_ENCODE_CACHE_SIZE; i++) {
+        if (cache->entries[i].data != NULL && EncodeCacheKeyEqual(&cache->entries[i].key, key)) {
+            return &cache->entries[i];
+        }
+    }
+    return NULL;
+}
+
+static void EncodeCacheFlush(CERT_EncodeCache *cache)
+{
+    for (uint32_t i = 0; i < CERT_ENCODE_CACHE_SIZE; i++) {
+        BSL_SAL_FREE(cache->entries[i].data);
+        cache->entries[i].dataLen = 0;
+    }
+    cache->next = 0;
+    cache->generation++;
+}
+
+CERT_EncodeCache *SAL_CERT_EncodeCacheNew(void)
+{
+    CERT_EncodeCache *cache = BSL_SAL_Calloc(1u, sizeof(CERT_EncodeCache));
+    if (cache == NULL) {
+        return NULL;
+    }
+    if (BSL_SAL_ThreadLockNew(&cache->lock) != BSL_SUCCESS) {
+        BSL_SAL_FREE(cache);
+        return NULL;
+    }
+    if (BSL_SAL_ReferencesInit(&cache->references) != BSL_SUCCESS) {
+        BSL_SAL_ThreadLockFree(cache->lock);
+        BSL_SAL_FREE(cache);
+        return NULL;
+    }
+    return cache;
+}
+
+CERT_EncodeCache *SAL_CERT_EncodeCacheRef(CERT_EncodeCache *cache)
+{
+    if (cache != NULL) {
+        int ref = 0;
+        (void)BSL_SAL_AtomicUpReferences(&cache->references, &ref);
+    }
+    return cache;
+}
+
+void SAL_CERT_EncodeCacheFree(CERT_EncodeCache *cache)
+{
+    if (cache == NULL) {
+        return;
+    }
+    int ref = 0;
+    (void)BSL_SAL_AtomicDownReferences(&cache->references, &ref);
+    if (ref > 0) {
+        return;
+    }
+    EncodeCacheFlush(cache);
+    BSL_SAL_ThreadLockFree(cache->lock);
+    BSL_SAL_ReferencesFree(&cache->references);
+    BSL_SAL_Free(cache);
+}
+
+void SAL_CERT_ResetEncodeCache(CERT_MgrCtx *mgrCtx)
+{
+    if (mgrCtx == NULL) {
+        return;
+    }
+    CERT_EncodeCache *cache = mgrCtx->encodeCache;
+    if (cache != NULL) {
+        /* The stores are shared with the duplicated managers, so the lists of the other owners may be stale too. */
+        (void)BSL_SAL_ThreadWriteLock(cache->lock);
+        EncodeCacheFlush(cache);
+        (void)BSL_SAL_ThreadUnlock(cache->lock);
+        SAL_CERT_EncodeCacheFree(cache);
+    }
+    /* The changed manager no longer shares the lists of the others. Without a cache the lists are just encoded. */
+    mgrCtx->encodeCache = SAL_CERT_EncodeCacheNew();
+}
+
+bool SAL_CERT_EncodeCacheGet(HITLS_Ctx *ctx, const CERT_EncodeCacheKey *key, uint8_t *buf, uint32_t bufLen,
+    uint32_t *usedLen, uint32_t *generation)
+{
+    CERT_EncodeCache *cache = ctx->config.tlsConfig.certMgrCtx->encodeCache;
+    bool found = false;
+    (void)BSL_SAL_ThreadReadLock(cache->lock);
+    EncodeCacheEntry *entry = EncodeCacheFind(cache, key);
+    if (entry != NULL && entry->dataLen <= bufLen) {
+        (void)memcpy_s(buf, bufLen, entry->data, entry->dataLen);
+        *usedLen = entry->dataLen;
+        found = true;
+    }
+    *generation = cache->generation;
+    (void)BSL_SAL_ThreadUnlock(cache->lock);
+    return found;
+}
+
+void SAL_CERT_EncodeCacheSet(HITLS_Ctx *ctx, const CERT_EncodeCacheKey *key, uint32_t generation,
+    const uint8_t *data, uint32_t dataLen)
+{
+    CERT_EncodeCache *cache = ctx->config.tlsConfig.certMgrCtx->encodeCache;
+    uint8_t *copy = BSL_SAL_Dump(data, dataLen);
+    if (copy == NULL) {
+        return;
+    }
+    (void)BSL_SAL_ThreadWriteLock(cache->lock);
+    if (cache->generation != generation || EncodeCacheFind(cache, key) != NULL) {
+        (void)BSL_SAL_ThreadUnlock(cache->lock);
+        BSL_SAL_Free(copy);
+        return;
+    }
+    EncodeCacheEntry *entry = NULL;
+    for (uint32_t i = 0; i < CERT_ENCODE_CACHE_SIZE && entry == NULL; i++) {
+        if (cache->entries[i].data == NULL) {
+            entry = &cache->entries[i];
+        }
+    }
+    if (entry == NULL) {
+        entry = &cache->entries[cache->next];
+        cache->next = (cache->next + 1) % CERT_ENCODE_CACHE_SIZE;
+        BSL_SAL_Free(entry->data);
+    }
+    entry->key = *key;
+    entry->data = copy;
+    entry->dataLen = dataLen;
+    (void)BSL_SAL_ThreadUnlock(cache->lock);
+}
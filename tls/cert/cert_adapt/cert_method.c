@@ -298,6 +298,7 @@ uint32_t g_tlsCertCtrlErrorCode[] = {
     HITLS_CERT_KEY_CTRL_ERR_IS_KEY_CERT_SIGN_USAGE,
     HITLS_CERT_KEY_CTRL_ERR_IS_KEY_AGREEMENT_USAGE,
     HITLS_CERT_KEY_CTRL_ERR_GET_PARAM_ID,
+    HITLS_CERT_STORE_CTRL_ERR_GET_CHAIN_GEN,
 };
 
 int32_t SAL_CERT_StoreCtrl(HITLS_Config *config, HITLS_CERT_Store *store, HITLS_CERT_CtrlCmd cmd, void *in, void *out)
@@ -159,6 +159,8 @@ CERT_MgrCtx *SAL_CERT_MgrCtxDup(CERT_MgrCtx *mgrCtx)
 
     newCtx->libCtx = LIBCTX_FROM_CERT_MGR_CTX(mgrCtx);
     newCtx->attrName = ATTRIBUTE_FROM_CERT_MGR_CTX(mgrCtx);
+    /* The duplicate has the same certificates, so the encoded certificate lists are shared until one is changed. */
+    newCtx->encodeCache = SAL_CERT_EncodeCacheRef(mgrCtx->encodeCache);
     return newCtx;
 }
 
@@ -167,6 +169,8 @@ void SAL_CERT_MgrCtxFree(CERT_MgrCtx *mgrCtx)
     if (mgrCtx == NULL) {
         return;
     }
+    SAL_CERT_EncodeCacheFree(mgrCtx->encodeCache);
+    mgrCtx->encodeCache = NULL;
     SAL_CERT_ClearCertAndKey(mgrCtx);
     SAL_CERT_ChainFree(mgrCtx->extraChain);
     mgrCtx->extraChain = NULL;
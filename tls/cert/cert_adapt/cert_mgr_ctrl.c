@@ -33,6 +33,7 @@ int32_t SAL_CERT_SetCertStore(CERT_MgrCtx *mgrCtx, HITLS_CERT_Store *store)
     }
     SAL_CERT_StoreFree(mgrCtx, mgrCtx->certStore);
     mgrCtx->certStore = store;
+    SAL_CERT_ResetEncodeCache(mgrCtx);
     return HITLS_SUCCESS;
 }
 
@@ -53,6 +54,7 @@ int32_t SAL_CERT_SetChainStore(CERT_MgrCtx *mgrCtx, HITLS_CERT_Store *store)
     }
     SAL_CERT_StoreFree(mgrCtx, mgrCtx->chainStore);
     mgrCtx->chainStore = store;
+    SAL_CERT_ResetEncodeCache(mgrCtx);
     return HITLS_SUCCESS;
 }
 
@@ -158,6 +160,7 @@ int32_t SAL_CERT_SetCurrentCert(HITLS_Config *config, HITLS_CERT_X509 *cert, boo
     SAL_CERT_X509Free(*certPairCert);
     *certPairCert = cert;
     mgrCtx->currentCertKeyType = keyType;
+    SAL_CERT_ResetEncodeCache(mgrCtx);
     return HITLS_SUCCESS;
 }
 
@@ -242,6 +245,7 @@ int32_t SAL_CERT_SetCurrentPrivateKey(HITLS_Config *config, HITLS_CERT_Key *key,
     SAL_CERT_KeyFree(mgrCtx, *certPairPrivateKey);
     *certPairPrivateKey = key;
     mgrCtx->currentCertKeyType = keyType;
+    SAL_CERT_ResetEncodeCache(mgrCtx);
     return HITLS_SUCCESS;
 }
 
@@ -320,6 +324,7 @@ int32_t SAL_CERT_AddChainCert(CERT_MgrCtx *mgrCtx, HITLS_CERT_X509 *cert)
         return ret;
     }
     certPair->chain = chain;
+    SAL_CERT_ResetEncodeCache(mgrCtx);
     return HITLS_SUCCESS;
 }
 
@@ -353,6 +358,7 @@ void SAL_CERT_ClearCurrentChainCerts(CERT_MgrCtx *mgrCtx)
     }
     SAL_CERT_ChainFree(certPair->chain);
     certPair->chain = NULL;
+    SAL_CERT_ResetEncodeCache(mgrCtx);
     return;
 }
 
@@ -371,6 +377,10 @@ void SAL_CERT_ClearCertAndKey(CERT_MgrCtx *mgrCtx)
         it = BSL_HASH_Erase(certPairs, keyType);
     }
     mgrCtx->currentCertKeyType = TLS_CERT_KEY_TYPE_UNKNOWN;
+    /* The cache has been released if the manager is being freed. */
+    if (mgrCtx->encodeCache != NULL) {
+        SAL_CERT_ResetEncodeCache(mgrCtx);
+    }
     return;
 }
 
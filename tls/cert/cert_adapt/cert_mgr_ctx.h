@@ -18,8 +18,10 @@
 #include <stdint.h>
 #include "hitls_crypt_type.h"
 #include "hitls_cert_reg.h"
+#include "hitls_security.h"
 #include "cert.h"
 #include "bsl_hash.h"
+#include "sal_atomic.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -28,6 +30,20 @@ extern "C" {
 #define TLS_DEFAULT_VERIFY_DEPTH 20u
 #define CERT_DEFAULT_HASH_BKT_SIZE 64u
 
+/* Encoded certificate lists of the handshake, shared by a manager and its duplicates. */
+typedef struct CertEncodeCacheInner CERT_EncodeCache;
+
+/* Everything the encoded certificate list depends on, besides the certificates of the manager. */
+typedef struct {
+    uint32_t keyType;
+    uint16_t version;
+    HITLS_SecurityCb securityCb;
+    void *securityExData;
+    int32_t securityLevel;
+    HITLS_CERT_Store *store;    /* store the chain is built from, NULL if the chain is set */
+    uint32_t storeGen;          /* change counter of the store, it can be changed through the handle of the config */
+} CERT_EncodeCacheKey;
+
 struct CertVerifyParamInner {
     uint32_t verifyDepth;   /* depth of verify */
     uint32_t purpose;       /* purpose to check untrusted certificates */
@@ -63,6 +79,7 @@ struct CertMgrCtxInner {
 
     HITLS_Lib_Ctx *libCtx;          /* library context */
     const char *attrName;              /* attrName */
+    CERT_EncodeCache *encodeCache;     /* Encoded certificate lists, NULL if no certificate is set. */
 };
 
 CERT_Type CertKeyType2CertType(HITLS_CERT_KeyType keyType);
@@ -78,6 +95,49 @@ int32_t SAL_CERT_ChainAppend(HITLS_CERT_Chain *chain, HITLS_CERT_X509 *cert);
 void SAL_CERT_ChainFree(HITLS_CERT_Chain *chain);
 HITLS_CERT_Chain *SAL_CERT_ChainDup(CERT_MgrCtx *mgrCtx, HITLS_CERT_Chain *chain);
 
+CERT_EncodeCache *SAL_CERT_EncodeCacheNew(void);
+CERT_EncodeCache *SAL_CERT_EncodeCacheRef(CERT_EncodeCache *cache);
+void SAL_CERT_EncodeCacheFree(CERT_EncodeCache *cache);
+
+/**
+ * @brief   Obtain the cache key of the encoded certificate list of the current certificate.
+ *
+ * @param   ctx [IN] TLS context
+ * @param   certPair [IN] Current certificate of the manager
+ * @param   key [OUT] Cache key
+ *
+ * @retval  false if the list cannot be cached, as the store does not count its changes.
+ */
+bool SAL_CERT_EncodeCacheGetKey(HITLS_Ctx *ctx, CERT_Pair *certPair, CERT_EncodeCacheKey *key);
+
+/**
+ * @brief   Obtain the encoded certificate list of the current certificate from the cache of the manager.
+ *
+ * @param   ctx [IN] TLS context, the manager of which has a cache
+ * @param   key [IN] Key returned by SAL_CERT_EncodeCacheGetKey
+ * @param   buf [OUT] Buffer of the certificate list
+ * @param   bufLen [IN] Maximum length of the buffer
+ * @param   usedLen [OUT] Length of the certificate list
+ * @param   generation [OUT] Version of the cache, to be passed to SAL_CERT_EncodeCacheSet on a miss
+ *
+ * @retval  true if the list is cached, false otherwise.
+ */
+bool SAL_CERT_EncodeCacheGet(HITLS_Ctx *ctx, const CERT_EncodeCacheKey *key, uint8_t *buf, uint32_t bufLen,
+    uint32_t *usedLen, uint32_t *generation);
+
+/**
+ * @brief   Add the encoded certificate list of the current certificate to the cache of the manager.
+ *          The list is dropped if the cache is flushed after SAL_CERT_EncodeCacheGet.
+ *
+ * @param   ctx [IN] TLS context, the manager of which has a cache
+ * @param   key [IN] Key passed to SAL_CERT_EncodeCacheGet
+ * @param   generation [IN] Version returned by SAL_CERT_EncodeCacheGet
+ * @param   data [IN] Certificate list
+ * @param   dataLen [IN] Length of the certificate list
+ */
+void SAL_CERT_EncodeCacheSet(HITLS_Ctx *ctx, const CERT_EncodeCacheKey *key, uint32_t generation,
+    const uint8_t *data, uint32_t dataLen);
+
 #define LIBCTX_FROM_CERT_MGR_CTX(mgrCtx) ((mgrCtx == NULL) ? NULL : (mgrCtx)->libCtx)
 #define ATTRIBUTE_FROM_CERT_MGR_CTX(mgrCtx) ((mgrCtx == NULL) ? NULL : (mgrCtx)->attrName)
 
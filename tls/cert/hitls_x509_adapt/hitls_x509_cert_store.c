@@ -51,13 +51,14 @@ int32_t HITLS_X509_Adapt_StoreCtrl(HITLS_Config *config, HITLS_CERT_Store *store
     void *input, void *output)
 {
     (void)config;
-    (void)output;
     switch (cmd) {
         case CERT_STORE_CTRL_SET_VERIFY_DEPTH:
             return HITLS_X509_StoreCtxCtrl(store, HITLS_X509_STORECTX_SET_PARAM_DEPTH, input, sizeof(int32_t));
         case CERT_STORE_CTRL_ADD_CERT_LIST:
             return HITLS_X509_StoreCtxCtrl(store, HITLS_X509_STORECTX_SHALLOW_COPY_SET_CA, input,
                 sizeof(HITLS_X509_Cert));
+        case CERT_STORE_CTRL_GET_CHAIN_GEN:
+            return HITLS_X509_StoreCtxCtrl(store, HITLS_X509_STORECTX_GET_CHAIN_GEN, output, sizeof(uint32_t));
         default:
             return HITLS_CERT_SELF_ADAPT_ERR;
     }
@@ -97,6 +97,9 @@ int32_t SAL_CERT_SelectCertByInfo(HITLS_Ctx *ctx, CERT_ExpectInfo *info);
 
 /**
  * @brief Encode the certificate chain in ASN.1 DER format.
+ *        The encoded list is cached by the certificate manager and shared by the connections of the same config,
+ *        until the certificates or the stores of the manager are changed, or the cas of the store which the chain
+ *        is built from are changed.
  *
  * @param ctx     [IN] tls Context
  * @param buf     [OUT] Certificate encoding data
@@ -278,6 +278,16 @@ void SAL_CERT_ClearCurrentChainCerts(CERT_MgrCtx *mgrCtx);
  */
 void SAL_CERT_ClearCertAndKey(CERT_MgrCtx *mgrCtx);
 
+/**
+ * @brief   Drop the encoded certificate lists after the certificates of the manager are changed.
+ *          The lists cached by the duplicated managers are dropped too, as they share the stores.
+ *
+ * @param   mgrCtx [IN] Certificate management struct
+ *
+ * @return  void
+ */
+void SAL_CERT_ResetEncodeCache(CERT_MgrCtx *mgrCtx);
+
 int32_t SAL_CERT_AddExtraChainCert(CERT_MgrCtx *mgrCtx, HITLS_CERT_X509 *cert);
 
 HITLS_CERT_Chain *SAL_CERT_GetExtraChainCerts(CERT_MgrCtx *mgrCtx);
@@ -104,6 +104,34 @@ extern "C" {
         } \
     } while (0)
 
+/**
+ * The lists of a configuration, such as the cipher suites, groups and signature algorithms, are shared by reference
+ * between the configuration and the connections created from it. A setter never changes a list in place, it replaces
+ * the list with a new one, so a connection only gets its own copy of a list when it is set on that connection.
+ */
+typedef void (*CFG_ListCleanup)(void *list, uint32_t len);
+
+/** allocate a zeroed list of len bytes holding one reference */
+void *CFG_ListCalloc(uint32_t len);
+
+/** allocate a list holding one reference and copy len bytes of src to it */
+void *CFG_ListDump(const void *src, uint32_t len);
+
+/** grow a list that is not shared yet, the list is left unchanged on failure */
+void *CFG_ListRealloc(void *list, uint32_t newLen, uint32_t oldLen);
+
+/** take a reference of the list, list can be NULL */
+void *CFG_ListRef(void *list);
+
+/** release a reference of the list, the last one calls cleanup, if any, and frees the list */
+void CFG_ListFree(void *list, CFG_ListCleanup cleanup);
+
+#define CFG_LIST_FREE(list)          \
+    do {                             \
+        CFG_ListFree((list), NULL);  \
+        (list) = NULL;               \
+    } while (0)
+
 /** clear the TLS configuration */
 void CFG_CleanConfig(HITLS_Config *config);
 
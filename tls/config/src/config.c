@@ -41,6 +41,7 @@
 #ifdef HITLS_TLS_FEATURE_SESSION
 #include "session_mgr.h"
 #endif
+#include "config.h"
 #include "config_check.h"
 #include "config_default.h"
 #include "bsl_list.h"
@@ -73,38 +74,127 @@ void HITLS_CFG_ClearCAList(HITLS_Config *config)
     return;
 }
 #endif
+typedef struct {
+    BSL_SAL_RefCount references;
+    uint32_t len;
+} CfgListHead;
+
+/* Keep the list behind the head aligned for any element type. */
+#define CFG_LIST_HEAD_SIZE ((sizeof(CfgListHead) + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1))
+#define CFG_LIST_HEAD(list) ((CfgListHead *)(void *)((uint8_t *)(list) - CFG_LIST_HEAD_SIZE))
+
+void *CFG_ListCalloc(uint32_t len)
+{
+    CfgListHead *head = BSL_SAL_Calloc(1u, CFG_LIST_HEAD_SIZE + len);
+    if (head == NULL) {
+        return NULL;
+    }
+    if (BSL_SAL_ReferencesInit(&head->references) != BSL_SUCCESS) {
+        BSL_SAL_Free(head);
+        return NULL;
+    }
+    head->len = len;
+    return (uint8_t *)head + CFG_LIST_HEAD_SIZE;
+}
+
+void *CFG_ListDump(const void *src, uint32_t len)
+{
+    if (src == NULL) {
+        return NULL;
+    }
+    uint8_t *list = CFG_ListCalloc(len);
+    if (list != NULL && len != 0) {
+        (void)memcpy_s(list, len, src, len);
+    }
+    return list;
+}
+
+void *CFG_ListRealloc(void *list, uint32_t newLen, uint32_t oldLen)
+{
+    if (list == NULL) {
+        return CFG_ListCalloc(newLen);
+    }
+    CfgListHead *head = BSL_SAL_Realloc(CFG_LIST_HEAD(list), CFG_LIST_HEAD_SIZE + newLen, CFG_LIST_HEAD_SIZE + oldLen);
+    if (head == NULL) {
+        return NULL;
+    }
+    head->len = newLen;
+    return (uint8_t *)head + CFG_LIST_HEAD_SIZE;
+}
+
+void *CFG_ListRef(void *list)
+{
+    if (list != NULL) {
+        int ref = 0;
+        (void)BSL_SAL_AtomicUpReferences(&CFG_LIST_HEAD(list)->references, &ref);
+    }
+    return list;
+}
+
+void CFG_ListFree(void *list, CFG_ListCleanup cleanup)
+{
+    if (list == NULL) {
+        return;
+    }
+    CfgListHead *head = CFG_LIST_HEAD(list);
+    int ref = 0;
+    (void)BSL_SAL_AtomicDownReferences(&head->references, &ref);
+    if (ref > 0) {
+        return;
+    }
+    if (cleanup != NULL) {
+        cleanup(list, head->len);
+    }
+    BSL_SAL_ReferencesFree(&head->references);
+    BSL_SAL_Free(head);
+}
+
+#ifdef HITLS_TLS_FEATURE_PROVIDER
+static void GroupInfoCleanup(void *list, uint32_t len)
+{
+    TLS_GroupInfo *groupInfo = list;
+    for (uint32_t i = 0; i < len / sizeof(TLS_GroupInfo); i++) {
+        BSL_SAL_FREE(groupInfo[i].name);
+    }
+}
+
+static void SigSchemeInfoCleanup(void *list, uint32_t len)
+{
+    TLS_SigSchemeInfo *sigSchemeInfo = list;
+    for (uint32_t i = 0; i < len / sizeof(TLS_SigSchemeInfo); i++) {
+        BSL_SAL_FREE(sigSchemeInfo[i].name);
+    }
+}
+#endif
+
 void CFG_CleanConfig(HITLS_Config *config)
 {
-    BSL_SAL_FREE(config->cipherSuites);
+    CFG_LIST_FREE(config->cipherSuites);
 #ifdef HITLS_TLS_PROTO_TLS13
-    BSL_SAL_FREE(config->tls13CipherSuites);
+    CFG_LIST_FREE(config->tls13CipherSuites);
 #endif
-    BSL_SAL_FREE(config->pointFormats);
-    BSL_SAL_FREE(config->groups);
-    BSL_SAL_FREE(config->signAlgorithms);
+    CFG_LIST_FREE(config->pointFormats);
+    CFG_LIST_FREE(config->groups);
+    CFG_LIST_FREE(config->signAlgorithms);
 #ifdef HITLS_TLS_FEATURE_PROVIDER
-    for (uint32_t i = 0; i < config->groupInfolen; i++) {
-        BSL_SAL_FREE(config->groupInfo[i].name);
-    }
-    BSL_SAL_FREE(config->groupInfo);
+    CFG_ListFree(config->groupInfo, GroupInfoCleanup);
+    config->groupInfo = NULL;
     config->groupInfoSize = 0;
     config->groupInfolen = 0;
-    for (uint32_t i = 0; i < config->sigSchemeInfolen; i++) {
-        BSL_SAL_FREE(config->sigSchemeInfo[i].name);
-    }
-    BSL_SAL_FREE(config->sigSchemeInfo);
+    CFG_ListFree(config->sigSchemeInfo, SigSchemeInfoCleanup);
+    config->sigSchemeInfo = NULL;
     config->sigSchemeInfoSize = 0;
     config->sigSchemeInfolen = 0;
 #endif
 
 #if defined(HITLS_TLS_PROTO_TLS12) && defined(HITLS_TLS_FEATURE_PSK)
-    BSL_SAL_FREE(config->pskIdentityHint);
+    CFG_LIST_FREE(config->pskIdentityHint);
 #endif
 #ifdef HITLS_TLS_FEATURE_ALPN
-    BSL_SAL_FREE(config->alpnList);
+    CFG_LIST_FREE(config->alpnList);
 #endif
 #ifdef HITLS_TLS_FEATURE_SNI
-    BSL_SAL_FREE(config->serverName);
+    CFG_LIST_FREE(config->serverName);
 #endif
 #ifdef HITLS_TLS_EXTENSION_CERT_AUTH
     BSL_LIST_FREE(config->caList, HitlsTrustedCANodeFree);
@@ -130,8 +220,8 @@ static void ShallowCopy(HITLS_Ctx *ctx, const HITLS_Config *srcConfig)
     HITLS_Config *destConfig = &ctx->config.tlsConfig;
 
     /*
-     * Other parameters except CipherSuite, PointFormats, Group, SignAlgorithms, Psk, SessionId, CertMgr, and SessMgr
-     * are shallowly copied, and some of them reference globalConfig.
+     * Other parameters except the lists, SessionId, CertMgr, and SessMgr are shallowly copied, and some of them
+     * reference globalConfig.
      */
     destConfig->libCtx = LIBCTX_FROM_CONFIG(srcConfig);
     destConfig->attrName = ATTRIBUTE_FROM_CONFIG(srcConfig);
@@ -142,6 +232,8 @@ static void ShallowCopy(HITLS_Ctx *ctx, const HITLS_Config *srcConfig)
     destConfig->maxCertList = srcConfig->maxCertList;
     destConfig->isSupportExtendMasterSecret = srcConfig->isSupportExtendMasterSecret;
     destConfig->emptyRecordsNum = srcConfig->emptyRecordsNum;
+    destConfig->writeBatchNum = srcConfig->writeBatchNum;
+    destConfig->readBatchNum = srcConfig->readBatchNum;
     destConfig->isKeepPeerCert = srcConfig->isKeepPeerCert;
     destConfig->version = srcConfig->version;
     destConfig->originVersionMask = srcConfig->originVersionMask;
@@ -221,162 +313,49 @@ static void ShallowCopy(HITLS_Ctx *ctx, const HITLS_Config *srcConfig)
 #endif
 }
 
-static int32_t DeepCopy(void** destConfig, const void* srcConfig, uint32_t logId, uint32_t len)
-{
-    BSL_SAL_FREE(*destConfig);
-    *destConfig = BSL_SAL_Dump(srcConfig, len);
-    if (*destConfig == NULL) {
-        BSL_LOG_BINLOG_FIXLEN(logId, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "Dump fail", 0, 0, 0, 0);
-        return HITLS_MEMALLOC_FAIL;
-    }
-    return HITLS_SUCCESS;
-}
-
-static int32_t PointFormatsCfgDeepCopy(HITLS_Config *destConfig, const HITLS_Config *srcConfig)
+static void ListCfgShare(void **destList, void *srcList)
 {
-    if (srcConfig->pointFormats != NULL) {
-        int32_t ret = DeepCopy((void **)&destConfig->pointFormats, srcConfig->pointFormats, BINLOG_ID16584,
-            srcConfig->pointFormatsSize * sizeof(uint8_t));
-        if (ret != HITLS_SUCCESS) {
-            return ret;
-        }
-        destConfig->pointFormatsSize = srcConfig->pointFormatsSize;
-    }
-    return HITLS_SUCCESS;
+    CFG_ListFree(*destList, NULL);
+    *destList = CFG_ListRef(srcList);
 }
 
-static int32_t GroupCfgDeepCopy(HITLS_Config *destConfig, const HITLS_Config *srcConfig)
+/* The lists are shared with the source config, the connection copies a list only when a setter replaces it. */
+static void ListsCfgShare(HITLS_Config *destConfig, const HITLS_Config *srcConfig)
 {
-    if (srcConfig->groups != NULL) {
-        int32_t ret = DeepCopy((void **)&destConfig->groups, srcConfig->groups, BINLOG_ID16585,
-            srcConfig->groupsSize * sizeof(uint16_t));
-        if (ret != HITLS_SUCCESS) {
-            return ret;
-        }
-        destConfig->groupsSize = srcConfig->groupsSize;
-    }
+    ListCfgShare((void **)&destConfig->cipherSuites, srcConfig->cipherSuites);
+    destConfig->cipherSuitesSize = srcConfig->cipherSuitesSize;
+#ifdef HITLS_TLS_PROTO_TLS13
+    ListCfgShare((void **)&destConfig->tls13CipherSuites, srcConfig->tls13CipherSuites);
+    destConfig->tls13cipherSuitesSize = srcConfig->tls13cipherSuitesSize;
+#endif
+    ListCfgShare((void **)&destConfig->pointFormats, srcConfig->pointFormats);
+    destConfig->pointFormatsSize = srcConfig->pointFormatsSize;
+    ListCfgShare((void **)&destConfig->groups, srcConfig->groups);
+    destConfig->groupsSize = srcConfig->groupsSize;
+    ListCfgShare((void **)&destConfig->signAlgorithms, srcConfig->signAlgorithms);
+    destConfig->signAlgorithmsSize = srcConfig->signAlgorithmsSize;
 #ifdef HITLS_TLS_FEATURE_PROVIDER
-    if (srcConfig->groupInfo != NULL) {
-        if (destConfig->groupInfo != NULL) {
-            BSL_SAL_FREE(destConfig->groupInfo->name);
-            BSL_SAL_FREE(destConfig->groupInfo);
-        }
-        destConfig->groupInfo= BSL_SAL_Calloc(srcConfig->groupInfolen, sizeof(TLS_GroupInfo));
-        if (destConfig->groupInfo == NULL) {
-            return HITLS_MEMALLOC_FAIL;
-        }
-        for (uint32_t i = 0; i < srcConfig->groupInfolen; i++) {
-            destConfig->groupInfo[i] = srcConfig->groupInfo[i];
-            destConfig->groupInfo[i].name = BSL_SAL_Dump(srcConfig->groupInfo[i].name, strlen(srcConfig->groupInfo[i].name) + 1);
-            if (destConfig->groupInfo[i].name == NULL) {
-                return HITLS_MEMALLOC_FAIL;
-            }
-        }
-        destConfig->groupInfoSize = srcConfig->groupInfolen;
-        destConfig->groupInfolen = srcConfig->groupInfolen;
-    }
+    CFG_ListFree(destConfig->groupInfo, GroupInfoCleanup);
+    destConfig->groupInfo = CFG_ListRef(srcConfig->groupInfo);
+    destConfig->groupInfoSize = srcConfig->groupInfoSize;
+    destConfig->groupInfolen = srcConfig->groupInfolen;
+    CFG_ListFree(destConfig->sigSchemeInfo, SigSchemeInfoCleanup);
+    destConfig->sigSchemeInfo = CFG_ListRef(srcConfig->sigSchemeInfo);
+    destConfig->sigSchemeInfoSize = srcConfig->sigSchemeInfoSize;
+    destConfig->sigSchemeInfolen = srcConfig->sigSchemeInfolen;
 #endif
-    return HITLS_SUCCESS;
-}
-
 #if defined(HITLS_TLS_PROTO_TLS12) && defined(HITLS_TLS_FEATURE_PSK)
-static int32_t PskCfgDeepCopy(HITLS_Config *destConfig, const HITLS_Config *srcConfig)
-{
-    if (srcConfig->pskIdentityHint != NULL) {
-        BSL_SAL_FREE(destConfig->pskIdentityHint);
-        destConfig->pskIdentityHint = BSL_SAL_Dump(srcConfig->pskIdentityHint, srcConfig->hintSize * sizeof(uint8_t));
-        if (destConfig->pskIdentityHint == NULL) {
-            BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16586, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "Dump fail", 0, 0, 0, 0);
-            return HITLS_MEMALLOC_FAIL;
-        }
-        destConfig->hintSize = srcConfig->hintSize;
-    }
-    return HITLS_SUCCESS;
-}
+    ListCfgShare((void **)&destConfig->pskIdentityHint, srcConfig->pskIdentityHint);
+    destConfig->hintSize = srcConfig->hintSize;
 #endif
-static int32_t SignAlgorithmsCfgDeepCopy(HITLS_Config *destConfig, const HITLS_Config *srcConfig)
-{
-    if (srcConfig->signAlgorithms != NULL) {
-        int32_t ret = DeepCopy((void **)&destConfig->signAlgorithms, srcConfig->signAlgorithms, BINLOG_ID16587,
-            srcConfig->signAlgorithmsSize * sizeof(uint16_t));
-        if (ret != HITLS_SUCCESS) {
-            return ret;
-        }
-        destConfig->signAlgorithmsSize = srcConfig->signAlgorithmsSize;
-    }
-#ifdef HITLS_TLS_FEATURE_PROVIDER
-    if (srcConfig->sigSchemeInfo != NULL) {
-        BSL_SAL_FREE(destConfig->sigSchemeInfo);
-        destConfig->sigSchemeInfo = BSL_SAL_Calloc(srcConfig->sigSchemeInfolen, sizeof(TLS_SigSchemeInfo));
-        if (destConfig->sigSchemeInfo == NULL) {
-            return HITLS_MEMALLOC_FAIL;
-        }
-        for (uint32_t i = 0; i < srcConfig->sigSchemeInfolen; i++) {
-            destConfig->sigSchemeInfo[i] = srcConfig->sigSchemeInfo[i];
-            destConfig->sigSchemeInfo[i].name = BSL_SAL_Dump(srcConfig->sigSchemeInfo[i].name, strlen(srcConfig->sigSchemeInfo[i].name) + 1);
-            if (destConfig->sigSchemeInfo[i].name == NULL) {
-                return HITLS_MEMALLOC_FAIL;
-            }
-        }
-        destConfig->sigSchemeInfoSize = srcConfig->sigSchemeInfolen;
-        destConfig->sigSchemeInfolen = srcConfig->sigSchemeInfolen;
-    }
-#endif
-    return HITLS_SUCCESS;
-}
-
 #ifdef HITLS_TLS_FEATURE_ALPN
-static int32_t AlpnListDeepCopy(HITLS_Config *destConfig, const HITLS_Config *srcConfig)
-{
-    if (srcConfig->alpnListSize == 0 || srcConfig->alpnList == NULL) {
-        return HITLS_SUCCESS;
-    }
-    BSL_SAL_FREE(destConfig->alpnList);
-    destConfig->alpnList = BSL_SAL_Dump(srcConfig->alpnList, (srcConfig->alpnListSize + 1) * sizeof(uint8_t));
-    if (destConfig->alpnList == NULL) {
-        BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16588, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "Dump fail", 0, 0, 0, 0);
-        return HITLS_MEMALLOC_FAIL;
-    }
+    ListCfgShare((void **)&destConfig->alpnList, srcConfig->alpnList);
     destConfig->alpnListSize = srcConfig->alpnListSize;
-    return HITLS_SUCCESS;
-}
 #endif
 #ifdef HITLS_TLS_FEATURE_SNI
-static int32_t ServerNameDeepCopy(HITLS_Config *destConfig, const HITLS_Config *srcConfig)
-{
-    if (srcConfig->serverNameSize != 0 && srcConfig->serverName != NULL) {
-        int32_t ret = DeepCopy((void **)&destConfig->serverName, srcConfig->serverName, BINLOG_ID16589,
-            srcConfig->serverNameSize * sizeof(uint8_t));
-        if (ret != HITLS_SUCCESS) {
-            return ret;
-        }
-        destConfig->serverNameSize = srcConfig->serverNameSize;
-    }
-    return HITLS_SUCCESS;
-}
+    ListCfgShare((void **)&destConfig->serverName, srcConfig->serverName);
+    destConfig->serverNameSize = srcConfig->serverNameSize;
 #endif
-static int32_t CipherSuiteDeepCopy(HITLS_Config *destConfig, const HITLS_Config *srcConfig)
-{
-    if (srcConfig->cipherSuites != NULL) {
-        int32_t ret = DeepCopy((void **)&destConfig->cipherSuites, srcConfig->cipherSuites, BINLOG_ID16590,
-            srcConfig->cipherSuitesSize * sizeof(uint16_t));
-        if (ret != HITLS_SUCCESS) {
-            return ret;
-        }
-        destConfig->cipherSuitesSize = srcConfig->cipherSuitesSize;
-    }
-#ifdef HITLS_TLS_PROTO_TLS13
-    if (srcConfig->tls13CipherSuites != NULL) {
-        int32_t ret = DeepCopy((void **)&destConfig->tls13CipherSuites, srcConfig->tls13CipherSuites, BINLOG_ID16591,
-            srcConfig->tls13cipherSuitesSize * sizeof(uint16_t));
-        if (ret != HITLS_SUCCESS) {
-            BSL_SAL_FREE(destConfig->cipherSuites);
-            return ret;
-        }
-        destConfig->tls13cipherSuitesSize = srcConfig->tls13cipherSuitesSize;
-    }
-#endif
-    return HITLS_SUCCESS;
 }
 
 static int32_t CertMgrDeepCopy(HITLS_Config *destConfig, const HITLS_Config *srcConfig)
@@ -483,18 +462,6 @@ static int32_t BasicConfigDeepCopy(HITLS_Config *destConfig, const HITLS_Config
         return ret;
     }
 #endif
-#ifdef HITLS_TLS_FEATURE_ALPN
-    ret = AlpnListDeepCopy(destConfig, srcConfig);
-    if (ret != HITLS_SUCCESS) {
-        return ret;
-    }
-#endif
-#ifdef HITLS_TLS_FEATURE_SNI
-    ret = ServerNameDeepCopy(destConfig, srcConfig);
-    if (ret != HITLS_SUCCESS) {
-        return ret;
-    }
-#endif
 #ifdef HITLS_TLS_CONFIG_MANUAL_DH
     ret = CryptKeyDeepCopy(destConfig, srcConfig);
     if (ret != HITLS_SUCCESS) {
@@ -512,46 +479,19 @@ static int32_t BasicConfigDeepCopy(HITLS_Config *destConfig, const HITLS_Config
 
 int32_t DumpConfig(HITLS_Ctx *ctx, const HITLS_Config *srcConfig)
 {
-    int32_t ret;
     HITLS_Config *destConfig = &ctx->config.tlsConfig;
 
     // shallow copy
     ShallowCopy(ctx, srcConfig);
+    ListsCfgShare(destConfig, srcConfig);
 
-    ret = CipherSuiteDeepCopy(destConfig, srcConfig);
-    if (ret != HITLS_SUCCESS) {
-        goto EXIT;
-    }
-
-    ret = PointFormatsCfgDeepCopy(destConfig, srcConfig);
-    if (ret != HITLS_SUCCESS) {
-        goto EXIT;
-    }
-
-    ret = GroupCfgDeepCopy(destConfig, srcConfig);
-    if (ret != HITLS_SUCCESS) {
-        goto EXIT;
-    }
-
-    ret = SignAlgorithmsCfgDeepCopy(destConfig, srcConfig);
-    if (ret != HITLS_SUCCESS) {
-        goto EXIT;
-    }
-#if defined(HITLS_TLS_PROTO_TLS12) && defined(HITLS_TLS_FEATURE_PSK)
-    ret = PskCfgDeepCopy(destConfig, srcConfig);
+    int32_t ret = BasicConfigDeepCopy(destConfig, srcConfig);
     if (ret != HITLS_SUCCESS) {
-        goto EXIT;
-    }
-#endif
-    ret = BasicConfigDeepCopy(destConfig, srcConfig);
-    if (ret != HITLS_SUCCESS) {
-        goto EXIT;
+        CFG_CleanConfig(destConfig);
+        return ret;
     }
 
     return HITLS_SUCCESS;
-EXIT:
-    CFG_CleanConfig(destConfig);
-    return ret;
 }
 
 HITLS_Config *CreateConfig(void)
@@ -974,17 +914,17 @@ int32_t HITLS_CFG_SetCipherSuites(HITLS_Config *config, const uint16_t *cipherSu
 #endif
     GetCipherSuitesCnt(cipherSuites, cipherSuitesSize, &tls13CipherSize, &tlsCipherSize);
 
-    uint16_t *cipherSuite = BSL_SAL_Calloc(1u, (tlsCipherSize + 1) * sizeof(uint16_t));
+    uint16_t *cipherSuite = CFG_ListCalloc((tlsCipherSize + 1) * sizeof(uint16_t));
     if (cipherSuite == NULL) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16600, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "Calloc fail", 0, 0, 0, 0);
         return HITLS_MEMALLOC_FAIL;
     }
 #ifdef HITLS_TLS_PROTO_TLS13
-    uint16_t *tls13CipherSuite = BSL_SAL_Calloc(1u, (tls13CipherSize + 1) * sizeof(uint16_t));
+    uint16_t *tls13CipherSuite = CFG_ListCalloc((tls13CipherSize + 1) * sizeof(uint16_t));
 
     if (tls13CipherSuite == NULL) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16601, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "Calloc fail", 0, 0, 0, 0);
-        BSL_SAL_FREE(cipherSuite);
+        CFG_LIST_FREE(cipherSuite);
         return HITLS_MEMALLOC_FAIL;
     }
 #endif
@@ -1004,17 +944,17 @@ int32_t HITLS_CFG_SetCipherSuites(HITLS_Config *config, const uint16_t *cipherSu
     }
 #ifdef HITLS_TLS_PROTO_TLS13
     if (validTls13Cipher == 0) {
-        BSL_SAL_FREE(tls13CipherSuite);
+        CFG_LIST_FREE(tls13CipherSuite);
     } else {
-        BSL_SAL_FREE(config->tls13CipherSuites);
+        CFG_LIST_FREE(config->tls13CipherSuites);
         config->tls13CipherSuites = tls13CipherSuite;
         config->tls13cipherSuitesSize = validTls13Cipher;
     }
 #endif
     if (validTlsCipher == 0) {
-        BSL_SAL_FREE(cipherSuite);
+        CFG_LIST_FREE(cipherSuite);
     } else {
-        BSL_SAL_FREE(config->cipherSuites);
+        CFG_LIST_FREE(config->cipherSuites);
         config->cipherSuites = cipherSuite;
         config->cipherSuitesSize = validTlsCipher;
     }
@@ -1040,14 +980,14 @@ int32_t HITLS_CFG_SetEcPointFormats(HITLS_Config *config, const uint8_t *pointFo
         return HITLS_CONFIG_INVALID_LENGTH;
     }
 
-    uint8_t *newData = BSL_SAL_Dump(pointFormats, pointFormatsSize * sizeof(uint8_t));
+    uint8_t *newData = CFG_ListDump(pointFormats, pointFormatsSize * sizeof(uint8_t));
     /* If the allocation fails, an error code is returned. */
     if (newData == NULL) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16602, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "Dump fail", 0, 0, 0, 0);
         return HITLS_MEMALLOC_FAIL;
     }
     /* Reallocate the memory of pointFormats and update the length of pointFormats */
-    BSL_SAL_FREE(config->pointFormats);
+    CFG_LIST_FREE(config->pointFormats);
     config->pointFormats = newData;
     config->pointFormatsSize = pointFormatsSize;
     return HITLS_SUCCESS;
@@ -1064,7 +1004,7 @@ int32_t HITLS_CFG_SetGroups(HITLS_Config *config, const uint16_t *groups, uint32
         return HITLS_CONFIG_INVALID_LENGTH;
     }
 
-    uint16_t *newData = BSL_SAL_Dump(groups, groupsSize * sizeof(uint16_t));
+    uint16_t *newData = CFG_ListDump(groups, groupsSize * sizeof(uint16_t));
     /* If the allocation fails, return an error code */
     if (newData == NULL) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16603, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "Dump fail", 0, 0, 0, 0);
@@ -1073,7 +1013,7 @@ int32_t HITLS_CFG_SetGroups(HITLS_Config *config, const uint16_t *groups, uint32
     }
 
     /* Reallocate the memory of groups and update the length of groups */
-    BSL_SAL_FREE(config->groups);
+    CFG_LIST_FREE(config->groups);
     config->groups = newData;
     config->groupsSize = groupsSize;
     return HITLS_SUCCESS;
@@ -1309,6 +1249,58 @@ int32_t HITLS_CFG_GetReadAhead(HITLS_Config *config, int32_t *onOff)
     return HITLS_SUCCESS;
 }
 
+int32_t HITLS_CFG_SetWriteBatchNum(HITLS_Config *config, uint32_t batchNum)
+{
+    if (config == NULL) {
+        return HITLS_NULL_INPUT;
+    }
+    if (batchNum > HITLS_MAX_WRITE_BATCH_NUM) {
+        BSL_ERR_PUSH_ERROR(HITLS_CONFIG_INVALID_SET);
+        return HITLS_CONFIG_INVALID_SET;
+    }
+
+    config->writeBatchNum = batchNum;
+
+    return HITLS_SUCCESS;
+}
+
+int32_t HITLS_CFG_GetWriteBatchNum(const HITLS_Config *config, uint32_t *batchNum)
+{
+    if (config == NULL || batchNum == NULL) {
+        return HITLS_NULL_INPUT;
+    }
+
+    *batchNum = config->writeBatchNum;
+
+    return HITLS_SUCCESS;
+}
+
+int32_t HITLS_CFG_SetReadBatchNum(HITLS_Config *config, uint32_t batchNum)
+{
+    if (config == NULL) {
+        return HITLS_NULL_INPUT;
+    }
+    if (batchNum > HITLS_MAX_READ_BATCH_NUM) {
+        BSL_ERR_PUSH_ERROR(HITLS_CONFIG_INVALID_SET);
+        return HITLS_CONFIG_INVALID_SET;
+    }
+
+    config->readBatchNum = batchNum;
+
+    return HITLS_SUCCESS;
+}
+
+int32_t HITLS_CFG_GetReadBatchNum(const HITLS_Config *config, uint32_t *batchNum)
+{
+    if (config == NULL || batchNum == NULL) {
+        return HITLS_NULL_INPUT;
+    }
+
+    *batchNum = config->readBatchNum;
+
+    return HITLS_SUCCESS;
+}
+
 int32_t HITLS_CFG_SetSignature(HITLS_Config *config, const uint16_t *signAlgs, uint16_t signAlgsSize)
 {
     if ((config == NULL) || (signAlgs == NULL) || (signAlgsSize == 0)) {
@@ -1319,7 +1311,7 @@ int32_t HITLS_CFG_SetSignature(HITLS_Config *config, const uint16_t *signAlgs, u
         return HITLS_CONFIG_INVALID_LENGTH;
     }
 
-    uint16_t *newData = BSL_SAL_Dump(signAlgs, signAlgsSize * sizeof(uint16_t));
+    uint16_t *newData = CFG_ListDump(signAlgs, signAlgsSize * sizeof(uint16_t));
     /* If the allocation fails, return an error code. */
     if (newData == NULL) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16605, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "Dump fail", 0, 0, 0, 0);
@@ -1327,7 +1319,7 @@ int32_t HITLS_CFG_SetSignature(HITLS_Config *config, const uint16_t *signAlgs, u
     }
 
     /* Reallocate the signAlgs memory and update the signAlgs length */
-    BSL_SAL_FREE(config->signAlgorithms);
+    CFG_LIST_FREE(config->signAlgorithms);
     config->signAlgorithms = newData;
     config->signAlgorithmsSize = signAlgsSize;
     return HITLS_SUCCESS;
@@ -1346,7 +1338,7 @@ int32_t HITLS_CFG_SetServerName(HITLS_Config *config, uint8_t *serverName, uint3
     if (serverName[serverNameStrlen - 1] != '\0') {
         serverNameSize += 1;
     }
-    uint8_t *newData = (uint8_t *) BSL_SAL_Malloc(serverNameSize * sizeof(uint8_t));
+    uint8_t *newData = (uint8_t *)CFG_ListCalloc(serverNameSize * sizeof(uint8_t));
     if (newData == NULL) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16606, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "Calloc fail", 0, 0, 0, 0);
         return HITLS_MEMALLOC_FAIL;
@@ -1354,7 +1346,7 @@ int32_t HITLS_CFG_SetServerName(HITLS_Config *config, uint8_t *serverName, uint3
     (void)memcpy_s(newData, serverNameSize, serverName, serverNameStrlen);
     newData[serverNameSize - 1] = '\0';
     /* Reallocate the serverName memory and update the serverName length */
-    BSL_SAL_FREE(config->serverName);
+    CFG_LIST_FREE(config->serverName);
     config->serverName = newData;
     config->serverNameSize = serverNameSize;
     return HITLS_SUCCESS;
@@ -1478,14 +1470,14 @@ int32_t HITLS_CFG_SetPskIdentityHint(HITLS_Config *config, const uint8_t *hint,
         return HITLS_CONFIG_INVALID_LENGTH;
     }
 
-    uint8_t *newData = BSL_SAL_Dump(hint, hintSize * sizeof(uint8_t));
+    uint8_t *newData = CFG_ListDump(hint, hintSize * sizeof(uint8_t));
     if (newData == NULL) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16607, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "Dump fail", 0, 0, 0, 0);
         return HITLS_MEMALLOC_FAIL;
     }
 
     /* Repeated settings are supported */
-    BSL_SAL_FREE(config->pskIdentityHint);
+    CFG_LIST_FREE(config->pskIdentityHint);
     config->pskIdentityHint = newData;
     config->hintSize = hintSize;
 
@@ -1589,6 +1581,35 @@ int32_t HITLS_CFG_SetSessionTicketKey(HITLS_Config *config, const uint8_t *key,
 
     return SESSMGR_SetTicketKey(config->sessMgr, key, keySize);
 }
+
+int32_t HITLS_CFG_AddSessionTicketKey(HITLS_Config *config, const uint8_t *key, uint32_t keySize)
+{
+    if (config == NULL || config->sessMgr == NULL || key == NULL ||
+        (keySize != HITLS_TICKET_KEY_NAME_SIZE + HITLS_TICKET_KEY_SIZE + HITLS_TICKET_KEY_SIZE)) {
+        return HITLS_NULL_INPUT;
+    }
+
+    return SESSMGR_AddTicketKey(config->sessMgr, key, keySize);
+}
+
+int32_t HITLS_CFG_SetTicketKeyRotation(HITLS_Config *config, uint64_t interval, uint32_t keyNum)
+{
+    if (config == NULL || config->sessMgr == NULL) {
+        return HITLS_NULL_INPUT;
+    }
+
+    return SESSMGR_SetTicketKeyRotation(config->sessMgr, interval, keyNum);
+}
+
+int32_t HITLS_CFG_GetTicketKeyRotation(const HITLS_Config *config, uint64_t *interval, uint32_t *keyNum)
+{
+    if (config == NULL || config->sessMgr == NULL || interval == NULL || keyNum == NULL) {
+        return HITLS_NULL_INPUT;
+    }
+
+    SESSMGR_GetTicketKeyRotation(config->sessMgr, interval, keyNum);
+    return HITLS_SUCCESS;
+}
 #endif
 
 #if defined(HITLS_TLS_FEATURE_CERT_MODE) && defined(HITLS_TLS_FEATURE_RENEGOTIATION)
@@ -1665,7 +1686,7 @@ int32_t HITLS_CFG_SetAlpnProtos(HITLS_Config *config, const uint8_t *alpnProtos,
 
     /* If the input parameter is empty or the length is 0, clear the original alpn list */
     if (alpnProtosLen == 0 || alpnProtos == NULL) {
-        BSL_SAL_FREE(config->alpnList);
+        CFG_LIST_FREE(config->alpnList);
         config->alpnListSize = 0;
         return HITLS_SUCCESS;
     }
@@ -1675,7 +1696,7 @@ int32_t HITLS_CFG_SetAlpnProtos(HITLS_Config *config, const uint8_t *alpnProtos,
         return HITLS_CONFIG_INVALID_LENGTH;
     }
 
-    uint8_t *alpnListTmp = (uint8_t *)BSL_SAL_Calloc(alpnProtosLen + 1, sizeof(uint8_t));
+    uint8_t *alpnListTmp = (uint8_t *)CFG_ListCalloc((alpnProtosLen + 1) * sizeof(uint8_t));
     if (alpnListTmp == NULL) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16610, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "Calloc fail", 0, 0, 0, 0);
         return HITLS_MEMALLOC_FAIL;
@@ -1683,7 +1704,7 @@ int32_t HITLS_CFG_SetAlpnProtos(HITLS_Config *config, const uint8_t *alpnProtos,
 
     (void)memcpy_s(alpnListTmp, alpnProtosLen + 1, alpnProtos, alpnProtosLen);
 
-    BSL_SAL_FREE(config->alpnList);
+    CFG_LIST_FREE(config->alpnList);
     config->alpnList = alpnListTmp;
     /* Ignore ending 0s */
     config->alpnListSize = alpnProtosLen;
@@ -1760,6 +1781,16 @@ int32_t HITLS_CFG_GetSessionCacheSize(HITLS_Config *config, uint32_t *size)
     *size = SESSMGR_GetCacheSize(config->sessMgr);
     return HITLS_SUCCESS;
 }
+
+int32_t HITLS_CFG_GetSessionCacheStats(HITLS_Config *config, HITLS_SessCacheStats *stats)
+{
+    if (config == NULL || config->sessMgr == NULL || stats == NULL) {
+        return HITLS_NULL_INPUT;
+    }
+
+    SESSMGR_GetCacheStats(config->sessMgr, stats);
+    return HITLS_SUCCESS;
+}
 #endif
 
 #ifdef HITLS_TLS_PROTO_ALL
@@ -115,8 +115,8 @@ uint16_t g_tls12CipherSuites[] = {
 
 int32_t SetDefaultCipherSuite(HITLS_Config *config, const uint16_t *cipherSuites, uint32_t cipherSuiteSize)
 {
-    BSL_SAL_FREE(config->cipherSuites);
-    config->cipherSuites = BSL_SAL_Dump(cipherSuites, cipherSuiteSize);
+    CFG_LIST_FREE(config->cipherSuites);
+    config->cipherSuites = CFG_ListDump(cipherSuites, cipherSuiteSize);
     if (config->cipherSuites == NULL) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16563, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "Dump fail", 0, 0, 0, 0);
         return HITLS_MEMALLOC_FAIL;
@@ -135,8 +135,8 @@ static int32_t SetTLS13DefaultCipherSuites(HITLS_Config *config)
         HITLS_AES_128_GCM_SHA256,
     };
 
-    BSL_SAL_FREE(config->tls13CipherSuites);
-    config->tls13CipherSuites = BSL_SAL_Dump(ciphersuites13, sizeof(ciphersuites13));
+    CFG_LIST_FREE(config->tls13CipherSuites);
+    config->tls13CipherSuites = CFG_ListDump(ciphersuites13, sizeof(ciphersuites13));
     if (config->tls13CipherSuites == NULL) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16564, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "Dump fail", 0, 0, 0, 0);
         return HITLS_MEMALLOC_FAIL;
@@ -151,8 +151,8 @@ static int32_t SetDefaultPointFormats(HITLS_Config *config)
     const uint8_t pointFormats[] = {HITLS_POINT_FORMAT_UNCOMPRESSED};
     uint32_t size = sizeof(pointFormats);
 
-    BSL_SAL_FREE(config->pointFormats);
-    config->pointFormats = BSL_SAL_Dump(pointFormats, size);
+    CFG_LIST_FREE(config->pointFormats);
+    config->pointFormats = CFG_ListDump(pointFormats, size);
     if (config->pointFormats == NULL) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16565, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "Dump fail", 0, 0, 0, 0);
         return HITLS_MEMALLOC_FAIL;
@@ -187,6 +187,8 @@ static void InitConfig(HITLS_Config *config)
     config->needCheckPmsVersion = false;
 #endif
     config->readAhead = 0;
+    config->writeBatchNum = 0;
+    config->readBatchNum = 0;
 #ifdef HITLS_TLS_CONFIG_KEY_USAGE
     config->needCheckKeyUsage = true;
 #endif
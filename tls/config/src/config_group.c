@@ -246,7 +246,7 @@ static int32_t ProviderAddGroupInfo(const BSL_Param *params, void *args)
     BSL_Param *param = NULL;
     int32_t ret = HITLS_CONFIG_ERR_LOAD_GROUP_INFO;
     if (config->groupInfolen == config->groupInfoSize) {
-        void *ptr = BSL_SAL_Realloc(config->groupInfo,
+        void *ptr = CFG_ListRealloc(config->groupInfo,
             (config->groupInfoSize + TLS_CAPABILITY_LIST_MALLOC_SIZE) * sizeof(TLS_GroupInfo),
             config->groupInfoSize * sizeof(TLS_GroupInfo));
         if (ptr == NULL) {
@@ -62,7 +62,7 @@ static int32_t UpdateSignAlgorithmsArray(TLS_Config *config)
     if (config == NULL) {
         return HITLS_INVALID_INPUT;
     }
-    uint16_t *tempItems = BSL_SAL_Calloc(sizeof(DEFAULT_SIGSCHEME_ID), sizeof(uint8_t));
+    uint16_t *tempItems = CFG_ListCalloc(sizeof(DEFAULT_SIGSCHEME_ID));
     if (tempItems == NULL) {
         return HITLS_MEMALLOC_FAIL;
     }
@@ -76,10 +76,10 @@ static int32_t UpdateSignAlgorithmsArray(TLS_Config *config)
         size++;
     }
     if (size == 0) {
-        BSL_SAL_Free(tempItems);
+        CFG_LIST_FREE(tempItems);
         return HITLS_INVALID_INPUT;
     }
-    BSL_SAL_FREE(config->signAlgorithms);
+    CFG_LIST_FREE(config->signAlgorithms);
     config->signAlgorithms = tempItems;
     config->signAlgorithmsSize = size;
     return HITLS_SUCCESS;
@@ -393,7 +393,7 @@ const TLS_SigSchemeInfo *ConfigGetSignatureSchemeInfoList(const HITLS_Config *co
 static int32_t PrepareSignSchemeStorage(TLS_Config *config, TLS_SigSchemeInfo **scheme)
 {
     if (config->sigSchemeInfolen == config->sigSchemeInfoSize) {
-        void *ptr = BSL_SAL_Realloc(config->sigSchemeInfo,
+        void *ptr = CFG_ListRealloc(config->sigSchemeInfo,
             (config->sigSchemeInfoSize + TLS_CAPABILITY_LIST_MALLOC_SIZE) * sizeof(TLS_SigSchemeInfo),
             config->sigSchemeInfoSize * sizeof(TLS_SigSchemeInfo));
         if (ptr == NULL) {
@@ -18,6 +18,7 @@
 #include "tls.h"
 #include "bsl_err_internal.h"
 #include "hitls_error.h"
+#include "config.h"
 #include "config_default.h"
 #ifdef HITLS_TLS_FEATURE_PSK
 #include "hitls_psk.h"
@@ -53,7 +54,7 @@ int32_t HITLS_CFG_ClearTLS13CipherSuites(HITLS_Config *config)
         return HITLS_NULL_INPUT;
     }
 
-    BSL_SAL_FREE(config->tls13CipherSuites);
+    CFG_LIST_FREE(config->tls13CipherSuites);
     config->tls13cipherSuitesSize = 0;
     return HITLS_SUCCESS;
 }
@@ -37,7 +37,12 @@
 #endif
 #define SESSION_GERNERATE_RETRY_MAX_TIMES 10
 
+/* Buckets of each shard, the hash tables are not resized so the shards keep the bucket size of the whole cache */
 #define SESSION_DEFAULT_HASH_BKT_SZIE 64u
+/* Maximum number of least recently queued sessions checked for expiry when a session is inserted */
+#define SESSION_EXPIRE_SCAN_NUM 4u
+/* Maximum number of sessions of each shard checked for expiry by one SESSMGR_ClearTimeout call */
+#define SESSION_CLEAR_TIMEOUT_SCAN_NUM 16u
 
 typedef struct {
     uint32_t sessionIdSize;
@@ -86,17 +91,232 @@ static void SessKeyFreeFunc(void *ptr)
     return;
 }
 
-/* Session copy function */
-static void *SessionDupFunc(void *src, size_t size)
+typedef struct {
+    ListRawNode lruNode;                /* Must be the first member, the node of SessCacheShard.lru */
+    SessionKey key;
+    HITLS_Session *sess;
+    BSL_SAL_RefCount useCnt;            /* 1 + lookups of the session since it was queued */
+} SessCacheNode;
+
+/* Release the cache node when it is erased from the hash table, the node has been removed from the lru list */
+static void SessCacheNodeFree(void *ptr)
 {
-    (void)size;
-    return (void *)HITLS_SESS_Dup((HITLS_Session *)src);
+    SessCacheNode *node = (SessCacheNode *)ptr;
+    HITLS_SESS_Free(node->sess);
+    BSL_SAL_ReferencesFree(&node->useCnt);
+    BSL_SAL_FREE(node);
+    return;
 }
 
-static void SessionFreeFunc(void *ptr)
+/* The counters are changed by atomic operations like the reference counts, but start from 0 */
+static int32_t SessCacheCounterInit(BSL_SAL_RefCount *counter)
 {
-    HITLS_SESS_Free((HITLS_Session *)ptr);
-    return;
+    if (BSL_SAL_ReferencesInit(counter) != BSL_SUCCESS) {
+        return HITLS_MEMALLOC_FAIL;
+    }
+    counter->count = 0;
+    return HITLS_SUCCESS;
+}
+
+static void SessCacheShardDeinit(SessCacheShard *shard)
+{
+    // The nodes are released by the hash table
+    BSL_HASH_Destory(shard->hash);
+    shard->hash = NULL;
+    BSL_SAL_ReferencesFree(&shard->pendingHits);
+    BSL_SAL_ReferencesFree(&shard->pendingMisses);
+    BSL_SAL_ThreadLockFree(shard->lock);
+    shard->lock = NULL;
+}
+
+static int32_t SessCacheShardInit(SessCacheShard *shard)
+{
+    if (BSL_SAL_ThreadLockNew(&shard->lock) != BSL_SUCCESS) {
+        return HITLS_MEMALLOC_FAIL;
+    }
+    if (SessCacheCounterInit(&shard->pendingHits) != HITLS_SUCCESS ||
+        SessCacheCounterInit(&shard->pendingMisses) != HITLS_SUCCESS) {
+        SessCacheShardDeinit(shard);
+        return HITLS_MEMALLOC_FAIL;
+    }
+    ListDupFreeFuncPair keyFunc = {.dupFunc = SessKeyDupFunc, .freeFunc = SessKeyFreeFunc};
+    ListDupFreeFuncPair valueFunc = {.dupFunc = NULL, .freeFunc = SessCacheNodeFree};
+    shard->hash = BSL_HASH_Create(SESSION_DEFAULT_HASH_BKT_SZIE,
+        SessKeyHashCodeCal, SessKeyHashMacth, &keyFunc, &valueFunc);
+    if (shard->hash == NULL) {
+        SessCacheShardDeinit(shard);
+        return HITLS_MEMALLOC_FAIL;
+    }
+    (void)ListRawInit(&shard->lru, NULL);
+    shard->expireCursor = NULL;
+    return HITLS_SUCCESS;
+}
+
+/* Move the lookups counted under the read lock to the statistics. The write lock of the shard must be held */
+static void SessCacheShardFoldStats(SessCacheShard *shard)
+{
+    shard->hits += (uint64_t)shard->pendingHits.count;
+    shard->pendingHits.count = 0;
+    shard->misses += (uint64_t)shard->pendingMisses.count;
+    shard->pendingMisses.count = 0;
+}
+
+static SessCacheShard *SessCacheGetShard(TLS_SessionMgr *mgr, const SessionKey *key)
+{
+    /* The hash tables of the shards take the hash code modulo their bucket size, use the high bits here */
+    uint32_t hashCode = BSL_HASH_CodeCalc((void *)(uintptr_t)key, sizeof(SessionKey));
+    return &mgr->shards[(hashCode >> 16) % SESSION_CACHE_SHARD_NUM];
+}
+
+static SessCacheNode *SessCacheShardFind(SessCacheShard *shard, const SessionKey *key)
+{
+    BSL_HASH_Iterator it = BSL_HASH_Find(shard->hash, (uintptr_t)key);
+    if (it == BSL_HASH_IterEnd(shard->hash)) {
+        return NULL;
+    }
+    return (SessCacheNode *)BSL_HASH_IterValue(shard->hash, it);
+}
+
+/* Reserve room for one more session, which fails if the cache is full. */
+static bool SessCacheReserve(TLS_SessionMgr *mgr, uint32_t cacheSize)
+{
+    int sessNum;
+    (void)BSL_SAL_AtomicUpReferences(&mgr->sessNum, &sessNum);
+    if ((uint32_t)sessNum <= cacheSize) {
+        return true;
+    }
+    (void)BSL_SAL_AtomicDownReferences(&mgr->sessNum, &sessNum);
+    return false;
+}
+
+static void SessCacheRelease(TLS_SessionMgr *mgr)
+{
+    int sessNum;
+    (void)BSL_SAL_AtomicDownReferences(&mgr->sessNum, &sessNum);
+}
+
+/* Take the node out of the lru list, the expiry scan goes on from the next more recently queued node. The write
+ * lock of the shard must be held */
+static void SessCacheShardUnlink(SessCacheShard *shard, SessCacheNode *node)
+{
+    if (shard->expireCursor == &node->lruNode) {
+        shard->expireCursor = ListRawGetPrev(&shard->lru, &node->lruNode);
+    }
+    (void)ListRawRemove(&shard->lru, &node->lruNode);
+}
+
+/* Remove the node from the shard. The write lock of the shard must be held */
+static void SessCacheShardRemove(TLS_SessionMgr *mgr, SessCacheShard *shard, SessCacheNode *node)
+{
+    SessCacheShardUnlink(shard, node);
+    (void)BSL_HASH_Erase(shard->hash, (uintptr_t)&node->key);
+    SessCacheRelease(mgr);
+}
+
+/* Remove the timed out sessions among the scanNum least recently queued ones. The write lock of the shard must be
+ * held */
+static void SessCacheShardExpire(TLS_SessionMgr *mgr, SessCacheShard *shard, uint64_t curTime, size_t scanNum)
+{
+    ListRawNode *lruNode = ListRawBack(&shard->lru);
+    for (size_t i = 0; i < scanNum && lruNode != NULL; i++) {
+        SessCacheNode *node = (SessCacheNode *)lruNode;
+        lruNode = ListRawGetPrev(&shard->lru, lruNode);
+        if (SESS_CheckValidity(node->sess, curTime) == false) {
+            SessCacheShardRemove(mgr, shard, node);
+            shard->timeouts++;
+        }
+    }
+}
+
+/* Go on with the expiry scan of the shard from where the last one stopped, checking at most scanNum sessions. The
+ * scan walks from the least to the most recently queued session, then starts from the back again. The write lock of
+ * the shard must be held */
+static void SessCacheShardExpireStep(TLS_SessionMgr *mgr, SessCacheShard *shard, uint64_t curTime, size_t scanNum)
+{
+    ListRawNode *lruNode = (shard->expireCursor != NULL) ? shard->expireCursor : ListRawBack(&shard->lru);
+    for (size_t i = 0; i < scanNum && lruNode != NULL; i++) {
+        SessCacheNode *node = (SessCacheNode *)lruNode;
+        lruNode = ListRawGetPrev(&shard->lru, lruNode);
+        if (SESS_CheckValidity(node->sess, curTime) == false) {
+            SessCacheShardRemove(mgr, shard, node);
+            shard->timeouts++;
+        }
+    }
+    shard->expireCursor = lruNode;
+}
+
+#if defined(HITLS_TLS_PROTO_TLS_BASIC) || defined(HITLS_TLS_PROTO_DTLS12)
+/* Get the session to evict. Lookups only hold the read lock and do not reorder the lru list, they count the uses of
+ * the node instead. A node found since it was queued is queued again rather than evicted, so the order approximates
+ * the least recently used one. The write lock of the shard must be held */
+static SessCacheNode *SessCacheShardVictim(SessCacheShard *shard)
+{
+    ListRawNode *lruNode = ListRawBack(&shard->lru);
+    while (lruNode != NULL) {
+        SessCacheNode *node = (SessCacheNode *)lruNode;
+        if (node->useCnt.count <= 1) {
+            return node;
+        }
+        node->useCnt.count = 1;
+        SessCacheShardUnlink(shard, node);
+        (void)ListRawPushFront(&shard->lru, lruNode);
+        lruNode = ListRawBack(&shard->lru);
+    }
+    return NULL;
+}
+
+/* Evict the least recently used session of another shard. No shard lock may be held by the caller */
+static bool SessCacheEvictOther(TLS_SessionMgr *mgr, const SessCacheShard *exclude)
+{
+    for (uint32_t i = 0; i < SESSION_CACHE_SHARD_NUM; i++) {
+        SessCacheShard *shard = &mgr->shards[i];
+        if (shard == exclude) {
+            continue;
+        }
+        BSL_SAL_ThreadWriteLock(shard->lock);
+        SessCacheNode *victim = SessCacheShardVictim(shard);
+        if (victim != NULL) {
+            SessCacheShardRemove(mgr, shard, victim);
+            shard->evictions++;
+            BSL_SAL_ThreadUnlock(shard->lock);
+            return true;
+        }
+        BSL_SAL_ThreadUnlock(shard->lock);
+    }
+    return false;
+}
+#endif
+
+static int32_t TicketKeyGenerate(HITLS_Lib_Ctx *libCtx, SessTicketKey *key)
+{
+    if (SAL_CRYPT_Rand(libCtx, key->name, sizeof(key->name)) != HITLS_SUCCESS ||
+        SAL_CRYPT_Rand(libCtx, key->aesKey, sizeof(key->aesKey)) != HITLS_SUCCESS ||
+        SAL_CRYPT_Rand(libCtx, key->hmacKey, sizeof(key->hmacKey)) != HITLS_SUCCESS) {
+        BSL_SAL_CleanseData(key, sizeof(SessTicketKey));
+        return HITLS_CRYPT_ERR_GENERATE_RANDOM;
+    }
+    key->createTime = (uint64_t)BSL_SAL_CurrentSysTimeGet();
+    return HITLS_SUCCESS;
+}
+
+static void TicketKeyClear(SessTicketKey *key)
+{
+    for (uint32_t i = 0; i < key->encCtxNum; i++) {
+        SAL_CRYPT_CipherFree(key->encCtx[i]);
+    }
+    for (uint32_t i = 0; i < key->decCtxNum; i++) {
+        SAL_CRYPT_CipherFree(key->decCtx[i]);
+    }
+    BSL_SAL_CleanseData(key, sizeof(SessTicketKey));
+}
+
+/* Drop the oldest keys until at most keyNum remain. The write lock must be held */
+static void TicketKeyTrim(TLS_SessionMgr *mgr, uint32_t keyNum)
+{
+    while (mgr->ticketKeyNum > keyNum) {
+        mgr->ticketKeyNum--;
+        TicketKeyClear(&mgr->ticketKeys[mgr->ticketKeyNum]);
+    }
 }
 
 TLS_SessionMgr *SESSMGR_New(HITLS_Lib_Ctx *libCtx)
@@ -114,34 +334,54 @@ TLS_SessionMgr *SESSMGR_New(HITLS_Lib_Ctx *libCtx)
         return NULL;
     }
 
-    /* Prepare the default ticket key */
-    if (SAL_CRYPT_Rand(libCtx, mgr->ticketKeyName, sizeof(mgr->ticketKeyName)) != HITLS_SUCCESS ||
-        SAL_CRYPT_Rand(libCtx, mgr->ticketAesKey, sizeof(mgr->ticketAesKey)) != HITLS_SUCCESS ||
-        SAL_CRYPT_Rand(libCtx, mgr->ticketHmacKey, sizeof(mgr->ticketHmacKey)) != HITLS_SUCCESS) {
-        BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16704, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "Rand fail", 0, 0, 0, 0);
+    if (BSL_SAL_ThreadLockNew(&mgr->ticketCtxLock) != BSL_SUCCESS) {
+        BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16703, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN,
+            "ThreadLockNew fail", 0, 0, 0, 0);
         BSL_SAL_ThreadLockFree(mgr->lock);
         BSL_SAL_FREE(mgr);
         return NULL;
     }
 
-    // Apply for a hash table from mgr->hash
-    ListDupFreeFuncPair keyFunc = {.dupFunc = SessKeyDupFunc, .freeFunc = SessKeyFreeFunc};
-    ListDupFreeFuncPair valueFunc = {.dupFunc = SessionDupFunc, .freeFunc = SessionFreeFunc};
-    mgr->hash = BSL_HASH_Create(SESSION_DEFAULT_HASH_BKT_SZIE,
-        SessKeyHashCodeCal, SessKeyHashMacth, &keyFunc, &valueFunc);
-    if (mgr->hash == NULL) {
-        BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16705, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN,
-            "HASH_Create fail", 0, 0, 0, 0);
+    if (SessCacheCounterInit(&mgr->sessNum) != HITLS_SUCCESS) {
+        BSL_SAL_ThreadLockFree(mgr->ticketCtxLock);
+        BSL_SAL_ThreadLockFree(mgr->lock);
+        BSL_SAL_FREE(mgr);
+        return NULL;
+    }
+
+    /* Prepare the default ticket key */
+    if (TicketKeyGenerate(libCtx, &mgr->ticketKeys[0]) != HITLS_SUCCESS) {
+        BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16704, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "Rand fail", 0, 0, 0, 0);
+        BSL_SAL_ReferencesFree(&mgr->sessNum);
+        BSL_SAL_ThreadLockFree(mgr->ticketCtxLock);
         BSL_SAL_ThreadLockFree(mgr->lock);
         BSL_SAL_FREE(mgr);
         return NULL;
     }
 
+    for (uint32_t i = 0; i < SESSION_CACHE_SHARD_NUM; i++) {
+        if (SessCacheShardInit(&mgr->shards[i]) != HITLS_SUCCESS) {
+            BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16705, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN,
+                "HASH_Create fail", 0, 0, 0, 0);
+            for (uint32_t j = 0; j < i; j++) {
+                SessCacheShardDeinit(&mgr->shards[j]);
+            }
+            TicketKeyClear(&mgr->ticketKeys[0]);
+            BSL_SAL_ReferencesFree(&mgr->sessNum);
+            BSL_SAL_ThreadLockFree(mgr->ticketCtxLock);
+            BSL_SAL_ThreadLockFree(mgr->lock);
+            BSL_SAL_FREE(mgr);
+            return NULL;
+        }
+    }
+
 #ifdef HITLS_TLS_FEATURE_SESSION
     mgr->sessCacheMode = HITLS_SESS_CACHE_SERVER;
     mgr->sessCacheSize = SESSION_DEFAULT_CACHE_SIZE;
 #endif
     mgr->sessTimeout = SESSION_DEFAULT_TIMEOUT;
+    mgr->ticketKeyNum = 1;
+    mgr->ticketKeyMaxNum = 1;
     mgr->references = 1;
     return mgr;
 }
@@ -172,9 +412,13 @@ void SESSMGR_Free(TLS_SessionMgr *mgr)
         BSL_SAL_ThreadUnlock(mgr->lock);
 
         // Delete all sessions
-        BSL_HASH_Destory(mgr->hash);
-        mgr->hash = NULL;
+        for (uint32_t i = 0; i < SESSION_CACHE_SHARD_NUM; i++) {
+            SessCacheShardDeinit(&mgr->shards[i]);
+        }
+        TicketKeyTrim(mgr, 0);
+        BSL_SAL_ReferencesFree(&mgr->sessNum);
 
+        BSL_SAL_ThreadLockFree(mgr->ticketCtxLock);
         BSL_SAL_ThreadLockFree(mgr->lock);
         BSL_SAL_FREE(mgr);
     }
@@ -257,6 +501,7 @@ void SESSMGR_InsertSession(TLS_SessionMgr *mgr, HITLS_Session *sess, bool isClie
 
     BSL_SAL_ThreadReadLock(mgr->lock);
     HITLS_SESS_CACHE_MODE mode = mgr->sessCacheMode;
+    uint32_t cacheSize = mgr->sessCacheSize;
     BSL_SAL_ThreadUnlock(mgr->lock);
 
     SessionKey key = {0};
@@ -281,54 +526,118 @@ void SESSMGR_InsertSession(TLS_SessionMgr *mgr, HITLS_Session *sess, bool isClie
         return;
     }
 
-    BSL_SAL_ThreadWriteLock(mgr->lock);
+    SessCacheShard *shard = SessCacheGetShard(mgr, &key);
+    BSL_SAL_ThreadWriteLock(shard->lock);
+    SessCacheNode *node = SessCacheShardFind(shard, &key);
+    if (node != NULL) {
+        /* The session is already cached, mark it as the most recently used one */
+        SessCacheShardUnlink(shard, node);
+        (void)ListRawPushFront(&shard->lru, &node->lruNode);
+        BSL_SAL_ThreadUnlock(shard->lock);
+        return;
+    }
 
-    if (BSL_HASH_Size(mgr->hash) < mgr->sessCacheSize) {
-        /* Insert a session node */
-        BSL_HASH_Insert(mgr->hash, (uintptr_t)&key, sizeof(key), (uintptr_t)sess, 0);
-    } else {
-        BSL_LOG_BINLOG_FIXLEN(
-            BINLOG_ID15305, BSL_LOG_LEVEL_WARN, BSL_LOG_BINLOG_TYPE_RUN, "over sess cache size", 0, 0, 0, 0);
+    SessCacheShardFoldStats(shard);
+    SessCacheShardExpire(mgr, shard, (uint64_t)BSL_SAL_CurrentSysTimeGet(), SESSION_EXPIRE_SCAN_NUM);
+    /* Evict the least recently used sessions until there is room for the new one, those of the shard first */
+    while (!SessCacheReserve(mgr, cacheSize)) {
+        SessCacheNode *victim = SessCacheShardVictim(shard);
+        if (victim != NULL) {
+            SessCacheShardRemove(mgr, shard, victim);
+            shard->evictions++;
+            continue;
+        }
+        /* Only one shard is locked at a time */
+        BSL_SAL_ThreadUnlock(shard->lock);
+        bool isEvicted = SessCacheEvictOther(mgr, shard);
+        BSL_SAL_ThreadWriteLock(shard->lock);
+        if (!isEvicted) {
+            BSL_LOG_BINLOG_FIXLEN(
+                BINLOG_ID15305, BSL_LOG_LEVEL_WARN, BSL_LOG_BINLOG_TYPE_RUN, "over sess cache size", 0, 0, 0, 0);
+            BSL_SAL_ThreadUnlock(shard->lock);
+            return;
+        }
+        if (SessCacheShardFind(shard, &key) != NULL) {
+            /* The session has been cached by another thread while the shard was unlocked */
+            BSL_SAL_ThreadUnlock(shard->lock);
+            return;
+        }
     }
 
-    BSL_SAL_ThreadUnlock(mgr->lock);
+    node = (SessCacheNode *)BSL_SAL_Calloc(1u, sizeof(SessCacheNode));
+    if (node == NULL || BSL_SAL_ReferencesInit(&node->useCnt) != BSL_SUCCESS) {
+        BSL_SAL_FREE(node);
+        SessCacheRelease(mgr);
+        BSL_SAL_ThreadUnlock(shard->lock);
+        return;
+    }
+    node->key = key;
+    node->sess = HITLS_SESS_Dup(sess);
+    /* Insert a session node */
+    if (BSL_HASH_Insert(shard->hash, (uintptr_t)&key, sizeof(key), (uintptr_t)node, 0) != BSL_SUCCESS) {
+        SessCacheNodeFree(node);
+        SessCacheRelease(mgr);
+        BSL_SAL_ThreadUnlock(shard->lock);
+        return;
+    }
+    (void)ListRawPushFront(&shard->lru, &node->lruNode);
+
+    BSL_SAL_ThreadUnlock(shard->lock);
     return;
 }
 #endif /* #if defined(HITLS_TLS_PROTO_TLS_BASIC) || defined(HITLS_TLS_PROTO_DTLS12) */
 
 #ifdef HITLS_TLS_FEATURE_SESSION_ID
-/* Find the matching session */
+/* Find the matching session, the returned session is referenced and must be released by the caller */
 HITLS_Session *SESSMGR_Find(TLS_SessionMgr *mgr, uint8_t *sessionId, uint8_t sessionIdSize)
 {
     if (mgr == NULL || sessionId == NULL || sessionIdSize == 0) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16706, BSL_LOG_LEVEL_WARN, BSL_LOG_BINLOG_TYPE_RUN, "input null", 0, 0, 0, 0);
         return NULL;
     }
-    BSL_SAL_ThreadReadLock(mgr->lock);
 
-    HITLS_Session *sess = NULL;
     SessionKey key = {0};
     key.sessionIdSize = sessionIdSize;
-    if (memcpy_s(key.sessionId, sizeof(key.sessionId), sessionId, sessionIdSize) == EOK) {
-        // Query the session corresponding to the key
-        if (BSL_HASH_At(mgr->hash, (uintptr_t)&key, (uintptr_t *)&sess) != BSL_SUCCESS) {
-            BSL_LOG_BINLOG_FIXLEN(
-                BINLOG_ID15353, BSL_LOG_LEVEL_DEBUG, BSL_LOG_BINLOG_TYPE_RUN, "not find sess", 0, 0, 0, 0);
-                sess = NULL;
-                goto EXIT;
-        }
+    if (memcpy_s(key.sessionId, sizeof(key.sessionId), sessionId, sessionIdSize) != EOK) {
+        return NULL;
     }
 
+    int cnt;
     uint64_t curTime = (uint64_t)BSL_SAL_CurrentSysTimeGet();
-    /* Check whether the validity is valid */
-    if (SESS_CheckValidity(sess, curTime) == false) {
-        BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16707, BSL_LOG_LEVEL_INFO, BSL_LOG_BINLOG_TYPE_RUN, "sess time out", 0, 0, 0, 0);
-        sess = NULL;
+    SessCacheShard *shard = SessCacheGetShard(mgr, &key);
+    BSL_SAL_ThreadReadLock(shard->lock);
+    // Query the session corresponding to the key
+    SessCacheNode *node = SessCacheShardFind(shard, &key);
+    if (node == NULL) {
+        BSL_LOG_BINLOG_FIXLEN(
+            BINLOG_ID15353, BSL_LOG_LEVEL_DEBUG, BSL_LOG_BINLOG_TYPE_RUN, "not find sess", 0, 0, 0, 0);
+        (void)BSL_SAL_AtomicUpReferences(&shard->pendingMisses, &cnt);
+        BSL_SAL_ThreadUnlock(shard->lock);
+        return NULL;
     }
 
-EXIT:
-    BSL_SAL_ThreadUnlock(mgr->lock);
-    return sess;
+    /* Check whether the validity is valid */
+    if (SESS_CheckValidity(node->sess, curTime) == true) {
+        (void)BSL_SAL_AtomicUpReferences(&node->useCnt, &cnt);
+        (void)BSL_SAL_AtomicUpReferences(&shard->pendingHits, &cnt);
+        /* Take the reference under the lock, so that the session cannot be released by other threads */
+        HITLS_Session *sess = HITLS_SESS_Dup(node->sess);
+        BSL_SAL_ThreadUnlock(shard->lock);
+        return sess;
+    }
+    BSL_SAL_ThreadUnlock(shard->lock);
+
+    BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16707, BSL_LOG_LEVEL_INFO, BSL_LOG_BINLOG_TYPE_RUN, "sess time out", 0, 0, 0, 0);
+    /* Remove the timed out session, unless another thread has removed or replaced it while the shard was unlocked */
+    BSL_SAL_ThreadWriteLock(shard->lock);
+    node = SessCacheShardFind(shard, &key);
+    if (node != NULL && SESS_CheckValidity(node->sess, curTime) == false) {
+        SessCacheShardRemove(mgr, shard, node);
+        shard->timeouts++;
+    }
+    shard->misses++;
+    BSL_SAL_ThreadUnlock(shard->lock);
+    return NULL;
 }
 
 #endif /* HITLS_TLS_FEATURE_SESSION_ID */
@@ -338,21 +647,23 @@ bool SESSMGR_HasMacthSessionId(TLS_SessionMgr *mgr, uint8_t *sessionId, uint8_t
     if (mgr == NULL || sessionId == NULL || sessionIdSize == 0) {
         return false;
     }
-    HITLS_Session *sess = NULL;
 
-    BSL_SAL_ThreadReadLock(mgr->lock);
     SessionKey key = {0};
     key.sessionIdSize = sessionIdSize;
-    if (memcpy_s(key.sessionId, sizeof(key.sessionId), sessionId, sessionIdSize) == EOK) {
-        // Query the session corresponding to the key
-        BSL_HASH_At(mgr->hash, (uintptr_t)&key, (uintptr_t *)&sess);
+    if (memcpy_s(key.sessionId, sizeof(key.sessionId), sessionId, sessionIdSize) != EOK) {
+        return false;
     }
 
-    BSL_SAL_ThreadUnlock(mgr->lock);
-    return (sess == NULL) ? false : true;
+    SessCacheShard *shard = SessCacheGetShard(mgr, &key);
+    BSL_SAL_ThreadReadLock(shard->lock);
+    // Query the session corresponding to the key
+    bool isFound = SessCacheShardFind(shard, &key) != NULL;
+    BSL_SAL_ThreadUnlock(shard->lock);
+    return isFound;
 }
 
-/* Clear timeout sessions */
+/* Clear timeout sessions. The shards are checked one by one, so only one shard is locked at a time, and a bounded
+ * number of sessions of each shard is checked per call, so that the whole cache is covered by successive calls */
 void SESSMGR_ClearTimeout(TLS_SessionMgr *mgr)
 {
     if (mgr == NULL) {
@@ -360,28 +671,35 @@ void SESSMGR_ClearTimeout(TLS_SessionMgr *mgr)
     }
 
     uint64_t curTime = (uint64_t)BSL_SAL_CurrentSysTimeGet();
-
-    BSL_SAL_ThreadWriteLock(mgr->lock);
-
-    BSL_HASH_Iterator it = BSL_HASH_IterBegin(mgr->hash);
-
-    while (it != BSL_HASH_IterEnd(mgr->hash)) {
-        uintptr_t ptr = BSL_HASH_IterValue(mgr->hash, it);
-        HITLS_Session *sess = (HITLS_Session *)ptr;
-        if (SESS_CheckValidity(sess, curTime) == false) {
-            /* Delete the node if it is invalid */
-            uintptr_t tmpKey = BSL_HASH_HashIterKey(mgr->hash, it);
-            // Returns the next iterator of the iterator where the key resides
-            it = BSL_HASH_Erase(mgr->hash, tmpKey);
-        } else {
-            it = BSL_HASH_IterNext(mgr->hash, it);
-        }
+    for (uint32_t i = 0; i < SESSION_CACHE_SHARD_NUM; i++) {
+        SessCacheShard *shard = &mgr->shards[i];
+        BSL_SAL_ThreadWriteLock(shard->lock);
+        SessCacheShardFoldStats(shard);
+        SessCacheShardExpireStep(mgr, shard, curTime, SESSION_CLEAR_TIMEOUT_SCAN_NUM);
+        BSL_SAL_ThreadUnlock(shard->lock);
     }
-
-    BSL_SAL_ThreadUnlock(mgr->lock);
     return;
 }
 
+#ifdef HITLS_TLS_FEATURE_SESSION
+/* Obtain the statistics of the session cache. Ensure that the pointer is not NULL */
+void SESSMGR_GetCacheStats(TLS_SessionMgr *mgr, HITLS_SessCacheStats *stats)
+{
+    (void)memset_s(stats, sizeof(HITLS_SessCacheStats), 0, sizeof(HITLS_SessCacheStats));
+    for (uint32_t i = 0; i < SESSION_CACHE_SHARD_NUM; i++) {
+        SessCacheShard *shard = &mgr->shards[i];
+        BSL_SAL_ThreadWriteLock(shard->lock);
+        SessCacheShardFoldStats(shard);
+        stats->number += BSL_HASH_Size(shard->hash);
+        stats->hits += shard->hits;
+        stats->misses += shard->misses;
+        stats->evictions += shard->evictions;
+        stats->timeouts += shard->timeouts;
+        BSL_SAL_ThreadUnlock(shard->lock);
+    }
+}
+#endif
+
 int32_t SESSMGR_GernerateSessionId(TLS_Ctx *ctx, uint8_t *sessionId, uint32_t sessionIdSize)
 {
     int32_t ret = 0;
@@ -440,9 +758,10 @@ int32_t SESSMGR_GetTicketKey(const TLS_SessionMgr *mgr, uint8_t *key, uint32_t k
     }
 
     BSL_SAL_ThreadReadLock(mgr->lock);
+    const SessTicketKey *cur = &mgr->ticketKeys[0];
 
     uint32_t offset = 0;
-    if (memcpy_s(key, keySize, mgr->ticketKeyName, HITLS_TICKET_KEY_NAME_SIZE) != EOK) {
+    if (memcpy_s(key, keySize, cur->name, HITLS_TICKET_KEY_NAME_SIZE) != EOK) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16709, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "memcpy fail", 0, 0, 0, 0);
         BSL_ERR_PUSH_ERROR(HITLS_MEMCPY_FAIL);
         BSL_SAL_ThreadUnlock(mgr->lock);
@@ -450,7 +769,7 @@ int32_t SESSMGR_GetTicketKey(const TLS_SessionMgr *mgr, uint8_t *key, uint32_t k
     }
     offset += HITLS_TICKET_KEY_NAME_SIZE;
 
-    if (memcpy_s(&key[offset], keySize - offset, mgr->ticketAesKey, HITLS_TICKET_KEY_SIZE) != EOK) {
+    if (memcpy_s(&key[offset], keySize - offset, cur->aesKey, HITLS_TICKET_KEY_SIZE) != EOK) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16710, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "memcpy fail", 0, 0, 0, 0);
         BSL_ERR_PUSH_ERROR(HITLS_MEMCPY_FAIL);
         BSL_SAL_ThreadUnlock(mgr->lock);
@@ -458,7 +777,7 @@ int32_t SESSMGR_GetTicketKey(const TLS_SessionMgr *mgr, uint8_t *key, uint32_t k
     }
     offset += HITLS_TICKET_KEY_SIZE;
 
-    if (memcpy_s(&key[offset], keySize - offset, mgr->ticketHmacKey, HITLS_TICKET_KEY_SIZE) != EOK) {
+    if (memcpy_s(&key[offset], keySize - offset, cur->hmacKey, HITLS_TICKET_KEY_SIZE) != EOK) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16711, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "memcpy fail", 0, 0, 0, 0);
         BSL_ERR_PUSH_ERROR(HITLS_MEMCPY_FAIL);
         BSL_SAL_ThreadUnlock(mgr->lock);
@@ -473,6 +792,30 @@ int32_t SESSMGR_GetTicketKey(const TLS_SessionMgr *mgr, uint8_t *key, uint32_t k
     return HITLS_SUCCESS;
 }
 
+/* Make the key the one that encrypts the new tickets. The write lock must be held */
+static void TicketKeyPush(TLS_SessionMgr *mgr, const SessTicketKey *key)
+{
+    TicketKeyTrim(mgr, mgr->ticketKeyMaxNum - 1);
+    for (uint32_t i = mgr->ticketKeyNum; i > 0; i--) {
+        mgr->ticketKeys[i] = mgr->ticketKeys[i - 1];
+    }
+    mgr->ticketKeys[0] = *key;
+    mgr->ticketKeyNum++;
+}
+
+static void TicketKeyParse(const uint8_t *key, SessTicketKey *ticketKey)
+{
+    uint32_t offset = 0;
+    (void)memcpy_s(ticketKey->name, HITLS_TICKET_KEY_NAME_SIZE, key, HITLS_TICKET_KEY_NAME_SIZE);
+    offset += HITLS_TICKET_KEY_NAME_SIZE;
+
+    (void)memcpy_s(ticketKey->aesKey, HITLS_TICKET_KEY_SIZE, &key[offset], HITLS_TICKET_KEY_SIZE);
+    offset += HITLS_TICKET_KEY_SIZE;
+
+    (void)memcpy_s(ticketKey->hmacKey, HITLS_TICKET_KEY_SIZE, &key[offset], HITLS_TICKET_KEY_SIZE);
+    ticketKey->createTime = (uint64_t)BSL_SAL_CurrentSysTimeGet();
+}
+
 int32_t SESSMGR_SetTicketKey(TLS_SessionMgr *mgr, const uint8_t *key, uint32_t keySize)
 {
     if (mgr == NULL || key == NULL ||
@@ -482,20 +825,171 @@ int32_t SESSMGR_SetTicketKey(TLS_SessionMgr *mgr, const uint8_t *key, uint32_t k
         return HITLS_NULL_INPUT;
     }
 
+    SessTicketKey ticketKey = {0};
+    TicketKeyParse(key, &ticketKey);
+
+    /* The key replaces all the keys in use, the tickets they issued are no longer accepted */
     BSL_SAL_ThreadWriteLock(mgr->lock);
+    TicketKeyTrim(mgr, 0);
+    TicketKeyPush(mgr, &ticketKey);
+    BSL_SAL_ThreadUnlock(mgr->lock);
 
-    uint32_t offset = 0;
-    (void)memcpy_s(mgr->ticketKeyName, HITLS_TICKET_KEY_NAME_SIZE, key, HITLS_TICKET_KEY_NAME_SIZE);
-    offset += HITLS_TICKET_KEY_NAME_SIZE;
+    BSL_SAL_CleanseData(&ticketKey, sizeof(ticketKey));
+    return HITLS_SUCCESS;
+}
 
-    (void)memcpy_s(mgr->ticketAesKey, HITLS_TICKET_KEY_SIZE, &key[offset], HITLS_TICKET_KEY_SIZE);
-    offset += HITLS_TICKET_KEY_SIZE;
+/* The key named keyName, NULL if it is not in use. The lock must be held */
+static SessTicketKey *TicketKeyFind(TLS_SessionMgr *mgr, const uint8_t *keyName)
+{
+    /* The ring is short, the newest keys are the most likely */
+    for (uint32_t i = 0; i < mgr->ticketKeyNum; i++) {
+        if (memcmp(mgr->ticketKeys[i].name, keyName, HITLS_TICKET_KEY_NAME_SIZE) == 0) {
+            return &mgr->ticketKeys[i];
+        }
+    }
+    return NULL;
+}
+
+int32_t SESSMGR_AddTicketKey(TLS_SessionMgr *mgr, const uint8_t *key, uint32_t keySize)
+{
+    if (mgr == NULL || key == NULL ||
+        (keySize != HITLS_TICKET_KEY_NAME_SIZE + HITLS_TICKET_KEY_SIZE + HITLS_TICKET_KEY_SIZE)) {
+        BSL_ERR_PUSH_ERROR(HITLS_NULL_INPUT);
+        return HITLS_NULL_INPUT;
+    }
 
-    (void)memcpy_s(mgr->ticketHmacKey, HITLS_TICKET_KEY_SIZE, &key[offset], HITLS_TICKET_KEY_SIZE);
+    SessTicketKey ticketKey = {0};
+    TicketKeyParse(key, &ticketKey);
 
+    int32_t ret = HITLS_SUCCESS;
+    BSL_SAL_ThreadWriteLock(mgr->lock);
+    if (TicketKeyFind(mgr, ticketKey.name) != NULL) {
+        ret = HITLS_CONFIG_INVALID_SET;
+    } else {
+        TicketKeyPush(mgr, &ticketKey);
+    }
     BSL_SAL_ThreadUnlock(mgr->lock);
 
+    BSL_SAL_CleanseData(&ticketKey, sizeof(ticketKey));
+    if (ret != HITLS_SUCCESS) {
+        BSL_ERR_PUSH_ERROR(ret);
+    }
+    return ret;
+}
+
+int32_t SESSMGR_SetTicketKeyRotation(TLS_SessionMgr *mgr, uint64_t interval, uint32_t keyNum)
+{
+    if (mgr == NULL) {
+        BSL_ERR_PUSH_ERROR(HITLS_NULL_INPUT);
+        return HITLS_NULL_INPUT;
+    }
+    if (keyNum == 0 || keyNum > HITLS_TICKET_KEY_MAX_NUM) {
+        BSL_ERR_PUSH_ERROR(HITLS_CONFIG_INVALID_SET);
+        return HITLS_CONFIG_INVALID_SET;
+    }
+
+    BSL_SAL_ThreadWriteLock(mgr->lock);
+    mgr->ticketKeyInterval = interval;
+    mgr->ticketKeyMaxNum = keyNum;
+    TicketKeyTrim(mgr, keyNum);
+    BSL_SAL_ThreadUnlock(mgr->lock);
     return HITLS_SUCCESS;
 }
+
+void SESSMGR_GetTicketKeyRotation(TLS_SessionMgr *mgr, uint64_t *interval, uint32_t *keyNum)
+{
+    BSL_SAL_ThreadReadLock(mgr->lock);
+    *interval = mgr->ticketKeyInterval;
+    *keyNum = mgr->ticketKeyMaxNum;
+    BSL_SAL_ThreadUnlock(mgr->lock);
+}
+
+/* Whether the key that encrypts the new tickets is older than the interval. The lock must be held */
+static bool TicketKeyRotationDue(const TLS_SessionMgr *mgr)
+{
+    uint64_t curTime = (uint64_t)BSL_SAL_CurrentSysTimeGet();
+    uint64_t createTime = mgr->ticketKeys[0].createTime;
+    return mgr->ticketKeyInterval != 0 && curTime >= createTime && curTime - createTime >= mgr->ticketKeyInterval;
+}
+
+/* Replace the key that encrypts the new tickets if it is older than the interval. The write lock must be held */
+static void TicketKeyRotate(TLS_SessionMgr *mgr, HITLS_Lib_Ctx *libCtx)
+{
+    /* Another connection may have rotated the key between the read lock and the write lock */
+    if (!TicketKeyRotationDue(mgr)) {
+        return;
+    }
+    SessTicketKey ticketKey = {0};
+    if (TicketKeyGenerate(libCtx, &ticketKey) != HITLS_SUCCESS) {
+        /* Keep the current key, the next ticket tries again */
+        BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16704, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "Rand fail", 0, 0, 0, 0);
+        return;
+    }
+    TicketKeyPush(mgr, &ticketKey);
+    BSL_SAL_CleanseData(&ticketKey, sizeof(ticketKey));
+}
+
+bool SESSMGR_BorrowTicketKey(TLS_SessionMgr *mgr, HITLS_Lib_Ctx *libCtx, bool isEncrypt, uint8_t *keyName,
+    uint8_t *aesKey, HITLS_Cipher_Ctx **cipherCtx)
+{
+    *cipherCtx = NULL;
+    BSL_SAL_ThreadReadLock(mgr->lock);
+    if (isEncrypt && TicketKeyRotationDue(mgr)) {
+        /* Only the rotation changes the ring, once per interval */
+        BSL_SAL_ThreadUnlock(mgr->lock);
+        BSL_SAL_ThreadWriteLock(mgr->lock);
+        TicketKeyRotate(mgr, libCtx);
+        BSL_SAL_ThreadUnlock(mgr->lock);
+        BSL_SAL_ThreadReadLock(mgr->lock);
+    }
+    SessTicketKey *key = NULL;
+    if (isEncrypt) {
+        key = &mgr->ticketKeys[0];
+        (void)memcpy_s(keyName, HITLS_TICKET_KEY_NAME_SIZE, key->name, HITLS_TICKET_KEY_NAME_SIZE);
+    } else {
+        key = TicketKeyFind(mgr, keyName);
+    }
+    if (key == NULL) {
+        BSL_SAL_ThreadUnlock(mgr->lock);
+        return false;
+    }
+    (void)memcpy_s(aesKey, HITLS_TICKET_KEY_SIZE, key->aesKey, HITLS_TICKET_KEY_SIZE);
+    /* The connections that find the pool empty get NULL, and the crypto layer expands the key again */
+    HITLS_Cipher_Ctx **pool = isEncrypt ? key->encCtx : key->decCtx;
+    uint32_t *poolNum = isEncrypt ? &key->encCtxNum : &key->decCtxNum;
+    BSL_SAL_ThreadWriteLock(mgr->ticketCtxLock);
+    if (*poolNum > 0) {
+        (*poolNum)--;
+        *cipherCtx = pool[*poolNum];
+        pool[*poolNum] = NULL;
+    }
+    BSL_SAL_ThreadUnlock(mgr->ticketCtxLock);
+    BSL_SAL_ThreadUnlock(mgr->lock);
+    return true;
+}
+
+void SESSMGR_ReturnTicketKey(TLS_SessionMgr *mgr, bool isEncrypt, const uint8_t *keyName, const uint8_t *aesKey,
+    HITLS_Cipher_Ctx *cipherCtx)
+{
+    if (cipherCtx == NULL) {
+        return;
+    }
+    BSL_SAL_ThreadReadLock(mgr->lock);
+    SessTicketKey *key = TicketKeyFind(mgr, keyName);
+    /* The key may have been dropped, or replaced by a key of the same name, since it was borrowed */
+    if (key != NULL && memcmp(key->aesKey, aesKey, HITLS_TICKET_KEY_SIZE) == 0) {
+        HITLS_Cipher_Ctx **pool = isEncrypt ? key->encCtx : key->decCtx;
+        uint32_t *poolNum = isEncrypt ? &key->encCtxNum : &key->decCtxNum;
+        BSL_SAL_ThreadWriteLock(mgr->ticketCtxLock);
+        if (*poolNum < SESSION_TICKET_CTX_POOL_SIZE) {
+            pool[*poolNum] = cipherCtx;
+            (*poolNum)++;
+            cipherCtx = NULL;
+        }
+        BSL_SAL_ThreadUnlock(mgr->ticketCtxLock);
+    }
+    BSL_SAL_ThreadUnlock(mgr->lock);
+    SAL_CRYPT_CipherFree(cipherCtx);
+}
 #endif /* #ifdef HITLS_TLS_FEATURE_SESSION_TICKET */
 #endif /* HITLS_TLS_FEATURE_SESSION */
\ No newline at end of file
@@ -28,6 +28,7 @@
 #include "hitls_error.h"
 #include "session_type.h"
 #include "session_enc.h"
+#include "session_mgr.h"
 
 typedef struct {
     uint8_t keyName[HITLS_TICKET_KEY_NAME_SIZE];
@@ -35,6 +36,9 @@ typedef struct {
     uint32_t encryptedStateSize;
     uint8_t *encryptedState;
     uint8_t mac[HITLS_TICKET_KEY_SIZE];
+    bool isDefaultKey;                          /* the key is borrowed from the session manager */
+    uint8_t aesKey[HITLS_TICKET_KEY_SIZE];      /* copy of the default key, the session manager may drop it */
+    HITLS_Cipher_Ctx *cipherCtx;                /* context of the default key, reused across the tickets */
 } Ticket;
 
 #define DEFAULT_SESSION_ENCRYPT_TYPE HITLS_AEAD_CIPHER
@@ -43,20 +47,33 @@ typedef struct {
 #define AES_CBC_BLOCK_LEN 16u
 #endif
 
-static void SetCipherInfo(const TLS_SessionMgr *sessMgr, Ticket *ticket, HITLS_CipherParameters *cipher)
+static void SetCipherInfo(Ticket *ticket, HITLS_CipherParameters *cipher)
 {
     cipher->type = DEFAULT_SESSION_ENCRYPT_TYPE;
     cipher->algo = DEFAULT_SESSION_ENCRYPT_ALGO;
-    cipher->key = sessMgr->ticketAesKey;
+    cipher->key = ticket->aesKey;
     cipher->keyLen = HITLS_TICKET_KEY_SIZE;
     cipher->iv = ticket->iv;
     cipher->ivLen = HITLS_TICKET_IV_SIZE;
     cipher->aad = ticket->iv;
     cipher->aadLen = HITLS_TICKET_IV_SIZE;
+    cipher->ctx = &ticket->cipherCtx;
     return;
 }
 
-static int32_t GetSessEncryptInfo(TLS_Ctx *ctx, const TLS_SessionMgr *sessMgr, Ticket *ticket, HITLS_CipherParameters *cipher)
+/* Give the cipher context of the default key back to the session manager */
+static void ReleaseTicketKey(TLS_SessionMgr *sessMgr, Ticket *ticket, bool isEncrypt)
+{
+    if (!ticket->isDefaultKey) {
+        return;
+    }
+    SESSMGR_ReturnTicketKey(sessMgr, isEncrypt, ticket->keyName, ticket->aesKey, ticket->cipherCtx);
+    ticket->cipherCtx = NULL;
+    ticket->isDefaultKey = false;
+    BSL_SAL_CleanseData(ticket->aesKey, sizeof(ticket->aesKey));
+}
+
+static int32_t GetSessEncryptInfo(TLS_Ctx *ctx, TLS_SessionMgr *sessMgr, Ticket *ticket, HITLS_CipherParameters *cipher)
 {
     int32_t ret;
 #ifdef HITLS_TLS_FEATURE_SESSION
@@ -73,8 +90,6 @@ static int32_t GetSessEncryptInfo(TLS_Ctx *ctx, const TLS_SessionMgr *sessMgr, T
     }
 #endif
     /* The user does not register the callback. The default ticket key is used. */
-    (void)memcpy_s(ticket->keyName, HITLS_TICKET_KEY_NAME_SIZE, sessMgr->ticketKeyName, HITLS_TICKET_KEY_NAME_SIZE);
-
     ret = SAL_CRYPT_Rand(LIBCTX_FROM_CTX(ctx), ticket->iv, HITLS_TICKET_IV_SIZE);
     if (ret != HITLS_SUCCESS) {
         BSL_ERR_PUSH_ERROR(HITLS_TICKET_KEY_RET_FAIL);
@@ -82,7 +97,9 @@ static int32_t GetSessEncryptInfo(TLS_Ctx *ctx, const TLS_SessionMgr *sessMgr, T
         return HITLS_TICKET_KEY_RET_FAIL;
     }
 
-    SetCipherInfo(sessMgr, ticket, cipher);
+    ticket->isDefaultKey = SESSMGR_BorrowTicketKey(sessMgr, LIBCTX_FROM_CTX(ctx), true, ticket->keyName,
+        ticket->aesKey, &ticket->cipherCtx);
+    SetCipherInfo(ticket, cipher);
 
     return HITLS_TICKET_KEY_RET_SUCCESS;
 }
@@ -246,31 +263,11 @@ static uint8_t *NewTicketBuf(const HITLS_Session *sess, HITLS_CipherParameters *
     return ticketBuf;
 }
 
-int32_t SESSMGR_EncryptSessionTicket(TLS_Ctx *ctx,
-    const TLS_SessionMgr *sessMgr, const HITLS_Session *sess, uint8_t **ticketBuf, uint32_t *ticketBufSize)
+static int32_t EncryptTicket(TLS_Ctx *ctx, const HITLS_Session *sess, const Ticket *ticket,
+    HITLS_CipherParameters *cipher, uint8_t **ticketBuf, uint32_t *ticketBufSize)
 {
-    if (sessMgr == NULL || sess == NULL || ticketBuf == NULL) {
-        BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16713, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "input null", 0, 0, 0, 0);
-        return HITLS_INTERNAL_EXCEPTION;
-    }
-
-    Ticket ticket = {0};
-    HITLS_CipherParameters cipher = {0};
-    int32_t retVal = GetSessEncryptInfo(ctx, sessMgr, &ticket, &cipher);
-    if (retVal < 0) {
-        BSL_ERR_PUSH_ERROR(HITLS_SESS_ERR_SESSION_TICKET_KEY_FAIL);
-        BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16030, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN,
-            "GetSessEncryptInfo fail when encrypt session ticket.", 0, 0, 0, 0);
-        return HITLS_SESS_ERR_SESSION_TICKET_KEY_FAIL;
-    }
-    if (retVal == HITLS_TICKET_KEY_RET_FAIL) {
-        /* Failed to obtain the encryption information. An empty ticket is returned. */
-        *ticketBufSize = 0;
-        return HITLS_SUCCESS;
-    }
-
     uint32_t dataLen = 0;
-    uint8_t *data = NewTicketBuf(sess, &cipher, &dataLen);
+    uint8_t *data = NewTicketBuf(sess, cipher, &dataLen);
     if (data == NULL) {
         return HITLS_MEMALLOC_FAIL;
     }
@@ -278,7 +275,7 @@ int32_t SESSMGR_EncryptSessionTicket(TLS_Ctx *ctx,
     int32_t ret;
     uint32_t packLen = 0;
     uint32_t offset = 0;
-    ret = PackKeyNameAndIv(&ticket, &data[0], dataLen, &packLen);
+    ret = PackKeyNameAndIv(ticket, &data[0], dataLen, &packLen);
     if (ret != HITLS_SUCCESS) {
         BSL_SAL_FREE(data);
         return ret;
@@ -286,7 +283,7 @@ int32_t SESSMGR_EncryptSessionTicket(TLS_Ctx *ctx,
     offset += packLen;
     /* Encrypt and fill the ticket. */
     ret = PackEncryptTicket(LIBCTX_FROM_CTX(ctx), ATTRIBUTE_FROM_CTX(ctx),
-        sess, &cipher, &data[offset], dataLen - offset, &packLen);
+        sess, cipher, &data[offset], dataLen - offset, &packLen);
     if (ret != HITLS_SUCCESS) {
         BSL_SAL_FREE(data);
         return ret;
@@ -296,7 +293,7 @@ int32_t SESSMGR_EncryptSessionTicket(TLS_Ctx *ctx,
 #ifdef HITLS_TLS_SUITE_CIPHER_CBC
     /* fill HMAC */
     ret = PackTicketHmac(LIBCTX_FROM_CTX(ctx), ATTRIBUTE_FROM_CTX(ctx),
-        &cipher, data, dataLen, offset, &packLen);
+        cipher, data, dataLen, offset, &packLen);
     if (ret != HITLS_SUCCESS) {
         BSL_SAL_FREE(data);
         return ret;
@@ -307,6 +304,34 @@ int32_t SESSMGR_EncryptSessionTicket(TLS_Ctx *ctx,
     *ticketBuf = data;
     return HITLS_SUCCESS;
 }
+
+int32_t SESSMGR_EncryptSessionTicket(TLS_Ctx *ctx,
+    TLS_SessionMgr *sessMgr, const HITLS_Session *sess, uint8_t **ticketBuf, uint32_t *ticketBufSize)
+{
+    if (sessMgr == NULL || sess == NULL || ticketBuf == NULL) {
+        BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16713, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "input null", 0, 0, 0, 0);
+        return HITLS_INTERNAL_EXCEPTION;
+    }
+
+    Ticket ticket = {0};
+    HITLS_CipherParameters cipher = {0};
+    int32_t retVal = GetSessEncryptInfo(ctx, sessMgr, &ticket, &cipher);
+    if (retVal < 0) {
+        BSL_ERR_PUSH_ERROR(HITLS_SESS_ERR_SESSION_TICKET_KEY_FAIL);
+        BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16030, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN,
+            "GetSessEncryptInfo fail when encrypt session ticket.", 0, 0, 0, 0);
+        return HITLS_SESS_ERR_SESSION_TICKET_KEY_FAIL;
+    }
+    if (retVal == HITLS_TICKET_KEY_RET_FAIL) {
+        /* Failed to obtain the encryption information. An empty ticket is returned. */
+        *ticketBufSize = 0;
+        return HITLS_SUCCESS;
+    }
+
+    int32_t ret = EncryptTicket(ctx, sess, &ticket, &cipher, ticketBuf, ticketBufSize);
+    ReleaseTicketKey(sessMgr, &ticket, true);
+    return ret;
+}
 static int32_t ParseSessionTicket(Ticket *ticket, const uint8_t *ticketBuf, uint32_t ticketBufSize)
 {
     uint32_t offset = 0;
@@ -349,7 +374,7 @@ static int32_t ParseSessionTicket(Ticket *ticket, const uint8_t *ticketBuf, uint
     return HITLS_SUCCESS;
 }
 
-static int32_t GetSessDecryptInfo(const TLS_SessionMgr *sessMgr, Ticket *ticket, HITLS_CipherParameters *cipher)
+static int32_t GetSessDecryptInfo(TLS_SessionMgr *sessMgr, Ticket *ticket, HITLS_CipherParameters *cipher)
 {
 #ifdef HITLS_TLS_FEATURE_SESSION
     HITLS_TicketKeyCb cb = sessMgr->ticketKeyCb;
@@ -357,12 +382,14 @@ static int32_t GetSessDecryptInfo(const TLS_SessionMgr *sessMgr, Ticket *ticket,
         return cb(ticket->keyName, HITLS_TICKET_KEY_NAME_SIZE, cipher, false);
     }
 #endif
-    /* The user does not register the callback. Use the default ticket key. */
-    if (memcmp(ticket->keyName, sessMgr->ticketKeyName, HITLS_TICKET_KEY_NAME_SIZE) != 0) {
+    /* The user does not register the callback. Use the default ticket key of the name. */
+    ticket->isDefaultKey = SESSMGR_BorrowTicketKey(sessMgr, NULL, false, ticket->keyName,
+        ticket->aesKey, &ticket->cipherCtx);
+    if (!ticket->isDefaultKey) {
         /* Failed to match the key name. */
         return HITLS_TICKET_KEY_RET_FAIL;
     }
-    SetCipherInfo(sessMgr, ticket, cipher);
+    SetCipherInfo(ticket, cipher);
     return HITLS_TICKET_KEY_RET_SUCCESS;
 }
 
@@ -464,7 +491,7 @@ static int32_t GenerateSessFromTicket(HITLS_Lib_Ctx *libCtx, const char *attrNam
 }
 
 int32_t SESSMGR_DecryptSessionTicket(HITLS_Lib_Ctx *libCtx, const char *attrName,
-    const TLS_SessionMgr *sessMgr, HITLS_Session **sess, const uint8_t *ticketBuf,
+    TLS_SessionMgr *sessMgr, HITLS_Session **sess, const uint8_t *ticketBuf,
     uint32_t ticketBufSize, bool *isTicketExpect)
 {
     if (sessMgr == NULL || sess == NULL || ticketBuf == NULL || isTicketExpect == NULL) {
@@ -516,10 +543,13 @@ int32_t SESSMGR_DecryptSessionTicket(HITLS_Lib_Ctx *libCtx, const char *attrName
     ret = CheckTicketHmac(libCtx, attrName, &cipher, &ticket, ticketBuf, ticketBufSize, &isPass);
     if ((ret != HITLS_SUCCESS) || (!isPass)) {
         /* If the HMAC check fails, the session is not restored and complete link establishment is performed. */
+        ReleaseTicketKey(sessMgr, &ticket, false);
         return ret;
     }
 #endif
     /* Parse the ticket content to the SESS. */
-    return GenerateSessFromTicket(libCtx, attrName, &cipher, &ticket, ticketBufSize, sess);
+    ret = GenerateSessFromTicket(libCtx, attrName, &cipher, &ticket, ticketBufSize, sess);
+    ReleaseTicketKey(sessMgr, &ticket, false);
+    return ret;
 }
 #endif /* HITLS_TLS_FEATURE_SESSION_TICKET */
\ No newline at end of file
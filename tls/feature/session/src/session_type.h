@@ -23,16 +23,51 @@
 #include "tls_config.h"
 #include "cert.h"
 #include "session.h"
+#include "list_base.h"
+#include "sal_atomic.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define SESSION_CACHE_SHARD_NUM 16u
+
+/* One shard of the session cache. Sessions are spread over the shards by the hash of the session id */
+typedef struct {
+    void *lock;                                            /* Thread lock of the shard */
+    void *hash;                                            /* hash table: session id -> cache node */
+    RawList lru;                                           /* Cache nodes, the most recently queued first */
+    ListRawNode *expireCursor;                             /* Next node checked by SESSMGR_ClearTimeout, NULL: back */
+    uint64_t hits;                                         /* Lookups which found a valid session */
+    uint64_t misses;                                       /* Lookups which found no valid session */
+    /* Lookups counted under the read lock, moved to hits and misses under the write lock */
+    BSL_SAL_RefCount pendingHits;
+    BSL_SAL_RefCount pendingMisses;
+    uint64_t evictions;                                    /* Sessions removed to make room for new ones */
+    uint64_t timeouts;                                     /* Timed out sessions removed from the cache */
+} SessCacheShard;
+
+#define SESSION_TICKET_CTX_POOL_SIZE 8u
+
+/* A ticket key of the ring. The cipher contexts keep the expanded keys, a connection takes one from the pool while it
+ * encrypts or decrypts a ticket and puts it back afterwards. */
+typedef struct {
+    uint8_t name[HITLS_TICKET_KEY_NAME_SIZE];              /* identifies the key in the tickets */
+    uint8_t aesKey[HITLS_TICKET_KEY_SIZE];
+    uint8_t hmacKey[HITLS_TICKET_KEY_SIZE];
+    uint64_t createTime;                                   /* when the key started to encrypt the new tickets */
+    HITLS_Cipher_Ctx *encCtx[SESSION_TICKET_CTX_POOL_SIZE];
+    HITLS_Cipher_Ctx *decCtx[SESSION_TICKET_CTX_POOL_SIZE];
+    uint32_t encCtxNum;                                    /* number of contexts in encCtx */
+    uint32_t decCtxNum;                                    /* number of contexts in decCtx */
+} SessTicketKey;
+
 struct TlsSessionManager {
     void *lock;                                            /* Thread lock */
     int32_t references;                                    /* Reference times */
 
-    void *hash;                                            /* hash table */
+    SessCacheShard shards[SESSION_CACHE_SHARD_NUM];        /* session cache */
+    BSL_SAL_RefCount sessNum;                              /* Number of cached sessions, without the mgr lock */
 
     uint64_t sessTimeout;                                  /* Session timeout interval, in seconds */
 #ifdef HITLS_TLS_FEATURE_SESSION
@@ -42,10 +77,13 @@ struct TlsSessionManager {
     /* TLS1.2 session ticket */
     HITLS_TicketKeyCb ticketKeyCb;                         /* allows users to customize ticket keys through callback */
 #endif
-    /* key_name: is used to identify a specific set of keys used to protect tickets */
-    uint8_t ticketKeyName[HITLS_TICKET_KEY_NAME_SIZE];
-    uint8_t ticketAesKey[HITLS_TICKET_KEY_SIZE];           /* aes key */
-    uint8_t ticketHmacKey[HITLS_TICKET_KEY_SIZE];          /* hmac key */
+    /* The default ticket keys, the newest first. The first key encrypts the new tickets, all of them decrypt.
+     * The tickets read the ring under the read lock, the changes of the ring take the write lock */
+    SessTicketKey ticketKeys[HITLS_TICKET_KEY_MAX_NUM];
+    void *ticketCtxLock;                                   /* guards the context pools, taken under the read lock */
+    uint32_t ticketKeyNum;                                 /* number of keys in the ring */
+    uint32_t ticketKeyMaxNum;                              /* number of keys kept for decryption */
+    uint64_t ticketKeyInterval;                            /* seconds before a new key is generated, 0: never */
 };
 
 struct TlsSessCtx {
@@ -55,16 +55,20 @@ void SESSMGR_SetCacheSize(TLS_SessionMgr *mgr, uint32_t sessCacheSize);
 /* Set the maximum number of cached sessions. Ensure that the pointer is not null */
 uint32_t SESSMGR_GetCacheSize(TLS_SessionMgr *mgr);
 
+/* Obtain the statistics of the session cache. Ensure that the pointer is not null */
+void SESSMGR_GetCacheStats(TLS_SessionMgr *mgr, HITLS_SessCacheStats *stats);
+
 /* add */
 void SESSMGR_InsertSession(TLS_SessionMgr *mgr, HITLS_Session *sess, bool isClient);
 
-/* Find the matching session and verify the validity of the session (time) */
+/* Find the matching session and verify the validity of the session (time).
+ * The returned session is referenced, and the caller needs to release it */
 HITLS_Session *SESSMGR_Find(TLS_SessionMgr *mgr, uint8_t *sessionId, uint8_t sessionIdSize);
 
 /* Search for the matching session without checking the validity of the session (time) */
 bool SESSMGR_HasMacthSessionId(TLS_SessionMgr *mgr, uint8_t *sessionId, uint8_t sessionIdSize);
 
-/* Clear timeout sessions */
+/* Clear timeout sessions, each call checks a bounded number of sessions and goes on from where the last one stopped */
 void SESSMGR_ClearTimeout(TLS_SessionMgr *mgr);
 
 /* Generate session IDs to prevent duplicate session IDs */
@@ -105,6 +109,74 @@ int32_t SESSMGR_GetTicketKey(const TLS_SessionMgr *mgr, uint8_t *key, uint32_t k
  */
 int32_t SESSMGR_SetTicketKey(TLS_SessionMgr *mgr, const uint8_t *key, uint32_t keySize);
 
+/**
+ * @brief   Add a default ticket key, which encrypts the new tickets from now on. The previous keys still decrypt
+ *          the tickets, the oldest one is dropped when the ring is full.
+ *
+ * @param   mgr [OUT] Session management context
+ * @param   key [IN] Ticket key to be added: 16-bytes key name + 32-bytes AES key + 32-bytes HMAC key
+ * @param   keySize [IN] Size of the ticket key
+ *
+ * @retval  HITLS_SUCCESS
+ * @retval  HITLS_CONFIG_INVALID_SET, the key name is in use
+ * @retval  For other error codes, see hitls_error.h
+ */
+int32_t SESSMGR_AddTicketKey(TLS_SessionMgr *mgr, const uint8_t *key, uint32_t keySize);
+
+/**
+ * @brief   Set the rotation of the default ticket keys
+ *
+ * @param   mgr [OUT] Session management context
+ * @param   interval [IN] Seconds a key encrypts the new tickets before a new key is generated, 0: never
+ * @param   keyNum [IN] Number of keys kept for decryption, from 1 to HITLS_TICKET_KEY_MAX_NUM
+ *
+ * @retval  HITLS_SUCCESS
+ * @retval  HITLS_CONFIG_INVALID_SET, keyNum is out of range
+ */
+int32_t SESSMGR_SetTicketKeyRotation(TLS_SessionMgr *mgr, uint64_t interval, uint32_t keyNum);
+
+/**
+ * @brief   Obtain the rotation of the default ticket keys
+ *
+ * @param   mgr [IN] Session management context
+ * @param   interval [OUT] Seconds a key encrypts the new tickets before a new key is generated, 0: never
+ * @param   keyNum [OUT] Number of keys kept for decryption
+ */
+void SESSMGR_GetTicketKeyRotation(TLS_SessionMgr *mgr, uint64_t *interval, uint32_t *keyNum);
+
+/**
+ * @brief   Take a default ticket key for one ticket, with the cipher context that has its key expanded
+ *
+ * Encryption takes the current key, after replacing it if the rotation interval has passed. Decryption takes the key
+ * named keyName. Only the rotation takes the write lock, the tickets share the read lock. The context comes from the
+ * pool of the key, NULL if the pool is empty, and it must be given back by SESSMGR_ReturnTicketKey.
+ *
+ * @param   mgr [IN] Session management context
+ * @param   libCtx [IN] Library context, used to generate a new key
+ * @param   isEncrypt [IN] Whether the key encrypts a ticket
+ * @param   keyName [IN/OUT] Encryption: name of the current key. Decryption: name of the key to find
+ * @param   aesKey [OUT] AES key, HITLS_TICKET_KEY_SIZE bytes
+ * @param   cipherCtx [OUT] Cipher context of the key from the pool
+ *
+ * @retval  true, the key is found
+ * @retval  false, no key is named keyName
+ */
+bool SESSMGR_BorrowTicketKey(TLS_SessionMgr *mgr, HITLS_Lib_Ctx *libCtx, bool isEncrypt, uint8_t *keyName,
+    uint8_t *aesKey, HITLS_Cipher_Ctx **cipherCtx);
+
+/**
+ * @brief   Give back the cipher context taken by SESSMGR_BorrowTicketKey, it is released if the key is no longer
+ *          in use or the pool of the key is full
+ *
+ * @param   mgr [IN] Session management context
+ * @param   isEncrypt [IN] Whether the key encrypted a ticket
+ * @param   keyName [IN] Name of the key
+ * @param   aesKey [IN] AES key, to recognize a key replaced under the same name
+ * @param   cipherCtx [IN] Cipher context, may be NULL
+ */
+void SESSMGR_ReturnTicketKey(TLS_SessionMgr *mgr, bool isEncrypt, const uint8_t *keyName, const uint8_t *aesKey,
+    HITLS_Cipher_Ctx *cipherCtx);
+
 /**
  * @brief   Encrypt the session ticket, which is invoked when a new session ticket is sent
  *
@@ -116,7 +188,7 @@ int32_t SESSMGR_SetTicketKey(TLS_SessionMgr *mgr, const uint8_t *key, uint32_t k
  * @retval  HITLS_SUCCESS
  * @retval  For other error codes, see hitls_error.h
  */
-int32_t SESSMGR_EncryptSessionTicket(TLS_Ctx *ctx, const TLS_SessionMgr *sessMgr, const HITLS_Session *sess, uint8_t **ticketBuf,
+int32_t SESSMGR_EncryptSessionTicket(TLS_Ctx *ctx, TLS_SessionMgr *sessMgr, const HITLS_Session *sess, uint8_t **ticketBuf,
     uint32_t *ticketBufSize);
 
 /**
@@ -144,7 +216,7 @@ int32_t SESSMGR_EncryptSessionTicket(TLS_Ctx *ctx, const TLS_SessionMgr *sessMgr
  * @retval  For other error codes, see hitls_error.h
  */
 int32_t SESSMGR_DecryptSessionTicket(HITLS_Lib_Ctx *libCtx, const char *attrName,
-    const TLS_SessionMgr *sessMgr, HITLS_Session **sess, const uint8_t *ticketBuf,
+    TLS_SessionMgr *sessMgr, HITLS_Session **sess, const uint8_t *ticketBuf,
     uint32_t ticketBufSize, bool *isTicketExcept);
 
 #ifdef __cplusplus
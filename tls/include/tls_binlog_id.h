@@ -501,7 +501,7 @@ enum TLS_BINLOG_ID {
     BINLOG_ID17336, BINLOG_ID17337, BINLOG_ID17338, BINLOG_ID17339, BINLOG_ID17340,
     BINLOG_ID17341, BINLOG_ID17342, BINLOG_ID17343, BINLOG_ID17344, BINLOG_ID17345,
     BINLOG_ID17346, BINLOG_ID17347, BINLOG_ID17348, BINLOG_ID17349, BINLOG_ID17350,
-    BINLOG_ID17351, BINLOG_ID17352, BINLOG_ID17353, BINLOG_ID17354
+    BINLOG_ID17351, BINLOG_ID17352, BINLOG_ID17353, BINLOG_ID17354, BINLOG_ID17355
 };
 
 #ifdef HITLS_BSL_LOG
@@ -59,6 +59,10 @@ typedef struct TlsSessionManager TLS_SessionMgr;
 /* the default number of tickets of TLS1.3 server is 2 */
 #define HITLS_TLS13_TICKET_NUM_DEFAULT 2u
 #define HITLS_MAX_EMPTY_RECORDS 32
+/* the max number of app records which can be packed into one write */
+#define HITLS_MAX_WRITE_BATCH_NUM 16u
+/* the max number of app records which can be decrypted by one read */
+#define HITLS_MAX_READ_BATCH_NUM 16u
 /* max cert list is 100k */
 #define HITLS_MAX_CERT_LIST_DEFAULT (1024 * 100)
 
@@ -151,6 +155,8 @@ typedef struct TlsConfig {
 
     int32_t readAhead;                  /* need read more data into user buffer, nonzero indicates yes, otherwise no */
     uint32_t emptyRecordsNum;           /* the max number of empty records can be received */
+    uint32_t writeBatchNum;             /* the max number of app records sent by one write, 0 or 1 indicates no batch */
+    uint32_t readBatchNum;              /* the max number of app records decrypted by one read, 0 or 1 indicates no batch */
 
     /* TLS1.2 psk */
     uint8_t *pskIdentityHint;           /* psk identity hint */
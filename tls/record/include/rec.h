@@ -214,6 +214,19 @@ int32_t REC_ActivePendingState(TLS_Ctx *ctx, bool isOut);
  */
 int32_t REC_GetMaxWriteSize(const TLS_Ctx *ctx, uint32_t *len);
 
+/**
+ * @brief   Obtain the maximum plaintext length of app data which can be written by one REC_Write call.
+ *          If write batching is configured, the data is split into multiple records which are sent together.
+ *
+ * @param   ctx [IN] TLS_Ctx context
+ * @param   len [OUT] Maximum length of the plaintext
+ *
+ * @retval  HITLS_SUCCESS
+ * @retval  HITLS_INTERNAL_EXCEPTION Invalid null pointer
+ * @retval  HITLS_REC_PMTU_TOO_SMALL The PMTU is too small
+ */
+int32_t REC_GetMaxAppWriteSize(const TLS_Ctx *ctx, uint32_t *len);
+
 /**
  * @ingroup record
  * @brief   TLS13 Initialize the pending state
@@ -263,7 +276,7 @@ bool REC_HaveReadSuiteInfo(const TLS_Ctx *ctx);
 
 /**
  * @ingroup app
- * @brief Obtain the length of the remaining readable app messages in the current record.
+ * @brief Obtain the length of the remaining readable app messages which have been decrypted.
  *
  * @param ctx [IN] TLS object
  * @return Length of the remaining readable app message
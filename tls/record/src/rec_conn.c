@@ -24,6 +24,9 @@
 #include "rec_alert.h"
 #include "rec_crypto.h"
 #include "rec_conn.h"
+#ifdef HITLS_TLS_SUITE_CIPHER_AEAD
+#include "rec_crypto_aead.h"
+#endif
 
 
 #define KEY_EXPANSION_LABEL "key expansion"
@@ -109,6 +112,11 @@ int32_t RecConnStateSetCipherInfo(RecConnState *state, RecConnSuitInfo *suitInfo
     }
 
     (void)memcpy_s(state->suiteInfo, sizeof(RecConnSuitInfo), suitInfo, sizeof(RecConnSuitInfo));
+#ifdef HITLS_TLS_SUITE_CIPHER_AEAD
+    if (suitInfo->cipherType == HITLS_AEAD_CIPHER) {
+        return RecAeadInitNonce(state->suiteInfo);
+    }
+#endif
     return HITLS_SUCCESS;
 }
 
@@ -35,6 +35,7 @@ extern "C" {
 #define MAX_MD5_SIZE 16
 
 #define REC_CONN_SEQ_SIZE 8u            /* Sequence number size */
+#define REC_AEAD_NONCE_SIZE 12u         /* The length of the AEAD nonce is fixed to 12 */
 
 /**
  * Cipher suite information, which is required for local encryption and decryption
@@ -50,6 +51,9 @@ typedef struct {
     uint8_t macKey[REC_MAX_MAC_KEY_LEN];
     uint8_t key[REC_MAX_KEY_LENGTH];
     uint8_t iv[REC_MAX_IV_LENGTH];
+    /* AEAD nonce. The implicit part is prepared when the cipher info is set, only the part derived from the
+       sequence number is updated for each record */
+    uint8_t nonce[REC_AEAD_NONCE_SIZE];
     bool isExportIV;                /* Used by the TTO feature. The IV does not need to be randomly
                                     generated during CBC encryption If it is set by user */
     /* key length */
@@ -101,7 +101,6 @@ static int32_t DefaultEncryptPreProcess(TLS_Ctx *ctx, uint8_t recordType, const
     (void)ctx, (void)data;
     recPlaintext->recordType = recordType;
     recPlaintext->plainLen = plainLen;
-    recPlaintext->plainData = NULL;
 #ifdef HITLS_TLS_PROTO_TLS13
     if (ctx->negotiatedInfo.version != HITLS_VERSION_TLS13 ||
         ctx->recCtx->writeStates.currentState->suiteInfo == NULL) {
@@ -132,24 +131,10 @@ static int32_t DefaultEncryptPreProcess(TLS_Ctx *ctx, uint8_t recordType, const
         return HITLS_REC_RECORD_OVERFLOW;
     }
 
-    uint8_t *tlsInnerPlaintext = BSL_SAL_Calloc(1u, tlsInnerPlaintextLen);
-    if (tlsInnerPlaintext == NULL) {
-        BSL_ERR_PUSH_ERROR(HITLS_MEMALLOC_FAIL);
-        return RETURN_ERROR_NUMBER_PROCESS(HITLS_MEMALLOC_FAIL, BINLOG_ID17253, "Calloc fail");
-    }
-
-    if (memcpy_s(tlsInnerPlaintext, tlsInnerPlaintextLen, data, plainLen) != EOK) {
-        BSL_SAL_FREE(tlsInnerPlaintext);
-        BSL_ERR_PUSH_ERROR(HITLS_MEMCPY_FAIL);
-        return RETURN_ERROR_NUMBER_PROCESS(HITLS_MEMCPY_FAIL, BINLOG_ID17254, "memcpy fail");
-    }
-
-    tlsInnerPlaintext[plainLen] = recordType;
-
-    /* Padding is calloc when the memory is applied for. Therefore, the number of buffs to be supplemented is 0. You do
-     * not need to perform any operation */
+    /* The TLSInnerPlaintext is packed into the record body by the writer and encrypted in place */
     recPlaintext->plainLen = tlsInnerPlaintextLen;
-    recPlaintext->plainData = tlsInnerPlaintext;
+    recPlaintext->innerType = recordType;
+    recPlaintext->recPaddingLength = recPaddingLength;
     /* tls1.3 Hide the actual record type during encryption */
     recPlaintext->recordType = (uint8_t)REC_TYPE_APP;
 #endif /* HITLS_TLS_PROTO_TLS13 */
@@ -23,9 +23,9 @@
 typedef struct {
     REC_Type recordType; /* Protocol type */
     uint32_t plainLen;   /* message length */
-    uint8_t *plainData;  /* message data */
 #ifdef HITLS_TLS_PROTO_TLS13
-    /* Length of the tls1.3 padding content. Currently, the value is 0. The value can be used as required */
+    REC_Type innerType;  /* Actual protocol type carried in the TLSInnerPlaintext message */
+    /* Length of the tls1.3 padding content, which is obtained from the record padding callback */
     uint64_t recPaddingLength;
 #endif
     bool isTlsInnerPlaintext; /* Whether it is a TLSInnerPlaintext message for tls1.3 */
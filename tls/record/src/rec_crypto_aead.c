@@ -29,16 +29,14 @@
 
 #define AEAD_AAD_TLS12_SIZE 13u            /* TLS1.2 AEAD additional_data length */
 #define AEAD_AAD_MAX_SIZE   AEAD_AAD_TLS12_SIZE
-#define AEAD_NONCE_SIZE 12u         /* The length of the AEAD nonce is fixed to 12 */
-#define AEAD_NONCE_ZEROS_SIZE 4u            /* The length of the AEAD nonce First 4 bytes */
+#define AEAD_NONCE_SIZE REC_AEAD_NONCE_SIZE
+#define AEAD_NONCE_SEQ_OFFSET (AEAD_NONCE_SIZE - REC_CONN_SEQ_SIZE)    /* The last 8 bytes come from the sequence */
 #ifdef HITLS_TLS_PROTO_TLS13
 #define AEAD_AAD_TLS13_SIZE 5u            /* TLS1.3 AEAD additional_data length */
 #endif
 
-static int32_t CleanSensitiveData(int32_t ret, uint8_t *nonce, uint8_t *aad, uint32_t outLen, uint32_t cipherLen)
+static int32_t CheckEncryptResult(int32_t ret, uint32_t outLen, uint32_t cipherLen)
 {
-    BSL_SAL_CleanseData(nonce, AEAD_NONCE_SIZE);
-    BSL_SAL_CleanseData(aad, AEAD_AAD_MAX_SIZE);
     if (ret != HITLS_SUCCESS) {
         BSL_ERR_PUSH_ERROR(ret);
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID15480, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN,
@@ -56,47 +54,40 @@ static int32_t CleanSensitiveData(int32_t ret, uint8_t *nonce, uint8_t *aad, uin
     return HITLS_SUCCESS;
 }
 
-static int32_t AeadGetNonce(const RecConnSuitInfo *suiteInfo, uint8_t *nonce, uint8_t nonceLen,
-    const uint8_t *seq, uint8_t seqLen)
+int32_t RecAeadInitNonce(RecConnSuitInfo *suiteInfo)
 {
     uint8_t fixedIvLength = suiteInfo->fixedIvLength;
     uint8_t recordIvLength = suiteInfo->recordIvLength;
 
-    if ((fixedIvLength + recordIvLength) != nonceLen) {
+    if ((fixedIvLength + recordIvLength) != AEAD_NONCE_SIZE ||
+        (recordIvLength != REC_CONN_SEQ_SIZE && recordIvLength != 0)) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID17239, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "nonceLen err", 0, 0, 0, 0);
         BSL_ERR_PUSH_ERROR(HITLS_REC_ERR_AEAD_NONCE_PARAM);
-        return HITLS_REC_ERR_AEAD_NONCE_PARAM;  // The caller should ensure that the input is correct
+        return HITLS_REC_ERR_AEAD_NONCE_PARAM;
     }
+    /*
+     * If recordIvLength is 8, according to the RFC5116 && RFC5288 AEAD_AES_128_GCM/AEAD_AES_256_GCM definition,
+     * the nonce is the 4 bytes implicit part derived from the iv followed by the 8 bytes explicit part.
+     * If recordIvLength is 0, the nonce is the 12 bytes iv XORed with the sequence number padded to the left with
+     * zeros (RFC8446 5.3, same as defined in RFC7905 AEAD_CHACHA20_POLY1305). The first 4 bytes are the iv.
+     */
+    (void)memcpy_s(suiteInfo->nonce, sizeof(suiteInfo->nonce), suiteInfo->iv, fixedIvLength);
+    return HITLS_SUCCESS;
+}
 
-    if (recordIvLength == seqLen) {
-        /*
-         * According to the RFC5116 && RFC5288 AEAD_AES_128_GCM/AEAD_AES_256_GCM definition, the nonce length is fixed
-         * to 12. 4 bytes + 8bytes(64 bits record sequence number, big endian) = 12 bytes 4 bytes the implicit part be
-         * derived from iv. The first 4 bytes of the IV are obtained.
-         */
-        (void)memcpy_s(nonce, nonceLen, suiteInfo->iv, fixedIvLength);
-        (void)memcpy_s(&nonce[fixedIvLength], recordIvLength, seq, seqLen);
-        return HITLS_SUCCESS;
-    } else if (recordIvLength == 0) {
-        /*
-         * (same as defined in RFC7905 AEAD_CHACHA20_POLY1305)
-         * The per-record nonce for the AEAD defined in RFC8446 5.3
-         * First 4 bytes (all 0s) + Last 8bytes(64 bits record sequence number, big endian) = 12 bytes
-         * Perform XOR with the 12 bytes IV. The result is nonce.
-         */
-        // First four bytes (all 0s)
-        (void)memset_s(&nonce[0], nonceLen, 0, AEAD_NONCE_ZEROS_SIZE);
-        // First 4 bytes (all 0s) + Last 8 bytes (64-bit record sequence number, big endian)
-        (void)memcpy_s(&nonce[AEAD_NONCE_ZEROS_SIZE], nonceLen - AEAD_NONCE_ZEROS_SIZE, seq, seqLen);
-        for (uint32_t i = 0; i < nonceLen; i++) {
-            nonce[i] = nonce[i] ^ suiteInfo->iv[i];
+/* Fill in the part of the nonce derived from the 64 bits record sequence number (big endian) or explicit iv */
+static const uint8_t *AeadUpdateNonce(RecConnSuitInfo *suiteInfo, const uint8_t *seq)
+{
+    uint8_t *nonce = &suiteInfo->nonce[AEAD_NONCE_SEQ_OFFSET];
+    if (suiteInfo->recordIvLength == 0) {
+        const uint8_t *iv = &suiteInfo->iv[AEAD_NONCE_SEQ_OFFSET];
+        for (uint32_t i = 0; i < REC_CONN_SEQ_SIZE; i++) {
+            nonce[i] = iv[i] ^ seq[i];
         }
-        return HITLS_SUCCESS;
+    } else {
+        (void)memcpy_s(nonce, REC_CONN_SEQ_SIZE, seq, REC_CONN_SEQ_SIZE);
     }
-
-    BSL_LOG_BINLOG_FIXLEN(BINLOG_ID17240, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN, "get nonce fail", 0, 0, 0, 0);
-    BSL_ERR_PUSH_ERROR(HITLS_REC_ERR_AEAD_NONCE_PARAM);
-    return HITLS_REC_ERR_AEAD_NONCE_PARAM;
+    return suiteInfo->nonce;
 }
 
 static void AeadGetAad(uint8_t *aad, uint32_t *aadLen, const REC_TextInput *input, uint32_t plainDataLen)
@@ -177,18 +168,11 @@ static int32_t AeadDecrypt(TLS_Ctx *ctx, RecConnState *state, const REC_TextInpu
     }
 
     /** Calculate NONCE */
-    uint8_t nonce[AEAD_NONCE_SIZE] = {0};
-    int32_t ret = AeadGetNonce(suiteInfo, nonce, sizeof(nonce), recordIv, REC_CONN_SEQ_SIZE);
-    if (ret != HITLS_SUCCESS) {
-        BSL_LOG_BINLOG_FIXLEN(BINLOG_ID15395, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN,
-            "Record decrypt:get nonce failed.", 0, 0, 0, 0);
-        return ret;
-    }
-    cipherParam.iv = nonce;
+    cipherParam.iv = AeadUpdateNonce(suiteInfo, recordIv);
     cipherParam.ivLen = AEAD_NONCE_SIZE;
 
-    /* Calculate additional_data */
-    uint8_t aad[AEAD_AAD_MAX_SIZE] = {0};
+    /* Calculate additional_data, which is sent in plaintext and does not need to be cleansed */
+    uint8_t aad[AEAD_AAD_MAX_SIZE];
     uint32_t aadLen = AEAD_AAD_MAX_SIZE;
     /*
     Definition of additional_data
@@ -210,11 +194,8 @@ static int32_t AeadDecrypt(TLS_Ctx *ctx, RecConnState *state, const REC_TextInpu
     /** Calculate the encryption length: GenericAEADCipher.content + aead tag */
     uint32_t cipherLen = cryptMsg->textLen - cipherOffset;
     /** Decryption */
-    ret = SAL_CRYPT_Decrypt(LIBCTX_FROM_CTX(ctx), ATTRIBUTE_FROM_CTX(ctx),
+    int32_t ret = SAL_CRYPT_Decrypt(LIBCTX_FROM_CTX(ctx), ATTRIBUTE_FROM_CTX(ctx),
         &cipherParam, &cryptMsg->text[cipherOffset], cipherLen, data, dataLen);
-    /* Clear sensitive information */
-    BSL_SAL_CleanseData(nonce, AEAD_NONCE_SIZE);
-    BSL_SAL_CleanseData(aad, AEAD_AAD_MAX_SIZE);
     if (ret != HITLS_SUCCESS) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID15396, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN,
             "decrypt record error. ret:%d", ret, 0, 0, 0);
@@ -264,17 +245,10 @@ static int32_t AeadEncrypt(TLS_Ctx *ctx, RecConnState *state, const REC_TextInpu
     }
 
     /** Calculate NONCE */
-    uint8_t nonce[AEAD_NONCE_SIZE] = {0};
-    int32_t ret = AeadGetNonce(state->suiteInfo, nonce, sizeof(nonce), plainMsg->seq, REC_CONN_SEQ_SIZE);
-    if (ret != HITLS_SUCCESS) {
-        BSL_LOG_BINLOG_FIXLEN(BINLOG_ID15385, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN,
-            "Record encrypt:get nonce failed.", 0, 0, 0, 0);
-        return ret;
-    }
-    cipherParam.iv = nonce;
+    cipherParam.iv = AeadUpdateNonce(state->suiteInfo, plainMsg->seq);
     cipherParam.ivLen = AEAD_NONCE_SIZE;
 
-    /* Calculate additional_data */
+    /* Calculate additional_data, which is sent in plaintext and does not need to be cleansed */
     uint8_t aad[AEAD_AAD_MAX_SIZE];
     uint32_t aadLen = AEAD_AAD_MAX_SIZE;
     uint32_t textLen =
@@ -290,10 +264,9 @@ static int32_t AeadEncrypt(TLS_Ctx *ctx, RecConnState *state, const REC_TextInpu
     uint32_t cipherLen = cipherTextLen - cipherOffset;
     uint32_t outLen = cipherLen;
     /** Encryption */
-    ret = SAL_CRYPT_Encrypt(LIBCTX_FROM_CTX(ctx), ATTRIBUTE_FROM_CTX(ctx),
+    int32_t ret = SAL_CRYPT_Encrypt(LIBCTX_FROM_CTX(ctx), ATTRIBUTE_FROM_CTX(ctx),
         &cipherParam, plainMsg->text, plainMsg->textLen, &cipherText[cipherOffset], &outLen);
-    /* Clear sensitive information */
-    return CleanSensitiveData(ret, nonce, aad, outLen, cipherLen);
+    return CheckEncryptResult(ret, outLen, cipherLen);
 }
 
 const RecCryptoFunc *RecGetAeadCryptoFuncs(DecryptPostProcess decryptPostProcess, EncryptPreProcess encryptPreProcess)
@@ -17,4 +17,14 @@
 #include "rec_crypto.h"
 
 const RecCryptoFunc *RecGetAeadCryptoFuncs(DecryptPostProcess decryptPostProcess, EncryptPreProcess encryptPreProcess);
+
+/**
+ * @brief   Prepare the implicit part of the AEAD nonce
+ *
+ * @param   suiteInfo [IN/OUT] Cipher suite information
+ *
+ * @retval  HITLS_SUCCESS succeeded.
+ * @retval  HITLS_REC_ERR_AEAD_NONCE_PARAM The iv length does not match the nonce.
+ */
+int32_t RecAeadInitNonce(RecConnSuitInfo *suiteInfo);
 #endif
\ No newline at end of file
@@ -818,6 +818,21 @@ int32_t TlsCheckRecordHeader(TLS_Ctx *ctx, const RecHdr *recordHdr)
     return HITLS_SUCCESS;
 }
 
+static bool IsReadBatchEnabled(const TLS_Ctx *ctx)
+{
+    return ctx->config.tlsConfig.readAhead != 0 && ctx->config.tlsConfig.readBatchNum > 1;
+}
+
+/* Enlarge the read buffer for the read batch, so that one read can fetch multiple records from the socket */
+static int32_t ReadBatchBufReserve(const TLS_Ctx *ctx, RecBuf *inBuf)
+{
+    uint32_t bufSize = RecGetInitBufferSize(ctx, true) * ctx->config.tlsConfig.readBatchNum;
+    if (inBuf->bufSize >= bufSize) {
+        return HITLS_SUCCESS;
+    }
+    return RecBufResize(inBuf, bufSize);
+}
+
 /**
  * @brief   Read data from the uio of the TLS context into inBuf
  *
@@ -844,6 +859,13 @@ int32_t StreamRead(TLS_Ctx *ctx, RecBuf *inBuf, uint32_t len)
     if (bytesInRbuf >= len) {
         return HITLS_SUCCESS;
     }
+    if (IsReadBatchEnabled(ctx)) {
+        int32_t ret = ReadBatchBufReserve(ctx, inBuf);
+        if (ret != HITLS_SUCCESS) {
+            return ret;
+        }
+        bytesInRbuf = inBuf->end - inBuf->start;
+    }
     // right-side available space is less then required len, move data leftwards
     if (inBuf->bufSize - inBuf->end < len) {
         for (uint32_t i = 0; i < bytesInRbuf; i++) {
@@ -999,6 +1021,65 @@ int32_t RecordDecryptPrepare(TLS_Ctx *ctx, uint16_t version, REC_Type recordType
     return HITLS_SUCCESS;
 }
 
+/* Check whether the next record in the read buffer is a complete app record whose plaintext fits in bufLen bytes */
+static bool IsAppRecordReady(TLS_Ctx *ctx, const RecBuf *inBuf, uint32_t bufLen)
+{
+    if (IsNeedtoRead(ctx, inBuf) || inBuf->buf[inBuf->start] != REC_TYPE_APP) {
+        return false;
+    }
+    RecConnState *state = GetReadConnState(ctx);
+    uint32_t bodyLen = BSL_ByteToUint16(&inBuf->buf[inBuf->start + REC_TLS_RECORD_LENGTH_OFFSET]);
+    uint32_t offset = 0;
+    uint32_t minBufLen = 0;
+    if (bodyLen == 0 || RecGetCryptoFuncs(state->suiteInfo)->calPlantextBufLen(ctx, state->suiteInfo, bodyLen,
+        &offset, &minBufLen) != HITLS_SUCCESS) {
+        /* Leave the invalid record to the next read, which reports the error */
+        return false;
+    }
+    return minBufLen <= bufLen;
+}
+
+/**
+ * @brief Decrypt up to readBatchNum app records which are already in the read buffer back-to-back after the data read,
+ *        so that one read returns the app data received by one socket read.
+ * @attention In TLS1.3, the real type of a record is known after it is decrypted. If the record is not app data, the
+ *            decryption is rolled back and the record is left to the next read. The TLS1.3 records are protected by
+ *            AEAD, so the decryption depends on the sequence number only.
+ */
+static int32_t ReadBatchAppRecords(TLS_Ctx *ctx, uint8_t *data, uint32_t num, uint32_t *readLen)
+{
+    RecBuf *inBuf = ctx->recCtx->inBuf;
+    RecConnState *state = GetReadConnState(ctx);
+    for (uint32_t recordNum = 1; recordNum < ctx->config.tlsConfig.readBatchNum && *readLen < num &&
+        IsAppRecordReady(ctx, inBuf, num - *readLen); recordNum++) {
+        uint32_t start = inBuf->start;
+        uint64_t seq = state->seq;
+        bool isWrapped = state->isWrapped;
+        REC_TextInput encryptedMsg = { 0 };
+        int32_t ret = RecordDecryptPrepare(ctx, ctx->negotiatedInfo.version, REC_TYPE_APP, &encryptedMsg);
+        if (ret != HITLS_SUCCESS) {
+            return ret;
+        }
+        RecBuf decryptBuf = {0};
+        decryptBuf.buf = &data[*readLen];
+        decryptBuf.bufSize = num - *readLen;
+        ret = RecordDecrypt(ctx, &decryptBuf, &encryptedMsg);
+        if (ret != HITLS_SUCCESS) {
+            return ret;
+        }
+        if (encryptedMsg.type != REC_TYPE_APP) {
+            BSL_SAL_CleanseData(decryptBuf.buf, decryptBuf.end);
+            inBuf->start = start;
+            RecConnSetSeqNum(state, seq);
+            state->isWrapped = isWrapped;
+            break;
+        }
+        RecClearAlertCount(ctx, encryptedMsg.type);
+        *readLen += decryptBuf.end;
+    }
+    return HITLS_SUCCESS;
+}
+
 /**
  * @brief Read a record in the TLS protocol.
  * @attention: Handle record and handle transporting state to receive unexpected record type messages
@@ -1043,6 +1124,9 @@ int32_t TlsRecordRead(TLS_Ctx *ctx, REC_Type recordType, uint8_t *data, uint32_t
     if (decryptBuf.buf == data) {
         /* Update the read length */
         *readLen = decryptBuf.end;
+        if (recordType == REC_TYPE_APP && IsReadBatchEnabled(ctx) && ctx->peekFlag == 0) {
+            return ReadBatchAppRecords(ctx, data, num, readLen);
+        }
         return HITLS_SUCCESS;
     }
     ret = RecBufListAddBuffer(bufList, &decryptBuf);
@@ -1061,9 +1145,11 @@ uint32_t APP_GetReadPendingBytes(const TLS_Ctx *ctx)
     if (ctx == NULL || ctx->recCtx == NULL || RecBufListEmpty(ctx->recCtx->appRecList)) {
         return 0;
     }
-    RecBuf *recBuf = (RecBuf *)BSL_LIST_GET_FIRST(ctx->recCtx->appRecList);
-    if (recBuf == NULL) {
-        return 0;
+    uint32_t pendingBytes = 0;
+    RecBufList *bufList = ctx->recCtx->appRecList;
+    for (BslListNode *node = BSL_LIST_FirstNode(bufList); node != NULL; node = BSL_LIST_GetNextNode(bufList, node)) {
+        RecBuf *recBuf = (RecBuf *)BSL_LIST_GetData(node);
+        pendingBytes += recBuf->end - recBuf->start;
     }
-    return recBuf->end - recBuf->start;
+    return pendingBytes;
 }
\ No newline at end of file
@@ -50,7 +50,7 @@ static void OutbufUpdate(uint32_t *start, uint32_t startvalue, uint32_t *end, ui
     return;
 }
 
-static int32_t CheckEncryptionLimits(TLS_Ctx *ctx, RecConnState *state)
+static int32_t CheckEncryptionLimits(TLS_Ctx *ctx, RecConnState *state, uint64_t seq)
 {
     (void)ctx;
     if (state->suiteInfo != NULL &&
@@ -59,7 +59,7 @@ static int32_t CheckEncryptionLimits(TLS_Ctx *ctx, RecConnState *state)
 #endif
         (state->suiteInfo->cipherAlg == HITLS_CIPHER_AES_128_GCM ||
         state->suiteInfo->cipherAlg == HITLS_CIPHER_AES_256_GCM) &&
-        RecConnGetSeqNum(state) > REC_MAX_AES_GCM_ENCRYPTION_LIMIT) {
+        seq > REC_MAX_AES_GCM_ENCRYPTION_LIMIT) {
         BSL_ERR_PUSH_ERROR(HITLS_REC_ENCRYPTED_NUMBER_OVERFLOW);
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID16188, BSL_LOG_LEVEL_WARN, BSL_LOG_BINLOG_TYPE_RUN,
             "AES-GCM record encrypted times overflow", 0, 0, 0, 0);
@@ -221,7 +221,7 @@ int32_t DtlsRecordWrite(TLS_Ctx *ctx, REC_Type recordType, const uint8_t *data,
 
     DtlsRecordHeaderPack(outBuf, recordType, plainMsg.version, epochSeq, cipherTextLen);
 
-    ret = CheckEncryptionLimits(ctx, state);
+    ret = CheckEncryptionLimits(ctx, state, RecConnGetSeqNum(state));
     if (ret != HITLS_SUCCESS) {
         return ret;
     }
@@ -282,7 +282,7 @@ int32_t StreamWrite(TLS_Ctx *ctx, RecBuf *buf)
 }
 
 static void TlsPlainMsgGenerate(REC_TextInput *plainMsg, const TLS_Ctx *ctx,
-    REC_Type recordType, const uint8_t *data, uint32_t plainLen)
+    REC_Type recordType, const uint8_t *data, uint32_t plainLen, uint64_t seq)
 {
     plainMsg->type = recordType;
     plainMsg->text = data;
@@ -317,7 +317,7 @@ static void TlsPlainMsgGenerate(REC_TextInput *plainMsg, const TLS_Ctx *ctx,
         plainMsg->version = HITLS_VERSION_TLS10;
     }
 
-    BSL_Uint64ToByte(GetWriteConnState(ctx)->seq, plainMsg->seq);
+    BSL_Uint64ToByte(seq, plainMsg->seq);
 }
 
 static inline void TlsRecordHeaderPack(uint8_t *outBuf, REC_Type recordType, uint16_t version, uint32_t cipherTextLen)
@@ -327,15 +327,16 @@ static inline void TlsRecordHeaderPack(uint8_t *outBuf, REC_Type recordType, uin
     BSL_Uint16ToByte((uint16_t)cipherTextLen, &outBuf[REC_TLS_RECORD_LENGTH_OFFSET]);
 }
 
-static int32_t SendRecord(TLS_Ctx *ctx, RecCtx *recordCtx, RecConnState *state, uint64_t seq)
+static int32_t SendRecord(TLS_Ctx *ctx, RecCtx *recordCtx, RecConnState *state)
 {
     int32_t ret = StreamWrite(ctx, recordCtx->outBuf);
     if (ret != HITLS_SUCCESS) {
         return ret;
     }
 
-    /** Add the record sequence */
-    RecConnSetSeqNum(state, seq + 1);
+    /** Add the record sequence by the number of records sent */
+    RecConnSetSeqNum(state, state->seq + recordCtx->outRecordNum);
+    recordCtx->outRecordNum = 0;
     return HITLS_SUCCESS;
 }
 static int32_t SequenceCompare(RecConnState *state, uint64_t value)
@@ -367,32 +368,31 @@ static int32_t LengthCheck(uint32_t ciphertextLen, const uint32_t outBufLen, Rec
     }
     return HITLS_SUCCESS;
 }
-static const uint8_t *GetPlainMsgData(RecordPlaintext *recPlaintext, const uint8_t *data)
-{
-    (void)recPlaintext;
-    return
 #ifdef HITLS_TLS_PROTO_TLS13
-        recPlaintext->isTlsInnerPlaintext ? recPlaintext->plainData :
-#endif
-        data;
+/* Pack the TLSInnerPlaintext into the record body of the write buffer, so that it is encrypted in place */
+static int32_t TlsInnerPlaintextPack(const RecordPlaintext *recPlaintext, const uint8_t *data, uint32_t num,
+    uint8_t *body, uint32_t bodyLen)
+{
+    if (num > 0 && memcpy_s(body, bodyLen, data, num) != EOK) {
+        BSL_ERR_PUSH_ERROR(HITLS_MEMCPY_FAIL);
+        return RETURN_ERROR_NUMBER_PROCESS(HITLS_MEMCPY_FAIL, BINLOG_ID17254, "memcpy fail");
+    }
+    body[num] = recPlaintext->innerType;
+    /* TlsInnerPlaintext see rfc 8446 section 5.2, the padding is all zeros */
+    (void)memset_s(&body[num + 1], bodyLen - num - 1, 0, (size_t)recPlaintext->recPaddingLength);
+    return HITLS_SUCCESS;
 }
-// Write a record in the TLS protocol, serialize a record message, and send the message
-int32_t TlsRecordWrite(TLS_Ctx *ctx, REC_Type recordType, const uint8_t *data, uint32_t num)
+#endif
+
+/* Serialize a record at the end of the write buffer and encrypt it with the sequence number seq */
+static int32_t TlsRecordPack(TLS_Ctx *ctx, RecConnState *state, REC_Type recordType, const uint8_t *data,
+    uint32_t num, uint64_t seq)
 {
     RecBuf *writeBuf = ctx->recCtx->outBuf;
-    RecConnState *state = GetWriteConnState(ctx);
     RecordPlaintext recPlaintext = {0};
     REC_TextInput plainMsg = {0};
-    int32_t ret = SequenceCompare(state, REC_TLS_SN_MAX_VALUE);
-    if (ret != HITLS_SUCCESS) {
-        return ret;
-    }
-    /* Check whether the cache exists */
-    if (writeBuf->end > writeBuf->start) {
-        return SendRecord(ctx, ctx->recCtx, state, state->seq);
-    }
     const RecCryptoFunc *funcs = RecGetCryptoFuncs(state->suiteInfo);
-    ret = funcs->encryptPreProcess(ctx, recordType, data, num, &recPlaintext);
+    int32_t ret = funcs->encryptPreProcess(ctx, recordType, data, num, &recPlaintext);
     if (ret != HITLS_SUCCESS) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID17281, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN,
             "encryptPreProcess fail", 0, 0, 0, 0);
@@ -401,35 +401,109 @@ int32_t TlsRecordWrite(TLS_Ctx *ctx, REC_Type recordType, const uint8_t *data, u
 
     uint32_t ciphertextLen = funcs->calCiphertextLen(ctx, state->suiteInfo, recPlaintext.plainLen, false);
     const uint32_t outBufLen = REC_TLS_RECORD_HEADER_LEN + ciphertextLen;
-    ret = LengthCheck(ciphertextLen, outBufLen, writeBuf);
+    ret = LengthCheck(ciphertextLen, writeBuf->end + outBufLen, writeBuf);
     if (ret != HITLS_SUCCESS) {
-        BSL_SAL_FREE(recPlaintext.plainData);
         return ret;
     }
-    /* If the value is not tls13, use the input parameter data */
-    const uint8_t *plainMsgData = GetPlainMsgData(&recPlaintext, data);
-    (void)TlsPlainMsgGenerate(&plainMsg, ctx, recPlaintext.recordType, plainMsgData, recPlaintext.plainLen);
-    (void)TlsRecordHeaderPack(writeBuf->buf, recPlaintext.recordType, plainMsg.version, ciphertextLen);
 
-    ret = CheckEncryptionLimits(ctx, state);
+    ret = CheckEncryptionLimits(ctx, state, seq);
     if (ret != HITLS_SUCCESS) {
-        BSL_SAL_FREE(recPlaintext.plainData);
         return ret;
     }
 
+    uint8_t *record = writeBuf->buf + writeBuf->end;
+    uint8_t *recordBody = record + REC_TLS_RECORD_HEADER_LEN;
+    /* If the value is not tls13, use the input parameter data */
+    const uint8_t *plainMsgData = data;
+#ifdef HITLS_TLS_PROTO_TLS13
+    if (recPlaintext.isTlsInnerPlaintext) {
+        ret = TlsInnerPlaintextPack(&recPlaintext, data, num, recordBody,
+            writeBuf->bufSize - writeBuf->end - REC_TLS_RECORD_HEADER_LEN);
+        if (ret != HITLS_SUCCESS) {
+            return ret;
+        }
+        plainMsgData = recordBody;
+    }
+#endif
+    (void)TlsPlainMsgGenerate(&plainMsg, ctx, recPlaintext.recordType, plainMsgData, recPlaintext.plainLen, seq);
+    (void)TlsRecordHeaderPack(record, recPlaintext.recordType, plainMsg.version, ciphertextLen);
+
     /** Encrypt the record body */
-    ret = RecConnEncrypt(ctx, state, &plainMsg, writeBuf->buf + REC_TLS_RECORD_HEADER_LEN, ciphertextLen);
-    BSL_SAL_FREE(recPlaintext.plainData);
+    ret = RecConnEncrypt(ctx, state, &plainMsg, recordBody, ciphertextLen);
     if (ret != HITLS_SUCCESS) {
+        /* The record body may hold the plaintext which is to be encrypted in place */
+        BSL_SAL_CleanseData(recordBody, ciphertextLen);
         return ret;
     }
 
 #ifdef HITLS_TLS_FEATURE_INDICATOR
-    INDICATOR_MessageIndicate(1, recordType, RECORD_HEADER, writeBuf->buf, REC_TLS_RECORD_HEADER_LEN, ctx,
+    INDICATOR_MessageIndicate(1, recordType, RECORD_HEADER, record, REC_TLS_RECORD_HEADER_LEN, ctx,
                               ctx->config.tlsConfig.msgArg);
 #endif
-    OutbufUpdate(&writeBuf->start, 0, &writeBuf->end, outBufLen);
+    writeBuf->end += outBufLen;
+    return HITLS_SUCCESS;
+}
 
-    return SendRecord(ctx, ctx->recCtx, state, state->seq);
+/* Enlarge the write buffer so that recordNum records of the maximum length can be packed into it */
+static int32_t TlsOutBufReserve(TLS_Ctx *ctx, RecConnState *state, uint32_t recordNum)
+{
+    if (recordNum == 1) {
+        return HITLS_SUCCESS;
+    }
+    /* The batched records must not use the last sequence number, which is left to the wrapping check */
+    if (REC_TLS_SN_MAX_VALUE - state->seq < recordNum) {
+        BSL_ERR_PUSH_ERROR(HITLS_REC_ERR_SN_WRAPPING);
+        BSL_LOG_BINLOG_FIXLEN(BINLOG_ID17355, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN,
+            "Record write: sequence number wrap.", 0, 0, 0, 0);
+        return HITLS_REC_ERR_SN_WRAPPING;
+    }
+    uint32_t bufSize = RecGetInitBufferSize(ctx, false) * recordNum;
+    if (ctx->recCtx->outBuf->bufSize >= bufSize) {
+        return HITLS_SUCCESS;
+    }
+    return RecBufResize(ctx->recCtx->outBuf, bufSize);
+}
+
+// Write records in the TLS protocol, serialize the record messages, and send them at a time
+int32_t TlsRecordBatchWrite(TLS_Ctx *ctx, REC_Type recordType, const uint8_t *data, uint32_t num, uint32_t maxFragLen)
+{
+    RecCtx *recordCtx = ctx->recCtx;
+    RecBuf *writeBuf = recordCtx->outBuf;
+    RecConnState *state = GetWriteConnState(ctx);
+    int32_t ret = SequenceCompare(state, REC_TLS_SN_MAX_VALUE);
+    if (ret != HITLS_SUCCESS) {
+        return ret;
+    }
+    /* Check whether the cache exists */
+    if (writeBuf->end > writeBuf->start) {
+        return SendRecord(ctx, recordCtx, state);
+    }
+
+    uint32_t recordNum = (num <= maxFragLen) ? 1 : (num + maxFragLen - 1) / maxFragLen;
+    ret = TlsOutBufReserve(ctx, state, recordNum);
+    if (ret != HITLS_SUCCESS) {
+        return ret;
+    }
+    OutbufUpdate(&writeBuf->start, 0, &writeBuf->end, 0);
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i < recordNum; i++) {
+        uint32_t fragLen = (num - offset > maxFragLen) ? maxFragLen : num - offset;
+        ret = TlsRecordPack(ctx, state, recordType, &data[offset], fragLen, state->seq + i);
+        if (ret != HITLS_SUCCESS) {
+            /* Discard the records packed before, their sequence numbers are not used */
+            OutbufUpdate(&writeBuf->start, 0, &writeBuf->end, 0);
+            return ret;
+        }
+        offset += fragLen;
+    }
+    recordCtx->outRecordNum = recordNum;
+
+    return SendRecord(ctx, recordCtx, state);
+}
+
+// Write a record in the TLS protocol, serialize a record message, and send the message
+int32_t TlsRecordWrite(TLS_Ctx *ctx, REC_Type recordType, const uint8_t *data, uint32_t num)
+{
+    return TlsRecordBatchWrite(ctx, recordType, data, num, num);
 }
 #endif /* HITLS_TLS_PROTO_TLS */
@@ -39,6 +39,24 @@ extern "C" {
  */
 int32_t TlsRecordWrite(TLS_Ctx *ctx, REC_Type recordType, const uint8_t *data, uint32_t plainLen);
 
+/**
+ * @brief   Write records in TLS, the data longer than maxFragLen is split into multiple records which are encrypted
+ *          back-to-back into the write buffer and sent by one write
+ *
+ * @param   ctx [IN] TLS context
+ * @param   recordType [IN] Record type
+ * @param   data [IN] Data to be written
+ * @param   plainLen [IN] plain length
+ * @param   maxFragLen [IN] Maximum plaintext length of a single record
+ *
+ * @retval  HITLS_SUCCESS
+ * @retval  HITLS_REC_ERR_IO_EXCEPTION I/O error
+ * @retval  HITLS_REC_NORMAL_IO_BUSY I/O busy
+ * @retval  HITLS_REC_ERR_SN_WRAPPING Sequence number wrap
+ */
+int32_t TlsRecordBatchWrite(TLS_Ctx *ctx, REC_Type recordType, const uint8_t *data, uint32_t plainLen,
+    uint32_t maxFragLen);
+
 #ifdef HITLS_TLS_PROTO_DTLS12
 
 /**
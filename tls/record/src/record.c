@@ -130,6 +130,18 @@ static int32_t InnerRecRead(TLS_Ctx *ctx, REC_Type recordType, uint8_t *data, ui
     return HITLS_INTERNAL_EXCEPTION;
 #endif
 }
+/* Number of app records which can be sent by one write, the records of DTLS are always sent one by one */
+static uint32_t RecGetWriteBatchNum(const TLS_Ctx *ctx)
+{
+#ifdef HITLS_TLS_PROTO_DTLS12
+    if (IS_SUPPORT_DATAGRAM(ctx->config.tlsConfig.originVersionMask)) {
+        return 1;
+    }
+#endif
+    uint32_t batchNum = ctx->config.tlsConfig.writeBatchNum;
+    return (batchNum == 0) ? 1 : batchNum;
+}
+
 static int32_t InnerRecWrite(TLS_Ctx *ctx, REC_Type recordType, const uint8_t *data, uint32_t num)
 {
 #ifdef HITLS_TLS_CONFIG_STATE
@@ -143,6 +155,10 @@ static int32_t InnerRecWrite(TLS_Ctx *ctx, REC_Type recordType, const uint8_t *d
             "GetMaxWriteSize fail", 0, 0, 0, 0);
         return ret;
     }
+    uint32_t maxFragLen = maxWriteSize;
+    if (recordType == REC_TYPE_APP) {
+        maxWriteSize *= RecGetWriteBatchNum(ctx);
+    }
     if (num > maxWriteSize) {
         BSL_LOG_BINLOG_FIXLEN(BINLOG_ID15539, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN,
             "Record wrtie: plain length is too long.", 0, 0, 0, 0);
@@ -153,11 +169,12 @@ static int32_t InnerRecWrite(TLS_Ctx *ctx, REC_Type recordType, const uint8_t *d
 #ifdef HITLS_TLS_PROTO_DTLS12
     if (IS_SUPPORT_DATAGRAM(ctx->config.tlsConfig.originVersionMask)) {
         /* DTLS */
+        (void)maxFragLen;
         return DtlsRecordWrite(ctx, recordType, data, num);
     }
 #endif
 #ifdef HITLS_TLS_PROTO_TLS
-    return TlsRecordWrite(ctx, recordType, data, num);
+    return TlsRecordBatchWrite(ctx, recordType, data, num, maxFragLen);
 #else
     BSL_LOG_BINLOG_FIXLEN(BINLOG_ID17296, BSL_LOG_LEVEL_ERR, BSL_LOG_BINLOG_TYPE_RUN,
         "internal exception occurs", 0, 0, 0, 0);
@@ -568,6 +585,16 @@ int32_t REC_GetMaxWriteSize(const TLS_Ctx *ctx, uint32_t *len)
     return HITLS_SUCCESS;
 }
 
+int32_t REC_GetMaxAppWriteSize(const TLS_Ctx *ctx, uint32_t *len)
+{
+    int32_t ret = REC_GetMaxWriteSize(ctx, len);
+    if (ret != HITLS_SUCCESS) {
+        return ret;
+    }
+    *len *= RecGetWriteBatchNum(ctx);
+    return HITLS_SUCCESS;
+}
+
 REC_Type REC_GetUnexpectedMsgType(TLS_Ctx *ctx)
 {
     return ctx->recCtx->unexpectedMsgType;
@@ -78,6 +78,7 @@ typedef struct RecCtx {
     REC_Type unexpectedMsgType;
     uint32_t pendingDataSize;               /* Data length */
     const uint8_t *pendingData;             /* Plain Data content */
+    uint32_t outRecordNum;                  /* Number of records cached in outBuf */
 } RecCtx;
 
 